@@ -1,5 +1,6 @@
 #include "Editor/EditorApp.h"
 
+#include "Frost/Asset/Model.h"
 #include "Frost/Core/EntryPoint.h"
 #include "Frost/Core/Layer.h"
 #include "Frost/Scripting/ScriptingEngine.h"
@@ -27,6 +28,11 @@ namespace Editor
 
     void EditorApp::OnApplicationReady()
     {
+        // Viewport picking needs the mesh geometry on the CPU
+        ModelCookSettings cookSettings = Model::GetCookSettings();
+        cookSettings.keepPickingGeometry = true;
+        Model::SetCookSettings(cookSettings);
+
         _projectOpenEventHandlerId =
             EventManager::Subscribe<ProjectOpenEvent>(FROST_BIND_EVENT_FN(EditorApp::OnProjectOpen));
         _projectCloseEventHandlerId =
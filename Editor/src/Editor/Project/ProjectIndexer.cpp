@@ -0,0 +1,590 @@
+#include "Editor/Project/ProjectIndexer.h"
+
+#include "Frost/Asset/MeshConfig.h"
+#include "Frost/Debugging/Logger.h"
+#include "Frost/Utils/SerializerUtils.h"
+
+#include <algorithm>
+#include <fstream>
+
+using namespace Frost;
+
+namespace Editor
+{
+    const ProjectIndexSnapshot::Listing* ProjectIndexSnapshot::GetDirectory(const std::filesystem::path& directory) const
+    {
+        auto it = _directories.find(directory.lexically_normal().native());
+        if (it == _directories.end())
+        {
+            return nullptr;
+        }
+
+        return it->second.get();
+    }
+
+    const FileEntry* ProjectIndexSnapshot::Find(const std::filesystem::path& path) const
+    {
+        std::filesystem::path normalized = path.lexically_normal();
+
+        const Listing* listing = GetDirectory(normalized.parent_path());
+        if (!listing)
+        {
+            return nullptr;
+        }
+
+        for (const auto& entry : *listing)
+        {
+            if (entry.Path.lexically_normal() == normalized)
+            {
+                return &entry;
+            }
+        }
+
+        return nullptr;
+    }
+
+    ProjectIndexer::ProjectIndexer(const std::filesystem::path& projectDirectory,
+                                   const std::vector<std::filesystem::path>& roots,
+                                   const std::vector<std::string>& ignoredExtensions) :
+        _projectDirectory(projectDirectory), _ignoredExtensions(ignoredExtensions)
+    {
+        _indexFile = _projectDirectory / ".frost" / "assets.index";
+
+        for (const auto& root : roots)
+        {
+            _roots.push_back(root.lexically_normal());
+        }
+
+        _snapshot = std::make_shared<ProjectIndexSnapshot>();
+    }
+
+    ProjectIndexer::~ProjectIndexer()
+    {
+        Stop();
+    }
+
+    void ProjectIndexer::Start()
+    {
+        Stop();
+
+        // Watchers are started before the crawl so that nothing happening during it is lost
+        for (const auto& root : _roots)
+        {
+            if (!std::filesystem::exists(root))
+            {
+                continue;
+            }
+
+            auto watcher = std::make_unique<FileWatcher>(root);
+            watcher->SetCallback([this](const std::vector<FileChange>& changes) { _OnFilesChanged(changes); });
+            watcher->Start();
+            _watchers.push_back(std::move(watcher));
+        }
+
+        _running = true;
+        _workerThread = std::thread(&ProjectIndexer::_WorkerThreadFunc, this);
+    }
+
+    void ProjectIndexer::Stop()
+    {
+        for (auto& watcher : _watchers)
+        {
+            watcher->Stop();
+        }
+        _watchers.clear();
+
+        {
+            std::lock_guard lock(_changesMutex);
+            _running = false;
+        }
+        _changesCondition.notify_all();
+
+        if (_workerThread.joinable())
+        {
+            _workerThread.join();
+        }
+    }
+
+    std::shared_ptr<const ProjectIndexSnapshot> ProjectIndexer::GetSnapshot() const
+    {
+        std::lock_guard lock(_snapshotMutex);
+        return _snapshot;
+    }
+
+    void ProjectIndexer::Invalidate(const std::filesystem::path& path)
+    {
+        _OnFilesChanged({ { path, FileChangeAction::Modified } });
+    }
+
+    AssetType ProjectIndexer::GetAssetType(const std::string& extension)
+    {
+        using namespace Frost::Component;
+
+        if (extension == ".scene" || extension == ".yaml")
+            return AssetType::Scene;
+        if (extension == ".prefab")
+            return AssetType::Prefab;
+        if (std::find(MESH_FILE_EXTENSIONS.begin(), MESH_FILE_EXTENSIONS.end(), extension) !=
+            MESH_FILE_EXTENSIONS.end())
+            return AssetType::Model;
+        if (extension == ".png" || extension == ".jpg" || extension == ".jpeg" || extension == ".dds" ||
+            extension == ".tga" || extension == ".bmp" || extension == ".hdr")
+            return AssetType::Texture;
+        if (extension == ".hlsl" || extension == ".hlsli")
+            return AssetType::Shader;
+        if (extension == ".cpp" || extension == ".h")
+            return AssetType::Script;
+
+        return AssetType::Other;
+    }
+
+    void ProjectIndexer::_OnFilesChanged(const std::vector<FileChange>& changes)
+    {
+        {
+            std::lock_guard lock(_changesMutex);
+            _pendingChanges.insert(_pendingChanges.end(), changes.begin(), changes.end());
+        }
+        _changesCondition.notify_one();
+    }
+
+    void ProjectIndexer::_WorkerThreadFunc()
+    {
+        // Show the last known state right away, the crawl below only corrects it
+        if (_LoadIndex())
+        {
+            _Publish();
+        }
+
+        for (const auto& [directory, children] : _tree)
+        {
+            _dirtyDirectories.insert(directory);
+        }
+        _tree.clear();
+
+        for (const auto& root : _roots)
+        {
+            if (std::filesystem::exists(root))
+            {
+                _Crawl(root);
+            }
+        }
+
+        _previousIndex.clear();
+        _Publish();
+        _SaveIndex();
+
+        auto lastSave = std::chrono::steady_clock::now();
+
+        while (_running)
+        {
+            std::vector<FileChange> changes;
+            {
+                std::unique_lock lock(_changesMutex);
+                _changesCondition.wait_for(
+                    lock, std::chrono::milliseconds(500), [this]() { return !_running || !_pendingChanges.empty(); });
+                changes.swap(_pendingChanges);
+            }
+
+            for (const auto& change : changes)
+            {
+                std::filesystem::path path = change.Path.lexically_normal();
+
+                if (change.Action == FileChangeAction::Rescan)
+                {
+                    _RemoveDirectory(_Key(path));
+
+                    if (std::find(_roots.begin(), _roots.end(), path) != _roots.end())
+                    {
+                        _Crawl(path);
+                        continue;
+                    }
+                }
+
+                _Refresh(path);
+            }
+
+            _Publish();
+
+            auto now = std::chrono::steady_clock::now();
+            if (_indexDirty && now - lastSave > std::chrono::seconds(2))
+            {
+                _SaveIndex();
+                lastSave = now;
+            }
+        }
+
+        if (_indexDirty)
+        {
+            _SaveIndex();
+        }
+    }
+
+    void ProjectIndexer::_Crawl(const std::filesystem::path& directory)
+    {
+        PathKey directoryKey = _Key(directory);
+        Children& children = _tree[directoryKey];
+        _dirtyDirectories.insert(directoryKey);
+        _indexDirty = true;
+
+        std::vector<std::filesystem::path> subDirectories;
+
+        std::error_code ec;
+        for (const auto& entry :
+             std::filesystem::directory_iterator(directory, std::filesystem::directory_options::skip_permission_denied, ec))
+        {
+            if (_IsIgnored(entry.path()))
+            {
+                continue;
+            }
+
+            FileEntry file;
+            if (!_MakeEntry(entry, file))
+            {
+                continue;
+            }
+
+            PathKey key = _Key(file.Path);
+
+            // Files untouched since the last session keep their GUID without reading the .meta again
+            const FileEntry* previous = nullptr;
+            auto previousIt = _previousIndex.find(key);
+            if (previousIt != _previousIndex.end() && previousIt->second.Size == file.Size &&
+                previousIt->second.LastWriteTime == file.LastWriteTime)
+            {
+                previous = &previousIt->second;
+            }
+
+            _ResolveHandle(file, previous);
+
+            if (file.IsDirectory)
+            {
+                subDirectories.push_back(file.Path);
+            }
+
+            children[key] = std::move(file);
+        }
+
+        for (const auto& subDirectory : subDirectories)
+        {
+            _Crawl(subDirectory);
+        }
+    }
+
+    void ProjectIndexer::_Refresh(const std::filesystem::path& changedPath)
+    {
+        std::filesystem::path path = changedPath;
+        bool metadataChanged = false;
+
+        // A changed .meta file means the GUID of its asset must be read again
+        if (path.extension() == ".meta")
+        {
+            path.replace_extension();
+            metadataChanged = true;
+        }
+        else if (_IsIgnored(path))
+        {
+            return;
+        }
+
+        PathKey key = _Key(path);
+        PathKey parentKey = _Key(path.parent_path());
+
+        auto parentIt = _tree.find(parentKey);
+        if (parentIt == _tree.end())
+        {
+            return;
+        }
+        Children& children = parentIt->second;
+
+        std::error_code ec;
+        std::filesystem::directory_entry entry(path, ec);
+        if (ec || !entry.exists(ec))
+        {
+            auto it = children.find(key);
+            if (it != children.end())
+            {
+                if (it->second.IsDirectory)
+                {
+                    _RemoveDirectory(key);
+                }
+
+                children.erase(it);
+                _dirtyDirectories.insert(parentKey);
+                _indexDirty = true;
+            }
+            return;
+        }
+
+        FileEntry file;
+        if (!_MakeEntry(entry, file))
+        {
+            return;
+        }
+
+        const FileEntry* previous = nullptr;
+        auto it = children.find(key);
+        if (it != children.end() && !metadataChanged)
+        {
+            previous = &it->second;
+        }
+
+        _ResolveHandle(file, previous);
+
+        bool isNewDirectory = file.IsDirectory && !_tree.contains(key);
+
+        children[key] = std::move(file);
+        _dirtyDirectories.insert(parentKey);
+        _indexDirty = true;
+
+        if (isNewDirectory)
+        {
+            _Crawl(path);
+        }
+    }
+
+    void ProjectIndexer::_RemoveDirectory(const PathKey& directory)
+    {
+        auto it = _tree.find(directory);
+        if (it == _tree.end())
+        {
+            return;
+        }
+
+        for (const auto& [key, child] : it->second)
+        {
+            if (child.IsDirectory)
+            {
+                _RemoveDirectory(key);
+            }
+        }
+
+        _tree.erase(directory);
+        _dirtyDirectories.insert(directory);
+        _indexDirty = true;
+    }
+
+    bool ProjectIndexer::_MakeEntry(const std::filesystem::directory_entry& entry, FileEntry& outEntry)
+    {
+        std::error_code ec;
+        const auto& path = entry.path();
+
+        outEntry.Path = path.lexically_normal();
+
+        auto u8name = path.filename().u8string();
+        outEntry.Name = std::string(u8name.begin(), u8name.end());
+
+        auto u8ext = path.extension().u8string();
+        outEntry.Extension = std::string(u8ext.begin(), u8ext.end());
+
+        outEntry.IsDirectory = entry.is_directory(ec);
+        if (ec)
+        {
+            return false;
+        }
+
+        outEntry.LastWriteTime = entry.last_write_time(ec);
+        if (ec)
+        {
+            return false;
+        }
+
+        if (outEntry.IsDirectory)
+        {
+            outEntry.Type = AssetType::Directory;
+            return true;
+        }
+
+        outEntry.Type = GetAssetType(outEntry.Extension);
+        outEntry.Size = entry.file_size(ec);
+
+        return !ec;
+    }
+
+    void ProjectIndexer::_ResolveHandle(FileEntry& entry, const FileEntry* previous)
+    {
+        if (entry.IsDirectory)
+        {
+            return;
+        }
+
+        if (previous && previous->Handle.value() != 0)
+        {
+            entry.Handle = previous->Handle;
+            return;
+        }
+
+        MetadataManager::EnsureMetadata(entry.Path);
+        entry.Handle = MetadataManager::GetUUID(entry.Path);
+    }
+
+    bool ProjectIndexer::_IsIgnored(const std::filesystem::path& path) const
+    {
+        auto u8ext = path.extension().u8string();
+        std::string ext(u8ext.begin(), u8ext.end());
+
+        return std::find(_ignoredExtensions.begin(), _ignoredExtensions.end(), ext) != _ignoredExtensions.end();
+    }
+
+    void ProjectIndexer::_Publish()
+    {
+        if (_dirtyDirectories.empty())
+        {
+            return;
+        }
+
+        for (const auto& directory : _dirtyDirectories)
+        {
+            auto it = _tree.find(directory);
+            if (it == _tree.end())
+            {
+                _listings.erase(directory);
+                continue;
+            }
+
+            auto listing = std::make_shared<ProjectIndexSnapshot::Listing>();
+            listing->reserve(it->second.size());
+            for (const auto& [key, child] : it->second)
+            {
+                listing->push_back(child);
+            }
+
+            std::stable_sort(listing->begin(),
+                             listing->end(),
+                             [](const FileEntry& a, const FileEntry& b)
+                             {
+                                 if (a.IsDirectory != b.IsDirectory)
+                                     return a.IsDirectory;
+                                 return a.Name < b.Name;
+                             });
+
+            _listings[directory] = std::move(listing);
+        }
+        _dirtyDirectories.clear();
+
+        auto snapshot = std::make_shared<ProjectIndexSnapshot>();
+        snapshot->_directories = _listings;
+
+        std::lock_guard lock(_snapshotMutex);
+        snapshot->_version = _snapshot->_version + 1;
+        _snapshot = std::move(snapshot);
+    }
+
+    bool ProjectIndexer::_LoadIndex()
+    {
+        std::ifstream in(_indexFile, std::ios::binary);
+        if (!in)
+        {
+            return false;
+        }
+
+        uint32_t magic = 0;
+        uint32_t version = 0;
+        ReadBinary(in, magic);
+        ReadBinary(in, version);
+
+        if (magic != INDEX_MAGIC || version != INDEX_VERSION)
+        {
+            FT_ENGINE_WARN("ProjectIndexer: ignoring outdated index '{}'", _indexFile.string());
+            return false;
+        }
+
+        uint64_t count = 0;
+        ReadBinary(in, count);
+
+        for (uint64_t i = 0; i < count && in; ++i)
+        {
+            std::string relativePath = ReadBinaryString(in);
+
+            FileEntry file;
+            uint8_t type = 0;
+            uint8_t isDirectory = 0;
+            int64_t lastWriteTime = 0;
+            AssetUUID::ValueType handle = 0;
+
+            ReadBinary(in, type);
+            ReadBinary(in, isDirectory);
+            ReadBinary(in, file.Size);
+            ReadBinary(in, lastWriteTime);
+            ReadBinary(in, handle);
+
+            if (!in)
+            {
+                break;
+            }
+
+            file.Path = (_projectDirectory / std::u8string(relativePath.begin(), relativePath.end())).lexically_normal();
+
+            auto u8name = file.Path.filename().u8string();
+            file.Name = std::string(u8name.begin(), u8name.end());
+
+            auto u8ext = file.Path.extension().u8string();
+            file.Extension = std::string(u8ext.begin(), u8ext.end());
+
+            file.Type = static_cast<AssetType>(type);
+            file.IsDirectory = isDirectory != 0;
+            file.LastWriteTime =
+                std::filesystem::file_time_type(std::filesystem::file_time_type::duration(lastWriteTime));
+            file.Handle = AssetUUID(handle);
+
+            PathKey key = _Key(file.Path);
+            PathKey parentKey = _Key(file.Path.parent_path());
+
+            _tree[parentKey][key] = file;
+            _dirtyDirectories.insert(parentKey);
+            _previousIndex[key] = std::move(file);
+        }
+
+        return !_previousIndex.empty();
+    }
+
+    void ProjectIndexer::_SaveIndex()
+    {
+        std::error_code ec;
+        std::filesystem::create_directories(_indexFile.parent_path(), ec);
+
+        std::filesystem::path tempFile = _indexFile;
+        tempFile += ".tmp";
+
+        {
+            std::ofstream out(tempFile, std::ios::binary | std::ios::trunc);
+            if (!out)
+            {
+                FT_ENGINE_WARN("ProjectIndexer: cannot write index '{}'", _indexFile.string());
+                return;
+            }
+
+            uint64_t count = 0;
+            for (const auto& [directory, children] : _tree)
+            {
+                count += children.size();
+            }
+
+            WriteBinary(out, INDEX_MAGIC);
+            WriteBinary(out, INDEX_VERSION);
+            WriteBinary(out, count);
+
+            for (const auto& [directory, children] : _tree)
+            {
+                for (const auto& [key, file] : children)
+                {
+                    auto u8path = file.Path.lexically_relative(_projectDirectory).u8string();
+
+                    WriteBinaryString(out, std::string(u8path.begin(), u8path.end()));
+                    WriteBinary(out, static_cast<uint8_t>(file.Type));
+                    WriteBinary(out, static_cast<uint8_t>(file.IsDirectory ? 1 : 0));
+                    WriteBinary(out, file.Size);
+                    WriteBinary(out, static_cast<int64_t>(file.LastWriteTime.time_since_epoch().count()));
+                    WriteBinary(out, file.Handle.value());
+                }
+            }
+        }
+
+        std::filesystem::rename(tempFile, _indexFile, ec);
+        _indexDirty = false;
+    }
+
+    ProjectIndexer::PathKey ProjectIndexer::_Key(const std::filesystem::path& path)
+    {
+        return path.lexically_normal().native();
+    }
+} // namespace Editor
@@ -0,0 +1,130 @@
+#pragma once
+
+#include "Editor/UI/ContentBrowser/AssetMetadata.h"
+#include "Editor/Utils/FileWatcher.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <filesystem>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace Editor
+{
+    enum class AssetType : uint8_t
+    {
+        Directory,
+        Scene,
+        Prefab,
+        Model,
+        Texture,
+        Shader,
+        Script,
+        Other
+    };
+
+    struct FileEntry
+    {
+        std::filesystem::path Path;
+        std::string Name;
+        std::string Extension;
+        bool IsDirectory = false;
+
+        AssetType Type = AssetType::Other;
+        uint64_t Size = 0;
+        std::filesystem::file_time_type LastWriteTime;
+        AssetUUID Handle{ static_cast<AssetUUID::ValueType>(0) };
+    };
+
+    // Immutable view of the project files, safe to read from the UI thread while the indexer keeps working
+    class ProjectIndexSnapshot
+    {
+    public:
+        using Listing = std::vector<FileEntry>;
+
+        const Listing* GetDirectory(const std::filesystem::path& directory) const;
+        const FileEntry* Find(const std::filesystem::path& path) const;
+
+        uint64_t GetVersion() const { return _version; }
+        size_t GetDirectoryCount() const { return _directories.size(); }
+
+    private:
+        uint64_t _version = 0;
+        std::unordered_map<std::filesystem::path::string_type, std::shared_ptr<const Listing>> _directories;
+
+        friend class ProjectIndexer;
+    };
+
+    class ProjectIndexer
+    {
+    public:
+        ProjectIndexer(const std::filesystem::path& projectDirectory,
+                       const std::vector<std::filesystem::path>& roots,
+                       const std::vector<std::string>& ignoredExtensions);
+        ~ProjectIndexer();
+
+        void Start();
+        void Stop();
+
+        std::shared_ptr<const ProjectIndexSnapshot> GetSnapshot() const;
+
+        // Re-stat a path on the worker thread, used after the editor itself touched the disk
+        void Invalidate(const std::filesystem::path& path);
+
+        static AssetType GetAssetType(const std::string& extension);
+
+    private:
+        using PathKey = std::filesystem::path::string_type;
+        using Children = std::map<PathKey, FileEntry>;
+
+        void _WorkerThreadFunc();
+        void _OnFilesChanged(const std::vector<FileChange>& changes);
+
+        void _Crawl(const std::filesystem::path& directory);
+        void _Refresh(const std::filesystem::path& path);
+        void _RemoveDirectory(const PathKey& directory);
+        bool _MakeEntry(const std::filesystem::directory_entry& entry, FileEntry& outEntry);
+        void _ResolveHandle(FileEntry& entry, const FileEntry* previous);
+        bool _IsIgnored(const std::filesystem::path& path) const;
+
+        void _Publish();
+        bool _LoadIndex();
+        void _SaveIndex();
+
+        static PathKey _Key(const std::filesystem::path& path);
+
+    private:
+        std::filesystem::path _projectDirectory;
+        std::filesystem::path _indexFile;
+        std::vector<std::filesystem::path> _roots;
+        std::vector<std::string> _ignoredExtensions;
+
+        std::vector<std::unique_ptr<FileWatcher>> _watchers;
+        std::thread _workerThread;
+        std::atomic<bool> _running = false;
+
+        // Changes reported by the watchers, consumed by the worker
+        std::mutex _changesMutex;
+        std::condition_variable _changesCondition;
+        std::vector<FileChange> _pendingChanges;
+
+        // Worker state, only touched by the worker thread
+        std::unordered_map<PathKey, Children> _tree;
+        std::unordered_map<PathKey, FileEntry> _previousIndex;
+        std::unordered_set<PathKey> _dirtyDirectories;
+        std::unordered_map<PathKey, std::shared_ptr<const ProjectIndexSnapshot::Listing>> _listings;
+        bool _indexDirty = false;
+
+        mutable std::mutex _snapshotMutex;
+        std::shared_ptr<const ProjectIndexSnapshot> _snapshot;
+
+        static constexpr uint32_t INDEX_MAGIC = 0x58495446; // "FTIX"
+        static constexpr uint32_t INDEX_VERSION = 1;
+    };
+} // namespace Editor
@@ -1,13 +1,12 @@
 #include "Editor/UI/ContentBrowser/AssetIconManager.h"
+#include "Frost/Asset/AssetManager.h"
 #include "Frost/Scene/Components/Transform.h"
 #include "Frost/Scene/Components/Camera.h"
 #include "Frost/Scene/Components/StaticMesh.h"
 #include "Frost/Scene/Components/Light.h"
-#include "Frost/Asset/MeshConfig.h"
+#include "Frost/Renderer/RendererAPI.h"
 #include "Editor/EditorApp.h"
 
-#include <thread>
-
 #undef max
 
 using namespace Frost;
@@ -16,7 +15,8 @@ using namespace Frost::Component;
 
 namespace Editor
 {
-    AssetIconManager::AssetIconManager()
+    AssetIconManager::AssetIconManager() :
+        _cacheFile(EditorApp::Get().GetProjectDirectory(), THUMBNAIL_SIZE)
     {
         Frost::TextureConfig folderConfig;
         folderConfig.debugName = "FolderIcon";
@@ -29,199 +29,502 @@ namespace Editor
         _folderIcon = Frost::Texture::Create(folderConfig);
         _fileIcon = Frost::Texture::Create(fileConfig);
 
-        auto _projectFolder = EditorApp::Get().GetProjectDirectory();
-        _thumbnailCacheDir = _projectFolder / ".frost" / "thumbnails";
-        if (!std::filesystem::exists(_thumbnailCacheDir))
+        _cacheFile.LoadAsync();
+    }
+
+    AssetIconManager::~AssetIconManager()
+    {
+        if (_cacheDirty)
         {
-            std::filesystem::create_directories(_thumbnailCacheDir);
+            // The cache destructor waits for the write to finish
+            _cacheFile.SaveAsync(_CollectCacheRecords());
         }
     }
 
-    std::filesystem::path AssetIconManager::_GetCachePath(const std::filesystem::path& assetPath)
+    void AssetIconManager::Update()
     {
-        std::string pathStr = std::filesystem::absolute(assetPath).string();
-        size_t hash = std::hash<std::string>{}(pathStr);
-        return _thumbnailCacheDir / (std::to_string(hash) + ".png");
+        auto deadline = std::chrono::steady_clock::now() + FRAME_BUDGET;
+
+        if (!_diskRecordsLoaded)
+        {
+            std::vector<ThumbnailCache::Record> records;
+            if (_cacheFile.PollLoaded(records))
+            {
+                for (auto& record : records)
+                {
+                    std::string pathKey = record.path.string();
+                    _diskRecords[pathKey] = std::move(record);
+                }
+                _diskRecordsLoaded = true;
+            }
+        }
+
+        _UpdateTextureJobs();
+
+        // Baking before the cache is read would redo thumbnails that are already on disk
+        if (_diskRecordsLoaded)
+        {
+            _UpdateThumbnailJobs(deadline);
+        }
+
+        _UpdateReadbacks();
+        _UpdateCacheFile();
     }
 
-    void AssetIconManager::Update()
+    void AssetIconManager::_UpdateTextureJobs()
     {
-        if (!_loadQueue.empty())
+        while (!_textureQueue.empty() && _textureJobs.size() < MAX_LOADS_IN_FLIGHT)
         {
-            std::filesystem::path assetPath = _loadQueue.front();
-            _loadQueue.pop_front();
+            FileEntry file = std::move(_textureQueue.front());
+            _textureQueue.pop_front();
+
+            Frost::TextureConfig config;
+            config.path = file.Path.string();
+            config.debugName = file.Path.string();
+            config.loadImmediately = false;
+
+            TextureJob job;
+            job.file = std::move(file);
+            job.texture = Frost::Texture::Create(config);
+            job.cpuLoad = std::async(std::launch::async,
+                                     [texture = job.texture, config]() { texture->LoadCPU(config.path, config); });
+            _textureJobs.push_back(std::move(job));
+        }
 
-            std::string pathKey = assetPath.string();
-            std::shared_ptr<Frost::Texture> newIcon = nullptr;
-            std::string ext = assetPath.extension().string();
+        for (auto it = _textureJobs.begin(); it != _textureJobs.end();)
+        {
+            if (it->cpuLoad.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+            {
+                ++it;
+                continue;
+            }
 
-            if (ext == ".png" || ext == ".jpg" || ext == ".dds" || ext == ".tga")
+            if (!it->cancelled)
             {
-                Frost::TextureConfig config;
-                config.path = assetPath.string();
-                config.debugName = pathKey;
-                newIcon = Frost::Texture::Create(config);
+                it->texture->UploadGPU();
+                _StoreIcon(it->file, { it->texture->IsLoaded() ? it->texture : _fileIcon });
             }
-            else if (_IsModelFormat(ext))
+
+            it = _textureJobs.erase(it);
+        }
+    }
+
+    void AssetIconManager::_UpdateThumbnailJobs(std::chrono::steady_clock::time_point deadline)
+    {
+        size_t modelsInFlight = 0;
+        bool finishedAny = false;
+
+        for (auto it = _thumbnailJobs.begin(); it != _thumbnailJobs.end();)
+        {
+            if (std::chrono::steady_clock::now() >= deadline)
             {
-                std::filesystem::path cachePath = _GetCachePath(assetPath);
-                bool cacheValid = false;
+                break;
+            }
 
-                // Cache for performance
-                if (std::filesystem::exists(cachePath))
-                {
-                    auto assetTime = std::filesystem::last_write_time(assetPath);
-                    auto cacheTime = std::filesystem::last_write_time(cachePath);
+            ThumbnailJob& job = *it;
+            std::string pathKey = job.file.Path.string();
+            int32_t slot = -1;
 
-                    if (cacheTime >= assetTime)
+            if (!job.model)
+            {
+                // A thumbnail baked by a previous session only needs to be copied into the atlas
+                auto record = _diskRecords.find(pathKey);
+                if (record != _diskRecords.end() && record->second.lastWriteTime >= job.file.LastWriteTime)
+                {
+                    slot = _AllocateSlot();
+                    if (!_UploadThumbnail(record->second.pixels, slot))
                     {
-                        Frost::TextureConfig config;
-                        config.path = cachePath.string();
-                        config.debugName = "ThumbCache_" + assetPath.stem().string();
-                        newIcon = Frost::Texture::Create(config);
-                        cacheValid = true;
+                        _ReleaseSlot(slot);
+                        slot = -1;
                     }
+
+                    std::vector<uint8_t> pixels = slot >= 0 ? std::move(record->second.pixels) : std::vector<uint8_t>{};
+                    _diskRecords.erase(record);
+                    _StoreIcon(
+                        job.file, slot >= 0 ? _GetSlotIcon(slot) : AssetIcon{ _fileIcon }, slot, std::move(pixels));
+                    it = _thumbnailJobs.erase(it);
+                    continue;
                 }
 
-                if (!cacheValid)
+                if (modelsInFlight >= MAX_LOADS_IN_FLIGHT)
                 {
-                    auto renderTex = _GenerateModelThumbnail(assetPath);
-                    if (renderTex)
-                    {
-                        renderTex->SaveToFile(cachePath.string());
+                    ++it;
+                    continue;
+                }
 
-                        Frost::TextureConfig config;
-                        config.path = cachePath.string();
-                        newIcon = Frost::Texture::Create(config);
+                job.model = AssetManager::LoadAsset<Model>(pathKey);
+            }
 
-                        // Save memory by pruning unused assets
-                        Frost::AssetManager::PruneUnused();
-                    }
-                }
+            ++modelsInFlight;
+
+            AssetStatus status = job.model->GetStatus();
+            bool failed = status == AssetStatus::Failed || (status == AssetStatus::Loaded && !job.model->HasMeshes());
+
+            // Textures that never finish loading only cost their albedo, the bake goes on without them
+            if (!failed && (status != AssetStatus::Loaded ||
+                            (!_IsModelReady(*job.model) && job.waitedFrames++ < MAX_TEXTURE_WAIT_FRAMES)))
+            {
+                ++it;
+                continue;
             }
 
-            if (newIcon)
+            if (!failed && !_bakeScene)
             {
-                try
-                {
-                    auto time = std::filesystem::last_write_time(assetPath);
-                    _iconCache[pathKey] = { newIcon, time };
-                }
-                catch (...)
+                _CreateBakeScene();
+            }
+
+            // Every staging texture still waits for the GPU, the bake is retried on a later frame
+            if (!failed && _freeStaging.empty())
+            {
+                ++it;
+                continue;
+            }
+
+            size_t staging = 0;
+            if (!failed)
+            {
+                slot = _AllocateSlot();
+                staging = _freeStaging.back();
+                if (!_BakeThumbnail(job, slot, staging))
                 {
-                    _iconCache[pathKey] = { newIcon, std::filesystem::file_time_type() };
+                    _ReleaseSlot(slot);
+                    slot = -1;
                 }
             }
 
-            _pendingPaths.erase(pathKey);
+            // Failures are cached too, otherwise the asset would be queued again on the next frame
+            _StoreIcon(job.file, slot >= 0 ? _GetSlotIcon(slot) : AssetIcon{ _fileIcon }, slot);
+            _diskRecords.erase(pathKey);
+
+            if (slot >= 0)
+            {
+                _freeStaging.pop_back();
+                _readbacks.push_back({ pathKey, slot, staging });
+            }
+
+            it = _thumbnailJobs.erase(it);
+            finishedAny = true;
+        }
+
+        if (finishedAny && _thumbnailJobs.empty())
+        {
+            // The baked models are only referenced by the asset manager now
+            Frost::AssetManager::PruneUnused();
         }
     }
 
-    std::shared_ptr<Frost::Texture> AssetIconManager::GetIcon(const std::filesystem::path& path, bool isDirectory)
+    void AssetIconManager::_UpdateReadbacks()
     {
-        if (isDirectory)
+        for (auto it = _readbacks.begin(); it != _readbacks.end();)
         {
-            return _folderIcon;
+            std::vector<uint8_t> pixels;
+            if (!_stagingTextures[it->staging]->TryReadPixels(pixels))
+            {
+                ++it;
+                continue;
+            }
+
+            // The asset may have been baked again or cleared while the copy was in flight
+            auto entry = _iconCache.find(it->pathKey);
+            if (entry != _iconCache.end() && entry->second.slot == it->slot)
+            {
+                entry->second.pixels = std::move(pixels);
+                _cacheDirty = true;
+                _lastBakeTime = std::chrono::steady_clock::now();
+            }
+
+            _freeStaging.push_back(it->staging);
+            it = _readbacks.erase(it);
         }
+    }
 
-        std::string pathKey = path.string();
+    void AssetIconManager::_UpdateCacheFile()
+    {
+        if (!_cacheDirty || _cacheFile.IsBusy() || !_thumbnailJobs.empty() || !_readbacks.empty())
+        {
+            return;
+        }
 
-        if (_iconCache.contains(pathKey))
+        if (std::chrono::steady_clock::now() - _lastBakeTime < SAVE_DELAY)
         {
-            return _iconCache.at(pathKey).texture;
+            return;
         }
 
-        if (_pendingPaths.contains(pathKey))
+        _cacheFile.SaveAsync(_CollectCacheRecords());
+        _cacheDirty = false;
+    }
+
+    std::vector<ThumbnailCache::Record> AssetIconManager::_CollectCacheRecords()
+    {
+        std::vector<ThumbnailCache::Record> records;
+        records.reserve(_iconCache.size() + _diskRecords.size());
+
+        for (const auto& [pathKey, entry] : _iconCache)
         {
-            return _fileIcon;
+            if (entry.slot < 0 || entry.pixels.empty())
+            {
+                continue;
+            }
+
+            records.push_back({ pathKey, entry.lastWriteTime, entry.pixels });
         }
 
-        _pendingPaths.insert(pathKey);
-        _loadQueue.push_back(path);
+        // Thumbnails of assets not displayed during this session stay in the file
+        for (const auto& [pathKey, record] : _diskRecords)
+        {
+            records.push_back(record);
+        }
 
-        return _fileIcon;
+        return records;
     }
 
-    std::shared_ptr<Frost::Texture> AssetIconManager::_GenerateModelThumbnail(const std::filesystem::path& path)
+    AssetIcon AssetIconManager::GetIcon(const FileEntry& file)
     {
-        uint32_t thumbSize = 256;
-        Frost::TextureConfig texConfig = {};
-        texConfig.width = thumbSize;
-        texConfig.height = thumbSize;
-        texConfig.format = Frost::Format::RGBA8_UNORM;
-        texConfig.isRenderTarget = true;
-        texConfig.isShaderResource = true;
-        texConfig.hasMipmaps = false;
-        texConfig.debugName = "Thumbnail_" + path.filename().string();
+        if (file.IsDirectory)
+        {
+            return { _folderIcon };
+        }
+
+        if (file.Type != AssetType::Texture && file.Type != AssetType::Model)
+        {
+            return { _fileIcon };
+        }
+
+        std::string pathKey = file.Path.string();
+
+        // The index already knows the write time, a newer one means the icon is stale
+        auto it = _iconCache.find(pathKey);
+        if (it != _iconCache.end() && it->second.lastWriteTime >= file.LastWriteTime)
+        {
+            return it->second.icon;
+        }
 
-        auto thumbnailTexture = Frost::Texture::Create(texConfig);
+        AssetIcon currentIcon = it != _iconCache.end() ? it->second.icon : AssetIcon{ _fileIcon };
 
-        Frost::Scene tempScene("ThumbnailGen");
+        if (_pendingPaths.contains(pathKey))
+        {
+            return currentIcon;
+        }
 
-        auto meshEntity = tempScene.CreateGameObject("Mesh");
-        auto& sm = meshEntity.AddComponent<StaticMesh>(MeshSourceFile{ path.string() });
-        meshEntity.AddComponent<Transform>();
+        _pendingPaths.insert(pathKey);
 
-        if (!sm.GetModel() || !sm.GetModel()->HasMeshes())
+        if (file.Type == AssetType::Texture)
+        {
+            _textureQueue.push_back(file);
+        }
+        else
         {
-            return nullptr;
+            _thumbnailJobs.push_back({ file });
         }
 
-        auto model = sm.GetModel();
-        int maxWaitFrames = 200;
-        bool allTexturesReady = false;
+        return currentIcon;
+    }
+
+    void AssetIconManager::_StoreIcon(const FileEntry& file,
+                                      const AssetIcon& icon,
+                                      int32_t slot,
+                                      std::vector<uint8_t> pixels)
+    {
+        std::string pathKey = file.Path.string();
 
-        while (!allTexturesReady && maxWaitFrames > 0)
+        // The stale tile stayed on screen until now, it can be reused
+        auto it = _iconCache.find(pathKey);
+        if (it != _iconCache.end() && it->second.slot >= 0)
         {
-            allTexturesReady = true;
-            for (const auto& mat : model->GetMaterials())
+            _ReleaseSlot(it->second.slot);
+        }
+
+        _iconCache[pathKey] = { icon, file.LastWriteTime, slot, std::move(pixels) };
+        _pendingPaths.erase(pathKey);
+    }
+
+    bool AssetIconManager::_IsModelReady(const Frost::Model& model) const
+    {
+        for (const auto& mat : model.GetMaterials())
+        {
+            for (const auto& tex : mat.albedoTextures)
             {
-                for (const auto& tex : mat.albedoTextures)
+                if (tex && tex->GetStatus() != AssetStatus::Loaded && tex->GetStatus() != AssetStatus::Failed)
                 {
-                    if (tex)
-                    {
-                        if (tex->GetStatus() != Frost::AssetStatus::Loaded)
-                        {
-                            allTexturesReady = false;
-                            tex->UploadGPU();
-                        }
-                    }
+                    return false;
                 }
-                if (!allTexturesReady)
-                    break;
             }
+        }
 
-            if (!allTexturesReady)
-            {
-                std::this_thread::sleep_for(std::chrono::milliseconds(5));
-                maxWaitFrames--;
-            }
+        return true;
+    }
+
+    bool AssetIconManager::_BakeThumbnail(const ThumbnailJob& job, int32_t slot, size_t staging)
+    {
+        if (!_bakeTarget->IsLoaded() || !_stagingTextures[staging]->IsLoaded())
+        {
+            return false;
         }
 
-        auto cameraEntity = tempScene.CreateGameObject("Camera");
-        auto& camComp = cameraEntity.AddComponent<Camera>();
+        auto& staticMesh = _bakeMesh.GetComponent<StaticMesh>();
+        staticMesh.SetModel(job.model);
+        _FocusCameraOnBounds(_bakeCamera.GetComponent<Transform>(), job.model->GetBoundingBox());
+
+        _bakeScene->Update(0.016f);
+        _bakeScene->LateUpdate(0.016f);
+
+        staticMesh.SetModel(nullptr);
+
+        uint32_t tile = slot % TILES_PER_PAGE;
+
+        // The bake target is reused right away, copy it before the next thumbnail is rendered
+        _commandList->BeginRecording();
+        _commandList->CopyTextureRegion(_atlasPages[slot / TILES_PER_PAGE].get(),
+                                        (tile % TILES_PER_ROW) * THUMBNAIL_SIZE,
+                                        (tile / TILES_PER_ROW) * THUMBNAIL_SIZE,
+                                        _bakeTarget.get());
+        // Read back a few frames later, for the cache file, once the copy has completed
+        _commandList->CopyResource(_stagingTextures[staging].get(), _bakeTarget.get());
+        _commandList->EndRecording();
+        _commandList->Execute();
+
+        return true;
+    }
+
+    bool AssetIconManager::_UploadThumbnail(const std::vector<uint8_t>& pixels, int32_t slot)
+    {
+        if (pixels.size() != static_cast<size_t>(THUMBNAIL_SIZE) * THUMBNAIL_SIZE * 4)
+        {
+            return false;
+        }
+
+        Frost::TextureConfig config;
+        config.width = THUMBNAIL_SIZE;
+        config.height = THUMBNAIL_SIZE;
+        config.format = Frost::Format::RGBA8_UNORM;
+        config.fileData = pixels;
+        config.hasMipmaps = false;
+        config.debugName = "ThumbnailUpload";
+
+        auto upload = Frost::Texture::Create(config);
+        if (!upload->IsLoaded())
+        {
+            return false;
+        }
+
+        if (!_commandList)
+        {
+            _commandList = RendererAPI::GetRenderer()->GetNewCommandList();
+        }
+
+        uint32_t tile = slot % TILES_PER_PAGE;
+
+        _commandList->BeginRecording();
+        _commandList->CopyTextureRegion(_atlasPages[slot / TILES_PER_PAGE].get(),
+                                        (tile % TILES_PER_ROW) * THUMBNAIL_SIZE,
+                                        (tile / TILES_PER_ROW) * THUMBNAIL_SIZE,
+                                        upload.get());
+        _commandList->EndRecording();
+        _commandList->Execute();
+
+        return true;
+    }
+
+    void AssetIconManager::_CreateBakeScene()
+    {
+        Frost::TextureConfig texConfig = {};
+        texConfig.width = THUMBNAIL_SIZE;
+        texConfig.height = THUMBNAIL_SIZE;
+        texConfig.format = Frost::Format::RGBA8_UNORM;
+        texConfig.isRenderTarget = true;
+        texConfig.isShaderResource = true;
+        texConfig.hasMipmaps = false;
+        texConfig.debugName = "ThumbnailBakeTarget";
+
+        _bakeTarget = Frost::Texture::Create(texConfig);
+
+        Frost::TextureConfig stagingConfig = {};
+        stagingConfig.width = THUMBNAIL_SIZE;
+        stagingConfig.height = THUMBNAIL_SIZE;
+        stagingConfig.format = Frost::Format::RGBA8_UNORM;
+        stagingConfig.isReadback = true;
+        stagingConfig.isShaderResource = false;
+        stagingConfig.hasMipmaps = false;
+        stagingConfig.debugName = "ThumbnailStaging";
+
+        for (size_t i = 0; i < STAGING_RING_SIZE; ++i)
+        {
+            _stagingTextures.push_back(Frost::Texture::Create(stagingConfig));
+            _freeStaging.push_back(i);
+        }
+
+        if (!_commandList)
+        {
+            _commandList = RendererAPI::GetRenderer()->GetNewCommandList();
+        }
+
+        _bakeScene = std::make_unique<Frost::Scene>("ThumbnailGen");
+
+        _bakeMesh = _bakeScene->CreateGameObject("Mesh");
+        _bakeMesh.AddComponent<StaticMesh>();
+
+        _bakeCamera = _bakeScene->CreateGameObject("Camera");
+        auto& camComp = _bakeCamera.AddComponent<Camera>();
         camComp.viewport = { 0.0f, 0.0f, 1.0f, 1.0f };
         camComp.nearClip = 0.1f;
         camComp.farClip = 1000.0f;
 
-        auto& camTrans = cameraEntity.AddComponent<Transform>();
-
-        Frost::BoundingBox bounds = sm.GetModel()->GetBoundingBox();
-        _FocusCameraOnBounds(camTrans, bounds);
-
-        auto lightEntity = tempScene.CreateGameObject("Light");
+        auto lightEntity = _bakeScene->CreateGameObject("Light");
         auto& lightComp = lightEntity.AddComponent<Frost::Component::Light>(LightDirectional{});
         lightComp.intensity = 1.2f;
         lightComp.color = { 1.0f, 0.95f, 0.9f };
 
-        auto& lightTrans = lightEntity.AddComponent<Frost::Component::Transform>();
+        auto& lightTrans = lightEntity.GetComponent<Frost::Component::Transform>();
         lightTrans.Rotate(Frost::Math::EulerAngles{ -45.0f, 45.0f, 0.0f });
 
-        tempScene.SetEditorRenderTarget(thumbnailTexture);
-        tempScene.Update(0.016f);
-        tempScene.LateUpdate(0.016f);
+        _bakeScene->SetEditorRenderTarget(_bakeTarget);
+    }
 
-        return thumbnailTexture;
+    int32_t AssetIconManager::_AllocateSlot()
+    {
+        if (_freeSlots.empty())
+        {
+            Frost::TextureConfig config = {};
+            config.width = ATLAS_SIZE;
+            config.height = ATLAS_SIZE;
+            config.format = Frost::Format::RGBA8_UNORM;
+            config.isRenderTarget = true;
+            config.isShaderResource = true;
+            config.hasMipmaps = false;
+            config.debugName = "ThumbnailAtlas_" + std::to_string(_atlasPages.size());
+
+            _atlasPages.push_back(Frost::Texture::Create(config));
+
+            // Reversed so that tiles are handed out from the top left corner
+            for (int32_t i = TILES_PER_PAGE - 1; i >= 0; --i)
+            {
+                _freeSlots.push_back(_slotCount + i);
+            }
+            _slotCount += TILES_PER_PAGE;
+        }
+
+        int32_t slot = _freeSlots.back();
+        _freeSlots.pop_back();
+        return slot;
+    }
+
+    void AssetIconManager::_ReleaseSlot(int32_t slot)
+    {
+        _freeSlots.push_back(slot);
+    }
+
+    AssetIcon AssetIconManager::_GetSlotIcon(int32_t slot) const
+    {
+        uint32_t tile = slot % TILES_PER_PAGE;
+        float tileSize = static_cast<float>(THUMBNAIL_SIZE) / ATLAS_SIZE;
+        float u = (tile % TILES_PER_ROW) * tileSize;
+        float v = (tile / TILES_PER_ROW) * tileSize;
+
+        AssetIcon icon;
+        icon.texture = _atlasPages[slot / TILES_PER_PAGE];
+        icon.uv0 = { u, v };
+        icon.uv1 = { u + tileSize, v + tileSize };
+        return icon;
     }
 
     void AssetIconManager::_FocusCameraOnBounds(Frost::Component::Transform& cameraTransform,
@@ -254,14 +557,29 @@ namespace Editor
         cameraTransform.LookAt(center);
     }
 
-    bool AssetIconManager::_IsModelFormat(const std::string& extension)
-    {
-        return std::find(MESH_FILE_EXTENSIONS.begin(), MESH_FILE_EXTENSIONS.end(), extension) !=
-               MESH_FILE_EXTENSIONS.end();
-    }
-
     void AssetIconManager::ClearCache()
     {
+        for (const auto& [pathKey, entry] : _iconCache)
+        {
+            if (entry.slot >= 0)
+            {
+                _ReleaseSlot(entry.slot);
+            }
+        }
         _iconCache.clear();
+
+        // Queued and in-flight requests would store icons for the cleared entries
+        _pendingPaths.clear();
+        _textureQueue.clear();
+        _thumbnailJobs.clear();
+        for (const auto& readback : _readbacks)
+        {
+            _freeStaging.push_back(readback.staging);
+        }
+        _readbacks.clear();
+        for (auto& job : _textureJobs)
+        {
+            job.cancelled = true;
+        }
     }
-} // namespace Editor
\ No newline at end of file
+} // namespace Editor
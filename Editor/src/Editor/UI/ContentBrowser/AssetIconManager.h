@@ -1,49 +1,142 @@
 #pragma once
 
+#include "Editor/Project/ProjectIndexer.h"
+#include "Editor/UI/ContentBrowser/ThumbnailCache.h"
+
+#include "Frost/Asset/Model.h"
 #include "Frost/Asset/Texture.h"
+#include "Frost/Renderer/CommandList.h"
 #include "Frost/Scene/Scene.h"
+#include "Frost/Scene/ECS/GameObject.h"
 #include "Frost/Scene/Components/Transform.h"
 #include "Frost/Renderer/BoundingBox.h"
+#include "Frost/Utils/Math/Vector.h"
 
+#include <chrono>
 #include <deque>
 #include <filesystem>
+#include <future>
+#include <memory>
 #include <unordered_map>
 #include <unordered_set>
 
 namespace Editor
 {
+    struct AssetIcon
+    {
+        std::shared_ptr<Frost::Texture> texture;
+        Frost::Math::Vector2 uv0 = { 0.0f, 0.0f };
+        Frost::Math::Vector2 uv1 = { 1.0f, 1.0f };
+    };
 
     class AssetIconManager
     {
     public:
         AssetIconManager();
-        ~AssetIconManager() = default;
+        ~AssetIconManager();
 
         void Update();
 
-        std::shared_ptr<Frost::Texture> GetIcon(const std::filesystem::path& path, bool isDirectory);
+        AssetIcon GetIcon(const FileEntry& file);
 
         void ClearCache();
 
     private:
-        std::shared_ptr<Frost::Texture> _GenerateModelThumbnail(const std::filesystem::path& path);
-        void _FocusCameraOnBounds(Frost::Component::Transform& cameraTransform, const Frost::BoundingBox& bounds);
-        bool _IsModelFormat(const std::string& extension);
-        std::filesystem::path _GetCachePath(const std::filesystem::path& assetPath);
+        struct TextureJob
+        {
+            FileEntry file;
+            std::shared_ptr<Frost::Texture> texture;
+            std::future<void> cpuLoad;
+            // Set by ClearCache, the load is left to finish but its icon is dropped
+            bool cancelled = false;
+        };
+
+        struct ThumbnailJob
+        {
+            FileEntry file;
+            std::shared_ptr<Frost::Model> model;
+            uint32_t waitedFrames = 0;
+        };
+
+        // A baked tile copied into a staging texture, read back once the GPU is done with it
+        struct PendingReadback
+        {
+            std::string pathKey;
+            int32_t slot = -1;
+            size_t staging = 0;
+        };
 
-    private:
         struct CacheEntry
         {
-            std::shared_ptr<Frost::Texture> texture;
+            AssetIcon icon;
             std::filesystem::file_time_type lastWriteTime;
+            int32_t slot = -1;
+            // RGBA copy of the atlas tile, kept so that saving the cache file reads nothing back from the GPU
+            std::vector<uint8_t> pixels;
         };
 
+        void _UpdateTextureJobs();
+        void _UpdateThumbnailJobs(std::chrono::steady_clock::time_point deadline);
+        void _UpdateReadbacks();
+        void _UpdateCacheFile();
+
+        void _StoreIcon(const FileEntry& file,
+                        const AssetIcon& icon,
+                        int32_t slot = -1,
+                        std::vector<uint8_t> pixels = {});
+        bool _IsModelReady(const Frost::Model& model) const;
+        bool _BakeThumbnail(const ThumbnailJob& job, int32_t slot, size_t staging);
+        bool _UploadThumbnail(const std::vector<uint8_t>& pixels, int32_t slot);
+        void _CreateBakeScene();
+        void _FocusCameraOnBounds(Frost::Component::Transform& cameraTransform, const Frost::BoundingBox& bounds);
+
+        int32_t _AllocateSlot();
+        void _ReleaseSlot(int32_t slot);
+        AssetIcon _GetSlotIcon(int32_t slot) const;
+        std::vector<ThumbnailCache::Record> _CollectCacheRecords();
+
+    private:
         std::shared_ptr<Frost::Texture> _folderIcon;
         std::shared_ptr<Frost::Texture> _fileIcon;
         std::unordered_map<std::string, CacheEntry> _iconCache;
-        std::deque<std::filesystem::path> _loadQueue;
         std::unordered_set<std::string> _pendingPaths;
 
-        std::filesystem::path _thumbnailCacheDir;
+        std::deque<FileEntry> _textureQueue;
+        std::vector<TextureJob> _textureJobs;
+        std::deque<ThumbnailJob> _thumbnailJobs;
+
+        // Model thumbnails live in tiles of shared atlas render targets
+        std::vector<std::shared_ptr<Frost::Texture>> _atlasPages;
+        std::vector<int32_t> _freeSlots;
+        int32_t _slotCount = 0;
+
+        // Scene and target reused by every bake
+        std::unique_ptr<Frost::Scene> _bakeScene;
+        Frost::GameObject _bakeMesh;
+        Frost::GameObject _bakeCamera;
+        std::shared_ptr<Frost::Texture> _bakeTarget;
+        std::shared_ptr<Frost::CommandList> _commandList;
+
+        // Ring of staging textures, a bake waits for a free one instead of stalling on a readback
+        std::vector<std::shared_ptr<Frost::Texture>> _stagingTextures;
+        std::vector<size_t> _freeStaging;
+        std::vector<PendingReadback> _readbacks;
+
+        ThumbnailCache _cacheFile;
+        std::unordered_map<std::string, ThumbnailCache::Record> _diskRecords;
+        bool _diskRecordsLoaded = false;
+        bool _cacheDirty = false;
+        std::chrono::steady_clock::time_point _lastBakeTime;
+
+        static constexpr uint32_t THUMBNAIL_SIZE = 128;
+        static constexpr uint32_t ATLAS_SIZE = 2048;
+        static constexpr uint32_t TILES_PER_ROW = ATLAS_SIZE / THUMBNAIL_SIZE;
+        static constexpr uint32_t TILES_PER_PAGE = TILES_PER_ROW * TILES_PER_ROW;
+
+        static constexpr size_t MAX_LOADS_IN_FLIGHT = 4;
+        static constexpr size_t STAGING_RING_SIZE = 4;
+        static constexpr uint32_t MAX_TEXTURE_WAIT_FRAMES = 120;
+        static constexpr std::chrono::microseconds FRAME_BUDGET{ 4000 };
+        static constexpr std::chrono::seconds SAVE_DELAY{ 2 };
     };
-} // namespace Editor
\ No newline at end of file
+} // namespace Editor
@@ -1,5 +1,4 @@
 ﻿#include "Editor/UI/ContentBrowser/ContentBrowser.h"
-#include "Editor/Utils/FileWatcher.h"
 #include "Editor/UI/ContentBrowser/AssetIconManager.h"
 #include "Editor/UI/ContentBrowser/AssetMetadata.h"
 #include "Editor/EditorApp.h"
@@ -41,62 +40,37 @@ namespace Editor
 
         _iconManager = std::make_unique<AssetIconManager>();
 
-        _fileWatcher = std::make_unique<FileWatcher>(_assetDirectory);
-        _fileWatcher->SetCallback([this]() { this->_OnFileSystemChanged(); });
-        _fileWatcher->Start();
+        std::vector<std::filesystem::path> roots = { _assetDirectory };
+        if (!_projectInfo.GetConfig().sourceDirectory.empty())
+        {
+            roots.push_back(_sourceDirectory);
+        }
 
+        // Crawling, metadata and watching all happen on the indexer thread
+        _indexer = std::make_unique<ProjectIndexer>(_projectInfo.GetProjectDir(), roots, _ignoredExtensions);
+        _indexer->Start();
+
+        _snapshot = _indexer->GetSnapshot();
         _RefreshAssetList();
     }
 
     ContentBrowser::~ContentBrowser()
     {
-        if (_fileWatcher)
+        if (_indexer)
         {
-            _fileWatcher->Stop();
+            _indexer->Stop();
         }
     }
 
-    void ContentBrowser::_OnFileSystemChanged()
-    {
-        _dirty = true;
-    }
-
     void ContentBrowser::_RefreshAssetList()
     {
         _currentDirCache.clear();
 
-        if (!std::filesystem::exists(_currentDirectory))
+        if (const auto* listing = _snapshot->GetDirectory(_currentDirectory))
         {
-            return;
+            _currentDirCache = *listing;
         }
 
-        for (const auto& entry : std::filesystem::directory_iterator(_currentDirectory))
-        {
-            auto u8ext = entry.path().extension().u8string();
-            std::string ext(u8ext.begin(), u8ext.end());
-
-            if (std::find(_ignoredExtensions.begin(), _ignoredExtensions.end(), ext) != _ignoredExtensions.end())
-            {
-                continue;
-            }
-
-            FileEntry file;
-            auto u8path = entry.path().filename().u8string();
-            file.Name = std::string(u8path.begin(), u8path.end());
-
-            auto u8fullPath = entry.path().u8string();
-            file.Path = std::string(u8fullPath.begin(), u8fullPath.end());
-
-            file.Extension = ext;
-            file.IsDirectory = entry.is_directory();
-
-            if (!file.IsDirectory)
-            {
-                MetadataManager::EnsureMetadata(file.Path);
-            }
-
-            _currentDirCache.push_back(file);
-        }
         _dirty = false;
     }
 
@@ -108,6 +82,13 @@ namespace Editor
             _iconManager->Update();
         }
 
+        auto snapshot = _indexer->GetSnapshot();
+        if (snapshot != _snapshot)
+        {
+            _snapshot = std::move(snapshot);
+            _dirty = true;
+        }
+
         if (_dirty)
         {
             _RefreshAssetList();
@@ -254,14 +235,18 @@ namespace Editor
 
     void ContentBrowser::_RenderTreeRecursive(const std::filesystem::path& directory)
     {
-        for (const auto& entry : std::filesystem::directory_iterator(directory))
+        const auto* listing = _snapshot->GetDirectory(directory);
+        if (!listing)
         {
-            if (entry.is_directory() && entry.path().extension() != ".meta")
-            {
-                const auto& path = entry.path();
+            return;
+        }
 
-                auto u8name = path.filename().u8string();
-                std::string name(u8name.begin(), u8name.end());
+        for (const auto& entry : *listing)
+        {
+            if (entry.IsDirectory)
+            {
+                const auto& path = entry.Path;
+                const std::string& name = entry.Name;
                 ImGuiTreeNodeFlags flags = ImGuiTreeNodeFlags_OpenOnArrow | ImGuiTreeNodeFlags_SpanAvailWidth |
                                            ImGuiTreeNodeFlags_DrawLinesFull;
                 if (path == _currentDirectory)
@@ -345,11 +330,13 @@ namespace Editor
                 ImGui::PushID(file.Name.c_str());
 
                 // Icon
-                auto icon = _iconManager->GetIcon(file.Path, file.IsDirectory);
-                ImTextureID textureID = (ImTextureID)((icon) ? icon->GetRendererID() : nullptr);
+                AssetIcon icon = _iconManager->GetIcon(file);
+                ImTextureID textureID = (ImTextureID)((icon.texture) ? icon.texture->GetRendererID() : nullptr);
+                ImVec2 uv0 = { icon.uv0.x, icon.uv0.y };
+                ImVec2 uv1 = { icon.uv1.x, icon.uv1.y };
 
                 ImGui::PushStyleColor(ImGuiCol_Button, ImVec4(0, 0, 0, 0));
-                ImGui::ImageButton("##AssetIcon", textureID, { _thumbnailSize, _thumbnailSize }, { 0, 0 }, { 1, 1 });
+                ImGui::ImageButton("##AssetIcon", textureID, { _thumbnailSize, _thumbnailSize }, uv0, uv1);
 
                 // Drag & Drop
                 if (ImGui::BeginDragDropSource())
@@ -360,7 +347,7 @@ namespace Editor
                     ImGui::SetDragDropPayload(
                         "CONTENT_BROWSER_ITEM", itemPath, (wcslen(itemPath) + 1) * sizeof(wchar_t));
 
-                    ImGui::Image(textureID, { 32, 32 });
+                    ImGui::Image(textureID, { 32, 32 }, uv0, uv1);
                     ImGui::Text("%s", file.Name.c_str());
                     ImGui::EndDragDropSource();
                 }
@@ -668,7 +655,7 @@ namespace Editor
             path += ".prefab";
         }
         Frost::PrefabSerializer::CreatePrefab(go, path);
-        _RefreshAssetList();
+        _indexer->Invalidate(path);
     }
 
     void ContentBrowser::_CreateFolder(const std::string& name)
@@ -678,7 +665,7 @@ namespace Editor
         {
             std::filesystem::create_directory(path);
         }
-        _RefreshAssetList();
+        _indexer->Invalidate(path);
     }
 
     void ContentBrowser::_RenameItem(const std::filesystem::path& oldPath, const std::string& newName)
@@ -708,7 +695,8 @@ namespace Editor
         {
         }
 
-        _RefreshAssetList();
+        _indexer->Invalidate(oldPath);
+        _indexer->Invalidate(newPath);
     }
 
     void ContentBrowser::_DeleteItem(const std::filesystem::path& path)
@@ -726,7 +714,7 @@ namespace Editor
         catch (...)
         {
         }
-        _RefreshAssetList();
+        _indexer->Invalidate(path);
     }
 
     void ContentBrowser::_MoveAsset(const std::filesystem::path& sourcePath, const std::filesystem::path& destDir)
@@ -777,7 +765,8 @@ namespace Editor
         {
         }
 
-        _RefreshAssetList();
+        _indexer->Invalidate(sourcePath);
+        _indexer->Invalidate(destPath);
     }
 
     void ContentBrowser::_ShowInExplorer(const std::filesystem::path& path)
@@ -817,7 +806,7 @@ namespace Editor
         Frost::SceneSerializer serializer(&tempScene);
         serializer.Serialize(path);
 
-        _RefreshAssetList();
+        _indexer->Invalidate(path);
     }
 
 } // namespace Editor
\ No newline at end of file
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "Editor/Project/ProjectInfo.h"
+#include "Editor/Project/ProjectIndexer.h"
 
 #include <filesystem>
 #include <vector>
@@ -9,17 +10,8 @@
 
 namespace Editor
 {
-    class FileWatcher;
     class AssetIconManager;
 
-    struct FileEntry
-    {
-        std::filesystem::path Path;
-        std::string Name;
-        std::string Extension;
-        bool IsDirectory;
-    };
-
     class ContentBrowser
     {
     public:
@@ -30,7 +22,6 @@ namespace Editor
 
     private:
         void _RefreshAssetList();
-        void _OnFileSystemChanged();
 
         // Rendering
         void _RenderBreadCrumbs();
@@ -57,8 +48,9 @@ namespace Editor
         const ProjectInfo& _projectInfo;
 
         // Modules
-        std::unique_ptr<FileWatcher> _fileWatcher;
+        std::unique_ptr<ProjectIndexer> _indexer;
         std::unique_ptr<AssetIconManager> _iconManager;
+        std::shared_ptr<const ProjectIndexSnapshot> _snapshot;
 
         // Navigation state
         std::filesystem::path _assetDirectory;
@@ -0,0 +1,181 @@
+#include "Editor/UI/ContentBrowser/ThumbnailCache.h"
+
+#include "Frost/Debugging/Logger.h"
+#include "Frost/Utils/SerializerUtils.h"
+
+#include <fstream>
+
+using namespace Frost;
+
+namespace Editor
+{
+    ThumbnailCache::ThumbnailCache(const std::filesystem::path& projectDirectory, uint32_t thumbnailSize) :
+        _projectDirectory(projectDirectory),
+        _cacheFile(projectDirectory / ".frost" / "thumbnails.cache"),
+        _thumbnailSize(thumbnailSize)
+    {
+    }
+
+    ThumbnailCache::~ThumbnailCache()
+    {
+        _Join();
+    }
+
+    void ThumbnailCache::LoadAsync()
+    {
+        _Join();
+        _busy = true;
+        _thread = std::thread(
+            [this]()
+            {
+                std::vector<Record> records = _Read();
+                {
+                    std::lock_guard lock(_loadedMutex);
+                    _loadedRecords = std::move(records);
+                    _loadReady = true;
+                }
+                _busy = false;
+            });
+    }
+
+    void ThumbnailCache::SaveAsync(std::vector<Record>&& records)
+    {
+        _Join();
+        _busy = true;
+        _thread = std::thread(
+            [this, records = std::move(records)]()
+            {
+                _Write(records);
+                _busy = false;
+            });
+    }
+
+    bool ThumbnailCache::PollLoaded(std::vector<Record>& outRecords)
+    {
+        std::lock_guard lock(_loadedMutex);
+        if (!_loadReady)
+        {
+            return false;
+        }
+
+        outRecords = std::move(_loadedRecords);
+        _loadedRecords.clear();
+        _loadReady = false;
+        return true;
+    }
+
+    void ThumbnailCache::_Join()
+    {
+        if (_thread.joinable())
+        {
+            _thread.join();
+        }
+    }
+
+    std::vector<ThumbnailCache::Record> ThumbnailCache::_Read() const
+    {
+        std::vector<Record> records;
+
+        std::ifstream in(_cacheFile, std::ios::binary);
+        if (!in)
+        {
+            return records;
+        }
+
+        uint32_t magic = 0;
+        uint32_t version = 0;
+        uint32_t thumbnailSize = 0;
+        uint64_t count = 0;
+        ReadBinary(in, magic);
+        ReadBinary(in, version);
+        ReadBinary(in, thumbnailSize);
+        ReadBinary(in, count);
+
+        if (magic != CACHE_MAGIC || version != CACHE_VERSION || thumbnailSize != _thumbnailSize)
+        {
+            FT_ENGINE_WARN("ThumbnailCache: ignoring outdated cache '{}'", _cacheFile.string());
+            return records;
+        }
+
+        const size_t pixelSize = static_cast<size_t>(_thumbnailSize) * _thumbnailSize * 4;
+
+        for (uint64_t i = 0; i < count && in; ++i)
+        {
+            std::string relativePath = ReadBinaryString(in);
+
+            int64_t lastWriteTime = 0;
+            ReadBinary(in, lastWriteTime);
+
+            Record record;
+            record.pixels.resize(pixelSize);
+            in.read(reinterpret_cast<char*>(record.pixels.data()), pixelSize);
+
+            if (!in)
+            {
+                break;
+            }
+
+            record.path =
+                (_projectDirectory / std::u8string(relativePath.begin(), relativePath.end())).lexically_normal();
+            record.lastWriteTime =
+                std::filesystem::file_time_type(std::filesystem::file_time_type::duration(lastWriteTime));
+
+            records.push_back(std::move(record));
+        }
+
+        return records;
+    }
+
+    void ThumbnailCache::_Write(const std::vector<Record>& records) const
+    {
+        std::error_code ec;
+        std::filesystem::create_directories(_cacheFile.parent_path(), ec);
+
+        std::filesystem::path tempFile = _cacheFile;
+        tempFile += ".tmp";
+
+        const size_t pixelSize = static_cast<size_t>(_thumbnailSize) * _thumbnailSize * 4;
+
+        {
+            std::ofstream out(tempFile, std::ios::binary | std::ios::trunc);
+            if (!out)
+            {
+                FT_ENGINE_WARN("ThumbnailCache: cannot write cache '{}'", _cacheFile.string());
+                return;
+            }
+
+            uint64_t count = 0;
+            for (const auto& record : records)
+            {
+                if (record.pixels.size() == pixelSize)
+                {
+                    ++count;
+                }
+            }
+
+            WriteBinary(out, CACHE_MAGIC);
+            WriteBinary(out, CACHE_VERSION);
+            WriteBinary(out, _thumbnailSize);
+            WriteBinary(out, count);
+
+            for (const auto& record : records)
+            {
+                if (record.pixels.size() != pixelSize)
+                {
+                    continue;
+                }
+
+                auto relativePath = record.path.lexically_relative(_projectDirectory).generic_u8string();
+                WriteBinaryString(out, std::string(relativePath.begin(), relativePath.end()));
+                WriteBinary(out, static_cast<int64_t>(record.lastWriteTime.time_since_epoch().count()));
+                out.write(reinterpret_cast<const char*>(record.pixels.data()), pixelSize);
+            }
+        }
+
+        std::filesystem::rename(tempFile, _cacheFile, ec);
+        if (ec)
+        {
+            FT_ENGINE_WARN("ThumbnailCache: cannot replace cache '{}': {}", _cacheFile.string(), ec.message());
+        }
+    }
+} // namespace Editor
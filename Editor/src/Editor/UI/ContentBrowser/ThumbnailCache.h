@@ -0,0 +1,55 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <filesystem>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace Editor
+{
+    // Single packed file holding the RGBA pixels of every baked thumbnail, read and written off the UI thread
+    class ThumbnailCache
+    {
+    public:
+        struct Record
+        {
+            std::filesystem::path path;
+            std::filesystem::file_time_type lastWriteTime;
+            std::vector<uint8_t> pixels;
+        };
+
+        ThumbnailCache(const std::filesystem::path& projectDirectory, uint32_t thumbnailSize);
+        ~ThumbnailCache();
+
+        void LoadAsync();
+        void SaveAsync(std::vector<Record>&& records);
+
+        // Returns true once, when the records read by LoadAsync are available
+        bool PollLoaded(std::vector<Record>& outRecords);
+
+        bool IsBusy() const { return _busy; }
+
+    private:
+        void _Join();
+        std::vector<Record> _Read() const;
+        void _Write(const std::vector<Record>& records) const;
+
+    private:
+        std::filesystem::path _projectDirectory;
+        std::filesystem::path _cacheFile;
+        uint32_t _thumbnailSize;
+
+        std::thread _thread;
+        std::atomic<bool> _busy = false;
+
+        std::mutex _loadedMutex;
+        std::vector<Record> _loadedRecords;
+        bool _loadReady = false;
+
+        static constexpr uint32_t CACHE_MAGIC = 0x43544654; // "FTTC"
+        static constexpr uint32_t CACHE_VERSION = 1;
+    };
+} // namespace Editor
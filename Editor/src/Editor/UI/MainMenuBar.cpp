@@ -9,6 +9,8 @@
 #include "Frost/Scene/Scene.h"
 #include "Frost/Scene/SceneSerializer.h"
 #include "Frost/Scene/PrefabSerializer.h"
+#include "Frost/Scene/SceneStreamer.h"
+#include "Frost/Scene/Components/WorldCell.h"
 #include "Frost/Debugging/Logger.h"
 
 #include <imgui.h>
@@ -120,14 +122,29 @@ namespace Editor
             {
                 Frost::Scene tempScene;
                 Frost::SceneSerializer serializer(&tempScene);
-                if (serializer.Deserialize(path))
+                // The binary file holds the editor saves made since the last YAML export, it is not overwritten
+                std::filesystem::path latestPath = Frost::SceneSerializer::GetLatestScenePath(path);
+                if (serializer.Deserialize(latestPath))
                 {
                     std::filesystem::path binPath = path;
                     binPath.replace_extension(".bin");
-                    if (serializer.Serialize(binPath))
+                    if (latestPath == binPath || serializer.Serialize(binPath))
                     {
                         sceneCount++;
                     }
+
+                    // Placing one hierarchy in a WorldCell opts the whole scene into streaming, the cells of a scene
+                    // that opted out are removed so that SceneManager loads it whole
+                    std::filesystem::path cellsPath = Frost::SceneStreamer::GetCellsDirectory(path);
+                    if (!tempScene.View<Frost::Component::WorldCell>().empty())
+                    {
+                        Frost::SceneStreamer::BuildCells(tempScene, cellsPath);
+                    }
+                    else
+                    {
+                        std::error_code ec;
+                        std::filesystem::remove_all(cellsPath, ec);
+                    }
                 }
             }
             else if (extension == ".prefab")
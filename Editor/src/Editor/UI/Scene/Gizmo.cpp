@@ -50,7 +50,16 @@ namespace Editor
                        const ImVec2& viewportSize)
     {
         if (targets.empty())
+        {
+            // The selection went away during a drag, what was moved so far stays undoable
+            if (_isManipulating)
+            {
+                _scene->GetHistory().EndTransaction();
+                _isManipulating = false;
+                _activeAxis = Axis::None;
+            }
             return;
+        }
 
         _currentOperation = operation;
         _targets = targets;
@@ -257,9 +266,14 @@ namespace Editor
             _isManipulating = true;
             _activeAxis = _hoveredAxis;
 
+            // The whole drag is one undo entry, closed when the button is released
+            Frost::SceneHistory& history = _scene->GetHistory();
+            history.BeginTransaction("Transform");
+
             _originalTransforms.clear();
             for (const auto& go : _targets)
             {
+                history.Record(go);
                 if (go.HasComponent<Frost::Component::Transform>())
                 {
                     _originalTransforms.push_back(go.GetComponent<Frost::Component::Transform>());
@@ -319,6 +333,11 @@ namespace Editor
 
         if (!mouse.IsButtonDown(Mouse::MouseBoutton::Left))
         {
+            if (_isManipulating)
+            {
+                _scene->GetHistory().EndTransaction();
+            }
+
             _isManipulating = false;
             _activeAxis = Axis::None;
             _originalTransforms.clear();
@@ -383,6 +402,12 @@ namespace Editor
                     else
                         deltaTranslation = delta;
 
+                    if (ImGui::GetIO().KeyCtrl && _surfaceSnap)
+                    {
+                        if (std::optional<Vector3> surfacePoint = _surfaceSnap(rayOrigin, rayDir))
+                            deltaTranslation = *surfacePoint - _pivotStartPos;
+                    }
+
                     modified = true;
                 }
                 else if (_currentOperation == GizmoOperation::Rotate)
@@ -464,6 +489,8 @@ namespace Editor
                             currentTransform.scale.z = std::max(currentTransform.scale.z, 0.001f);
                         }
 
+                        _scene->GetRegistry().patch<Frost::Component::Transform>(go.GetHandle());
+
                         if (auto* physicSystem = _scene->GetSystem<PhysicSystem>())
                         {
                             physicSystem->NotifyRigidBodyUpdate(*_scene, go);
@@ -16,6 +16,10 @@ namespace Editor
     class Gizmo
     {
     public:
+        // Point of the surface under the mouse ray, if any
+        using SurfaceSnapFunction = std::function<std::optional<Frost::Math::Vector3>(
+            const Frost::Math::Vector3& rayOrigin, const Frost::Math::Vector3& rayDir)>;
+
         Gizmo(Frost::Scene* scene);
 
         void Update(GizmoOperation operation,
@@ -30,6 +34,10 @@ namespace Editor
                     const ImVec2& viewportSize);
 
         bool IsManipulating() const { return _isManipulating; }
+        bool IsHovered() const { return _hoveredAxis != Axis::None; }
+
+        // Translating with Ctrl held moves the selection onto the surface found by this function
+        void SetSurfaceSnap(SurfaceSnapFunction surfaceSnap) { _surfaceSnap = std::move(surfaceSnap); }
 
     private:
         enum class Axis
@@ -86,6 +94,8 @@ namespace Editor
         // Duplicate
         bool _hasDuplicated = false;
 
+        SurfaceSnapFunction _surfaceSnap;
+
         // Context
         Frost::Scene* _scene = nullptr;
     };
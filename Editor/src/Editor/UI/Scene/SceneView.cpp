@@ -6,6 +6,7 @@
 #include "Frost/Scene/Components/StaticMesh.h"
 #include "Frost/Scene/Components/Skybox.h"
 #include "Frost/Scene/Components/Light.h"
+#include "Frost/Scene/Components/Relationship.h"
 #include "Frost/Scene/PrefabSerializer.h"
 #include "Frost/Utils/Math/Transform.h"
 #include "Frost/Scene/SceneSerializer.h"
@@ -47,6 +48,33 @@ namespace Editor
         _selection.clear();
     }
 
+    std::vector<entt::entity> SceneView::_GetSelectionHierarchy() const
+    {
+        auto& registry = _sceneContext->GetRegistry();
+
+        std::vector<entt::entity> entities;
+        std::vector<entt::entity> pending;
+        for (const auto& go : _selection)
+            pending.push_back(go.GetHandle());
+
+        while (!pending.empty())
+        {
+            entt::entity entity = pending.back();
+            pending.pop_back();
+            entities.push_back(entity);
+
+            auto* relationship = registry.try_get<Relationship>(entity);
+            entt::entity child = relationship ? relationship->firstChild : entt::null;
+            while (child != entt::null)
+            {
+                pending.push_back(child);
+                child = registry.get<Relationship>(child).nextSibling;
+            }
+        }
+
+        return entities;
+    }
+
     SceneView::SceneView(const std::string& title, Frost::Scene* existingScene) :
         _title(title),
         _sceneContext(existingScene),
@@ -138,7 +166,7 @@ namespace Editor
         if (std::filesystem::exists(_assetPath))
         {
             SceneSerializer serializer(_sceneContext);
-            if (!serializer.Deserialize(_assetPath))
+            if (!serializer.Deserialize(SceneSerializer::GetLatestScenePath(_assetPath)))
             {
                 FT_ENGINE_ERROR("Failed to load scene for editing: {0}", _assetPath.string());
             }
@@ -174,6 +202,17 @@ namespace Editor
 
         _cameraController.Initialize(tc);
         _toolbar.Init();
+
+        _picker = std::make_unique<Frost::ScenePicker>(_sceneContext);
+        _gizmo->SetSurfaceSnap(
+            [this](const Vector3& rayOrigin, const Vector3& rayDir) -> std::optional<Vector3>
+            {
+                // The dragged entities would be under the mouse themselves
+                std::vector<entt::entity> dragged = _GetSelectionHierarchy();
+                if (auto hit = _picker->Pick({ rayOrigin, rayDir }, PICK_DISTANCE, dragged))
+                    return hit->position;
+                return std::nullopt;
+            });
     }
 
     void SceneView::OnUpdate(float deltaTime)
@@ -3,6 +3,7 @@
 #include "Editor/UI/EditorPanel.h"
 #include "Editor/Utils/EditorCameraController.h"
 #include "Frost/Scene/Scene.h"
+#include "Frost/Scene/ScenePicker.h"
 #include "Frost/Scene/ECS/GameObject.h"
 #include "Frost/Renderer/BoundingBox.h"
 #include "Editor/UI/Scene/SceneViewToolbar.h"
@@ -51,12 +52,10 @@ namespace Editor
         void _Init();
         void _ResizeViewportFramebuffer(uint32_t width, uint32_t height);
 
-        // Utils
-        std::vector<entt::entity> _GetSortedChildren(entt::entity parentID);
-
         // UI
         void _DrawToolbar();
-        void _DrawEntityNode(entt::entity entityID);
+        // One row of the scene's hierarchy cache
+        void _DrawEntityRow(const Frost::SceneHierarchyCache::Row& row);
         bool _DrawVec3Control(const std::string& label,
                               float* values,
                               float resetValue = 0.0f,
@@ -67,10 +66,14 @@ namespace Editor
         void _AddToSelection(const Frost::GameObject& go);
         void _RemoveFromSelection(const Frost::GameObject& go);
         void _ClearSelection();
+        // The selected entities and their descendants
+        std::vector<entt::entity> _GetSelectionHierarchy() const;
 
         // Actions
         void _SavePrefab();
         void _SaveScene();
+        // Rewrites the YAML scene file, saves only go to the binary file
+        void _ExportScene();
         void _LoadScene();
         void _ReparentEntity(entt::entity entity, entt::entity newParent);
         void _FocusCameraOnEntity(Frost::Component::Transform& cameraTransform, const Frost::BoundingBox& bounds);
@@ -79,6 +82,9 @@ namespace Editor
 
         // Input
         void _HandleMeshDrop(const std::filesystem::path& meshPath);
+        void _HandleViewportClick(float mouseX, float mouseY, float viewportW, float viewportH);
+        // Ctrl+Z undoes, Ctrl+Y and Ctrl+Shift+Z redo
+        void _HandleHistoryShortcuts();
         Frost::Math::Vector3 _GetSpawnPositionFromMouse();
         std::pair<Frost::Math::Vector3, Frost::Math::Vector3> _GetCameraRay(float mouseX,
                                                                             float mouseY,
@@ -115,5 +121,8 @@ namespace Editor
         GizmoOperation _currentGizmoOp = GizmoOperation::Translate;
 
         std::unique_ptr<Gizmo> _gizmo;
+        std::unique_ptr<Frost::ScenePicker> _picker;
+
+        static constexpr float PICK_DISTANCE = 1000.0f;
     };
 } // namespace Editor
\ No newline at end of file
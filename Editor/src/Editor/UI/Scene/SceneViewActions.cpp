@@ -79,7 +79,12 @@ namespace Editor
         Frost::GameObject obj(entityID, _sceneContext);
         Frost::GameObject parentObj =
             (newParentID != entt::null) ? Frost::GameObject(newParentID, _sceneContext) : Frost::GameObject{};
+
+        Frost::SceneHistory& history = _sceneContext->GetHistory();
+        history.BeginTransaction("Reparent");
+        history.Record(obj);
         obj.SetParent(parentObj);
+        history.EndTransaction();
     }
 
     void SceneView::_SavePrefab()
@@ -132,28 +137,43 @@ namespace Editor
             _assetPath = *filepath;
         }
 
+        // Only the entities edited since the last save are appended to the binary file. The YAML file is written by
+        // an explicit export, or here when the scene has none yet so that it shows in the content browser
+        std::filesystem::path binaryPath = _assetPath;
+        binaryPath.replace_extension(".bin");
+
         SceneSerializer serializer(_sceneContext);
-        if (serializer.Serialize(_assetPath))
+        if (serializer.Serialize(binaryPath))
         {
-            FT_ENGINE_INFO("Scene saved to: {}", _assetPath.string());
+            FT_ENGINE_INFO("Scene saved to: {}", binaryPath.string());
             _title = "Scene: " + _assetPath.stem().string();
 
-            // Also serialize to binary
-            std::filesystem::path binaryPath = _assetPath;
-            binaryPath.replace_extension(".bin");
-            SceneSerializer binarySerializer(_sceneContext);
-            if (binarySerializer.Serialize(binaryPath))
-            {
-                FT_ENGINE_INFO("Scene also saved to binary: {}", binaryPath.string());
-            }
-            else
-            {
-                FT_ENGINE_ERROR("Failed to save scene to binary: {}", binaryPath.string());
-            }
+            if (_assetPath.extension() != ".bin" && !std::filesystem::exists(_assetPath))
+                _ExportScene();
+        }
+        else
+        {
+            FT_ENGINE_ERROR("Failed to save scene to: {}", binaryPath.string());
+        }
+    }
+
+    void SceneView::_ExportScene()
+    {
+        if (_isPrefabView || !_sceneContext || _assetPath.empty())
+            return;
+
+        std::filesystem::path yamlPath = _assetPath;
+        if (yamlPath.extension() == ".bin")
+            yamlPath.replace_extension(".scene");
+
+        SceneSerializer serializer(_sceneContext);
+        if (serializer.Serialize(yamlPath))
+        {
+            FT_ENGINE_INFO("Scene exported to: {}", yamlPath.string());
         }
         else
         {
-            FT_ENGINE_ERROR("Failed to save scene to: {}", _assetPath.string());
+            FT_ENGINE_ERROR("Failed to export scene to: {}", yamlPath.string());
         }
     }
 
@@ -166,7 +186,7 @@ namespace Editor
         if (filepath)
         {
             SceneSerializer serializer(_sceneContext);
-            if (serializer.Deserialize(*filepath))
+            if (serializer.Deserialize(SceneSerializer::GetLatestScenePath(*filepath)))
             {
                 _selection = {};
                 _title = _sceneContext->GetName();
@@ -36,10 +36,61 @@ namespace Editor
             }
         }
 
+        Frost::SceneHistory& history = _sceneContext->GetHistory();
+        history.BeginTransaction("Add Mesh");
+        history.RecordCreated(newEntity);
+        history.EndTransaction();
+
         _ClearSelection();
         _AddToSelection(newEntity);
     }
 
+    void SceneView::_HandleViewportClick(float mouseX, float mouseY, float viewportW, float viewportH)
+    {
+        auto [rayOrigin, rayDir] = _GetCameraRay(mouseX, mouseY, viewportW, viewportH);
+        std::optional<PickHit> hit = _picker->Pick({ rayOrigin, rayDir }, PICK_DISTANCE);
+
+        bool ctrlPressed = ImGui::GetIO().KeyCtrl;
+        if (!hit)
+        {
+            if (!ctrlPressed)
+                _ClearSelection();
+            return;
+        }
+
+        if (ctrlPressed)
+        {
+            if (_IsSelected(hit->gameObject))
+                _RemoveFromSelection(hit->gameObject);
+            else
+                _AddToSelection(hit->gameObject);
+        }
+        else
+        {
+            _ClearSelection();
+            _AddToSelection(hit->gameObject);
+        }
+    }
+
+    void SceneView::_HandleHistoryShortcuts()
+    {
+        if (!_isFocused || _isReadOnly || ImGui::GetIO().WantTextInput || !ImGui::GetIO().KeyCtrl)
+            return;
+
+        bool shiftPressed = ImGui::GetIO().KeyShift;
+        bool undoPressed = !shiftPressed && ImGui::IsKeyPressed(ImGuiKey_Z, false);
+        bool redoPressed =
+            ImGui::IsKeyPressed(ImGuiKey_Y, false) || (shiftPressed && ImGui::IsKeyPressed(ImGuiKey_Z, false));
+
+        Frost::SceneHistory& history = _sceneContext->GetHistory();
+        if (!(undoPressed && history.Undo()) && !(redoPressed && history.Redo()))
+            return;
+
+        // Entities created by the undone operation are gone
+        auto& registry = _sceneContext->GetRegistry();
+        std::erase_if(_selection, [&](const Frost::GameObject& go) { return !registry.valid(go.GetHandle()); });
+    }
+
     Frost::Math::Vector3 SceneView::_GetSpawnPositionFromMouse()
     {
         ImVec2 mousePos = ImGui::GetMousePos();
@@ -58,6 +109,9 @@ namespace Editor
 
         auto [rayOrigin, rayDir] = _GetCameraRay(mx, my, viewportW, viewportH);
 
+        if (auto hit = _picker->Pick({ rayOrigin, rayDir }, PICK_DISTANCE))
+            return hit->position;
+
         Vector3 planeNormal = { 0.0f, 1.0f, 0.0f };
         Vector3 planePoint = { 0.0f, 0.0f, 0.0f };
 
@@ -78,6 +78,7 @@ namespace Editor
                                 bool isPrefabView,
                                 const std::function<void()>& onSavePrefabCallback,
                                 const std::function<void()>& onSaveSceneCallback,
+                                const std::function<void()>& onExportSceneCallback,
                                 const std::function<void()>& onLoadSceneCallback)
     {
         // Handle inputs
@@ -145,8 +146,14 @@ namespace Editor
                     onSaveSceneCallback();
             }
             ImGui::PopStyleColor();
+            if (ImGui::BeginPopupContextItem("##SaveSceneOptions"))
+            {
+                if (ImGui::MenuItem("Export YAML") && onExportSceneCallback)
+                    onExportSceneCallback();
+                ImGui::EndPopup();
+            }
             if (ImGui::IsItemHovered())
-                ImGui::SetTooltip("Save Scene (Ctrl+S)");
+                ImGui::SetTooltip("Save Scene (Ctrl+S)\nRight-click to export the YAML file");
 
             ImGui::SameLine();
 
@@ -43,6 +43,7 @@ namespace Editor
                   bool isPrefabView,
                   const std::function<void()>& onSavePrefabCallback,
                   const std::function<void()>& onSaveSceneCallback,
+                  const std::function<void()>& onExportSceneCallback,
                   const std::function<void()>& onLoadSceneCallback);
 
     private:
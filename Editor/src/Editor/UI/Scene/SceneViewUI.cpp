@@ -39,6 +39,7 @@ namespace Editor
         _isFocused = ImGui::IsWindowFocused(ImGuiFocusedFlags_RootAndChildWindows);
         _isHovered = ImGui::IsWindowHovered(ImGuiHoveredFlags_ChildWindows);
 
+        _HandleHistoryShortcuts();
         _DrawToolbar();
 
         if (ImGui::BeginPopup("SaveErrorPopup"))
@@ -57,9 +58,11 @@ namespace Editor
 
         _ResizeViewportFramebuffer((uint32_t)viewportPanelSize.x, (uint32_t)viewportPanelSize.y);
 
+        bool isViewportClicked = false;
         if (_viewportTexture)
         {
             ImGui::Image((ImTextureID)_viewportTexture->GetRendererID(), viewportPanelSize);
+            isViewportClicked = ImGui::IsItemClicked(ImGuiMouseButton_Left);
         }
 
         if (ImGui::BeginDragDropTarget())
@@ -85,6 +88,11 @@ namespace Editor
                         }
                     }
 
+                    Frost::SceneHistory& history = _sceneContext->GetHistory();
+                    history.BeginTransaction("Add Prefab");
+                    history.RecordCreated(newEntity, true);
+                    history.EndTransaction();
+
                     _ClearSelection();
                     _AddToSelection(newEntity);
                 }
@@ -138,6 +146,17 @@ namespace Editor
             }
         }
 
+        // A click on a gizmo handle starts a manipulation instead
+        bool isGizmoUnderMouse = !_selection.empty() && (_gizmo->IsHovered() || _gizmo->IsManipulating());
+        if (isViewportClicked && !isGizmoUnderMouse)
+        {
+            ImVec2 mousePos = ImGui::GetMousePos();
+            _HandleViewportClick(mousePos.x - viewportMinRegion.x,
+                                 mousePos.y - viewportMinRegion.y,
+                                 viewportPanelSize.x,
+                                 viewportPanelSize.y);
+        }
+
         if (_editorCamera && _editorCamera.HasComponent<Transform>())
         {
             auto& tc = _editorCamera.GetComponent<Transform>();
@@ -182,33 +201,31 @@ namespace Editor
                     newEntity.SetParent(Frost::GameObject(prefabRoot, _sceneContext));
                 }
 
+                Frost::SceneHistory& history = _sceneContext->GetHistory();
+                history.BeginTransaction("Create Entity");
+                history.RecordCreated(newEntity);
+                history.EndTransaction();
+
                 _ClearSelection();
                 _AddToSelection(newEntity);
             }
             ImGui::EndPopup();
         }
 
-        std::vector<entt::entity> roots;
-        _sceneContext->GetRegistry().view<Relationship>().each(
-            [&](auto entityID, auto& relation)
-            {
-                if (relation.parent == entt::null)
-                    roots.push_back(entityID);
-            });
-
-        std::sort(roots.begin(),
-                  roots.end(),
-                  [&](entt::entity a, entt::entity b)
-                  {
-                      auto* metaA = _sceneContext->GetRegistry().try_get<Meta>(a);
-                      auto* metaB = _sceneContext->GetRegistry().try_get<Meta>(b);
-                      return (metaA ? metaA->name : "") < (metaB ? metaB->name : "");
-                  });
-
-        for (auto entityID : roots)
+        // Only the rows on screen are submitted
+        Frost::SceneHierarchyCache& hierarchy = _sceneContext->GetHierarchyCache();
+        hierarchy.SetSortedByName(true);
+        const auto& rows = hierarchy.GetRows();
+        ImGuiListClipper clipper;
+        clipper.Begin(static_cast<int>(rows.size()));
+        while (clipper.Step())
         {
-            _DrawEntityNode(entityID);
+            for (int i = clipper.DisplayStart; i < clipper.DisplayEnd; ++i)
+            {
+                _DrawEntityRow(rows[i]);
+            }
         }
+        clipper.End();
 
         if (!_isReadOnly &&
             ImGui::BeginDragDropTargetCustom(ImGui::GetCurrentWindow()->Rect(), ImGui::GetID("HierarchyContent")))
@@ -225,7 +242,10 @@ namespace Editor
                 std::filesystem::path assetPath = std::filesystem::path((const wchar_t*)payload->Data);
                 if (assetPath.extension() == ".prefab")
                 {
-                    Frost::PrefabSerializer::Instantiate(_sceneContext, assetPath);
+                    Frost::SceneHistory& history = _sceneContext->GetHistory();
+                    history.BeginTransaction("Instantiate Prefab");
+                    history.RecordCreated(Frost::PrefabSerializer::Instantiate(_sceneContext, assetPath), true);
+                    history.EndTransaction();
                 }
             }
             ImGui::EndDragDropTarget();
@@ -237,15 +257,14 @@ namespace Editor
         }
     }
 
-    void SceneView::_DrawEntityNode(entt::entity entityID)
+    void SceneView::_DrawEntityRow(const Frost::SceneHierarchyCache::Row& row)
     {
         auto& registry = _sceneContext->GetRegistry();
+        entt::entity entityID = row.entity;
         if (!registry.valid(entityID))
             return;
 
         auto* meta = registry.try_get<Meta>(entityID);
-        if (meta && meta->name.find("__EDITOR__") == 0)
-            return;
 
         auto* relation = registry.try_get<Relationship>(entityID);
         bool isDisabled = registry.all_of<Disabled>(entityID);
@@ -257,26 +276,37 @@ namespace Editor
         Frost::GameObject currentGO(entityID, _sceneContext);
         bool isSelected = _IsSelected(currentGO);
 
+        // Rows are flat, the tree indentation is applied by hand
         ImGuiTreeNodeFlags flags = (isSelected ? ImGuiTreeNodeFlags_Selected : 0) | ImGuiTreeNodeFlags_OpenOnArrow |
-                                   ImGuiTreeNodeFlags_SpanAvailWidth;
+                                   ImGuiTreeNodeFlags_SpanAvailWidth | ImGuiTreeNodeFlags_NoTreePushOnOpen;
 
+        // The children of a prefab instance belong to its asset, they are not listed
         if (isPrefabInstance)
         {
             flags |= ImGuiTreeNodeFlags_Leaf;
             flags &= ~ImGuiTreeNodeFlags_OpenOnArrow;
         }
-        else if (relation && relation->childrenCount == 0)
+        else if (!row.hasChildren)
         {
             flags |= ImGuiTreeNodeFlags_Leaf;
         }
 
+        const float indent = row.depth * ImGui::GetStyle().IndentSpacing;
+        if (indent > 0.0f)
+            ImGui::Indent(indent);
+
         if (isDisabled)
             ImGui::PushStyleColor(ImGuiCol_Text, ImVec4(0.5f, 0.5f, 0.5f, 1.0f));
 
         if (isPrefabInstance)
             ImGui::PushStyleColor(ImGuiCol_Text, ImVec4(0.4f, 0.6f, 1.0f, 1.0f));
 
-        bool opened = ImGui::TreeNodeEx((void*)(uint64_t)(uint32_t)entityID, flags, name.c_str());
+        ImGui::SetNextItemOpen(row.isExpanded && !isPrefabInstance);
+        bool opened = ImGui::TreeNodeEx((void*)(uint64_t)(uint32_t)entityID, flags, "%s", name.c_str());
+        if (row.hasChildren && !isPrefabInstance && opened != row.isExpanded)
+        {
+            _sceneContext->GetHierarchyCache().SetExpanded(entityID, opened);
+        }
 
         if (isPrefabInstance)
             ImGui::PopStyleColor();
@@ -342,11 +372,19 @@ namespace Editor
             {
                 auto child = _sceneContext->CreateGameObject("New Entity");
                 child.SetParent(currentGO);
+
+                Frost::SceneHistory& history = _sceneContext->GetHistory();
+                history.BeginTransaction("Create Child");
+                history.RecordCreated(child);
+                history.EndTransaction();
             }
 
             if (!isPrefabRoot && ImGui::MenuItem("Duplicate"))
             {
-                _sceneContext->DuplicateGameObject(currentGO);
+                Frost::SceneHistory& history = _sceneContext->GetHistory();
+                history.BeginTransaction("Duplicate");
+                history.RecordCreated(_sceneContext->DuplicateGameObject(currentGO), true);
+                history.EndTransaction();
             }
 
             if (!isPrefabRoot && ImGui::MenuItem("Delete Entity"))
@@ -355,25 +393,19 @@ namespace Editor
             ImGui::EndPopup();
         }
 
-        if (opened)
-        {
-            if (relation && !isPrefabInstance)
-            {
-                auto sortedChildren = _GetSortedChildren(entityID);
-                for (auto childID : sortedChildren)
-                {
-                    _DrawEntityNode(childID);
-                }
-            }
-            ImGui::TreePop();
-        }
+        if (indent > 0.0f)
+            ImGui::Unindent(indent);
 
         if (entityDeleted)
         {
             if (_IsSelected(currentGO))
                 _RemoveFromSelection(currentGO);
 
+            Frost::SceneHistory& history = _sceneContext->GetHistory();
+            history.BeginTransaction("Delete Entity");
+            history.Record(currentGO, true);
             _sceneContext->DestroyGameObject(currentGO);
+            history.EndTransaction();
         }
     }
 
@@ -422,6 +454,10 @@ namespace Editor
                     std::string name = activeSelection.GetComponent<Meta>().name;
                     bool wasEnabled = !activeSelection.HasComponent<Disabled>();
 
+                    Frost::SceneHistory& history = _sceneContext->GetHistory();
+                    history.BeginTransaction("Unpack Prefab");
+                    history.Record(activeSelection, true);
+
                     _sceneContext->DestroyGameObject(activeSelection);
                     _ClearSelection();
 
@@ -437,8 +473,10 @@ namespace Editor
                         else if (!newRoot.HasComponent<Disabled>())
                             newRoot.AddComponent<Disabled>();
 
+                        history.RecordCreated(newRoot, true);
                         _AddToSelection(newRoot);
                     }
+                    history.EndTransaction();
                 }
 
                 ImGui::TreePop();
@@ -469,6 +507,10 @@ namespace Editor
                         auto transform = activeSelection.GetComponent<Transform>();
                         std::string originalName = activeSelection.GetComponent<Meta>().name;
 
+                        Frost::SceneHistory& history = _sceneContext->GetHistory();
+                        history.BeginTransaction("Replace With Prefab");
+                        history.Record(activeSelection, true);
+
                         _sceneContext->DestroyGameObject(activeSelection);
                         _ClearSelection();
 
@@ -478,8 +520,11 @@ namespace Editor
                             newObj.SetParent(parent);
                             newObj.GetComponent<Transform>() = transform;
                             newObj.GetComponent<Meta>().name = originalName;
+
+                            history.RecordCreated(newObj, true);
                             _AddToSelection(newObj);
                         }
+                        history.EndTransaction();
                     }
                 }
             }
@@ -502,7 +547,11 @@ namespace Editor
                 }
                 if (ImGui::MenuItem(serializer.Name.c_str()))
                 {
+                    Frost::SceneHistory& history = _sceneContext->GetHistory();
+                    history.BeginTransaction("Add Component");
+                    history.Record(activeSelection);
                     serializer.AddComponent(activeSelection);
+                    history.EndTransaction();
                     ImGui::CloseCurrentPopup();
                     searchBuffer[0] = '\0';
                 }
@@ -520,6 +569,7 @@ namespace Editor
             _isPrefabView,
             [this]() { this->_SavePrefab(); },
             [this]() { this->_SaveScene(); },
+            [this]() { this->_ExportScene(); },
             [this]() { this->_LoadScene(); });
 
         if (_viewSettings.showEditorSkybox && !_editorCamera.HasComponent<Skybox>())
@@ -582,42 +632,4 @@ namespace Editor
 
         return changed;
     }
-
-    std::vector<entt::entity> SceneView::_GetSortedChildren(entt::entity parentID)
-    {
-        auto& registry = _sceneContext->GetRegistry();
-        std::vector<entt::entity> children;
-
-        auto* relation = registry.try_get<Relationship>(parentID);
-        if (!relation)
-            return children;
-
-        entt::entity currentChild = relation->firstChild;
-        while (registry.valid(currentChild))
-        {
-            children.push_back(currentChild);
-            auto* childRel = registry.try_get<Relationship>(currentChild);
-            currentChild = childRel ? childRel->nextSibling : entt::null;
-        }
-
-        std::sort(children.begin(),
-                  children.end(),
-                  [&](entt::entity a, entt::entity b)
-                  {
-                      auto* metaA = registry.try_get<Meta>(a);
-                      auto* metaB = registry.try_get<Meta>(b);
-
-                      std::string nameA = metaA ? metaA->name : "Entity";
-                      std::string nameB = metaB ? metaB->name : "Entity";
-
-                      return std::lexicographical_compare(nameA.begin(),
-                                                          nameA.end(),
-                                                          nameB.begin(),
-                                                          nameB.end(),
-                                                          [](char c1, char c2)
-                                                          { return std::tolower(c1) < std::tolower(c2); });
-                  });
-
-        return children;
-    }
 } // namespace Editor
\ No newline at end of file
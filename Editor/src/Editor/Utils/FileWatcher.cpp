@@ -1,9 +1,15 @@
 #include "Editor/Utils/FileWatcher.h"
 
+#ifdef FT_PLATFORM_WINDOWS
 #ifndef WIN32_LEAN_AND_MEAN
 #define WIN32_LEAN_AND_MEAN
 #endif
 #include <Windows.h>
+#elif defined(__linux__)
+#include <sys/inotify.h>
+#include <poll.h>
+#include <unistd.h>
+#endif
 
 namespace Editor
 {
@@ -26,6 +32,7 @@ namespace Editor
         _watcherThread = std::thread(&FileWatcher::_WatchThreadFunc, this);
     }
 
+#ifdef FT_PLATFORM_WINDOWS
     void FileWatcher::Stop()
     {
         _running = false;
@@ -56,7 +63,7 @@ namespace Editor
         if (_dirHandle == INVALID_HANDLE_VALUE)
             return;
 
-        char buffer[4096];
+        alignas(DWORD) char buffer[16 * 1024];
         DWORD bytesReturned;
 
         while (_running)
@@ -66,17 +73,59 @@ namespace Editor
                                       sizeof(buffer),
                                       TRUE,
                                       FILE_NOTIFY_CHANGE_FILE_NAME | FILE_NOTIFY_CHANGE_DIR_NAME |
-                                          FILE_NOTIFY_CHANGE_LAST_WRITE | FILE_NOTIFY_CHANGE_CREATION,
+                                          FILE_NOTIFY_CHANGE_LAST_WRITE | FILE_NOTIFY_CHANGE_CREATION |
+                                          FILE_NOTIFY_CHANGE_SIZE,
                                       &bytesReturned,
                                       NULL,
                                       NULL))
             {
-                if (bytesReturned > 0 && _callback)
+                if (!_callback)
+                {
+                    continue;
+                }
+
+                std::vector<FileChange> changes;
+
+                // Zero bytes means the kernel buffer overflowed and the events are lost
+                if (bytesReturned == 0)
                 {
-                    // debounce multiple events
-                    std::this_thread::sleep_for(std::chrono::milliseconds(50));
-                    _callback();
+                    changes.push_back({ _directory, FileChangeAction::Rescan });
                 }
+
+                size_t offset = 0;
+                while (bytesReturned > 0)
+                {
+                    auto* info = reinterpret_cast<const FILE_NOTIFY_INFORMATION*>(buffer + offset);
+                    std::wstring name(info->FileName, info->FileNameLength / sizeof(WCHAR));
+
+                    FileChange change;
+                    change.Path = _directory / name;
+
+                    switch (info->Action)
+                    {
+                        case FILE_ACTION_ADDED:
+                        case FILE_ACTION_RENAMED_NEW_NAME:
+                            change.Action = FileChangeAction::Added;
+                            break;
+                        case FILE_ACTION_REMOVED:
+                        case FILE_ACTION_RENAMED_OLD_NAME:
+                            change.Action = FileChangeAction::Removed;
+                            break;
+                        default:
+                            change.Action = FileChangeAction::Modified;
+                            break;
+                    }
+
+                    changes.push_back(std::move(change));
+
+                    if (info->NextEntryOffset == 0)
+                        break;
+                    offset += info->NextEntryOffset;
+                }
+
+                // debounce multiple events
+                std::this_thread::sleep_for(std::chrono::milliseconds(50));
+                _callback(changes);
             }
             else
             {
@@ -84,4 +133,131 @@ namespace Editor
             }
         }
     }
-} // namespace Editor
\ No newline at end of file
+#elif defined(__linux__)
+    void FileWatcher::Stop()
+    {
+        _running = false;
+
+        if (_watcherThread.joinable())
+        {
+            _watcherThread.join();
+        }
+
+        if (_inotifyFd >= 0)
+        {
+            close(_inotifyFd);
+            _inotifyFd = -1;
+        }
+        _watchDescriptors.clear();
+    }
+
+    void FileWatcher::_AddWatchRecursive(const std::filesystem::path& directory)
+    {
+        constexpr uint32_t mask =
+            IN_CREATE | IN_DELETE | IN_MODIFY | IN_CLOSE_WRITE | IN_MOVED_FROM | IN_MOVED_TO | IN_DELETE_SELF;
+
+        int wd = inotify_add_watch(_inotifyFd, directory.c_str(), mask);
+        if (wd >= 0)
+        {
+            _watchDescriptors[wd] = directory;
+        }
+
+        std::error_code ec;
+        for (const auto& entry : std::filesystem::directory_iterator(directory, ec))
+        {
+            if (entry.is_directory(ec))
+            {
+                _AddWatchRecursive(entry.path());
+            }
+        }
+    }
+
+    void FileWatcher::_WatchThreadFunc()
+    {
+        _inotifyFd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+        if (_inotifyFd < 0)
+            return;
+
+        // inotify is not recursive: every directory of the tree needs its own watch
+        _AddWatchRecursive(_directory);
+
+        alignas(inotify_event) char buffer[16 * 1024];
+
+        while (_running)
+        {
+            pollfd pfd = { _inotifyFd, POLLIN, 0 };
+            if (poll(&pfd, 1, 100) <= 0)
+            {
+                continue;
+            }
+
+            // debounce multiple events
+            std::this_thread::sleep_for(std::chrono::milliseconds(50));
+
+            std::vector<FileChange> changes;
+            ssize_t length;
+            while ((length = read(_inotifyFd, buffer, sizeof(buffer))) > 0)
+            {
+                for (char* ptr = buffer; ptr < buffer + length;)
+                {
+                    const auto* event = reinterpret_cast<const inotify_event*>(ptr);
+                    ptr += sizeof(inotify_event) + event->len;
+
+                    if (event->mask & IN_Q_OVERFLOW)
+                    {
+                        changes.push_back({ _directory, FileChangeAction::Rescan });
+                        continue;
+                    }
+
+                    auto it = _watchDescriptors.find(event->wd);
+                    if (it == _watchDescriptors.end())
+                    {
+                        continue;
+                    }
+
+                    if (event->mask & IN_IGNORED)
+                    {
+                        _watchDescriptors.erase(it);
+                        continue;
+                    }
+
+                    if (event->len == 0)
+                    {
+                        continue;
+                    }
+
+                    FileChange change;
+                    change.Path = it->second / event->name;
+
+                    if (event->mask & (IN_CREATE | IN_MOVED_TO))
+                    {
+                        change.Action = FileChangeAction::Added;
+
+                        // Files may have been created in the new directory before the watch was installed
+                        if (event->mask & IN_ISDIR)
+                        {
+                            _AddWatchRecursive(change.Path);
+                            change.Action = FileChangeAction::Rescan;
+                        }
+                    }
+                    else if (event->mask & (IN_DELETE | IN_MOVED_FROM))
+                    {
+                        change.Action = FileChangeAction::Removed;
+                    }
+                    else
+                    {
+                        change.Action = FileChangeAction::Modified;
+                    }
+
+                    changes.push_back(std::move(change));
+                }
+            }
+
+            if (!changes.empty() && _callback)
+            {
+                _callback(changes);
+            }
+        }
+    }
+#endif
+} // namespace Editor
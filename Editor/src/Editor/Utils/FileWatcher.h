@@ -3,13 +3,30 @@
 #include <functional>
 #include <thread>
 #include <atomic>
+#include <vector>
+#include <unordered_map>
 
 namespace Editor
 {
+    enum class FileChangeAction
+    {
+        Added,
+        Removed,
+        Modified,
+        // The watcher lost events (buffer overflow, new directory tree...), the subtree must be crawled again
+        Rescan
+    };
+
+    struct FileChange
+    {
+        std::filesystem::path Path;
+        FileChangeAction Action;
+    };
+
     class FileWatcher
     {
     public:
-        using OnChangeCallback = std::function<void()>;
+        using OnChangeCallback = std::function<void(const std::vector<FileChange>& changes)>;
 
         FileWatcher(const std::filesystem::path& pathToWatch);
         ~FileWatcher();
@@ -18,14 +35,25 @@ namespace Editor
         void Start();
         void Stop();
 
+        const std::filesystem::path& GetDirectory() const { return _directory; }
+
     private:
         void _WatchThreadFunc();
 
+#ifndef FT_PLATFORM_WINDOWS
+        void _AddWatchRecursive(const std::filesystem::path& directory);
+#endif
+
     private:
         std::filesystem::path _directory;
         OnChangeCallback _callback;
         std::thread _watcherThread;
         std::atomic<bool> _running;
         void* _dirHandle = nullptr;
+
+#ifndef FT_PLATFORM_WINDOWS
+        int _inotifyFd = -1;
+        std::unordered_map<int, std::filesystem::path> _watchDescriptors;
+#endif
     };
-} // namespace Editor
\ No newline at end of file
+} // namespace Editor
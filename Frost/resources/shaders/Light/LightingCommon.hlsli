@@ -11,6 +11,7 @@ cbuffer ShadowMatrix : register(b1)
 {
     column_major float4x4 World;
     column_major float4x4 LightViewProj;
+    float4 ShadowAtlasRect; // xy: tile offset, zw: tile scale, in atlas UV
 }
 
 struct PS_Input
@@ -61,8 +62,9 @@ float SampleShadowPCF_Merged(float2 baseUV, float baseDepth, float3 normal, floa
         [unroll]
         for (int dy = -1; dy <= 1; ++dy)
         {
-            float2 sampleUV = baseUV + float2(dx, dy) * texel;
-            float mapDepth = ShadowMap.Sample(GBufferSampler, sampleUV).r;
+            // Clamped to the tile so that the filter never reads a neighbouring light
+            float2 sampleUV = clamp(baseUV + float2(dx, dy) * texel, 0.5f * texel, 1.0f - 0.5f * texel);
+            float mapDepth = ShadowMap.Sample(GBufferSampler, ShadowAtlasRect.xy + sampleUV * ShadowAtlasRect.zw).r;
             
             if (mapDepth + bias > baseDepth)
             {
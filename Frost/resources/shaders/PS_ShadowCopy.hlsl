@@ -0,0 +1,7 @@
+// Copies a tile of the static casters atlas, both atlases share the same layout
+Texture2D StaticShadowAtlas : register(t0);
+
+float main(float4 position : SV_POSITION) : SV_DEPTH
+{
+    return StaticShadowAtlas.Load(int3(position.xy, 0)).r;
+}
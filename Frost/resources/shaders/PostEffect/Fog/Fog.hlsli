@@ -0,0 +1,16 @@
+struct FogParams
+{
+    float MinDepth;
+    float Strength;
+    float red;
+    float green;
+    float blue;
+};
+
+float4 Fog_Apply(float4 currentColor, float2 uv, FogParams params, SamplerState linearSampler, Texture2D depthTexture)
+{
+    float depth = saturate(params.Strength * (depthTexture.Sample(linearSampler, uv).r - params.MinDepth) /
+                           (1 - params.MinDepth));
+    float3 newColor = lerp(currentColor.rgb, float3(params.red, params.green, params.blue), depth);
+    return saturate(float4(newColor.xyz, 1.0));
+}
@@ -1,3 +1,5 @@
+#include "Fog.hlsli"
+
 Texture2D SourceTexture     : register(t0);
 SamplerState SourceSampler  : register(s0);
 
@@ -11,17 +13,11 @@ struct PS_Input
 
 cbuffer UnderWaterConstants : register(b0)
 {
-    float MinDepth;
-    float Strength;
-    float red;
-    float green;
-    float blue;
+    FogParams Params;
 };
 
 float4 main(PS_Input input) : SV_TARGET
 {    
     float4 currentColor = SourceTexture.Sample(SourceSampler, input.TexCoord);
-    float depth = saturate(Strength * (DepthTexture.Sample(SourceSampler, input.TexCoord).r - MinDepth) / (1 - MinDepth));
-    float3 newColor = lerp(currentColor.rgb, float3(red, green, blue), depth);
-    return saturate(float4(newColor.xyz, 1.0));
+    return Fog_Apply(currentColor, input.TexCoord, Params, SourceSampler, DepthTexture);
 }
\ No newline at end of file
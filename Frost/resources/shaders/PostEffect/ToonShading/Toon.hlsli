@@ -0,0 +1,88 @@
+#define MAX_STEPS 8
+
+struct ToonParams
+{
+    int redStepCount; // Nombre de paliers pour le rouge (1-16)
+    int greenStepCount; // Nombre de paliers pour le vert (1-16)
+    int blueStepCount; // Nombre de paliers pour le bleu (1-16)
+    int pad0;
+    
+    float redSteps[MAX_STEPS]; // Valeurs des paliers rouge [0.0 - 1.0]
+    float greenSteps[MAX_STEPS]; // Valeurs des paliers vert [0.0 - 1.0]
+    float blueSteps[MAX_STEPS]; // Valeurs des paliers bleu [0.0 - 1.0]
+    
+    float3 pad1;
+    
+    // Parametres de detection de contours
+    float edgeThreshold;        // Seuil normales (ex: 0.3 a 0.6)
+    float edgeStrength;         // Intensite du contour (ex: 1.0)
+    float depthThreshold;       // Seuil profondeur (ex: 0.01 a 0.1)
+    float depthSensitivity;     // Sensibilite profondeur (ex: 50.0)
+    
+    // Parametres de shading base sur les normales
+    float normalStrength;       // Multiplicateur pour l'assombrissement (ex: 1.0)
+    float normalMin;            // Valeur minimale de normal (ex: 0.0)
+    float normalMax;            // Valeur maximale de normal (ex: 1.0)
+    
+    float3 edgeColor;           // Couleur des contours (ex: noir = 0,0,0)
+    
+    float2 texelSize;
+};
+
+float Toon_QuantizeToClosest(float value, float steps[MAX_STEPS], int stepCount)
+{
+    float closest = steps[0];
+    float minDist = abs(value - closest);
+        
+    for (int i = 1; i < stepCount; i++)
+    {
+        float dist = abs(value - steps[i]);
+        if (dist < minDist)
+        {
+            minDist = dist;
+            closest = steps[i];
+        }
+    }
+    
+    return closest;
+}
+
+// The normal texture is a G-buffer input, sampling its neighbours keeps the effect per-pixel for the source
+float4 Toon_Apply(float4 currentColor, float2 uv, ToonParams params, SamplerState linearSampler,
+                  Texture2D normalTexture)
+{
+    // ===== 1. QUANTIFICATION DES COULEURS (TOON SHADING) =====
+    float3 quantizedColor;
+    
+    quantizedColor.r = Toon_QuantizeToClosest(currentColor.r, params.redSteps, params.redStepCount);
+    quantizedColor.g = Toon_QuantizeToClosest(currentColor.g, params.greenSteps, params.greenStepCount);
+    quantizedColor.b = Toon_QuantizeToClosest(currentColor.b, params.blueSteps, params.blueStepCount);
+    
+    // ===== 2. DETECTION DES CONTOURS PAR NORMALES =====
+    float3 normalCenter = normalTexture.Sample(linearSampler, uv).xyz;
+    normalCenter = normalize(normalCenter * 2.0 - 1.0);
+    
+    float3 normalTop = normalTexture.Sample(linearSampler, uv + float2(0, -params.texelSize.y)).xyz;
+    float3 normalBottom = normalTexture.Sample(linearSampler, uv + float2(0, params.texelSize.y)).xyz;
+    float3 normalLeft = normalTexture.Sample(linearSampler, uv + float2(-params.texelSize.x, 0)).xyz;
+    float3 normalRight = normalTexture.Sample(linearSampler, uv + float2(params.texelSize.x, 0)).xyz;
+
+    normalTop = normalize(normalTop * 2.0 - 1.0);
+    normalBottom = normalize(normalBottom * 2.0 - 1.0);
+    normalLeft = normalize(normalLeft * 2.0 - 1.0);
+    normalRight = normalize(normalRight * 2.0 - 1.0);
+    
+    float edgeX = dot(normalRight - normalLeft, normalRight - normalLeft);
+    float edgeY = dot(normalTop - normalBottom, normalTop - normalBottom);
+    float normalEdge = sqrt(edgeX + edgeY);
+    
+    // ===== 3. COMBINAISON DES DETECTIONS =====
+    normalEdge = smoothstep(params.edgeThreshold, params.edgeThreshold + 0.1, normalEdge);    
+    float edge = saturate(normalEdge * params.edgeStrength);
+    
+    // ===== 4. APPLICATION DES CONTOURS =====
+    // Interpoler entre la couleur shadee et la couleur de contour
+    float3 finalColor = lerp(quantizedColor, params.edgeColor, edge);
+    
+    return float4(finalColor, currentColor.a);
+}
@@ -0,0 +1,6 @@
+// Fullscreen triangle on the far plane, drawn over a shadow atlas tile to clear or overwrite it
+float4 main(uint vertexID : SV_VertexID) : SV_POSITION
+{
+    float2 uv = float2((vertexID << 1) & 2, vertexID & 2);
+    return float4(uv * float2(2.0f, -2.0f) + float2(-1.0f, 1.0f), 1.0f, 1.0f);
+}
@@ -28,6 +28,7 @@
 
 #include "Frost/Physics/Physics.h"
 #include "Frost/Physics/PhysicsConfig.h"
+#include "Frost/Physics/SceneQuery.h"
 #include "Frost/Physics/ShapeFactory.h"
 
 #include "Frost/Scene/Components/Camera.h"
@@ -38,10 +39,12 @@
 #include "Frost/Scene/Components/StaticMesh.h"
 #include "Frost/Scene/Components/Transform.h"
 #include "Frost/Scene/Components/WorldTransform.h"
+#include "Frost/Scene/Components/WorldMatrix.h"
 #include "Frost/Scene/Components/Billboard.h"
 #include "Frost/Scene/Components/UIElement.h"
 #include "Frost/Scene/Scene.h"
 #include "Frost/Scene/SceneManager.h"
+#include "Frost/Scene/ScenePicker.h"
 
 #include "Frost/Renderer/DX11/RendererDX11.h"
 #include "Frost/Renderer/PostEffect/ChromaticAberrationEffect.h"
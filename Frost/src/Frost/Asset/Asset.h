@@ -2,6 +2,8 @@
 
 #include <string>
 #include <atomic>
+#include <cstddef>
+#include <cstdint>
 
 namespace Frost
 {
@@ -13,6 +15,22 @@ namespace Frost
         Failed
     };
 
+    // Memory budgets are set per category
+    enum class AssetCategory : uint8_t
+    {
+        Texture,
+        Model,
+        Font,
+        Other,
+        Count
+    };
+
+    struct AssetMemory
+    {
+        size_t cpuBytes = 0;
+        size_t gpuBytes = 0;
+    };
+
     class Asset
     {
     public:
@@ -25,6 +43,11 @@ namespace Frost
         bool IsLoaded() const { return _status == AssetStatus::Loaded; }
         void SetStatus(AssetStatus status) { _status.store(status, std::memory_order_release); }
 
+        virtual AssetCategory GetCategory() const { return AssetCategory::Other; }
+        // Bytes held by the asset itself, the assets it references are counted on their own. Only meaningful once
+        // loaded or failed, the loader thread may still be writing before that.
+        virtual AssetMemory GetMemoryUsage() const { return {}; }
+
     protected:
         std::atomic<AssetStatus> _status{ AssetStatus::Unloaded };
 
@@ -1,10 +1,15 @@
 ﻿#include "Frost/Asset/AssetManager.h"
 #include <assimp/texture.h>
 
+#include <algorithm>
+
 namespace Frost
 {
-    FROST_API std::map<Asset::Path, std::shared_ptr<Asset>> AssetManager::_loadedAssets;
+    FROST_API std::map<Asset::Path, AssetManager::AssetEntry> AssetManager::_loadedAssets;
     FROST_API std::mutex AssetManager::_mutex;
+    FROST_API std::array<AssetBudget, static_cast<size_t>(AssetCategory::Count)> AssetManager::_budgets;
+    FROST_API uint64_t AssetManager::_frame = 0;
+    FROST_API uint64_t AssetManager::_evictedCount = 0;
     FROST_API std::deque<std::function<void()>> AssetManager::_uploadQueue;
     FROST_API std::mutex AssetManager::_queueMutex;
 
@@ -14,7 +19,8 @@ namespace Frost
         auto it = _loadedAssets.find(path);
         if (it != _loadedAssets.end())
         {
-            return it->second;
+            it->second.lastUsedFrame = _frame;
+            return it->second.asset;
         }
         return nullptr;
     }
@@ -22,7 +28,7 @@ namespace Frost
     void AssetManager::RegisterAsset(const Asset::Path& path, std::shared_ptr<Asset> asset)
     {
         std::unique_lock lock(_mutex);
-        _loadedAssets[path] = asset;
+        _loadedAssets[path] = { std::move(asset), _frame };
     }
 
     void AssetManager::AddToUploadQueue(std::function<void()>&& job)
@@ -31,6 +37,26 @@ namespace Frost
         _uploadQueue.emplace_back(std::move(job));
     }
 
+    void AssetManager::QueueJob(std::function<void()>&& load, std::function<void()>&& upload)
+    {
+        std::thread(
+            [load = std::move(load), upload = std::move(upload)]() mutable
+            {
+                try
+                {
+                    load();
+                }
+                catch (const std::exception& e)
+                {
+                    FT_ENGINE_ERROR("Async job exception: {}", e.what());
+                }
+
+                // Even after a failed load, so that whoever waits on the job hears back
+                AddToUploadQueue(std::move(upload));
+            })
+            .detach();
+    }
+
     void AssetManager::Shutdown()
     {
         std::unique_lock lock(_mutex);
@@ -60,6 +86,144 @@ namespace Frost
                 break;
             }
         }
+
+        lock.unlock();
+        _EnforceBudgets();
+    }
+
+    void AssetManager::SetBudget(AssetCategory category, const AssetBudget& budget)
+    {
+        std::unique_lock lock(_mutex);
+        _budgets[static_cast<size_t>(category)] = budget;
+    }
+
+    void AssetManager::SetDefaultBudgets()
+    {
+        constexpr size_t MB = 1024 * 1024;
+        SetBudget(AssetCategory::Texture, { 256 * MB, 1024 * MB });
+        SetBudget(AssetCategory::Model, { 256 * MB, 512 * MB });
+        SetBudget(AssetCategory::Font, { 32 * MB, 64 * MB });
+        SetBudget(AssetCategory::Other, {});
+    }
+
+    AssetBudget AssetManager::GetBudget(AssetCategory category)
+    {
+        std::unique_lock lock(_mutex);
+        return _budgets[static_cast<size_t>(category)];
+    }
+
+    AssetMemoryReport AssetManager::GetMemoryReport()
+    {
+        std::unique_lock lock(_mutex);
+
+        AssetMemoryReport report;
+        report.budgets = _budgets;
+        report.frame = _frame;
+        report.evictedCount = _evictedCount;
+        report.assets.reserve(_loadedAssets.size());
+
+        for (const auto& [path, entry] : _loadedAssets)
+        {
+            AssetMemoryReport::Entry& reportEntry = report.assets.emplace_back();
+            reportEntry.path = path;
+            reportEntry.category = entry.asset->GetCategory();
+            reportEntry.status = entry.asset->GetStatus();
+            reportEntry.references = entry.asset.use_count() - 1;
+            reportEntry.lastUsedFrame = entry.lastUsedFrame;
+
+            if (reportEntry.status == AssetStatus::Loaded || reportEntry.status == AssetStatus::Failed)
+            {
+                reportEntry.memory = entry.asset->GetMemoryUsage();
+            }
+
+            AssetMemory& category = report.categories[static_cast<size_t>(reportEntry.category)];
+            category.cpuBytes += reportEntry.memory.cpuBytes;
+            category.gpuBytes += reportEntry.memory.gpuBytes;
+        }
+
+        return report;
+    }
+
+    bool AssetManager::_IsEvictable(const std::shared_ptr<Asset>& asset)
+    {
+        // A loader thread or a pending upload holds a reference too, so an asset still loading is never evicted
+        AssetStatus status = asset->GetStatus();
+        return asset.use_count() == 1 && (status == AssetStatus::Loaded || status == AssetStatus::Failed);
+    }
+
+    void AssetManager::_EnforceBudgets()
+    {
+        constexpr size_t categoryCount = static_cast<size_t>(AssetCategory::Count);
+
+        std::unique_lock lock(_mutex);
+        ++_frame;
+
+        std::array<AssetMemory, categoryCount> usage{};
+        std::array<std::vector<std::pair<uint64_t, decltype(_loadedAssets)::iterator>>, categoryCount> candidates;
+        bool hasBudget = std::any_of(_budgets.begin(),
+                                     _budgets.end(),
+                                     [](const AssetBudget& budget) { return budget.cpuBytes || budget.gpuBytes; });
+
+        for (auto it = _loadedAssets.begin(); it != _loadedAssets.end(); ++it)
+        {
+            AssetEntry& entry = it->second;
+            if (entry.asset.use_count() > 1)
+            {
+                entry.lastUsedFrame = _frame;
+            }
+
+            AssetStatus status = entry.asset->GetStatus();
+            if (!hasBudget || (status != AssetStatus::Loaded && status != AssetStatus::Failed))
+            {
+                continue;
+            }
+
+            size_t category = static_cast<size_t>(entry.asset->GetCategory());
+            AssetMemory memory = entry.asset->GetMemoryUsage();
+            usage[category].cpuBytes += memory.cpuBytes;
+            usage[category].gpuBytes += memory.gpuBytes;
+
+            if (_IsEvictable(entry.asset))
+            {
+                candidates[category].emplace_back(entry.lastUsedFrame, it);
+            }
+        }
+
+        auto isOverBudget = [](const AssetMemory& memory, const AssetBudget& budget)
+        {
+            return (budget.cpuBytes && memory.cpuBytes > budget.cpuBytes) ||
+                   (budget.gpuBytes && memory.gpuBytes > budget.gpuBytes);
+        };
+
+        for (size_t category = 0; category < categoryCount && hasBudget; ++category)
+        {
+            AssetMemory& memory = usage[category];
+            if (!isOverBudget(memory, _budgets[category]))
+            {
+                continue;
+            }
+
+            auto& categoryCandidates = candidates[category];
+            std::sort(categoryCandidates.begin(),
+                      categoryCandidates.end(),
+                      [](const auto& a, const auto& b) { return a.first < b.first; });
+
+            for (auto& [lastUsedFrame, it] : categoryCandidates)
+            {
+                if (!isOverBudget(memory, _budgets[category]))
+                {
+                    break;
+                }
+
+                AssetMemory released = it->second.asset->GetMemoryUsage();
+                memory.cpuBytes -= std::min(memory.cpuBytes, released.cpuBytes);
+                memory.gpuBytes -= std::min(memory.gpuBytes, released.gpuBytes);
+
+                FT_ENGINE_INFO("Asset evicted over budget: {}", it->first);
+                _loadedAssets.erase(it);
+                ++_evictedCount;
+            }
+        }
     }
 
     void AssetManager::PruneUnused()
@@ -67,7 +231,7 @@ namespace Frost
         std::unique_lock lock(_mutex);
         for (auto it = _loadedAssets.begin(); it != _loadedAssets.end();)
         {
-            if (it->second.use_count() == 1)
+            if (it->second.asset.use_count() == 1)
             {
                 it = _loadedAssets.erase(it);
             }
@@ -84,17 +248,15 @@ namespace Frost
             std::unique_lock lock(_mutex);
             if (auto it = _loadedAssets.find(path); it != _loadedAssets.end())
             {
-                return std::static_pointer_cast<Texture>(it->second);
+                it->second.lastUsedFrame = _frame;
+                return std::static_pointer_cast<Texture>(it->second.asset);
             }
         }
 
         config.loadImmediately = false;
         auto texture = Texture::Create(config);
 
-        {
-            std::unique_lock lock(_mutex);
-            _loadedAssets[path] = texture;
-        }
+        RegisterAsset(path, texture);
 
         std::thread(
             [texture, path, config]() mutable
@@ -107,9 +269,6 @@ namespace Frost
             })
             .detach();
 
-        auto format = texture->GetFormat();
-        FT_INFO("Texture {}", static_cast<int>(format));
-
         return texture;
     }
 } // namespace Frost
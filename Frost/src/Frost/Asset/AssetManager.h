@@ -6,22 +6,65 @@
 #include "Frost/Debugging/Assert.h"
 #include "Frost/Debugging/Logger.h"
 
+#include <array>
 #include <map>
 #include <memory>
 #include <future>
 #include <deque>
 #include <mutex>
 #include <functional>
+#include <vector>
 
 namespace Frost
 {
+    // Zero means no limit
+    struct AssetBudget
+    {
+        size_t cpuBytes = 0;
+        size_t gpuBytes = 0;
+    };
+
+    struct AssetMemoryReport
+    {
+        struct Entry
+        {
+            Asset::Path path;
+            AssetCategory category = AssetCategory::Other;
+            AssetStatus status = AssetStatus::Unloaded;
+            AssetMemory memory;
+            // References besides the manager's own, an asset without any can be evicted
+            long references = 0;
+            uint64_t lastUsedFrame = 0;
+        };
+
+        std::array<AssetMemory, static_cast<size_t>(AssetCategory::Count)> categories{};
+        std::array<AssetBudget, static_cast<size_t>(AssetCategory::Count)> budgets{};
+        std::vector<Entry> assets;
+        uint64_t frame = 0;
+        uint64_t evictedCount = 0;
+    };
+
     class FROST_API AssetManager
     {
     public:
         static void Shutdown();
+        // Runs the pending uploads, then evicts assets over budget
         static void Update();
         static void PruneUnused();
 
+        // When a category goes over its budget, its assets nothing else references are released, least recently
+        // used first. An asset is used on every frame something holds it and whenever it is loaded again.
+        static void SetBudget(AssetCategory category, const AssetBudget& budget);
+        static AssetBudget GetBudget(AssetCategory category);
+        // Set by the Application at startup, the game can change them with SetBudget afterwards:
+        //   Texture  256 MB CPU, 1 GB GPU
+        //   Model    256 MB CPU, 512 MB GPU
+        //   Font     32 MB CPU, 64 MB GPU
+        //   Other    no limit
+        static void SetDefaultBudgets();
+
+        static AssetMemoryReport GetMemoryReport();
+
         template<typename T, typename... Args>
         static std::shared_ptr<T> LoadAsset(const Asset::Path& path, Args&&... args)
             requires(!std::is_same_v<T, Texture>)
@@ -42,6 +85,10 @@ namespace Frost
 
         static std::shared_ptr<Texture> LoadAsset(const Asset::Path& path, TextureConfig& config);
 
+        // Runs load on a worker thread, then upload on the main thread within the upload time budget, even if load
+        // threw
+        static void QueueJob(std::function<void()>&& load, std::function<void()>&& upload);
+
     private:
         static std::shared_ptr<Asset> FindAsset(const Asset::Path& path);
         static void RegisterAsset(const Asset::Path& path, std::shared_ptr<Asset> asset);
@@ -72,9 +119,21 @@ namespace Frost
                 .detach();
         }
 
+        static void _EnforceBudgets();
+        static bool _IsEvictable(const std::shared_ptr<Asset>& asset);
+
     private:
+        struct AssetEntry
+        {
+            std::shared_ptr<Asset> asset;
+            uint64_t lastUsedFrame = 0;
+        };
+
         static std::mutex _mutex;
-        static std::map<Asset::Path, std::shared_ptr<Asset>> _loadedAssets;
+        static std::map<Asset::Path, AssetEntry> _loadedAssets;
+        static std::array<AssetBudget, static_cast<size_t>(AssetCategory::Count)> _budgets;
+        static uint64_t _frame;
+        static uint64_t _evictedCount;
 
         static std::mutex _queueMutex;
         static std::deque<std::function<void()>> _uploadQueue;
@@ -131,6 +131,14 @@ namespace Frost
         SetStatus(AssetStatus::Loaded);
     }
 
+    AssetMemory Font::GetMemoryUsage() const
+    {
+        // The atlas is not shared with other assets, it is counted with the font
+        AssetMemory memory = _atlasTexture ? _atlasTexture->GetMemoryUsage() : AssetMemory{};
+        memory.cpuBytes += _stagingPixels.capacity() + _metrics.size() * sizeof(CharacterMetric);
+        return memory;
+    }
+
     const CharacterMetric& Font::GetCharacterMetric(char c) const
     {
         if (_metrics.count(c))
@@ -34,6 +34,9 @@ namespace Frost
 
         Material::FilterMode GetFilterMode() const { return Material::FilterMode::LINEAR; }
 
+        virtual AssetCategory GetCategory() const override { return AssetCategory::Font; }
+        virtual AssetMemory GetMemoryUsage() const override;
+
     private:
         std::shared_ptr<Texture> _atlasTexture;
         std::unordered_map<char, CharacterMetric> _metrics;
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "Frost/Scene/ECS/ComponentFields.h"
 #include "Frost/Utils/Math/Vector.h"
 
 #include <string>
@@ -59,4 +60,67 @@ namespace Frost::Component
         uint32_t slices = 32;
         uint32_t stacks = 1;
     };
-} // namespace Frost::Component
\ No newline at end of file
+} // namespace Frost::Component
+
+namespace Frost::Reflection
+{
+    template<>
+    struct Fields<Component::MeshSourceHeightMap>
+    {
+        static constexpr const char* name = "HeightMap";
+        static constexpr auto value =
+            std::make_tuple(Field{ "TexturePath", &Component::MeshSourceHeightMap::texturePath },
+                            Field{ "Width", &Component::MeshSourceHeightMap::width },
+                            Field{ "Depth", &Component::MeshSourceHeightMap::depth },
+                            Field{ "MinHeight", &Component::MeshSourceHeightMap::minHeight },
+                            Field{ "MaxHeight", &Component::MeshSourceHeightMap::maxHeight },
+                            Field{ "SegmentWidth", &Component::MeshSourceHeightMap::segmentsWidth },
+                            Field{ "SegmentDepth", &Component::MeshSourceHeightMap::segmentsDepth },
+                            Field{ "ChunkSize", &Component::MeshSourceHeightMap::chunkSize });
+    };
+
+    template<>
+    struct Fields<Component::MeshSourceFile>
+    {
+        static constexpr const char* name = "File";
+        static constexpr auto value = std::make_tuple(Field{ "Path", &Component::MeshSourceFile::filepath });
+    };
+
+    template<>
+    struct Fields<Component::MeshSourceCube>
+    {
+        static constexpr const char* name = "Cube";
+        static constexpr auto value = std::make_tuple(Field{ "Size", &Component::MeshSourceCube::size },
+                                                      Field{ "Segments", &Component::MeshSourceCube::segments },
+                                                      Field{ "Bevel", &Component::MeshSourceCube::bevelRadius });
+    };
+
+    template<>
+    struct Fields<Component::MeshSourceSphere>
+    {
+        static constexpr const char* name = "Sphere";
+        static constexpr auto value = std::make_tuple(Field{ "Radius", &Component::MeshSourceSphere::radius },
+                                                      Field{ "Rings", &Component::MeshSourceSphere::rings },
+                                                      Field{ "Slices", &Component::MeshSourceSphere::slices });
+    };
+
+    template<>
+    struct Fields<Component::MeshSourcePlane>
+    {
+        static constexpr const char* name = "Plane";
+        static constexpr auto value = std::make_tuple(Field{ "Width", &Component::MeshSourcePlane::width },
+                                                      Field{ "Depth", &Component::MeshSourcePlane::depth });
+    };
+
+    template<>
+    struct Fields<Component::MeshSourceCylinder>
+    {
+        static constexpr const char* name = "Cylinder";
+        static constexpr auto value =
+            std::make_tuple(Field{ "BottomRadius", &Component::MeshSourceCylinder::bottomRadius },
+                            Field{ "TopRadius", &Component::MeshSourceCylinder::topRadius },
+                            Field{ "Height", &Component::MeshSourceCylinder::height },
+                            Field{ "Slices", &Component::MeshSourceCylinder::slices },
+                            Field{ "Stacks", &Component::MeshSourceCylinder::stacks });
+    };
+} // namespace Frost::Reflection
\ No newline at end of file
@@ -0,0 +1,542 @@
+#include "Frost/Asset/MeshCooker.h"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+namespace Frost
+{
+    namespace
+    {
+        constexpr uint32_t INVALID_INDEX = std::numeric_limits<uint32_t>::max();
+
+        // Forsyth's scoring, tuned for a 32 entry cache
+        constexpr uint32_t SCORING_CACHE_SIZE = 32;
+        constexpr float CACHE_DECAY_POWER = 1.5f;
+        constexpr float LAST_TRIANGLE_SCORE = 0.75f;
+        constexpr float VALENCE_BOOST_SCALE = 2.0f;
+
+        float VertexScore(int32_t cachePosition, uint32_t activeTriangles)
+        {
+            if (activeTriangles == 0)
+            {
+                return -1.0f;
+            }
+
+            float score = 0.0f;
+            if (cachePosition >= 0 && cachePosition < 3)
+            {
+                // The vertices of the last triangle, a triangle using them all would be degenerate
+                score = LAST_TRIANGLE_SCORE;
+            }
+            else if (cachePosition >= 3)
+            {
+                float scale = 1.0f / static_cast<float>(SCORING_CACHE_SIZE - 3);
+                score = std::pow(1.0f - static_cast<float>(cachePosition - 3) * scale, CACHE_DECAY_POWER);
+            }
+
+            // Vertices with few triangles left are finished first, so they leave the cache for good
+            return score + VALENCE_BOOST_SCALE / std::sqrt(static_cast<float>(activeTriangles));
+        }
+
+        // FIFO cache where a vertex is cached while fewer than cacheSize vertices were added after it
+        class FifoCache
+        {
+        public:
+            FifoCache(size_t vertexCount, uint32_t cacheSize) :
+                _addedAt(vertexCount, 0), _time{ cacheSize + 1 }, _size{ cacheSize }
+            {
+            }
+
+            // Returns true on a miss
+            bool Touch(uint32_t vertex)
+            {
+                if (_time - _addedAt[vertex] <= _size)
+                {
+                    return false;
+                }
+
+                _addedAt[vertex] = _time++;
+                return true;
+            }
+
+        private:
+            std::vector<uint32_t> _addedAt;
+            uint32_t _time;
+            uint32_t _size;
+        };
+
+        using VertexWords = std::array<uint32_t, sizeof(Vertex) / sizeof(uint32_t)>;
+
+        VertexWords CanonicalWords(const Vertex& vertex)
+        {
+            VertexWords words;
+            std::memcpy(words.data(), &vertex, sizeof(Vertex));
+
+            // -0 and 0 are the same attribute
+            for (uint32_t& word : words)
+            {
+                if (word == 0x80000000u)
+                {
+                    word = 0;
+                }
+            }
+            return words;
+        }
+
+        uint64_t HashWords(const VertexWords& words)
+        {
+            uint64_t hash = 14695981039346656037ull;
+            for (uint32_t word : words)
+            {
+                hash = (hash ^ word) * 1099511628211ull;
+            }
+            return hash ^ (hash >> 29);
+        }
+
+        uint32_t PackSnorm8(float x, float y, float z, float w)
+        {
+            auto quantize = [](float value)
+            {
+                value = std::isfinite(value) ? std::clamp(value, -1.0f, 1.0f) : 0.0f;
+                return static_cast<uint32_t>(static_cast<uint8_t>(static_cast<int8_t>(std::lround(value * 127.0f))));
+            };
+            return quantize(x) | (quantize(y) << 8) | (quantize(z) << 16) | (quantize(w) << 24);
+        }
+
+        float UnpackSnorm8(uint32_t packed, uint32_t component)
+        {
+            int8_t value = static_cast<int8_t>((packed >> (component * 8)) & 0xFF);
+            return std::max(static_cast<float>(value) / 127.0f, -1.0f);
+        }
+
+        // Rounds to nearest even, out of range values become infinities
+        uint16_t FloatToHalf(float value)
+        {
+            constexpr uint32_t floatInfinity = 255u << 23;
+            constexpr uint32_t halfOverflow = (127u + 16u) << 23;
+            constexpr uint32_t denormalMagic = ((127u - 15u) + (23u - 10u) + 1u) << 23;
+
+            uint32_t bits = std::bit_cast<uint32_t>(value);
+            uint32_t sign = bits & 0x80000000u;
+            bits ^= sign;
+
+            uint16_t half;
+            if (bits >= halfOverflow)
+            {
+                half = bits > floatInfinity ? 0x7E00 : 0x7C00;
+            }
+            else if (bits < (113u << 23))
+            {
+                // Below the smallest normal half, the float addition does the rounding
+                float shifted = std::bit_cast<float>(bits) + std::bit_cast<float>(denormalMagic);
+                half = static_cast<uint16_t>(std::bit_cast<uint32_t>(shifted) - denormalMagic);
+            }
+            else
+            {
+                uint32_t isMantissaOdd = (bits >> 13) & 1;
+                bits += (static_cast<uint32_t>(15 - 127) << 23) + 0xFFF;
+                bits += isMantissaOdd;
+                half = static_cast<uint16_t>(bits >> 13);
+            }
+
+            return static_cast<uint16_t>(half | (sign >> 16));
+        }
+
+        float HalfToFloat(uint16_t half)
+        {
+            uint32_t sign = static_cast<uint32_t>(half & 0x8000) << 16;
+            uint32_t exponent = (half >> 10) & 0x1F;
+            uint32_t mantissa = half & 0x3FF;
+
+            if (exponent == 0)
+            {
+                float value = std::ldexp(static_cast<float>(mantissa), -24);
+                return sign ? -value : value;
+            }
+
+            uint32_t bits = exponent == 31 ? sign | 0x7F800000u | (mantissa << 13)
+                                           : sign | ((exponent + 112) << 23) | (mantissa << 13);
+            return std::bit_cast<float>(bits);
+        }
+    } // namespace
+
+    void MeshCooker::Optimize(std::vector<Vertex>& vertices, std::vector<uint32_t>& indices)
+    {
+        WeldVertices(vertices, indices);
+        OptimizeVertexCache(indices, vertices.size());
+        OptimizeOverdraw(indices, vertices);
+        OptimizeVertexFetch(vertices, indices);
+    }
+
+    size_t MeshCooker::WeldVertices(std::vector<Vertex>& vertices, std::vector<uint32_t>& indices)
+    {
+        if (vertices.empty())
+        {
+            return 0;
+        }
+
+        // Open addressing over the welded vertices, at most half full
+        size_t tableSize = std::bit_ceil(vertices.size() * 2);
+        std::vector<uint32_t> table(tableSize, INVALID_INDEX);
+        std::vector<VertexWords> weldedWords;
+        weldedWords.reserve(vertices.size());
+
+        std::vector<uint32_t> remap(vertices.size());
+        std::vector<Vertex> welded;
+        welded.reserve(vertices.size());
+
+        for (size_t i = 0; i < vertices.size(); ++i)
+        {
+            VertexWords words = CanonicalWords(vertices[i]);
+            size_t slot = HashWords(words) & (tableSize - 1);
+            while (table[slot] != INVALID_INDEX && weldedWords[table[slot]] != words)
+            {
+                slot = (slot + 1) & (tableSize - 1);
+            }
+
+            if (table[slot] == INVALID_INDEX)
+            {
+                table[slot] = static_cast<uint32_t>(welded.size());
+                weldedWords.push_back(words);
+                welded.push_back(vertices[i]);
+            }
+            remap[i] = table[slot];
+        }
+
+        for (uint32_t& index : indices)
+        {
+            index = index < remap.size() ? remap[index] : index;
+        }
+
+        size_t removed = vertices.size() - welded.size();
+        vertices = std::move(welded);
+        return removed;
+    }
+
+    void MeshCooker::OptimizeVertexCache(std::span<uint32_t> indices, size_t vertexCount)
+    {
+        size_t triangleCount = indices.size() / 3;
+        if (triangleCount == 0)
+        {
+            return;
+        }
+
+        // Triangles of each vertex, those not drawn yet are kept at the front of each range
+        std::vector<uint32_t> activeCount(vertexCount, 0);
+        for (size_t i = 0; i < triangleCount * 3; ++i)
+        {
+            ++activeCount[indices[i]];
+        }
+
+        std::vector<uint32_t> firstTriangle(vertexCount + 1, 0);
+        for (size_t v = 0; v < vertexCount; ++v)
+        {
+            firstTriangle[v + 1] = firstTriangle[v] + activeCount[v];
+        }
+
+        std::vector<uint32_t> triangles(triangleCount * 3);
+        std::vector<uint32_t> fill(firstTriangle.begin(), firstTriangle.end() - 1);
+        for (size_t t = 0; t < triangleCount; ++t)
+        {
+            for (size_t k = 0; k < 3; ++k)
+            {
+                triangles[fill[indices[t * 3 + k]]++] = static_cast<uint32_t>(t);
+            }
+        }
+
+        std::vector<int32_t> cachePosition(vertexCount, -1);
+        std::vector<float> vertexScores(vertexCount);
+        for (size_t v = 0; v < vertexCount; ++v)
+        {
+            vertexScores[v] = VertexScore(-1, activeCount[v]);
+        }
+
+        std::vector<float> triangleScores(triangleCount);
+        std::vector<bool> isEmitted(triangleCount, false);
+        uint32_t best = 0;
+        for (size_t t = 0; t < triangleCount; ++t)
+        {
+            triangleScores[t] = vertexScores[indices[t * 3]] + vertexScores[indices[t * 3 + 1]] +
+                                vertexScores[indices[t * 3 + 2]];
+            if (triangleScores[t] > triangleScores[best])
+            {
+                best = static_cast<uint32_t>(t);
+            }
+        }
+
+        std::vector<uint32_t> ordered;
+        ordered.reserve(triangleCount * 3);
+
+        std::array<uint32_t, SCORING_CACHE_SIZE + 3> cache;
+        std::array<uint32_t, SCORING_CACHE_SIZE + 3> nextCache;
+        uint32_t cacheCount = 0;
+        size_t deadEndCursor = 0;
+
+        for (size_t emitted = 0; emitted < triangleCount; ++emitted)
+        {
+            // Nothing left around the cache, the next triangle in input order starts elsewhere
+            if (best == INVALID_INDEX)
+            {
+                while (isEmitted[deadEndCursor])
+                {
+                    ++deadEndCursor;
+                }
+                best = static_cast<uint32_t>(deadEndCursor);
+            }
+
+            isEmitted[best] = true;
+            const uint32_t* triangle = &indices[best * 3];
+
+            uint32_t nextCount = 0;
+            for (size_t k = 0; k < 3; ++k)
+            {
+                uint32_t vertex = triangle[k];
+                ordered.push_back(vertex);
+
+                uint32_t* begin = &triangles[firstTriangle[vertex]];
+                uint32_t* end = begin + activeCount[vertex];
+                std::iter_swap(std::find(begin, end, best), end - 1);
+                --activeCount[vertex];
+
+                if (std::find(nextCache.begin(), nextCache.begin() + nextCount, vertex) ==
+                    nextCache.begin() + nextCount)
+                {
+                    nextCache[nextCount++] = vertex;
+                }
+            }
+
+            for (uint32_t i = 0; i < cacheCount; ++i)
+            {
+                uint32_t vertex = cache[i];
+                if (vertex != triangle[0] && vertex != triangle[1] && vertex != triangle[2])
+                {
+                    nextCache[nextCount++] = vertex;
+                }
+            }
+
+            // The vertices pushed out of the cache are scored as well, their triangles lose their cache bonus
+            for (uint32_t i = 0; i < nextCount; ++i)
+            {
+                uint32_t vertex = nextCache[i];
+                cachePosition[vertex] = i < SCORING_CACHE_SIZE ? static_cast<int32_t>(i) : -1;
+                vertexScores[vertex] = VertexScore(cachePosition[vertex], activeCount[vertex]);
+            }
+
+            best = INVALID_INDEX;
+            float bestScore = -std::numeric_limits<float>::max();
+            for (uint32_t i = 0; i < nextCount; ++i)
+            {
+                uint32_t vertex = nextCache[i];
+                for (uint32_t j = 0; j < activeCount[vertex]; ++j)
+                {
+                    uint32_t t = triangles[firstTriangle[vertex] + j];
+                    float score = vertexScores[indices[t * 3]] + vertexScores[indices[t * 3 + 1]] +
+                                  vertexScores[indices[t * 3 + 2]];
+                    triangleScores[t] = score;
+                    if (score > bestScore)
+                    {
+                        bestScore = score;
+                        best = t;
+                    }
+                }
+            }
+
+            cacheCount = std::min(nextCount, SCORING_CACHE_SIZE);
+            std::copy_n(nextCache.begin(), cacheCount, cache.begin());
+        }
+
+        std::copy(ordered.begin(), ordered.end(), indices.begin());
+    }
+
+    void MeshCooker::OptimizeOverdraw(std::span<uint32_t> indices, std::span<const Vertex> vertices)
+    {
+        size_t triangleCount = indices.size() / 3;
+        if (triangleCount < 2)
+        {
+            return;
+        }
+
+        // A triangle missing the cache on its three vertices starts a cluster, the order of the clusters barely
+        // matters to the cache
+        std::vector<uint32_t> clusterStarts;
+        FifoCache cache(vertices.size(), STATISTICS_CACHE_SIZE);
+        for (size_t t = 0; t < triangleCount; ++t)
+        {
+            uint32_t misses = 0;
+            for (size_t k = 0; k < 3; ++k)
+            {
+                misses += cache.Touch(indices[t * 3 + k]) ? 1 : 0;
+            }
+
+            if (misses == 3 || t == 0)
+            {
+                clusterStarts.push_back(static_cast<uint32_t>(t));
+            }
+        }
+        clusterStarts.push_back(static_cast<uint32_t>(triangleCount));
+
+        if (clusterStarts.size() <= 2)
+        {
+            return;
+        }
+
+        struct Cluster
+        {
+            uint32_t first;
+            uint32_t last;
+            Math::Vector3 centroid;
+            Math::Vector3 normal;
+            float sortKey;
+        };
+
+        std::vector<Cluster> clusters;
+        clusters.reserve(clusterStarts.size() - 1);
+
+        Math::Vector3 meshCentroid = { 0.0f, 0.0f, 0.0f };
+        float meshArea = 0.0f;
+
+        for (size_t c = 0; c + 1 < clusterStarts.size(); ++c)
+        {
+            Cluster cluster = { clusterStarts[c], clusterStarts[c + 1], { 0, 0, 0 }, { 0, 0, 0 }, 0.0f };
+            float clusterArea = 0.0f;
+
+            for (uint32_t t = cluster.first; t < cluster.last; ++t)
+            {
+                const Vertex& v0 = vertices[indices[t * 3]];
+                const Vertex& v1 = vertices[indices[t * 3 + 1]];
+                const Vertex& v2 = vertices[indices[t * 3 + 2]];
+
+                // The vertex normals give the facing, the winding depends on the importer flags
+                float area = Length(Cross(v1.position - v0.position, v2.position - v0.position)) * 0.5f;
+                Math::Vector3 center = (v0.position + v1.position + v2.position) / 3.0f;
+
+                cluster.centroid = cluster.centroid + center * area;
+                cluster.normal = cluster.normal + (v0.normal + v1.normal + v2.normal) * area;
+                clusterArea += area;
+            }
+
+            meshCentroid = meshCentroid + cluster.centroid;
+            meshArea += clusterArea;
+
+            if (clusterArea > 0.0f)
+            {
+                cluster.centroid = cluster.centroid / clusterArea;
+            }
+            clusters.push_back(cluster);
+        }
+
+        if (meshArea > 0.0f)
+        {
+            meshCentroid = meshCentroid / meshArea;
+        }
+
+        for (Cluster& cluster : clusters)
+        {
+            float normalLength = Length(cluster.normal);
+            cluster.sortKey =
+                normalLength > 0.0f ? Dot(cluster.centroid - meshCentroid, cluster.normal) / normalLength : 0.0f;
+        }
+
+        std::stable_sort(clusters.begin(),
+                         clusters.end(),
+                         [](const Cluster& a, const Cluster& b) { return a.sortKey > b.sortKey; });
+
+        std::vector<uint32_t> ordered;
+        ordered.reserve(triangleCount * 3);
+        for (const Cluster& cluster : clusters)
+        {
+            ordered.insert(ordered.end(), indices.begin() + cluster.first * 3, indices.begin() + cluster.last * 3);
+        }
+
+        std::copy(ordered.begin(), ordered.end(), indices.begin());
+    }
+
+    void MeshCooker::OptimizeVertexFetch(std::vector<Vertex>& vertices, std::span<uint32_t> indices)
+    {
+        std::vector<uint32_t> remap(vertices.size(), INVALID_INDEX);
+        std::vector<Vertex> ordered;
+        ordered.reserve(vertices.size());
+
+        for (uint32_t& index : indices)
+        {
+            if (remap[index] == INVALID_INDEX)
+            {
+                remap[index] = static_cast<uint32_t>(ordered.size());
+                ordered.push_back(vertices[index]);
+            }
+            index = remap[index];
+        }
+
+        vertices = std::move(ordered);
+    }
+
+    MeshCooker::Statistics MeshCooker::Analyze(std::span<const uint32_t> indices,
+                                               size_t vertexCount,
+                                               uint32_t cacheSize)
+    {
+        Statistics statistics;
+        statistics.vertexCount = vertexCount;
+        statistics.triangleCount = indices.size() / 3;
+        if (statistics.triangleCount == 0 || vertexCount == 0)
+        {
+            return statistics;
+        }
+
+        FifoCache cache(vertexCount, cacheSize);
+        size_t misses = 0;
+        for (uint32_t index : indices)
+        {
+            misses += cache.Touch(index) ? 1 : 0;
+        }
+
+        statistics.acmr = static_cast<float>(misses) / static_cast<float>(statistics.triangleCount);
+        statistics.atvr = static_cast<float>(misses) / static_cast<float>(vertexCount);
+        return statistics;
+    }
+
+    bool MeshCooker::CanCompress(std::span<const Vertex> vertices, float maxTexCoord)
+    {
+        return std::ranges::all_of(vertices,
+                                   [&](const Vertex& vertex)
+                                   {
+                                       return std::abs(vertex.texCoord.x) <= maxTexCoord &&
+                                              std::abs(vertex.texCoord.y) <= maxTexCoord;
+                                   });
+    }
+
+    std::vector<CompactVertex> MeshCooker::Compress(std::span<const Vertex> vertices)
+    {
+        std::vector<CompactVertex> compact(vertices.size());
+        for (size_t i = 0; i < vertices.size(); ++i)
+        {
+            const Vertex& vertex = vertices[i];
+            float bitangentSign = vertex.tangent.w < 0.0f ? -1.0f : 1.0f;
+
+            compact[i].position = vertex.position;
+            compact[i].normal = PackSnorm8(vertex.normal.x, vertex.normal.y, vertex.normal.z, 0.0f);
+            compact[i].tangent = PackSnorm8(vertex.tangent.x, vertex.tangent.y, vertex.tangent.z, bitangentSign);
+            compact[i].texCoord[0] = FloatToHalf(vertex.texCoord.x);
+            compact[i].texCoord[1] = FloatToHalf(vertex.texCoord.y);
+        }
+        return compact;
+    }
+
+    Vertex MeshCooker::Decompress(const CompactVertex& vertex)
+    {
+        Vertex result{};
+        result.position = vertex.position;
+        result.normal = { UnpackSnorm8(vertex.normal, 0),
+                          UnpackSnorm8(vertex.normal, 1),
+                          UnpackSnorm8(vertex.normal, 2) };
+        result.tangent = { UnpackSnorm8(vertex.tangent, 0),
+                           UnpackSnorm8(vertex.tangent, 1),
+                           UnpackSnorm8(vertex.tangent, 2),
+                           UnpackSnorm8(vertex.tangent, 3) };
+        result.texCoord = { HalfToFloat(vertex.texCoord[0]), HalfToFloat(vertex.texCoord[1]) };
+        return result;
+    }
+} // namespace Frost
@@ -0,0 +1,58 @@
+#pragma once
+
+#include "Frost/Core/Core.h"
+#include "Frost/Renderer/Vertex.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace Frost
+{
+    // CPU stage between import and upload: welds the duplicated vertices importers produce, orders the triangles for
+    // the post-transform vertex cache then for overdraw, and the vertices for fetch locality. Everything here works
+    // on plain arrays, so the results can be checked without a device.
+    class FROST_API MeshCooker
+    {
+    public:
+        struct Statistics
+        {
+            size_t vertexCount = 0;
+            size_t triangleCount = 0;
+            // Average cache misses per triangle and per vertex, 0.5 and 1 are the best a mesh can get
+            float acmr = 0.0f;
+            float atvr = 0.0f;
+        };
+
+        // Simulated FIFO cache of the statistics, close to what current GPUs keep between triangles
+        static constexpr uint32_t STATISTICS_CACHE_SIZE = 16;
+
+        // Welds, then reorders for the vertex cache, overdraw and fetch
+        static void Optimize(std::vector<Vertex>& vertices, std::vector<uint32_t>& indices);
+
+        // Merges the vertices with identical attributes, returns the number of vertices removed
+        static size_t WeldVertices(std::vector<Vertex>& vertices, std::vector<uint32_t>& indices);
+
+        // Forsyth's linear-speed ordering: the next triangle is the one whose vertices score best, by their position
+        // in a simulated cache and the number of triangles they still have to draw
+        static void OptimizeVertexCache(std::span<uint32_t> indices, size_t vertexCount);
+
+        // Splits the cache-ordered triangles where the cache restarts anyway, and draws the clusters facing outwards
+        // first, so they tend to hide the ones behind them
+        static void OptimizeOverdraw(std::span<uint32_t> indices, std::span<const Vertex> vertices);
+
+        // Renumbers the vertices in the order the indices first use them, unused vertices are dropped
+        static void OptimizeVertexFetch(std::vector<Vertex>& vertices, std::span<uint32_t> indices);
+
+        static Statistics Analyze(std::span<const uint32_t> indices,
+                                  size_t vertexCount,
+                                  uint32_t cacheSize = STATISTICS_CACHE_SIZE);
+
+        // Half precision rounds texture coordinates below 2 by at most a texel of a 2048 texture, meshes with larger
+        // ones stay in floats
+        static bool CanCompress(std::span<const Vertex> vertices, float maxTexCoord = 2.0f);
+        static std::vector<CompactVertex> Compress(std::span<const Vertex> vertices);
+        static Vertex Decompress(const CompactVertex& vertex);
+    };
+} // namespace Frost
@@ -0,0 +1,493 @@
+#include "Frost/Asset/MeshSimplifier.h"
+#include "Frost/Asset/MeshCooker.h"
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <numeric>
+
+namespace Frost
+{
+    namespace
+    {
+        // Open borders weigh more than the surface, so the outline of open meshes holds longer
+        constexpr double BORDER_WEIGHT = 10.0;
+        // A level has to drop that fraction of the triangles of the previous one to be worth keeping
+        constexpr float MIN_LOD_REDUCTION = 0.15f;
+
+        enum class VertexKind : uint8_t
+        {
+            Manifold,
+            // On one open border, only collapses along it
+            Border,
+            // On a seam, a non-manifold edge or several borders
+            Locked
+        };
+
+        // Sum of squared distances to planes, weighted by the area they come from
+        struct Quadric
+        {
+            double a00 = 0.0, a11 = 0.0, a22 = 0.0, a01 = 0.0, a02 = 0.0, a12 = 0.0;
+            double b0 = 0.0, b1 = 0.0, b2 = 0.0;
+            double c = 0.0;
+            double weight = 0.0;
+
+            void AddPlane(const Math::Vector3& normal, const Math::Vector3& point, double planeWeight)
+            {
+                double x = normal.x, y = normal.y, z = normal.z;
+                double d = -(x * point.x + y * point.y + z * point.z);
+
+                a00 += planeWeight * x * x;
+                a11 += planeWeight * y * y;
+                a22 += planeWeight * z * z;
+                a01 += planeWeight * x * y;
+                a02 += planeWeight * x * z;
+                a12 += planeWeight * y * z;
+                b0 += planeWeight * x * d;
+                b1 += planeWeight * y * d;
+                b2 += planeWeight * z * d;
+                c += planeWeight * d * d;
+                weight += planeWeight;
+            }
+
+            void Add(const Quadric& other)
+            {
+                a00 += other.a00;
+                a11 += other.a11;
+                a22 += other.a22;
+                a01 += other.a01;
+                a02 += other.a02;
+                a12 += other.a12;
+                b0 += other.b0;
+                b1 += other.b1;
+                b2 += other.b2;
+                c += other.c;
+                weight += other.weight;
+            }
+
+            // Mean squared distance of the point to the planes
+            double Evaluate(const Math::Vector3& point) const
+            {
+                if (weight <= 0.0)
+                {
+                    return 0.0;
+                }
+
+                double x = point.x, y = point.y, z = point.z;
+                double result = a00 * x * x + a11 * y * y + a22 * z * z;
+                result += 2.0 * (a01 * x * y + a02 * x * z + a12 * y * z);
+                result += 2.0 * (b0 * x + b1 * y + b2 * z) + c;
+                return std::max(result, 0.0) / weight;
+            }
+        };
+
+        // Vertices at the same position share the first of them as owner, the owner counts the wedges
+        void GroupPositions(std::span<const Vertex> vertices,
+                            std::vector<uint32_t>& owners,
+                            std::vector<uint32_t>& wedgeCounts)
+        {
+            std::vector<uint32_t> order(vertices.size());
+            std::iota(order.begin(), order.end(), 0u);
+
+            auto less = [&](uint32_t a, uint32_t b)
+            {
+                const Math::Vector3& pa = vertices[a].position;
+                const Math::Vector3& pb = vertices[b].position;
+                if (pa.x != pb.x)
+                    return pa.x < pb.x;
+                if (pa.y != pb.y)
+                    return pa.y < pb.y;
+                if (pa.z != pb.z)
+                    return pa.z < pb.z;
+                return a < b;
+            };
+            std::sort(order.begin(), order.end(), less);
+
+            owners.assign(vertices.size(), 0);
+            wedgeCounts.assign(vertices.size(), 0);
+            for (size_t i = 0; i < order.size();)
+            {
+                const Math::Vector3& position = vertices[order[i]].position;
+                size_t end = i;
+                while (end < order.size() && vertices[order[end]].position.x == position.x &&
+                       vertices[order[end]].position.y == position.y && vertices[order[end]].position.z == position.z)
+                {
+                    owners[order[end]] = order[i];
+                    ++end;
+                }
+
+                wedgeCounts[order[i]] = static_cast<uint32_t>(end - i);
+                i = end;
+            }
+        }
+
+        struct Collapse
+        {
+            uint32_t from;
+            uint32_t to;
+            float cost;
+        };
+    } // namespace
+
+    std::vector<uint32_t> MeshSimplifier::Simplify(std::span<const Vertex> vertices,
+                                                   std::span<const uint32_t> indices,
+                                                   size_t targetIndexCount,
+                                                   float maxError,
+                                                   float& error)
+    {
+        error = 0.0f;
+
+        std::vector<uint32_t> owners;
+        std::vector<uint32_t> wedgeCounts;
+        GroupPositions(vertices, owners, wedgeCounts);
+
+        // Triangles collapsed to a line or a point by the position groups are dropped right away
+        std::vector<uint32_t> current;
+        current.reserve(indices.size());
+        for (size_t t = 0; t + 2 < indices.size(); t += 3)
+        {
+            uint32_t o0 = owners[indices[t]], o1 = owners[indices[t + 1]], o2 = owners[indices[t + 2]];
+            if (o0 != o1 && o1 != o2 && o0 != o2)
+            {
+                current.insert(current.end(), indices.begin() + t, indices.begin() + t + 3);
+            }
+        }
+
+        if (current.size() <= targetIndexCount)
+        {
+            return current;
+        }
+
+        const size_t vertexCount = vertices.size();
+        auto position = [&](uint32_t vertex) -> const Math::Vector3& { return vertices[vertex].position; };
+
+        // Triangles around each position, rebuilt after every pass
+        std::vector<uint32_t> firstTriangle(vertexCount + 1);
+        std::vector<uint32_t> triangles;
+        auto buildFans = [&]()
+        {
+            std::fill(firstTriangle.begin(), firstTriangle.end(), 0);
+            for (uint32_t vertex : current)
+            {
+                ++firstTriangle[owners[vertex] + 1];
+            }
+            std::partial_sum(firstTriangle.begin(), firstTriangle.end(), firstTriangle.begin());
+
+            triangles.resize(current.size());
+            std::vector<uint32_t> fill(firstTriangle.begin(), firstTriangle.end() - 1);
+            for (size_t i = 0; i < current.size(); ++i)
+            {
+                triangles[fill[owners[current[i]]]++] = static_cast<uint32_t>(i / 3);
+            }
+        };
+
+        // Number of triangles with the directed edge between the two positions, looked up in the fan of the first
+        auto countEdge = [&](uint32_t fromOwner, uint32_t toOwner)
+        {
+            uint32_t count = 0;
+            for (uint32_t i = firstTriangle[fromOwner]; i < firstTriangle[fromOwner + 1]; ++i)
+            {
+                const uint32_t* triangle = &current[triangles[i] * 3];
+                for (size_t k = 0; k < 3; ++k)
+                {
+                    if (owners[triangle[k]] == fromOwner && owners[triangle[(k + 1) % 3]] == toOwner)
+                    {
+                        ++count;
+                    }
+                }
+            }
+            return count;
+        };
+
+        buildFans();
+
+        // Classification, on the edges between positions
+        std::vector<VertexKind> kinds(vertexCount, VertexKind::Manifold);
+        std::vector<uint32_t> openEdges(vertexCount, 0);
+        for (size_t t = 0; t < current.size(); t += 3)
+        {
+            for (size_t k = 0; k < 3; ++k)
+            {
+                uint32_t from = owners[current[t + k]];
+                uint32_t to = owners[current[t + (k + 1) % 3]];
+                if (countEdge(from, to) > 1)
+                {
+                    kinds[from] = VertexKind::Locked;
+                    kinds[to] = VertexKind::Locked;
+                }
+                if (countEdge(to, from) == 0)
+                {
+                    ++openEdges[from];
+                    ++openEdges[to];
+                }
+            }
+        }
+
+        for (size_t v = 0; v < vertexCount; ++v)
+        {
+            if (owners[v] != v)
+            {
+                continue;
+            }
+
+            if (wedgeCounts[v] > 1 || openEdges[v] > 2)
+            {
+                kinds[v] = VertexKind::Locked;
+            }
+            else if (openEdges[v] == 2 && kinds[v] == VertexKind::Manifold)
+            {
+                kinds[v] = VertexKind::Border;
+            }
+        }
+
+        // Quadrics of the triangle planes, plus planes through the open edges perpendicular to their triangle
+        std::vector<Quadric> quadrics(vertexCount);
+        for (size_t t = 0; t < current.size(); t += 3)
+        {
+            const Math::Vector3& p0 = position(current[t]);
+            const Math::Vector3& p1 = position(current[t + 1]);
+            const Math::Vector3& p2 = position(current[t + 2]);
+
+            Math::Vector3 normal = Cross(p1 - p0, p2 - p0);
+            float length = Length(normal);
+            if (length <= 0.0f)
+            {
+                continue;
+            }
+            normal = normal / length;
+
+            for (size_t k = 0; k < 3; ++k)
+            {
+                quadrics[owners[current[t + k]]].AddPlane(normal, p0, length * 0.5);
+            }
+
+            for (size_t k = 0; k < 3; ++k)
+            {
+                uint32_t from = owners[current[t + k]];
+                uint32_t to = owners[current[t + (k + 1) % 3]];
+                if (openEdges[from] == 0 || countEdge(to, from) > 0)
+                {
+                    continue;
+                }
+
+                Math::Vector3 edge = position(to) - position(from);
+                Math::Vector3 edgeNormal = Cross(edge, normal);
+                float edgeLength = Length(edgeNormal);
+                if (edgeLength > 0.0f)
+                {
+                    double borderWeight = BORDER_WEIGHT * Dot(edge, edge);
+                    quadrics[from].AddPlane(edgeNormal / edgeLength, position(from), borderWeight);
+                    quadrics[to].AddPlane(edgeNormal / edgeLength, position(from), borderWeight);
+                }
+            }
+        }
+
+        const double maxCost = static_cast<double>(maxError) * maxError;
+        double reachedCost = 0.0;
+
+        std::vector<uint32_t> remap(vertexCount);
+        std::vector<uint8_t> isTouched(vertexCount);
+        std::vector<Collapse> collapses;
+
+        // Each pass collapses independent edges, cheapest first, then rebuilds the triangles
+        for (bool isFirstPass = true; current.size() > targetIndexCount; isFirstPass = false)
+        {
+            size_t triangleCount = current.size() / 3;
+            if (!isFirstPass)
+            {
+                buildFans();
+            }
+
+            auto canCollapse = [&](uint32_t fromOwner, uint32_t toOwner, bool isOpen)
+            {
+                switch (kinds[fromOwner])
+                {
+                    case VertexKind::Manifold:
+                        return true;
+                    case VertexKind::Border:
+                        return isOpen && kinds[toOwner] != VertexKind::Manifold;
+                    default:
+                        return false;
+                }
+            };
+
+            // One collapse per edge, in its cheaper direction
+            collapses.clear();
+            for (size_t t = 0; t < current.size(); t += 3)
+            {
+                for (size_t k = 0; k < 3; ++k)
+                {
+                    uint32_t a = current[t + k];
+                    uint32_t b = current[t + (k + 1) % 3];
+                    uint32_t ownerA = owners[a];
+                    uint32_t ownerB = owners[b];
+
+                    // Interior edges are seen from both of their triangles
+                    bool isOpen = countEdge(ownerB, ownerA) == 0;
+                    if (ownerA > ownerB && !isOpen)
+                    {
+                        continue;
+                    }
+
+                    bool canCollapseA = canCollapse(ownerA, ownerB, isOpen);
+                    bool canCollapseB = canCollapse(ownerB, ownerA, isOpen);
+                    if (!canCollapseA && !canCollapseB)
+                    {
+                        continue;
+                    }
+
+                    Quadric quadric = quadrics[ownerA];
+                    quadric.Add(quadrics[ownerB]);
+                    float costA = canCollapseA ? static_cast<float>(quadric.Evaluate(position(b))) : FLT_MAX;
+                    float costB = canCollapseB ? static_cast<float>(quadric.Evaluate(position(a))) : FLT_MAX;
+                    collapses.push_back(costA <= costB ? Collapse{ a, b, costA } : Collapse{ b, a, costB });
+                }
+            }
+
+            std::sort(collapses.begin(),
+                      collapses.end(),
+                      [](const Collapse& a, const Collapse& b) { return a.cost < b.cost; });
+
+            std::iota(remap.begin(), remap.end(), 0u);
+            std::fill(isTouched.begin(), isTouched.end(), 0);
+
+            // A collapse must not turn a triangle of the fan over, the triangles on the collapsed edge vanish
+            auto flipsTriangles = [&](uint32_t from, uint32_t to)
+            {
+                uint32_t fromOwner = owners[from];
+                uint32_t toOwner = owners[to];
+                for (uint32_t i = firstTriangle[fromOwner]; i < firstTriangle[fromOwner + 1]; ++i)
+                {
+                    uint32_t t = triangles[i];
+                    uint32_t corners[3] = { remap[current[t * 3]],
+                                            remap[current[t * 3 + 1]],
+                                            remap[current[t * 3 + 2]] };
+                    uint32_t cornerOwners[3] = { owners[corners[0]], owners[corners[1]], owners[corners[2]] };
+                    if (cornerOwners[0] == toOwner || cornerOwners[1] == toOwner || cornerOwners[2] == toOwner ||
+                        cornerOwners[0] == cornerOwners[1] || cornerOwners[1] == cornerOwners[2] ||
+                        cornerOwners[0] == cornerOwners[2])
+                    {
+                        continue;
+                    }
+
+                    Math::Vector3 before[3] = { position(corners[0]), position(corners[1]), position(corners[2]) };
+                    Math::Vector3 after[3] = { before[0], before[1], before[2] };
+                    for (size_t k = 0; k < 3; ++k)
+                    {
+                        if (cornerOwners[k] == fromOwner)
+                        {
+                            after[k] = position(to);
+                        }
+                    }
+
+                    Math::Vector3 normalBefore = Cross(before[1] - before[0], before[2] - before[0]);
+                    Math::Vector3 normalAfter = Cross(after[1] - after[0], after[2] - after[0]);
+                    if (Dot(normalBefore, normalAfter) <= 0.0f)
+                    {
+                        return true;
+                    }
+                }
+                return false;
+            };
+
+            size_t remainingTriangles = triangleCount;
+            size_t targetTriangles = targetIndexCount / 3;
+            size_t collapsedCount = 0;
+            for (const Collapse& collapse : collapses)
+            {
+                if (remainingTriangles <= targetTriangles || collapse.cost > maxCost)
+                {
+                    break;
+                }
+
+                uint32_t fromOwner = owners[collapse.from];
+                uint32_t toOwner = owners[collapse.to];
+                if (isTouched[fromOwner] || isTouched[toOwner] || flipsTriangles(collapse.from, collapse.to))
+                {
+                    continue;
+                }
+
+                remap[collapse.from] = collapse.to;
+                quadrics[toOwner].Add(quadrics[fromOwner]);
+                isTouched[fromOwner] = 1;
+                isTouched[toOwner] = 1;
+
+                reachedCost = std::max(reachedCost, static_cast<double>(collapse.cost));
+                // An interior collapse removes the two triangles on the edge, a border one the single one
+                size_t removed = kinds[fromOwner] == VertexKind::Border ? 1 : 2;
+                remainingTriangles -= std::min(remainingTriangles, removed);
+                ++collapsedCount;
+            }
+
+            if (collapsedCount == 0)
+            {
+                break;
+            }
+
+            size_t kept = 0;
+            for (size_t t = 0; t < current.size(); t += 3)
+            {
+                uint32_t a = remap[current[t]], b = remap[current[t + 1]], c = remap[current[t + 2]];
+                if (owners[a] != owners[b] && owners[b] != owners[c] && owners[a] != owners[c])
+                {
+                    current[kept++] = a;
+                    current[kept++] = b;
+                    current[kept++] = c;
+                }
+            }
+            current.resize(kept);
+        }
+
+        error = static_cast<float>(std::sqrt(reachedCost));
+        return current;
+    }
+
+    std::vector<MeshLod> MeshSimplifier::GenerateLods(std::span<const Vertex> vertices,
+                                                      std::vector<uint32_t>& indices,
+                                                      uint32_t maxLodCount,
+                                                      float reduction,
+                                                      float maxError)
+    {
+        const uint32_t sourceCount = static_cast<uint32_t>(indices.size());
+        std::vector<MeshLod> lods = { { 0, sourceCount, 0.0f } };
+        if (sourceCount == 0 || maxLodCount <= 1)
+        {
+            return lods;
+        }
+
+        Math::Vector3 boundsMin = { FLT_MAX, FLT_MAX, FLT_MAX };
+        Math::Vector3 boundsMax = { -FLT_MAX, -FLT_MAX, -FLT_MAX };
+        for (uint32_t index : indices)
+        {
+            const Math::Vector3& p = vertices[index].position;
+            boundsMin = { std::min(boundsMin.x, p.x), std::min(boundsMin.y, p.y), std::min(boundsMin.z, p.z) };
+            boundsMax = { std::max(boundsMax.x, p.x), std::max(boundsMax.y, p.y), std::max(boundsMax.z, p.z) };
+        }
+        float maxDistance = maxError * Length(boundsMax - boundsMin);
+
+        // Every level starts from the full mesh, so its error is measured against the real surface
+        for (uint32_t level = 1; level < maxLodCount; ++level)
+        {
+            uint32_t previousCount = lods.back().indexCount;
+            size_t targetCount = static_cast<size_t>(previousCount / 3 * reduction) * 3;
+
+            float error = 0.0f;
+            std::vector<uint32_t> simplified = MeshSimplifier::Simplify(
+                vertices, std::span(indices.data(), sourceCount), targetCount, maxDistance, error);
+
+            if (simplified.empty() || simplified.size() > previousCount * (1.0f - MIN_LOD_REDUCTION))
+            {
+                break;
+            }
+
+            MeshCooker::OptimizeVertexCache(simplified, vertices.size());
+
+            lods.push_back({ static_cast<uint32_t>(indices.size()),
+                             static_cast<uint32_t>(simplified.size()),
+                             std::max(error, lods.back().error) });
+            indices.insert(indices.end(), simplified.begin(), simplified.end());
+        }
+
+        return lods;
+    }
+} // namespace Frost
@@ -0,0 +1,36 @@
+#pragma once
+
+#include "Frost/Core/Core.h"
+#include "Frost/Renderer/Mesh.h"
+#include "Frost/Renderer/Vertex.h"
+
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace Frost
+{
+    // Quadric error edge collapse. A vertex only ever collapses onto one of its neighbours, so the simplified
+    // triangles reuse the input vertices and every level of detail shares the vertex buffer. Vertices on attribute
+    // seams and non-manifold edges stay where they are, vertices on open borders only slide along the border.
+    class FROST_API MeshSimplifier
+    {
+    public:
+        // Stops at targetIndexCount, or before a collapse would move the surface by more than maxError, in the units
+        // of the positions. error receives the largest distance reached.
+        static std::vector<uint32_t> Simplify(std::span<const Vertex> vertices,
+                                              std::span<const uint32_t> indices,
+                                              size_t targetIndexCount,
+                                              float maxError,
+                                              float& error);
+
+        // Appends the levels after the first to indices and returns their ranges, the first one being the input.
+        // Each level aims at reduction times the triangles of the previous one, the chain ends at maxLodCount
+        // levels, at maxError times the mesh diagonal, or when a level would barely be smaller than the last.
+        static std::vector<MeshLod> GenerateLods(std::span<const Vertex> vertices,
+                                                 std::vector<uint32_t>& indices,
+                                                 uint32_t maxLodCount,
+                                                 float reduction,
+                                                 float maxError);
+    };
+} // namespace Frost
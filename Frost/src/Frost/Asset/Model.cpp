@@ -1,9 +1,12 @@
 ﻿#include "Frost/Asset/Model.h"
 #include "Frost/Asset/AssetManager.h"
+#include "Frost/Asset/MeshCooker.h"
+#include "Frost/Asset/MeshSimplifier.h"
 #include "Frost/Debugging/Assert.h"
 #include "Frost/Debugging/Logger.h"
 #include "Frost/Renderer/DX11/TextureDX11.h"
 #include "Frost/Renderer/RendererAPI.h"
+#include "Frost/Renderer/TextureStreaming.h"
 #include "Frost/Renderer/Vertex.h"
 #include "Frost/Utils/File/MemoryMappedFile.h"
 
@@ -30,7 +33,7 @@ namespace Frost
         _filepath = filepath;
         _directory = std::filesystem::path(filepath).parent_path().string();
 
-        FT_ENGINE_INFO("Async Loading model: {}", filepath);
+        FT_ENGINE_TRACE("Async Loading model: {}", filepath);
 
         Assimp::Importer importer;
         unsigned int flags = aiProcess_Triangulate | aiProcess_GenSmoothNormals | aiProcess_FlipUVs |
@@ -51,7 +54,7 @@ namespace Frost
         LoadMaterials(scene);
         ProcessNode(scene->mRootNode, scene);
 
-        FT_ENGINE_INFO("Model loaded successfully: {} meshes, {} materials", _meshes.size(), _materials.size());
+        FT_ENGINE_INFO("Model loaded successfully: {} meshes, {} materials", _cpuMeshes.size(), _materials.size());
     }
 
     void Model::UploadGPU()
@@ -64,14 +67,25 @@ namespace Frost
         _meshes.reserve(_cpuMeshes.size());
         for (auto& cpuMesh : _cpuMeshes)
         {
-            auto vertexData = std::as_bytes(std::span(cpuMesh.vertices));
-            _meshes.emplace_back(vertexData, static_cast<uint32_t>(sizeof(Vertex)), cpuMesh.indices);
+            _meshes.emplace_back(cpuMesh.vertexData,
+                                 cpuMesh.vertexStride,
+                                 cpuMesh.indices,
+                                 cpuMesh.vertexLayout,
+                                 _cookSettings.shortIndices,
+                                 cpuMesh.lods);
             _meshes.back().SetMaterialIndex(cpuMesh.materialIndex);
+            _meshes.back().SetUVDensity(cpuMesh.uvDensity);
+            if (!_cookSettings.keepPickingGeometry)
+            {
+                _meshes.back().ReleaseCpuGeometry();
+            }
         }
 
         _cpuMeshes.clear();
+        _cpuMeshes.shrink_to_fit();
+        UpdateLodErrors();
 
-        FT_ENGINE_INFO("Model uploaded to GPU: {}", _filepath);
+        FT_ENGINE_TRACE("Model uploaded to GPU: {}", _filepath);
         SetStatus(AssetStatus::Loaded);
     }
 
@@ -130,9 +144,42 @@ namespace Frost
             }
         }
 
-        auto vertexData = std::as_bytes(std::span(vertices));
+        if (vertices.empty() || indices.empty())
+        {
+            return;
+        }
+
+        // Cooked here, on the loader thread, rather than with aiProcess_JoinIdenticalVertices and
+        // aiProcess_ImproveCacheLocality, which leave the overdraw and fetch orders alone
+        if (_cookSettings.optimizeMeshes)
+        {
+            MeshCooker::Optimize(vertices, indices);
+        }
+
+        CpuMeshData cpuMesh;
+        cpuMesh.uvDensity = TextureStreaming::ComputeUVDensity(vertices, indices);
+        cpuMesh.lods = MeshSimplifier::GenerateLods(
+            vertices, indices, _cookSettings.lodCount, _cookSettings.lodReduction, _cookSettings.lodMaxError);
+        cpuMesh.indices = std::move(indices);
+        cpuMesh.materialIndex = aMesh->mMaterialIndex;
+
+        if (_cookSettings.compactVertices && MeshCooker::CanCompress(vertices))
+        {
+            std::vector<CompactVertex> compactVertices = MeshCooker::Compress(vertices);
+            auto vertexData = std::as_bytes(std::span(compactVertices));
+            cpuMesh.vertexData.assign(vertexData.begin(), vertexData.end());
+            cpuMesh.vertexStride = sizeof(CompactVertex);
+            cpuMesh.vertexLayout = VertexLayout::Compact;
+        }
+        else
+        {
+            auto vertexData = std::as_bytes(std::span(vertices));
+            cpuMesh.vertexData.assign(vertexData.begin(), vertexData.end());
+            cpuMesh.vertexStride = sizeof(Vertex);
+            cpuMesh.vertexLayout = VertexLayout::Standard;
+        }
 
-        _cpuMeshes.emplace_back(std::move(vertices), std::move(indices), aMesh->mMaterialIndex);
+        _cpuMeshes.push_back(std::move(cpuMesh));
     }
 
     void Model::LoadMaterials(const aiScene* scene)
@@ -294,6 +341,7 @@ namespace Frost
                     std::filesystem::path(_directory) / std::filesystem::path(textureIdentifier);
                 assetId = texturePath.string();
                 config.path = assetId;
+                config.streamMips = _cookSettings.streamTextures;
             }
 
             outTextures.push_back(AssetManager::LoadAsset(assetId, config));
@@ -317,4 +365,83 @@ namespace Frost
 
         return totalBounds;
     }
+
+    void Model::SetMeshes(std::vector<Mesh>&& meshes)
+    {
+        std::scoped_lock lock(_triangleBVHMutex);
+        _meshes = std::move(meshes);
+        _triangleBVHs.clear();
+        UpdateLodErrors();
+    }
+
+    void Model::UpdateLodErrors()
+    {
+        uint32_t lodCount = 1;
+        for (const Mesh& mesh : _meshes)
+        {
+            lodCount = std::max(lodCount, mesh.GetLodCount());
+        }
+
+        BoundingBox bounds = GetBoundingBox();
+        float diagonal = Math::Length(Math::Vector3{ bounds.max.x - bounds.min.x,
+                                                     bounds.max.y - bounds.min.y,
+                                                     bounds.max.z - bounds.min.z });
+
+        _lodErrors.assign(lodCount, 0.0f);
+        for (uint32_t lod = 1; lod < lodCount && diagonal > 0.0f; ++lod)
+        {
+            for (const Mesh& mesh : _meshes)
+            {
+                _lodErrors[lod] = std::max(_lodErrors[lod], mesh.GetLod(lod).error / diagonal);
+            }
+        }
+    }
+
+    AssetMemory Model::GetMemoryUsage() const
+    {
+        std::scoped_lock lock(_triangleBVHMutex);
+
+        AssetMemory memory;
+        for (const Mesh& mesh : _meshes)
+        {
+            AssetMemory meshMemory = mesh.GetMemoryUsage();
+            memory.cpuBytes += meshMemory.cpuBytes;
+            memory.gpuBytes += meshMemory.gpuBytes;
+        }
+
+        for (const CpuMeshData& cpuMesh : _cpuMeshes)
+        {
+            memory.cpuBytes += cpuMesh.vertexData.capacity() + cpuMesh.indices.capacity() * sizeof(uint32_t);
+        }
+
+        for (const std::unique_ptr<Math::TriangleBVH>& bvh : _triangleBVHs)
+        {
+            memory.cpuBytes += bvh ? bvh->GetMemorySize() : 0;
+        }
+
+        return memory;
+    }
+
+    const Math::TriangleBVH* Model::GetTriangleBVH(size_t meshIndex) const
+    {
+        std::scoped_lock lock(_triangleBVHMutex);
+        if (meshIndex >= _meshes.size())
+        {
+            return nullptr;
+        }
+
+        if (_triangleBVHs.size() < _meshes.size())
+        {
+            _triangleBVHs.resize(_meshes.size());
+        }
+
+        std::unique_ptr<Math::TriangleBVH>& bvh = _triangleBVHs[meshIndex];
+        if (!bvh)
+        {
+            const Mesh& mesh = _meshes[meshIndex];
+            bvh = std::make_unique<Math::TriangleBVH>(mesh.GetPositions(), mesh.GetIndices());
+        }
+
+        return bvh.get();
+    }
 } // namespace Frost
\ No newline at end of file
@@ -4,10 +4,13 @@
 #include "Frost/Core/Core.h"
 #include "Frost/Renderer/Material.h"
 #include "Frost/Renderer/Mesh.h"
+#include "Frost/Utils/Math/TriangleBVH.h"
 
 #include <string>
 #include <vector>
 #include <atomic>
+#include <memory>
+#include <mutex>
 
 struct aiNode;
 struct aiScene;
@@ -19,6 +22,27 @@ namespace Frost
 {
     class Renderer;
 
+    // How the imported meshes are cooked before upload, read by the loader threads so set before loading
+    struct ModelCookSettings
+    {
+        // Welds the vertices and reorders the triangles and vertices, see MeshCooker
+        bool optimizeMeshes = true;
+        // CompactVertex for the meshes whose texture coordinates fit in half precision
+        bool compactVertices = true;
+        // 16-bit indices for the meshes of at most 65536 vertices
+        bool shortIndices = true;
+        // Levels of detail per mesh, the full detail one included, see MeshSimplifier
+        uint32_t lodCount = 4;
+        // Fraction of the triangles of the previous level each level aims at
+        float lodReduction = 0.5f;
+        // Largest simplification error, as a fraction of the mesh diagonal
+        float lodMaxError = 0.02f;
+        // Keeps the full detail positions and indices on the CPU after upload, GetTriangleBVH needs them for picking
+        bool keepPickingGeometry = false;
+        // The material textures read from files stream their mips, see TextureStreamer
+        bool streamTextures = true;
+    };
+
     class FROST_API Model : public Asset
     {
     public:
@@ -36,16 +60,31 @@ namespace Frost
 
         void AddMesh(Mesh&& mesh) { _meshes.emplace_back(std::move(mesh)); }
         void AddMaterial(Material&& mat) { _materials.emplace_back(std::move(mat)); }
-        void SetMeshes(std::vector<Mesh>&& meshes) { _meshes = std::move(meshes); }
+        void SetMeshes(std::vector<Mesh>&& meshes);
 
         bool HasMaterials() const { return IsLoaded() && !_materials.empty(); }
         bool HasMeshes() const { return IsLoaded() && !_meshes.empty(); }
         BoundingBox GetBoundingBox() const;
 
+        // Levels of detail of the meshes, a mesh with fewer levels draws its last one
+        uint32_t GetLodCount() const { return static_cast<uint32_t>(_lodErrors.size()); }
+        // Largest error of the meshes at that level, as a fraction of the diagonal of the model bounds
+        float GetLodError(uint32_t lod) const { return lod < _lodErrors.size() ? _lodErrors[lod] : 0.0f; }
+
+        // Built on first use and kept with the model, nullptr for an index out of range
+        const Math::TriangleBVH* GetTriangleBVH(size_t meshIndex) const;
+
+        virtual AssetCategory GetCategory() const override { return AssetCategory::Model; }
+        virtual AssetMemory GetMemoryUsage() const override;
+
+        static void SetCookSettings(const ModelCookSettings& settings) { _cookSettings = settings; }
+        static const ModelCookSettings& GetCookSettings() { return _cookSettings; }
+
     private:
         void ProcessNode(aiNode* aNode, const aiScene* aScene);
         void ProcessMesh(aiMesh* aMesh, const aiScene* aScene);
         void LoadMaterials(const aiScene* aScene);
+        void UpdateLodErrors();
         void LoadMaterialProperties(const aiMaterial* ai_material, Material& material);
         void LoadMaterialTextures(const aiScene* scene,
                                   const aiMaterial* ai_material,
@@ -55,9 +94,13 @@ namespace Frost
     protected:
         struct CpuMeshData
         {
-            std::vector<Vertex> vertices;
+            std::vector<std::byte> vertexData;
+            uint32_t vertexStride;
+            VertexLayout vertexLayout;
             std::vector<uint32_t> indices;
+            std::vector<MeshLod> lods;
             uint32_t materialIndex;
+            float uvDensity;
         };
 
         std::string _filepath;
@@ -65,5 +108,11 @@ namespace Frost
         std::vector<Mesh> _meshes;
         std::vector<Material> _materials;
         std::vector<CpuMeshData> _cpuMeshes;
+        std::vector<float> _lodErrors = { 0.0f };
+
+        mutable std::mutex _triangleBVHMutex;
+        mutable std::vector<std::unique_ptr<Math::TriangleBVH>> _triangleBVHs;
+
+        static inline ModelCookSettings _cookSettings;
     };
 } // namespace Frost
\ No newline at end of file
@@ -68,6 +68,8 @@ namespace Frost
         texConfig.loadImmediately = true;
         texConfig.path = config.texturePath.generic_string();
         texConfig.textureType = TextureType::HEIGHTMAP;
+        // The pixels are read back from the GPU once and kept with the texture for the next GetData calls
+        texConfig.keepReadback = true;
         auto texture = Texture::Create(texConfig);
 
         std::vector<uint8_t> emptyData;
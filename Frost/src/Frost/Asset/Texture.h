@@ -11,6 +11,7 @@
 #include <string>
 #include <vector>
 #include <memory>
+#include <span>
 
 struct aiTexture;
 
@@ -87,6 +88,13 @@ namespace Frost
         std::array<std::string, 6> faceFilePaths;
         bool isUnfoldedCubemap = false;
         bool loadImmediately = true;
+        // GetData keeps what it reads back and returns it on the next calls, for textures read more than once
+        bool keepReadback = false;
+        // CPU readable copy destination, see TryReadPixels. Never bound nor rendered to.
+        bool isReadback = false;
+        // Uploads the mips up to TextureStreamingSettings::residentSize only, the TextureStreamer loads the finer ones
+        // when a view needs them. Only 2D textures of 8-bit channels read from a file stream.
+        bool streamMips = false;
     };
 
     class FROST_API Texture : public Asset, GPUResource
@@ -112,14 +120,41 @@ namespace Frost
         const uint32_t GetWidth() const { return _config.width; }
 
         virtual const std::vector<uint8_t> GetData() const = 0;
+        // Reads an isReadback texture without waiting for the GPU, false while the copy into it is still running.
+        // Rows are tightly packed.
+        virtual bool TryReadPixels(std::vector<uint8_t>& outPixels) const = 0;
         virtual void Bind(Slot slot) const = 0;
 
+        // A streamed texture replaces its view when its mips change, so the view is fetched when drawing and never
+        // kept across frames
         virtual void* GetRendererID() const = 0;
 
         virtual bool SaveToFile(const std::string& path) const = 0;
 
+        virtual AssetCategory GetCategory() const override { return AssetCategory::Texture; }
+
+        // Mip streaming, see TextureStreamer. Mips are counted from the full size one, whose size GetWidth and
+        // GetHeight return.
+        bool IsStreamable() const { return _config.streamMips; }
+        // Finest mip on the GPU
+        uint32_t GetTopMip() const { return _topMip; }
+        // Coarsest mip a streamed texture keeps, uploaded when it loads
+        uint32_t GetResidentMip() const { return _residentMip; }
+        // Returns that mip, empty on failure. The file is decoded on the first call only, the decoded image is kept
+        // for the next ones until ReleaseDecodedImage. Safe on a worker thread.
+        virtual std::vector<uint8_t> LoadMipCPU(uint32_t mip) const = 0;
+        // CPU bytes of the image kept by LoadMipCPU
+        virtual size_t GetDecodedImageSize() const = 0;
+        virtual void ReleaseDecodedImage() = 0;
+        // Replace the GPU chain, and the view GetRendererID returns, by the one starting with these pixels of that mip
+        virtual void UploadMipGPU(uint32_t mip, std::span<const uint8_t> pixels) = 0;
+        // or by the one from a coarser mip, copied from the mips already there
+        virtual void DropToMip(uint32_t mip) = 0;
+
     protected:
         TextureConfig _config;
+        uint32_t _topMip = 0;
+        uint32_t _residentMip = 0;
         mutable std::vector<uint8_t> _dataCache;
         mutable bool _dataCached = false;
     };
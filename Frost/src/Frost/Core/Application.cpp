@@ -4,7 +4,9 @@
 #include "Frost/Event/EventManager.h"
 #include "Frost/Renderer/DX11/RendererDX11.h"
 #include "Frost/Renderer/RendererAPI.h"
+#include "Frost/Renderer/TextureStreamer.h"
 #include "Frost/Debugging/Assert.h"
+#include "Frost/Debugging/Logger.h"
 #include "Frost/Event/Event.h"
 #include "Frost/Asset/AssetManager.h"
 #include "Frost/Physics/Physics.h"
@@ -46,6 +48,8 @@ namespace Frost
 
         // Register engine component serializers
         EngineComponentSerializer::RegisterEngineComponents();
+
+        AssetManager::SetDefaultBudgets();
     }
 
     void Application::Setup()
@@ -63,6 +67,7 @@ namespace Frost
         _layerStack.Clear();
 
         // Clean up assets
+        TextureStreamer::Shutdown();
         AssetManager::Shutdown();
 
         // Clean up physics
@@ -71,6 +76,9 @@ namespace Frost
         // Clean up renderer
         RendererAPI::SetRenderer(nullptr);
         _renderer.reset();
+
+        // Write what is still queued before the process exits
+        Logger::Shutdown();
     }
 
     void Application::PopLayer(Layer* layer)
@@ -125,11 +133,12 @@ namespace Frost
                 _physicsTimer.Start();
                 _window->MainLoop();
 
+                float fixedDeltaTime =
+                    std::chrono::duration<float, std::chrono::seconds::period>(_physicsDuration).count();
+                Input::OnFixedTick(fixedDeltaTime);
+
                 for (const auto& layer : _layerStack)
                 {
-                    float fixedDeltaTime =
-                        std::chrono::duration<float, std::chrono::seconds::period>(_physicsDuration).count();
-
                     if (!layer->isPaused())
                     {
                         layer->OnPreFixedUpdate(fixedDeltaTime);
@@ -143,6 +152,7 @@ namespace Frost
             {
                 _renderTimer.Start();
                 AssetManager::Update();
+                TextureStreamer::Update();
                 RendererAPI::BeginFrame();
 
                 for (const auto& layer : _layerStack)
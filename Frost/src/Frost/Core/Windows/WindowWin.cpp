@@ -219,12 +219,18 @@ namespace Frost
         {
             case WM_KEYDOWN:
             {
+                if (Input::IsReplaying())
+                    break;
+
                 KeyState keyState = (lParam & (1 << 30)) ? KeyState::REPEATED : KeyState::DOWN;
                 Input::GetKeyboard().SetKeyState(static_cast<VirtualKeyCode>(wParam), keyState);
                 break;
             }
             case WM_KEYUP:
             {
+                if (Input::IsReplaying())
+                    break;
+
                 Input::GetKeyboard().SetKeyState(static_cast<VirtualKeyCode>(wParam), KeyState::UP);
                 break;
             }
@@ -261,12 +267,18 @@ namespace Frost
             }
             case WM_MOUSEWHEEL:
             {
+                if (Input::IsReplaying())
+                    break;
+
                 int16_t delta = GET_WHEEL_DELTA_WPARAM(wParam);
                 Input::GetMouse().SetScroll(Mouse::MouseScroll{ Input::GetMouse().GetScroll().scrollX, delta });
                 break;
             }
             case WM_MOUSEHWHEEL:
             {
+                if (Input::IsReplaying())
+                    break;
+
                 int16_t delta = GET_WHEEL_DELTA_WPARAM(wParam);
                 Input::GetMouse().SetScroll(Mouse::MouseScroll{ delta, Input::GetMouse().GetScroll().scrollY });
                 break;
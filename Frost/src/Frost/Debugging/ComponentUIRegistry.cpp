@@ -5,13 +5,16 @@
 #include "Frost/Scene/Components/Meta.h"
 #include "Frost/Scene/Components/Transform.h"
 #include "Frost/Scene/Components/Camera.h"
+#include "Frost/Scene/Components/EnvironmentMap.h"
 #include "Frost/Scene/Components/StaticMesh.h"
 #include "Frost/Scene/Components/Light.h"
+#include "Frost/Scene/Components/Occluder.h"
 #include "Frost/Scene/Components/RigidBody.h"
 #include "Frost/Scene/Components/Scriptable.h"
 #include "Frost/Scene/Components/Prefab.h"
 #include "Frost/Scene/Components/Skybox.h"
 #include "Frost/Scene/Components/UIElement.h"
+#include "Frost/Scene/Components/WorldCell.h"
 #include "Frost/Scene/PrefabSerializer.h"
 #include "Frost/Scene/Components/Disabled.h"
 #include "Frost/Scene/Systems/PhysicSystem.h"
@@ -41,10 +44,53 @@ namespace Frost
             return;
         }
 
+        // One undo entry per edit: it is opened when a field widget is activated and committed once the widget is
+        // released. A widget held over several frames stays a single entry.
+        SceneHistory& history = scene->GetHistory();
+        const uint64_t mergeKey = static_cast<uint64_t>(entt::to_integral(e)) + 1;
+
+        // Sliders and keyboard activation edit on the frame they activate, so a click or a key press over the
+        // inspector records the entity before the drawers run. The transaction is empty and dropped otherwise.
+        const bool mayEditNow =
+            (ImGui::IsWindowHovered(ImGuiHoveredFlags_ChildWindows) && ImGui::IsMouseClicked(ImGuiMouseButton_Left)) ||
+            (ImGui::IsWindowFocused(ImGuiFocusedFlags_ChildWindows) &&
+             (ImGui::IsKeyPressed(ImGuiKey_Space, false) || ImGui::IsKeyPressed(ImGuiKey_Enter, false)));
+        if (mayEditNow)
+        {
+            history.BeginTransaction("Edit Components", mergeKey);
+            history.Record(GameObject(e, scene));
+        }
+
+        // The group reports the activation and release of any widget drawn inside it
+        ImGui::BeginGroup();
         for (const auto& [typeIndex, drawer] : _drawers)
         {
             drawer(scene, e, ctx);
         }
+        ImGui::EndGroup();
+
+        if (mayEditNow)
+        {
+            history.EndTransaction(ImGui::IsItemActive());
+        }
+        else if (ImGui::IsItemActivated())
+        {
+            history.BeginTransaction("Edit Components", mergeKey);
+            history.Record(GameObject(e, scene));
+            history.EndTransaction(ImGui::IsItemActive());
+        }
+        else if (ImGui::IsItemDeactivated())
+        {
+            // Resumes the open entry and commits it, a widget released without an edit leaves no entry
+            history.BeginTransaction("Edit Components", mergeKey);
+            history.EndTransaction();
+        }
+
+        // Drawers edit components in place, so the change tracker is told directly
+        if (ImGui::IsItemEdited() || ImGui::IsItemDeactivatedAfterEdit())
+        {
+            scene->GetChangeTracker().MarkDirty(e);
+        }
     }
 
     void ComponentUIRegistry::DrawByType(std::type_index type, Scene* scene, entt::entity e, const UIContext& ctx)
@@ -95,7 +141,9 @@ namespace Frost
                         strncpy_s(nameBuffer, meta.name.c_str(), sizeof(nameBuffer) - 1);
                         if (ImGui::InputText("Name", nameBuffer, sizeof(nameBuffer)))
                         {
+                            // Patched so that the hierarchy panels and the change tracker see the new name
                             meta.name = std::string(nameBuffer);
+                            scene->GetRegistry().patch<Meta>(e);
                         }
                     }
                     else
@@ -628,68 +676,8 @@ namespace Frost
                         modified = true;
                     }
 
-                    modified |= std::visit(
-                        [](auto&& arg)
-                        {
-                            bool shapeModified = false;
-                            using T = std::decay_t<decltype(arg)>;
-                            if constexpr (std::is_same_v<T, ShapeBox>)
-                            {
-                                shapeModified |= DebugUtils::DrawVec3Control("Half Extent", arg.halfExtent, 0.0f, 0.1f);
-                                shapeModified |=
-                                    ImGui::DragFloat("Convex Radius", &arg.convexRadius, 0.005f, 0.0f, 1.0f);
-                            }
-                            else if constexpr (std::is_same_v<T, ShapeSphere>)
-                            {
-                                shapeModified |= ImGui::DragFloat("Radius", &arg.radius, 0.05f, 0.01f, 1000.0f);
-                            }
-                            else if constexpr (std::is_same_v<T, ShapeCapsule>)
-                            {
-                                shapeModified |= ImGui::DragFloat("Half Height", &arg.halfHeight, 0.05f, 0.0f, 1000.0f);
-                                shapeModified |= ImGui::DragFloat("Radius", &arg.radius, 0.05f, 0.01f, 1000.0f);
-                            }
-                            else if constexpr (std::is_same_v<T, ShapeCylinder>)
-                            {
-                                shapeModified |= ImGui::DragFloat("Half Height", &arg.halfHeight, 0.05f, 0.0f, 1000.0f);
-                                shapeModified |= ImGui::DragFloat("Radius", &arg.radius, 0.05f, 0.01f, 1000.0f);
-                                shapeModified |=
-                                    ImGui::DragFloat("Convex Radius", &arg.convexRadius, 0.005f, 0.0f, 1.0f);
-                            }
-                            else if constexpr (std::is_same_v<T, ShapeMesh>)
-                            {
-                                char buffer[256];
-                                memset(buffer, 0, sizeof(buffer));
-                                strncpy_s(buffer, sizeof(buffer), arg.path.c_str(), _TRUNCATE);
-
-                                if (ImGui::InputText("Mesh Path", buffer, sizeof(buffer)))
-                                {
-                                    arg.path = std::string(buffer);
-                                    shapeModified = true;
-                                }
-
-                                if (ImGui::BeginDragDropTarget())
-                                {
-                                    if (const ImGuiPayload* payload =
-                                            ImGui::AcceptDragDropPayload("CONTENT_BROWSER_ITEM"))
-                                    {
-                                        const wchar_t* path = (const wchar_t*)payload->Data;
-                                        std::filesystem::path filePath(path);
-
-                                        std::string ext = filePath.extension().string();
-                                        if (std::find(MESH_FILE_EXTENSIONS.begin(), MESH_FILE_EXTENSIONS.end(), ext) !=
-                                            MESH_FILE_EXTENSIONS.end())
-                                        {
-                                            arg.path = filePath.string();
-                                            shapeModified = true;
-                                        }
-                                    }
-                                    ImGui::EndDragDropTarget();
-                                }
-                            }
-
-                            return shapeModified;
-                        },
-                        rb.shape);
+                    modified |=
+                        std::visit([](auto& shape) { return DebugUtils::DrawReflectedFields(shape); }, rb.shape);
 
                     ImGui::Separator();
                     ImGui::Text("Material Properties");
@@ -953,158 +941,13 @@ namespace Frost
             });
 
         // Skybox
-        Register<Skybox>(
-            [](Scene* scene, entt::entity e, const UIContext& ctx)
-            {
-                if (!scene->GetRegistry().all_of<Skybox>(e))
-                    return;
-
-                auto& skybox = scene->GetRegistry().get<Skybox>(e);
-                bool removed = false;
-
-                if (DebugUtils::DrawComponentHeader("Skybox", &removed))
-                {
-                    if (removed)
-                    {
-                        scene->GetRegistry().remove<Skybox>(e);
-                        ImGui::TreePop();
-                        return;
-                    }
-
-                    const char* skyboxTypes[] = { "Cubemap", "6 Files" };
-                    int currentType = (int)skybox.GetType();
-
-                    if (ImGui::Combo("Source Type", &currentType, skyboxTypes, IM_ARRAYSIZE(skyboxTypes)))
-                    {
-                        skybox.SetType(static_cast<SkyboxType>(currentType));
-                    }
-
-                    ImGui::DragFloat("Intensity", &skybox.intensity, 0.05f, 0.0f, 100.0f);
-
-                    ImGui::Separator();
-
-                    auto DrawPathInput = [&](const char* label, std::filesystem::path& path) -> bool
-                    {
-                        bool changed = false;
-                        char buffer[256];
-                        memset(buffer, 0, sizeof(buffer));
-                        strncpy_s(buffer, path.string().c_str(), sizeof(buffer));
-
-                        ImGui::InputText(label, buffer, sizeof(buffer), ImGuiInputTextFlags_ReadOnly);
+        RegisterReflected<Skybox>("Skybox");
 
-                        if (ImGui::BeginDragDropTarget())
-                        {
-                            if (const ImGuiPayload* payload = ImGui::AcceptDragDropPayload("CONTENT_BROWSER_ITEM"))
-                            {
-                                const wchar_t* payload_path = (const wchar_t*)payload->Data;
-                                std::filesystem::path filePath(payload_path);
-                                std::string ext = filePath.extension().string();
-
-                                if (std::find(IMAGE_FILE_EXTENSIONS.begin(), IMAGE_FILE_EXTENSIONS.end(), ext) !=
-                                    IMAGE_FILE_EXTENSIONS.end())
-                                {
-                                    path = filePath;
-                                    changed = true;
-                                }
-                            }
-                            ImGui::EndDragDropTarget();
-                        }
-                        return changed;
-                    };
-
-                    if (auto* p = std::get_if<SkyboxSourceCubemap>(&skybox.config))
-                    {
-                        DrawPathInput("Cubemap Path", p->filepath);
-                    }
-                    else if (auto* p = std::get_if<SkyboxSource6Files>(&skybox.config))
-                    {
-                        const char* faceLabels[] = { "Right (+X)",  "Left (-X)",  "Top (+Y)",
-                                                     "Bottom (-Y)", "Front (+Z)", "Back (-Z)" };
-                        for (int i = 0; i < 6; ++i)
-                        {
-                            DrawPathInput(faceLabels[i], p->faceFilepaths[i]);
-                        }
-                    }
-
-                    ImGui::TreePop();
-                }
-            });
+        // EnvironmentMap
+        RegisterReflected<EnvironmentMap>("Environment Map");
 
         // Camera
-        Register<Camera>(
-            [](Scene* scene, entt::entity e, const UIContext& ctx)
-            {
-                auto& camera = scene->GetRegistry().get<Camera>(e);
-                bool removed = false;
-
-                if (DebugUtils::DrawComponentHeader("Camera", &removed))
-                {
-                    if (removed)
-                    {
-                        scene->GetRegistry().remove<Camera>(e);
-                        ImGui::TreePop();
-                        return;
-                    }
-
-                    const char* projectionTypes[] = { "Perspective", "Orthographic" };
-                    int currentType = (int)camera.projectionType;
-                    if (ImGui::Combo("Projection Type", &currentType, projectionTypes, IM_ARRAYSIZE(projectionTypes)))
-                    {
-                        camera.projectionType = (Camera::ProjectionType)currentType;
-                    }
-
-                    if (camera.projectionType == Camera::ProjectionType::Perspective)
-                    {
-                        float fovDegrees = Math::Angle<Math::Degree>(camera.perspectiveFOV).value();
-                        if (ImGui::DragFloat("FOV", &fovDegrees, 0.5f, 30.0f, 120.0f))
-                            camera.perspectiveFOV = Math::Angle<Math::Radian>(Math::Angle<Math::Degree>(fovDegrees));
-                    }
-                    else
-                    {
-                        ImGui::DragFloat("Size", &camera.orthographicSize, 0.1f, 1.0f, 1000.0f);
-                    }
-
-                    ImGui::DragFloat("Near Clip", &camera.nearClip, 0.01f);
-                    ImGui::DragFloat("Far Clip", &camera.farClip, 1.0f);
-                    ImGui::DragInt("Priority", &camera.priority);
-
-                    ImGui::Separator();
-
-                    ImGui::Checkbox("Clear On Render", &camera.clearOnRender);
-                    ImGui::ColorEdit4("Background Color", camera.backgroundColor.values);
-
-                    ImGui::Separator();
-
-                    bool isRenderTarget = camera.renderTargetConfig.has_value();
-                    if (ImGui::Checkbox("Render To Texture", &isRenderTarget))
-                    {
-                        if (isRenderTarget)
-                        {
-                            camera.renderTargetConfig.emplace();
-                        }
-                        else
-                        {
-                            camera.renderTargetConfig.reset();
-                        }
-                    }
-
-                    if (camera.renderTargetConfig)
-                    {
-                        ImGui::Indent();
-                        int size[2] = { (int)camera.renderTargetConfig->width, (int)camera.renderTargetConfig->height };
-                        if (ImGui::DragInt2("Resolution", size, 1, 16, 4096))
-                        {
-                            camera.renderTargetConfig->width = size[0];
-                            camera.renderTargetConfig->height = size[1];
-                        }
-                        ImGui::Checkbox("Use Screen Space Aspect Ratio",
-                                        &camera.renderTargetConfig->useScreenSpaceAspectRatio);
-                        ImGui::Unindent();
-                    }
-
-                    ImGui::TreePop();
-                }
-            });
+        RegisterReflected<Camera>("Camera");
 
         // UIElement
         Register<UIElement>(
@@ -1245,5 +1088,11 @@ namespace Frost
                     ImGui::TreePop();
                 }
             });
+
+        // WorldCell
+        RegisterReflected<WorldCell>("World Cell");
+
+        // Occluder
+        RegisterReflected<Occluder>("Occluder");
     }
 } // namespace Frost
\ No newline at end of file
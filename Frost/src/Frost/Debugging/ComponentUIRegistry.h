@@ -1,6 +1,8 @@
 #pragma once
 
 #include "Frost/Core/Core.h"
+#include "Frost/Debugging/DebugInterface/DebugUtils.h"
+#include "Frost/Scene/ECS/ComponentFields.h"
 #include "Frost/Scene/Scene.h"
 
 #include <entt/entt.hpp>
@@ -34,6 +36,30 @@ namespace Frost
                            });
         }
 
+        // Header and one control per field, generated from the component's Reflection::Fields
+        template<Reflection::Reflected T>
+        static void RegisterReflected(const char* name)
+        {
+            Register<T>(
+                [name](Scene* scene, entt::entity e, const UIContext& ctx)
+                {
+                    bool removed = false;
+                    if (!DebugUtils::DrawComponentHeader(name, &removed))
+                        return;
+
+                    if (removed)
+                    {
+                        scene->GetRegistry().remove<T>(e);
+                    }
+                    else
+                    {
+                        DebugUtils::DrawReflectedFields(scene->GetRegistry().get<T>(e));
+                    }
+
+                    DebugUtils::EndComponentHeader();
+                });
+        }
+
         template<typename T>
         static void Draw(Scene* scene, entt::entity e, const UIContext& ctx)
         {
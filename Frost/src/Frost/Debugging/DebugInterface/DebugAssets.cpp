@@ -0,0 +1,144 @@
+#include "Frost/Debugging/DebugInterface/DebugAssets.h"
+#include "Frost/Asset/AssetManager.h"
+
+#include <imgui.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <string>
+
+namespace Frost
+{
+    namespace
+    {
+        const char* CATEGORY_NAMES[] = { "Textures", "Models", "Fonts", "Other" };
+
+        std::string FormatBytes(size_t bytes)
+        {
+            char buffer[32];
+            if (bytes >= 1024 * 1024)
+                std::snprintf(buffer, sizeof(buffer), "%.1f MB", bytes / (1024.0 * 1024.0));
+            else
+                std::snprintf(buffer, sizeof(buffer), "%.1f KB", bytes / 1024.0);
+            return buffer;
+        }
+
+        std::string FormatBudget(size_t bytes)
+        {
+            return bytes ? FormatBytes(bytes) : "-";
+        }
+    } // namespace
+
+    void DebugAssets::OnImGuiRender(float deltaTime)
+    {
+        if (!ImGui::CollapsingHeader("Assets"))
+        {
+            return;
+        }
+
+        AssetMemoryReport report = AssetManager::GetMemoryReport();
+
+        if (ImGui::BeginTable("AssetCategories", 5, ImGuiTableFlags_Borders | ImGuiTableFlags_SizingStretchSame))
+        {
+            ImGui::TableSetupColumn("Category");
+            ImGui::TableSetupColumn("CPU");
+            ImGui::TableSetupColumn("CPU Budget");
+            ImGui::TableSetupColumn("GPU");
+            ImGui::TableSetupColumn("GPU Budget");
+            ImGui::TableHeadersRow();
+
+            for (size_t i = 0; i < report.categories.size(); ++i)
+            {
+                const AssetMemory& memory = report.categories[i];
+                const AssetBudget& budget = report.budgets[i];
+                bool overBudget = (budget.cpuBytes && memory.cpuBytes > budget.cpuBytes) ||
+                                  (budget.gpuBytes && memory.gpuBytes > budget.gpuBytes);
+
+                ImGui::TableNextRow();
+                ImGui::TableNextColumn();
+                if (overBudget)
+                    ImGui::TextColored(ImVec4(1.0f, 0.4f, 0.4f, 1.0f), "%s", CATEGORY_NAMES[i]);
+                else
+                    ImGui::TextUnformatted(CATEGORY_NAMES[i]);
+                ImGui::TableNextColumn();
+                ImGui::TextUnformatted(FormatBytes(memory.cpuBytes).c_str());
+                ImGui::TableNextColumn();
+                ImGui::TextUnformatted(FormatBudget(budget.cpuBytes).c_str());
+                ImGui::TableNextColumn();
+                ImGui::TextUnformatted(FormatBytes(memory.gpuBytes).c_str());
+                ImGui::TableNextColumn();
+                ImGui::TextUnformatted(FormatBudget(budget.gpuBytes).c_str());
+            }
+
+            ImGui::EndTable();
+        }
+
+        ImGui::Text("Assets: %zu | Evicted: %llu",
+                    report.assets.size(),
+                    static_cast<unsigned long long>(report.evictedCount));
+        ImGui::SameLine();
+        if (ImGui::Button("Prune Unused"))
+        {
+            AssetManager::PruneUnused();
+        }
+
+        // Largest first
+        std::sort(report.assets.begin(),
+                  report.assets.end(),
+                  [](const AssetMemoryReport::Entry& a, const AssetMemoryReport::Entry& b)
+                  { return a.memory.cpuBytes + a.memory.gpuBytes > b.memory.cpuBytes + b.memory.gpuBytes; });
+
+        ImGuiTableFlags flags = ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg | ImGuiTableFlags_ScrollY |
+                                ImGuiTableFlags_Resizable;
+        if (ImGui::BeginTable("AssetList", 5, flags, ImVec2(0.0f, 250.0f)))
+        {
+            ImGui::TableSetupScrollFreeze(0, 1);
+            ImGui::TableSetupColumn("Path", ImGuiTableColumnFlags_WidthStretch);
+            ImGui::TableSetupColumn("CPU", ImGuiTableColumnFlags_WidthFixed, 80.0f);
+            ImGui::TableSetupColumn("GPU", ImGuiTableColumnFlags_WidthFixed, 80.0f);
+            ImGui::TableSetupColumn("Refs", ImGuiTableColumnFlags_WidthFixed, 40.0f);
+            ImGui::TableSetupColumn("Unused For", ImGuiTableColumnFlags_WidthFixed, 80.0f);
+            ImGui::TableHeadersRow();
+
+            ImGuiListClipper clipper;
+            clipper.Begin(static_cast<int>(report.assets.size()));
+            while (clipper.Step())
+            {
+                for (int row = clipper.DisplayStart; row < clipper.DisplayEnd; ++row)
+                {
+                    const AssetMemoryReport::Entry& entry = report.assets[row];
+
+                    ImGui::TableNextRow();
+                    ImGui::TableNextColumn();
+                    ImGui::TextUnformatted(entry.path.c_str());
+                    if (ImGui::IsItemHovered())
+                        ImGui::SetTooltip("%s", CATEGORY_NAMES[static_cast<size_t>(entry.category)]);
+
+                    ImGui::TableNextColumn();
+                    if (entry.status == AssetStatus::Loaded || entry.status == AssetStatus::Failed)
+                    {
+                        ImGui::TextUnformatted(FormatBytes(entry.memory.cpuBytes).c_str());
+                        ImGui::TableNextColumn();
+                        ImGui::TextUnformatted(FormatBytes(entry.memory.gpuBytes).c_str());
+                    }
+                    else
+                    {
+                        ImGui::TextDisabled("Loading");
+                        ImGui::TableNextColumn();
+                    }
+
+                    ImGui::TableNextColumn();
+                    ImGui::Text("%ld", entry.references);
+                    ImGui::TableNextColumn();
+                    if (entry.references > 0)
+                        ImGui::TextDisabled("In use");
+                    else
+                        ImGui::Text("%llu frames",
+                                    static_cast<unsigned long long>(report.frame - entry.lastUsedFrame));
+                }
+            }
+
+            ImGui::EndTable();
+        }
+    }
+} // namespace Frost
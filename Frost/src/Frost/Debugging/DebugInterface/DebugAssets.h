@@ -0,0 +1,15 @@
+#pragma once
+
+#include "Frost/Debugging/DebugInterface/DebugPanel.h"
+
+namespace Frost
+{
+    class DebugAssets : public DebugPanel
+    {
+    public:
+        DebugAssets() = default;
+        virtual ~DebugAssets() override = default;
+        virtual void OnImGuiRender(float deltaTime) override;
+        virtual const char* GetName() const override { return "Assets"; }
+    };
+} // namespace Frost
@@ -1,5 +1,6 @@
 #include "Frost/Debugging/DebugInterface/DebugInput.h"
 #include "Frost/Input/Input.h"
+#include "Frost/Utils/Random.h"
 
 #include <imgui.h>
 #include <string>
@@ -16,6 +17,9 @@ namespace Frost
             _DrawKeyboardPanel();
             ImGui::Separator();
 
+            _DrawRecordingPanel();
+            ImGui::Separator();
+
             if (ImGui::TreeNode("Gamepads"))
             {
                 for (uint8_t i = 0; i < Gamepad::MAX_GAMEPADS; ++i)
@@ -28,6 +32,45 @@ namespace Frost
         }
     }
 
+    void DebugInput::_DrawRecordingPanel()
+    {
+        if (!ImGui::TreeNode("Recording"))
+            return;
+
+        const bool isRecording = Input::IsRecording();
+        const bool isReplaying = Input::IsReplaying();
+
+        ImGui::BeginDisabled(isRecording || isReplaying);
+        ImGui::InputText("File", _recordingPath, sizeof(_recordingPath));
+        if (ImGui::Button("Record"))
+        {
+            Input::StartRecording(_recordingPath);
+        }
+        ImGui::SameLine();
+        if (ImGui::Button("Replay"))
+        {
+            Input::StartReplay(_recordingPath);
+        }
+        ImGui::EndDisabled();
+
+        ImGui::SameLine();
+        ImGui::BeginDisabled(!isRecording && !isReplaying);
+        if (ImGui::Button("Stop"))
+        {
+            Input::StopRecording();
+        }
+        ImGui::EndDisabled();
+
+        if (isRecording)
+            ImGui::Text("Recording, seed %u", Random::GetSeed());
+        else if (isReplaying)
+            ImGui::Text("Replaying, seed %u", Random::GetSeed());
+        else
+            ImGui::TextDisabled("Idle");
+
+        ImGui::TreePop();
+    }
+
     void DebugInput::_DrawMousePanel()
     {
         bool isCursorVisible = Input::GetMouse().IsCursorVisible();
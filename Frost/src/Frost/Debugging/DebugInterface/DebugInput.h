@@ -20,5 +20,9 @@ namespace Frost
         void _DrawJoystickVisual(const char* label, const Gamepad::Joystick& joy, float radius);
         bool _DrawTransformControl(const char* label, Frost::Gamepad::Transform& currentTransform);
         void _DrawMouseVisual(const char* label, float size);
+        void _DrawRecordingPanel();
+
+    private:
+        char _recordingPath[256] = "input_recording.bin";
     };
 } // namespace Frost
\ No newline at end of file
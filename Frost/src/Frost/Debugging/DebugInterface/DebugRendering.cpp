@@ -8,6 +8,9 @@ namespace Frost
 {
     bool Debug::RendererConfig::wireframeMode = false;
     bool Debug::RendererConfig::display = true;
+    bool Debug::RendererConfig::occlusionCulling = true;
+    uint32_t Debug::RendererConfig::occluderCount = 0;
+    uint32_t Debug::RendererConfig::occludedCount = 0;
 
     void DebugRendering::OnImGuiRender(float deltaTime)
     {
@@ -16,6 +19,10 @@ namespace Frost
         {
             ImGui::Checkbox("Display", &Debug::RendererConfig::display);
             ImGui::Checkbox("Wireframe Mode", &Debug::RendererConfig::wireframeMode);
+            ImGui::Checkbox("Occlusion Culling", &Debug::RendererConfig::occlusionCulling);
+            ImGui::Text("Occluders: %u, occluded instances: %u",
+                        Debug::RendererConfig::occluderCount,
+                        Debug::RendererConfig::occludedCount);
         }
 #endif
     }
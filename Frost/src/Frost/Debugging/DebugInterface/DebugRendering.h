@@ -2,6 +2,8 @@
 
 #include "Frost/Debugging/DebugInterface/DebugPanel.h"
 
+#include <cstdint>
+
 namespace Frost
 {
     namespace Debug
@@ -10,6 +12,10 @@ namespace Frost
         {
             static bool wireframeMode;
             static bool display;
+            static bool occlusionCulling;
+            // Written by the renderer for the main cameras of the last frame
+            static uint32_t occluderCount;
+            static uint32_t occludedCount;
         };
     } // namespace Debug
 
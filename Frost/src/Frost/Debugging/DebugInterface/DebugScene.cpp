@@ -67,8 +67,14 @@ namespace Frost
             ImGui::Text("No scene attached to DebugLayer");
         }
 
+        ImGui::SetNextItemWidth(-1.0f);
+        ImGui::InputTextWithHint("##HierarchyFilter", "Search", _hierarchyFilter, sizeof(_hierarchyFilter));
+
         for (Scene* scene : _scenes)
         {
+            SceneHierarchyCache& hierarchy = scene->GetHierarchyCache();
+            hierarchy.SetFilter(_hierarchyFilter);
+
             if (ImGui::TreeNodeEx(scene->GetName().c_str(), ImGuiTreeNodeFlags_DefaultOpen))
             {
                 auto& registry = scene->GetRegistry();
@@ -84,14 +90,18 @@ namespace Frost
                     ImGui::EndDragDropTarget();
                 }
 
-                registry.view<Relationship, Meta>().each(
-                    [&](auto entity, auto& relationship, auto& meta)
+                // Only the rows on screen are submitted
+                const auto& rows = hierarchy.GetRows();
+                ImGuiListClipper clipper;
+                clipper.Begin(static_cast<int>(rows.size()));
+                while (clipper.Step())
+                {
+                    for (int i = clipper.DisplayStart; i < clipper.DisplayEnd; ++i)
                     {
-                        if (relationship.parent == entt::null)
-                        {
-                            _DrawEntityNode(scene, entity);
-                        }
-                    });
+                        _DrawEntityRow(scene, rows[i]);
+                    }
+                }
+                clipper.End();
 
                 ImGui::TreePop();
             }
@@ -278,21 +288,29 @@ namespace Frost
         }
     }
 
-    void DebugScene::_DrawEntityNode(Scene* scene, entt::entity gameObjectId)
+    void DebugScene::_DrawEntityRow(Scene* scene, const SceneHierarchyCache::Row& row)
     {
         auto& registry = scene->GetRegistry();
-        Meta* info = registry.try_get<Meta>(gameObjectId);
-        Relationship* relationship = registry.try_get<Relationship>(gameObjectId);
+        entt::entity gameObjectId = row.entity;
+        if (!registry.valid(gameObjectId))
+            return;
 
-        if (!info || !relationship)
+        Meta* info = registry.try_get<Meta>(gameObjectId);
+        if (!info)
             return;
 
-        ImGuiTreeNodeFlags node_flags = ImGuiTreeNodeFlags_OpenOnArrow | ImGuiTreeNodeFlags_SpanAvailWidth;
-        if (relationship->childrenCount == 0)
+        // Rows are flat, the tree indentation is applied by hand
+        ImGuiTreeNodeFlags node_flags = ImGuiTreeNodeFlags_OpenOnArrow | ImGuiTreeNodeFlags_SpanAvailWidth |
+                                        ImGuiTreeNodeFlags_NoTreePushOnOpen;
+        if (!row.hasChildren)
             node_flags |= ImGuiTreeNodeFlags_Leaf;
         if (_selectedEntity == gameObjectId)
             node_flags |= ImGuiTreeNodeFlags_Selected;
 
+        const float indent = row.depth * ImGui::GetStyle().IndentSpacing;
+        if (indent > 0.0f)
+            ImGui::Indent(indent);
+
         bool isEnabled = !registry.all_of<Disabled>(gameObjectId);
         ImGui::PushID((void*)(intptr_t)gameObjectId);
         if (ImGui::Checkbox("##enabled", &isEnabled))
@@ -305,7 +323,12 @@ namespace Frost
         ImGui::PopID();
 
         ImGui::SameLine();
+        ImGui::SetNextItemOpen(row.isExpanded);
         const bool is_open = ImGui::TreeNodeEx((void*)(intptr_t)gameObjectId, node_flags, "%s", info->name.c_str());
+        if (row.hasChildren && is_open != row.isExpanded)
+        {
+            scene->GetHierarchyCache().SetExpanded(gameObjectId, is_open);
+        }
 
         if (ImGui::IsItemClicked())
         {
@@ -344,21 +367,12 @@ namespace Frost
         if (ImGui::BeginDragDropSource())
         {
             ImGui::SetDragDropPayload("HIERARCHY_NODE", &gameObjectId, sizeof(entt::entity));
-            ImGui::Text("%s", scene->GetRegistry().get<Meta>(gameObjectId).name.c_str());
+            ImGui::Text("%s", info->name.c_str());
             ImGui::EndDragDropSource();
         }
 
-        if (is_open)
-        {
-            entt::entity currentChild = relationship->firstChild;
-            while (registry.valid(currentChild))
-            {
-                _DrawEntityNode(scene, currentChild);
-                Relationship* childRel = registry.try_get<Relationship>(currentChild);
-                currentChild = childRel ? childRel->nextSibling : entt::null;
-            }
-            ImGui::TreePop();
-        }
+        if (indent > 0.0f)
+            ImGui::Unindent(indent);
     }
 
     void DebugScene::_ReparentEntity(Scene* scene, entt::entity entityId, entt::entity newParentId)
@@ -405,6 +419,8 @@ namespace Frost
         {
             childRel.nextSibling = entt::null;
         }
+
+        scene->GetHierarchyCache().Invalidate();
     }
 
     void DebugScene::AddScene(Scene* scene)
@@ -486,25 +502,15 @@ namespace Frost
                                               Math::Angle<Math::Degree>(eulerAnglesRadians.Yaw).value(),
                                               Math::Angle<Math::Degree>(eulerAnglesRadians.Roll).value() };
 
+            ImGui::BeginDisabled();
+            DebugUtils::DrawReflectedFields(*worldTransform);
+            ImGui::EndDisabled();
+
             ImGui::PushStyleColor(ImGuiCol_Text, ImVec4(0.5f, 0.5f, 0.5f, 1.0f));
-            ImGui::Text("Position: (%.2f, %.2f, %.2f)",
-                        worldTransform->position.x,
-                        worldTransform->position.y,
-                        worldTransform->position.z);
-            ImGui::Text("Rotation (Quat): (%.2f, %.2f, %.2f, %.2f)",
-                        worldTransform->rotation.x,
-                        worldTransform->rotation.y,
-                        worldTransform->rotation.z,
-                        worldTransform->rotation.w);
             ImGui::Text("Rotation (Euler): (P:%.2f, Y:%.2f, R:%.2f) deg",
                         eulerAnglesDegrees.x,
                         eulerAnglesDegrees.y,
                         eulerAnglesDegrees.z);
-            ImGui::Text("Scale:    (%.2f, %.2f, %.2f)",
-                        worldTransform->scale.x,
-                        worldTransform->scale.y,
-                        worldTransform->scale.z);
-
             ImGui::PopStyleColor();
             ImGui::TreePop();
         }
@@ -31,11 +31,13 @@ namespace Frost
         Math::Vector3 _inspectorEulerCache;
         entt::entity _lastInspectedEntity{ entt::null };
 
+        char _hierarchyFilter[128] = { 0 };
+
     private:
         void _DrawHierarchyPanel();
         void _DrawInspectorPanel();
 
-        void _DrawEntityNode(Scene* scene, entt::entity gameObjectId);
+        void _DrawEntityRow(Scene* scene, const SceneHierarchyCache::Row& row);
         void _ReparentEntity(Scene* scene, entt::entity entityId, entt::entity newParentId);
 
         void _DrawMetaComponent(Scene* scene, entt::entity gameObjectId);
@@ -32,6 +32,11 @@ namespace Frost
         return open;
     }
 
+    void DebugUtils::EndComponentHeader()
+    {
+        ImGui::TreePop();
+    }
+
     bool DebugUtils::DrawVec3Control(const std::string& label,
                                      Math::Vector3& values,
                                      float resetValue,
@@ -243,4 +248,105 @@ namespace Frost
 
         return modified;
     }
+
+    bool DebugUtils::DrawField(const char* label, float& value)
+    {
+        return ImGui::DragFloat(label, &value, 0.1f);
+    }
+
+    bool DebugUtils::DrawField(const char* label, int& value)
+    {
+        return ImGui::DragInt(label, &value);
+    }
+
+    bool DebugUtils::DrawField(const char* label, uint32_t& value)
+    {
+        return ImGui::DragScalar(label, ImGuiDataType_U32, &value);
+    }
+
+    bool DebugUtils::DrawField(const char* label, bool& value)
+    {
+        return ImGui::Checkbox(label, &value);
+    }
+
+    bool DebugUtils::DrawField(const char* label, Math::Vector3& value)
+    {
+        return DrawVec3Control(label, value);
+    }
+
+    bool DebugUtils::DrawField(const char* label, Math::Vector4& value)
+    {
+        return ImGui::DragFloat4(label, value.values, 0.01f);
+    }
+
+    bool DebugUtils::DrawField(const char* label, std::string& value)
+    {
+        char buffer[256];
+        strncpy_s(buffer, value.c_str(), sizeof(buffer) - 1);
+        if (ImGui::InputText(label, buffer, sizeof(buffer)))
+        {
+            value = buffer;
+            return true;
+        }
+        return false;
+    }
+
+    bool DebugUtils::DrawField(const char* label, std::filesystem::path& value)
+    {
+        std::string path = value.string();
+        bool modified = DrawField(label, path);
+        if (modified)
+        {
+            value = path;
+        }
+
+        // Files can also be dropped from the content browser
+        if (ImGui::BeginDragDropTarget())
+        {
+            if (const ImGuiPayload* payload = ImGui::AcceptDragDropPayload("CONTENT_BROWSER_ITEM"))
+            {
+                value = std::filesystem::path(static_cast<const wchar_t*>(payload->Data));
+                modified = true;
+            }
+            ImGui::EndDragDropTarget();
+        }
+        return modified;
+    }
+
+    bool DebugUtils::DrawField(const char* label, Math::Angle<Math::Radian>& value)
+    {
+        float degrees = Angle<Degree>(value).value();
+        if (ImGui::DragFloat(label, &degrees, 0.5f, 0.0f, 0.0f, "%.1f deg"))
+        {
+            value = Angle<Radian>(Angle<Degree>(degrees));
+            return true;
+        }
+        return false;
+    }
+
+    bool DebugUtils::DrawField(const char* label, Viewport& value)
+    {
+        return ImGui::DragFloat4(label, &value.x, 0.01f, 0.0f, 1.0f);
+    }
+
+    bool DebugUtils::_DrawTypeCombo(const char* label, int& index, const char* const* names, int count)
+    {
+        return ImGui::Combo(label, &index, names, count);
+    }
+
+    void DebugUtils::_BeginNested(const char* label, bool showLabel)
+    {
+        if (showLabel)
+        {
+            ImGui::TextUnformatted(label);
+        }
+        ImGui::PushID(label);
+        ImGui::Indent();
+    }
+
+    void DebugUtils::_EndNested()
+    {
+        ImGui::Unindent();
+        ImGui::PopID();
+    }
 } // namespace Frost
@@ -1,9 +1,17 @@
 #pragma once
 
 #include "Frost/Core/Core.h"
+#include "Frost/Renderer/Viewport.h"
+#include "Frost/Scene/ECS/ComponentFields.h"
+#include "Frost/Utils/Math/Angle.h"
 #include "Frost/Utils/Math/Vector.h"
 
+#include <array>
+#include <cstdint>
+#include <filesystem>
+#include <optional>
 #include <string>
+#include <variant>
 
 namespace Frost
 {
@@ -11,6 +19,8 @@ namespace Frost
     {
     public:
         static bool DrawComponentHeader(const char* name, bool* outRemoved = nullptr);
+        // Closes a header that DrawComponentHeader opened
+        static void EndComponentHeader();
         static bool DrawVec3Control(const std::string& label,
                                     Math::Vector3& values,
                                     float resetValue = 0.0f,
@@ -19,5 +29,112 @@ namespace Frost
                                           Math::Vector4& quaternion,
                                           float resetValue = 0.0f,
                                           float columnWidth = 100.0f);
+
+        static bool DrawField(const char* label, float& value);
+        static bool DrawField(const char* label, int& value);
+        static bool DrawField(const char* label, uint32_t& value);
+        static bool DrawField(const char* label, bool& value);
+        static bool DrawField(const char* label, Math::Vector3& value);
+        static bool DrawField(const char* label, Math::Vector4& value);
+        static bool DrawField(const char* label, std::string& value);
+        static bool DrawField(const char* label, std::filesystem::path& value);
+        // Edited in degrees
+        static bool DrawField(const char* label, Math::Angle<Math::Radian>& value);
+        static bool DrawField(const char* label, Viewport& value);
+
+        template<typename T>
+            requires std::is_enum_v<T>
+        static bool DrawField(const char* label, T& value)
+        {
+            int index = static_cast<int>(value);
+            if (!DrawField(label, index))
+                return false;
+
+            value = static_cast<T>(index);
+            return true;
+        }
+
+        template<Reflection::Reflected T>
+        static bool DrawField(const char* label, T& value)
+        {
+            _BeginNested(label, true);
+            bool modified = DrawReflectedFields(value);
+            _EndNested();
+            return modified;
+        }
+
+        // A combo of the alternatives by name, then the fields of the current one
+        template<typename... Ts>
+        static bool DrawField(const char* label, std::variant<Ts...>& value)
+        {
+            const char* names[] = { Reflection::TypeName<Ts>()... };
+            int index = static_cast<int>(value.index());
+
+            bool modified = false;
+            if (_DrawTypeCombo(*label ? label : "Type", index, names, static_cast<int>(sizeof...(Ts))))
+            {
+                Reflection::EmplaceAlternative(value, static_cast<size_t>(index));
+                modified = true;
+            }
+
+            modified |= std::visit([](auto& alternative) { return DrawReflectedFields(alternative); }, value);
+            return modified;
+        }
+
+        // A checkbox creating or dropping the value, then its fields
+        template<Reflection::Reflected T>
+        static bool DrawField(const char* label, std::optional<T>& value)
+        {
+            bool enabled = value.has_value();
+            bool modified = DrawField(label, enabled);
+            if (modified)
+            {
+                if (enabled)
+                    value.emplace();
+                else
+                    value.reset();
+            }
+
+            if (value)
+            {
+                _BeginNested(label, false);
+                modified |= DrawReflectedFields(*value);
+                _EndNested();
+            }
+            return modified;
+        }
+
+        template<typename T, size_t N>
+        static bool DrawField(const char* label, std::array<T, N>& value)
+        {
+            bool modified = false;
+            for (size_t i = 0; i < N; ++i)
+            {
+                std::string elementLabel = std::string(label) + " " + std::to_string(i);
+                modified |= DrawField(elementLabel.c_str(), value[i]);
+            }
+            return modified;
+        }
+
+        // One control per field of a reflected component, returns true if any of them was edited
+        template<Reflection::Reflected T>
+        static bool DrawReflectedFields(T& component)
+        {
+            bool modified = false;
+            Reflection::ForEachField<T>([&](const auto& field)
+                                        { modified |= DrawField(field.name, component.*field.member); });
+
+            if (modified)
+            {
+                Reflection::NotifyAssigned(component);
+            }
+            return modified;
+        }
+
+    private:
+        static bool _DrawTypeCombo(const char* label, int& index, const char* const* names, int count);
+        // Indents the controls of a nested value, under its label when showLabel is set
+        static void _BeginNested(const char* label, bool showLabel);
+        static void _EndNested();
     };
 } // namespace Frost
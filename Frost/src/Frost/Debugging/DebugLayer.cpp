@@ -6,6 +6,7 @@
 #include "Frost/Renderer/DX11/RendererDX11.h"
 #include "Frost/Renderer/RendererAPI.h"
 
+#include "Frost/Debugging/DebugInterface/DebugAssets.h"
 #include "Frost/Debugging/DebugInterface/DebugInput.h"
 #include "Frost/Debugging/DebugInterface/DebugPerformance.h"
 #include "Frost/Debugging/DebugInterface/DebugPhysics.h"
@@ -46,6 +47,7 @@ namespace Frost
 #error "Platform not supported!"
 #endif
 
+        _debugPanels.push_back(std::make_unique<DebugAssets>());
         _debugPanels.push_back(std::make_unique<DebugInput>());
         _debugPanels.push_back(std::make_unique<DebugPerformance>());
         _debugPanels.push_back(std::make_unique<DebugPhysics>());
@@ -1,18 +1,69 @@
 #include "Frost/Debugging/Logger.h"
+#include <spdlog/async.h>
 #include <spdlog/sinks/basic_file_sink.h>
 #include <spdlog/sinks/wincolor_sink.h>
 
+#include <Windows.h>
+#include <array>
+#include <atomic>
+#include <cstdlib>
+#include <exception>
+#include <functional>
+
 namespace Frost
 {
     constexpr const char* LOG_FILE_NAME = "Frost.log";
     constexpr const char* ENGINE_LOGGER_NAME = "FROST";
     constexpr const char* GAME_LOGGER_NAME = "GAME";
 
+    // Messages waiting for the background thread, the oldest are dropped past it
+    constexpr size_t LOG_QUEUE_SIZE = 8192;
+    constexpr auto LOG_FLUSH_INTERVAL = std::chrono::seconds(3);
+
+    std::shared_mutex Logger::_loggerMutex;
     std::shared_ptr<spdlog::logger> Logger::_engineLogger;
     std::shared_ptr<spdlog::logger> Logger::_gameLogger;
 
+    namespace
+    {
+        struct RateLimitSlot
+        {
+            std::atomic<int64_t> windowStart{ 0 };
+            std::atomic<uint32_t> count{ 0 };
+            std::atomic<uint32_t> suppressed{ 0 };
+        };
+
+        std::array<RateLimitSlot, 512> rateLimitSlots;
+        std::atomic<uint32_t> rateLimitCount{ 20 };
+        std::atomic<int64_t> rateLimitWindowMs{ 1000 };
+
+        std::terminate_handler previousTerminateHandler = nullptr;
+
+        // Shutting down here would take the registry lock and join the background thread from a crashed state
+        LONG WINAPI OnUnhandledException(EXCEPTION_POINTERS* exception)
+        {
+            Logger::LogCrash(fmt::format("Unhandled exception 0x{:08X} at {}",
+                                         static_cast<uint32_t>(exception->ExceptionRecord->ExceptionCode),
+                                         exception->ExceptionRecord->ExceptionAddress));
+            return EXCEPTION_CONTINUE_SEARCH;
+        }
+
+        void OnTerminate()
+        {
+            Logger::LogCrash("std::terminate called");
+
+            if (previousTerminateHandler)
+            {
+                previousTerminateHandler();
+            }
+            std::abort();
+        }
+    } // namespace
+
     void Logger::Init()
     {
+        spdlog::init_thread_pool(LOG_QUEUE_SIZE, 1);
+
         auto console_sink = std::make_shared<spdlog::sinks::wincolor_stdout_sink_mt>();
         console_sink->set_pattern("%^[%H:%M:%S.%e] [%n]: %v%$");
 
@@ -22,26 +73,154 @@ namespace Frost
         std::vector<spdlog::sink_ptr> engine_sinks = { console_sink, file_sink };
         std::vector<spdlog::sink_ptr> game_sinks = { console_sink };
 
-        _engineLogger = std::make_shared<spdlog::logger>(ENGINE_LOGGER_NAME, begin(engine_sinks), end(engine_sinks));
-        spdlog::register_logger(_engineLogger);
-        _engineLogger->set_level(spdlog::level::trace);
-        _engineLogger->flush_on(spdlog::level::trace);
+        auto engineLogger = std::make_shared<spdlog::async_logger>(ENGINE_LOGGER_NAME,
+                                                                   begin(engine_sinks),
+                                                                   end(engine_sinks),
+                                                                   spdlog::thread_pool(),
+                                                                   spdlog::async_overflow_policy::overrun_oldest);
+        spdlog::register_logger(engineLogger);
+        engineLogger->set_level(spdlog::level::trace);
+        engineLogger->flush_on(spdlog::level::warn);
+
+        auto gameLogger = std::make_shared<spdlog::async_logger>(GAME_LOGGER_NAME,
+                                                                 begin(game_sinks),
+                                                                 end(game_sinks),
+                                                                 spdlog::thread_pool(),
+                                                                 spdlog::async_overflow_policy::overrun_oldest);
+        spdlog::register_logger(gameLogger);
+        gameLogger->set_level(spdlog::level::trace);
+        gameLogger->flush_on(spdlog::level::warn);
 
-        _gameLogger = std::make_shared<spdlog::logger>(GAME_LOGGER_NAME, begin(game_sinks), end(game_sinks));
-        spdlog::register_logger(_gameLogger);
-        _gameLogger->set_level(spdlog::level::trace);
-        _gameLogger->flush_on(spdlog::level::trace);
+        spdlog::set_default_logger(engineLogger);
+        spdlog::flush_every(LOG_FLUSH_INTERVAL);
+
+        {
+            std::unique_lock lock(_loggerMutex);
+            _engineLogger = std::move(engineLogger);
+            _gameLogger = std::move(gameLogger);
+        }
+
+        _InstallCrashHandlers();
+    }
+
+    void Logger::Shutdown()
+    {
+        {
+            // Waits for the messages being logged, later ones find no logger
+            std::unique_lock lock(_loggerMutex);
+            if (!_engineLogger)
+            {
+                return;
+            }
+
+            _engineLogger->flush();
+            _gameLogger->flush();
+            _engineLogger.reset();
+            _gameLogger.reset();
+        }
+
+        // Joins the background thread once the queue is empty
+        spdlog::shutdown();
+    }
+
+    void Logger::Flush()
+    {
+        std::shared_lock lock(_loggerMutex);
+        if (_engineLogger)
+        {
+            _engineLogger->flush();
+        }
+        if (_gameLogger)
+        {
+            _gameLogger->flush();
+        }
+    }
 
-        spdlog::set_default_logger(_engineLogger);
+    void Logger::LogCrash(const std::string& message)
+    {
+        std::shared_lock lock(_loggerMutex, std::try_to_lock);
+        if (!lock.owns_lock() || !_engineLogger)
+        {
+            return;
+        }
+
+        spdlog::details::log_msg msg(_engineLogger->name(), spdlog::level::critical, message);
+        for (const spdlog::sink_ptr& sink : _engineLogger->sinks())
+        {
+            sink->log(msg);
+            sink->flush();
+        }
+    }
+
+    void Logger::SetLevel(LogCategory category, spdlog::level::level_enum level)
+    {
+        std::shared_lock lock(_loggerMutex);
+        std::shared_ptr<spdlog::logger>& logger = category == LogCategory::Engine ? _engineLogger : _gameLogger;
+        if (logger)
+        {
+            logger->set_level(level);
+        }
+    }
+
+    spdlog::level::level_enum Logger::GetLevel(LogCategory category)
+    {
+        std::shared_lock lock(_loggerMutex);
+        std::shared_ptr<spdlog::logger>& logger = category == LogCategory::Engine ? _engineLogger : _gameLogger;
+        return logger ? logger->level() : spdlog::level::off;
+    }
+
+    void Logger::SetRateLimit(uint32_t count, std::chrono::milliseconds window)
+    {
+        rateLimitCount.store(count, std::memory_order_relaxed);
+        rateLimitWindowMs.store(window.count(), std::memory_order_relaxed);
+    }
+
+    bool Logger::_Admit(const void* format, uint32_t& suppressed)
+    {
+        uint32_t limit = rateLimitCount.load(std::memory_order_relaxed);
+        if (limit == 0)
+        {
+            return true;
+        }
+
+        RateLimitSlot& slot = rateLimitSlots[std::hash<const void*>{}(format) % rateLimitSlots.size()];
+        int64_t now = std::chrono::duration_cast<std::chrono::milliseconds>(
+                          std::chrono::steady_clock::now().time_since_epoch())
+                          .count();
+
+        // Only the thread that moves the window on resets the count
+        int64_t windowStart = slot.windowStart.load(std::memory_order_relaxed);
+        if (now - windowStart >= rateLimitWindowMs.load(std::memory_order_relaxed) &&
+            slot.windowStart.compare_exchange_strong(windowStart, now, std::memory_order_relaxed))
+        {
+            slot.count.store(0, std::memory_order_relaxed);
+        }
+
+        if (slot.count.fetch_add(1, std::memory_order_relaxed) >= limit)
+        {
+            slot.suppressed.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+
+        suppressed = slot.suppressed.exchange(0, std::memory_order_relaxed);
+        return true;
+    }
+
+    void Logger::_InstallCrashHandlers()
+    {
+        SetUnhandledExceptionFilter(&OnUnhandledException);
+        previousTerminateHandler = std::set_terminate(&OnTerminate);
     }
 
-    std::shared_ptr<spdlog::logger>& Logger::GetEngineLogger()
+    std::shared_ptr<spdlog::logger> Logger::GetEngineLogger()
     {
+        std::shared_lock lock(_loggerMutex);
         return _engineLogger;
     }
 
-    std::shared_ptr<spdlog::logger>& Logger::GetGameLogger()
+    std::shared_ptr<spdlog::logger> Logger::GetGameLogger()
     {
+        std::shared_lock lock(_loggerMutex);
         return _gameLogger;
     }
 } // namespace Frost
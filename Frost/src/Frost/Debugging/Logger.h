@@ -3,135 +3,177 @@
 #include "Frost/Core/Core.h"
 
 #include <spdlog/spdlog.h>
+#include <chrono>
+#include <cstdint>
 #include <memory>
+#include <mutex>
+#include <shared_mutex>
+
+// The FT_* functions of the levels under FT_LOG_ACTIVE_LEVEL compile to nothing, the others can still be filtered
+// per category at runtime with Logger::SetLevel
+#define FT_LOG_LEVEL_TRACE 0
+#define FT_LOG_LEVEL_INFO 2
+#define FT_LOG_LEVEL_WARN 3
+#define FT_LOG_LEVEL_ERROR 4
+#define FT_LOG_LEVEL_CRITICAL 5
+#define FT_LOG_LEVEL_OFF 6
+
+#ifndef FT_LOG_ACTIVE_LEVEL
+#ifdef FT_DEBUG
+#define FT_LOG_ACTIVE_LEVEL FT_LOG_LEVEL_TRACE
+#else
+#define FT_LOG_ACTIVE_LEVEL FT_LOG_LEVEL_INFO
+#endif
+#endif
 
 namespace Frost
 {
+    enum class LogCategory
+    {
+        Engine,
+        Game
+    };
+
+    // Both loggers hand their messages to a background thread through a bounded queue, which drops its oldest
+    // message rather than block when full. The file is flushed on warnings and above, every few seconds, on shutdown
+    // and on a crash. A crash only flushes the sinks, the background thread is left alone.
+    //
+    // Logging may run on any thread, the loggers are swapped out by Init and Shutdown under _loggerMutex.
     class FROST_API Logger
     {
     public:
         static void Init();
-
-        static std::shared_ptr<spdlog::logger>& GetEngineLogger();
-        static std::shared_ptr<spdlog::logger>& GetGameLogger();
+        // Writes the queued messages and stops the background thread, logging does nothing afterwards
+        static void Shutdown();
+        static void Flush();
+        // For crash handlers: writes a critical message straight to the engine sinks and flushes them, bypassing the
+        // queue and the registry. Does nothing if another thread is initializing or shutting the loggers down.
+        static void LogCrash(const std::string& message);
+
+        static void SetLevel(LogCategory category, spdlog::level::level_enum level);
+        static spdlog::level::level_enum GetLevel(LogCategory category);
+
+        // At most count trace, debug and info messages of a format string per window, zero lets everything through.
+        // Warnings and above are never dropped. The next message let through tells how many were suppressed. Format
+        // strings sharing a slot of the table share their limit.
+        static void SetRateLimit(uint32_t count, std::chrono::milliseconds window);
+
+        static std::shared_ptr<spdlog::logger> GetEngineLogger();
+        static std::shared_ptr<spdlog::logger> GetGameLogger();
+
+        template<typename... Args>
+        static void Log(LogCategory category,
+                        spdlog::level::level_enum level,
+                        fmt::format_string<Args...> fmt,
+                        Args&&... args)
+        {
+            std::shared_lock lock(_loggerMutex);
+            const std::shared_ptr<spdlog::logger>& logger =
+                category == LogCategory::Engine ? _engineLogger : _gameLogger;
+            if (!logger || !logger->should_log(level))
+            {
+                return;
+            }
+
+            uint32_t suppressed = 0;
+            if (level < spdlog::level::warn && !_Admit(fmt.get().data(), suppressed))
+            {
+                return;
+            }
+
+            if (suppressed > 0)
+            {
+                logger->log(level, "({} messages like the next one were suppressed)", suppressed);
+            }
+            logger->log(level, fmt, std::forward<Args>(args)...);
+        }
 
     private:
+        static bool _Admit(const void* format, uint32_t& suppressed);
+        static void _InstallCrashHandlers();
+
+        static std::shared_mutex _loggerMutex;
         static std::shared_ptr<spdlog::logger> _engineLogger;
         static std::shared_ptr<spdlog::logger> _gameLogger;
     };
 
-#ifdef FT_DEBUG
-    template<typename... Args>
-    void FT_ENGINE_TRACE(fmt::format_string<Args...> fmt, Args&&... args)
-    {
-        Logger::GetEngineLogger()->trace(fmt, std::forward<Args>(args)...);
-    }
-
-    template<typename... Args>
-    void FT_ENGINE_INFO(fmt::format_string<Args...> fmt, Args&&... args)
-    {
-        Logger::GetEngineLogger()->info(fmt, std::forward<Args>(args)...);
-    }
-
-    template<typename... Args>
-    void FT_ENGINE_WARN(fmt::format_string<Args...> fmt, Args&&... args)
-    {
-        Logger::GetEngineLogger()->warn(fmt, std::forward<Args>(args)...);
-    }
-
-    template<typename... Args>
-    void FT_ENGINE_ERROR(fmt::format_string<Args...> fmt, Args&&... args)
-    {
-        Logger::GetEngineLogger()->error(fmt, std::forward<Args>(args)...);
-    }
-
-    template<typename... Args>
-    void FT_ENGINE_CRITICAL(fmt::format_string<Args...> fmt, Args&&... args)
-    {
-        Logger::GetEngineLogger()->critical(fmt, std::forward<Args>(args)...);
-    }
-
-    template<typename... Args>
-    void FT_TRACE(fmt::format_string<Args...> fmt, Args&&... args)
-    {
-        Logger::GetGameLogger()->trace(fmt, std::forward<Args>(args)...);
-    }
-
-    template<typename... Args>
-    void FT_INFO(fmt::format_string<Args...> fmt, Args&&... args)
-    {
-        Logger::GetGameLogger()->info(fmt, std::forward<Args>(args)...);
-    }
-
-    template<typename... Args>
-    void FT_WARN(fmt::format_string<Args...> fmt, Args&&... args)
-    {
-        Logger::GetGameLogger()->warn(fmt, std::forward<Args>(args)...);
-    }
-
-    template<typename... Args>
-    void FT_ERROR(fmt::format_string<Args...> fmt, Args&&... args)
-    {
-        Logger::GetGameLogger()->error(fmt, std::forward<Args>(args)...);
-    }
-
-    template<typename... Args>
-    void FT_CRITICAL(fmt::format_string<Args...> fmt, Args&&... args)
-    {
-        Logger::GetGameLogger()->critical(fmt, std::forward<Args>(args)...);
-    }
-
-#else
-
     template<typename... Args>
     void FT_ENGINE_TRACE(fmt::format_string<Args...> fmt, Args&&... args)
     {
+#if FT_LOG_ACTIVE_LEVEL <= FT_LOG_LEVEL_TRACE
+        Logger::Log(LogCategory::Engine, spdlog::level::trace, fmt, std::forward<Args>(args)...);
+#endif
     }
 
     template<typename... Args>
     void FT_ENGINE_INFO(fmt::format_string<Args...> fmt, Args&&... args)
     {
+#if FT_LOG_ACTIVE_LEVEL <= FT_LOG_LEVEL_INFO
+        Logger::Log(LogCategory::Engine, spdlog::level::info, fmt, std::forward<Args>(args)...);
+#endif
     }
 
     template<typename... Args>
     void FT_ENGINE_WARN(fmt::format_string<Args...> fmt, Args&&... args)
     {
+#if FT_LOG_ACTIVE_LEVEL <= FT_LOG_LEVEL_WARN
+        Logger::Log(LogCategory::Engine, spdlog::level::warn, fmt, std::forward<Args>(args)...);
+#endif
     }
 
     template<typename... Args>
     void FT_ENGINE_ERROR(fmt::format_string<Args...> fmt, Args&&... args)
     {
+#if FT_LOG_ACTIVE_LEVEL <= FT_LOG_LEVEL_ERROR
+        Logger::Log(LogCategory::Engine, spdlog::level::err, fmt, std::forward<Args>(args)...);
+#endif
     }
 
     template<typename... Args>
     void FT_ENGINE_CRITICAL(fmt::format_string<Args...> fmt, Args&&... args)
     {
+#if FT_LOG_ACTIVE_LEVEL <= FT_LOG_LEVEL_CRITICAL
+        Logger::Log(LogCategory::Engine, spdlog::level::critical, fmt, std::forward<Args>(args)...);
+#endif
     }
 
     template<typename... Args>
     void FT_TRACE(fmt::format_string<Args...> fmt, Args&&... args)
     {
+#if FT_LOG_ACTIVE_LEVEL <= FT_LOG_LEVEL_TRACE
+        Logger::Log(LogCategory::Game, spdlog::level::trace, fmt, std::forward<Args>(args)...);
+#endif
     }
 
     template<typename... Args>
     void FT_INFO(fmt::format_string<Args...> fmt, Args&&... args)
     {
+#if FT_LOG_ACTIVE_LEVEL <= FT_LOG_LEVEL_INFO
+        Logger::Log(LogCategory::Game, spdlog::level::info, fmt, std::forward<Args>(args)...);
+#endif
     }
 
     template<typename... Args>
     void FT_WARN(fmt::format_string<Args...> fmt, Args&&... args)
     {
+#if FT_LOG_ACTIVE_LEVEL <= FT_LOG_LEVEL_WARN
+        Logger::Log(LogCategory::Game, spdlog::level::warn, fmt, std::forward<Args>(args)...);
+#endif
     }
 
     template<typename... Args>
     void FT_ERROR(fmt::format_string<Args...> fmt, Args&&... args)
     {
+#if FT_LOG_ACTIVE_LEVEL <= FT_LOG_LEVEL_ERROR
+        Logger::Log(LogCategory::Game, spdlog::level::err, fmt, std::forward<Args>(args)...);
+#endif
     }
 
     template<typename... Args>
     void FT_CRITICAL(fmt::format_string<Args...> fmt, Args&&... args)
     {
-    }
-
+#if FT_LOG_ACTIVE_LEVEL <= FT_LOG_LEVEL_CRITICAL
+        Logger::Log(LogCategory::Game, spdlog::level::critical, fmt, std::forward<Args>(args)...);
 #endif
+    }
 } // namespace Frost
@@ -15,6 +15,7 @@ namespace Frost
         _isConnected{ false },
         _dwPacketNumber{ 0 },
         _buttons{ 0 },
+        _rawState{},
         _leftMotorSpeed{ 0 },
         _rightMotorSpeed{ 0 }
     {
@@ -43,6 +44,20 @@ namespace Frost
                 return;
             }
 
+            _dwPacketNumber = state.dwPacketNumber;
+            _SetState(true, state.Gamepad);
+        }
+        else
+        {
+            _dwPacketNumber = 0;
+            _SetState(false, state.Gamepad);
+        }
+    }
+
+    void Gamepad::_SetState(bool isConnected, const XINPUT_GAMEPAD& state)
+    {
+        if (isConnected)
+        {
             // Check if the controller was previously disconnected
             if (!_isConnected)
             {
@@ -50,13 +65,13 @@ namespace Frost
             }
 
             _isConnected = true;
-            _dwPacketNumber = state.dwPacketNumber;
+            _rawState = state;
 
-            _UpdateJoystick(_leftJoystick, state.Gamepad.sThumbLX, state.Gamepad.sThumbLY);
-            _UpdateJoystick(_rightJoystick, state.Gamepad.sThumbRX, state.Gamepad.sThumbRY);
-            _UpdateTrigger(_leftTrigger, state.Gamepad.bLeftTrigger);
-            _UpdateTrigger(_rightTrigger, state.Gamepad.bRightTrigger);
-            _buttons = state.Gamepad.wButtons;
+            _UpdateJoystick(_leftJoystick, state.sThumbLX, state.sThumbLY);
+            _UpdateJoystick(_rightJoystick, state.sThumbRX, state.sThumbRY);
+            _UpdateTrigger(_leftTrigger, state.bLeftTrigger);
+            _UpdateTrigger(_rightTrigger, state.bRightTrigger);
+            _buttons = state.wButtons;
         }
         else
         {
@@ -67,10 +82,19 @@ namespace Frost
             }
 
             _isConnected = false;
-            _dwPacketNumber = 0;
         }
     }
 
+    Gamepad::Snapshot Gamepad::GetSnapshot() const noexcept
+    {
+        return { _isConnected, _rawState };
+    }
+
+    void Gamepad::ApplySnapshot(const Snapshot& snapshot)
+    {
+        _SetState(snapshot.isConnected, snapshot.state);
+    }
+
     bool Gamepad::IsConnected() const noexcept
     {
         return _isConnected;
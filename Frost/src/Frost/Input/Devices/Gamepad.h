@@ -112,6 +112,16 @@ namespace Frost
         // Buttons
         bool IsButtonPressed(Buttons button) noexcept;
 
+        // Raw device state, used to record and replay input
+        struct Snapshot
+        {
+            bool isConnected;
+            XINPUT_GAMEPAD state;
+        };
+
+        Snapshot GetSnapshot() const noexcept;
+        void ApplySnapshot(const Snapshot& snapshot);
+
         // Vibration
         WORD GetLeftMotorSpeed() const noexcept;
         WORD GetRightMotorSpeed() const noexcept;
@@ -125,6 +135,7 @@ namespace Frost
         bool _isConnected;
         DWORD _dwPacketNumber;
         WORD _buttons;
+        XINPUT_GAMEPAD _rawState;
 
         Joystick _leftJoystick;
         Joystick _rightJoystick;
@@ -135,6 +146,7 @@ namespace Frost
         WORD _leftMotorSpeed;
         WORD _rightMotorSpeed;
 
+        void _SetState(bool isConnected, const XINPUT_GAMEPAD& state);
         void _UpdateJoystick(Joystick& joystick, SHORT rawX, SHORT rawY);
         void _UpdateTrigger(Trigger& trigger, BYTE rawValue);
     };
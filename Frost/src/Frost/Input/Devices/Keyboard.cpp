@@ -39,6 +39,32 @@ namespace Frost
         return false;
     }
 
+    Keyboard::Snapshot Keyboard::GetSnapshot() const
+    {
+        Snapshot snapshot;
+        for (const auto& [keyCode, state] : _keyStates)
+        {
+            if (state != KeyState::UP)
+            {
+                snapshot.emplace_back(keyCode, state);
+            }
+        }
+        return snapshot;
+    }
+
+    void Keyboard::ApplySnapshot(const Snapshot& snapshot)
+    {
+        for (auto& pair : _keyStates)
+        {
+            pair.second = KeyState::UP;
+        }
+
+        for (const auto& [keyCode, state] : snapshot)
+        {
+            _keyStates[keyCode] = state;
+        }
+    }
+
     void Keyboard::Reset()
     {
         for (auto& pair : _keyStates)
@@ -3,6 +3,7 @@
 #include "Frost/Core/Core.h"
 
 #include <unordered_map>
+#include <vector>
 
 #define WIN32_LEAN_AND_MEAN
 #include <windows.h>
@@ -227,6 +228,11 @@ namespace Frost
         bool IsKeyPressed(const VirtualKeyCode keyCode) const;
         void Reset();
 
+        // Keys that are not UP, used to record and replay input
+        using Snapshot = std::vector<std::pair<VirtualKeyCode, KeyState>>;
+        Snapshot GetSnapshot() const;
+        void ApplySnapshot(const Snapshot& snapshot);
+
     private:
         std::unordered_map<VirtualKeyCode, KeyState> _keyStates;
     };
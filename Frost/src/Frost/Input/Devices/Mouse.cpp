@@ -209,6 +209,21 @@ namespace Frost
         return (GetAsyncKeyState(virtualKeyCode) & 0x8000) != 0;
     }
 
+    Mouse::Snapshot Mouse::GetSnapshot() const
+    {
+        return { _position, _viewportPosition, _scroll, _buttonStates, _currentButtonPresses };
+    }
+
+    void Mouse::ApplySnapshot(const Snapshot& snapshot)
+    {
+        _position = snapshot.position;
+        _viewportPosition = snapshot.viewportPosition;
+        _scroll = snapshot.scroll;
+        _buttonStates = snapshot.buttonStates;
+        _previousButtonPresses = _currentButtonPresses;
+        _currentButtonPresses = snapshot.buttonPresses;
+    }
+
     void Mouse::Reset()
     {
         _UpdateButtonStates();
@@ -75,6 +75,19 @@ namespace Frost
         void Update();
         void Reset();
 
+        // Full device state, used to record and replay input
+        struct Snapshot
+        {
+            MousePosition position;
+            MouseViewportPosition viewportPosition;
+            MouseScroll scroll;
+            std::array<ButtonState, static_cast<uint8_t>(MouseBoutton::Count)> buttonStates;
+            std::array<bool, static_cast<uint8_t>(MouseBoutton::Count)> buttonPresses;
+        };
+
+        Snapshot GetSnapshot() const;
+        void ApplySnapshot(const Snapshot& snapshot);
+
     private:
         MousePosition _position{};
         MouseViewportPosition _viewportPosition{};
@@ -28,6 +28,12 @@ namespace Frost
 
     void Input::Update()
     {
+        // Devices are driven by the recording, once per fixed tick
+        if (IsReplaying())
+        {
+            return;
+        }
+
         GetMouse().Update();
 
         // TODO: Update not connected gamepads every few seconds to check for
@@ -40,7 +46,40 @@ namespace Frost
 
     void Input::Reset()
     {
-        GetMouse().Reset();
+        if (!IsReplaying())
+        {
+            GetMouse().Reset();
+        }
         GetKeyboard().Reset();
     }
+
+    bool Input::StartRecording(const std::filesystem::path& path)
+    {
+        return Get()._recorder.StartRecording(path);
+    }
+
+    bool Input::StartReplay(const std::filesystem::path& path)
+    {
+        return Get()._recorder.StartReplay(path);
+    }
+
+    void Input::StopRecording()
+    {
+        Get()._recorder.Stop();
+    }
+
+    bool Input::IsRecording()
+    {
+        return Get()._recorder.GetMode() == InputRecorder::Mode::Recording;
+    }
+
+    bool Input::IsReplaying()
+    {
+        return Get()._recorder.GetMode() == InputRecorder::Mode::Replaying;
+    }
+
+    void Input::OnFixedTick(float& fixedDeltaTime)
+    {
+        Get()._recorder.OnFixedTick(Get(), fixedDeltaTime);
+    }
 } // namespace Frost
\ No newline at end of file
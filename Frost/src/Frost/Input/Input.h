@@ -4,6 +4,7 @@
 #include "Frost/Input/Devices/Gamepad.h"
 #include "Frost/Input/Devices/Keyboard.h"
 #include "Frost/Input/Devices/Mouse.h"
+#include "Frost/Input/InputRecorder.h"
 #include "Frost/Utils/NoCopy.h"
 
 #include <array>
@@ -21,6 +22,14 @@ namespace Frost
         static void Update();
         static void Reset();
 
+        // Recording and replay, both also fix the seed of Random
+        static bool StartRecording(const std::filesystem::path& path);
+        static bool StartReplay(const std::filesystem::path& path);
+        static void StopRecording();
+        static bool IsRecording();
+        static bool IsReplaying();
+        static void OnFixedTick(float& fixedDeltaTime);
+
     private:
         Input() = default;
 
@@ -28,5 +37,8 @@ namespace Frost
         Mouse _mouse;
         Keyboard _keyboard;
         std::array<Gamepad, Gamepad::MAX_GAMEPADS> _gamepads{ Gamepad(0), Gamepad(1), Gamepad(2), Gamepad(3) };
+        InputRecorder _recorder;
+
+        friend class InputRecorder;
     };
 } // namespace Frost
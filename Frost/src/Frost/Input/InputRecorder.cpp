@@ -0,0 +1,208 @@
+#include "Frost/Input/InputRecorder.h"
+#include "Frost/Input/Input.h"
+#include "Frost/Debugging/Logger.h"
+#include "Frost/Utils/Random.h"
+#include "Frost/Utils/SerializerUtils.h"
+
+namespace Frost
+{
+    bool InputRecorder::StartRecording(const std::filesystem::path& path)
+    {
+        Stop();
+
+        _out.open(path, std::ios::binary | std::ios::trunc);
+        if (!_out)
+        {
+            FT_ENGINE_ERROR("InputRecorder: cannot create recording '{}'", path.string());
+            return false;
+        }
+
+        // The seed is stored so that the replay draws the same random numbers
+        uint32_t seed = std::random_device{}();
+        Random::SetSeed(seed);
+
+        WriteBinary(_out, RECORDING_MAGIC);
+        WriteBinary(_out, RECORDING_VERSION);
+        WriteBinary(_out, seed);
+
+        _mode = Mode::Recording;
+        _tick = 0;
+        FT_ENGINE_INFO("InputRecorder: recording to '{}' (seed {})", path.string(), seed);
+        return true;
+    }
+
+    bool InputRecorder::StartReplay(const std::filesystem::path& path)
+    {
+        Stop();
+
+        _in.open(path, std::ios::binary);
+        if (!_in)
+        {
+            FT_ENGINE_ERROR("InputRecorder: cannot open recording '{}'", path.string());
+            return false;
+        }
+
+        uint32_t magic = 0;
+        uint32_t version = 0;
+        uint32_t seed = 0;
+        ReadBinary(_in, magic);
+        ReadBinary(_in, version);
+        ReadBinary(_in, seed);
+
+        if (!_in || magic != RECORDING_MAGIC || version != RECORDING_VERSION)
+        {
+            FT_ENGINE_ERROR("InputRecorder: '{}' is not a valid recording", path.string());
+            _in.close();
+            return false;
+        }
+
+        Random::SetSeed(seed);
+
+        _mode = Mode::Replaying;
+        _tick = 0;
+        FT_ENGINE_INFO("InputRecorder: replaying '{}' (seed {})", path.string(), seed);
+        return true;
+    }
+
+    void InputRecorder::Stop()
+    {
+        if (_out.is_open())
+        {
+            _out.close();
+        }
+
+        if (_in.is_open())
+        {
+            _in.close();
+        }
+
+        _mode = Mode::None;
+    }
+
+    void InputRecorder::OnFixedTick(Input& input, float& fixedDeltaTime)
+    {
+        switch (_mode)
+        {
+            case Mode::Recording:
+                _WriteTick(input, fixedDeltaTime);
+                break;
+            case Mode::Replaying:
+                if (!_ReadTick(input, fixedDeltaTime))
+                {
+                    FT_ENGINE_INFO("InputRecorder: replay finished after {} ticks", _tick);
+                    Stop();
+                    return;
+                }
+                break;
+            default:
+                return;
+        }
+
+        ++_tick;
+    }
+
+    void InputRecorder::_WriteTick(Input& input, float fixedDeltaTime)
+    {
+        WriteBinary(_out, fixedDeltaTime);
+
+        // Keyboard: only the keys that are not up
+        Keyboard::Snapshot keyboard = input._keyboard.GetSnapshot();
+        WriteBinary(_out, static_cast<uint16_t>(keyboard.size()));
+        for (const auto& [keyCode, state] : keyboard)
+        {
+            WriteBinary(_out, static_cast<uint8_t>(keyCode));
+            WriteBinary(_out, static_cast<uint8_t>(state));
+        }
+
+        Mouse::Snapshot mouse = input._mouse.GetSnapshot();
+        WriteBinary(_out, mouse.position);
+        WriteBinary(_out, mouse.viewportPosition);
+        WriteBinary(_out, mouse.scroll);
+        WriteBinary(_out, mouse.buttonStates);
+
+        uint8_t presses = 0;
+        for (size_t i = 0; i < mouse.buttonPresses.size(); ++i)
+        {
+            presses |= mouse.buttonPresses[i] ? (1 << i) : 0;
+        }
+        WriteBinary(_out, presses);
+
+        // Gamepads: a connection mask, then the raw state of the connected ones
+        uint8_t connected = 0;
+        for (uint8_t i = 0; i < Gamepad::MAX_GAMEPADS; ++i)
+        {
+            connected |= input._gamepads[i].IsConnected() ? (1 << i) : 0;
+        }
+        WriteBinary(_out, connected);
+
+        for (uint8_t i = 0; i < Gamepad::MAX_GAMEPADS; ++i)
+        {
+            if (connected & (1 << i))
+            {
+                WriteBinary(_out, input._gamepads[i].GetSnapshot().state);
+            }
+        }
+    }
+
+    bool InputRecorder::_ReadTick(Input& input, float& fixedDeltaTime)
+    {
+        float recordedDeltaTime = 0.0f;
+        ReadBinary(_in, recordedDeltaTime);
+
+        uint16_t keyCount = 0;
+        ReadBinary(_in, keyCount);
+
+        Keyboard::Snapshot keyboard;
+        keyboard.reserve(keyCount);
+        for (uint16_t i = 0; i < keyCount; ++i)
+        {
+            uint8_t keyCode = 0;
+            uint8_t state = 0;
+            ReadBinary(_in, keyCode);
+            ReadBinary(_in, state);
+            keyboard.emplace_back(static_cast<VirtualKeyCode>(keyCode), static_cast<KeyState>(state));
+        }
+
+        Mouse::Snapshot mouse;
+        ReadBinary(_in, mouse.position);
+        ReadBinary(_in, mouse.viewportPosition);
+        ReadBinary(_in, mouse.scroll);
+        ReadBinary(_in, mouse.buttonStates);
+
+        uint8_t presses = 0;
+        ReadBinary(_in, presses);
+        for (size_t i = 0; i < mouse.buttonPresses.size(); ++i)
+        {
+            mouse.buttonPresses[i] = (presses & (1 << i)) != 0;
+        }
+
+        uint8_t connected = 0;
+        ReadBinary(_in, connected);
+
+        std::array<Gamepad::Snapshot, Gamepad::MAX_GAMEPADS> gamepads{};
+        for (uint8_t i = 0; i < Gamepad::MAX_GAMEPADS; ++i)
+        {
+            gamepads[i].isConnected = (connected & (1 << i)) != 0;
+            if (gamepads[i].isConnected)
+            {
+                ReadBinary(_in, gamepads[i].state);
+            }
+        }
+
+        // A truncated tick is dropped entirely
+        if (!_in)
+        {
+            return false;
+        }
+
+        fixedDeltaTime = recordedDeltaTime;
+        input._keyboard.ApplySnapshot(keyboard);
+        input._mouse.ApplySnapshot(mouse);
+        for (uint8_t i = 0; i < Gamepad::MAX_GAMEPADS; ++i)
+        {
+            input._gamepads[i].ApplySnapshot(gamepads[i]);
+        }
+
+        return true;
+    }
+} // namespace Frost
@@ -0,0 +1,47 @@
+#pragma once
+
+#include "Frost/Core/Core.h"
+
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+
+namespace Frost
+{
+    class Input;
+
+    // Captures the state of every device once per fixed tick, or feeds a previous capture back in lock-step
+    class FROST_API InputRecorder
+    {
+    public:
+        enum class Mode : uint8_t
+        {
+            None,
+            Recording,
+            Replaying
+        };
+
+        bool StartRecording(const std::filesystem::path& path);
+        bool StartReplay(const std::filesystem::path& path);
+        void Stop();
+
+        Mode GetMode() const { return _mode; }
+        uint64_t GetTick() const { return _tick; }
+
+        // Called before each fixed update, replay overrides the time step with the recorded one
+        void OnFixedTick(Input& input, float& fixedDeltaTime);
+
+    private:
+        void _WriteTick(Input& input, float fixedDeltaTime);
+        bool _ReadTick(Input& input, float& fixedDeltaTime);
+
+    private:
+        Mode _mode = Mode::None;
+        uint64_t _tick = 0;
+        std::ofstream _out;
+        std::ifstream _in;
+
+        static constexpr uint32_t RECORDING_MAGIC = 0x52495446; // "FTIR"
+        static constexpr uint32_t RECORDING_VERSION = 1;
+    };
+} // namespace Frost
@@ -15,6 +15,7 @@
 #include <iostream>
 #include <stdarg.h>
 
+#include "Frost/Physics/SceneQuery.h"
 #include "Frost/Utils/Math/Vector.h"
 #include <Frost/Debugging/Assert.h>
 #include <Frost/Debugging/Logger.h>
@@ -152,6 +153,11 @@ namespace Frost
 #endif
     }
 
+    void Physics::ExecuteQueries(SceneQueryBatch& batch, Scene& scene)
+    {
+        batch.Execute(scene);
+    }
+
     void Physics::SetLayerNames(const std::vector<PhysicsLayerInfo>& layers)
     {
         _layerNames = layers;
@@ -32,6 +32,8 @@
 
 namespace Frost
 {
+    class SceneQueryBatch;
+
     struct PhysicsLayerInfo
     {
         std::string name;
@@ -41,6 +43,7 @@ namespace Frost
     class FROST_API Physics : NoCopy
     {
         friend class PhysicSystem;
+        friend class SceneQueryBatch;
 
     public:
         static Physics& Get();
@@ -65,6 +68,9 @@ namespace Frost
         void Clear() { Physics::Get().physics_system.~PhysicsSystem(); }
         static JPH::DebugRenderer* GetDebugRenderer();
 
+        // Runs the queries of the batch on the physics job system, see SceneQueryBatch
+        static void ExecuteQueries(SceneQueryBatch& batch, Scene& scene);
+
         static void SetLayerNames(const std::vector<PhysicsLayerInfo>& layers);
         static const std::vector<PhysicsLayerInfo>& GetLayerNames();
 
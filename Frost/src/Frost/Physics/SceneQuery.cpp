@@ -0,0 +1,298 @@
+#include "Frost/Physics/SceneQuery.h"
+#include "Frost/Physics/Physics.h"
+#include "Frost/Scene/Scene.h"
+
+#include <Jolt/Core/Color.h>
+#include <Jolt/Core/JobSystem.h>
+#include <Jolt/Physics/Body/BodyFilter.h>
+#include <Jolt/Physics/Body/BodyLock.h>
+#include <Jolt/Physics/Collision/BroadPhase/BroadPhaseLayer.h>
+#include <Jolt/Physics/Collision/CastResult.h>
+#include <Jolt/Physics/Collision/CollideShape.h>
+#include <Jolt/Physics/Collision/CollisionCollectorImpl.h>
+#include <Jolt/Physics/Collision/RayCast.h>
+#include <Jolt/Physics/Collision/Shape/BoxShape.h>
+#include <Jolt/Physics/Collision/Shape/SphereShape.h>
+#include <Jolt/Physics/Collision/ShapeCast.h>
+
+#include <algorithm>
+#include <atomic>
+
+namespace Frost
+{
+    namespace
+    {
+        class LayerMaskFilter final : public JPH::ObjectLayerFilter
+        {
+        public:
+            explicit LayerMaskFilter(PhysicsLayerMask mask) : _mask(mask) {}
+
+            bool ShouldCollide(JPH::ObjectLayer layer) const override { return (PhysicsLayerBit(layer) & _mask) != 0; }
+
+        private:
+            PhysicsLayerMask _mask;
+        };
+
+        // Bodies store their entity in their user data
+        class IgnoreEntityFilter final : public JPH::BodyFilter
+        {
+        public:
+            explicit IgnoreEntityFilter(entt::entity entity) : _entity(entity) {}
+
+            bool ShouldCollideLocked(const JPH::Body& body) const override
+            {
+                return _entity == entt::null || static_cast<entt::entity>(body.GetUserData()) != _entity;
+            }
+
+        private:
+            entt::entity _entity;
+        };
+
+        class BodyCollector final : public JPH::CollideShapeCollector
+        {
+        public:
+            explicit BodyCollector(std::vector<JPH::BodyID>& bodies) : _bodies(bodies) {}
+
+            void AddHit(const JPH::CollideShapeResult& result) override { _bodies.push_back(result.mBodyID2); }
+
+        private:
+            std::vector<JPH::BodyID>& _bodies;
+        };
+
+        // The shape only lives for the call, it is not reference counted
+        template<typename Function>
+        void WithShape(const QueryShape& queryShape, Function&& function)
+        {
+            if (queryShape.type == QueryShape::Type::Box)
+            {
+                float convexRadius = std::min(JPH::cDefaultConvexRadius, queryShape.halfExtent.ReduceMin());
+                JPH::BoxShape box(queryShape.halfExtent, convexRadius);
+                box.SetEmbedded();
+                function(box);
+            }
+            else
+            {
+                JPH::SphereShape sphere(queryShape.radius);
+                sphere.SetEmbedded();
+                function(sphere);
+            }
+        }
+    } // namespace
+
+    uint32_t SceneQueryBatch::AddRaycast(const RaycastQuery& query)
+    {
+        _raycasts.push_back(query);
+        return static_cast<uint32_t>(_raycasts.size() - 1);
+    }
+
+    uint32_t SceneQueryBatch::AddShapeCast(const ShapeCastQuery& query)
+    {
+        _shapeCasts.push_back(query);
+        return static_cast<uint32_t>(_shapeCasts.size() - 1);
+    }
+
+    uint32_t SceneQueryBatch::AddOverlap(const OverlapQuery& query)
+    {
+        _overlaps.push_back(query);
+        return static_cast<uint32_t>(_overlaps.size() - 1);
+    }
+
+    void SceneQueryBatch::Execute(Scene& scene)
+    {
+        _raycastHits.resize(_raycasts.size());
+        _shapeCastHits.resize(_shapeCasts.size());
+        if (_overlapBodies.size() < _overlaps.size())
+        {
+            _overlapBodies.resize(_overlaps.size());
+            _overlapHits.resize(_overlaps.size());
+        }
+
+        const size_t queryCount = GetQueryCount();
+        if (queryCount < MIN_PARALLEL_QUERIES)
+        {
+            for (size_t index = 0; index < queryCount; ++index)
+            {
+                _RunQuery(index);
+            }
+        }
+        else
+        {
+            // Jobs take QUERIES_PER_JOB queries at a time until none are left, the waiting thread runs jobs too
+            JPH::JobSystem& jobSystem = Physics::Get().job_system;
+            size_t jobCount = std::min<size_t>((queryCount + QUERIES_PER_JOB - 1) / QUERIES_PER_JOB,
+                                               static_cast<size_t>(jobSystem.GetMaxConcurrency()));
+            std::atomic<size_t> nextQuery = 0;
+
+            auto runQueries = [this, &nextQuery, queryCount]()
+            {
+                for (size_t first = nextQuery.fetch_add(QUERIES_PER_JOB); first < queryCount;
+                     first = nextQuery.fetch_add(QUERIES_PER_JOB))
+                {
+                    size_t last = std::min(first + QUERIES_PER_JOB, queryCount);
+                    for (size_t index = first; index < last; ++index)
+                    {
+                        _RunQuery(index);
+                    }
+                }
+            };
+
+            JPH::JobSystem::Barrier* barrier = jobSystem.CreateBarrier();
+            for (size_t i = 0; i < jobCount; ++i)
+            {
+                barrier->AddJob(jobSystem.CreateJob("SceneQueries", JPH::Color::sCyan, runQueries));
+            }
+            jobSystem.WaitForJobs(barrier);
+            jobSystem.DestroyBarrier(barrier);
+        }
+
+        _ResolveGameObjects(scene);
+    }
+
+    void SceneQueryBatch::Clear()
+    {
+        _raycasts.clear();
+        _shapeCasts.clear();
+        _overlaps.clear();
+    }
+
+    void SceneQueryBatch::_RunQuery(size_t index)
+    {
+        if (index < _raycasts.size())
+        {
+            _RunRaycast(index);
+            return;
+        }
+        index -= _raycasts.size();
+
+        if (index < _shapeCasts.size())
+        {
+            _RunShapeCast(index);
+            return;
+        }
+        index -= _shapeCasts.size();
+
+        _RunOverlap(index);
+    }
+
+    void SceneQueryBatch::_RunRaycast(size_t index)
+    {
+        const RaycastQuery& query = _raycasts[index];
+        QueryHit& hit = _raycastHits[index];
+        hit = {};
+
+        const JPH::PhysicsSystem& physicsSystem = Physics::Get().physics_system;
+        LayerMaskFilter layerFilter(query.layerMask);
+        IgnoreEntityFilter bodyFilter(query.ignoredEntity);
+
+        JPH::RRayCast ray(query.origin, query.direction);
+        JPH::RayCastResult result;
+        if (!physicsSystem.GetNarrowPhaseQuery().CastRay(
+                ray, result, JPH::BroadPhaseLayerFilter(), layerFilter, bodyFilter))
+        {
+            return;
+        }
+
+        hit.hasHit = true;
+        hit.bodyId = result.mBodyID;
+        hit.fraction = result.mFraction;
+        hit.position = ray.GetPointOnRay(result.mFraction);
+
+        JPH::BodyLockRead lock(physicsSystem.GetBodyLockInterface(), result.mBodyID);
+        if (lock.Succeeded())
+        {
+            hit.normal = lock.GetBody().GetWorldSpaceSurfaceNormal(result.mSubShapeID2, hit.position);
+        }
+    }
+
+    void SceneQueryBatch::_RunShapeCast(size_t index)
+    {
+        const ShapeCastQuery& query = _shapeCasts[index];
+        QueryHit& hit = _shapeCastHits[index];
+        hit = {};
+
+        const JPH::PhysicsSystem& physicsSystem = Physics::Get().physics_system;
+        LayerMaskFilter layerFilter(query.layerMask);
+        IgnoreEntityFilter bodyFilter(query.ignoredEntity);
+
+        WithShape(query.shape,
+                  [&](const JPH::Shape& shape)
+                  {
+                      JPH::RShapeCast shapeCast(&shape,
+                                                JPH::Vec3::sOne(),
+                                                JPH::RMat44::sRotationTranslation(query.rotation, query.position),
+                                                query.direction);
+                      JPH::ShapeCastSettings settings;
+                      JPH::ClosestHitCollisionCollector<JPH::CastShapeCollector> collector;
+                      physicsSystem.GetNarrowPhaseQuery().CastShape(shapeCast,
+                                                                    settings,
+                                                                    query.position,
+                                                                    collector,
+                                                                    JPH::BroadPhaseLayerFilter(),
+                                                                    layerFilter,
+                                                                    bodyFilter);
+                      if (!collector.HadHit())
+                      {
+                          return;
+                      }
+
+                      // Contact points are relative to the base offset, the penetration axis points into the hit body
+                      const JPH::ShapeCastResult& result = collector.mHit;
+                      hit.hasHit = true;
+                      hit.bodyId = result.mBodyID2;
+                      hit.fraction = result.mFraction;
+                      hit.position = query.position + result.mContactPointOn2;
+                      hit.normal = -result.mPenetrationAxis.NormalizedOr(JPH::Vec3::sZero());
+                  });
+    }
+
+    void SceneQueryBatch::_RunOverlap(size_t index)
+    {
+        const OverlapQuery& query = _overlaps[index];
+        std::vector<JPH::BodyID>& bodies = _overlapBodies[index];
+        bodies.clear();
+
+        const JPH::PhysicsSystem& physicsSystem = Physics::Get().physics_system;
+        LayerMaskFilter layerFilter(query.layerMask);
+        IgnoreEntityFilter bodyFilter(query.ignoredEntity);
+
+        WithShape(query.shape,
+                  [&](const JPH::Shape& shape)
+                  {
+                      JPH::CollideShapeSettings settings;
+                      BodyCollector collector(bodies);
+                      physicsSystem.GetNarrowPhaseQuery().CollideShape(
+                          &shape,
+                          JPH::Vec3::sOne(),
+                          JPH::RMat44::sRotationTranslation(query.rotation, query.position),
+                          settings,
+                          query.position,
+                          collector,
+                          JPH::BroadPhaseLayerFilter(),
+                          layerFilter,
+                          bodyFilter);
+                  });
+
+        // A body touched by several of its sub shapes is reported once per sub shape
+        std::sort(bodies.begin(), bodies.end());
+        bodies.erase(std::unique(bodies.begin(), bodies.end()), bodies.end());
+    }
+
+    void SceneQueryBatch::_ResolveGameObjects(Scene& scene)
+    {
+        auto resolve = [&](QueryHit& hit)
+        {
+            hit.gameObject = hit.hasHit ? GameObject(Physics::GetEntityID(hit.bodyId), &scene) : GameObject();
+        };
+        std::ranges::for_each(_raycastHits, resolve);
+        std::ranges::for_each(_shapeCastHits, resolve);
+
+        for (size_t index = 0; index < _overlaps.size(); ++index)
+        {
+            _overlapHits[index].clear();
+            for (const JPH::BodyID& bodyId : _overlapBodies[index])
+            {
+                _overlapHits[index].emplace_back(Physics::GetEntityID(bodyId), &scene);
+            }
+        }
+    }
+} // namespace Frost
@@ -0,0 +1,131 @@
+#pragma once
+
+#include "Frost/Core/Core.h"
+#include "Frost/Scene/ECS/GameObject.h"
+
+#include <Jolt/Jolt.h>
+#include <Jolt/Physics/Body/BodyID.h>
+#include <Jolt/Physics/Collision/ObjectLayer.h>
+
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace Frost
+{
+    class Scene;
+
+    // Bit i accepts the object layer i, layers from 64 on are never hit
+    using PhysicsLayerMask = uint64_t;
+    inline constexpr PhysicsLayerMask ALL_PHYSICS_LAYERS = ~PhysicsLayerMask(0);
+
+    constexpr PhysicsLayerMask PhysicsLayerBit(JPH::ObjectLayer layer)
+    {
+        return layer < 64 ? PhysicsLayerMask(1) << layer : 0;
+    }
+
+    // Shape swept or tested by a query, built on the stack when the query runs
+    struct QueryShape
+    {
+        enum class Type
+        {
+            Sphere,
+            Box
+        };
+
+        Type type = Type::Sphere;
+        float radius = 0.5f;
+        JPH::Vec3 halfExtent = JPH::Vec3::sReplicate(0.5f);
+
+        static QueryShape Sphere(float radius) { return { .type = Type::Sphere, .radius = radius }; }
+        static QueryShape Box(JPH::Vec3 halfExtent) { return { .type = Type::Box, .halfExtent = halfExtent }; }
+    };
+
+    struct RaycastQuery
+    {
+        JPH::RVec3 origin = JPH::RVec3::sZero();
+        // The length is the distance covered
+        JPH::Vec3 direction = JPH::Vec3::sZero();
+        PhysicsLayerMask layerMask = ALL_PHYSICS_LAYERS;
+        entt::entity ignoredEntity = entt::null;
+    };
+
+    struct ShapeCastQuery
+    {
+        QueryShape shape;
+        JPH::RVec3 position = JPH::RVec3::sZero();
+        JPH::Quat rotation = JPH::Quat::sIdentity();
+        // The length is the distance covered
+        JPH::Vec3 direction = JPH::Vec3::sZero();
+        PhysicsLayerMask layerMask = ALL_PHYSICS_LAYERS;
+        entt::entity ignoredEntity = entt::null;
+    };
+
+    struct OverlapQuery
+    {
+        QueryShape shape;
+        JPH::RVec3 position = JPH::RVec3::sZero();
+        JPH::Quat rotation = JPH::Quat::sIdentity();
+        PhysicsLayerMask layerMask = ALL_PHYSICS_LAYERS;
+        entt::entity ignoredEntity = entt::null;
+    };
+
+    // Closest hit of a raycast or a shape cast
+    struct QueryHit
+    {
+        bool hasHit = false;
+        GameObject gameObject;
+        JPH::BodyID bodyId;
+        // Part of the direction covered before the hit
+        float fraction = 1.0f;
+        JPH::RVec3 position = JPH::RVec3::sZero();
+        JPH::Vec3 normal = JPH::Vec3::sZero();
+    };
+
+    // Queries gathered during a tick and run together on the physics job system. Add returns the index of the result,
+    // results are valid after Execute until the next Clear.
+    //
+    // Results are mapped to the game objects of the scene passed to Execute. The batch keeps its memory across
+    // Clear, so a batch reused every tick does not allocate once warmed up.
+    class FROST_API SceneQueryBatch
+    {
+    public:
+        uint32_t AddRaycast(const RaycastQuery& query);
+        uint32_t AddShapeCast(const ShapeCastQuery& query);
+        uint32_t AddOverlap(const OverlapQuery& query);
+
+        void Execute(Scene& scene);
+        void Clear();
+
+        const QueryHit& GetRaycastHit(uint32_t index) const { return _raycastHits[index]; }
+        const QueryHit& GetShapeCastHit(uint32_t index) const { return _shapeCastHits[index]; }
+        // Each body is listed once
+        std::span<const GameObject> GetOverlaps(uint32_t index) const { return _overlapHits[index]; }
+
+        size_t GetQueryCount() const { return _raycasts.size() + _shapeCasts.size() + _overlaps.size(); }
+
+    private:
+        void _RunQuery(size_t index);
+        void _RunRaycast(size_t index);
+        void _RunShapeCast(size_t index);
+        void _RunOverlap(size_t index);
+
+        // Mapped on the calling thread once the jobs are done
+        void _ResolveGameObjects(Scene& scene);
+
+    private:
+        std::vector<RaycastQuery> _raycasts;
+        std::vector<ShapeCastQuery> _shapeCasts;
+        std::vector<OverlapQuery> _overlaps;
+
+        std::vector<QueryHit> _raycastHits;
+        std::vector<QueryHit> _shapeCastHits;
+        // Only grow, so that the lists of every overlap keep their capacity
+        std::vector<std::vector<JPH::BodyID>> _overlapBodies;
+        std::vector<std::vector<GameObject>> _overlapHits;
+
+        // Below this many queries, they run on the calling thread
+        static constexpr size_t MIN_PARALLEL_QUERIES = 16;
+        static constexpr size_t QUERIES_PER_JOB = 8;
+    };
+} // namespace Frost
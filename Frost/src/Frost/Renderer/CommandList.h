@@ -25,7 +25,8 @@ namespace Frost
     {
         None,
         ReadWrite,
-        ReadOnly
+        ReadOnly,
+        WriteOnly // Writes without testing, to overwrite a region of a depth buffer
     };
 
     enum class RasterizerMode
@@ -40,6 +41,8 @@ namespace Frost
     class CommandList
     {
     public:
+        static constexpr uint32_t CONSTANT_BUFFER_RANGE_ALIGNMENT = 256;
+
         virtual ~CommandList() = default;
 
         virtual void BeginRecording() = 0;
@@ -68,11 +71,14 @@ namespace Frost
         virtual void SetVertexBuffer(const Buffer* buffer, uint32_t stride, uint32_t offset) = 0;
         virtual void SetIndexBuffer(const Buffer* buffer, uint32_t offset) = 0;
         virtual void SetConstantBuffer(const Buffer* buffer, uint32_t slot) = 0;
+        // Binds size bytes starting at offset, offset is a multiple of CONSTANT_BUFFER_RANGE_ALIGNMENT
+        virtual void SetConstantBufferRange(const Buffer* buffer, uint32_t slot, uint32_t offset, uint32_t size) = 0;
         virtual void SetTexture(const Texture* texture, uint32_t slot) = 0;
         virtual void SetSampler(const Sampler* sampler, uint32_t slot) = 0;
 
         virtual void SetPrimitiveTopology(PrimitiveTopology topology) = 0;
         virtual void CopyResource(Texture* destination, Texture* source) = 0;
+        virtual void CopyTextureRegion(Texture* destination, uint32_t destX, uint32_t destY, Texture* source) = 0;
 
         virtual void Draw(uint32_t vertexCount, uint32_t startVertexLocation) = 0;
         virtual void DrawIndexed(uint32_t indexCount, uint32_t startIndexLocation, uint32_t baseVertexLocation) = 0;
@@ -0,0 +1,58 @@
+#include "Frost/Renderer/ConstantBufferArena.h"
+#include "Frost/Debugging/Assert.h"
+#include "Frost/Renderer/Buffer.h"
+#include "Frost/Renderer/CommandList.h"
+#include "Frost/Renderer/Renderer.h"
+#include "Frost/Renderer/RendererAPI.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace Frost
+{
+    ConstantBufferArena::ConstantBufferArena(const char* debugName) : _debugName(debugName) {}
+
+    void ConstantBufferArena::Reset()
+    {
+        _staging.clear();
+    }
+
+    uint32_t ConstantBufferArena::Push(const void* data, uint32_t size)
+    {
+        FT_ENGINE_ASSERT(size > 0, "ConstantBufferArena: pushing empty constants");
+
+        constexpr uint32_t alignment = CommandList::CONSTANT_BUFFER_RANGE_ALIGNMENT;
+        uint32_t offset = static_cast<uint32_t>(_staging.size());
+        uint32_t alignedSize = (size + alignment - 1) / alignment * alignment;
+
+        _staging.resize(offset + alignedSize);
+        std::memcpy(_staging.data() + offset, data, size);
+        return offset;
+    }
+
+    void ConstantBufferArena::Upload(CommandList* commandList)
+    {
+        if (_staging.empty())
+        {
+            return;
+        }
+
+        uint32_t size = static_cast<uint32_t>(_staging.size());
+        if (!_buffer || _buffer->GetSize() < size)
+        {
+            // Doubled so that a growing scene settles after a few frames
+            uint32_t capacity = std::max(size, _buffer ? _buffer->GetSize() * 2 : 0u);
+            _buffer = RendererAPI::GetRenderer()->CreateBuffer(BufferConfig{
+                .usage = BufferUsage::CONSTANT_BUFFER, .size = capacity, .dynamic = true, .debugName = _debugName });
+        }
+
+        _buffer->UpdateData(commandList, _staging.data(), size);
+    }
+
+    void ConstantBufferArena::Release()
+    {
+        _buffer.reset();
+        _staging.clear();
+        _staging.shrink_to_fit();
+    }
+} // namespace Frost
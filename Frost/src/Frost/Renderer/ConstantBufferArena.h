@@ -0,0 +1,41 @@
+#pragma once
+
+#include "Frost/Core/Core.h"
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace Frost
+{
+    class Buffer;
+    class CommandList;
+
+    // Packs the constants of many draws into one dynamic constant buffer, uploaded with a single map. Each draw then
+    // binds its own range with CommandList::SetConstantBufferRange.
+    //
+    // Reset, Push every draw, Upload, then bind. The upload discards the previous contents, the driver keeps the
+    // earlier versions alive for the GPU, so the arena can be refilled several times per frame.
+    class FROST_API ConstantBufferArena
+    {
+    public:
+        explicit ConstantBufferArena(const char* debugName);
+
+        void Reset();
+        // Copies the constants and returns their offset in the buffer
+        uint32_t Push(const void* data, uint32_t size);
+        // Grows the buffer if needed and copies everything pushed since Reset
+        void Upload(CommandList* commandList);
+
+        void Release();
+
+        const Buffer* GetBuffer() const { return _buffer.get(); }
+        uint32_t GetUsedSize() const { return static_cast<uint32_t>(_staging.size()); }
+
+    private:
+        const char* _debugName;
+        // Kept across frames, only grows
+        std::vector<uint8_t> _staging;
+        std::shared_ptr<Buffer> _buffer;
+    };
+} // namespace Frost
@@ -261,6 +261,30 @@ namespace Frost
         _context->DSSetConstantBuffers(slot, 1, pBuffers);
     }
 
+    void CommandListDX11::SetConstantBufferRange(const Buffer* buffer, uint32_t slot, uint32_t offset, uint32_t size)
+    {
+        FT_ENGINE_ASSERT(buffer, "Constant buffer cannot be null.");
+        FT_ENGINE_ASSERT(offset % CONSTANT_BUFFER_RANGE_ALIGNMENT == 0,
+                         "Constant buffer offset {} is not aligned to {} bytes.",
+                         offset,
+                         CONSTANT_BUFFER_RANGE_ALIGNMENT);
+
+        ID3D11Buffer* d3dBuffer = static_cast<const BufferDX11*>(buffer)->GetD3D11Buffer();
+
+        ID3D11Buffer* const pBuffers[] = { d3dBuffer };
+
+        // Counted in 16 byte constants, the count has to be a multiple of 16 too
+        const UINT firstConstant[] = { offset / 16 };
+        const UINT blockCount = (size + CONSTANT_BUFFER_RANGE_ALIGNMENT - 1) / CONSTANT_BUFFER_RANGE_ALIGNMENT;
+        const UINT constantCount[] = { blockCount * 16 };
+
+        _context->VSSetConstantBuffers1(slot, 1, pBuffers, firstConstant, constantCount);
+        _context->PSSetConstantBuffers1(slot, 1, pBuffers, firstConstant, constantCount);
+        _context->GSSetConstantBuffers1(slot, 1, pBuffers, firstConstant, constantCount);
+        _context->HSSetConstantBuffers1(slot, 1, pBuffers, firstConstant, constantCount);
+        _context->DSSetConstantBuffers1(slot, 1, pBuffers, firstConstant, constantCount);
+    }
+
     void CommandListDX11::SetTexture(const Texture* texture, uint32_t slot)
     {
         ID3D11ShaderResourceView* srv = nullptr;
@@ -327,6 +351,25 @@ namespace Frost
         }
     }
 
+    void CommandListDX11::CopyTextureRegion(Texture* destination, uint32_t destX, uint32_t destY, Texture* source)
+    {
+        auto* destDX11 = static_cast<TextureDX11*>(destination);
+        auto* srcDX11 = static_cast<TextureDX11*>(source);
+
+        if (!destDX11 || !srcDX11)
+        {
+            return;
+        }
+
+        ID3D11Resource* pDstResource = destDX11->GetDX11Texture();
+        ID3D11Resource* pSrcResource = srcDX11->GetDX11Texture();
+
+        if (pDstResource && pSrcResource)
+        {
+            _context->CopySubresourceRegion(pDstResource, 0, destX, destY, 0, pSrcResource, 0, nullptr);
+        }
+    }
+
     void CommandListDX11::Draw(uint32_t vertexCount, uint32_t startVertexLocation)
     {
         _context->Draw(vertexCount, startVertexLocation);
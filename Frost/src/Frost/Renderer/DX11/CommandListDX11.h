@@ -40,12 +40,14 @@ namespace Frost
         void SetVertexBuffer(const Buffer* buffer, uint32_t stride, uint32_t offset) override;
         void SetIndexBuffer(const Buffer* buffer, uint32_t offset) override;
         void SetConstantBuffer(const Buffer* buffer, uint32_t slot) override;
+        void SetConstantBufferRange(const Buffer* buffer, uint32_t slot, uint32_t offset, uint32_t size) override;
         void SetTexture(const Texture* texture, uint32_t slot) override;
         void SetSampler(const Sampler* sampler, uint32_t slot) override;
 
         void SetPrimitiveTopology(PrimitiveTopology topology) override;
 
         void CopyResource(Texture* destination, Texture* source) override;
+        void CopyTextureRegion(Texture* destination, uint32_t destX, uint32_t destY, Texture* source) override;
 
         void Draw(uint32_t vertexCount, uint32_t startVertexLocation) override;
         void DrawIndexed(uint32_t indexCount, uint32_t startIndexLocation, uint32_t baseVertexLocation) override;
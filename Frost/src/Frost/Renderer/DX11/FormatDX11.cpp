@@ -34,6 +34,10 @@ namespace Frost
                 return DXGI_FORMAT_R32_FLOAT;
             case Format::R24G8_TYPELESS:
                 return DXGI_FORMAT_R24G8_TYPELESS;
+            case Format::RGBA8_SNORM:
+                return DXGI_FORMAT_R8G8B8A8_SNORM;
+            case Format::RG16_FLOAT:
+                return DXGI_FORMAT_R16G16_FLOAT;
             default:
                 FT_ENGINE_ASSERT(false, "Unsupported format specified: {}", static_cast<int>(format));
                 return DXGI_FORMAT_UNKNOWN;
@@ -70,6 +74,10 @@ namespace Frost
                 return 4;
             case Format::R24G8_TYPELESS:
                 return 4;
+            case Format::RGBA8_SNORM:
+                return 4;
+            case Format::RG16_FLOAT:
+                return 4;
             default:
                 FT_ENGINE_ASSERT(false, "Unsupported format specified");
                 return 0;
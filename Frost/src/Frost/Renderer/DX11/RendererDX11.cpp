@@ -8,6 +8,7 @@
 
 #include <array>
 #include <dxgi1_6.h>
+#include <filesystem>
 
 #ifdef FT_DEBUG
 #include <d3d11sdklayers.h>
@@ -29,6 +30,7 @@ namespace Frost
         _CreateDepthStencilStates();
         _CreateRasterizerStates();
         _CreateBlendStates();
+        _CreateShaderCache();
 
         _immediateContext->RSSetState(_solidRasterizerState.Get());
 
@@ -53,6 +55,9 @@ namespace Frost
     {
         FT_ENGINE_INFO("RendererDX11: destroying...");
 
+        // Keeps the shaders that were first compiled on demand, material shaders for instance
+        _shaderCache->Save();
+
         _backBufferTexture.reset();
         _depthBufferTexture.reset();
 
@@ -79,6 +84,7 @@ namespace Frost
         _depthStateReadWrite.Reset();
         _depthStateReadOnly.Reset();
         _depthStateNone.Reset();
+        _depthStateWriteOnly.Reset();
         _blendStateAlpha.Reset();
 
         _immediateContext.Reset();
@@ -348,6 +354,11 @@ namespace Frost
         hr = _device->CreateDepthStencilState(&depthStencilDesc, &_depthStateReadOnly);
         FT_ENGINE_ASSERT(SUCCEEDED(hr), "Failed to create ReadOnly depth stencil state!");
 
+        depthStencilDesc.DepthWriteMask = D3D11_DEPTH_WRITE_MASK_ALL;
+        depthStencilDesc.DepthFunc = D3D11_COMPARISON_ALWAYS;
+        hr = _device->CreateDepthStencilState(&depthStencilDesc, &_depthStateWriteOnly);
+        FT_ENGINE_ASSERT(SUCCEEDED(hr), "Failed to create WriteOnly depth stencil state!");
+
         depthStencilDesc.DepthEnable = FALSE;
         hr = _device->CreateDepthStencilState(&depthStencilDesc, &_depthStateNone);
         FT_ENGINE_ASSERT(SUCCEEDED(hr), "Failed to create None depth stencil state!");
@@ -412,6 +423,26 @@ namespace Frost
         FT_ENGINE_ASSERT(SUCCEEDED(hr), "Failed to create alpha blend state!");
     }
 
+    void RendererDX11::_CreateShaderCache()
+    {
+        _shaderCache = std::make_unique<ShaderCache>(_shaderCompiler, SHADER_CACHE_PATH);
+        _shaderCache->Load();
+
+        // Engine shaders and everything compiled in a previous session are built up front, in parallel, instead
+        // of one by one on the main thread as pipelines get created
+        std::vector<ShaderDesc> shaders = ShaderCache::GatherShaders(ENGINE_SHADER_DIRECTORY);
+        for (auto& shader : _shaderCache->GetKnownShaders())
+        {
+            if (std::filesystem::exists(shader.filePath))
+            {
+                shaders.push_back(std::move(shader));
+            }
+        }
+
+        _shaderCache->Prewarm(shaders);
+        _shaderCache->Save();
+    }
+
     Microsoft::WRL::ComPtr<IDXGIAdapter1> RendererDX11::_GetBestAdapter()
     {
         ComPtr<IDXGIFactory1> factory;
@@ -461,6 +492,8 @@ namespace Frost
                 return _depthStateReadOnly.Get();
             case DepthMode::None:
                 return _depthStateNone.Get();
+            case DepthMode::WriteOnly:
+                return _depthStateWriteOnly.Get();
             case DepthMode::ReadWrite:
             default:
                 return _depthStateReadWrite.Get();
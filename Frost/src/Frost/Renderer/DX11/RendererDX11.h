@@ -1,6 +1,8 @@
 #pragma once
 
+#include "Frost/Renderer/DX11/ShaderCompilerDX11.h"
 #include "Frost/Renderer/DX11/TextureDX11.h"
+#include "Frost/Renderer/ShaderCache.h"
 #include "Frost/Renderer/Renderer.h"
 
 #include <d3d11_1.h>
@@ -31,6 +33,7 @@ namespace Frost
         ID3D11RasterizerState* GetWireframeRasterizerState() const { return _wireframeRasterizerState.Get(); }
         ID3D11RasterizerState* GetCullNoneRasterizerState() const { return _cullNoneRasterizerState.Get(); }
         ID3D11RasterizerState* GetCullBackRasterizerState() const { return _cullBackRasterizerState.Get(); }
+        ShaderCache& GetShaderCache() { return *_shaderCache; }
         ID3D11BlendState* GetBlendState(BlendMode mode) const;
         ID3D11DepthStencilState* GetDepthStencilState(DepthMode mode) const;
 
@@ -50,9 +53,12 @@ namespace Frost
         Microsoft::WRL::ComPtr<ID3D11DepthStencilState> _depthStateReadWrite;
         Microsoft::WRL::ComPtr<ID3D11DepthStencilState> _depthStateReadOnly;
         Microsoft::WRL::ComPtr<ID3D11DepthStencilState> _depthStateNone;
+        Microsoft::WRL::ComPtr<ID3D11DepthStencilState> _depthStateWriteOnly;
         Microsoft::WRL::ComPtr<ID3D11BlendState> _blendStateAlpha;
         std::unique_ptr<TextureDX11> _backBufferTexture;
         std::unique_ptr<TextureDX11> _depthBufferTexture;
+        ShaderCompilerDX11 _shaderCompiler;
+        std::unique_ptr<ShaderCache> _shaderCache;
 
     private:
         void _CreateDevice();
@@ -61,7 +67,11 @@ namespace Frost
         void _CreateDepthStencilStates();
         void _CreateRasterizerStates();
         void _CreateBlendStates();
+        void _CreateShaderCache();
 
         Microsoft::WRL::ComPtr<IDXGIAdapter1> _GetBestAdapter();
+
+        static constexpr const char* SHADER_CACHE_PATH = ".frost/shaders.cache";
+        static constexpr const char* ENGINE_SHADER_DIRECTORY = "../Frost/resources/shaders";
     };
 } // namespace Frost
\ No newline at end of file
@@ -0,0 +1,101 @@
+#include "Frost/Renderer/DX11/ShaderCompilerDX11.h"
+#include "Frost/Debugging/Assert.h"
+#include "Frost/Renderer/DX11/ShaderIncludeDX11.h"
+
+#include <d3dcompiler.h>
+#include <filesystem>
+#include <format>
+#include <wrl/client.h>
+
+namespace Frost
+{
+    ShaderCompilerDX11::ShaderCompilerDX11() : _flags(D3DCOMPILE_ENABLE_STRICTNESS | D3DCOMPILE_OPTIMIZATION_LEVEL3)
+    {
+#ifdef FT_DEBUG
+        // Debug info is kept for graphics debuggers, but the cache makes optimized builds affordable
+        _flags |= D3DCOMPILE_DEBUG | D3DCOMPILE_WARNINGS_ARE_ERRORS;
+#endif
+    }
+
+    ShaderCompiler::Result ShaderCompilerDX11::Compile(const ShaderDesc& desc) const
+    {
+        Result result;
+
+        std::filesystem::path shaderPath(desc.filePath);
+        if (!std::filesystem::exists(shaderPath))
+        {
+            result.log = "Shader file not found: " + std::filesystem::absolute(shaderPath).string() +
+                         "\nCurrent Working Directory: " + std::filesystem::current_path().string();
+            return result;
+        }
+
+        std::vector<D3D_SHADER_MACRO> macros;
+        macros.reserve(desc.defines.size() + 1);
+        for (const auto& [name, value] : desc.defines)
+        {
+            macros.push_back({ name.c_str(), value.c_str() });
+        }
+        macros.push_back({ nullptr, nullptr });
+
+        ShaderIncludeDX11 includeHandler(shaderPath.parent_path().string());
+        std::string profile = GetProfile(desc.type);
+
+        Microsoft::WRL::ComPtr<ID3DBlob> blob;
+        Microsoft::WRL::ComPtr<ID3DBlob> errorBlob;
+
+        HRESULT hr = D3DCompileFromFile(shaderPath.wstring().c_str(),
+                                        macros.data(),
+                                        &includeHandler,
+                                        desc.entryPoint.c_str(),
+                                        profile.c_str(),
+                                        _flags,
+                                        0,
+                                        &blob,
+                                        &errorBlob);
+
+        if (errorBlob)
+        {
+            result.log.assign(static_cast<const char*>(errorBlob->GetBufferPointer()), errorBlob->GetBufferSize());
+        }
+
+        if (FAILED(hr))
+        {
+            if (!errorBlob)
+            {
+                result.log = std::format("Failed to find or read shader file. HRESULT: 0x{:x}", hr);
+            }
+            return result;
+        }
+
+        const char* bytecode = static_cast<const char*>(blob->GetBufferPointer());
+        result.bytecode.assign(bytecode, bytecode + blob->GetBufferSize());
+        result.success = true;
+        return result;
+    }
+
+    std::string ShaderCompilerDX11::GetProfile(ShaderType type) const
+    {
+        switch (type)
+        {
+            case ShaderType::Compute:
+                return "cs_5_0";
+            case ShaderType::Domain:
+                return "ds_5_0";
+            case ShaderType::Geometry:
+                return "gs_5_0";
+            case ShaderType::Hull:
+                return "hs_5_0";
+            case ShaderType::Pixel:
+                return "ps_5_0";
+            case ShaderType::Vertex:
+                return "vs_5_0";
+        }
+        FT_ENGINE_ASSERT(false, "Unknown shader type!");
+        return "";
+    }
+
+    uint64_t ShaderCompilerDX11::GetConfigurationHash() const
+    {
+        return (static_cast<uint64_t>(D3D_COMPILER_VERSION) << 32) | _flags;
+    }
+} // namespace Frost
@@ -0,0 +1,20 @@
+#pragma once
+
+#include "Frost/Renderer/ShaderCompiler.h"
+
+namespace Frost
+{
+    class ShaderCompilerDX11 : public ShaderCompiler
+    {
+    public:
+        ShaderCompilerDX11();
+
+        Result Compile(const ShaderDesc& desc) const override;
+
+        std::string GetProfile(ShaderType type) const override;
+        uint64_t GetConfigurationHash() const override;
+
+    private:
+        unsigned int _flags;
+    };
+} // namespace Frost
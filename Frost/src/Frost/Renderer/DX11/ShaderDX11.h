@@ -18,7 +18,7 @@ namespace Frost
         ID3D11DeviceChild* GetShaderObject() const;
 
     private:
-        Microsoft::WRL::ComPtr<ID3DBlob> _blob;
+        std::vector<char> _bytecode;
         Microsoft::WRL::ComPtr<ID3D11DeviceChild> _shader;
     };
 } // namespace Frost
\ No newline at end of file
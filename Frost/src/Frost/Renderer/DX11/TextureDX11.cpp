@@ -4,6 +4,8 @@
 #include "Frost/Debugging/Logger.h"
 #include "Frost/Renderer/DX11/RendererDX11.h"
 #include "Frost/Renderer/RendererAPI.h"
+#include "Frost/Renderer/TextureStreamer.h"
+#include "Frost/Renderer/TextureStreaming.h"
 
 #define STB_IMAGE_IMPLEMENTATION
 #include <stb_image.h>
@@ -12,6 +14,7 @@
 #include <stb_image_write.h>
 
 #include <assimp/texture.h>
+#include <algorithm>
 #include <filesystem>
 
 namespace Frost
@@ -258,6 +261,26 @@ namespace Frost
             SetStatus(AssetStatus::Loading);
             stbi_image_free(data);
         }
+
+        _config.streamMips = _config.streamMips && _CanStream();
+        if (_config.streamMips)
+        {
+            // Only the resident mips go to the GPU for now
+            _residentMip = TextureStreaming::GetMipForSize(
+                _config.width, _config.height, TextureStreamer::GetSettings().residentSize);
+            _topMip = _residentMip;
+            _cpuData = TextureStreaming::Downsample(
+                _cpuData, _config.width, _config.height, GetFormatSize(_config.format), _residentMip);
+        }
+    }
+
+    bool TextureDX11::_CanStream() const
+    {
+        bool is8BitFormat = _config.format == Format::R8_UNORM || _config.format == Format::RG8_UNORM ||
+                            _config.format == Format::RGBA8_UNORM;
+        return is8BitFormat && _config.layout == TextureLayout::TEXTURE_2D && _config.hasMipmaps &&
+               _config.isShaderResource && !_config.isRenderTarget && !_config.path.empty() &&
+               _config.fileData.empty() && !_cpuData.empty();
     }
 
     bool TextureDX11::SaveToFile(const std::string& path) const
@@ -556,16 +579,26 @@ namespace Frost
         bool generateMips = _config.hasMipmaps && _config.isShaderResource && !_cpuData.empty();
         bool isDepth = IsDepthFormat(_config.format);
 
+        // A streamed texture starts at its resident mip
+        uint32_t width = std::max(_config.width >> _topMip, 1u);
+        uint32_t height = std::max(_config.height >> _topMip, 1u);
+
         D3D11_TEXTURE2D_DESC desc = {};
-        desc.Width = _config.width;
-        desc.Height = _config.height;
+        desc.Width = width;
+        desc.Height = height;
         desc.MipLevels = generateMips ? 0 : 1;
         desc.ArraySize = 1;
         desc.SampleDesc.Count = 1;
 
         desc.Format = dxgiFormat;
 
-        if (generateMips)
+        if (_config.isReadback)
+        {
+            desc.Usage = D3D11_USAGE_STAGING;
+            desc.CPUAccessFlags = D3D11_CPU_ACCESS_READ;
+            desc.BindFlags = 0;
+        }
+        else if (generateMips)
         {
             desc.Usage = D3D11_USAGE_DEFAULT;
             desc.BindFlags = D3D11_BIND_SHADER_RESOURCE | D3D11_BIND_RENDER_TARGET;
@@ -619,14 +652,14 @@ namespace Frost
             if (SUCCEEDED(hr) && !_cpuData.empty())
             {
                 context->UpdateSubresource(
-                    _texture.Get(), 0, nullptr, _cpuData.data(), _config.width * GetFormatSize(_config.format), 0);
+                    _texture.Get(), 0, nullptr, _cpuData.data(), width * GetFormatSize(_config.format), 0);
             }
         }
         else if (!_cpuData.empty())
         {
             D3D11_SUBRESOURCE_DATA initData = {};
             initData.pSysMem = _cpuData.data();
-            initData.SysMemPitch = _config.width * GetFormatSize(_config.format);
+            initData.SysMemPitch = width * GetFormatSize(_config.format);
             hr = device->CreateTexture2D(&desc, &initData, _texture.GetAddressOf());
         }
         else
@@ -711,6 +744,193 @@ namespace Frost
         _mmFile.reset();
     }
 
+    AssetMemory TextureDX11::GetMemoryUsage() const
+    {
+        AssetMemory memory;
+        memory.cpuBytes = _cpuData.capacity() + _config.fileData.capacity() + _dataCache.capacity();
+        memory.cpuBytes += GetDecodedImageSize();
+        for (const std::vector<uint8_t>& face : _cpuCubemapData)
+        {
+            memory.cpuBytes += face.capacity();
+        }
+
+        if (_texture)
+        {
+            D3D11_TEXTURE2D_DESC desc;
+            _texture->GetDesc(&desc);
+
+            const size_t bytesPerPixel = GetFormatSize(_config.format);
+            for (UINT mip = 0; mip < desc.MipLevels; ++mip)
+            {
+                size_t width = std::max<size_t>(desc.Width >> mip, 1);
+                size_t height = std::max<size_t>(desc.Height >> mip, 1);
+                memory.gpuBytes += width * height * bytesPerPixel * desc.ArraySize;
+            }
+        }
+
+        return memory;
+    }
+
+    std::vector<uint8_t> TextureDX11::LoadMipCPU(uint32_t mip) const
+    {
+        uint32_t bytesPerPixel = GetFormatSize(_config.format);
+
+        std::shared_ptr<const std::vector<uint8_t>> image;
+        {
+            std::lock_guard lock(_decodedImageMutex);
+            image = _decodedImage;
+        }
+
+        if (image)
+        {
+            return TextureStreaming::Downsample(*image, _config.width, _config.height, bytesPerPixel, mip);
+        }
+
+        MemoryMappedFile file(_config.path);
+        if (!file.IsValid())
+        {
+            FT_ENGINE_ERROR("TextureDX11: Failed to memory map file for mip streaming: {}", _config.path);
+            return {};
+        }
+
+        int width = 0, height = 0, channels = 0;
+        stbi_uc* data = stbi_load_from_memory(reinterpret_cast<const stbi_uc*>(file.GetData()),
+                                              static_cast<int>(file.GetSize()),
+                                              &width,
+                                              &height,
+                                              &channels,
+                                              static_cast<int>(bytesPerPixel));
+        if (!data)
+        {
+            FT_ENGINE_ERROR("TextureDX11: Failed to decode {} for mip streaming", _config.path);
+            return {};
+        }
+
+        if (static_cast<uint32_t>(width) != _config.width || static_cast<uint32_t>(height) != _config.height)
+        {
+            FT_ENGINE_ERROR("TextureDX11: {} changed size since it was loaded, its mips are not streamed",
+                            _config.path);
+            stbi_image_free(data);
+            return {};
+        }
+
+        image = std::make_shared<const std::vector<uint8_t>>(
+            data, data + size_t{ _config.width } * _config.height * bytesPerPixel);
+        stbi_image_free(data);
+
+        {
+            std::lock_guard lock(_decodedImageMutex);
+            _decodedImage = image;
+        }
+
+        return TextureStreaming::Downsample(*image, _config.width, _config.height, bytesPerPixel, mip);
+    }
+
+    size_t TextureDX11::GetDecodedImageSize() const
+    {
+        std::lock_guard lock(_decodedImageMutex);
+        return _decodedImage ? _decodedImage->size() : 0;
+    }
+
+    void TextureDX11::ReleaseDecodedImage()
+    {
+        std::lock_guard lock(_decodedImageMutex);
+        _decodedImage.reset();
+    }
+
+    bool TextureDX11::_CreateStreamedChain(uint32_t mip,
+                                           Microsoft::WRL::ComPtr<ID3D11Texture2D>& texture,
+                                           Microsoft::WRL::ComPtr<ID3D11ShaderResourceView>& srv) const
+    {
+        ID3D11Device* device = static_cast<RendererDX11*>(RendererAPI::GetRenderer())->GetDevice();
+
+        D3D11_TEXTURE2D_DESC desc = {};
+        desc.Width = std::max(_config.width >> mip, 1u);
+        desc.Height = std::max(_config.height >> mip, 1u);
+        desc.MipLevels = 0;
+        desc.ArraySize = 1;
+        desc.SampleDesc.Count = 1;
+        desc.Format = ToDXGIFormat(_config.format);
+        desc.Usage = D3D11_USAGE_DEFAULT;
+        desc.BindFlags = D3D11_BIND_SHADER_RESOURCE | D3D11_BIND_RENDER_TARGET;
+        desc.MiscFlags = D3D11_RESOURCE_MISC_GENERATE_MIPS;
+
+        if (FAILED(device->CreateTexture2D(&desc, nullptr, texture.GetAddressOf())))
+        {
+            FT_ENGINE_ERROR("Failed to create the streamed mips of {}", _config.debugName);
+            return false;
+        }
+
+        D3D11_SHADER_RESOURCE_VIEW_DESC srvDesc = {};
+        srvDesc.Format = desc.Format;
+        srvDesc.ViewDimension = D3D11_SRV_DIMENSION_TEXTURE2D;
+        srvDesc.Texture2D.MipLevels = -1;
+        srvDesc.Texture2D.MostDetailedMip = 0;
+
+        if (FAILED(device->CreateShaderResourceView(texture.Get(), &srvDesc, srv.GetAddressOf())))
+        {
+            FT_ENGINE_ERROR("Failed to create the SRV of the streamed mips of {}", _config.debugName);
+            return false;
+        }
+
+        return true;
+    }
+
+    void TextureDX11::UploadMipGPU(uint32_t mip, std::span<const uint8_t> pixels)
+    {
+        uint32_t pitch = std::max(_config.width >> mip, 1u) * GetFormatSize(_config.format);
+        if (!IsLoaded() || pixels.size() < size_t{ pitch } * std::max(_config.height >> mip, 1u))
+        {
+            return;
+        }
+
+        Microsoft::WRL::ComPtr<ID3D11Texture2D> texture;
+        Microsoft::WRL::ComPtr<ID3D11ShaderResourceView> srv;
+        if (!_CreateStreamedChain(mip, texture, srv))
+        {
+            return;
+        }
+
+        // The coarser mips are generated again from the new first one rather than copied
+        ID3D11DeviceContext* context = static_cast<RendererDX11*>(RendererAPI::GetRenderer())->GetDeviceContext();
+        context->UpdateSubresource(texture.Get(), 0, nullptr, pixels.data(), pitch, 0);
+        context->GenerateMips(srv.Get());
+
+        _texture = texture;
+        _srv = srv;
+        _topMip = mip;
+    }
+
+    void TextureDX11::DropToMip(uint32_t mip)
+    {
+        if (!IsLoaded() || !_texture || mip <= _topMip)
+        {
+            return;
+        }
+
+        Microsoft::WRL::ComPtr<ID3D11Texture2D> texture;
+        Microsoft::WRL::ComPtr<ID3D11ShaderResourceView> srv;
+        if (!_CreateStreamedChain(mip, texture, srv))
+        {
+            return;
+        }
+
+        D3D11_TEXTURE2D_DESC desc;
+        texture->GetDesc(&desc);
+
+        // Both chains end at 1x1, so the new one is the tail of the current one
+        ID3D11DeviceContext* context = static_cast<RendererDX11*>(RendererAPI::GetRenderer())->GetDeviceContext();
+        for (UINT level = 0; level < desc.MipLevels; ++level)
+        {
+            context->CopySubresourceRegion(
+                texture.Get(), level, 0, 0, 0, _texture.Get(), level + mip - _topMip, nullptr);
+        }
+
+        _texture = texture;
+        _srv = srv;
+        _topMip = mip;
+    }
+
     void TextureDX11::Bind(Slot slot) const
     {
         if (!IsLoaded() || !_srv)
@@ -723,7 +943,8 @@ namespace Frost
     {
         if (!IsLoaded() || !_texture)
             return {};
-        if (_dataCached)
+        // Render targets are drawn to after creation, their content can't be cached
+        if (_dataCached && !_config.isRenderTarget)
             return _dataCache;
 
         RendererDX11* renderer = static_cast<RendererDX11*>(RendererAPI::GetRenderer());
@@ -766,8 +987,47 @@ namespace Frost
         }
 
         context->Unmap(stagingTexture.Get(), 0);
+
+        // Without keepReadback the copy is not kept, the texture already lives on the GPU
+        if (!_config.keepReadback || _config.isRenderTarget)
+        {
+            return std::move(_dataCache);
+        }
+
         _dataCached = true;
         return _dataCache;
     }
 
+    bool TextureDX11::TryReadPixels(std::vector<uint8_t>& outPixels) const
+    {
+        if (!_config.isReadback || !IsLoaded() || !_texture)
+            return false;
+
+        RendererDX11* renderer = static_cast<RendererDX11*>(RendererAPI::GetRenderer());
+        ID3D11DeviceContext* context = renderer->GetDeviceContext();
+
+        D3D11_MAPPED_SUBRESOURCE mappedResource;
+        HRESULT hr = context->Map(_texture.Get(), 0, D3D11_MAP_READ, D3D11_MAP_FLAG_DO_NOT_WAIT, &mappedResource);
+        if (FAILED(hr))
+            return false;
+
+        D3D11_TEXTURE2D_DESC desc;
+        _texture->GetDesc(&desc);
+
+        const uint32_t bytesPerRow = desc.Width * GetFormatSize(_config.format);
+        outPixels.resize(static_cast<size_t>(bytesPerRow) * desc.Height);
+
+        const uint8_t* src = static_cast<const uint8_t*>(mappedResource.pData);
+        uint8_t* dst = outPixels.data();
+        for (uint32_t y = 0; y < desc.Height; ++y)
+        {
+            std::memcpy(dst, src, bytesPerRow);
+            src += mappedResource.RowPitch;
+            dst += bytesPerRow;
+        }
+
+        context->Unmap(_texture.Get(), 0);
+        return true;
+    }
+
 } // namespace Frost
\ No newline at end of file
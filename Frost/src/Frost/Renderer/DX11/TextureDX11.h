@@ -5,6 +5,8 @@
 
 #include <d3d11.h>
 #include <wrl/client.h>
+#include <memory>
+#include <mutex>
 #include <vector>
 
 namespace Frost
@@ -32,6 +34,7 @@ namespace Frost
         virtual void Bind(Slot slot) const override;
         virtual void* GetRendererID() const override { return _srv.Get(); }
         virtual const std::vector<uint8_t> GetData() const override;
+        virtual bool TryReadPixels(std::vector<uint8_t>& outPixels) const override;
 
         // Get resources
         ID3D11Texture2D* GetDX11Texture() const { return _texture.Get(); }
@@ -41,9 +44,22 @@ namespace Frost
 
         virtual bool SaveToFile(const std::string& path) const override;
 
+        virtual AssetMemory GetMemoryUsage() const override;
+
+        virtual std::vector<uint8_t> LoadMipCPU(uint32_t mip) const override;
+        virtual size_t GetDecodedImageSize() const override;
+        virtual void ReleaseDecodedImage() override;
+        virtual void UploadMipGPU(uint32_t mip, std::span<const uint8_t> pixels) override;
+        virtual void DropToMip(uint32_t mip) override;
+
     private:
         void _CreateCubemapCPU();
         void _ReleaseCPUData();
+        bool _CanStream() const;
+        // Full chain from mip, that GenerateMips can fill from its first level
+        bool _CreateStreamedChain(uint32_t mip,
+                                  Microsoft::WRL::ComPtr<ID3D11Texture2D>& texture,
+                                  Microsoft::WRL::ComPtr<ID3D11ShaderResourceView>& srv) const;
 
         Microsoft::WRL::ComPtr<ID3D11Texture2D> _texture;
         Microsoft::WRL::ComPtr<ID3D11ShaderResourceView> _srv;
@@ -54,9 +70,12 @@ namespace Frost
         std::unique_ptr<MemoryMappedFile> _mmFile;
         std::vector<uint8_t> _cpuData;
         std::vector<std::vector<uint8_t>> _cpuCubemapData;
-
         // Cache
         mutable std::vector<uint8_t> _dataCache;
         mutable bool _dataCached = false;
+
+        // Full size image of a streamed texture, decoded by the first mip load and shared with the loads running
+        mutable std::shared_ptr<const std::vector<uint8_t>> _decodedImage;
+        mutable std::mutex _decodedImageMutex;
     };
 } // namespace Frost
\ No newline at end of file
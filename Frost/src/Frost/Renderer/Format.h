@@ -17,6 +17,8 @@ namespace Frost
         R11G11B10_FLOAT,
         R16_FLOAT,
         R32_FLOAT,
-        R24G8_TYPELESS
+        R24G8_TYPELESS,
+        RGBA8_SNORM,
+        RG16_FLOAT
     };
 }
\ No newline at end of file
@@ -4,6 +4,7 @@
 #include "Frost/Renderer/GPUResource.h"
 #include "Frost/Renderer/Renderer.h"
 #include "Frost/Renderer/Shader.h"
+#include "Frost/Renderer/Vertex.h"
 
 #include <cstdint>
 #include <string>
@@ -30,4 +31,27 @@ namespace Frost
         InputLayout(const VertexAttributeArray& attributes, const Shader& shader) {};
         virtual ~InputLayout() = default;
     };
+
+    // Attributes of the mesh vertex buffers, every layout binds the same semantics
+    inline InputLayout::VertexAttributeArray GetMeshVertexAttributes(VertexLayout layout)
+    {
+        if (layout == VertexLayout::Compact)
+        {
+            const uint32_t stride = sizeof(CompactVertex);
+            return {
+                { .name = "POSITION", .format = Format::RGB32_FLOAT, .offset = 0, .elementStride = stride },
+                { .name = "NORMAL", .format = Format::RGBA8_SNORM, .offset = 12, .elementStride = stride },
+                { .name = "TANGENT", .format = Format::RGBA8_SNORM, .offset = 16, .elementStride = stride },
+                { .name = "TEXCOORD", .format = Format::RG16_FLOAT, .offset = 20, .elementStride = stride },
+            };
+        }
+
+        const uint32_t stride = sizeof(Vertex);
+        return {
+            { .name = "POSITION", .format = Format::RGB32_FLOAT, .offset = 0, .elementStride = stride },
+            { .name = "NORMAL", .format = Format::RGB32_FLOAT, .offset = 12, .elementStride = stride },
+            { .name = "TEXCOORD", .format = Format::RG32_FLOAT, .offset = 24, .elementStride = stride },
+            { .name = "TANGENT", .format = Format::RGBA32_FLOAT, .offset = 32, .elementStride = stride },
+        };
+    }
 } // namespace Frost
\ No newline at end of file
@@ -0,0 +1,70 @@
+#include "Frost/Renderer/LodSelector.h"
+#include "Frost/Asset/Model.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace Frost
+{
+    float LodSelector::GetScreenSize(const BoundingBox& worldBounds,
+                                     const Component::Camera& camera,
+                                     const Math::Vector3& cameraPosition)
+    {
+        Math::Vector3 boundsMin = { worldBounds.min.x, worldBounds.min.y, worldBounds.min.z };
+        Math::Vector3 boundsMax = { worldBounds.max.x, worldBounds.max.y, worldBounds.max.z };
+        Math::Vector3 center = (boundsMin + boundsMax) * 0.5f;
+        float radius = Math::Length(boundsMax - boundsMin) * 0.5f;
+
+        if (camera.projectionType == Component::Camera::ProjectionType::Orthographic)
+        {
+            return 2.0f * radius / camera.orthographicSize;
+        }
+
+        float distance = std::max(Math::Length(center - cameraPosition), radius);
+        if (distance <= 0.0f)
+        {
+            return 0.0f;
+        }
+
+        return radius / (distance * std::tan(camera.perspectiveFOV.value() * 0.5f));
+    }
+
+    uint32_t LodSelector::Select(const Model& model,
+                                 float screenSize,
+                                 float viewportHeight,
+                                 uint32_t currentLod,
+                                 const LodSettings& settings)
+    {
+        uint32_t lodCount = model.GetLodCount();
+        if (lodCount <= 1)
+        {
+            return 0;
+        }
+
+        auto coarsestLod = [&](float size)
+        {
+            uint32_t lod = 0;
+            while (lod + 1 < lodCount && model.GetLodError(lod + 1) * size * viewportHeight <= settings.maxPixelError)
+            {
+                ++lod;
+            }
+            return lod;
+        };
+
+        // Coarser once the level would still do for a slightly larger instance, finer once the current one would
+        // not even do for a slightly smaller one
+        uint32_t coarser = coarsestLod(screenSize * (1.0f + settings.hysteresis));
+        if (coarser > currentLod)
+        {
+            return coarser;
+        }
+
+        uint32_t finer = coarsestLod(screenSize * (1.0f - settings.hysteresis));
+        if (finer < currentLod)
+        {
+            return finer;
+        }
+
+        return std::min(currentLod, lodCount - 1);
+    }
+} // namespace Frost
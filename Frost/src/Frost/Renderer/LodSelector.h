@@ -0,0 +1,43 @@
+#pragma once
+
+#include "Frost/Core/Core.h"
+#include "Frost/Renderer/BoundingBox.h"
+#include "Frost/Scene/Components/Camera.h"
+#include "Frost/Utils/Math/Vector.h"
+
+#include <cstdint>
+
+namespace Frost
+{
+    class Model;
+
+    struct LodSettings
+    {
+        // Largest simplification error accepted on screen, in pixels
+        float maxPixelError = 1.0f;
+        // Relative change of screen size past a threshold before switching, so an instance sitting on a threshold
+        // does not pop back and forth
+        float hysteresis = 0.1f;
+        // Levels added for the shadow passes, the shadow texels are larger than the screen pixels anyway
+        uint32_t shadowLodBias = 1;
+    };
+
+    // Picks the level of detail of an instance from the size of its bounding sphere on screen and the simplification
+    // error of each level of its model
+    class FROST_API LodSelector
+    {
+    public:
+        // Diameter of the bounding sphere over the viewport height, cameras inside the sphere see it at its largest
+        static float GetScreenSize(const BoundingBox& worldBounds,
+                                   const Component::Camera& camera,
+                                   const Math::Vector3& cameraPosition);
+
+        // The coarsest level whose error stays under settings.maxPixelError, currentLod is kept while the screen
+        // size is within the hysteresis of the thresholds around it
+        static uint32_t Select(const Model& model,
+                               float screenSize,
+                               float viewportHeight,
+                               uint32_t currentLod,
+                               const LodSettings& settings);
+    };
+} // namespace Frost
@@ -64,6 +64,6 @@ namespace Frost
 
         // If present, the render target of the camera will be used as albedo
         // texture
-        GameObject::Id cameraRef;
+        GameObject::Id cameraRef = entt::null;
     };
 } // namespace Frost
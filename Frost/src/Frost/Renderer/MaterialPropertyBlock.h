@@ -0,0 +1,41 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+namespace Frost
+{
+    // Custom shader parameters owned by one mesh instance instead of the shared material. When set, they replace
+    // Material::parameters of one material of the instance, the first one unless told otherwise. The payload is
+    // stored inline, so updating it every frame does not allocate.
+    class MaterialPropertyBlock
+    {
+    public:
+        static constexpr uint32_t MAX_SIZE = 256;
+
+        template<typename T>
+        void Set(const T& parameters, uint32_t materialIndex = 0)
+        {
+            static_assert(std::is_trivially_copyable_v<T>, "Material parameters are copied bytewise");
+            static_assert(sizeof(T) <= MAX_SIZE, "Material parameters do not fit in a property block");
+
+            std::memcpy(_data.data(), &parameters, sizeof(T));
+            _size = sizeof(T);
+            _materialIndex = materialIndex;
+        }
+
+        void Clear() { _size = 0; }
+
+        bool IsEmpty() const { return _size == 0; }
+        const uint8_t* GetData() const { return _data.data(); }
+        uint32_t GetSize() const { return _size; }
+        uint32_t GetMaterialIndex() const { return _materialIndex; }
+
+    private:
+        alignas(16) std::array<uint8_t, MAX_SIZE> _data{};
+        uint32_t _size = 0;
+        uint32_t _materialIndex = 0;
+    };
+} // namespace Frost
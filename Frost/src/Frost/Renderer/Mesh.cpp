@@ -3,10 +3,22 @@
 #include "Frost/Debugging/Assert.h"
 #include "Frost/Renderer/RendererAPI.h"
 
+#include <limits>
+#include <vector>
+
 namespace Frost
 {
-    Mesh::Mesh(std::span<const std::byte> vertices, uint32_t vertexStride, std::span<const uint32_t> indices) :
-        _vertexStride(vertexStride), _indexCount(static_cast<uint32_t>(indices.size())), _materialIndex(0)
+    Mesh::Mesh(std::span<const std::byte> vertices,
+               uint32_t vertexStride,
+               std::span<const uint32_t> indices,
+               VertexLayout vertexLayout,
+               bool allowShortIndices,
+               std::span<const MeshLod> lods) :
+        _vertexStride(vertexStride),
+        _vertexLayout(vertexLayout),
+        _indexCount(lods.empty() ? static_cast<uint32_t>(indices.size()) : lods[0].indexCount),
+        _indexStride(sizeof(uint32_t)),
+        _materialIndex(0)
     {
         FT_ENGINE_ASSERT(!vertices.empty() && !indices.empty(), "Mesh data cannot be empty!");
         FT_ENGINE_ASSERT(vertexStride > 0, "Vertex stride must be greater than zero!");
@@ -23,23 +35,37 @@ namespace Frost
 
         BufferConfig indexBufferConfig = {};
         indexBufferConfig.usage = BufferUsage::INDEX_BUFFER;
-        indexBufferConfig.size = static_cast<uint32_t>(indices.size_bytes());
-        indexBufferConfig.stride = sizeof(uint32_t);
         indexBufferConfig.dynamic = false;
         indexBufferConfig.debugName = "Mesh_IndexBuffer";
 
-        _indexBuffer = renderer->CreateBuffer(indexBufferConfig, indices.data());
+        // The command list picks the index format from the buffer stride
+        size_t vertexCount = vertices.size_bytes() / vertexStride;
+        if (allowShortIndices && vertexCount <= std::numeric_limits<uint16_t>::max() + size_t{ 1 })
+        {
+            std::vector<uint16_t> shortIndices(indices.begin(), indices.end());
+            _indexStride = sizeof(uint16_t);
+            indexBufferConfig.size = static_cast<uint32_t>(shortIndices.size() * sizeof(uint16_t));
+            indexBufferConfig.stride = sizeof(uint16_t);
+            _indexBuffer = renderer->CreateBuffer(indexBufferConfig, shortIndices.data());
+        }
+        else
+        {
+            indexBufferConfig.size = static_cast<uint32_t>(indices.size_bytes());
+            indexBufferConfig.stride = sizeof(uint32_t);
+            _indexBuffer = renderer->CreateBuffer(indexBufferConfig, indices.data());
+        }
 
         DirectX::XMFLOAT3 min = { FLT_MAX, FLT_MAX, FLT_MAX };
         DirectX::XMFLOAT3 max = { -FLT_MAX, -FLT_MAX, -FLT_MAX };
 
-        // BoundingBox calculation
-        size_t vertexCount = vertices.size_bytes() / vertexStride;
+        // BoundingBox calculation, every layout starts with the position
+        _positions.reserve(vertexCount);
         for (size_t i = 0; i < vertexCount; ++i)
         {
             const std::byte* vertexPtr = vertices.data() + i * vertexStride;
             const float* positionPtr = reinterpret_cast<const float*>(vertexPtr);
             DirectX::XMFLOAT3 position = { positionPtr[0], positionPtr[1], positionPtr[2] };
+            _positions.emplace_back(position);
             min.x = std::min(min.x, position.x);
             min.y = std::min(min.y, position.y);
             min.z = std::min(min.z, position.z);
@@ -49,5 +75,53 @@ namespace Frost
         }
 
         _boundingBox = { min, max };
+
+        if (lods.empty())
+        {
+            _lods.push_back({ 0, _indexCount, 0.0f });
+        }
+        else
+        {
+            _lods.assign(lods.begin(), lods.end());
+        }
+
+        auto fullDetailIndices = indices.subspan(_lods[0].indexOffset, _lods[0].indexCount);
+        _indices.assign(fullDetailIndices.begin(), fullDetailIndices.end());
+
+        auto coarsestIndices = indices.subspan(_lods.back().indexOffset, _lods.back().indexCount);
+        if (coarsestIndices.size() / 3 <= MAX_OCCLUDER_TRIANGLES)
+        {
+            std::vector<uint32_t> remap(vertexCount, std::numeric_limits<uint32_t>::max());
+            _occluderIndices.reserve(coarsestIndices.size());
+            for (uint32_t index : coarsestIndices)
+            {
+                if (remap[index] == std::numeric_limits<uint32_t>::max())
+                {
+                    remap[index] = static_cast<uint32_t>(_occluderPositions.size());
+                    _occluderPositions.push_back(_positions[index]);
+                }
+                _occluderIndices.push_back(remap[index]);
+            }
+        }
+    }
+
+    void Mesh::ReleaseCpuGeometry()
+    {
+        _positions.clear();
+        _positions.shrink_to_fit();
+        _indices.clear();
+        _indices.shrink_to_fit();
+    }
+
+    AssetMemory Mesh::GetMemoryUsage() const
+    {
+        AssetMemory memory;
+        memory.cpuBytes = _positions.capacity() * sizeof(Math::Vector3) + _indices.capacity() * sizeof(uint32_t) +
+                          _lods.capacity() * sizeof(MeshLod) +
+                          _occluderPositions.capacity() * sizeof(Math::Vector3) +
+                          _occluderIndices.capacity() * sizeof(uint32_t);
+        memory.gpuBytes = size_t{ _vertexBuffer ? _vertexBuffer->GetSize() : 0u } +
+                          size_t{ _indexBuffer ? _indexBuffer->GetSize() : 0u };
+        return memory;
     }
 } // namespace Frost
\ No newline at end of file
@@ -1,32 +1,76 @@
 ﻿#pragma once
 
+#include "Frost/Asset/Asset.h"
 #include "Frost/Renderer/BoundingBox.h"
 #include "Frost/Renderer/Buffer.h"
 #include "Frost/Renderer/Vertex.h"
 
+#include <algorithm>
 #include <cstddef>
 #include <cstdint>
 #include <span>
+#include <vector>
 
 namespace Frost
 {
     class Renderer;
 
+    // Range of the index buffer drawn for one level of detail, all the levels share the vertex buffer
+    struct MeshLod
+    {
+        uint32_t indexOffset = 0;
+        uint32_t indexCount = 0;
+        // Largest distance to the full detail surface, in model space
+        float error = 0.0f;
+    };
+
     class Mesh
     {
     public:
-        Mesh(std::span<const std::byte> vertices, uint32_t vertexStride, std::span<const uint32_t> indices);
+        // Meshes whose coarsest level has more triangles are not occluders, a default heightmap chunk has this many
+        static constexpr uint32_t MAX_OCCLUDER_TRIANGLES = 2048;
+
+        // With allowShortIndices, the index buffer is 16-bit when the vertex count allows it. The indices hold every
+        // level of lods, without lods they are a single level.
+        Mesh(std::span<const std::byte> vertices,
+             uint32_t vertexStride,
+             std::span<const uint32_t> indices,
+             VertexLayout vertexLayout = VertexLayout::Standard,
+             bool allowShortIndices = false,
+             std::span<const MeshLod> lods = {});
 
         const Buffer* GetVertexBuffer() const { return _vertexBuffer.get(); }
         const Buffer* GetIndexBuffer() const { return _indexBuffer.get(); }
 
         uint32_t GetVertexStride() const { return _vertexStride; }
+        VertexLayout GetVertexLayout() const { return _vertexLayout; }
         uint32_t GetIndexCount() const { return _indexCount; }
+        uint32_t GetIndexStride() const { return _indexStride; }
         uint32_t GetMaterialIndex() const { return _materialIndex; }
 
+        uint32_t GetLodCount() const { return static_cast<uint32_t>(_lods.size()); }
+        // Clamped to the last level
+        const MeshLod& GetLod(uint32_t lod) const { return _lods[std::min(lod, GetLodCount() - 1)]; }
+
         void SetMaterialIndex(uint32_t index) { _materialIndex = index; }
+        // Texture coordinate units per model space unit, the texture streaming derives the mip it needs from it
+        float GetUVDensity() const { return _uvDensity; }
+        void SetUVDensity(float density) { _uvDensity = density; }
         BoundingBox GetBoundingBox() const { return _boundingBox; }
 
+        // CPU copy of the full detail geometry for picking, the GPU buffers cannot be read back
+        std::span<const Math::Vector3> GetPositions() const { return _positions; }
+        std::span<const uint32_t> GetIndices() const { return _indices; }
+        // The mesh can no longer be picked afterwards
+        void ReleaseCpuGeometry();
+
+        // Coarsest level with its own compact vertices, kept for the occlusion culling, empty when the level is too
+        // large to be worth rasterizing
+        std::span<const Math::Vector3> GetOccluderPositions() const { return _occluderPositions; }
+        std::span<const uint32_t> GetOccluderIndices() const { return _occluderIndices; }
+
+        AssetMemory GetMemoryUsage() const;
+
         bool enabled = true;
 
     private:
@@ -34,8 +78,17 @@ namespace Frost
         std::shared_ptr<Buffer> _indexBuffer;
         BoundingBox _boundingBox;
 
+        std::vector<Math::Vector3> _positions;
+        std::vector<uint32_t> _indices;
+        std::vector<MeshLod> _lods;
+        std::vector<Math::Vector3> _occluderPositions;
+        std::vector<uint32_t> _occluderIndices;
+
         uint32_t _vertexStride;
+        VertexLayout _vertexLayout;
         uint32_t _indexCount;
+        uint32_t _indexStride;
         uint32_t _materialIndex;
+        float _uvDensity = 0.0f;
     };
 } // namespace Frost
\ No newline at end of file
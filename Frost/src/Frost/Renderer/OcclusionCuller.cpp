@@ -0,0 +1,537 @@
+#include "Frost/Renderer/OcclusionCuller.h"
+
+#include <emmintrin.h>
+#include <algorithm>
+#include <atomic>
+#include <cfloat>
+#include <cmath>
+#include <functional>
+#include <future>
+#include <thread>
+
+#undef min
+#undef max
+
+namespace Frost
+{
+    namespace
+    {
+        // Rows rasterized by one job
+        constexpr uint32_t BAND_HEIGHT = 8;
+        // Below this many triangles the workers cost more than they save
+        constexpr size_t MIN_PARALLEL_TRIANGLES = 2048;
+        // Triangles are clipped to this many times the view on x and y, so the edge functions keep their precision
+        constexpr float GUARD_BAND = 4.0f;
+
+        struct ClipVertex
+        {
+            float x;
+            float y;
+            float z;
+            float w;
+        };
+
+        ClipVertex TransformPoint(const Math::Vector3& p, const Math::Matrix4x4& m)
+        {
+            const auto& e = m.elements;
+            return { p.x * e[0] + p.y * e[4] + p.z * e[8] + e[12],
+                     p.x * e[1] + p.y * e[5] + p.z * e[9] + e[13],
+                     p.x * e[2] + p.y * e[6] + p.z * e[10] + e[14],
+                     p.x * e[3] + p.y * e[7] + p.z * e[11] + e[15] };
+        }
+
+        // Signed distances to the near plane and the guard band, positive inside
+        float PlaneDistance(const ClipVertex& v, int plane)
+        {
+            switch (plane)
+            {
+                case 0:
+                    return v.z;
+                case 1:
+                    return GUARD_BAND * v.w - v.x;
+                case 2:
+                    return GUARD_BAND * v.w + v.x;
+                case 3:
+                    return GUARD_BAND * v.w - v.y;
+                default:
+                    return GUARD_BAND * v.w + v.y;
+            }
+        }
+
+        // Sutherland-Hodgman, a triangle gains at most one vertex per plane
+        uint32_t ClipPolygon(ClipVertex (&polygon)[8], uint32_t count)
+        {
+            for (int plane = 0; plane < 5 && count > 0; ++plane)
+            {
+                ClipVertex clipped[8];
+                uint32_t clippedCount = 0;
+                for (uint32_t i = 0; i < count; ++i)
+                {
+                    const ClipVertex& a = polygon[i];
+                    const ClipVertex& b = polygon[(i + 1) % count];
+                    float da = PlaneDistance(a, plane);
+                    float db = PlaneDistance(b, plane);
+
+                    if (da >= 0.0f)
+                    {
+                        clipped[clippedCount++] = a;
+                    }
+                    if ((da >= 0.0f) != (db >= 0.0f))
+                    {
+                        float t = da / (da - db);
+                        clipped[clippedCount++] = { a.x + (b.x - a.x) * t,
+                                                    a.y + (b.y - a.y) * t,
+                                                    a.z + (b.z - a.z) * t,
+                                                    a.w + (b.w - a.w) * t };
+                    }
+                }
+
+                std::copy(clipped, clipped + clippedCount, polygon);
+                count = clippedCount;
+            }
+            return count;
+        }
+
+        // Runs job(i) for i in [0, count) on workerCount threads at most, the calling thread included
+        void ParallelFor(size_t count, uint32_t workerCount, const std::function<void(size_t)>& job)
+        {
+            std::atomic<size_t> next = 0;
+            auto worker = [&]()
+            {
+                for (size_t i = next++; i < count; i = next++)
+                {
+                    job(i);
+                }
+            };
+
+            size_t threadCount = std::min<size_t>(workerCount, count);
+            std::vector<std::future<void>> workers;
+            for (size_t i = 1; i < threadCount; ++i)
+            {
+                workers.push_back(std::async(std::launch::async, worker));
+            }
+            worker();
+
+            for (auto& future : workers)
+            {
+                future.get();
+            }
+        }
+    } // namespace
+
+    OcclusionCuller::OcclusionCuller()
+    {
+        SetWorkerCount(std::thread::hardware_concurrency());
+        SetSettings(_settings);
+    }
+
+    void OcclusionCuller::SetSettings(const OcclusionSettings& settings)
+    {
+        _settings = settings;
+        _width = (std::max(settings.width, 4u) + 3) & ~3u;
+        _height = std::max(settings.height, 1u);
+
+        _levels.clear();
+        uint32_t width = _width;
+        uint32_t height = _height;
+        while (true)
+        {
+            DepthLevel& level = _levels.emplace_back();
+            level.width = width;
+            level.height = height;
+            level.maxDepth.assign(size_t{ width } * height, 1.0f);
+            if (_levels.size() > 1)
+            {
+                level.minDepth.assign(size_t{ width } * height, 1.0f);
+            }
+
+            if (width == 1 && height == 1)
+            {
+                break;
+            }
+            width = (width + 1) / 2;
+            height = (height + 1) / 2;
+        }
+    }
+
+    void OcclusionCuller::SetWorkerCount(uint32_t workerCount)
+    {
+        _workerCount = std::max(workerCount, 1u);
+    }
+
+    void OcclusionCuller::BeginFrame(const Math::Matrix4x4& viewProjection)
+    {
+        _viewProjection = viewProjection;
+        _occluders.clear();
+        _triangleCount = 0;
+
+        for (DepthLevel& level : _levels)
+        {
+            std::fill(level.maxDepth.begin(), level.maxDepth.end(), 1.0f);
+            std::fill(level.minDepth.begin(), level.minDepth.end(), 1.0f);
+        }
+    }
+
+    void OcclusionCuller::AddOccluder(std::span<const Math::Vector3> positions,
+                                      std::span<const uint32_t> indices,
+                                      const Math::Matrix4x4& worldMatrix)
+    {
+        if (positions.empty() || indices.size() < 3)
+        {
+            return;
+        }
+
+        _occluders.push_back({ positions, indices, worldMatrix * _viewProjection });
+    }
+
+    void OcclusionCuller::Rasterize()
+    {
+        if (_occluders.empty())
+        {
+            return;
+        }
+
+        size_t inputTriangles = 0;
+        for (const Occluder& occluder : _occluders)
+        {
+            inputTriangles += occluder.indices.size() / 3;
+        }
+        uint32_t workerCount = inputTriangles >= MIN_PARALLEL_TRIANGLES ? _workerCount : 1;
+
+        if (_triangles.size() < _occluders.size())
+        {
+            _triangles.resize(_occluders.size());
+        }
+        ParallelFor(_occluders.size(),
+                    workerCount,
+                    [this](size_t i)
+                    {
+                        _triangles[i].clear();
+                        _SetupTriangles(_occluders[i], _triangles[i]);
+                    });
+
+        _triangleCount = 0;
+        for (size_t i = 0; i < _occluders.size(); ++i)
+        {
+            _triangleCount += _triangles[i].size();
+        }
+
+        // Bands share no pixel, so their workers write without locking
+        uint32_t bandCount = (_height + BAND_HEIGHT - 1) / BAND_HEIGHT;
+        ParallelFor(bandCount,
+                    workerCount,
+                    [this](size_t band)
+                    {
+                        uint32_t rowBegin = static_cast<uint32_t>(band) * BAND_HEIGHT;
+                        _RasterizeRows(rowBegin, std::min(rowBegin + BAND_HEIGHT, _height));
+                    });
+
+        _BuildHierarchy();
+    }
+
+    bool OcclusionCuller::IsVisible(const BoundingBox& worldBounds) const
+    {
+        if (_triangleCount == 0)
+        {
+            return true;
+        }
+
+        float minX = FLT_MAX;
+        float minY = FLT_MAX;
+        float maxX = -FLT_MAX;
+        float maxY = -FLT_MAX;
+        float nearestDepth = FLT_MAX;
+        for (int i = 0; i < 8; ++i)
+        {
+            Math::Vector3 corner = { (i & 1) ? worldBounds.max.x : worldBounds.min.x,
+                                     (i & 2) ? worldBounds.max.y : worldBounds.min.y,
+                                     (i & 4) ? worldBounds.max.z : worldBounds.min.z };
+            ClipVertex v = TransformPoint(corner, _viewProjection);
+            if (v.z < 0.0f || v.w <= 0.0f)
+            {
+                return true;
+            }
+
+            float invW = 1.0f / v.w;
+            float x = (v.x * invW * 0.5f + 0.5f) * _width;
+            float y = (0.5f - v.y * invW * 0.5f) * _height;
+            minX = std::min(minX, x);
+            maxX = std::max(maxX, x);
+            minY = std::min(minY, y);
+            maxY = std::max(maxY, y);
+            nearestDepth = std::min(nearestDepth, v.z * invW);
+        }
+
+        if (maxX < 0.0f || maxY < 0.0f || minX >= _width || minY >= _height)
+        {
+            return true;
+        }
+
+        // Every pixel the rectangle touches
+        int32_t x0 = std::max(static_cast<int32_t>(minX), 0);
+        int32_t y0 = std::max(static_cast<int32_t>(minY), 0);
+        int32_t x1 = std::min(static_cast<int32_t>(maxX), static_cast<int32_t>(_width) - 1);
+        int32_t y1 = std::min(static_cast<int32_t>(maxY), static_cast<int32_t>(_height) - 1);
+
+        // Start from the finest level where the rectangle spans 2x2 texels at most
+        uint32_t level = 0;
+        while (level + 1 < _levels.size() && ((x1 >> level) - (x0 >> level) > 1 || (y1 >> level) - (y0 >> level) > 1))
+        {
+            ++level;
+        }
+
+        return _IsRegionVisible(level, x0, y0, x1, y1, nearestDepth);
+    }
+
+    void OcclusionCuller::_SetupTriangles(const Occluder& occluder, std::vector<ScreenTriangle>& triangles) const
+    {
+        const float width = static_cast<float>(_width);
+        const float height = static_cast<float>(_height);
+
+        auto addTriangle = [&](const ClipVertex& a, const ClipVertex& b, const ClipVertex& c)
+        {
+            float x[3];
+            float y[3];
+            float z[3];
+            const ClipVertex* vertices[3] = { &a, &b, &c };
+            for (int i = 0; i < 3; ++i)
+            {
+                float invW = 1.0f / vertices[i]->w;
+                x[i] = (vertices[i]->x * invW * 0.5f + 0.5f) * width;
+                y[i] = (0.5f - vertices[i]->y * invW * 0.5f) * height;
+                z[i] = vertices[i]->z * invW;
+            }
+
+            float area = (x[1] - x[0]) * (y[2] - y[0]) - (x[2] - x[0]) * (y[1] - y[0]);
+            if (std::abs(area) < 1e-6f)
+            {
+                return;
+            }
+            if (area < 0.0f)
+            {
+                std::swap(x[1], x[2]);
+                std::swap(y[1], y[2]);
+                std::swap(z[1], z[2]);
+                area = -area;
+            }
+
+            ScreenTriangle triangle;
+            triangle.minX = std::max(static_cast<int32_t>(std::ceil(std::min({ x[0], x[1], x[2] }) - 0.5f)), 0);
+            triangle.maxX = std::min(static_cast<int32_t>(std::floor(std::max({ x[0], x[1], x[2] }) - 0.5f)),
+                                     static_cast<int32_t>(_width) - 1);
+            triangle.minY = std::max(static_cast<int32_t>(std::ceil(std::min({ y[0], y[1], y[2] }) - 0.5f)), 0);
+            triangle.maxY = std::min(static_cast<int32_t>(std::floor(std::max({ y[0], y[1], y[2] }) - 0.5f)),
+                                     static_cast<int32_t>(_height) - 1);
+            if (triangle.minX > triangle.maxX || triangle.minY > triangle.maxY)
+            {
+                return;
+            }
+
+            // Edge i goes between the two other vertices and is positive on the side of vertex i
+            for (int i = 0; i < 3; ++i)
+            {
+                int a = (i + 1) % 3;
+                int b = (i + 2) % 3;
+                triangle.edgeA[i] = y[a] - y[b];
+                triangle.edgeB[i] = x[b] - x[a];
+                triangle.edgeC[i] = x[a] * y[b] - y[a] * x[b];
+            }
+
+            // The edge functions over the area are the barycentric coordinates
+            float invArea = 1.0f / area;
+            const float* edgeA = triangle.edgeA;
+            const float* edgeB = triangle.edgeB;
+            const float* edgeC = triangle.edgeC;
+            triangle.depthX = (edgeA[0] * z[0] + edgeA[1] * z[1] + edgeA[2] * z[2]) * invArea;
+            triangle.depthY = (edgeB[0] * z[0] + edgeB[1] * z[1] + edgeB[2] * z[2]) * invArea;
+            triangle.depthC = (edgeC[0] * z[0] + edgeC[1] * z[1] + edgeC[2] * z[2]) * invArea;
+            // A pixel stores the farthest depth of the plane over its area rather than at its centre
+            triangle.depthC += 0.5f * (std::abs(triangle.depthX) + std::abs(triangle.depthY));
+
+            triangles.push_back(triangle);
+        };
+
+        const size_t vertexCount = occluder.positions.size();
+        for (size_t i = 0; i + 2 < occluder.indices.size(); i += 3)
+        {
+            uint32_t i0 = occluder.indices[i];
+            uint32_t i1 = occluder.indices[i + 1];
+            uint32_t i2 = occluder.indices[i + 2];
+            if (i0 >= vertexCount || i1 >= vertexCount || i2 >= vertexCount)
+            {
+                continue;
+            }
+
+            ClipVertex polygon[8] = { TransformPoint(occluder.positions[i0], occluder.worldViewProjection),
+                                      TransformPoint(occluder.positions[i1], occluder.worldViewProjection),
+                                      TransformPoint(occluder.positions[i2], occluder.worldViewProjection) };
+
+            // Entirely on the outer side of one plane of the view
+            auto allOutside = [&](auto&& outside)
+            { return outside(polygon[0]) && outside(polygon[1]) && outside(polygon[2]); };
+            if (allOutside([](const ClipVertex& v) { return v.x > v.w; }) ||
+                allOutside([](const ClipVertex& v) { return v.x < -v.w; }) ||
+                allOutside([](const ClipVertex& v) { return v.y > v.w; }) ||
+                allOutside([](const ClipVertex& v) { return v.y < -v.w; }) ||
+                allOutside([](const ClipVertex& v) { return v.z < 0.0f; }) ||
+                allOutside([](const ClipVertex& v) { return v.z > v.w; }))
+            {
+                continue;
+            }
+
+            bool needsClipping = false;
+            for (int v = 0; v < 3 && !needsClipping; ++v)
+            {
+                for (int plane = 0; plane < 5; ++plane)
+                {
+                    needsClipping |= PlaneDistance(polygon[v], plane) < 0.0f;
+                }
+            }
+
+            if (!needsClipping)
+            {
+                addTriangle(polygon[0], polygon[1], polygon[2]);
+                continue;
+            }
+
+            uint32_t count = ClipPolygon(polygon, 3);
+            for (uint32_t v = 2; v < count; ++v)
+            {
+                addTriangle(polygon[0], polygon[v - 1], polygon[v]);
+            }
+        }
+    }
+
+    void OcclusionCuller::_RasterizeRows(uint32_t rowBegin, uint32_t rowEnd)
+    {
+        float* depth = _levels[0].maxDepth.data();
+        const __m128 laneOffsets = _mm_setr_ps(0.5f, 1.5f, 2.5f, 3.5f);
+        const __m128 zero = _mm_setzero_ps();
+
+        for (size_t occluder = 0; occluder < _occluders.size(); ++occluder)
+        {
+            for (const ScreenTriangle& triangle : _triangles[occluder])
+            {
+                int32_t yBegin = std::max(triangle.minY, static_cast<int32_t>(rowBegin));
+                int32_t yEnd = std::min(triangle.maxY, static_cast<int32_t>(rowEnd) - 1);
+                if (yBegin > yEnd)
+                {
+                    continue;
+                }
+
+                // Four pixels at a time from a multiple of 4, the buffer width is one
+                int32_t xBegin = triangle.minX & ~3;
+                __m128 xStart = _mm_add_ps(_mm_set1_ps(static_cast<float>(xBegin)), laneOffsets);
+
+                __m128 edgeA[3];
+                __m128 edgeStep[3];
+                for (int i = 0; i < 3; ++i)
+                {
+                    edgeA[i] = _mm_set1_ps(triangle.edgeA[i]);
+                    edgeStep[i] = _mm_set1_ps(triangle.edgeA[i] * 4.0f);
+                }
+                __m128 depthStep = _mm_set1_ps(triangle.depthX * 4.0f);
+
+                for (int32_t y = yBegin; y <= yEnd; ++y)
+                {
+                    float centerY = static_cast<float>(y) + 0.5f;
+
+                    __m128 edge[3];
+                    for (int i = 0; i < 3; ++i)
+                    {
+                        __m128 rowConstant = _mm_set1_ps(triangle.edgeB[i] * centerY + triangle.edgeC[i]);
+                        edge[i] = _mm_add_ps(_mm_mul_ps(edgeA[i], xStart), rowConstant);
+                    }
+                    __m128 planeDepth = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(triangle.depthX), xStart),
+                                                   _mm_set1_ps(triangle.depthY * centerY + triangle.depthC));
+
+                    float* row = depth + size_t(y) * _width;
+                    for (int32_t x = xBegin; x <= triangle.maxX; x += 4)
+                    {
+                        __m128 inside = _mm_and_ps(_mm_and_ps(_mm_cmpge_ps(edge[0], zero), _mm_cmpge_ps(edge[1], zero)),
+                                                   _mm_cmpge_ps(edge[2], zero));
+                        if (_mm_movemask_ps(inside) != 0)
+                        {
+                            __m128 previous = _mm_loadu_ps(row + x);
+                            __m128 nearest = _mm_min_ps(previous, planeDepth);
+                            _mm_storeu_ps(row + x,
+                                          _mm_or_ps(_mm_and_ps(inside, nearest), _mm_andnot_ps(inside, previous)));
+                        }
+
+                        for (int i = 0; i < 3; ++i)
+                        {
+                            edge[i] = _mm_add_ps(edge[i], edgeStep[i]);
+                        }
+                        planeDepth = _mm_add_ps(planeDepth, depthStep);
+                    }
+                }
+            }
+        }
+    }
+
+    void OcclusionCuller::_BuildHierarchy()
+    {
+        for (size_t l = 1; l < _levels.size(); ++l)
+        {
+            const DepthLevel& source = _levels[l - 1];
+            DepthLevel& level = _levels[l];
+            // Level 0 holds a single depth per pixel
+            const std::vector<float>& sourceMin = l == 1 ? source.maxDepth : source.minDepth;
+
+            for (uint32_t y = 0; y < level.height; ++y)
+            {
+                uint32_t sy0 = y * 2;
+                uint32_t sy1 = std::min(sy0 + 1, source.height - 1);
+                for (uint32_t x = 0; x < level.width; ++x)
+                {
+                    uint32_t sx0 = x * 2;
+                    uint32_t sx1 = std::min(sx0 + 1, source.width - 1);
+
+                    size_t a = size_t(sy0) * source.width + sx0;
+                    size_t b = size_t(sy0) * source.width + sx1;
+                    size_t c = size_t(sy1) * source.width + sx0;
+                    size_t d = size_t(sy1) * source.width + sx1;
+
+                    size_t texel = size_t(y) * level.width + x;
+                    level.minDepth[texel] = std::min({ sourceMin[a], sourceMin[b], sourceMin[c], sourceMin[d] });
+                    level.maxDepth[texel] =
+                        std::max({ source.maxDepth[a], source.maxDepth[b], source.maxDepth[c], source.maxDepth[d] });
+                }
+            }
+        }
+    }
+
+    bool OcclusionCuller::_IsRegionVisible(
+        uint32_t level, int32_t x0, int32_t y0, int32_t x1, int32_t y1, float depth) const
+    {
+        const DepthLevel& texels = _levels[level];
+        for (int32_t ty = y0 >> level; ty <= (y1 >> level); ++ty)
+        {
+            for (int32_t tx = x0 >> level; tx <= (x1 >> level); ++tx)
+            {
+                size_t texel = size_t(ty) * texels.width + tx;
+                if (depth > texels.maxDepth[texel])
+                {
+                    continue;
+                }
+
+                // In front of everything drawn in the texel
+                if (level == 0 || depth <= texels.minDepth[texel])
+                {
+                    return true;
+                }
+
+                // Only in front of a part of it, the finer texels tell which
+                int32_t cx0 = std::max(x0, tx << level);
+                int32_t cy0 = std::max(y0, ty << level);
+                int32_t cx1 = std::min(x1, ((tx + 1) << level) - 1);
+                int32_t cy1 = std::min(y1, ((ty + 1) << level) - 1);
+                if (_IsRegionVisible(level - 1, cx0, cy0, cx1, cy1, depth))
+                {
+                    return true;
+                }
+            }
+        }
+        return false;
+    }
+} // namespace Frost
@@ -0,0 +1,109 @@
+#pragma once
+
+#include "Frost/Core/Core.h"
+#include "Frost/Renderer/BoundingBox.h"
+#include "Frost/Utils/Math/Matrix.h"
+#include "Frost/Utils/Math/Vector.h"
+
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace Frost
+{
+    struct OcclusionSettings
+    {
+        bool enabled = true;
+        // Resolution of the depth buffer, the width is rounded up to a multiple of 4
+        uint32_t width = 256;
+        uint32_t height = 128;
+        // Occluders rasterized per view, the designated ones first, then the largest on screen
+        uint32_t maxOccluders = 32;
+        // Screen size, as returned by LodSelector::GetScreenSize, from which an instance is an occluder on its own
+        float minOccluderScreenSize = 0.25f;
+    };
+
+    // Software occlusion culling. The occluders of a view are rasterized into a small depth buffer on the CPU, four
+    // pixels at a time and one band of rows per worker, then a min/max hierarchy of the buffer is built to test
+    // bounding boxes against. Depths follow the D3D convention, 0 on the near plane and 1 on the far plane.
+    class FROST_API OcclusionCuller
+    {
+    public:
+        OcclusionCuller();
+
+        void SetSettings(const OcclusionSettings& settings);
+        const OcclusionSettings& GetSettings() const { return _settings; }
+
+        uint32_t GetWorkerCount() const { return _workerCount; }
+        void SetWorkerCount(uint32_t workerCount);
+
+        // Clears the depth buffer and the occluders, viewProjection maps world space to clip space
+        void BeginFrame(const Math::Matrix4x4& viewProjection);
+        // The geometry is read by Rasterize and must live until then. Both sides of the triangles are drawn.
+        void AddOccluder(std::span<const Math::Vector3> positions,
+                         std::span<const uint32_t> indices,
+                         const Math::Matrix4x4& worldMatrix);
+        // Rasterizes the occluders added since BeginFrame and builds the hierarchy
+        void Rasterize();
+
+        // False only when the box is behind the occluders over all the pixels it covers. Boxes crossing the near
+        // plane or outside the view are visible, the frustum culling deals with them.
+        bool IsVisible(const BoundingBox& worldBounds) const;
+
+        uint32_t GetWidth() const { return _width; }
+        uint32_t GetHeight() const { return _height; }
+        size_t GetOccluderCount() const { return _occluders.size(); }
+        size_t GetTriangleCount() const { return _triangleCount; }
+        // Farthest occluder depth of each pixel, row by row from the top, 1 where nothing was drawn
+        std::span<const float> GetDepthBuffer() const { return _levels[0].maxDepth; }
+
+    private:
+        struct Occluder
+        {
+            std::span<const Math::Vector3> positions;
+            std::span<const uint32_t> indices;
+            Math::Matrix4x4 worldViewProjection;
+        };
+
+        // Edge functions are positive inside, depth = depthX * x + depthY * y + depthC in pixels
+        struct ScreenTriangle
+        {
+            float edgeA[3];
+            float edgeB[3];
+            float edgeC[3];
+            float depthX;
+            float depthY;
+            float depthC;
+            int32_t minX;
+            int32_t maxX;
+            int32_t minY;
+            int32_t maxY;
+        };
+
+        // Level 0 is the depth buffer, each texel of the next levels covers 2x2 texels of the previous one
+        struct DepthLevel
+        {
+            uint32_t width = 0;
+            uint32_t height = 0;
+            std::vector<float> minDepth; // empty on level 0
+            std::vector<float> maxDepth;
+        };
+
+        void _SetupTriangles(const Occluder& occluder, std::vector<ScreenTriangle>& triangles) const;
+        void _RasterizeRows(uint32_t rowBegin, uint32_t rowEnd);
+        void _BuildHierarchy();
+        bool _IsRegionVisible(uint32_t level, int32_t x0, int32_t y0, int32_t x1, int32_t y1, float depth) const;
+
+        OcclusionSettings _settings;
+        uint32_t _width = 0;
+        uint32_t _height = 0;
+        uint32_t _workerCount = 1;
+
+        Math::Matrix4x4 _viewProjection;
+        std::vector<Occluder> _occluders;
+        // One list per occluder, kept across frames
+        std::vector<std::vector<ScreenTriangle>> _triangles;
+        size_t _triangleCount = 0;
+        std::vector<DepthLevel> _levels;
+    };
+} // namespace Frost
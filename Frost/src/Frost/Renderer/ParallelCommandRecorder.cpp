@@ -0,0 +1,102 @@
+#include "Frost/Renderer/ParallelCommandRecorder.h"
+#include "Frost/Debugging/Assert.h"
+#include "Frost/Renderer/CommandList.h"
+#include "Frost/Renderer/Renderer.h"
+#include "Frost/Renderer/RendererAPI.h"
+
+#include <algorithm>
+#include <atomic>
+#include <future>
+#include <thread>
+
+namespace Frost
+{
+    ParallelCommandRecorder::ParallelCommandRecorder() :
+        ParallelCommandRecorder([]() { return RendererAPI::GetRenderer()->GetNewCommandList(); })
+    {
+    }
+
+    ParallelCommandRecorder::ParallelCommandRecorder(Factory factory) : _factory(std::move(factory))
+    {
+        SetWorkerCount(std::thread::hardware_concurrency());
+    }
+
+    void ParallelCommandRecorder::SetWorkerCount(uint32_t workerCount)
+    {
+        _workerCount = std::max(workerCount, 1u);
+    }
+
+    void ParallelCommandRecorder::Add(RecordFunction record)
+    {
+        _jobs.push_back(std::move(record));
+    }
+
+    void ParallelCommandRecorder::AddRange(size_t count, size_t minChunkSize, RangeRecordFunction record)
+    {
+        if (count == 0)
+        {
+            return;
+        }
+
+        size_t chunkSize = (count + _workerCount - 1) / _workerCount;
+        chunkSize = std::max({ chunkSize, minChunkSize, size_t(1) });
+        for (size_t begin = 0; begin < count; begin += chunkSize)
+        {
+            size_t end = std::min(begin + chunkSize, count);
+            _jobs.push_back([record, begin, end](CommandList* commandList) { record(commandList, begin, end); });
+        }
+    }
+
+    void ParallelCommandRecorder::Submit()
+    {
+        if (_jobs.empty())
+        {
+            return;
+        }
+
+        while (_commandLists.size() < _jobs.size())
+        {
+            _commandLists.push_back(_factory());
+            FT_ENGINE_ASSERT(_commandLists.back(), "ParallelCommandRecorder: the factory returned no command list");
+        }
+
+        auto recordJob = [this](size_t index)
+        {
+            CommandList* commandList = _commandLists[index].get();
+            commandList->BeginRecording();
+            _jobs[index](commandList);
+            commandList->EndRecording();
+        };
+
+        // The calling thread records too, a single job does not pay for a thread
+        size_t workerCount = std::min<size_t>(_workerCount, _jobs.size());
+        std::atomic<size_t> nextJob = 0;
+        auto worker = [&]()
+        {
+            for (size_t index = nextJob++; index < _jobs.size(); index = nextJob++)
+            {
+                recordJob(index);
+            }
+        };
+
+        std::vector<std::future<void>> workers;
+        workers.reserve(workerCount - 1);
+        for (size_t i = 1; i < workerCount; ++i)
+        {
+            workers.push_back(std::async(std::launch::async, worker));
+        }
+        worker();
+
+        for (auto& future : workers)
+        {
+            future.get();
+        }
+
+        for (size_t i = 0; i < _jobs.size(); ++i)
+        {
+            _commandLists[i]->Execute();
+        }
+
+        _jobs.clear();
+    }
+} // namespace Frost
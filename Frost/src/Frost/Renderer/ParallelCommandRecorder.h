@@ -0,0 +1,52 @@
+#pragma once
+
+#include "Frost/Core/Core.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <vector>
+
+namespace Frost
+{
+    class CommandList;
+
+    // Records independent jobs on worker threads, each into its own command list, then executes the lists in the
+    // order the jobs were added. Jobs are added in dependency order, a job only sees the GPU work of the jobs added
+    // before it once submitted.
+    //
+    // A command list starts from the default pipeline state, so a job binds everything it draws with. Jobs run
+    // concurrently and must not share mutable CPU state.
+    class FROST_API ParallelCommandRecorder
+    {
+    public:
+        using RecordFunction = std::function<void(CommandList*)>;
+        using RangeRecordFunction = std::function<void(CommandList*, size_t begin, size_t end)>;
+        using Factory = std::function<std::shared_ptr<CommandList>()>;
+
+        // Creates the command lists through Renderer::GetNewCommandList
+        ParallelCommandRecorder();
+        // A custom factory lets the scheduling run without a GPU
+        explicit ParallelCommandRecorder(Factory factory);
+
+        void Add(RecordFunction record);
+        // Splits [0, count) in one job per worker at most, a job gets minChunkSize items unless fewer are left
+        void AddRange(size_t count, size_t minChunkSize, RangeRecordFunction record);
+
+        // Records the jobs added since the last call, then executes their lists in order on the calling thread
+        void Submit();
+
+        size_t GetJobCount() const { return _jobs.size(); }
+        size_t GetCommandListCount() const { return _commandLists.size(); }
+        uint32_t GetWorkerCount() const { return _workerCount; }
+        void SetWorkerCount(uint32_t workerCount);
+
+    private:
+        Factory _factory;
+        std::vector<RecordFunction> _jobs;
+        // One list per job, kept across frames
+        std::vector<std::shared_ptr<CommandList>> _commandLists;
+        uint32_t _workerCount = 1;
+    };
+} // namespace Frost
@@ -4,6 +4,7 @@
 #include "Frost/Renderer/Buffer.h"
 #include "Frost/Renderer/Format.h"
 #include "Frost/Renderer/GraphicsTypes.h"
+#include "Frost/Renderer/MaterialPropertyBlock.h"
 #include "Frost/Renderer/Renderer.h"
 #include "Frost/Renderer/RendererAPI.h"
 #include "Frost/Renderer/Sampler.h"
@@ -73,16 +74,6 @@ namespace Frost
         //_commandList = Renderer::GetDevice()->CreateCommandList();
 #endif
 
-        uint32_t width = Application::GetWindow()->GetWidth();
-        uint32_t height = Application::GetWindow()->GetHeight();
-
-        if (width == 0 || height == 0)
-            return;
-
-        _CreateGBufferTextures(width, height);
-        _currentWidth = width;
-        _currentHeight = height;
-
         ShaderDesc gBufferVSDesc = { .type = ShaderType::Vertex,
                                      .debugName = "VS_GBuffer",
                                      .filePath = "../Frost/resources/shaders/VS_GBuffer.hlsl" };
@@ -92,38 +83,10 @@ namespace Frost
         _gBufferVertexShader = Shader::Create(gBufferVSDesc);
         _gBufferPixelShader = Shader::Create(gBufferPSDesc);
 
-        const uint32_t gBufferVertexStride = sizeof(Vertex);
-        InputLayout::VertexAttributeArray gBufferAttributes = {
-            { .name = "POSITION",
-              .format = Format::RGB32_FLOAT,
-              .arraySize = 1,
-              .bufferIndex = 0,
-              .offset = 0,
-              .elementStride = gBufferVertexStride,
-              .isInstanced = false },
-            { .name = "NORMAL",
-              .format = Format::RGB32_FLOAT,
-              .arraySize = 1,
-              .bufferIndex = 0,
-              .offset = 12,
-              .elementStride = gBufferVertexStride,
-              .isInstanced = false },
-            { .name = "TEXCOORD",
-              .format = Format::RG32_FLOAT,
-              .arraySize = 1,
-              .bufferIndex = 0,
-              .offset = 24,
-              .elementStride = gBufferVertexStride,
-              .isInstanced = false },
-            { .name = "TANGENT",
-              .format = Format::RGBA32_FLOAT,
-              .arraySize = 1,
-              .bufferIndex = 0,
-              .offset = 32,
-              .elementStride = gBufferVertexStride,
-              .isInstanced = false },
-        };
-        _gBufferInputLayout = std::make_unique<InputLayoutDX11>(gBufferAttributes, *_gBufferVertexShader);
+        _gBufferInputLayout =
+            std::make_unique<InputLayoutDX11>(GetMeshVertexAttributes(VertexLayout::Standard), *_gBufferVertexShader);
+        _gBufferCompactInputLayout =
+            std::make_unique<InputLayoutDX11>(GetMeshVertexAttributes(VertexLayout::Compact), *_gBufferVertexShader);
 
         SamplerConfig materialSamplerConfig = { .filter = Filter::MIN_MAG_MIP_LINEAR,
                                                 .addressU = AddressMode::WRAP,
@@ -150,10 +113,6 @@ namespace Frost
                                                                     .dynamic = true,
                                                                     .debugName = "DS_PS_MaterialConstants" });
 
-        // Custom materials
-        _customMaterialConstantBuffer = renderer->CreateBuffer(BufferConfig{
-            .usage = BufferUsage::CONSTANT_BUFFER, .size = 256, .dynamic = true, .debugName = "DS_CustomMaterial" });
-
         _CreateDefaultTextures();
     }
 
@@ -166,16 +125,12 @@ namespace Frost
         _gBufferSampler.reset();
         _materialSampler.reset();
         _gBufferInputLayout.reset();
+        _gBufferCompactInputLayout.reset();
 
         _gBufferPixelShader.reset();
         _gBufferVertexShader.reset();
 
-        _depthStencilTexture.reset();
-        _materialTexture.reset();
-        _worldPositionTexture.reset();
-        _normalTexture.reset();
-        _albedoTexture.reset();
-        _emissionTexture.reset();
+        _gbuffer = {};
 
         _defaultNormalTexture.reset();
         _defaultAlbedoTexture.reset();
@@ -187,7 +142,7 @@ namespace Frost
         _commandList.reset();
 
         _inputLayoutCache.clear();
-        _customMaterialConstantBuffer.reset();
+        _customMaterialConstants.Release();
     }
 
     void DeferredRenderingPipeline::OnWindowResize(WindowResizeEvent& e)
@@ -225,98 +180,18 @@ namespace Frost
 #endif
     }
 
-    InputLayout* DeferredRenderingPipeline::_GetOrCreateInputLayout(Shader* vertexShader)
-    {
-        auto it = _inputLayoutCache.find(vertexShader);
-        if (it != _inputLayoutCache.end())
-        {
-            return it->second.get();
-        }
-
-        const uint32_t vertexStride = sizeof(Vertex);
-        InputLayout::VertexAttributeArray attributes = {
-            { .name = "POSITION",
-              .format = Format::RGB32_FLOAT,
-              .arraySize = 1,
-              .bufferIndex = 0,
-              .offset = 0,
-              .elementStride = vertexStride },
-            { .name = "NORMAL",
-              .format = Format::RGB32_FLOAT,
-              .arraySize = 1,
-              .bufferIndex = 0,
-              .offset = 12,
-              .elementStride = vertexStride },
-            { .name = "TEXCOORD",
-              .format = Format::RG32_FLOAT,
-              .arraySize = 1,
-              .bufferIndex = 0,
-              .offset = 24,
-              .elementStride = vertexStride },
-            { .name = "TANGENT",
-              .format = Format::RGBA32_FLOAT,
-              .arraySize = 1,
-              .bufferIndex = 0,
-              .offset = 32,
-              .elementStride = vertexStride },
-        };
-
-        auto newLayout = std::make_unique<InputLayoutDX11>(attributes, *vertexShader);
-        InputLayout* ptr = newLayout.get();
-
-        _inputLayoutCache[vertexShader] = std::move(newLayout);
-
-        return ptr;
-    }
-
-    void DeferredRenderingPipeline::OnResize(uint32_t width, uint32_t height)
+    InputLayout* DeferredRenderingPipeline::_GetOrCreateInputLayout(Shader* vertexShader, VertexLayout vertexLayout)
     {
-        if (width == 0 || height == 0)
-            return;
+        // The G-Buffer chunks look layouts up from several threads
+        std::lock_guard lock(_inputLayoutMutex);
 
-        if (_currentWidth != width || _currentHeight != height)
+        std::unique_ptr<InputLayout>& layout = _inputLayoutCache[vertexShader][static_cast<size_t>(vertexLayout)];
+        if (!layout)
         {
-            _CreateGBufferTextures(width, height);
-            _currentWidth = width;
-            _currentHeight = height;
+            layout = std::make_unique<InputLayoutDX11>(GetMeshVertexAttributes(vertexLayout), *vertexShader);
         }
-    }
-
-    void DeferredRenderingPipeline::_CreateGBufferTextures(uint32_t width, uint32_t height)
-    {
-        _albedoTexture.reset();
-        _normalTexture.reset();
-        _worldPositionTexture.reset();
-        _materialTexture.reset();
-        _depthStencilTexture.reset();
-        _emissionTexture.reset();
-
-        TextureConfig textureConfig = {
-            .width = width, .height = height, .isRenderTarget = true, .isShaderResource = true, .hasMipmaps = false
-        };
-
-        textureConfig.format = Format::RGBA8_UNORM;
-        _albedoTexture = std::make_shared<TextureDX11>(textureConfig);
-
-        textureConfig.format = Format::RGBA16_FLOAT;
-        _normalTexture = std::make_shared<TextureDX11>(textureConfig);
-
-        textureConfig.format = Format::RGBA32_FLOAT;
-        _worldPositionTexture = std::make_shared<TextureDX11>(textureConfig);
-
-        textureConfig.format = Format::RGBA8_UNORM;
-        _materialTexture = std::make_shared<TextureDX11>(textureConfig);
 
-        textureConfig.format = Format::RGBA16_FLOAT;
-        _emissionTexture = std::make_shared<TextureDX11>(textureConfig);
-
-        TextureConfig depthConfig = { .format = Format::R24G8_TYPELESS,
-                                      .width = width,
-                                      .height = height,
-                                      .isRenderTarget = true,
-                                      .isShaderResource = true,
-                                      .hasMipmaps = false };
-        _depthStencilTexture = std::make_shared<TextureDX11>(depthConfig);
+        return layout.get();
     }
 
     void DeferredRenderingPipeline::BeginFrame(const Component::Camera& camera,
@@ -325,7 +200,7 @@ namespace Frost
                                                const Math::Matrix4x4& projectionMatrix,
                                                const Viewport& viewport)
     {
-        if (!_albedoTexture)
+        if (!_gbuffer.albedo)
             return;
         _enabled = true;
 
@@ -351,20 +226,12 @@ namespace Frost
         vsPerFrameData.CameraPosition = cameraTransform.position;
         _vsPerFrameConstants->UpdateData(_commandList.get(), &vsPerFrameData, sizeof(VS_PerFrameConstants));
 
-        Texture* gBufferRTs[] = { _albedoTexture.get(),
-                                  _normalTexture.get(),
-                                  _worldPositionTexture.get(),
-                                  _materialTexture.get(),
-                                  _emissionTexture.get() };
-        _commandList->SetRenderTargets(ARRAYSIZE(gBufferRTs), gBufferRTs, _depthStencilTexture.get());
-
-        _commandList->SetViewport(viewport.x, viewport.y, viewport.width, viewport.height, 0.0f, 1.0f);
-
-        _commandList->SetScissorRect(static_cast<int>(viewport.x),
-                                     static_cast<int>(viewport.y),
-                                     static_cast<int>(viewport.x + viewport.width),
-                                     static_cast<int>(viewport.y + viewport.height));
+        _frameViewport = viewport;
+        _BindGBuffer(_commandList.get());
 
+        Texture* gBufferRTs[] = {
+            _gbuffer.albedo, _gbuffer.normal, _gbuffer.worldPosition, _gbuffer.material, _gbuffer.emission
+        };
         if (camera.clearOnRender)
         {
             const float clearColor[4] = {
@@ -376,23 +243,141 @@ namespace Frost
             }
         }
 
-        _commandList->ClearDepthStencil(_depthStencilTexture.get(), true, 1.0f, false, 0);
-        _commandList->SetConstantBuffer(_vsPerFrameConstants.get(), 0);
+        _commandList->ClearDepthStencil(_gbuffer.depth, true, 1.0f, false, 0);
+    }
+
+    void DeferredRenderingPipeline::_BindGBuffer(CommandList* commandList)
+    {
+        const Viewport& viewport = _frameViewport;
+
+        Texture* gBufferRTs[] = {
+            _gbuffer.albedo, _gbuffer.normal, _gbuffer.worldPosition, _gbuffer.material, _gbuffer.emission
+        };
+        commandList->SetRenderTargets(ARRAYSIZE(gBufferRTs), gBufferRTs, _gbuffer.depth);
+
+        commandList->SetViewport(viewport.x, viewport.y, viewport.width, viewport.height, 0.0f, 1.0f);
+
+        commandList->SetScissorRect(static_cast<int>(viewport.x),
+                                    static_cast<int>(viewport.y),
+                                    static_cast<int>(viewport.x + viewport.width),
+                                    static_cast<int>(viewport.y + viewport.height));
+
+        commandList->SetConstantBuffer(_vsPerFrameConstants.get(), 0);
+    }
+
+    void DeferredRenderingPipeline::SubmitModel(const Model& model,
+                                                const Math::Matrix4x4& worldMatrix,
+                                                const MaterialPropertyBlock* propertyBlock,
+                                                uint32_t lod)
+    {
+        DrawItem item = { &model, &worldMatrix, propertyBlock, lod };
+        SubmitModels({ &item, 1 });
+    }
+
+    void DeferredRenderingPipeline::SubmitModels(std::span<const DrawItem> drawItems)
+    {
+        // Recorded before the draws, on the list that runs first
+        _PackCustomMaterialConstants(drawItems);
+
+        auto recordDraw = [this, drawItems](CommandList* commandList, size_t index)
+        {
+            const DrawItem& item = drawItems[index];
+            std::span<const CustomConstantsRange> customConstants(
+                _customConstantRanges.begin() + _drawCustomConstants[index],
+                _customConstantRanges.begin() + _drawCustomConstants[index + 1]);
+            _RecordModel(commandList, *item.model, *item.worldMatrix, item.lod, customConstants);
+        };
+
+        if (drawItems.size() < 2 * MIN_DRAWS_PER_CHUNK)
+        {
+            for (size_t i = 0; i < drawItems.size(); ++i)
+            {
+                recordDraw(_commandList.get(), i);
+            }
+            return;
+        }
+
+        // The clears, the per-frame and the material constants have to reach the GPU before the chunks.
+        // The shared list goes on from the default state.
+        _commandList->EndRecording();
+        _commandList->Execute();
+        _commandList->BeginRecording();
+
+        _gBufferRecorder.AddRange(drawItems.size(),
+                                  MIN_DRAWS_PER_CHUNK,
+                                  [this, &recordDraw](CommandList* commandList, size_t begin, size_t end)
+                                  {
+                                      _BindGBuffer(commandList);
+                                      for (size_t i = begin; i < end; ++i)
+                                      {
+                                          recordDraw(commandList, i);
+                                      }
+                                  });
+        _gBufferRecorder.Submit();
+    }
+
+    void DeferredRenderingPipeline::_PackCustomMaterialConstants(std::span<const DrawItem> drawItems)
+    {
+        _customMaterialConstants.Reset();
+        _customConstantRanges.clear();
+        _drawCustomConstants.clear();
+        _sharedCustomConstants.clear();
+
+        for (const DrawItem& item : drawItems)
+        {
+            _drawCustomConstants.push_back(_customConstantRanges.size());
+            if (!item.model->IsLoaded())
+            {
+                continue;
+            }
+
+            const auto& materials = item.model->GetMaterials();
+            const bool hasPropertyBlock = item.propertyBlock && !item.propertyBlock->IsEmpty();
+
+            for (size_t materialIndex = 0; materialIndex < materials.size(); ++materialIndex)
+            {
+                const Material& material = materials[materialIndex];
+                CustomConstantsRange range;
+                if (hasPropertyBlock && materialIndex == item.propertyBlock->GetMaterialIndex())
+                {
+                    uint32_t size = item.propertyBlock->GetSize();
+                    range = { _customMaterialConstants.Push(item.propertyBlock->GetData(), size), size };
+                }
+                else if (!material.parameters.empty())
+                {
+                    auto [it, isNew] = _sharedCustomConstants.try_emplace(&material);
+                    if (isNew)
+                    {
+                        uint32_t size = static_cast<uint32_t>(material.parameters.size());
+                        it->second = { _customMaterialConstants.Push(material.parameters.data(), size), size };
+                    }
+                    range = it->second;
+                }
+                _customConstantRanges.push_back(range);
+            }
+        }
+        _drawCustomConstants.push_back(_customConstantRanges.size());
+
+        _customMaterialConstants.Upload(_commandList.get());
     }
 
-    void DeferredRenderingPipeline::SubmitModel(const Model& model, const Math::Matrix4x4& worldMatrix)
+    void DeferredRenderingPipeline::_RecordModel(CommandList* commandList,
+                                                 const Model& model,
+                                                 const Math::Matrix4x4& worldMatrix,
+                                                 uint32_t lod,
+                                                 std::span<const CustomConstantsRange> customConstants)
     {
         if (!model.IsLoaded())
             return;
 
         VS_PerObjectConstants vsPerObjectData;
         vsPerObjectData.World = Math::Matrix4x4::CreateTranspose(worldMatrix);
-        _vsPerObjectConstants->UpdateData(_commandList.get(), &vsPerObjectData, sizeof(VS_PerObjectConstants));
-        _commandList->SetConstantBuffer(_vsPerObjectConstants.get(), 1);
+        _vsPerObjectConstants->UpdateData(commandList, &vsPerObjectData, sizeof(VS_PerObjectConstants));
+        commandList->SetConstantBuffer(_vsPerObjectConstants.get(), 1);
 
-        _commandList->SetSampler(_materialSampler.get(), 0);
+        commandList->SetSampler(_materialSampler.get(), 0);
 
-        _commandList->SetPrimitiveTopology(PrimitiveTopology::TRIANGLELIST);
+        commandList->SetPrimitiveTopology(PrimitiveTopology::TRIANGLELIST);
 
         Frustum frustum{};
         DirectX::XMMATRIX matWorld = Math::LoadMatrix(worldMatrix);
@@ -410,13 +395,13 @@ namespace Frost
 #ifdef FT_DEBUG
             if (Debug::RendererConfig::wireframeMode)
             {
-                _commandList->SetRasterizerState(RasterizerMode::Wireframe);
+                commandList->SetRasterizerState(RasterizerMode::Wireframe);
             }
             else
-                _commandList->SetRasterizerState(material.backFaceCulling ? RasterizerMode::Solid
+                commandList->SetRasterizerState(material.backFaceCulling ? RasterizerMode::Solid
                                                                           : RasterizerMode::SolidCullNone);
 #else
-            _commandList->SetRasterizerState(material.backFaceCulling ? RasterizerMode::Solid
+            commandList->SetRasterizerState(material.backFaceCulling ? RasterizerMode::Solid
                                                                       : RasterizerMode::SolidCullNone);
 #endif
 
@@ -424,128 +409,121 @@ namespace Frost
             Shader* vs = material.customVertexShader ? material.customVertexShader.get() : _gBufferVertexShader.get();
             Shader* ps = material.customPixelShader ? material.customPixelShader.get() : _gBufferPixelShader.get();
 
-            _commandList->SetShader(vs);
-            _commandList->SetShader(ps);
+            commandList->SetShader(vs);
+            commandList->SetShader(ps);
 
             if (material.customVertexShader)
             {
-                InputLayout* layout = _GetOrCreateInputLayout(vs);
-                _commandList->SetInputLayout(layout);
+                InputLayout* layout = _GetOrCreateInputLayout(vs, mesh.GetVertexLayout());
+                commandList->SetInputLayout(layout);
+            }
+            else if (mesh.GetVertexLayout() == VertexLayout::Compact)
+            {
+                commandList->SetInputLayout(_gBufferCompactInputLayout.get());
             }
             else
             {
-                _commandList->SetInputLayout(_gBufferInputLayout.get());
+                commandList->SetInputLayout(_gBufferInputLayout.get());
             }
 
             // Geometry Shader
             if (material.geometryShader)
             {
-                _commandList->SetShader(material.geometryShader.get());
+                commandList->SetShader(material.geometryShader.get());
             }
             else
             {
-                _commandList->UnbindShader(ShaderType::Geometry);
+                commandList->UnbindShader(ShaderType::Geometry);
             }
 
             // Hull & Domain
             if (material.hullShader && material.domainShader)
             {
-                _commandList->SetShader(material.hullShader.get());
-                _commandList->SetShader(material.domainShader.get());
+                commandList->SetShader(material.hullShader.get());
+                commandList->SetShader(material.domainShader.get());
 
-                _commandList->SetPrimitiveTopology(PrimitiveTopology::PATCHLIST_3);
+                commandList->SetPrimitiveTopology(PrimitiveTopology::PATCHLIST_3);
             }
             else
             {
-                _commandList->UnbindShader(ShaderType::Hull);
-                _commandList->UnbindShader(ShaderType::Domain);
+                commandList->UnbindShader(ShaderType::Hull);
+                commandList->UnbindShader(ShaderType::Domain);
 
-                _commandList->SetPrimitiveTopology(PrimitiveTopology::TRIANGLELIST);
+                commandList->SetPrimitiveTopology(PrimitiveTopology::TRIANGLELIST);
             }
 
             PS_MaterialConstants psMaterialData;
             psMaterialData.UVTiling = material.uvTiling;
             psMaterialData.UVOffset = material.uvOffset;
-            _psMaterialConstants->UpdateData(_commandList.get(), &psMaterialData, sizeof(PS_MaterialConstants));
-            _commandList->SetConstantBuffer(_psMaterialConstants.get(), 2);
+            _psMaterialConstants->UpdateData(commandList, &psMaterialData, sizeof(PS_MaterialConstants));
+            commandList->SetConstantBuffer(_psMaterialConstants.get(), 2);
 
-            if (!material.parameters.empty())
+            // A model that finished loading after the constants were packed draws without them this frame
+            if (mesh.GetMaterialIndex() < customConstants.size() && customConstants[mesh.GetMaterialIndex()].size > 0)
             {
-                if (_customMaterialConstantBuffer->GetConfig().size < material.parameters.size())
-                {
-                    int32_t requiredSize = static_cast<uint32_t>(material.parameters.size());
-                    uint32_t alignedSize = (requiredSize + 15) & ~15;
-
-                    BufferConfig config = { .usage = BufferUsage::CONSTANT_BUFFER,
-                                            .size = alignedSize,
-                                            .dynamic = true,
-                                            .debugName = "DS_CustomMaterial_Resized" };
-
-                    _customMaterialConstantBuffer = RendererAPI::GetRenderer()->CreateBuffer(config);
-                }
-
-                _customMaterialConstantBuffer->UpdateData(
-                    _commandList.get(), material.parameters.data(), material.parameters.size());
-                _commandList->SetConstantBuffer(_customMaterialConstantBuffer.get(), 3);
+                const CustomConstantsRange& customRange = customConstants[mesh.GetMaterialIndex()];
+                commandList->SetConstantBufferRange(
+                    _customMaterialConstants.GetBuffer(), 3, customRange.offset, customRange.size);
             }
 
             if (!material.albedoTextures.empty() && material.albedoTextures[0]->IsLoaded())
             {
-                _commandList->SetTexture(material.albedoTextures[0].get(), 0);
+                commandList->SetTexture(material.albedoTextures[0].get(), 0);
             }
             else
             {
-                _commandList->SetTexture(_defaultAlbedoTexture.get(), 0);
+                commandList->SetTexture(_defaultAlbedoTexture.get(), 0);
             }
 
             if (!material.normalTextures.empty() && material.normalTextures[0]->IsLoaded())
             {
-                _commandList->SetTexture(material.normalTextures[0].get(), 1);
+                commandList->SetTexture(material.normalTextures[0].get(), 1);
             }
             else
             {
-                _commandList->SetTexture(_defaultNormalTexture.get(), 1);
+                commandList->SetTexture(_defaultNormalTexture.get(), 1);
             }
 
             if (!material.metallicTextures.empty() && material.metallicTextures[0]->IsLoaded())
             {
-                _commandList->SetTexture(material.metallicTextures[0].get(), 2);
+                commandList->SetTexture(material.metallicTextures[0].get(), 2);
             }
             else
             {
-                _commandList->SetTexture(_defaultMetallicTexture.get(), 2);
+                commandList->SetTexture(_defaultMetallicTexture.get(), 2);
             }
 
             if (!material.roughnessTextures.empty() && material.roughnessTextures[0]->IsLoaded())
             {
-                _commandList->SetTexture(material.roughnessTextures[0].get(), 3);
+                commandList->SetTexture(material.roughnessTextures[0].get(), 3);
             }
             else
             {
-                _commandList->SetTexture(_defaultRoughnessTexture.get(), 3);
+                commandList->SetTexture(_defaultRoughnessTexture.get(), 3);
             }
 
             if (!material.aoTextures.empty() && material.aoTextures[0]->IsLoaded())
             {
-                _commandList->SetTexture(material.aoTextures[0].get(), 4);
+                commandList->SetTexture(material.aoTextures[0].get(), 4);
             }
             else
             {
-                _commandList->SetTexture(_defaultAOTexture.get(), 4);
+                commandList->SetTexture(_defaultAOTexture.get(), 4);
             }
 
             if (!material.emissiveTextures.empty() && material.emissiveTextures[0]->IsLoaded())
             {
-                _commandList->SetTexture(material.emissiveTextures[0].get(), 5);
+                commandList->SetTexture(material.emissiveTextures[0].get(), 5);
             }
             else
             {
-                _commandList->SetTexture(_defaultEmissionTexture.get(), 5);
+                commandList->SetTexture(_defaultEmissionTexture.get(), 5);
             }
 
-            _commandList->SetVertexBuffer(mesh.GetVertexBuffer(), mesh.GetVertexStride(), 0);
-            _commandList->SetIndexBuffer(mesh.GetIndexBuffer(), 0);
-            _commandList->DrawIndexed(mesh.GetIndexCount(), 0, 0);
+            const MeshLod& meshLod = mesh.GetLod(lod);
+            commandList->SetVertexBuffer(mesh.GetVertexBuffer(), mesh.GetVertexStride(), 0);
+            commandList->SetIndexBuffer(mesh.GetIndexBuffer(), 0);
+            commandList->DrawIndexed(meshLod.indexCount, meshLod.indexOffset, 0);
         }
     }
 } // namespace Frost
\ No newline at end of file
@@ -1,15 +1,23 @@
 ﻿#pragma once
 
 #include "Frost/Core/Core.h"
+#include "Frost/Renderer/Format.h"
 #include "Frost/Renderer/Pipeline.h"
 #include "Frost/Scene/Components/Camera.h"
 #include "Frost/Scene/Components/Light.h"
 #include "Frost/Scene/Components/WorldTransform.h"
 #include "Frost/Utils/Math/Matrix.h"
 #include "Frost/Renderer/Frustum.h"
+#include "Frost/Renderer/ConstantBufferArena.h"
+#include "Frost/Renderer/ParallelCommandRecorder.h"
+#include "Frost/Renderer/Vertex.h"
 
+#include <array>
 #include <memory>
+#include <mutex>
+#include <span>
 #include <unordered_map>
+#include <vector>
 
 namespace Frost
 {
@@ -20,6 +28,8 @@ namespace Frost
     class Sampler;
     class Buffer;
     class Model;
+    class MaterialPropertyBlock;
+    struct Material;
     class Component::Camera;
     class Component::Light;
     struct Component::WorldTransform;
@@ -27,6 +37,34 @@ namespace Frost
     class DeferredRenderingPipeline : public Pipeline
     {
     public:
+        struct DrawItem
+        {
+            const Model* model;
+            const Math::Matrix4x4* worldMatrix;
+            // Overrides the custom parameters of one material of the model when not empty
+            const MaterialPropertyBlock* propertyBlock = nullptr;
+            // Clamped to the levels of each mesh
+            uint32_t lod = 0;
+        };
+
+        // Transient textures of the render graph, set before each frame
+        struct GBuffer
+        {
+            Texture* albedo = nullptr;
+            Texture* normal = nullptr;
+            Texture* worldPosition = nullptr;
+            Texture* material = nullptr;
+            Texture* emission = nullptr;
+            Texture* depth = nullptr;
+        };
+
+        static constexpr Format ALBEDO_FORMAT = Format::RGBA8_UNORM;
+        static constexpr Format NORMAL_FORMAT = Format::RGBA16_FLOAT;
+        static constexpr Format WORLD_POSITION_FORMAT = Format::RGBA32_FLOAT;
+        static constexpr Format MATERIAL_FORMAT = Format::RGBA8_UNORM;
+        static constexpr Format EMISSION_FORMAT = Format::RGBA16_FLOAT;
+        static constexpr Format DEPTH_FORMAT = Format::R24G8_TYPELESS;
+
         DeferredRenderingPipeline();
         ~DeferredRenderingPipeline();
 
@@ -34,45 +72,38 @@ namespace Frost
         void Shutdown() override;
         void OnWindowResize(WindowResizeEvent& e) override;
 
-        void OnResize(uint32_t width, uint32_t height);
+        void SetGBuffer(const GBuffer& gbuffer) { _gbuffer = gbuffer; }
+        const GBuffer& GetGBuffer() const { return _gbuffer; }
 
         void BeginFrame(const Component::Camera& camera,
                         const Component::WorldTransform& cameraTransform,
                         const Math::Matrix4x4& viewMatrix,
                         const Math::Matrix4x4& projectionMatrix,
                         const Viewport& viewport);
-        void SubmitModel(const Model& model, const Math::Matrix4x4& worldMatrix);
+        void SubmitModel(const Model& model,
+                         const Math::Matrix4x4& worldMatrix,
+                         const MaterialPropertyBlock* propertyBlock = nullptr,
+                         uint32_t lod = 0);
+        // Large draw lists are split in chunks recorded on worker threads, the chunks are submitted at once.
+        // The custom material parameters of all the draws are uploaded together beforehand.
+        void SubmitModels(std::span<const DrawItem> drawItems);
         /* void EndFrame(const Component::Camera& camera,
                       const Component::WorldTransform& cameraTransform,
                       const std::vector<std::pair<Component::Light, Component::WorldTransform>>& lights,
                       const Viewport& viewport);
         */
 
-        std::shared_ptr<Texture> GetAlbedoTexture() const { return _albedoTexture; }
-        std::shared_ptr<Texture> GetNormalTexture() const { return _normalTexture; }
-        std::shared_ptr<Texture> GetWorldPositionTexture() const { return _worldPositionTexture; }
-        std::shared_ptr<Texture> GetMaterialTexture() const { return _materialTexture; }
-        std::shared_ptr<Texture> GetDepthStencilTexture() const { return _depthStencilTexture; }
-        std::shared_ptr<Texture> GetEmissionTexture() const { return _emissionTexture; }
-
         CommandList* GetCommandList() const { return _commandList.get(); }
         std::shared_ptr<CommandList> GetSharedCommandList() const { return _commandList; }
 
     private:
-        void _CreateGBufferTextures(uint32_t width, uint32_t height);
-
-        // G-Buffer Textures
-        std::shared_ptr<Texture> _albedoTexture;
-        std::shared_ptr<Texture> _normalTexture;
-        std::shared_ptr<Texture> _worldPositionTexture;
-        std::shared_ptr<Texture> _materialTexture;
-        std::shared_ptr<Texture> _emissionTexture;
-        std::shared_ptr<Texture> _depthStencilTexture;
+        GBuffer _gbuffer;
 
         // G-Buffer Pass Resources
         std::shared_ptr<Shader> _gBufferVertexShader;
         std::shared_ptr<Shader> _gBufferPixelShader;
         std::unique_ptr<InputLayout> _gBufferInputLayout;
+        std::unique_ptr<InputLayout> _gBufferCompactInputLayout;
         std::unique_ptr<Sampler> _materialSampler;
 
         // Lighting Pass Resources
@@ -96,17 +127,41 @@ namespace Frost
         std::unique_ptr<Texture> _defaultEmissionTexture;
 
         // Materials buffers
-        std::shared_ptr<Buffer> _customMaterialConstantBuffer;
-        std::unordered_map<Shader*, std::unique_ptr<InputLayout>> _inputLayoutCache;
+        struct CustomConstantsRange
+        {
+            uint32_t offset = 0;
+            uint32_t size = 0; // 0 when the material has no custom parameters
+        };
+
+        ConstantBufferArena _customMaterialConstants{ "DS_CustomMaterial" };
+        // One range per material of each draw, the ranges of the draw i start at _drawCustomConstants[i] and end
+        // at _drawCustomConstants[i + 1]
+        std::vector<CustomConstantsRange> _customConstantRanges;
+        std::vector<size_t> _drawCustomConstants;
+        // Shared materials are uploaded once per submit
+        std::unordered_map<const Material*, CustomConstantsRange> _sharedCustomConstants;
+        // One layout per vertex layout of the meshes drawn with each custom vertex shader
+        std::unordered_map<Shader*, std::array<std::unique_ptr<InputLayout>, 2>> _inputLayoutCache;
+        std::mutex _inputLayoutMutex;
 
         std::shared_ptr<CommandList> _commandList;
+        ParallelCommandRecorder _gBufferRecorder;
+        Viewport _frameViewport;
 
         bool _enabled = true;
-        uint32_t _currentWidth = 0;
-        uint32_t _currentHeight = 0;
 
     private:
         void _CreateDefaultTextures();
-        InputLayout* _GetOrCreateInputLayout(Shader* vertexShader);
+        InputLayout* _GetOrCreateInputLayout(Shader* vertexShader, VertexLayout vertexLayout);
+        void _BindGBuffer(CommandList* commandList);
+        void _PackCustomMaterialConstants(std::span<const DrawItem> drawItems);
+        void _RecordModel(CommandList* commandList,
+                          const Model& model,
+                          const Math::Matrix4x4& worldMatrix,
+                          uint32_t lod,
+                          std::span<const CustomConstantsRange> customConstants);
+
+        // Below two chunks worth of draws, the list is recorded on the calling thread
+        static constexpr size_t MIN_DRAWS_PER_CHUNK = 64;
     };
 } // namespace Frost
\ No newline at end of file
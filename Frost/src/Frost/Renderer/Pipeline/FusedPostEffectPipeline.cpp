@@ -0,0 +1,178 @@
+#include "FusedPostEffectPipeline.h"
+#include "Frost/Debugging/Logger.h"
+#include "Frost/Renderer/Buffer.h"
+#include "Frost/Renderer/CommandList.h"
+#include "Frost/Renderer/Renderer.h"
+#include "Frost/Renderer/RendererAPI.h"
+#include "Frost/Renderer/Sampler.h"
+#include "Frost/Renderer/Shader.h"
+
+#include "Frost/Renderer/DX11/RendererDX11.h"
+#include "Frost/Renderer/DX11/SamplerDX11.h"
+
+#include <format>
+#include <fstream>
+#include <sstream>
+
+namespace Frost
+{
+    static std::string ReadTextFile(const std::filesystem::path& path)
+    {
+        std::ifstream in(path, std::ios::binary);
+        std::stringstream buffer;
+        buffer << in.rdbuf();
+        return buffer.str();
+    }
+
+    FusedPostEffectPipeline::FusedPostEffectPipeline()
+    {
+        Initialize();
+        RendererAPI::GetRenderer()->RegisterPipeline(this);
+    }
+
+    FusedPostEffectPipeline::~FusedPostEffectPipeline()
+    {
+        Shutdown();
+        RendererAPI::GetRenderer()->UnregisterPipeline(this);
+    }
+
+    void FusedPostEffectPipeline::Initialize()
+    {
+        // Any post effect vertex shader works, they all draw the same fullscreen triangle
+        ShaderDesc vsDesc = { .type = ShaderType::Vertex,
+                              .debugName = "VS_FusedPostEffect",
+                              .filePath = "../Frost/resources/shaders/PostEffect/VS_ColorCorrection.hlsl" };
+        _vertexShader = Shader::Create(vsDesc);
+
+        SamplerConfig samplerConfig = { .filter = Filter::MIN_MAG_MIP_LINEAR,
+                                        .addressU = AddressMode::CLAMP,
+                                        .addressV = AddressMode::CLAMP,
+                                        .addressW = AddressMode::CLAMP };
+        _sampler = std::make_unique<SamplerDX11>(samplerConfig);
+    }
+
+    void FusedPostEffectPipeline::Shutdown()
+    {
+        _permutations.clear();
+        _sampler.reset();
+        _vertexShader.reset();
+    }
+
+    bool FusedPostEffectPipeline::IsAvailable(const PostEffectChain::Pass& pass)
+    {
+        return _GetOrCreatePermutation(pass) != nullptr;
+    }
+
+    void FusedPostEffectPipeline::Render(CommandList* commandList,
+                                         const PostEffectChain::Pass& pass,
+                                         Texture* source,
+                                         Texture* destination)
+    {
+        Permutation* permutation = _GetOrCreatePermutation(pass);
+        if (!permutation)
+        {
+            return;
+        }
+
+        _constantData.assign(permutation->layout.size, 0);
+        _textures.assign(permutation->textureCount, nullptr);
+
+        const Texture** textures = _textures.data();
+        for (size_t i = 0; i < pass.effects.size(); ++i)
+        {
+            pass.effects[i]->GetFusedBindings(_constantData.data() + permutation->layout.offsets[i], textures);
+            textures += pass.effects[i]->GetFusedStage().textureCount;
+        }
+
+        permutation->constants->UpdateData(commandList, _constantData.data(), permutation->layout.size);
+
+        commandList->SetRenderTargets(1, &destination, nullptr);
+        commandList->SetShader(_vertexShader.get());
+        commandList->SetShader(permutation->pixelShader.get());
+        commandList->SetInputLayout(nullptr);
+
+        commandList->SetTexture(source, 0);
+        for (uint32_t i = 0; i < permutation->textureCount; ++i)
+        {
+            commandList->SetTexture(_textures[i], i + 1);
+        }
+
+        commandList->SetSampler(_sampler.get(), 0);
+        commandList->SetConstantBuffer(permutation->constants.get(), 0);
+
+        commandList->SetPrimitiveTopology(PrimitiveTopology::TRIANGLELIST);
+        commandList->Draw(3, 0);
+    }
+
+    FusedPostEffectPipeline::Permutation* FusedPostEffectPipeline::_GetOrCreatePermutation(
+        const PostEffectChain::Pass& pass)
+    {
+        auto it = _permutations.find(pass.permutationKey);
+        if (it != _permutations.end())
+        {
+            return it->second.pixelShader ? &it->second : nullptr;
+        }
+
+        // A failed permutation is remembered too, so that it is not regenerated nor reported every frame
+        Permutation& permutation = _permutations[pass.permutationKey];
+
+        std::vector<FusedStage> stages = PostEffectChain::GetStages(pass);
+        std::vector<std::string> fragments;
+        for (const auto& stage : stages)
+        {
+            std::string fragment = ReadTextFile(stage.fragmentPath);
+            if (fragment.empty())
+            {
+                FT_ENGINE_ERROR("FusedPostEffectPipeline: cannot read fragment '{}', the effects run unfused",
+                                stage.fragmentPath);
+                return nullptr;
+            }
+
+            fragments.push_back(std::move(fragment));
+            permutation.textureCount += stage.textureCount;
+        }
+
+        // The shader system compiles from files. The content is only rewritten when it changes, so that the
+        // shader cache keeps hitting
+        std::string source = PostEffectChain::GenerateShader(stages, fragments);
+        std::string shaderName = std::format("PS_Fused_{:016x}", pass.permutationKey);
+        std::filesystem::path shaderPath = std::filesystem::path(GENERATED_SHADER_DIRECTORY) / (shaderName + ".hlsl");
+
+        if (ReadTextFile(shaderPath) != source)
+        {
+            std::error_code ec;
+            std::filesystem::create_directories(shaderPath.parent_path(), ec);
+
+            std::ofstream out(shaderPath, std::ios::binary | std::ios::trunc);
+            out << source;
+        }
+
+        ShaderDesc psDesc = { .type = ShaderType::Pixel,
+                              .debugName = shaderName,
+                              .filePath = shaderPath.generic_string() };
+
+        // Compiled through the cache first, a generated shader that does not compile is not worth an assert
+        RendererDX11* rendererDX11 = static_cast<RendererDX11*>(RendererAPI::GetRenderer());
+        std::vector<char> bytecode;
+        std::string log;
+        if (!rendererDX11->GetShaderCache().GetBytecode(psDesc, bytecode, &log))
+        {
+            FT_ENGINE_WARN("FusedPostEffectPipeline: {} failed to compile, the effects run unfused\n{}",
+                           psDesc.debugName,
+                           log);
+            return nullptr;
+        }
+
+        permutation.pixelShader = Shader::Create(psDesc);
+
+        permutation.layout = PostEffectChain::GetConstantLayout(stages);
+        permutation.constants =
+            RendererAPI::GetRenderer()->CreateBuffer(BufferConfig{ .usage = BufferUsage::CONSTANT_BUFFER,
+                                                                   .size = permutation.layout.size,
+                                                                   .dynamic = true,
+                                                                   .debugName = "CB_FusedPostEffect" });
+
+        FT_ENGINE_INFO("FusedPostEffectPipeline: {} effects fused into {}", stages.size(), psDesc.debugName);
+        return &permutation;
+    }
+} // namespace Frost
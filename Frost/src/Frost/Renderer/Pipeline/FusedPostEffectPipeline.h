@@ -0,0 +1,57 @@
+#pragma once
+
+#include "Frost/Renderer/Pipeline.h"
+#include "Frost/Renderer/PostEffectChain.h"
+
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+namespace Frost
+{
+    class CommandList;
+    class Texture;
+    class Shader;
+    class Sampler;
+    class Buffer;
+
+    // Draws a run of per-pixel post effects in a single fullscreen pass, one generated shader per permutation
+    class FusedPostEffectPipeline : public Pipeline
+    {
+    public:
+        FusedPostEffectPipeline();
+        ~FusedPostEffectPipeline();
+
+        void Initialize() override;
+        void Shutdown() override;
+
+        // Builds the permutation of a fused pass on first use. False when it failed to compile, the effects then
+        // have to run through their own passes
+        bool IsAvailable(const PostEffectChain::Pass& pass);
+
+        void Render(CommandList* commandList, const PostEffectChain::Pass& pass, Texture* source, Texture* destination);
+
+    private:
+        struct Permutation
+        {
+            std::shared_ptr<Shader> pixelShader;
+            std::shared_ptr<Buffer> constants;
+            PostEffectChain::ConstantLayout layout;
+            uint32_t textureCount = 0;
+        };
+
+        Permutation* _GetOrCreatePermutation(const PostEffectChain::Pass& pass);
+
+        std::shared_ptr<Shader> _vertexShader;
+        std::unique_ptr<Sampler> _sampler;
+        std::unordered_map<uint64_t, Permutation> _permutations;
+
+        // Scratch storage reused every frame
+        std::vector<uint8_t> _constantData;
+        std::vector<const Texture*> _textures;
+
+        static constexpr const char* GENERATED_SHADER_DIRECTORY = ".frost/shaders/generated";
+    };
+} // namespace Frost
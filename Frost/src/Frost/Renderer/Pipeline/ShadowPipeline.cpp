@@ -9,6 +9,7 @@
 #include "Frost/Utils/Math/Matrix.h"
 #include "Frost/Utils/Math/Transform.h"
 #include "Frost/Scene/Components/StaticMesh.h"
+#include "Frost/Scene/Components/WorldMatrix.h"
 #include "Frost/Scene/Components/WorldTransform.h"
 #include "Frost/Scene/Scene.h"
 
@@ -16,6 +17,8 @@
 #include "Frost/Renderer/DX11/InputLayoutDX11.h"
 #include "Frost/Renderer/DX11/SamplerDX11.h"
 #include "Frost/Renderer/DX11/TextureDX11.h"
+#include <algorithm>
+#include <cmath>
 #include <variant>
 
 // windows.....
@@ -34,8 +37,29 @@ namespace Frost
     {
         DirectX::XMMATRIX World;
         DirectX::XMMATRIX LightViewProj;
+        DirectX::XMFLOAT4 AtlasRect = { 0.f, 0.f, 1.f, 1.f }; // Offset and scale of the shadow tile, in atlas UV
     };
 
+    static uint64_t HashBytes(uint64_t hash, const void* data, size_t size)
+    {
+        // FNV-1a
+        const auto* bytes = static_cast<const uint8_t*>(data);
+        for (size_t i = 0; i < size; ++i)
+        {
+            hash ^= bytes[i];
+            hash *= 0x100000001b3ull;
+        }
+        return hash;
+    }
+
+    template<typename T>
+    static uint64_t HashValue(uint64_t hash, const T& value)
+    {
+        return HashBytes(hash, &value, sizeof(T));
+    }
+
+    constexpr uint64_t HASH_SEED = 0xcbf29ce484222325ull;
+
     struct alignas(16) DirectionalLightData : public LightData
     {
         Math::Vector3 CameraPosition;
@@ -187,6 +211,15 @@ namespace Frost
         _shadowVertexShader = Shader::Create(vsDesc);
         _shadowPixelShader = Shader::Create(psDesc);
 
+        vsDesc = { .type = ShaderType::Vertex,
+                   .debugName = "VS_ShadowTile",
+                   .filePath = "../Frost/resources/shaders/VS_ShadowTile.hlsl" };
+        psDesc = { .type = ShaderType::Pixel,
+                   .debugName = "PS_ShadowCopy",
+                   .filePath = "../Frost/resources/shaders/PS_ShadowCopy.hlsl" };
+        _shadowTileVertexShader = Shader::Create(vsDesc);
+        _shadowCopyPixelShader = Shader::Create(psDesc);
+
         InitLightShaders();
 
         auto* renderer = RendererAPI::GetRenderer();
@@ -222,6 +255,8 @@ namespace Frost
                                                .addressV = AddressMode::CLAMP,
                                                .addressW = AddressMode::CLAMP };
         _gBufferSampler = std::make_unique<SamplerDX11>(gBufferSamplerConfig);
+
+        _CreateShadowAtlas();
     }
 
     void ShadowPipeline::Shutdown()
@@ -232,6 +267,8 @@ namespace Frost
         _gBufferSampler.reset();
         _shadowVertexShader.reset();
         _shadowPixelShader.reset();
+        _shadowTileVertexShader.reset();
+        _shadowCopyPixelShader.reset();
         _pointLightVertexShader.reset();
         _pointLightPixelShader.reset();
         _directionalLightVertexShader.reset();
@@ -246,18 +283,15 @@ namespace Frost
         _environmentLightPixelShader.reset();
         _currentEnvironmentMap.reset();
 
-        for_each(
-            _shadowMaps.begin(), _shadowMaps.end(), [](auto& shadowPair) { shadowPair.second.shadowTexture.reset(); });
         _shadowMaps.clear();
-
-        _albedoTexture.reset();
-        _normalTexture.reset();
-        _worldPositionTexture.reset();
-        _materialTexture.reset();
-        _emissionTexture.reset();
-        _luminanceTexture1.reset();
-        _luminanceTexture2.reset();
-        _finalLitTexture.reset();
+        _shadowAtlasTiles.Clear();
+        _shadowAtlas.reset();
+        _staticShadowAtlas.reset();
+        _shadowCasters.clear();
+        _shadowCasterStates.clear();
+
+        _gbuffer = {};
+        _targets = {};
         _shadowInputLayout.reset();
         _commandList.reset();
     }
@@ -268,78 +302,19 @@ namespace Frost
         _currentEnvIntensity = intensity;
     }
 
-    void ShadowPipeline::CreateTextures(uint32_t width, uint32_t height)
+    void ShadowPipeline::SetLightTargets(const LightTargets& targets)
     {
-        for_each(
-            _shadowMaps.begin(), _shadowMaps.end(), [](auto& shadowPair) { shadowPair.second.shadowTexture.reset(); });
-
-        _albedoTexture.reset();
-        _normalTexture.reset();
-        _worldPositionTexture.reset();
-        _materialTexture.reset();
-        _emissionTexture.reset();
-        _luminanceTexture1.reset();
-        _luminanceTexture2.reset();
-        _finalLitTexture.reset();
-
-        TextureConfig lumConfig = { .format = Format::RGBA32_FLOAT,
-                                    .width = width,
-                                    .height = height,
-                                    .isRenderTarget = true,
-                                    .isShaderResource = true,
-                                    .hasMipmaps = false };
-        _luminanceTexture1 = std::make_shared<TextureDX11>(lumConfig);
-        _luminanceTexture2 = std::make_shared<TextureDX11>(lumConfig);
-
-        TextureConfig litConfig = { .format = Format::RGBA8_UNORM,
-                                    .width = width,
-                                    .height = height,
-                                    .isRenderTarget = true,
-                                    .isShaderResource = true,
-                                    .hasMipmaps = false };
-        _finalLitTexture = std::make_unique<TextureDX11>(litConfig);
-    }
-
-    void ShadowPipeline::OnResize(uint32_t width, uint32_t height)
-    {
-        if (width == 0 || height == 0)
-            return;
-
-        if (_currentWidth != width || _currentHeight != height)
+        _targets = targets;
+        if (_targets.output)
         {
-            _currentWidth = width;
-            _currentHeight = height;
-
-            _vsShadowConstants.reset();
-            _lightPassBuffer.reset();
-
-            constexpr size_t maxLightDataSize = std::max({ sizeof(DirectionalLightData),
-                                                           sizeof(PointLightData),
-                                                           sizeof(SpotLightData),
-                                                           sizeof(AmbiantLightData) });
-
-            auto* renderer = RendererAPI::GetRenderer();
-            _vsShadowConstants = renderer->CreateBuffer(BufferConfig{ .usage = BufferUsage::CONSTANT_BUFFER,
-                                                                      .size = sizeof(VS_ShadowConstants),
-                                                                      .dynamic = true,
-                                                                      .debugName = "VS_ShadowConstants" });
-
-            _lightPassBuffer = renderer->CreateBuffer(BufferConfig{ .usage = BufferUsage::CONSTANT_BUFFER,
-                                                                    .size = maxLightDataSize,
-                                                                    .dynamic = true,
-                                                                    .debugName = "VS_PS_LightPassBuffer" });
-
-            CreateTextures(width, height);
+            _currentWidth = _targets.output->GetWidth();
+            _currentHeight = _targets.output->GetHeight();
         }
     }
 
     void ShadowPipeline::SetGBufferData(DeferredRenderingPipeline* deferredPipeline, Scene* scene)
     {
-        _albedoTexture = deferredPipeline->GetAlbedoTexture();
-        _normalTexture = deferredPipeline->GetNormalTexture();
-        _worldPositionTexture = deferredPipeline->GetWorldPositionTexture();
-        _materialTexture = deferredPipeline->GetMaterialTexture();
-        _emissionTexture = deferredPipeline->GetEmissionTexture();
+        _gbuffer = deferredPipeline->GetGBuffer();
         _commandList = deferredPipeline->GetSharedCommandList();
         _scene = scene;
     }
@@ -379,16 +354,34 @@ namespace Frost
     }
 
     void ShadowPipeline::ShadowPass(std::vector<std::pair<Component::Light, Component::WorldTransform>> lightPairs,
+                                    const std::vector<entt::entity>& lightEntities,
                                     const Component::Camera& camera,
                                     const Component::WorldTransform& cameraTransform,
                                     const Viewport& viewport)
     {
         _virtualLightPairs.clear();
+        _virtualLightKeys.clear();
+        _virtualLightTileSizes.clear();
+        ++_frameIndex;
+
         int i = 0;
         for (; i < lightPairs.size(); i++)
         {
+            // Every virtual light pushed below gets a key, the faces and cascades of a light differ by their index
+            const uint64_t lightKey = _GetLightKey(lightEntities[i], lightPairs[i].first.GetType());
+            uint32_t subIndex = 0;
+            auto addLightShadow = [&](uint32_t tileSize)
+            {
+                _virtualLightKeys.push_back(HashValue(lightKey, subIndex++));
+                _virtualLightTileSizes.push_back(tileSize);
+            };
+
             if (lightPairs[i].first.GetType() == Component::LightType::Point)
             {
+                auto* cfg = std::get_if<Component::LightPoint>(&lightPairs[i].first.config);
+                uint32_t tileSize =
+                    _GetLocalShadowTileSize(lightPairs[i].second.position, cfg->radius, camera, cameraTransform);
+
                 // Note : Optimisation possible ici -> Ne générer que les faces visibles si on avait un système de
                 // culling avancé
                 MakePointDirectionalLight(Math::EulerAngles(0, 0, 0), lightPairs[i]);
@@ -397,6 +390,8 @@ namespace Frost
                 MakePointDirectionalLight(Math::EulerAngles(0.0_deg, 0.0_deg, 180.0_deg), lightPairs[i]);
                 MakePointDirectionalLight(Math::EulerAngles(0.0_deg, 90.0_deg, 0.0_deg), lightPairs[i]);
                 MakePointDirectionalLight(Math::EulerAngles(0.0_deg, -90.0_deg, 0.0_deg), lightPairs[i]);
+                for (int face = 0; face < 6; face++)
+                    addLightShadow(tileSize);
             }
             else if (lightPairs[i].first.GetType() == Component::LightType::Directional)
             {
@@ -419,13 +414,32 @@ namespace Frost
                                            camera.farClip,
                                            camera.perspectiveFOV.value(),
                                            cameraTransform);
+
+                // The near cascade covers the least ground, it gets the most texels
+                addLightShadow(SHADOW_ATLAS_SIZE / 2);
+                addLightShadow(SHADOW_ATLAS_SIZE / 4);
+                addLightShadow(SHADOW_ATLAS_SIZE / 4);
             }
             else
+            {
                 _virtualLightPairs.push_back(lightPairs[i]);
+
+                uint32_t tileSize = 0;
+                if (auto* cfg = std::get_if<Component::LightSpot>(&lightPairs[i].first.config))
+                    tileSize =
+                        _GetLocalShadowTileSize(lightPairs[i].second.position, cfg->range, camera, cameraTransform);
+                addLightShadow(tileSize);
+            }
         }
 
+        _GatherShadowCasters();
+        _ReleaseUnusedShadowTiles();
+
         for (int j = 0; j < _virtualLightPairs.size(); j++)
         {
+            if (_virtualLightTileSizes[j] == 0)
+                continue;
+
             if (_virtualLightPairs[j].first.GetType() == Component::LightType::Directional)
             {
                 ComputeDirectionalShadowMap(LightObject{ j, _virtualLightPairs[j].second, _virtualLightPairs[j].first },
@@ -438,6 +452,8 @@ namespace Frost
                                  cameraTransform,
                                  viewport);
         }
+
+        _RecordShadowTiles();
     }
 
     void ShadowPipeline::LightPass(const Component::Camera& camera,
@@ -453,8 +469,8 @@ namespace Frost
                 SubmitLight(camera,
                             cameraTransform,
                             LightObject{ j, _virtualLightPairs[j].second, _virtualLightPairs[j].first },
-                            _luminanceTexture1,
-                            _luminanceTexture2,
+                            _targets.luminance1,
+                            _targets.luminance2,
                             viewport);
             }
             else
@@ -462,8 +478,8 @@ namespace Frost
                 SubmitLight(camera,
                             cameraTransform,
                             LightObject{ j, _virtualLightPairs[j].second, _virtualLightPairs[j].first },
-                            _luminanceTexture2,
-                            _luminanceTexture1,
+                            _targets.luminance2,
+                            _targets.luminance1,
                             viewport);
             }
         }
@@ -475,11 +491,11 @@ namespace Frost
 
         if (_virtualLightPairs.size() % 2 == 0)
         {
-            DrawFinalLitTexture(_luminanceTexture1, viewport);
+            DrawFinalLitTexture(_targets.luminance1, viewport);
         }
         else
         {
-            DrawFinalLitTexture(_luminanceTexture2, viewport);
+            DrawFinalLitTexture(_targets.luminance2, viewport);
         }
     }
 
@@ -491,10 +507,9 @@ namespace Frost
             return;
 
         bool isEven = (_virtualLightPairs.size() % 2 == 0);
-        auto source = isEven ? _luminanceTexture1 : _luminanceTexture2;
-        auto dest = isEven ? _luminanceTexture2 : _luminanceTexture1;
+        Texture* source = isEven ? _targets.luminance1 : _targets.luminance2;
+        Texture* outPtr = isEven ? _targets.luminance2 : _targets.luminance1;
 
-        Texture* outPtr = dest.get();
         _commandList->SetRenderTargets(1, &outPtr, nullptr);
 
         EnvironmentLightData lightData;
@@ -511,11 +526,11 @@ namespace Frost
         _commandList->SetConstantBuffer(_lightPassBuffer.get(), 0);
         _commandList->SetConstantBuffer(_vsShadowConstants.get(), 1);
 
-        _commandList->SetTexture(_albedoTexture.get(), 0);
-        _commandList->SetTexture(_normalTexture.get(), 1);
-        _commandList->SetTexture(_worldPositionTexture.get(), 2);
-        _commandList->SetTexture(_materialTexture.get(), 3);
-        _commandList->SetTexture(source.get(), 5);
+        _commandList->SetTexture(_gbuffer.albedo, 0);
+        _commandList->SetTexture(_gbuffer.normal, 1);
+        _commandList->SetTexture(_gbuffer.worldPosition, 2);
+        _commandList->SetTexture(_gbuffer.material, 3);
+        _commandList->SetTexture(source, 5);
 
         _commandList->SetTexture(_currentEnvironmentMap.get(), 6);
 
@@ -541,7 +556,7 @@ namespace Frost
 
     void ShadowPipeline::InitLightTexture(const Viewport& viewport)
     {
-        Texture* outPtr = _luminanceTexture1.get();
+        Texture* outPtr = _targets.luminance1;
         _commandList->SetRenderTargets(1, &outPtr, nullptr);
 
         _commandList->SetShader(_finalLightVertexShader.get());
@@ -565,31 +580,11 @@ namespace Frost
         const auto& light = lightObj.light;
         const auto& transform = lightObj.wt;
 
-        auto it = _shadowMaps.find(lightObj.id);
-        if (it == _shadowMaps.end())
-        {
-            ShadowData data;
-            TextureConfig depthConfig = { .format = Format::R24G8_TYPELESS,
-                                          .width = static_cast<uint32_t>(_shadowResolution),
-                                          .height = static_cast<uint32_t>(_shadowResolution),
-                                          .isRenderTarget = true,
-                                          .isShaderResource = true,
-                                          .hasMipmaps = false };
-            data.shadowTexture = std::make_unique<TextureDX11>(depthConfig);
-            it = _shadowMaps.emplace(lightObj.id, std::move(data)).first;
-        }
-        else if (it->second.shadowTexture == nullptr)
-        {
-            TextureConfig depthConfig = { .format = Format::R24G8_TYPELESS,
-                                          .width = static_cast<uint32_t>(_shadowResolution),
-                                          .height = static_cast<uint32_t>(_shadowResolution),
-                                          .isRenderTarget = true,
-                                          .isShaderResource = true,
-                                          .hasMipmaps = false };
-            it->second.shadowTexture = std::make_unique<TextureDX11>(depthConfig);
-        }
+        ShadowData* shadowTile = _AcquireShadowData(lightObj.id);
+        if (!shadowTile)
+            return;
 
-        ShadowData& shadowData = it->second;
+        ShadowData& shadowData = *shadowTile;
 
         Vector3 up = Vector3(0, 1, 0);
         if (fabs(transform.GetForward().y) > 0.99f)
@@ -615,31 +610,7 @@ namespace Frost
         // --- OPTIMISATION : Calcul du Frustum de la Lumière ---
         shadowData.lightFrustum.Extract(LoadMatrix(shadowData.lightViewProj), 0.0f);
 
-        Texture* depthPtr = shadowData.shadowTexture.get();
-        _commandList->SetRenderTargets(0, nullptr, depthPtr);
-        _commandList->ClearDepthStencil(depthPtr, true, 1.0f, false, 0);
-
-        _commandList->SetShader(_shadowVertexShader.get());
-        _commandList->UnbindShader(ShaderType::Geometry);
-        _commandList->UnbindShader(ShaderType::Hull);
-        _commandList->UnbindShader(ShaderType::Domain);
-        _commandList->UnbindShader(ShaderType::Pixel);
-        _commandList->SetViewport(0, 0, _shadowResolution, _shadowResolution, 0.f, 1.f);
-
-        auto meshView = _scene->ViewActive<Component::StaticMesh, Component::WorldTransform>();
-
-        // On itère sur tous les objets, mais DrawDepthOnly fera le tri fin
-        meshView.each(
-            [&](const Component::StaticMesh& staticMesh, const Component::WorldTransform& meshTransform)
-            {
-                if (staticMesh.GetModel() && staticMesh.GetModel()->IsLoaded())
-                {
-                    Math::Matrix4x4 worldMatrix = Math::GetTransformMatrix(meshTransform);
-                    // On passe le frustum pour le culling
-                    DrawDepthOnly(
-                        _commandList.get(), staticMesh, worldMatrix, shadowData.lightViewProj, shadowData.lightFrustum);
-                }
-            });
+        _pendingShadowTiles.push_back(&shadowData);
     }
 
     void ShadowPipeline::ComputeDirectionalShadowMap(const LightObject& lightObj,
@@ -649,31 +620,11 @@ namespace Frost
         const auto& light = lightObj.light;
         const auto& transform = lightObj.wt;
 
-        auto it = _shadowMaps.find(lightObj.id);
-        if (it == _shadowMaps.end())
-        {
-            ShadowData data;
-            TextureConfig depthConfig = { .format = Format::R24G8_TYPELESS,
-                                          .width = static_cast<uint32_t>(_shadowResolution),
-                                          .height = static_cast<uint32_t>(_shadowResolution),
-                                          .isRenderTarget = true,
-                                          .isShaderResource = true,
-                                          .hasMipmaps = false };
-            data.shadowTexture = std::make_unique<TextureDX11>(depthConfig);
-            it = _shadowMaps.emplace(lightObj.id, std::move(data)).first;
-        }
-        else if (it->second.shadowTexture == nullptr)
-        {
-            TextureConfig depthConfig = { .format = Format::R24G8_TYPELESS,
-                                          .width = static_cast<uint32_t>(_shadowResolution),
-                                          .height = static_cast<uint32_t>(_shadowResolution),
-                                          .isRenderTarget = true,
-                                          .isShaderResource = true,
-                                          .hasMipmaps = false };
-            it->second.shadowTexture = std::make_unique<TextureDX11>(depthConfig);
-        }
+        ShadowData* shadowTile = _AcquireShadowData(lightObj.id);
+        if (!shadowTile)
+            return;
 
-        ShadowData& shadowData = it->second;
+        ShadowData& shadowData = *shadowTile;
         auto* cfg = std::get_if<Component::LightDirectional>(&light.config);
 
         auto lightView =
@@ -690,28 +641,292 @@ namespace Frost
         // --- OPTIMISATION : Calcul du Frustum Orthographique ---
         shadowData.lightFrustum.Extract(LoadMatrix(shadowData.lightViewProj), 0.0f);
 
-        Texture* depthPtr = shadowData.shadowTexture.get();
-        _commandList->SetRenderTargets(0, nullptr, depthPtr);
-        _commandList->ClearDepthStencil(depthPtr, true, 1.0f, false, 0);
+        _pendingShadowTiles.push_back(&shadowData);
+    }
 
-        _commandList->SetShader(_shadowVertexShader.get());
-        _commandList->UnbindShader(ShaderType::Geometry);
-        _commandList->UnbindShader(ShaderType::Hull);
-        _commandList->UnbindShader(ShaderType::Domain);
-        _commandList->UnbindShader(ShaderType::Pixel);
-        _commandList->SetViewport(0, 0, _shadowResolution, _shadowResolution, 0.0f, 1.0f);
+    void ShadowPipeline::_CreateShadowAtlas()
+    {
+        TextureConfig atlasConfig = { .format = Format::R24G8_TYPELESS,
+                                      .width = SHADOW_ATLAS_SIZE,
+                                      .height = SHADOW_ATLAS_SIZE,
+                                      .isRenderTarget = true,
+                                      .isShaderResource = true,
+                                      .hasMipmaps = false };
+        _shadowAtlas = std::make_unique<TextureDX11>(atlasConfig);
+        _staticShadowAtlas = std::make_unique<TextureDX11>(atlasConfig);
+
+        _shadowMaps.clear();
+        _shadowAtlasTiles.Clear();
+        _hasReportedFullAtlas = false;
+    }
+
+    uint64_t ShadowPipeline::_GetLightKey(entt::entity lightEntity, Component::LightType lightType) const
+    {
+        // A light keeps its tiles while it moves, the new light matrix changes the static key of the tile and only
+        // marks the cached map dirty. The type is hashed so that a light changed to another type starts over.
+        uint64_t key = HashValue(HASH_SEED, lightEntity);
+        return HashValue(key, lightType);
+    }
+
+    uint32_t ShadowPipeline::_GetLocalShadowTileSize(const Math::Vector3& lightPosition,
+                                                     float lightRange,
+                                                     const Component::Camera& camera,
+                                                     const Component::WorldTransform& cameraTransform) const
+    {
+        // Fraction of the screen height covered by the light's range
+        float distance = Math::Length(lightPosition - cameraTransform.position);
+        float coverage = 1.0f;
+        if (distance > lightRange)
+            coverage = lightRange / (distance * std::tan(camera.perspectiveFOV.value() * 0.5f));
+
+        coverage = std::clamp(coverage, 0.0f, 1.0f);
+        return _shadowAtlasTiles.RoundTileSize(static_cast<uint32_t>(MAX_LOCAL_SHADOW_TILE_SIZE * coverage));
+    }
 
-        auto meshView = _scene->ViewActive<Component::StaticMesh, Component::WorldTransform>();
+    void ShadowPipeline::_GatherShadowCasters()
+    {
+        _shadowCasters.clear();
+
+        auto meshView = _scene->ViewActive<Component::StaticMesh, Component::WorldMatrix>();
         meshView.each(
-            [&](const Component::StaticMesh& staticMesh, const Component::WorldTransform& meshTransform)
+            [&](entt::entity entity, const Component::StaticMesh& staticMesh, const Component::WorldMatrix& meshMatrix)
             {
-                if (staticMesh.GetModel() && staticMesh.GetModel()->IsLoaded())
+                const Model* model = staticMesh.GetModel().get();
+                if (!model || !model->IsLoaded())
+                    return;
+
+                ShadowCasterState& state = _shadowCasterStates[entity];
+                if (state.lastSeenFrame == 0 || state.version != meshMatrix.version || state.model != model)
                 {
-                    Math::Matrix4x4 worldMatrix = Math::GetTransformMatrix(meshTransform);
-                    DrawDepthOnly(
-                        _commandList.get(), staticMesh, worldMatrix, shadowData.lightViewProj, shadowData.lightFrustum);
+                    state.model = model;
+                    state.version = meshMatrix.version;
+                    state.bounds = BoundingBox::TransformAABB(model->GetBoundingBox(), LoadMatrix(meshMatrix.matrix));
+                    state.lastChangeFrame = _frameIndex;
                 }
+                state.lastSeenFrame = _frameIndex;
+
+                // Part of the key, a caster changing level redraws the static cache
+                uint32_t lod = std::min(staticMesh.GetLod() + _lodBias, model->GetLodCount() - 1);
+
+                uint64_t key = HashValue(HASH_SEED, entity);
+                key = HashValue(key, model);
+                key = HashValue(key, state.version);
+                key = HashValue(key, lod);
+
+                _shadowCasters.push_back({ .staticMesh = &staticMesh,
+                                           .worldMatrix = &meshMatrix.matrix,
+                                           .bounds = state.bounds,
+                                           .key = key,
+                                           .lod = lod,
+                                           .isStatic = _frameIndex - state.lastChangeFrame >= STATIC_CASTER_FRAMES });
             });
+
+        std::erase_if(_shadowCasterStates, [&](const auto& pair) { return pair.second.lastSeenFrame != _frameIndex; });
+    }
+
+    void ShadowPipeline::_ReleaseUnusedShadowTiles()
+    {
+        for (uint64_t key : _virtualLightKeys)
+        {
+            auto it = _shadowMaps.find(key);
+            if (it != _shadowMaps.end())
+                it->second.lastUsedFrame = _frameIndex;
+        }
+
+        std::erase_if(_shadowMaps,
+                      [&](const auto& pair)
+                      {
+                          if (_frameIndex - pair.second.lastUsedFrame < SHADOW_TILE_RELEASE_FRAMES)
+                              return false;
+
+                          _shadowAtlasTiles.Free(pair.second.tile);
+                          return true;
+                      });
+    }
+
+    ShadowData* ShadowPipeline::_AcquireShadowData(int lightId)
+    {
+        const uint64_t key = _virtualLightKeys[lightId];
+        const uint32_t tileSize = _shadowAtlasTiles.RoundTileSize(_virtualLightTileSizes[lightId]);
+
+        ShadowData& shadowData = _shadowMaps[key];
+        shadowData.lastUsedFrame = _frameIndex;
+
+        // Grows at once but only shrinks by two steps, so that a light on the edge of a size does not reallocate
+        // every frame
+        if (shadowData.tile.IsValid() &&
+            (tileSize > shadowData.requestedTileSize || tileSize * 4 <= shadowData.requestedTileSize))
+        {
+            _shadowAtlasTiles.Free(shadowData.tile);
+            shadowData.tile = {};
+        }
+
+        if (!shadowData.tile.IsValid())
+        {
+            // A full atlas hands out smaller tiles rather than dropping the light
+            for (uint32_t size = tileSize; size >= MIN_SHADOW_TILE_SIZE && !shadowData.tile.IsValid(); size /= 2)
+                shadowData.tile = _shadowAtlasTiles.Allocate(size);
+
+            if (!shadowData.tile.IsValid())
+            {
+                if (!_hasReportedFullAtlas)
+                {
+                    FT_ENGINE_WARN("Shadow atlas is full, some lights are skipped");
+                    _hasReportedFullAtlas = true;
+                }
+                _shadowMaps.erase(key);
+                return nullptr;
+            }
+
+            shadowData.requestedTileSize = tileSize;
+            shadowData.staticKey = 0;
+            shadowData.dynamicKey = 0;
+        }
+
+        return &shadowData;
+    }
+
+    void ShadowPipeline::_RecordShadowTiles()
+    {
+        // The tiles left untouched by the keys record nothing, their lists stay empty
+        _shadowRecorder.AddRange(_pendingShadowTiles.size(),
+                                 1,
+                                 [this](CommandList* commandList, size_t begin, size_t end)
+                                 {
+                                     std::vector<const ShadowCaster*> staticCasters;
+                                     std::vector<const ShadowCaster*> dynamicCasters;
+                                     for (size_t i = begin; i < end; ++i)
+                                     {
+                                         _RenderShadowTile(
+                                             commandList, *_pendingShadowTiles[i], staticCasters, dynamicCasters);
+                                     }
+                                 });
+
+        // Executed right away, so before the shared command list holding the light pass
+        _shadowRecorder.Submit();
+        _pendingShadowTiles.clear();
+
+        // The light pass used to inherit the state of the shadow draws, the G-Buffer may have left tessellation or
+        // geometry shaders bound
+        _commandList->UnbindShader(ShaderType::Geometry);
+        _commandList->UnbindShader(ShaderType::Hull);
+        _commandList->UnbindShader(ShaderType::Domain);
+        _commandList->SetPrimitiveTopology(PrimitiveTopology::TRIANGLELIST);
+        _commandList->SetRasterizerState(RasterizerMode::SolidCullBack);
+        _commandList->SetDepthStencilState(DepthMode::ReadWrite);
+    }
+
+    void ShadowPipeline::_RenderShadowTile(CommandList* commandList,
+                                           ShadowData& shadowData,
+                                           std::vector<const ShadowCaster*>& staticCasters,
+                                           std::vector<const ShadowCaster*>& dynamicCasters)
+    {
+        staticCasters.clear();
+        dynamicCasters.clear();
+
+        // The keys sum up everything the tile depends on, the tile is left untouched when they match the last draw
+        uint64_t staticKey = HashValue(HASH_SEED, shadowData.lightViewProj);
+        staticKey = HashValue(staticKey, shadowData.tile);
+        uint64_t dynamicKey = HASH_SEED;
+
+        for (const ShadowCaster& caster : _shadowCasters)
+        {
+            if (!shadowData.lightFrustum.IsInside(caster.bounds))
+                continue;
+
+            if (caster.isStatic)
+            {
+                staticKey = HashValue(staticKey, caster.key);
+                staticCasters.push_back(&caster);
+            }
+            else
+            {
+                dynamicKey = HashValue(dynamicKey, caster.key);
+                dynamicCasters.push_back(&caster);
+            }
+        }
+
+        const bool staticChanged = staticKey != shadowData.staticKey;
+        if (staticChanged)
+        {
+            _ClearShadowTile(commandList, _staticShadowAtlas.get(), shadowData.tile);
+            _DrawShadowCasters(commandList, _staticShadowAtlas.get(), shadowData, staticCasters);
+            shadowData.staticKey = staticKey;
+        }
+
+        if (staticChanged || dynamicKey != shadowData.dynamicKey)
+        {
+            _CopyStaticShadowTile(commandList, shadowData.tile);
+            _DrawShadowCasters(commandList, _shadowAtlas.get(), shadowData, dynamicCasters);
+            shadowData.dynamicKey = dynamicKey;
+        }
+    }
+
+    void ShadowPipeline::_ClearShadowTile(CommandList* commandList, Texture* atlas, const ShadowAtlas::Tile& tile)
+    {
+        // A depth view can only be cleared as a whole, the tile is overwritten with a far plane triangle instead
+        commandList->SetRenderTargets(0, nullptr, atlas);
+        commandList->SetViewport(tile.x, tile.y, tile.size, tile.size, 0.f, 1.f);
+        commandList->SetDepthStencilState(DepthMode::WriteOnly);
+
+        commandList->SetInputLayout(nullptr);
+        commandList->SetShader(_shadowTileVertexShader.get());
+        commandList->UnbindShader(ShaderType::Geometry);
+        commandList->UnbindShader(ShaderType::Hull);
+        commandList->UnbindShader(ShaderType::Domain);
+        commandList->UnbindShader(ShaderType::Pixel);
+
+        commandList->SetPrimitiveTopology(PrimitiveTopology::TRIANGLELIST);
+        commandList->Draw(3, 0);
+
+        commandList->SetDepthStencilState(DepthMode::ReadWrite);
+    }
+
+    void ShadowPipeline::_CopyStaticShadowTile(CommandList* commandList, const ShadowAtlas::Tile& tile)
+    {
+        // Depth resources cannot be copied by region either, the pixel shader writes the static depth back
+        Texture* atlas = _shadowAtlas.get();
+        commandList->SetRenderTargets(0, nullptr, atlas);
+        commandList->SetViewport(tile.x, tile.y, tile.size, tile.size, 0.f, 1.f);
+        commandList->SetDepthStencilState(DepthMode::WriteOnly);
+
+        commandList->SetInputLayout(nullptr);
+        commandList->SetShader(_shadowTileVertexShader.get());
+        commandList->SetShader(_shadowCopyPixelShader.get());
+        commandList->UnbindShader(ShaderType::Geometry);
+        commandList->UnbindShader(ShaderType::Hull);
+        commandList->UnbindShader(ShaderType::Domain);
+        commandList->SetTexture(_staticShadowAtlas.get(), 0);
+
+        commandList->SetPrimitiveTopology(PrimitiveTopology::TRIANGLELIST);
+        commandList->Draw(3, 0);
+
+        // The static atlas is bound as depth target again by the next static draw
+        commandList->SetTexture(nullptr, 0);
+        commandList->SetDepthStencilState(DepthMode::ReadWrite);
+    }
+
+    void ShadowPipeline::_DrawShadowCasters(CommandList* commandList,
+                                            Texture* atlas,
+                                            const ShadowData& shadowData,
+                                            const std::vector<const ShadowCaster*>& casters)
+    {
+        if (casters.empty())
+            return;
+
+        commandList->SetRenderTargets(0, nullptr, atlas);
+        const ShadowAtlas::Tile& tile = shadowData.tile;
+        commandList->SetViewport(tile.x, tile.y, tile.size, tile.size, 0.f, 1.f);
+
+        for (const ShadowCaster* caster : casters)
+        {
+            DrawDepthOnly(commandList,
+                          *caster->staticMesh,
+                          *caster->worldMatrix,
+                          caster->lod,
+                          shadowData.lightViewProj,
+                          shadowData.lightFrustum);
+        }
     }
 
     ShadowPipeline::DirectionalParams ShadowPipeline::ComputeOrthoSize(float cameraNear,
@@ -794,6 +1009,7 @@ namespace Frost
     void ShadowPipeline::DrawDepthOnly(CommandList* cmd,
                                        const Component::StaticMesh& staticMesh,
                                        const Math::Matrix4x4& worldMatrix,
+                                       uint32_t lod,
                                        const Math::Matrix4x4& _currentLightViewProj,
                                        const Frustum& lightFrustum)
     {
@@ -830,9 +1046,9 @@ namespace Frost
                     // Setup pipeline state (inchangé)
                     cmd->SetPrimitiveTopology(PrimitiveTopology::TRIANGLELIST);
                     cmd->SetShader(_shadowVertexShader.get());
-                    _commandList->UnbindShader(ShaderType::Geometry);
-                    _commandList->UnbindShader(ShaderType::Hull);
-                    _commandList->UnbindShader(ShaderType::Domain);
+                    cmd->UnbindShader(ShaderType::Geometry);
+                    cmd->UnbindShader(ShaderType::Hull);
+                    cmd->UnbindShader(ShaderType::Domain);
                     cmd->UnbindShader(ShaderType::Pixel);
                     cmd->SetInputLayout(_shadowInputLayout.get());
                     cmd->SetRasterizerState(RasterizerMode::SolidCullBack);
@@ -840,9 +1056,10 @@ namespace Frost
                     isFirstDraw = false;
                 }
 
+                const MeshLod& meshLod = mesh.GetLod(lod);
                 cmd->SetVertexBuffer(mesh.GetVertexBuffer(), mesh.GetVertexStride(), 0);
                 cmd->SetIndexBuffer(mesh.GetIndexBuffer(), 0);
-                cmd->DrawIndexed(mesh.GetIndexCount(), 0, 0);
+                cmd->DrawIndexed(meshLod.indexCount, meshLod.indexOffset, 0);
             }
         }
     }
@@ -850,8 +1067,8 @@ namespace Frost
     void ShadowPipeline::SubmitLight(const Component::Camera& camera,
                                      const Component::WorldTransform& cameraTransform,
                                      LightObject lightObj,
-                                     std::shared_ptr<Texture> destination,
-                                     std::shared_ptr<Texture> source,
+                                     Texture* destination,
+                                     Texture* source,
                                      const Viewport& viewport)
     {
         if (viewport.width == 0 || viewport.height == 0)
@@ -859,15 +1076,18 @@ namespace Frost
             FT_ENGINE_ERROR("Viewport width and height should be > 0");
             return;
         }
-        if (!_albedoTexture)
+        if (!_gbuffer.albedo)
             return;
 
-        auto it = _shadowMaps.find(lightObj.id);
-        if (it == _shadowMaps.end())
+        // Ambiant lights have no shadow map
+        const ShadowData* shadow = nullptr;
+        auto it = lightObj.id < _virtualLightKeys.size() ? _shadowMaps.find(_virtualLightKeys[lightObj.id])
+                                                         : _shadowMaps.end();
+        if (it != _shadowMaps.end())
+            shadow = &it->second;
+        else if (lightObj.light.GetType() != Component::LightType::Ambiant)
             return;
 
-        ShadowData& shadow = it->second;
-
         switch (lightObj.light.GetType())
         {
             case Component::LightType::Directional:
@@ -875,7 +1095,7 @@ namespace Frost
                 auto* cfg = std::get_if<Component::LightDirectional>(&lightObj.light.config);
 
                 auto light = DirectionalLightData();
-                light.shadowResolution = _shadowResolution;
+                light.shadowResolution = shadow->tile.size;
                 light.CameraPosition = cameraTransform.position;
                 light.Direction = lightObj.wt.GetForward();
                 light.Color = lightObj.light.color;
@@ -900,7 +1120,7 @@ namespace Frost
                 light.Radius = cfg->radius;
                 light.Color = lightObj.light.color;
                 light.Intensity = lightObj.light.intensity;
-                light.ShadowResolution = _shadowResolution;
+                light.ShadowResolution = shadow->tile.size;
                 light.LightDirection = lightObj.wt.GetForward();
 
                 _lightPassBuffer->UpdateData(_commandList.get(), &light, sizeof(light));
@@ -917,7 +1137,7 @@ namespace Frost
                 light.Direction = lightObj.wt.GetForward();
                 light.Color = lightObj.light.color;
                 light.Intensity = lightObj.light.intensity;
-                light.shadowResolution = _shadowResolution;
+                light.shadowResolution = shadow->tile.size;
                 light.InnerConeAngle = std::cos(cfg->innerConeAngle.value());
                 light.OuterConeAngle = std::cos(cfg->outerConeAngle.value());
                 light.Radius = cfg->range;
@@ -940,31 +1160,40 @@ namespace Frost
         }
     }
 
-    void ShadowPipeline::DrawLight(ShadowData& shadow,
+    void ShadowPipeline::DrawLight(const ShadowData* shadow,
                                    std::shared_ptr<Shader> lightingVertexShader,
                                    std::shared_ptr<Shader> lightingPixelShader,
-                                   std::shared_ptr<Texture> destination,
-                                   std::shared_ptr<Texture> source,
+                                   Texture* destination,
+                                   Texture* source,
                                    const Viewport& viewport)
     {
-        Texture* outPtr = destination.get();
+        Texture* outPtr = destination;
         _commandList->SetRenderTargets(1, &outPtr, nullptr);
 
         VS_ShadowConstants vsData;
         vsData.World = DirectX::XMMatrixIdentity();
-        vsData.LightViewProj = LoadMatrix(Math::Matrix4x4::CreateTranspose(shadow.lightViewProj));
+        vsData.LightViewProj = DirectX::XMMatrixIdentity();
+        if (shadow)
+        {
+            const float atlasSize = static_cast<float>(SHADOW_ATLAS_SIZE);
+            vsData.LightViewProj = LoadMatrix(Math::Matrix4x4::CreateTranspose(shadow->lightViewProj));
+            vsData.AtlasRect = { shadow->tile.x / atlasSize,
+                                 shadow->tile.y / atlasSize,
+                                 shadow->tile.size / atlasSize,
+                                 shadow->tile.size / atlasSize };
+        }
         _vsShadowConstants->UpdateData(_commandList.get(), &vsData, sizeof(vsData));
 
         _commandList->SetConstantBuffer(_lightPassBuffer.get(), 0);
         _commandList->SetConstantBuffer(_vsShadowConstants.get(), 1);
 
-        _commandList->SetTexture(_albedoTexture.get(), 0);
-        _commandList->SetTexture(_normalTexture.get(), 1);
-        _commandList->SetTexture(_worldPositionTexture.get(), 2);
-        _commandList->SetTexture(_materialTexture.get(), 3);
+        _commandList->SetTexture(_gbuffer.albedo, 0);
+        _commandList->SetTexture(_gbuffer.normal, 1);
+        _commandList->SetTexture(_gbuffer.worldPosition, 2);
+        _commandList->SetTexture(_gbuffer.material, 3);
 
-        _commandList->SetTexture(shadow.shadowTexture.get(), 4);
-        _commandList->SetTexture(source.get(), 5);
+        _commandList->SetTexture(_shadowAtlas.get(), 4);
+        _commandList->SetTexture(source, 5);
         _commandList->SetSampler(_gBufferSampler.get(), 0);
 
         _commandList->SetInputLayout(nullptr);
@@ -984,14 +1213,14 @@ namespace Frost
         _commandList->Draw(3, 0);
     }
 
-    void ShadowPipeline::DrawFinalLitTexture(std::shared_ptr<Texture> luminanceTexture, const Viewport& viewport)
+    void ShadowPipeline::DrawFinalLitTexture(Texture* luminanceTexture, const Viewport& viewport)
     {
-        Texture* outPtr = _finalLitTexture.get();
+        Texture* outPtr = _targets.output;
         _commandList->SetRenderTargets(1, &outPtr, nullptr);
 
-        _commandList->SetTexture(_albedoTexture.get(), 0);
-        _commandList->SetTexture(luminanceTexture.get(), 1);
-        _commandList->SetTexture(_emissionTexture.get(), 2);
+        _commandList->SetTexture(_gbuffer.albedo, 0);
+        _commandList->SetTexture(luminanceTexture, 1);
+        _commandList->SetTexture(_gbuffer.emission, 2);
         _commandList->SetSampler(_gBufferSampler.get(), 0);
 
         _commandList->SetShader(_finalLightVertexShader.get());
@@ -9,7 +9,10 @@
 #include "Frost/Utils/Math/Matrix.h"
 #include "Frost/Scene/Components/StaticMesh.h"
 #include "Frost/Renderer/Frustum.h"
+#include "Frost/Renderer/ParallelCommandRecorder.h"
+#include "Frost/Renderer/ShadowAtlas.h"
 
+#include <entt/entt.hpp>
 #include <memory>
 #include <unordered_map>
 #include "DeferredRenderingPipeline.h"
@@ -36,9 +39,15 @@ namespace Frost
 
     struct ShadowData
     {
-        std::unique_ptr<Texture> shadowTexture;
+        ShadowAtlas::Tile tile;
+        uint32_t requestedTileSize = 0;
         Math::Matrix4x4 lightViewProj;
         Frustum lightFrustum; // Cache du frustum pour éviter de le recalculer
+
+        // Casters the tile was last drawn with, the tile is only redrawn when they change
+        uint64_t staticKey = 0;
+        uint64_t dynamicKey = 0;
+        uint64_t lastUsedFrame = 0;
     };
 
     struct DirectionalShadowData : public ShadowData
@@ -57,6 +66,18 @@ namespace Frost
     class ShadowPipeline : public Pipeline
     {
     public:
+        // Transient textures of the render graph, set before each frame. The lights accumulate in the two luminance
+        // targets in turn, then the lit scene is resolved into the output.
+        struct LightTargets
+        {
+            Texture* luminance1 = nullptr;
+            Texture* luminance2 = nullptr;
+            Texture* output = nullptr;
+        };
+
+        static constexpr Format LUMINANCE_FORMAT = Format::RGBA32_FLOAT;
+        static constexpr Format OUTPUT_FORMAT = Format::RGBA8_UNORM;
+
         ShadowPipeline();
         ~ShadowPipeline();
 
@@ -66,10 +87,8 @@ namespace Frost
 
         void Initialize() override;
         void Shutdown() override;
-        void OnResize(uint32_t width, uint32_t height);
         void SetGBufferData(DeferredRenderingPipeline* deferredPipeline, Scene* scene);
-
-        Texture* GetFinalLitTexture() { return _finalLitTexture.get(); };
+        void SetLightTargets(const LightTargets& targets);
 
         void MakePointDirectionalLight(Math::EulerAngles rot,
                                        std::pair<Component::Light, Component::WorldTransform> lightPair);
@@ -80,7 +99,9 @@ namespace Frost
                                         float cameraFOV,
                                         const Component::WorldTransform& cameraTransform);
 
+        // lightEntities holds the entity of each light pair, its shadow tiles are kept while the entity lives
         void ShadowPass(std::vector<std::pair<Component::Light, Component::WorldTransform>> lightPairs,
+                        const std::vector<entt::entity>& lightEntities,
                         const Component::Camera& camera,
                         const Component::WorldTransform& cameraTransform,
                         const Viewport& viewport);
@@ -90,13 +111,13 @@ namespace Frost
 
         void InitLightTexture(const Viewport& viewport);
         void SetEnvironmentMap(std::shared_ptr<Texture> envMap, float intensity);
+        // Levels added to the level of detail the camera picked for each caster
+        void SetLodBias(uint32_t lodBias) { _lodBias = lodBias; }
         void EnvironmentPass(const Component::Camera& camera,
                              const Component::WorldTransform& cameraTransform,
                              const Viewport& viewport);
 
     private:
-        void CreateTextures(uint32_t width, uint32_t height);
-
         void ComputeShadowMap(const LightObject& lightObject,
                               const Component::Camera& camera,
                               const Component::WorldTransform& cameraTransform,
@@ -106,6 +127,46 @@ namespace Frost
                                          const Component::WorldTransform& cameraTransform,
                                          const Viewport& viewport);
 
+        struct ShadowCaster
+        {
+            const Component::StaticMesh* staticMesh;
+            const Math::Matrix4x4* worldMatrix;
+            BoundingBox bounds;
+            uint64_t key;
+            uint32_t lod;
+            bool isStatic;
+        };
+
+        struct ShadowCasterState
+        {
+            const Model* model = nullptr;
+            uint32_t version = 0;
+            BoundingBox bounds;
+            uint64_t lastChangeFrame = 0;
+            uint64_t lastSeenFrame = 0;
+        };
+
+        void _CreateShadowAtlas();
+        uint64_t _GetLightKey(entt::entity lightEntity, Component::LightType lightType) const;
+        uint32_t _GetLocalShadowTileSize(const Math::Vector3& lightPosition,
+                                         float lightRange,
+                                         const Component::Camera& camera,
+                                         const Component::WorldTransform& cameraTransform) const;
+        void _GatherShadowCasters();
+        void _ReleaseUnusedShadowTiles();
+        ShadowData* _AcquireShadowData(int lightId);
+        void _RecordShadowTiles();
+        void _RenderShadowTile(CommandList* commandList,
+                               ShadowData& shadowData,
+                               std::vector<const ShadowCaster*>& staticCasters,
+                               std::vector<const ShadowCaster*>& dynamicCasters);
+        void _ClearShadowTile(CommandList* commandList, Texture* atlas, const ShadowAtlas::Tile& tile);
+        void _CopyStaticShadowTile(CommandList* commandList, const ShadowAtlas::Tile& tile);
+        void _DrawShadowCasters(CommandList* commandList,
+                                Texture* atlas,
+                                const ShadowData& shadowData,
+                                const std::vector<const ShadowCaster*>& casters);
+
         struct DirectionalParams
         {
             Math::Vector3 sunPos;
@@ -123,38 +184,68 @@ namespace Frost
         void DrawDepthOnly(CommandList* cmd,
                            const Component::StaticMesh& staticMesh,
                            const Math::Matrix4x4& worldMatrix,
+                           uint32_t lod,
                            const Math::Matrix4x4& _currentLightViewProj,
                            const Frustum& lightFrustum);
 
         void SubmitLight(const Component::Camera& camera,
                          const Component::WorldTransform& cameraTransform,
                          LightObject lightObj,
-                         std::shared_ptr<Texture> destination,
-                         std::shared_ptr<Texture> source,
+                         Texture* destination,
+                         Texture* source,
                          const Viewport& viewport);
 
-        void DrawLight(ShadowData& shadow,
+        void DrawLight(const ShadowData* shadow,
                        std::shared_ptr<Shader> lightingVertexShader,
                        std::shared_ptr<Shader> lightingPixelShader,
-                       std::shared_ptr<Texture> destination,
-                       std::shared_ptr<Texture> source,
+                       Texture* destination,
+                       Texture* source,
                        const Viewport& viewport);
 
-        void DrawFinalLitTexture(std::shared_ptr<Texture> luminanceTexture, const Viewport& viewport);
+        void DrawFinalLitTexture(Texture* luminanceTexture, const Viewport& viewport);
+
+        // Every shadow map is a tile of one atlas, sized from the light's screen coverage. Static casters are cached
+        // in a second atlas with the same layout, and copied back under the dynamic casters when those change.
+        static constexpr uint32_t SHADOW_ATLAS_SIZE = 4096;
+        static constexpr uint32_t MIN_SHADOW_TILE_SIZE = 128;
+        static constexpr uint32_t MAX_LOCAL_SHADOW_TILE_SIZE = 1024;
+        // A caster that did not move for that many frames is drawn in the static cache
+        static constexpr uint64_t STATIC_CASTER_FRAMES = 30;
+        // Tiles of lights unseen for that many shadow passes are released, another camera may still be using them
+        static constexpr uint64_t SHADOW_TILE_RELEASE_FRAMES = 8;
 
-        int _shadowResolution = 2048; // Peut être réduit à 1024 si besoin de perf
         float _orthoSize = 512;
+        uint32_t _lodBias = 1;
         int _currentWidth = 0;
         int _currentHeight = 0;
 
         std::vector<std::pair<Component::Light, Component::WorldTransform>> _virtualLightPairs;
-        std::unordered_map<int, ShadowData> _shadowMaps;
+        // Stable shadow map key and wanted tile size of each virtual light, zero for lights without shadow
+        std::vector<uint64_t> _virtualLightKeys;
+        std::vector<uint32_t> _virtualLightTileSizes;
+        std::unordered_map<uint64_t, ShadowData> _shadowMaps;
+
+        ShadowAtlas _shadowAtlasTiles{ SHADOW_ATLAS_SIZE, MIN_SHADOW_TILE_SIZE };
+        std::unique_ptr<Texture> _shadowAtlas;
+        std::unique_ptr<Texture> _staticShadowAtlas;
+        bool _hasReportedFullAtlas = false;
+
+        std::vector<ShadowCaster> _shadowCasters;
+        std::unordered_map<entt::entity, ShadowCasterState> _shadowCasterStates;
+        uint64_t _frameIndex = 0;
+
+        // Tiles to draw this shadow pass. Every tile only touches its own region of the atlases, the tiles are
+        // recorded on worker threads and submitted before the lighting that samples them.
+        std::vector<ShadowData*> _pendingShadowTiles;
+        ParallelCommandRecorder _shadowRecorder;
 
         Scene* _scene;
 
         // Shaders
         std::shared_ptr<Shader> _shadowVertexShader;
         std::shared_ptr<Shader> _shadowPixelShader;
+        std::shared_ptr<Shader> _shadowTileVertexShader;
+        std::shared_ptr<Shader> _shadowCopyPixelShader;
 
         std::shared_ptr<Shader> _pointLightVertexShader;
         std::shared_ptr<Shader> _pointLightPixelShader;
@@ -181,17 +272,8 @@ namespace Frost
         std::unique_ptr<InputLayout> _shadowInputLayout;
         std::shared_ptr<CommandList> _commandList;
 
-        // G-Buffer textures
-        std::shared_ptr<Texture> _albedoTexture;
-        std::shared_ptr<Texture> _normalTexture;
-        std::shared_ptr<Texture> _worldPositionTexture;
-        std::shared_ptr<Texture> _materialTexture;
-        std::shared_ptr<Texture> _emissionTexture;
-
-        std::shared_ptr<Texture> _luminanceTexture1;
-        std::shared_ptr<Texture> _luminanceTexture2;
-
-        std::unique_ptr<Texture> _finalLitTexture;
+        DeferredRenderingPipeline::GBuffer _gbuffer;
+        LightTargets _targets;
 
         std::shared_ptr<Shader> _environmentLightPixelShader;
         std::shared_ptr<Texture> _currentEnvironmentMap;
@@ -3,8 +3,19 @@
 #include "Frost/Asset/Texture.h"
 #include "Frost/Utils/Math/Matrix.h"
 
+#include <cstdint>
+
 namespace Frost
 {
+    // HLSL fragment of a per-pixel effect, see PostEffectChain for the conventions it must follow
+    struct FusedStage
+    {
+        const char* name = nullptr;
+        const char* fragmentPath = nullptr;
+        uint32_t constantsSize = 0;
+        uint32_t textureCount = 0;
+    };
+
     class PostEffect
     {
     public:
@@ -17,6 +28,13 @@ namespace Frost
         bool IsEnabled() const { return _enabled; }
         void SetEnabled(bool enabled) { _enabled = enabled; }
         virtual bool IsPostProcessingPass() const { return true; }
+
+        // Per-pixel effects only read the source at the pixel they write, so consecutive ones can share a pass
+        virtual bool IsPerPixel() const { return false; }
+        virtual FusedStage GetFusedStage() const { return {}; }
+        // Fills the stage constants (constantsSize bytes) and its textures (textureCount entries)
+        virtual void GetFusedBindings(void* constants, const Texture** textures) const {}
+
         void SetNormalTexture(Texture* normalTexture) { _normal = normalTexture; };
         void SetMaterialTexture(Texture* materialTexture) { _material = materialTexture; };
         void SetDepthTexture(Texture* depthTexture) { _depth = depthTexture; };
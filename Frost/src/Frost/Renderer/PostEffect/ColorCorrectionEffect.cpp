@@ -114,6 +114,22 @@ namespace Frost
         commandList->Draw(3, 0);
     }
 
+    FusedStage ColorCorrectionEffect::GetFusedStage() const
+    {
+        return { .name = "ColorCorrection",
+                 .fragmentPath = "../Frost/resources/shaders/PostEffect/ColorCorrection.hlsli",
+                 .constantsSize = sizeof(ColorCorrectionConstants),
+                 .textureCount = 1 };
+    }
+
+    void ColorCorrectionEffect::GetFusedBindings(void* constants, const Texture** textures) const
+    {
+        // Without a LUT the stage has to let the color through, it cannot be skipped inside a fused pass
+        auto* colorCorrection = static_cast<ColorCorrectionConstants*>(constants);
+        colorCorrection->Strength = _lutTexture ? _strength : 0.0f;
+        textures[0] = _lutTexture;
+    }
+
     void ColorCorrectionEffect::OnImGuiRender(float deltaTime)
     {
         ImGui::Text("Color Correction (LUT)");
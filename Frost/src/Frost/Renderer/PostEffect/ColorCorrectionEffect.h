@@ -22,6 +22,10 @@ namespace Frost
 
         const char* GetName() const override { return "ColorCorrectionEffect"; }
 
+        bool IsPerPixel() const override { return true; }
+        FusedStage GetFusedStage() const override;
+        void GetFusedBindings(void* constants, const Texture** textures) const override;
+
         // Setter pour une texture déjà chargée ailleurs (ex: AssetManager)
         void SetLUT(Texture* lutTexture) { _lutTexture = lutTexture; }
 
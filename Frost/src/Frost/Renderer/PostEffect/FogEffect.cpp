@@ -50,11 +50,8 @@ namespace Frost
     void FogEffect::OnPostRender(float deltaTime, CommandList* commandList, Texture* source, Texture* destination)
     {
         FogConstants constants;
-        constants.minDepth = _minDepth;
-        constants.strength = _strength;
-        constants.red = _red;
-        constants.green = _green;
-        constants.blue = _blue;
+        const Texture* depth = nullptr;
+        GetFusedBindings(&constants, &depth);
 
         _constantsBuffer->UpdateData(commandList, &constants, sizeof(constants));
 
@@ -64,7 +61,7 @@ namespace Frost
         commandList->SetInputLayout(nullptr);
 
         commandList->SetTexture(source, 0);
-        commandList->SetTexture(_depth, 1);
+        commandList->SetTexture(depth, 1);
         commandList->SetSampler(_sampler.get(), 0);
 
         commandList->SetConstantBuffer(_constantsBuffer.get(), 0);
@@ -73,6 +70,25 @@ namespace Frost
         commandList->Draw(3, 0);
     }
 
+    FusedStage FogEffect::GetFusedStage() const
+    {
+        return { .name = "Fog",
+                 .fragmentPath = "../Frost/resources/shaders/PostEffect/Fog/Fog.hlsli",
+                 .constantsSize = sizeof(FogConstants),
+                 .textureCount = 1 };
+    }
+
+    void FogEffect::GetFusedBindings(void* constants, const Texture** textures) const
+    {
+        auto* fog = static_cast<FogConstants*>(constants);
+        fog->minDepth = _minDepth;
+        fog->strength = _strength;
+        fog->red = _red;
+        fog->green = _green;
+        fog->blue = _blue;
+        textures[0] = _depth;
+    }
+
     void FogEffect::OnImGuiRender(float deltaTime)
     {
         // Settings
@@ -21,6 +21,10 @@ namespace Frost
 
         const char* GetName() const override { return "FogEffect"; }
 
+        bool IsPerPixel() const override { return true; }
+        FusedStage GetFusedStage() const override;
+        void GetFusedBindings(void* constants, const Texture** textures) const override;
+
         void SetFog(float minDepth, float strength, Frost::Math::Vector3 color)
         {
             SetMinDepth(minDepth);
@@ -44,10 +44,46 @@ namespace Frost
 
     void ToonEffect::OnPostRender(float deltaTime, CommandList* commandList, Texture* source, Texture* destination)
     {
+        ToonConstants constants = _BuildConstants();
+
+        _constantsBuffer->UpdateData(commandList, &constants, sizeof(constants));
+
+        commandList->SetRenderTargets(1, &destination, nullptr);
+        commandList->SetShader(_vertexShader.get());
+        commandList->SetShader(_pixelShader.get());
+        commandList->SetInputLayout(nullptr);
+
+        commandList->SetTexture(source, 0);
+        commandList->SetTexture(_normal, 1);
+        commandList->SetSampler(_sampler.get(), 0);
+
+        commandList->SetConstantBuffer(_constantsBuffer.get(), 0);
+
+        commandList->SetPrimitiveTopology(PrimitiveTopology::TRIANGLELIST);
+        commandList->Draw(3, 0);
+    }
+
+    FusedStage ToonEffect::GetFusedStage() const
+    {
+        return { .name = "Toon",
+                 .fragmentPath = "../Frost/resources/shaders/PostEffect/ToonShading/Toon.hlsli",
+                 .constantsSize = sizeof(ToonConstants),
+                 .textureCount = 1 };
+    }
+
+    void ToonEffect::GetFusedBindings(void* constants, const Texture** textures) const
+    {
+        *static_cast<ToonConstants*>(constants) = _BuildConstants();
+        textures[0] = _normal;
+    }
+
+    ToonConstants ToonEffect::_BuildConstants() const
+    {
+        ToonConstants constants = this->constants;
+
         constants.redStepCount = 5;
         constants.greenStepCount = 5;
         constants.blueStepCount = 5;
-        int pad0;
 
         // --- RED ---
         constants.redSteps[0] = DirectX::XMFLOAT4(0.2f, 0.f, 0.f, 0.f);
@@ -88,21 +124,7 @@ namespace Frost
         FT_ASSERT(constants.greenStepCount != 0, "green step count must be strictly greater than 0");
         FT_ASSERT(constants.blueStepCount != 0, "blue step count must be strictly greater than 0");
 
-        _constantsBuffer->UpdateData(commandList, &constants, sizeof(constants));
-
-        commandList->SetRenderTargets(1, &destination, nullptr);
-        commandList->SetShader(_vertexShader.get());
-        commandList->SetShader(_pixelShader.get());
-        commandList->SetInputLayout(nullptr);
-
-        commandList->SetTexture(source, 0);
-        commandList->SetTexture(_normal, 1);
-        commandList->SetSampler(_sampler.get(), 0);
-
-        commandList->SetConstantBuffer(_constantsBuffer.get(), 0);
-
-        commandList->SetPrimitiveTopology(PrimitiveTopology::TRIANGLELIST);
-        commandList->Draw(3, 0);
+        return constants;
     }
 
     void ToonEffect::OnImGuiRender(float deltaTime)
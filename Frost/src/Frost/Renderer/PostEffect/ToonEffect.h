@@ -49,6 +49,13 @@ namespace Frost
 
         const char* GetName() const override { return "ToonEffect"; }
 
+        bool IsPerPixel() const override { return true; }
+        FusedStage GetFusedStage() const override;
+        void GetFusedBindings(void* constants, const Texture** textures) const override;
+
+    private:
+        ToonConstants _BuildConstants() const;
+
     private:
         // ImGui control
         int _activeCenter = 0;
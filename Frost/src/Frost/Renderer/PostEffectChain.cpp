@@ -0,0 +1,159 @@
+#include "Frost/Renderer/PostEffectChain.h"
+
+#include <format>
+#include <string_view>
+#include <unordered_set>
+
+namespace Frost
+{
+    std::vector<PostEffectChain::Pass> PostEffectChain::Build(const std::vector<PostEffect*>& effects)
+    {
+        std::vector<Pass> passes;
+
+        size_t i = 0;
+        while (i < effects.size())
+        {
+            Pass pass;
+            pass.effects.push_back(effects[i]);
+
+            if (effects[i]->IsPerPixel())
+            {
+                while (i + 1 < effects.size() && effects[i + 1]->IsPerPixel())
+                {
+                    pass.effects.push_back(effects[++i]);
+                }
+
+                // A lone effect is cheaper through its own hand-written shader
+                if (pass.effects.size() > 1)
+                {
+                    pass.permutationKey = GetPermutationKey(GetStages(pass));
+                }
+            }
+
+            passes.push_back(std::move(pass));
+            ++i;
+        }
+
+        return passes;
+    }
+
+    std::vector<FusedStage> PostEffectChain::GetStages(const Pass& pass)
+    {
+        std::vector<FusedStage> stages;
+        stages.reserve(pass.effects.size());
+        for (const PostEffect* effect : pass.effects)
+        {
+            stages.push_back(effect->GetFusedStage());
+        }
+        return stages;
+    }
+
+    uint64_t PostEffectChain::GetPermutationKey(const std::vector<FusedStage>& stages)
+    {
+        // FNV-1a over the ordered stage names, the names identify the fragments
+        uint64_t hash = 0xcbf29ce484222325ull;
+        for (const auto& stage : stages)
+        {
+            std::string_view name = stage.name ? stage.name : "";
+            for (char c : name)
+            {
+                hash ^= static_cast<uint8_t>(c);
+                hash *= 0x100000001b3ull;
+            }
+
+            // Separator, so that "AB" + "C" and "A" + "BC" differ
+            hash ^= 0xff;
+            hash *= 0x100000001b3ull;
+        }
+
+        return hash != 0 ? hash : 1;
+    }
+
+    PostEffectChain::ConstantLayout PostEffectChain::GetConstantLayout(const std::vector<FusedStage>& stages)
+    {
+        // HLSL starts every struct of a cbuffer on a new 16-byte register
+        ConstantLayout layout;
+        for (const auto& stage : stages)
+        {
+            layout.offsets.push_back(layout.size);
+            layout.size += (stage.constantsSize + 15) & ~15u;
+        }
+
+        // Constant buffers cannot be empty
+        if (layout.size == 0)
+        {
+            layout.size = 16;
+        }
+
+        return layout;
+    }
+
+    std::string PostEffectChain::GenerateShader(const std::vector<FusedStage>& stages,
+                                                const std::vector<std::string>& fragmentSources)
+    {
+        std::string source = "// Generated by PostEffectChain\n\n";
+
+        // A stage may appear twice, its fragment is only declared once
+        std::unordered_set<std::string_view> declared;
+        for (size_t i = 0; i < stages.size(); ++i)
+        {
+            if (declared.insert(stages[i].name).second)
+            {
+                source += fragmentSources[i];
+                source += "\n\n";
+            }
+        }
+
+        source += "Texture2D SourceTexture : register(t0);\n";
+        source += "SamplerState LinearSampler : register(s0);\n";
+
+        uint32_t textureSlot = 1;
+        for (size_t i = 0; i < stages.size(); ++i)
+        {
+            for (uint32_t t = 0; t < stages[i].textureCount; ++t)
+            {
+                source += std::format("Texture2D Stage{}_Texture{} : register(t{});\n", i, t, textureSlot++);
+            }
+        }
+
+        source += "\ncbuffer FusedConstants : register(b0)\n{\n";
+        bool hasConstants = false;
+        for (size_t i = 0; i < stages.size(); ++i)
+        {
+            if (stages[i].constantsSize > 0)
+            {
+                source += std::format("    {}Params Stage{};\n", stages[i].name, i);
+                hasConstants = true;
+            }
+        }
+        if (!hasConstants)
+        {
+            source += "    float4 Unused;\n";
+        }
+        source += "};\n\n";
+
+        source += "struct PS_Input\n{\n";
+        source += "    float4 Position : SV_POSITION;\n";
+        source += "    float2 TexCoord : TEXCOORD0;\n";
+        source += "};\n\n";
+
+        source += "float4 main(PS_Input input) : SV_TARGET\n{\n";
+        source += "    float4 color = SourceTexture.Sample(LinearSampler, input.TexCoord);\n";
+        for (size_t i = 0; i < stages.size(); ++i)
+        {
+            std::string params = stages[i].constantsSize > 0 ? std::format("Stage{}", i)
+                                                             : std::format("({}Params)0", stages[i].name);
+
+            source += std::format(
+                "    color = {}_Apply(color, input.TexCoord, {}, LinearSampler", stages[i].name, params);
+            for (uint32_t t = 0; t < stages[i].textureCount; ++t)
+            {
+                source += std::format(", Stage{}_Texture{}", i, t);
+            }
+            source += ");\n";
+        }
+        source += "    return color;\n}\n";
+
+        return source;
+    }
+} // namespace Frost
@@ -0,0 +1,48 @@
+#pragma once
+
+#include "Frost/Core/Core.h"
+#include "Frost/Renderer/PostEffect.h"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace Frost
+{
+    // Splits a camera's post effects into passes and generates the shader of the fused ones. No GPU work happens here.
+    //
+    // A fragment (FusedStage::fragmentPath) declares, for a stage named Foo:
+    //     struct FooParams { ... };  // Same layout as the C++ constants, constantsSize bytes
+    //     float4 Foo_Apply(float4 color, float2 uv, FooParams params, SamplerState linearSampler
+    //                      [, Texture2D texture0, ...]);  // textureCount textures
+    class FROST_API PostEffectChain
+    {
+    public:
+        struct Pass
+        {
+            std::vector<PostEffect*> effects;
+            // Zero unless the pass runs several effects through a generated shader
+            uint64_t permutationKey = 0;
+
+            bool IsFused() const { return permutationKey != 0; }
+        };
+
+        struct ConstantLayout
+        {
+            // Byte offset of each stage in the merged constant buffer
+            std::vector<uint32_t> offsets;
+            uint32_t size = 0;
+        };
+
+        // Consecutive per-pixel effects are merged, every other effect keeps a pass of its own
+        static std::vector<Pass> Build(const std::vector<PostEffect*>& effects);
+
+        static std::vector<FusedStage> GetStages(const Pass& pass);
+        static uint64_t GetPermutationKey(const std::vector<FusedStage>& stages);
+        static ConstantLayout GetConstantLayout(const std::vector<FusedStage>& stages);
+
+        // fragmentSources holds the content of each stage's fragment, in stage order
+        static std::string GenerateShader(const std::vector<FusedStage>& stages,
+                                          const std::vector<std::string>& fragmentSources);
+    };
+} // namespace Frost
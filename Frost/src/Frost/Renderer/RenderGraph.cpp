@@ -0,0 +1,296 @@
+#include "Frost/Renderer/RenderGraph.h"
+#include "Frost/Asset/Texture.h"
+#include "Frost/Debugging/Assert.h"
+#include "Frost/Renderer/TransientTexturePool.h"
+
+#include <algorithm>
+
+namespace Frost
+{
+    RenderGraph::TextureHandle RenderGraph::Builder::Create(const std::string& name,
+                                                            const TextureDesc& desc,
+                                                            ResourceState state)
+    {
+        uint32_t resource = static_cast<uint32_t>(_graph._resources.size());
+        _graph._resources.push_back({ .name = name, .desc = desc });
+
+        TextureHandle handle = _graph._AddNode(resource, _pass);
+        _graph._passes[_pass].writes.push_back({ handle.node, state });
+        return handle;
+    }
+
+    RenderGraph::TextureHandle RenderGraph::Builder::Read(TextureHandle handle, ResourceState state)
+    {
+        FT_ENGINE_ASSERT(handle.IsValid(), "RenderGraph: reading an invalid texture");
+        _graph._passes[_pass].reads.push_back({ handle.node, state });
+        return handle;
+    }
+
+    RenderGraph::TextureHandle RenderGraph::Builder::Write(TextureHandle handle, ResourceState state)
+    {
+        FT_ENGINE_ASSERT(handle.IsValid(), "RenderGraph: writing an invalid texture");
+        _graph._passes[_pass].reads.push_back({ handle.node, state });
+
+        TextureHandle newVersion = _graph._AddNode(_graph._nodes[handle.node].resource, _pass);
+        _graph._passes[_pass].writes.push_back({ newVersion.node, state });
+        return newVersion;
+    }
+
+    void RenderGraph::Builder::SetSideEffect()
+    {
+        _graph._passes[_pass].hasSideEffect = true;
+    }
+
+    Texture* RenderGraph::Context::GetTexture(TextureHandle handle) const
+    {
+        const Resource& resource = _graph._resources[_graph._nodes[handle.node].resource];
+        if (!resource.IsTransient())
+        {
+            return resource.imported;
+        }
+
+        FT_ENGINE_ASSERT(resource.physical != INVALID_INDEX, "RenderGraph: texture '{}' is not used", resource.name);
+        return _graph._physicalBindings[resource.physical];
+    }
+
+    void RenderGraph::Reset()
+    {
+        _passes.clear();
+        _resources.clear();
+        _nodes.clear();
+        _physicalTextures.clear();
+        _physicalBindings.clear();
+    }
+
+    RenderGraph::TextureHandle RenderGraph::Import(const std::string& name, Texture* texture)
+    {
+        FT_ENGINE_ASSERT(texture, "RenderGraph: importing a null texture");
+
+        uint32_t resource = static_cast<uint32_t>(_resources.size());
+        TextureDesc desc = { .format = texture->GetFormat(),
+                             .width = texture->GetWidth(),
+                             .height = texture->GetHeight() };
+        _resources.push_back({ .name = name, .desc = desc, .imported = texture });
+        return _AddNode(resource, INVALID_INDEX);
+    }
+
+    void RenderGraph::Compile()
+    {
+        _CullPasses();
+        _ComputeLifetimes();
+        _AssignPhysicalTextures();
+        _ComputeBarriers();
+    }
+
+    void RenderGraph::Execute(CommandList* commandList, TransientTexturePool& pool)
+    {
+        _physicalBindings.clear();
+        for (const TextureDesc& desc : _physicalTextures)
+        {
+            _physicalBindings.push_back(pool.Acquire(desc));
+        }
+
+        Context context(*this, commandList);
+        for (Pass& pass : _passes)
+        {
+            if (!pass.isCulled && pass.execute)
+            {
+                pass.execute(context);
+            }
+        }
+
+        for (Texture* texture : _physicalBindings)
+        {
+            pool.Release(texture);
+        }
+        _physicalBindings.clear();
+    }
+
+    uint32_t RenderGraph::_AddPass(const std::string& name)
+    {
+        _passes.push_back({ .name = name });
+        return static_cast<uint32_t>(_passes.size() - 1);
+    }
+
+    RenderGraph::TextureHandle RenderGraph::_AddNode(uint32_t resource, uint32_t producer)
+    {
+        _nodes.push_back({ .resource = resource, .producer = producer });
+        return { static_cast<uint32_t>(_nodes.size() - 1) };
+    }
+
+    void RenderGraph::_CullPasses()
+    {
+        for (Node& node : _nodes)
+        {
+            node.refCount = 0;
+        }
+
+        for (Pass& pass : _passes)
+        {
+            pass.isCulled = false;
+            pass.refCount = static_cast<uint32_t>(pass.writes.size());
+            for (const Access& read : pass.reads)
+            {
+                ++_nodes[read.node].refCount;
+            }
+
+            // Writing an imported texture is an output of the graph
+            for (const Access& write : pass.writes)
+            {
+                if (!_resources[_nodes[write.node].resource].IsTransient())
+                {
+                    pass.hasSideEffect = true;
+                }
+            }
+        }
+
+        // Flood from the versions nobody reads back to the passes that only produce those
+        std::vector<uint32_t> unreferenced;
+        for (uint32_t node = 0; node < _nodes.size(); ++node)
+        {
+            if (_nodes[node].refCount == 0)
+            {
+                unreferenced.push_back(node);
+            }
+        }
+
+        while (!unreferenced.empty())
+        {
+            uint32_t producer = _nodes[unreferenced.back()].producer;
+            unreferenced.pop_back();
+
+            if (producer == INVALID_INDEX)
+            {
+                continue;
+            }
+
+            Pass& pass = _passes[producer];
+            if (pass.hasSideEffect || pass.isCulled || --pass.refCount > 0)
+            {
+                continue;
+            }
+
+            pass.isCulled = true;
+            for (const Access& read : pass.reads)
+            {
+                if (--_nodes[read.node].refCount == 0)
+                {
+                    unreferenced.push_back(read.node);
+                }
+            }
+        }
+    }
+
+    void RenderGraph::_ComputeLifetimes()
+    {
+        for (Resource& resource : _resources)
+        {
+            resource.firstPass = INVALID_INDEX;
+            resource.lastPass = INVALID_INDEX;
+            resource.physical = INVALID_INDEX;
+        }
+
+        for (uint32_t passIndex = 0; passIndex < _passes.size(); ++passIndex)
+        {
+            const Pass& pass = _passes[passIndex];
+            if (pass.isCulled)
+            {
+                continue;
+            }
+
+            auto use = [&](const Access& access)
+            {
+                Resource& resource = _resources[_nodes[access.node].resource];
+                if (resource.firstPass == INVALID_INDEX)
+                {
+                    resource.firstPass = passIndex;
+                }
+                resource.lastPass = passIndex;
+            };
+            std::ranges::for_each(pass.reads, use);
+            std::ranges::for_each(pass.writes, use);
+        }
+    }
+
+    void RenderGraph::_AssignPhysicalTextures()
+    {
+        _physicalTextures.clear();
+
+        // Physical textures free for reuse, a texture is freed after the last pass using its resource
+        std::vector<uint32_t> freeTextures;
+        std::vector<bool> isReleased(_resources.size(), false);
+
+        for (uint32_t passIndex = 0; passIndex < _passes.size(); ++passIndex)
+        {
+            const Pass& pass = _passes[passIndex];
+            if (pass.isCulled)
+            {
+                continue;
+            }
+
+            auto allocate = [&](const Access& access)
+            {
+                Resource& resource = _resources[_nodes[access.node].resource];
+                if (!resource.IsTransient() || resource.physical != INVALID_INDEX)
+                {
+                    return;
+                }
+
+                auto it = std::ranges::find_if(freeTextures,
+                                               [&](uint32_t texture)
+                                               { return _physicalTextures[texture] == resource.desc; });
+                if (it != freeTextures.end())
+                {
+                    resource.physical = *it;
+                    freeTextures.erase(it);
+                }
+                else
+                {
+                    resource.physical = static_cast<uint32_t>(_physicalTextures.size());
+                    _physicalTextures.push_back(resource.desc);
+                }
+            };
+            std::ranges::for_each(pass.reads, allocate);
+            std::ranges::for_each(pass.writes, allocate);
+
+            auto release = [&](const Access& access)
+            {
+                uint32_t resourceIndex = _nodes[access.node].resource;
+                Resource& resource = _resources[resourceIndex];
+                if (resource.IsTransient() && resource.lastPass == passIndex && !isReleased[resourceIndex])
+                {
+                    isReleased[resourceIndex] = true;
+                    freeTextures.push_back(resource.physical);
+                }
+            };
+            std::ranges::for_each(pass.reads, release);
+            std::ranges::for_each(pass.writes, release);
+        }
+    }
+
+    void RenderGraph::_ComputeBarriers()
+    {
+        std::vector<ResourceState> states(_resources.size(), ResourceState::Undefined);
+
+        for (Pass& pass : _passes)
+        {
+            pass.barriers.clear();
+            if (pass.isCulled)
+            {
+                continue;
+            }
+
+            auto transition = [&](const Access& access)
+            {
+                uint32_t resource = _nodes[access.node].resource;
+                if (states[resource] != access.state)
+                {
+                    pass.barriers.push_back({ resource, states[resource], access.state });
+                    states[resource] = access.state;
+                }
+            };
+            std::ranges::for_each(pass.reads, transition);
+            std::ranges::for_each(pass.writes, transition);
+        }
+    }
+} // namespace Frost
@@ -0,0 +1,191 @@
+#pragma once
+
+#include "Frost/Core/Core.h"
+#include "Frost/Renderer/Format.h"
+
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace Frost
+{
+    class CommandList;
+    class Texture;
+    class TransientTexturePool;
+
+    // Frame graph: passes declare the textures they read and write, Compile() then culls the passes nothing depends on,
+    // computes the state transitions and aliases transient textures whose lifetimes do not overlap. Compile() does no
+    // GPU work, Execute() gets the textures from a TransientTexturePool and runs the surviving passes in order.
+    //
+    // A graph is rebuilt every frame: Reset(), Import()/AddPass(), Compile(), Execute(). The setup function of a pass
+    // declares its textures on the Builder and returns the function recording the pass:
+    //
+    //     graph.AddPass("Blur",
+    //                   [&](RenderGraph::Builder& builder)
+    //                   {
+    //                       auto input = builder.Read(scene);
+    //                       auto output = builder.Create("Blurred", desc);
+    //                       return [=](RenderGraph::Context& context) { ... context.GetTexture(output) ... };
+    //                   });
+    class FROST_API RenderGraph
+    {
+    public:
+        static constexpr uint32_t INVALID_INDEX = UINT32_MAX;
+
+        struct TextureHandle
+        {
+            uint32_t node = INVALID_INDEX;
+
+            bool IsValid() const { return node != INVALID_INDEX; }
+        };
+
+        struct TextureDesc
+        {
+            Format format = Format::RGBA8_UNORM;
+            uint32_t width = 0;
+            uint32_t height = 0;
+
+            bool operator==(const TextureDesc& other) const = default;
+        };
+
+        enum class ResourceState : uint8_t
+        {
+            Undefined,
+            ShaderResource,
+            RenderTarget,
+            DepthWrite,
+            CopySource,
+            CopyDest
+        };
+
+        struct Barrier
+        {
+            uint32_t resource;
+            ResourceState before;
+            ResourceState after;
+        };
+
+        class Context;
+        using ExecuteFunction = std::function<void(Context&)>;
+
+        class FROST_API Builder
+        {
+        public:
+            // The content is undefined until the pass writes it, the texture may be shared with others
+            TextureHandle Create(const std::string& name,
+                                 const TextureDesc& desc,
+                                 ResourceState state = ResourceState::RenderTarget);
+            TextureHandle Read(TextureHandle handle, ResourceState state = ResourceState::ShaderResource);
+            // Returns the new version of the texture. The previous content is kept, so the previous version is read
+            // as well.
+            TextureHandle Write(TextureHandle handle, ResourceState state = ResourceState::RenderTarget);
+            // The pass is never culled, for passes whose output is not a texture of the graph
+            void SetSideEffect();
+
+        private:
+            friend class RenderGraph;
+            Builder(RenderGraph& graph, uint32_t pass) : _graph(graph), _pass(pass) {}
+
+            RenderGraph& _graph;
+            uint32_t _pass;
+        };
+
+        class FROST_API Context
+        {
+        public:
+            // Every version of a texture resolves to the same texture
+            Texture* GetTexture(TextureHandle handle) const;
+            CommandList* GetCommandList() const { return _commandList; }
+
+        private:
+            friend class RenderGraph;
+            Context(const RenderGraph& graph, CommandList* commandList) : _graph(graph), _commandList(commandList) {}
+
+            const RenderGraph& _graph;
+            CommandList* _commandList;
+        };
+
+        void Reset();
+
+        // External textures (back buffer, pipeline outputs). Passes writing them are the outputs of the graph.
+        TextureHandle Import(const std::string& name, Texture* texture);
+        const TextureDesc& GetDesc(TextureHandle handle) const { return _resources[_nodes[handle.node].resource].desc; }
+
+        template<typename SetupFunction>
+        void AddPass(const std::string& name, SetupFunction&& setup)
+        {
+            uint32_t pass = _AddPass(name);
+            Builder builder(*this, pass);
+            _passes[pass].execute = setup(builder);
+        }
+
+        void Compile();
+        void Execute(CommandList* commandList, TransientTexturePool& pool);
+
+        // Compile() results
+        uint32_t GetPassCount() const { return static_cast<uint32_t>(_passes.size()); }
+        bool IsPassCulled(uint32_t pass) const { return _passes[pass].isCulled; }
+        const std::vector<Barrier>& GetBarriers(uint32_t pass) const { return _passes[pass].barriers; }
+        uint32_t GetResourceCount() const { return static_cast<uint32_t>(_resources.size()); }
+        // Index of the pooled texture backing a transient resource, INVALID_INDEX for imported or unused ones
+        uint32_t GetPhysicalTexture(uint32_t resource) const { return _resources[resource].physical; }
+        uint32_t GetPhysicalTextureCount() const { return static_cast<uint32_t>(_physicalTextures.size()); }
+        uint32_t GetResource(TextureHandle handle) const { return _nodes[handle.node].resource; }
+
+    private:
+        struct Access
+        {
+            uint32_t node;
+            ResourceState state;
+        };
+
+        struct Pass
+        {
+            std::string name;
+            ExecuteFunction execute;
+            std::vector<Access> reads;
+            std::vector<Access> writes;
+            std::vector<Barrier> barriers;
+            uint32_t refCount = 0;
+            bool hasSideEffect = false;
+            bool isCulled = false;
+        };
+
+        struct Resource
+        {
+            std::string name;
+            TextureDesc desc;
+            Texture* imported = nullptr;
+            uint32_t firstPass = INVALID_INDEX;
+            uint32_t lastPass = INVALID_INDEX;
+            uint32_t physical = INVALID_INDEX;
+
+            bool IsTransient() const { return imported == nullptr; }
+        };
+
+        // One version of a resource, every write creates a new node
+        struct Node
+        {
+            uint32_t resource;
+            uint32_t producer = INVALID_INDEX;
+            uint32_t refCount = 0;
+        };
+
+        uint32_t _AddPass(const std::string& name);
+        TextureHandle _AddNode(uint32_t resource, uint32_t producer);
+
+        void _CullPasses();
+        void _ComputeLifetimes();
+        void _AssignPhysicalTextures();
+        void _ComputeBarriers();
+
+        std::vector<Pass> _passes;
+        std::vector<Resource> _resources;
+        std::vector<Node> _nodes;
+
+        std::vector<TextureDesc> _physicalTextures;
+        // Textures acquired for the current Execute()
+        std::vector<Texture*> _physicalBindings;
+    };
+} // namespace Frost
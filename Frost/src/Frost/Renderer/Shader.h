@@ -4,6 +4,8 @@
 
 #include <memory>
 #include <string>
+#include <utility>
+#include <vector>
 
 namespace Frost
 {
@@ -18,11 +20,16 @@ namespace Frost
         Vertex
     };
 
+    // Name and value of a preprocessor macro passed to the compiler
+    using ShaderDefine = std::pair<std::string, std::string>;
+
     struct ShaderDesc
     {
         ShaderType type = ShaderType::None;
         std::string debugName;
         std::string filePath;
+        std::string entryPoint = "main";
+        std::vector<ShaderDefine> defines;
     };
 
     class FROST_API Shader
@@ -0,0 +1,488 @@
+#include "Frost/Renderer/ShaderCache.h"
+#include "Frost/Debugging/Logger.h"
+#include "Frost/Utils/SerializerUtils.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <future>
+#include <sstream>
+#include <thread>
+#include <unordered_set>
+
+namespace Frost
+{
+    static constexpr uint64_t FNV_OFFSET_BASIS = 0xcbf29ce484222325ull;
+    static constexpr uint64_t FNV_PRIME = 0x100000001b3ull;
+
+    ShaderCache::ShaderCache(const ShaderCompiler& compiler, const std::filesystem::path& archivePath) :
+        _compiler(compiler), _archivePath(archivePath)
+    {
+    }
+
+    bool ShaderCache::Load()
+    {
+        std::ifstream in(_archivePath, std::ios::binary);
+        if (!in)
+        {
+            return false;
+        }
+
+        uint32_t magic = 0;
+        uint32_t version = 0;
+        uint32_t count = 0;
+        ReadBinary(in, magic);
+        ReadBinary(in, version);
+        ReadBinary(in, count);
+
+        if (!in || magic != CACHE_MAGIC || version != CACHE_VERSION)
+        {
+            FT_ENGINE_WARN("ShaderCache: ignoring outdated cache '{}'", _archivePath.string());
+            return false;
+        }
+
+        std::lock_guard lock(_mutex);
+        _entries.clear();
+
+        for (uint32_t i = 0; i < count; ++i)
+        {
+            uint64_t key = 0;
+            uint8_t type = 0;
+            ReadBinary(in, key);
+            ReadBinary(in, type);
+
+            Entry entry;
+            entry.desc.type = static_cast<ShaderType>(type);
+            entry.desc.filePath = ReadBinaryString(in);
+            entry.desc.debugName = std::filesystem::path(entry.desc.filePath).stem().string();
+            entry.desc.entryPoint = ReadBinaryString(in);
+
+            uint32_t defineCount = 0;
+            ReadBinary(in, defineCount);
+            for (uint32_t j = 0; j < defineCount && in; ++j)
+            {
+                std::string name = ReadBinaryString(in);
+                std::string value = ReadBinaryString(in);
+                entry.desc.defines.emplace_back(std::move(name), std::move(value));
+            }
+
+            uint32_t bytecodeSize = 0;
+            ReadBinary(in, bytecodeSize);
+            if (!in)
+            {
+                break;
+            }
+
+            entry.bytecode.resize(bytecodeSize);
+            in.read(entry.bytecode.data(), bytecodeSize);
+            if (!in)
+            {
+                break;
+            }
+
+            _entries.emplace(key, std::move(entry));
+        }
+
+        _dirty = false;
+        FT_ENGINE_INFO("ShaderCache: loaded {} shaders from '{}'", _entries.size(), _archivePath.string());
+        return true;
+    }
+
+    bool ShaderCache::Save()
+    {
+        std::lock_guard lock(_mutex);
+        if (!_dirty)
+        {
+            return true;
+        }
+
+        std::error_code ec;
+        std::filesystem::create_directories(_archivePath.parent_path(), ec);
+
+        std::filesystem::path tempFile = _archivePath;
+        tempFile += ".tmp";
+
+        {
+            std::ofstream out(tempFile, std::ios::binary | std::ios::trunc);
+            if (!out)
+            {
+                FT_ENGINE_WARN("ShaderCache: cannot write cache '{}'", _archivePath.string());
+                return false;
+            }
+
+            WriteBinary(out, CACHE_MAGIC);
+            WriteBinary(out, CACHE_VERSION);
+            WriteBinary(out, static_cast<uint32_t>(_entries.size()));
+
+            for (const auto& [key, entry] : _entries)
+            {
+                WriteBinary(out, key);
+                WriteBinary(out, static_cast<uint8_t>(entry.desc.type));
+                WriteBinaryString(out, entry.desc.filePath);
+                WriteBinaryString(out, entry.desc.entryPoint);
+
+                WriteBinary(out, static_cast<uint32_t>(entry.desc.defines.size()));
+                for (const auto& [name, value] : entry.desc.defines)
+                {
+                    WriteBinaryString(out, name);
+                    WriteBinaryString(out, value);
+                }
+
+                WriteBinary(out, static_cast<uint32_t>(entry.bytecode.size()));
+                out.write(entry.bytecode.data(), entry.bytecode.size());
+            }
+        }
+
+        std::filesystem::rename(tempFile, _archivePath, ec);
+        if (ec)
+        {
+            FT_ENGINE_WARN("ShaderCache: cannot replace cache '{}': {}", _archivePath.string(), ec.message());
+            return false;
+        }
+
+        _dirty = false;
+        return true;
+    }
+
+    void ShaderCache::Prewarm(const std::vector<ShaderDesc>& requests)
+    {
+        struct Job
+        {
+            const ShaderDesc* desc;
+            uint64_t key;
+        };
+
+        std::vector<Job> jobs;
+        std::unordered_set<uint64_t> queued;
+
+        for (const auto& desc : requests)
+        {
+            uint64_t key = ComputeKey(desc);
+            {
+                std::lock_guard lock(_mutex);
+                if (_entries.contains(key))
+                {
+                    ++_hits;
+                    continue;
+                }
+            }
+
+            if (queued.insert(key).second)
+            {
+                jobs.push_back({ &desc, key });
+            }
+        }
+
+        if (jobs.empty())
+        {
+            return;
+        }
+
+        auto start = std::chrono::steady_clock::now();
+
+        size_t workerCount = std::clamp<size_t>(std::thread::hardware_concurrency(), 1, jobs.size());
+        std::atomic<size_t> nextJob = 0;
+
+        std::vector<std::future<void>> workers;
+        workers.reserve(workerCount);
+        for (size_t i = 0; i < workerCount; ++i)
+        {
+            workers.push_back(std::async(std::launch::async,
+                                         [this, &jobs, &nextJob]()
+                                         {
+                                             for (size_t index = nextJob++; index < jobs.size(); index = nextJob++)
+                                             {
+                                                 const Job& job = jobs[index];
+
+                                                 std::string log;
+                                                 if (!_Compile(*job.desc, job.key, &log))
+                                                 {
+                                                     FT_ENGINE_ERROR("ShaderCache: failed to compile '{}'\n{}",
+                                                                     job.desc->filePath,
+                                                                     log);
+                                                 }
+                                             }
+                                         }));
+        }
+
+        for (auto& worker : workers)
+        {
+            worker.wait();
+        }
+
+        auto elapsed = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - start);
+        FT_ENGINE_INFO("ShaderCache: compiled {} shaders on {} threads in {:.0f} ms",
+                       jobs.size(),
+                       workerCount,
+                       elapsed.count());
+    }
+
+    std::vector<ShaderDesc> ShaderCache::GetKnownShaders() const
+    {
+        std::lock_guard lock(_mutex);
+
+        std::vector<ShaderDesc> shaders;
+        shaders.reserve(_entries.size());
+        for (const auto& [key, entry] : _entries)
+        {
+            shaders.push_back(entry.desc);
+        }
+        return shaders;
+    }
+
+    bool ShaderCache::GetBytecode(const ShaderDesc& desc, std::vector<char>& outBytecode, std::string* outLog)
+    {
+        uint64_t key = ComputeKey(desc);
+
+        {
+            std::lock_guard lock(_mutex);
+            auto it = _entries.find(key);
+            if (it != _entries.end())
+            {
+                ++_hits;
+                outBytecode = it->second.bytecode;
+                return true;
+            }
+        }
+
+        return _Compile(desc, key, outLog, &outBytecode);
+    }
+
+    uint64_t ShaderCache::ComputeKey(const ShaderDesc& desc)
+    {
+        uint64_t hash = FNV_OFFSET_BASIS;
+
+        uint64_t configuration = _compiler.GetConfigurationHash();
+        hash = _Hash(hash, &configuration, sizeof(configuration));
+        hash = _Hash(hash, _compiler.GetProfile(desc.type));
+        hash = _Hash(hash, desc.entryPoint);
+
+        for (const auto& [name, value] : desc.defines)
+        {
+            hash = _Hash(hash, name);
+            hash = _Hash(hash, value);
+        }
+
+        std::filesystem::path path(desc.filePath);
+        std::vector<std::string> visited;
+        _HashSource(path.parent_path(), path.filename().string(), hash, visited);
+
+        return hash;
+    }
+
+    size_t ShaderCache::GetEntryCount() const
+    {
+        std::lock_guard lock(_mutex);
+        return _entries.size();
+    }
+
+    std::vector<ShaderDesc> ShaderCache::GatherShaders(const std::filesystem::path& directory)
+    {
+        static const std::pair<const char*, ShaderType> prefixes[] = {
+            { "VS_", ShaderType::Vertex }, { "PS_", ShaderType::Pixel },    { "GS_", ShaderType::Geometry },
+            { "HS_", ShaderType::Hull },   { "DS_", ShaderType::Domain },   { "CS_", ShaderType::Compute },
+        };
+
+        std::vector<ShaderDesc> shaders;
+
+        std::error_code ec;
+        for (auto it = std::filesystem::recursive_directory_iterator(directory, ec);
+             !ec && it != std::filesystem::recursive_directory_iterator();
+             it.increment(ec))
+        {
+            if (!it->is_regular_file() || it->path().extension() != ".hlsl")
+            {
+                continue;
+            }
+
+            std::string fileName = it->path().filename().string();
+            for (const auto& [prefix, type] : prefixes)
+            {
+                if (fileName.starts_with(prefix))
+                {
+                    shaders.push_back({ .type = type,
+                                        .debugName = it->path().stem().string(),
+                                        .filePath = it->path().generic_string() });
+                    break;
+                }
+            }
+        }
+
+        return shaders;
+    }
+
+    void ShaderCache::_HashSource(const std::filesystem::path& includeDir,
+                                  const std::string& fileName,
+                                  uint64_t& hash,
+                                  std::vector<std::string>& visited)
+    {
+        if (std::find(visited.begin(), visited.end(), fileName) != visited.end())
+        {
+            return;
+        }
+        visited.push_back(fileName);
+
+        SourceFile file;
+        if (!_GetSourceFile(includeDir / fileName, file))
+        {
+            // Hashed anyway so that the key changes once the file shows up
+            hash = _Hash(hash, "<missing>" + fileName);
+            return;
+        }
+
+        hash = _Hash(hash, &file.contentHash, sizeof(file.contentHash));
+
+        for (const auto& include : file.includes)
+        {
+            _HashSource(includeDir, include, hash, visited);
+        }
+    }
+
+    bool ShaderCache::_GetSourceFile(const std::filesystem::path& path, SourceFile& outFile)
+    {
+        std::error_code ec;
+        auto lastWriteTime = std::filesystem::last_write_time(path, ec);
+        if (ec)
+        {
+            return false;
+        }
+
+        std::string name = path.lexically_normal().generic_string();
+
+        {
+            std::lock_guard lock(_mutex);
+            auto it = _sourceFiles.find(name);
+            if (it != _sourceFiles.end() && it->second.lastWriteTime == lastWriteTime)
+            {
+                outFile = it->second;
+                return true;
+            }
+        }
+
+        std::ifstream in(path, std::ios::binary);
+        if (!in)
+        {
+            return false;
+        }
+
+        std::stringstream buffer;
+        buffer << in.rdbuf();
+        std::string source = buffer.str();
+
+        outFile.lastWriteTime = lastWriteTime;
+        outFile.contentHash = _Hash(FNV_OFFSET_BASIS, source);
+        outFile.includes = _ParseIncludes(source);
+
+        std::lock_guard lock(_mutex);
+        _sourceFiles[name] = outFile;
+        return true;
+    }
+
+    bool ShaderCache::_Compile(const ShaderDesc& desc,
+                               uint64_t key,
+                               std::string* outLog,
+                               std::vector<char>* outBytecode)
+    {
+        ShaderCompiler::Result result = _compiler.Compile(desc);
+
+        if (outLog)
+        {
+            *outLog = std::move(result.log);
+        }
+
+        if (!result.success)
+        {
+            return false;
+        }
+
+        std::lock_guard lock(_mutex);
+
+        // An older build of the same shader will never be requested again
+        std::string requestName = _GetRequestName(desc);
+        std::erase_if(_entries, [&](const auto& pair) { return _GetRequestName(pair.second.desc) == requestName; });
+
+        if (outBytecode)
+        {
+            *outBytecode = result.bytecode;
+        }
+
+        _entries[key] = { desc, std::move(result.bytecode) };
+        ++_misses;
+        _dirty = true;
+        return true;
+    }
+
+    uint64_t ShaderCache::_Hash(uint64_t hash, const void* data, size_t size)
+    {
+        const auto* bytes = static_cast<const uint8_t*>(data);
+        for (size_t i = 0; i < size; ++i)
+        {
+            hash ^= bytes[i];
+            hash *= FNV_PRIME;
+        }
+        return hash;
+    }
+
+    uint64_t ShaderCache::_Hash(uint64_t hash, const std::string& value)
+    {
+        // The length keeps "ab" + "c" apart from "a" + "bc"
+        uint64_t size = value.size();
+        hash = _Hash(hash, &size, sizeof(size));
+        return _Hash(hash, value.data(), value.size());
+    }
+
+    std::vector<std::string> ShaderCache::_ParseIncludes(const std::string& source)
+    {
+        // Conditional blocks are not evaluated, an include that is compiled out only costs a spurious dependency
+        std::vector<std::string> includes;
+
+        std::istringstream lines(source);
+        std::string line;
+        while (std::getline(lines, line))
+        {
+            size_t pos = line.find_first_not_of(" \t");
+            if (pos == std::string::npos || line[pos] != '#')
+            {
+                continue;
+            }
+
+            pos = line.find_first_not_of(" \t", pos + 1);
+            if (pos == std::string::npos || line.compare(pos, 7, "include") != 0)
+            {
+                continue;
+            }
+
+            size_t open = line.find_first_of("\"<", pos + 7);
+            if (open == std::string::npos)
+            {
+                continue;
+            }
+
+            size_t close = line.find(line[open] == '"' ? '"' : '>', open + 1);
+            if (close != std::string::npos)
+            {
+                includes.push_back(line.substr(open + 1, close - open - 1));
+            }
+        }
+
+        return includes;
+    }
+
+    std::string ShaderCache::_GetRequestName(const ShaderDesc& desc)
+    {
+        std::string name = std::filesystem::path(desc.filePath).lexically_normal().generic_string();
+        name += '|';
+        name += std::to_string(static_cast<int>(desc.type));
+        name += '|';
+        name += desc.entryPoint;
+        for (const auto& [define, value] : desc.defines)
+        {
+            name += '|';
+            name += define;
+            name += '=';
+            name += value;
+        }
+        return name;
+    }
+} // namespace Frost
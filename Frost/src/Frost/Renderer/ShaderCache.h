@@ -0,0 +1,91 @@
+#pragma once
+
+#include "Frost/Core/Core.h"
+#include "Frost/Renderer/ShaderCompiler.h"
+
+#include <cstdint>
+#include <filesystem>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace Frost
+{
+    // Compiled bytecode keyed by a hash of everything that affects it: the source, every file it includes, the
+    // defines, the entry point, the profile and the compiler configuration. Stored as one packed archive
+    class FROST_API ShaderCache
+    {
+    public:
+        ShaderCache(const ShaderCompiler& compiler, const std::filesystem::path& archivePath);
+
+        bool Load();
+        // Does nothing when no entry was added since the last load or save
+        bool Save();
+
+        // Compiles every request that misses the cache, spread over worker threads
+        void Prewarm(const std::vector<ShaderDesc>& requests);
+        // The shaders stored in the archive, so that edited ones are rebuilt at startup rather than on first use
+        std::vector<ShaderDesc> GetKnownShaders() const;
+
+        // Returns false and fills the log when the shader does not compile
+        bool GetBytecode(const ShaderDesc& desc, std::vector<char>& outBytecode, std::string* outLog = nullptr);
+
+        uint64_t ComputeKey(const ShaderDesc& desc);
+
+        size_t GetEntryCount() const;
+        uint32_t GetHitCount() const { return _hits; }
+        uint32_t GetMissCount() const { return _misses; }
+
+        // Every file of a directory tree named after the engine convention: VS_*.hlsl, PS_*.hlsl...
+        static std::vector<ShaderDesc> GatherShaders(const std::filesystem::path& directory);
+
+    private:
+        struct Entry
+        {
+            ShaderDesc desc;
+            std::vector<char> bytecode;
+        };
+
+        struct SourceFile
+        {
+            std::filesystem::file_time_type lastWriteTime;
+            uint64_t contentHash = 0;
+            std::vector<std::string> includes;
+        };
+
+        // Includes are resolved from the directory of the root shader, like ShaderIncludeDX11 does
+        void _HashSource(const std::filesystem::path& includeDir,
+                         const std::string& fileName,
+                         uint64_t& hash,
+                         std::vector<std::string>& visited);
+        // Stores the bytecode, and copies it to outBytecode under the same lock since another compile of the same
+        // shader may replace the entry right after
+        bool _Compile(const ShaderDesc& desc,
+                      uint64_t key,
+                      std::string* outLog,
+                      std::vector<char>* outBytecode = nullptr);
+        bool _GetSourceFile(const std::filesystem::path& path, SourceFile& outFile);
+
+        static uint64_t _Hash(uint64_t hash, const void* data, size_t size);
+        static uint64_t _Hash(uint64_t hash, const std::string& value);
+        static std::vector<std::string> _ParseIncludes(const std::string& source);
+        static std::string _GetRequestName(const ShaderDesc& desc);
+
+    private:
+        const ShaderCompiler& _compiler;
+        std::filesystem::path _archivePath;
+
+        mutable std::mutex _mutex;
+        std::unordered_map<uint64_t, Entry> _entries;
+        // Reused as long as the file on disk keeps the same write time
+        std::unordered_map<std::string, SourceFile> _sourceFiles;
+        bool _dirty = false;
+
+        uint32_t _hits = 0;
+        uint32_t _misses = 0;
+
+        static constexpr uint32_t CACHE_MAGIC = 0x48535446; // "FTSH"
+        static constexpr uint32_t CACHE_VERSION = 1;
+    };
+} // namespace Frost
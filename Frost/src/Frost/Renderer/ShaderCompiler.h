@@ -0,0 +1,32 @@
+#pragma once
+
+#include "Frost/Core/Core.h"
+#include "Frost/Renderer/Shader.h"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace Frost
+{
+    // Turns HLSL source into bytecode. Kept apart from the cache so that the cache can run with a stub compiler
+    class FROST_API ShaderCompiler
+    {
+    public:
+        struct Result
+        {
+            bool success = false;
+            std::vector<char> bytecode;
+            std::string log;
+        };
+
+        virtual ~ShaderCompiler() = default;
+
+        // Must be safe to call from several threads at once
+        virtual Result Compile(const ShaderDesc& desc) const = 0;
+
+        virtual std::string GetProfile(ShaderType type) const = 0;
+        // Anything besides the source that changes the output: compiler version, optimization flags...
+        virtual uint64_t GetConfigurationHash() const = 0;
+    };
+} // namespace Frost
@@ -0,0 +1,127 @@
+#include "Frost/Renderer/ShadowAtlas.h"
+
+#include <algorithm>
+#include <bit>
+
+namespace Frost
+{
+    ShadowAtlas::ShadowAtlas(uint32_t size, uint32_t minTileSize) :
+        _size(std::bit_ceil(size)), _minTileSize(std::clamp(std::bit_ceil(minTileSize), 1u, _size))
+    {
+        _freeTiles.resize(_GetLevel(_minTileSize) + 1);
+        Clear();
+    }
+
+    ShadowAtlas::Tile ShadowAtlas::Allocate(uint32_t size)
+    {
+        const uint32_t tileSize = RoundTileSize(size);
+        const uint32_t level = _GetLevel(tileSize);
+
+        // Smallest free tile that is large enough
+        uint32_t freeLevel = level + 1;
+        while (freeLevel > 0 && _freeTiles[freeLevel - 1].empty())
+        {
+            --freeLevel;
+        }
+        if (freeLevel == 0)
+        {
+            return {};
+        }
+        --freeLevel;
+
+        Tile tile = _freeTiles[freeLevel].back();
+        _freeTiles[freeLevel].pop_back();
+
+        // Split down to the requested size, keeping the top-left quarter each time
+        while (freeLevel < level)
+        {
+            ++freeLevel;
+            tile.size /= 2;
+            _freeTiles[freeLevel].push_back({ tile.x + tile.size, tile.y, tile.size });
+            _freeTiles[freeLevel].push_back({ tile.x, tile.y + tile.size, tile.size });
+            _freeTiles[freeLevel].push_back({ tile.x + tile.size, tile.y + tile.size, tile.size });
+        }
+
+        return tile;
+    }
+
+    void ShadowAtlas::Free(const Tile& tile)
+    {
+        if (!tile.IsValid())
+        {
+            return;
+        }
+
+        Tile current = tile;
+        uint32_t level = _GetLevel(current.size);
+
+        while (level > 0)
+        {
+            const uint32_t parentSize = current.size * 2;
+            const Tile parent = { current.x - current.x % parentSize, current.y - current.y % parentSize, parentSize };
+
+            const Tile quarters[4] = { { parent.x, parent.y, current.size },
+                                       { parent.x + current.size, parent.y, current.size },
+                                       { parent.x, parent.y + current.size, current.size },
+                                       { parent.x + current.size, parent.y + current.size, current.size } };
+
+            auto& freeTiles = _freeTiles[level];
+            bool siblingsFree = std::ranges::all_of(quarters,
+                                                    [&](const Tile& quarter)
+                                                    {
+                                                        return quarter == current ||
+                                                               std::ranges::find(freeTiles, quarter) != freeTiles.end();
+                                                    });
+            if (!siblingsFree)
+            {
+                break;
+            }
+
+            for (const Tile& quarter : quarters)
+            {
+                if (quarter != current)
+                {
+                    _TakeFreeTile(level, quarter);
+                }
+            }
+
+            current = parent;
+            --level;
+        }
+
+        _freeTiles[level].push_back(current);
+    }
+
+    void ShadowAtlas::Clear()
+    {
+        for (auto& tiles : _freeTiles)
+        {
+            tiles.clear();
+        }
+        _freeTiles[0].push_back({ 0, 0, _size });
+    }
+
+    uint32_t ShadowAtlas::RoundTileSize(uint32_t size) const
+    {
+        return std::clamp(std::bit_ceil(std::max(size, 1u)), _minTileSize, _size);
+    }
+
+    uint32_t ShadowAtlas::_GetLevel(uint32_t tileSize) const
+    {
+        return std::countr_zero(_size) - std::countr_zero(tileSize);
+    }
+
+    bool ShadowAtlas::_TakeFreeTile(uint32_t level, const Tile& tile)
+    {
+        auto& freeTiles = _freeTiles[level];
+        auto it = std::ranges::find(freeTiles, tile);
+        if (it == freeTiles.end())
+        {
+            return false;
+        }
+
+        *it = freeTiles.back();
+        freeTiles.pop_back();
+        return true;
+    }
+} // namespace Frost
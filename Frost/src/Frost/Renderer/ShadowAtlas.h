@@ -0,0 +1,47 @@
+#pragma once
+
+#include "Frost/Core/Core.h"
+
+#include <cstdint>
+#include <vector>
+
+namespace Frost
+{
+    // Square tile allocator for the shadow atlas. Tiles are powers of two, a tile is split in four when a smaller
+    // one is needed and the four quarters are merged back once they are all free. No GPU work happens here.
+    class FROST_API ShadowAtlas
+    {
+    public:
+        struct Tile
+        {
+            uint32_t x = 0;
+            uint32_t y = 0;
+            uint32_t size = 0;
+
+            bool IsValid() const { return size != 0; }
+            bool operator==(const Tile& other) const = default;
+        };
+
+        ShadowAtlas(uint32_t size, uint32_t minTileSize);
+
+        // The size is rounded up to a power of two and clamped to [minTileSize, size]. Returns an invalid tile when
+        // the atlas is full.
+        Tile Allocate(uint32_t size);
+        void Free(const Tile& tile);
+        void Clear();
+
+        uint32_t GetSize() const { return _size; }
+        uint32_t GetMinTileSize() const { return _minTileSize; }
+        uint32_t RoundTileSize(uint32_t size) const;
+
+    private:
+        uint32_t _GetLevel(uint32_t tileSize) const;
+        bool _TakeFreeTile(uint32_t level, const Tile& tile);
+
+        uint32_t _size;
+        uint32_t _minTileSize;
+
+        // Free tiles per level, level 0 being the whole atlas
+        std::vector<std::vector<Tile>> _freeTiles;
+    };
+} // namespace Frost
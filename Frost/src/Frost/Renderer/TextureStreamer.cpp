@@ -0,0 +1,219 @@
+#include "Frost/Renderer/TextureStreamer.h"
+#include "Frost/Asset/AssetManager.h"
+#include "Frost/Asset/Texture.h"
+
+#include <algorithm>
+#include <vector>
+
+namespace Frost
+{
+    FROST_API TextureStreamingSettings TextureStreamer::_settings;
+    FROST_API std::unordered_map<const Texture*, TextureStreamer::StreamedTexture> TextureStreamer::_textures;
+    FROST_API uint64_t TextureStreamer::_frame = 0;
+    FROST_API uint32_t TextureStreamer::_pendingLoads = 0;
+    FROST_API size_t TextureStreamer::_streamedBytes = 0;
+
+    namespace
+    {
+        // Streamed textures have 8-bit channels
+        uint32_t GetBytesPerPixel(Format format)
+        {
+            switch (format)
+            {
+                case Format::R8_UNORM:
+                    return 1;
+                case Format::RG8_UNORM:
+                    return 2;
+                default:
+                    return 4;
+            }
+        }
+    } // namespace
+
+    void TextureStreamer::RequestMip(const std::shared_ptr<Texture>& texture, uint32_t mip)
+    {
+        // The loader thread decides whether the texture streams, read it once loaded
+        if (!texture || !texture->IsLoaded() || !texture->IsStreamable())
+        {
+            return;
+        }
+
+        StreamedTexture& streamed = _textures[texture.get()];
+        if (streamed.texture.expired())
+        {
+            // New, or a texture at the address of a destroyed one
+            streamed = StreamedTexture{ .texture = texture, .finerRequestFrame = _frame };
+        }
+
+        streamed.requestedMip = std::min(streamed.requestedMip, mip);
+    }
+
+    void TextureStreamer::Update()
+    {
+        ++_frame;
+
+        std::vector<TextureStreamingRequest> requests;
+        std::vector<std::shared_ptr<Texture>> textures;
+        requests.reserve(_textures.size());
+        textures.reserve(_textures.size());
+
+        for (auto it = _textures.begin(); it != _textures.end();)
+        {
+            std::shared_ptr<Texture> texture = it->second.texture.lock();
+            if (!texture)
+            {
+                it = _textures.erase(it);
+                continue;
+            }
+
+            // A texture no view requested only needs its resident mips
+            StreamedTexture& streamed = it->second;
+            uint32_t residentMip = texture->GetResidentMip();
+            uint32_t requestedMip = std::min(streamed.requestedMip, residentMip);
+            streamed.requestedMip = UINT32_MAX;
+
+            if (requestedMip <= streamed.wantedMip)
+            {
+                streamed.wantedMip = requestedMip;
+                streamed.finerRequestFrame = _frame;
+            }
+            else if (_frame - streamed.finerRequestFrame >= _settings.dropDelayFrames)
+            {
+                streamed.wantedMip = requestedMip;
+                streamed.finerRequestFrame = _frame;
+            }
+
+            requests.push_back({ .width = texture->GetWidth(),
+                                 .height = texture->GetHeight(),
+                                 .bytesPerPixel = GetBytesPerPixel(texture->GetFormat()),
+                                 .wantedMip = streamed.wantedMip,
+                                 .residentMip = residentMip });
+            textures.push_back(std::move(texture));
+            ++it;
+        }
+
+        std::vector<uint32_t> targetMips = TextureStreaming::FitBudget(requests, _settings.budgetBytes);
+
+        // Drops right away, they only copy on the GPU, loads the furthest from their target first
+        std::vector<size_t> loads;
+        for (size_t i = 0; i < textures.size(); ++i)
+        {
+            Texture& texture = *textures[i];
+            StreamedTexture& streamed = _textures[&texture];
+            if (streamed.loading)
+            {
+                continue;
+            }
+
+            if (targetMips[i] > texture.GetTopMip())
+            {
+                texture.DropToMip(targetMips[i]);
+            }
+            else if (targetMips[i] < texture.GetTopMip() && !streamed.failed)
+            {
+                loads.push_back(i);
+            }
+        }
+
+        std::sort(loads.begin(),
+                  loads.end(),
+                  [&](size_t a, size_t b)
+                  { return textures[a]->GetTopMip() - targetMips[a] > textures[b]->GetTopMip() - targetMips[b]; });
+
+        for (size_t i : loads)
+        {
+            if (_pendingLoads >= _settings.maxPendingLoads)
+            {
+                break;
+            }
+
+            std::shared_ptr<Texture> texture = textures[i];
+            uint32_t mip = targetMips[i];
+            auto pixels = std::make_shared<std::vector<uint8_t>>();
+
+            _textures[texture.get()].loading = true;
+            _textures[texture.get()].lastLoadFrame = _frame;
+            ++_pendingLoads;
+
+            AssetManager::QueueJob([texture, mip, pixels]() { *pixels = texture->LoadMipCPU(mip); },
+                                   [texture, mip, pixels]()
+                                   {
+                                       texture->UploadMipGPU(mip, *pixels);
+
+                                       auto it = _textures.find(texture.get());
+                                       if (it == _textures.end() || !it->second.loading)
+                                       {
+                                           return;
+                                       }
+
+                                       it->second.loading = false;
+                                       it->second.failed = texture->GetTopMip() > mip;
+                                       --_pendingLoads;
+                                   });
+        }
+
+        _streamedBytes = 0;
+        for (size_t i = 0; i < textures.size(); ++i)
+        {
+            const TextureStreamingRequest& request = requests[i];
+            _streamedBytes += TextureStreaming::GetChainSize(
+                request.width, request.height, request.bytesPerPixel, textures[i]->GetTopMip());
+        }
+
+        _TrimDecodedImages();
+    }
+
+    void TextureStreamer::_TrimDecodedImages()
+    {
+        std::vector<std::pair<uint64_t, std::shared_ptr<Texture>>> decoded;
+        size_t decodedBytes = 0;
+        for (auto& [key, streamed] : _textures)
+        {
+            std::shared_ptr<Texture> texture = streamed.texture.lock();
+            if (!texture || streamed.loading)
+            {
+                continue;
+            }
+
+            size_t size = texture->GetDecodedImageSize();
+            if (size == 0)
+            {
+                continue;
+            }
+
+            // Nothing finer than the full size mip is ever loaded
+            if (texture->GetTopMip() == 0)
+            {
+                texture->ReleaseDecodedImage();
+                continue;
+            }
+
+            decoded.emplace_back(streamed.lastLoadFrame, std::move(texture));
+            decodedBytes += size;
+        }
+
+        if (decodedBytes <= _settings.decodedImageBudgetBytes)
+        {
+            return;
+        }
+
+        std::sort(decoded.begin(), decoded.end(), [](const auto& a, const auto& b) { return a.first < b.first; });
+        for (auto& [lastLoadFrame, texture] : decoded)
+        {
+            if (decodedBytes <= _settings.decodedImageBudgetBytes)
+            {
+                break;
+            }
+
+            decodedBytes -= texture->GetDecodedImageSize();
+            texture->ReleaseDecodedImage();
+        }
+    }
+
+    void TextureStreamer::Shutdown()
+    {
+        _textures.clear();
+        _pendingLoads = 0;
+        _streamedBytes = 0;
+    }
+} // namespace Frost
@@ -0,0 +1,58 @@
+#pragma once
+
+#include "Frost/Core/Core.h"
+#include "Frost/Renderer/TextureStreaming.h"
+
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+
+namespace Frost
+{
+    class Texture;
+
+    // Keeps the mips of the streamed textures the views need on the GPU, within a budget. The renderer requests a mip
+    // for every streamed texture a visible mesh samples, finer mips are then read by the asset worker threads and
+    // uploaded within the upload budget, coarser ones are kept by copying the tail of the chain on the GPU.
+    class FROST_API TextureStreamer
+    {
+    public:
+        static void SetSettings(const TextureStreamingSettings& settings) { _settings = settings; }
+        static const TextureStreamingSettings& GetSettings() { return _settings; }
+
+        // The finest mip requested over a frame is kept
+        static void RequestMip(const std::shared_ptr<Texture>& texture, uint32_t mip);
+
+        // Fits the requests of the last frame in the budget and starts the loads and drops, once per frame
+        static void Update();
+        static void Shutdown();
+
+        // GPU bytes of the streamed textures as of the last update
+        static size_t GetStreamedBytes() { return _streamedBytes; }
+        static size_t GetTextureCount() { return _textures.size(); }
+        static uint32_t GetPendingLoadCount() { return _pendingLoads; }
+
+    private:
+        static void _TrimDecodedImages();
+
+        struct StreamedTexture
+        {
+            std::weak_ptr<Texture> texture;
+            // Finest mip requested since the last update
+            uint32_t requestedMip = UINT32_MAX;
+            // Mip the budget aims at, only made coarser after dropDelayFrames of coarser requests
+            uint32_t wantedMip = UINT32_MAX;
+            uint64_t finerRequestFrame = 0;
+            uint64_t lastLoadFrame = 0;
+            bool loading = false;
+            // Its file could not be read again, it keeps the mips it has
+            bool failed = false;
+        };
+
+        static TextureStreamingSettings _settings;
+        static std::unordered_map<const Texture*, StreamedTexture> _textures;
+        static uint64_t _frame;
+        static uint32_t _pendingLoads;
+        static size_t _streamedBytes;
+    };
+} // namespace Frost
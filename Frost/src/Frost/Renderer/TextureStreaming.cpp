@@ -0,0 +1,208 @@
+#include "Frost/Renderer/TextureStreaming.h"
+
+#include <algorithm>
+#include <cmath>
+#include <queue>
+
+namespace Frost
+{
+    namespace
+    {
+        uint32_t MipExtent(uint32_t extent, uint32_t mip)
+        {
+            return mip >= 32 ? 1 : std::max(extent >> mip, 1u);
+        }
+
+        size_t MipSize(uint32_t width, uint32_t height, uint32_t bytesPerPixel, uint32_t mip)
+        {
+            return size_t{ MipExtent(width, mip) } * MipExtent(height, mip) * bytesPerPixel;
+        }
+    } // namespace
+
+    uint32_t TextureStreaming::GetMipCount(uint32_t width, uint32_t height)
+    {
+        uint32_t extent = std::max(width, height);
+        uint32_t count = 1;
+        while (extent > 1)
+        {
+            extent >>= 1;
+            ++count;
+        }
+        return count;
+    }
+
+    size_t TextureStreaming::GetChainSize(uint32_t width, uint32_t height, uint32_t bytesPerPixel, uint32_t firstMip)
+    {
+        size_t size = 0;
+        for (uint32_t mip = firstMip; mip < GetMipCount(width, height); ++mip)
+        {
+            size += MipSize(width, height, bytesPerPixel, mip);
+        }
+        return size;
+    }
+
+    uint32_t TextureStreaming::GetMipForSize(uint32_t width, uint32_t height, uint32_t maxSize)
+    {
+        uint32_t mip = 0;
+        uint32_t lastMip = GetMipCount(width, height) - 1;
+        while (mip < lastMip && std::max(MipExtent(width, mip), MipExtent(height, mip)) > maxSize)
+        {
+            ++mip;
+        }
+        return mip;
+    }
+
+    float TextureStreaming::ComputeUVDensity(std::span<const Vertex> vertices, std::span<const uint32_t> indices)
+    {
+        double surfaceArea = 0.0;
+        double uvArea = 0.0;
+        for (size_t i = 0; i + 2 < indices.size(); i += 3)
+        {
+            const Vertex& a = vertices[indices[i]];
+            const Vertex& b = vertices[indices[i + 1]];
+            const Vertex& c = vertices[indices[i + 2]];
+
+            surfaceArea += Math::Length(Math::Cross(b.position - a.position, c.position - a.position));
+
+            float u1 = b.texCoord.x - a.texCoord.x;
+            float v1 = b.texCoord.y - a.texCoord.y;
+            float u2 = c.texCoord.x - a.texCoord.x;
+            float v2 = c.texCoord.y - a.texCoord.y;
+            uvArea += std::abs(u1 * v2 - u2 * v1);
+        }
+
+        if (surfaceArea <= 0.0 || uvArea <= 0.0)
+        {
+            return 0.0f;
+        }
+
+        // Areas grow with the square of the lengths
+        return static_cast<float>(std::sqrt(uvArea / surfaceArea));
+    }
+
+    uint32_t TextureStreaming::ComputeRequiredMip(
+        uint32_t width, uint32_t height, float uvDensity, float pixelsPerUnit, float mipBias)
+    {
+        uint32_t lastMip = GetMipCount(width, height) - 1;
+        if (uvDensity <= 0.0f || pixelsPerUnit <= 0.0f)
+        {
+            return lastMip;
+        }
+
+        float texelsPerPixel = static_cast<float>(std::max(width, height)) * uvDensity / pixelsPerUnit;
+        float level = std::log2(texelsPerPixel) + mipBias;
+        if (level <= 0.0f)
+        {
+            return 0;
+        }
+
+        return std::min(static_cast<uint32_t>(level), lastMip);
+    }
+
+    std::vector<uint32_t> TextureStreaming::FitBudget(std::span<const TextureStreamingRequest> requests,
+                                                      size_t budgetBytes)
+    {
+        std::vector<uint32_t> mips(requests.size());
+        size_t total = 0;
+        for (size_t i = 0; i < requests.size(); ++i)
+        {
+            const TextureStreamingRequest& request = requests[i];
+            mips[i] = std::min(request.wantedMip, request.residentMip);
+            total += GetChainSize(request.width, request.height, request.bytesPerPixel, mips[i]);
+        }
+
+        if (total <= budgetBytes)
+        {
+            return mips;
+        }
+
+        struct Drop
+        {
+            uint32_t levelsBelowWanted;
+            size_t saving;
+            size_t request;
+
+            bool operator<(const Drop& other) const
+            {
+                // The priority queue pops the largest, so the fewest levels then the largest saving
+                if (levelsBelowWanted != other.levelsBelowWanted)
+                {
+                    return levelsBelowWanted > other.levelsBelowWanted;
+                }
+                return saving < other.saving;
+            }
+        };
+
+        auto nextDrop = [&](size_t i)
+        {
+            const TextureStreamingRequest& request = requests[i];
+            return Drop{ mips[i] + 1 - std::min(request.wantedMip, request.residentMip),
+                         MipSize(request.width, request.height, request.bytesPerPixel, mips[i]),
+                         i };
+        };
+
+        std::priority_queue<Drop> drops;
+        for (size_t i = 0; i < requests.size(); ++i)
+        {
+            if (mips[i] < requests[i].residentMip)
+            {
+                drops.push(nextDrop(i));
+            }
+        }
+
+        while (total > budgetBytes && !drops.empty())
+        {
+            Drop drop = drops.top();
+            drops.pop();
+
+            total -= drop.saving;
+            ++mips[drop.request];
+            if (mips[drop.request] < requests[drop.request].residentMip)
+            {
+                drops.push(nextDrop(drop.request));
+            }
+        }
+
+        return mips;
+    }
+
+    std::vector<uint8_t> TextureStreaming::Downsample(
+        std::span<const uint8_t> pixels, uint32_t width, uint32_t height, uint32_t channels, uint32_t levels)
+    {
+        std::vector<uint8_t> source(pixels.begin(), pixels.end());
+        std::vector<uint8_t> destination;
+
+        for (uint32_t level = 0; level < levels && (width > 1 || height > 1); ++level)
+        {
+            uint32_t mipWidth = std::max(width / 2, 1u);
+            uint32_t mipHeight = std::max(height / 2, 1u);
+            destination.resize(size_t{ mipWidth } * mipHeight * channels);
+
+            // The mip extents round down like the GPU ones, an odd extent leaves its last row or column out
+            for (uint32_t y = 0; y < mipHeight; ++y)
+            {
+                uint32_t y0 = std::min(y * 2, height - 1);
+                uint32_t y1 = std::min(y * 2 + 1, height - 1);
+                for (uint32_t x = 0; x < mipWidth; ++x)
+                {
+                    uint32_t x0 = std::min(x * 2, width - 1);
+                    uint32_t x1 = std::min(x * 2 + 1, width - 1);
+                    for (uint32_t c = 0; c < channels; ++c)
+                    {
+                        uint32_t sum = source[(size_t{ y0 } * width + x0) * channels + c] +
+                                       source[(size_t{ y0 } * width + x1) * channels + c] +
+                                       source[(size_t{ y1 } * width + x0) * channels + c] +
+                                       source[(size_t{ y1 } * width + x1) * channels + c];
+                        destination[(size_t{ y } * mipWidth + x) * channels + c] = static_cast<uint8_t>((sum + 2) / 4);
+                    }
+                }
+            }
+
+            source.swap(destination);
+            width = mipWidth;
+            height = mipHeight;
+        }
+
+        return source;
+    }
+} // namespace Frost
@@ -0,0 +1,72 @@
+#pragma once
+
+#include "Frost/Core/Core.h"
+#include "Frost/Renderer/Vertex.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace Frost
+{
+    // Read by the loader threads too, so set before loading
+    struct TextureStreamingSettings
+    {
+        // GPU bytes of the streamed textures, their resident mips are kept even past it
+        size_t budgetBytes = size_t{ 512 } * 1024 * 1024;
+        // CPU bytes of the decoded images kept between the mip loads of a texture, so that a finer mip does not decode
+        // the file again. The least recently loaded are freed first.
+        size_t decodedImageBudgetBytes = size_t{ 256 } * 1024 * 1024;
+        // Largest side of the mip a streamed texture uploads when it loads, it never drops below it
+        uint32_t residentSize = 64;
+        // Levels added to every demand, a positive bias trades detail for memory
+        float mipBias = 0.0f;
+        // Mip loads running at once
+        uint32_t maxPendingLoads = 4;
+        // Frames a texture has to be wanted at a coarser mip before its finer mips are dropped, so that turning the
+        // camera around does not drop and reload them
+        uint32_t dropDelayFrames = 120;
+    };
+
+    // A texture as the budget sees it, mips are counted from the full size one
+    struct TextureStreamingRequest
+    {
+        uint32_t width = 0;
+        uint32_t height = 0;
+        uint32_t bytesPerPixel = 0;
+        // Finest mip the views need
+        uint32_t wantedMip = 0;
+        // Coarsest mip, uploaded at load and always kept
+        uint32_t residentMip = 0;
+    };
+
+    // The CPU side of mip streaming: how much detail a view needs, what fits in the budget, and the mips themselves
+    class FROST_API TextureStreaming
+    {
+    public:
+        static uint32_t GetMipCount(uint32_t width, uint32_t height);
+        // Bytes of the chain from firstMip down to 1x1
+        static size_t GetChainSize(uint32_t width, uint32_t height, uint32_t bytesPerPixel, uint32_t firstMip);
+        // Finest mip whose largest side fits in maxSize
+        static uint32_t GetMipForSize(uint32_t width, uint32_t height, uint32_t maxSize);
+
+        // Texture coordinate units per model space unit, from the UV and surface areas of the triangles. Zero for a
+        // mesh without texture coordinates.
+        static float ComputeUVDensity(std::span<const Vertex> vertices, std::span<const uint32_t> indices);
+
+        // Mip at which a texel covers about a pixel on a mesh of that UV density, seen at pixelsPerUnit pixels per
+        // model space unit
+        static uint32_t ComputeRequiredMip(
+            uint32_t width, uint32_t height, float uvDensity, float pixelsPerUnit, float mipBias);
+
+        // Mip of each request once the chains fit in budgetBytes. While over, the texture that would end up the
+        // fewest levels below its wanted mip gives one up, the largest saving first on a tie, so that every texture
+        // loses detail evenly. A request never gets finer than its wanted mip nor coarser than its resident one.
+        static std::vector<uint32_t> FitBudget(std::span<const TextureStreamingRequest> requests, size_t budgetBytes);
+
+        // Box filters an image of 8-bit channels down by levels mips
+        static std::vector<uint8_t> Downsample(
+            std::span<const uint8_t> pixels, uint32_t width, uint32_t height, uint32_t channels, uint32_t levels);
+    };
+} // namespace Frost
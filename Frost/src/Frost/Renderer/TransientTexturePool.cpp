@@ -0,0 +1,64 @@
+#include "Frost/Renderer/TransientTexturePool.h"
+#include "Frost/Asset/Texture.h"
+#include "Frost/Debugging/Assert.h"
+
+#include <algorithm>
+
+namespace Frost
+{
+    TransientTexturePool::TransientTexturePool() :
+        TransientTexturePool(
+            [](const RenderGraph::TextureDesc& desc)
+            {
+                TextureConfig config = { .debugName = "RenderGraphTexture",
+                                         .format = desc.format,
+                                         .width = desc.width,
+                                         .height = desc.height,
+                                         .isRenderTarget = true,
+                                         .isShaderResource = true,
+                                         .hasMipmaps = false };
+                return Texture::Create(config);
+            })
+    {
+    }
+
+    TransientTexturePool::TransientTexturePool(Factory factory) : _factory(std::move(factory)) {}
+
+    Texture* TransientTexturePool::Acquire(const RenderGraph::TextureDesc& desc)
+    {
+        auto it = std::ranges::find_if(_entries,
+                                       [&](const Entry& entry) { return !entry.isInUse && entry.desc == desc; });
+        if (it == _entries.end())
+        {
+            _entries.push_back({ .desc = desc, .texture = _factory(desc) });
+            it = _entries.end() - 1;
+        }
+
+        it->isInUse = true;
+        it->lastUsedFrame = _frameIndex;
+        return it->texture.get();
+    }
+
+    void TransientTexturePool::Release(Texture* texture)
+    {
+        auto it = std::ranges::find_if(_entries, [&](const Entry& entry) { return entry.texture.get() == texture; });
+        FT_ENGINE_ASSERT(it != _entries.end(), "TransientTexturePool: releasing a texture the pool does not own");
+        if (it != _entries.end())
+        {
+            it->isInUse = false;
+        }
+    }
+
+    void TransientTexturePool::EndFrame()
+    {
+        std::erase_if(_entries,
+                      [&](const Entry& entry)
+                      { return !entry.isInUse && _frameIndex - entry.lastUsedFrame >= MAX_UNUSED_FRAMES; });
+        ++_frameIndex;
+    }
+
+    void TransientTexturePool::Clear()
+    {
+        _entries.clear();
+    }
+} // namespace Frost
@@ -0,0 +1,51 @@
+#pragma once
+
+#include "Frost/Core/Core.h"
+#include "Frost/Renderer/RenderGraph.h"
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <vector>
+
+namespace Frost
+{
+    class Texture;
+
+    // Keeps the transient textures of the render graphs alive across frames. A texture is handed out again to any
+    // request with the same description and destroyed once it has not been used for a while.
+    class FROST_API TransientTexturePool
+    {
+    public:
+        using Factory = std::function<std::shared_ptr<Texture>(const RenderGraph::TextureDesc&)>;
+
+        // Creates render targets through Texture::Create
+        TransientTexturePool();
+        // A custom factory lets the graph run without a GPU
+        explicit TransientTexturePool(Factory factory);
+
+        Texture* Acquire(const RenderGraph::TextureDesc& desc);
+        void Release(Texture* texture);
+
+        // Destroys the textures that were not acquired during the last MAX_UNUSED_FRAMES frames
+        void EndFrame();
+        void Clear();
+
+        size_t GetTextureCount() const { return _entries.size(); }
+
+    private:
+        struct Entry
+        {
+            RenderGraph::TextureDesc desc;
+            std::shared_ptr<Texture> texture;
+            uint64_t lastUsedFrame = 0;
+            bool isInUse = false;
+        };
+
+        static constexpr uint64_t MAX_UNUSED_FRAMES = 60;
+
+        Factory _factory;
+        std::vector<Entry> _entries;
+        uint64_t _frameIndex = 0;
+    };
+} // namespace Frost
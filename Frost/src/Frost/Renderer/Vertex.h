@@ -2,8 +2,18 @@
 
 #include "Frost/Utils/Math/Vector.h"
 
+#include <cstdint>
+
 namespace Frost
 {
+    enum class VertexLayout : uint8_t
+    {
+        // Vertex
+        Standard,
+        // CompactVertex
+        Compact
+    };
+
     struct Vertex
     {
         Math::Vector3 position;
@@ -11,4 +21,19 @@ namespace Frost
         Math::Vector2 texCoord;
         Math::Vector4 tangent;
     };
+
+    // Half the size of Vertex. The input assembler expands the normal, tangent and texture coordinates back to floats,
+    // so the vertex shaders read both layouts the same way.
+    struct CompactVertex
+    {
+        Math::Vector3 position;
+        // RGBA8_SNORM, w unused
+        uint32_t normal;
+        // RGBA8_SNORM, w is the bitangent sign
+        uint32_t tangent;
+        // RG16_FLOAT
+        uint16_t texCoord[2];
+    };
+
+    static_assert(sizeof(Vertex) == 48 && sizeof(CompactVertex) == 24, "Vertex layouts must stay tightly packed");
 } // namespace Frost
\ No newline at end of file
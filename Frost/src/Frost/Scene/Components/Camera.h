@@ -3,6 +3,7 @@
 #include "Frost/Renderer/PostEffect.h"
 #include "Frost/Renderer/Viewport.h"
 #include "Frost/Scene/ECS/Component.h"
+#include "Frost/Scene/ECS/ComponentFields.h"
 #include "Frost/Utils/Math/Angle.h"
 #include "Frost/Utils/Math/Vector.h"
 
@@ -24,6 +25,11 @@ namespace Frost::Component
 
         // Useful for effects like mirror or portal
         bool useScreenSpaceAspectRatio = false;
+
+        // Renders at most every updateInterval frames, and only while a surface showing the target is visible
+        uint32_t updateInterval = 1;
+        // Scales width and height, the texture keeps its size on screen
+        float resolutionScale = 1.0f;
     };
 
     struct Camera
@@ -73,4 +79,42 @@ namespace Frost::Component
             return nullptr;
         }
     };
-} // namespace Frost::Component
\ No newline at end of file
+} // namespace Frost::Component
+
+namespace Frost::Reflection
+{
+    template<>
+    struct Fields<Component::RenderTargetConfig>
+    {
+        using RenderTargetConfig = Component::RenderTargetConfig;
+
+        static constexpr auto value =
+            std::make_tuple(Field{ "Width", &RenderTargetConfig::width },
+                            Field{ "Height", &RenderTargetConfig::height },
+                            Field{ "UseScreenSpaceAspectRatio", &RenderTargetConfig::useScreenSpaceAspectRatio },
+                            Field{ "UpdateInterval", &RenderTargetConfig::updateInterval },
+                            Field{ "ResolutionScale", &RenderTargetConfig::resolutionScale });
+    };
+
+    // Post effects are set up by code and are not serialized
+    template<>
+    struct Fields<Component::Camera>
+    {
+        using Camera = Component::Camera;
+
+        static constexpr auto value = std::make_tuple(Field{ "ProjectionType", &Camera::projectionType },
+                                                      Field{ "PerspectiveFOV", &Camera::perspectiveFOV },
+                                                      Field{ "OrthographicSize", &Camera::orthographicSize },
+                                                      Field{ "NearClip", &Camera::nearClip },
+                                                      Field{ "FarClip", &Camera::farClip },
+                                                      Field{ "Priority", &Camera::priority },
+                                                      Field{ "FrustumCulling", &Camera::frustumCulling },
+                                                      Field{ "FrustumPadding", &Camera::frustumPadding },
+                                                      Field{ "ClearOnRender", &Camera::clearOnRender },
+                                                      Field{ "BackgroundColor", &Camera::backgroundColor },
+                                                      Field{ "Viewport", &Camera::viewport },
+                                                      Field{ "RenderTarget", &Camera::renderTargetConfig },
+                                                      Field{ "LookAtPositionEnabled", &Camera::lookAtPositionEnabled },
+                                                      Field{ "LookAtPosition", &Camera::lookAtPosition });
+    };
+} // namespace Frost::Reflection
\ No newline at end of file
@@ -0,0 +1,15 @@
+#include "Frost/Scene/Components/EntityID.h"
+
+#include <random>
+
+namespace Frost::Component
+{
+    uint64_t EntityID::Generate()
+    {
+        // Separate from Frost::Random so that creating game objects does not disturb seeded gameplay sequences
+        thread_local std::mt19937_64 engine{ (static_cast<uint64_t>(std::random_device{}()) << 32) |
+                                             std::random_device{}() };
+        std::uniform_int_distribution<uint64_t> distribution(1, (uint64_t{ 1 } << 63) - 1);
+        return distribution(engine);
+    }
+} // namespace Frost::Component
@@ -0,0 +1,21 @@
+#pragma once
+
+#include "Frost/Core/Core.h"
+#include "Frost/Scene/ECS/Component.h"
+
+#include <cstdint>
+
+namespace Frost::Component
+{
+    // Persistent identity of a game object, stable across saves and loads unlike the entt handle
+    struct FROST_API EntityID : public Component
+    {
+        uint64_t guid;
+
+        EntityID() : guid(Generate()) {}
+        explicit EntityID(uint64_t guid) : guid(guid) {}
+
+        // Never 0 and below 2^63, so files can use 0 and negative values as "no entity"
+        static uint64_t Generate();
+    };
+} // namespace Frost::Component
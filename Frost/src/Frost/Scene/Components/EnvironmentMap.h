@@ -6,6 +6,7 @@
 #include <filesystem>
 
 #include "Frost/Scene/ECS/Component.h"
+#include "Frost/Scene/ECS/ComponentFields.h"
 
 namespace Frost::Component
 {
@@ -39,4 +40,30 @@ namespace Frost::Component
 
         EnvironmentMapType GetType() const { return static_cast<EnvironmentMapType>(config.index()); }
     };
-} // namespace Frost::Component
\ No newline at end of file
+} // namespace Frost::Component
+
+namespace Frost::Reflection
+{
+    template<>
+    struct Fields<Component::EnvironmentMapSourceCubemap>
+    {
+        static constexpr const char* name = "Cubemap";
+        static constexpr auto value =
+            std::make_tuple(Field{ "Path", &Component::EnvironmentMapSourceCubemap::filepath });
+    };
+
+    template<>
+    struct Fields<Component::EnvironmentMapSource6Files>
+    {
+        static constexpr const char* name = "6 Files";
+        static constexpr auto value =
+            std::make_tuple(Field{ "Faces", &Component::EnvironmentMapSource6Files::faceFilepaths });
+    };
+
+    template<>
+    struct Fields<Component::EnvironmentMap>
+    {
+        static constexpr auto value = std::make_tuple(Field{ "", &Component::EnvironmentMap::config },
+                                                      Field{ "Intensity", &Component::EnvironmentMap::intensity });
+    };
+} // namespace Frost::Reflection
\ No newline at end of file
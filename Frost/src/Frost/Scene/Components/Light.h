@@ -1,5 +1,6 @@
 ﻿#pragma once
 
+#include "Frost/Scene/ECS/ComponentFields.h"
 #include "Frost/Utils/Math/Angle.h"
 #include "Frost/Utils/Math/Vector.h"
 
@@ -80,4 +81,49 @@ namespace Frost::Component
             }
         }
     };
-} // namespace Frost::Component
\ No newline at end of file
+} // namespace Frost::Component
+
+namespace Frost::Reflection
+{
+    template<>
+    struct Fields<Component::LightDirectional>
+    {
+        static constexpr const char* name = "Directional";
+        static constexpr auto value =
+            std::make_tuple(Field{ "CascadeNear", &Component::LightDirectional::cascadeNear },
+                            Field{ "CascadeFar", &Component::LightDirectional::cascadeFar },
+                            Field{ "Range", &Component::LightDirectional::range });
+    };
+
+    template<>
+    struct Fields<Component::LightPoint>
+    {
+        static constexpr const char* name = "Point";
+        static constexpr auto value = std::make_tuple(Field{ "Radius", &Component::LightPoint::radius },
+                                                      Field{ "Falloff", &Component::LightPoint::falloff });
+    };
+
+    template<>
+    struct Fields<Component::LightSpot>
+    {
+        static constexpr const char* name = "Spot";
+        static constexpr auto value = std::make_tuple(Field{ "Range", &Component::LightSpot::range },
+                                                      Field{ "InnerAngle", &Component::LightSpot::innerConeAngle },
+                                                      Field{ "OuterAngle", &Component::LightSpot::outerConeAngle });
+    };
+
+    template<>
+    struct Fields<Component::LightAmbient>
+    {
+        static constexpr const char* name = "Ambient";
+        static constexpr auto value = std::make_tuple();
+    };
+
+    template<>
+    struct Fields<Component::Light>
+    {
+        static constexpr auto value = std::make_tuple(Field{ "Color", &Component::Light::color },
+                                                      Field{ "Intensity", &Component::Light::intensity },
+                                                      Field{ "", &Component::Light::config });
+    };
+} // namespace Frost::Reflection
\ No newline at end of file
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "Frost/Scene/ECS/Component.h"
+#include "Frost/Scene/ECS/ComponentFields.h"
 #include "Frost/Scene/ECS/GameObject.h"
 
 #include <string>
@@ -14,3 +15,12 @@ namespace Frost::Component
         Meta(std::string name = "GameObject") : name(std::move(name)) {}
     };
 } // namespace Frost::Component
+
+namespace Frost::Reflection
+{
+    template<>
+    struct Fields<Component::Meta>
+    {
+        static constexpr auto value = std::make_tuple(Field{ "Name", &Component::Meta::name });
+    };
+} // namespace Frost::Reflection
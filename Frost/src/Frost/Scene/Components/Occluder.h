@@ -0,0 +1,23 @@
+#pragma once
+
+#include "Frost/Scene/ECS/Component.h"
+#include "Frost/Scene/ECS/ComponentFields.h"
+
+namespace Frost::Component
+{
+    // Makes the static mesh of this entity an occluder of the main cameras whatever its size on screen, see
+    // OcclusionCuller. Large meshes are picked without it, disabling it keeps a see-through mesh from ever occluding
+    struct Occluder : public Component
+    {
+        bool enabled = true;
+    };
+} // namespace Frost::Component
+
+namespace Frost::Reflection
+{
+    template<>
+    struct Fields<Component::Occluder>
+    {
+        static constexpr auto value = std::make_tuple(Field{ "Enabled", &Component::Occluder::enabled });
+    };
+} // namespace Frost::Reflection
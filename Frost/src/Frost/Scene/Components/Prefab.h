@@ -1,5 +1,7 @@
 #pragma once
 
+#include "Frost/Scene/ECS/ComponentFields.h"
+
 #include <filesystem>
 
 namespace Frost::Component
@@ -11,4 +13,13 @@ namespace Frost::Component
         Prefab() : assetPath{} {}
         Prefab(const std::filesystem::path& path) : assetPath{ path } {}
     };
-} // namespace Frost::Component
\ No newline at end of file
+} // namespace Frost::Component
+
+namespace Frost::Reflection
+{
+    template<>
+    struct Fields<Component::Prefab>
+    {
+        static constexpr auto value = std::make_tuple(Field{ "AssetPath", &Component::Prefab::assetPath });
+    };
+} // namespace Frost::Reflection
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "Frost/Scene/ECS/Component.h"
+#include "Frost/Scene/ECS/ComponentFields.h"
 #include "Frost/Utils/Math/Vector.h"
 
 #include <Jolt/Jolt.h>
@@ -105,4 +106,74 @@ namespace Frost::Component
         {
         }
     };
-} // namespace Frost::Component
\ No newline at end of file
+} // namespace Frost::Component
+
+namespace Frost::Reflection
+{
+    template<>
+    struct Fields<Component::ShapeBox>
+    {
+        static constexpr const char* name = "Box";
+        static constexpr auto value = std::make_tuple(Field{ "HalfExtent", &Component::ShapeBox::halfExtent },
+                                                      Field{ "ConvexRadius", &Component::ShapeBox::convexRadius });
+    };
+
+    template<>
+    struct Fields<Component::ShapeSphere>
+    {
+        static constexpr const char* name = "Sphere";
+        static constexpr auto value = std::make_tuple(Field{ "Radius", &Component::ShapeSphere::radius });
+    };
+
+    template<>
+    struct Fields<Component::ShapeCapsule>
+    {
+        static constexpr const char* name = "Capsule";
+        static constexpr auto value = std::make_tuple(Field{ "HalfHeight", &Component::ShapeCapsule::halfHeight },
+                                                      Field{ "Radius", &Component::ShapeCapsule::radius });
+    };
+
+    template<>
+    struct Fields<Component::ShapeCylinder>
+    {
+        static constexpr const char* name = "Cylinder";
+        static constexpr auto value =
+            std::make_tuple(Field{ "HalfHeight", &Component::ShapeCylinder::halfHeight },
+                            Field{ "Radius", &Component::ShapeCylinder::radius },
+                            Field{ "ConvexRadius", &Component::ShapeCylinder::convexRadius });
+    };
+
+    template<>
+    struct Fields<Component::ShapeMesh>
+    {
+        static constexpr const char* name = "Mesh";
+        static constexpr auto value = std::make_tuple(Field{ "Path", &Component::ShapeMesh::path });
+    };
+
+    // The runtime body is left out, the physics system creates it
+    template<>
+    struct Fields<Component::RigidBody>
+    {
+        using RigidBody = Component::RigidBody;
+
+        static constexpr auto value =
+            std::make_tuple(Field{ "MotionType", &RigidBody::motionType },
+                            Field{ "IsSensor", &RigidBody::isSensor },
+                            Field{ "AllowSleeping", &RigidBody::allowSleeping },
+                            Field{ "Friction", &RigidBody::friction },
+                            Field{ "Restitution", &RigidBody::restitution },
+                            Field{ "OverrideMassProperties", &RigidBody::overrideMassProperties },
+                            Field{ "Mass", &RigidBody::mass },
+                            Field{ "LinearDamping", &RigidBody::linearDamping },
+                            Field{ "AngularDamping", &RigidBody::angularDamping },
+                            Field{ "GravityFactor", &RigidBody::gravityFactor },
+                            Field{ "Shape", &RigidBody::shape },
+                            Field{ "LockPositionX", &RigidBody::lockPositionX },
+                            Field{ "LockPositionY", &RigidBody::lockPositionY },
+                            Field{ "LockPositionZ", &RigidBody::lockPositionZ },
+                            Field{ "LockRotationX", &RigidBody::lockRotationX },
+                            Field{ "LockRotationY", &RigidBody::lockRotationY },
+                            Field{ "LockRotationZ", &RigidBody::lockRotationZ },
+                            Field{ "ObjectLayer", &RigidBody::objectLayer });
+    };
+} // namespace Frost::Reflection
\ No newline at end of file
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "Frost/Scene/ECS/Component.h"
+#include "Frost/Scene/ECS/ComponentFields.h"
 
 #include <memory>
 #include <vector>
@@ -25,4 +26,14 @@ namespace Frost::Component
         Scriptable& operator=(Scriptable&&);
         ~Scriptable();
     };
-} // namespace Frost::Component
\ No newline at end of file
+} // namespace Frost::Component
+
+namespace Frost::Reflection
+{
+    // Script instances are created from their names by the scriptable system
+    template<>
+    struct Fields<Component::Scriptable>
+    {
+        static constexpr auto value = std::make_tuple(Field{ "Scripts", &Component::Scriptable::scriptNames });
+    };
+} // namespace Frost::Reflection
\ No newline at end of file
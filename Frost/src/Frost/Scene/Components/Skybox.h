@@ -6,6 +6,7 @@
 #include <filesystem>
 
 #include "Frost/Scene/ECS/Component.h"
+#include "Frost/Scene/ECS/ComponentFields.h"
 
 namespace Frost::Component
 {
@@ -56,4 +57,29 @@ namespace Frost::Component
             }
         }
     };
-} // namespace Frost::Component
\ No newline at end of file
+} // namespace Frost::Component
+
+namespace Frost::Reflection
+{
+    template<>
+    struct Fields<Component::SkyboxSourceCubemap>
+    {
+        static constexpr const char* name = "Cubemap";
+        static constexpr auto value = std::make_tuple(Field{ "Path", &Component::SkyboxSourceCubemap::filepath });
+    };
+
+    template<>
+    struct Fields<Component::SkyboxSource6Files>
+    {
+        static constexpr const char* name = "6 Files";
+        static constexpr auto value =
+            std::make_tuple(Field{ "Faces", &Component::SkyboxSource6Files::faceFilepaths });
+    };
+
+    template<>
+    struct Fields<Component::Skybox>
+    {
+        static constexpr auto value = std::make_tuple(Field{ "", &Component::Skybox::config },
+                                                      Field{ "Intensity", &Component::Skybox::intensity });
+    };
+} // namespace Frost::Reflection
\ No newline at end of file
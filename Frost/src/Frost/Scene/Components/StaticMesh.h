@@ -3,7 +3,9 @@
 #include "Frost/Asset/Model.h"
 #include "Frost/Core/Core.h"
 #include "Frost/Scene/ECS/Component.h"
+#include "Frost/Scene/ECS/ComponentFields.h"
 #include "Frost/Asset/MeshConfig.h"
+#include "Frost/Renderer/MaterialPropertyBlock.h"
 
 #include <memory>
 #include <string>
@@ -39,20 +41,46 @@ namespace Frost::Component
         const std::shared_ptr<Model>& GetModel() const { return _model; }
         void SetModel(const std::shared_ptr<Model>& newModel) { _model = newModel; }
 
+        // Parameters of this instance only, the model and its materials may be shared
+        MaterialPropertyBlock& GetPropertyBlock() { return _propertyBlock; }
+        const MaterialPropertyBlock& GetPropertyBlock() const { return _propertyBlock; }
+
         MeshConfig& GetMeshConfig() { return _config; }
         const MeshConfig& GetMeshConfig() const { return _config; }
         void SetMeshConfig(const MeshConfig& newConfig);
 
         MeshType GetType() const { return static_cast<MeshType>(_config.index()); }
 
+        // Level of detail picked for the last main camera, the renderer keeps it while the instance stays near a
+        // threshold. Not serialized.
+        uint32_t GetLod() const { return _lod; }
+        void SetLod(uint32_t lod) { _lod = lod; }
+
         void Reload();
 
     private:
+        template<typename>
+        friend struct Reflection::Fields;
+
         void _Generate();
 
     private:
         MeshConfig _config;
         std::shared_ptr<Model> _model;
+        MaterialPropertyBlock _propertyBlock;
+        uint32_t _lod = 0;
     };
 
 } // namespace Frost::Component
+
+namespace Frost::Reflection
+{
+    // The model is rebuilt whenever the config is assigned
+    template<>
+    struct Fields<Component::StaticMesh>
+    {
+        static constexpr auto value = std::make_tuple(Field{ "", &Component::StaticMesh::_config });
+
+        static void OnAssigned(Component::StaticMesh& mesh) { mesh.Reload(); }
+    };
+} // namespace Frost::Reflection
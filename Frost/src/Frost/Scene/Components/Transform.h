@@ -2,6 +2,7 @@
 
 #include "Frost/Core/Core.h"
 #include "Frost/Scene/ECS/Component.h"
+#include "Frost/Scene/ECS/ComponentFields.h"
 #include "Frost/Utils/Math/Angle.h"
 #include "Frost/Utils/Math/Vector.h"
 
@@ -123,3 +124,14 @@ namespace Frost::Component
         }
     };
 } // namespace Frost::Component
+
+namespace Frost::Reflection
+{
+    template<>
+    struct Fields<Component::Transform>
+    {
+        static constexpr auto value = std::make_tuple(Field{ "Position", &Component::Transform::position },
+                                                      Field{ "Rotation", &Component::Transform::rotation },
+                                                      Field{ "Scale", &Component::Transform::scale });
+    };
+} // namespace Frost::Reflection
@@ -6,6 +6,7 @@
 
 #include "Frost/Renderer/Material.h"
 #include "Frost/Renderer/Viewport.h"
+#include "Frost/Scene/ECS/ComponentFields.h"
 #include "Frost/Utils/Math/Vector.h"
 
 #include <functional>
@@ -72,4 +73,81 @@ namespace Frost::Component
         UIVariant content;
     };
 
-} // namespace Frost::Component
\ No newline at end of file
+} // namespace Frost::Component
+
+namespace Frost::Reflection
+{
+    // The textures and fonts are loaded again from their paths whenever these are assigned
+    template<>
+    struct Fields<Component::UIImage>
+    {
+        static constexpr const char* name = "Image";
+        static constexpr auto value = std::make_tuple(Field{ "TexturePath", &Component::UIImage::textureFilepath },
+                                                      Field{ "Filter", &Component::UIImage::filter });
+
+        static void OnAssigned(Component::UIImage& image)
+        {
+            if (!image.textureFilepath.empty())
+            {
+                image.SetTexturePath(image.textureFilepath);
+            }
+        }
+    };
+
+    template<>
+    struct Fields<Component::UIText>
+    {
+        static constexpr const char* name = "Text";
+        static constexpr auto value = std::make_tuple(Field{ "Text", &Component::UIText::text },
+                                                      Field{ "FontPath", &Component::UIText::fontFilepath },
+                                                      Field{ "FontSize", &Component::UIText::fontSize });
+
+        static void OnAssigned(Component::UIText& text)
+        {
+            text.font = AssetManager::LoadAsset<Font>(text.fontFilepath);
+        }
+    };
+
+    template<>
+    struct Fields<Component::UIButton>
+    {
+        using UIButton = Component::UIButton;
+
+        static constexpr const char* name = "Button";
+        static constexpr auto value = std::make_tuple(Field{ "IdleTexturePath", &UIButton::idleTextureFilepath },
+                                                      Field{ "HoverTexturePath", &UIButton::hoverTextureFilepath },
+                                                      Field{ "PressedTexturePath", &UIButton::pressedTextureFilepath });
+
+        static void OnAssigned(UIButton& button)
+        {
+            button.idleTexture = _LoadTexture(button.idleTextureFilepath);
+            button.hoverTexture = _LoadTexture(button.hoverTextureFilepath);
+            button.pressedTexture = _LoadTexture(button.pressedTextureFilepath);
+        }
+
+    private:
+        static std::shared_ptr<Texture> _LoadTexture(const std::string& path)
+        {
+            if (path.empty())
+            {
+                return nullptr;
+            }
+
+            TextureConfig config = { .textureType = TextureType::HUD, .path = path };
+            return AssetManager::LoadAsset(path, config);
+        }
+    };
+
+    template<>
+    struct Fields<Component::UIElement>
+    {
+        using UIElement = Component::UIElement;
+
+        static constexpr auto value = std::make_tuple(Field{ "Viewport", &UIElement::viewport },
+                                                      Field{ "Priority", &UIElement::priority },
+                                                      Field{ "Rotation", &UIElement::rotation },
+                                                      Field{ "Color", &UIElement::color },
+                                                      Field{ "IsEnabled", &UIElement::isEnabled },
+                                                      Field{ "Content", &UIElement::content });
+    };
+} // namespace Frost::Reflection
\ No newline at end of file
@@ -0,0 +1,27 @@
+#pragma once
+
+#include "Frost/Scene/ECS/Component.h"
+#include "Frost/Scene/ECS/ComponentFields.h"
+
+#include <cstdint>
+
+namespace Frost::Component
+{
+    // Places the hierarchy below this root in a given streaming cell instead of the one holding the centre of its
+    // bounds, see SceneStreamer::BuildCells. Ignored on entities that have a parent
+    struct WorldCell : public Component
+    {
+        int32_t x = 0;
+        int32_t z = 0;
+    };
+} // namespace Frost::Component
+
+namespace Frost::Reflection
+{
+    template<>
+    struct Fields<Component::WorldCell>
+    {
+        static constexpr auto value =
+            std::make_tuple(Field{ "X", &Component::WorldCell::x }, Field{ "Z", &Component::WorldCell::z });
+    };
+} // namespace Frost::Reflection
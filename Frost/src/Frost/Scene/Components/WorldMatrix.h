@@ -0,0 +1,23 @@
+#pragma once
+
+#include "Frost/Scene/ECS/Component.h"
+#include "Frost/Utils/Math/Matrix.h"
+#include "Frost/Utils/Math/Vector.h"
+
+namespace Frost::Component
+{
+    // Cached WorldTransform matrix, rebuilt by the WorldTransformSystem only when the world transform changes
+    struct WorldMatrix : public Component
+    {
+        Math::Matrix4x4 matrix = Math::Matrix4x4::CreateIdentity();
+
+        // World transform the matrix was built from
+        Math::Vector3 position;
+        Math::Vector4 rotation;
+        Math::Vector3 scale;
+        bool isDirty = true;
+
+        // Incremented every time the matrix is rebuilt, lets caches tell whether the entity moved since they last saw it
+        uint32_t version = 0;
+    };
+} // namespace Frost::Component
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "Frost/Scene/Components/Transform.h"
+#include "Frost/Scene/ECS/ComponentFields.h"
 
 namespace Frost::Component
 {
@@ -15,4 +16,12 @@ namespace Frost::Component
 
         WorldTransform(const Math::Vector3& pos) noexcept : Transform(pos) {}
     };
-} // namespace Frost::Component
\ No newline at end of file
+} // namespace Frost::Component
+
+namespace Frost::Reflection
+{
+    template<>
+    struct Fields<Component::WorldTransform> : Fields<Component::Transform>
+    {
+    };
+} // namespace Frost::Reflection
@@ -0,0 +1,202 @@
+#pragma once
+
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <optional>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <variant>
+
+namespace Frost::Reflection
+{
+    template<typename Class, typename T>
+    struct Field
+    {
+        using ValueType = T;
+
+        const char* name;
+        T Class::*member;
+    };
+
+    // Specialized next to each reflected component: static constexpr auto value = std::make_tuple(Field{ ... }, ...)
+    // Fields must be listed in declaration order, block copies rely on it. A specialization may also declare
+    // static void OnAssigned(T&), called once the fields were read or copied, for components holding resources
+    // built from them, and static constexpr const char* name, shown when the type is an alternative of a variant.
+    template<typename T>
+    struct Fields;
+
+    template<typename T>
+    concept Reflected = requires { Fields<T>::value; };
+
+    template<typename T>
+    concept HasAssignedHook = Reflected<T> && requires(T& component) { Fields<T>::OnAssigned(component); };
+
+    template<Reflected T>
+    constexpr std::size_t FieldCount = std::tuple_size_v<std::remove_cvref_t<decltype(Fields<T>::value)>>;
+
+    template<Reflected T, typename Fn>
+    constexpr void ForEachField(Fn&& fn)
+    {
+        std::apply([&](const auto&... field) { (fn(field), ...); }, Fields<T>::value);
+    }
+
+    template<Reflected T>
+    constexpr const char* TypeName()
+    {
+        if constexpr (requires { Fields<T>::name; })
+        {
+            return Fields<T>::name;
+        }
+        else
+        {
+            return "";
+        }
+    }
+
+    template<Reflected T>
+    void NotifyAssigned(T& component)
+    {
+        if constexpr (HasAssignedHook<T>)
+        {
+            Fields<T>::OnAssigned(component);
+        }
+    }
+
+    // Switches a variant to the alternative stored at a runtime index, out of range indices are ignored
+    template<typename... Ts>
+    void EmplaceAlternative(std::variant<Ts...>& value, std::size_t index)
+    {
+        if (index == value.index())
+            return;
+
+        [&]<std::size_t... I>(std::index_sequence<I...>)
+        { ((index == I ? (void)value.template emplace<I>() : (void)0), ...); }(std::index_sequence_for<Ts...>{});
+    }
+
+    // True when the fields, laid out one after the other at their natural alignment, cover the whole object with no
+    // padding before, between or after them, so it can be read and written as one block
+    template<Reflected T>
+    consteval bool IsBlockCopyable()
+    {
+        if constexpr (!std::is_trivially_copyable_v<T> || !std::is_standard_layout_v<T>)
+        {
+            return false;
+        }
+        else
+        {
+            std::size_t offset = 0;
+            bool packed = true;
+            ForEachField<T>(
+                [&](const auto& field)
+                {
+                    using ValueType = typename std::remove_cvref_t<decltype(field)>::ValueType;
+                    packed = packed && offset % alignof(ValueType) == 0;
+                    offset += sizeof(ValueType);
+                });
+            return packed && offset == sizeof(T);
+        }
+    }
+
+    template<typename T>
+    bool FieldEquals(const T& a, const T& b);
+    template<Reflected T>
+    bool FieldEquals(const T& a, const T& b);
+    template<typename... Ts>
+    bool FieldEquals(const std::variant<Ts...>& a, const std::variant<Ts...>& b);
+    template<typename T>
+    bool FieldEquals(const std::optional<T>& a, const std::optional<T>& b);
+
+    template<Reflected T>
+    bool Equals(const T& a, const T& b);
+
+    // Math vectors have no operator==, they are compared bitwise. Containers compare their elements one by one.
+    template<typename T>
+    bool FieldEquals(const T& a, const T& b)
+    {
+        if constexpr (requires { a.size(); a.begin(); })
+        {
+            if (a.size() != b.size())
+                return false;
+
+            auto itB = b.begin();
+            for (auto itA = a.begin(); itA != a.end(); ++itA, ++itB)
+            {
+                if (!FieldEquals(*itA, *itB))
+                    return false;
+            }
+            return true;
+        }
+        else if constexpr (std::equality_comparable<T>)
+        {
+            return a == b;
+        }
+        else
+        {
+            static_assert(std::is_trivially_copyable_v<T>, "Field type needs an operator==");
+            return std::memcmp(&a, &b, sizeof(T)) == 0;
+        }
+    }
+
+    template<Reflected T>
+    bool FieldEquals(const T& a, const T& b)
+    {
+        return Equals(a, b);
+    }
+
+    template<typename... Ts>
+    bool FieldEquals(const std::variant<Ts...>& a, const std::variant<Ts...>& b)
+    {
+        if (a.index() != b.index())
+            return false;
+
+        return std::visit(
+            [&](const auto& alternative)
+            { return FieldEquals(alternative, std::get<std::remove_cvref_t<decltype(alternative)>>(b)); },
+            a);
+    }
+
+    template<typename T>
+    bool FieldEquals(const std::optional<T>& a, const std::optional<T>& b)
+    {
+        if (a.has_value() != b.has_value())
+            return false;
+
+        return !a.has_value() || FieldEquals(*a, *b);
+    }
+
+    template<Reflected T>
+    void Copy(const T& source, T& destination)
+    {
+        ForEachField<T>([&](const auto& field) { destination.*field.member = source.*field.member; });
+        NotifyAssigned(destination);
+    }
+
+    // One bit per field, in declaration order
+    template<Reflected T>
+    uint64_t Diff(const T& a, const T& b)
+    {
+        static_assert(FieldCount<T> <= 64, "Diff masks are limited to 64 fields");
+
+        uint64_t mask = 0;
+        uint32_t index = 0;
+        ForEachField<T>(
+            [&](const auto& field)
+            {
+                if (!FieldEquals(a.*field.member, b.*field.member))
+                {
+                    mask |= uint64_t{ 1 } << index;
+                }
+                ++index;
+            });
+        return mask;
+    }
+
+    template<Reflected T>
+    bool Equals(const T& a, const T& b)
+    {
+        return Diff(a, b) == 0;
+    }
+} // namespace Frost::Reflection
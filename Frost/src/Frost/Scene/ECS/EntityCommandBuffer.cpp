@@ -0,0 +1,138 @@
+#include "Frost/Scene/ECS/EntityCommandBuffer.h"
+#include "Frost/Scene/Scene.h"
+
+#include <algorithm>
+
+namespace Frost
+{
+    EntityCommandBuffer::EntityRef EntityCommandBuffer::CreateGameObject(std::string name)
+    {
+        _creates.push_back({ std::move(name) });
+        return EntityRef(static_cast<uint32_t>(_creates.size() - 1));
+    }
+
+    EntityCommandBuffer::EntityRef EntityCommandBuffer::CreateGameObject(std::string name, EntityRef parent)
+    {
+        EntityRef gameObject = CreateGameObject(std::move(name));
+        SetParent(gameObject, parent);
+        return gameObject;
+    }
+
+    void EntityCommandBuffer::DestroyGameObject(EntityRef gameObject)
+    {
+        _destroys.push_back(gameObject);
+    }
+
+    void EntityCommandBuffer::SetParent(EntityRef child, EntityRef parent)
+    {
+        _parents.push_back({ child, parent });
+    }
+
+    bool EntityCommandBuffer::IsEmpty() const
+    {
+        return _creates.empty() && _parents.empty() && _components.empty() && _destroys.empty();
+    }
+
+    void EntityCommandBuffer::Clear()
+    {
+        _creates.clear();
+        _parents.clear();
+        _components.clear();
+        _destroys.clear();
+        _created.clear();
+    }
+
+    entt::entity EntityCommandBuffer::_Resolve(const EntityRef& ref) const
+    {
+        if (ref._pendingIndex == EntityRef::NOT_PENDING)
+        {
+            return ref._handle;
+        }
+
+        return ref._pendingIndex < _created.size() ? _created[ref._pendingIndex] : entt::null;
+    }
+
+    void EntityCommandBuffer::Playback(Scene& scene, std::vector<EntityCommandBuffer>& buffers)
+    {
+        auto& registry = scene.GetRegistry();
+
+        for (auto& buffer : buffers)
+        {
+            buffer._created.clear();
+            buffer._created.reserve(buffer._creates.size());
+
+            for (auto& create : buffer._creates)
+            {
+                buffer._created.push_back(scene.CreateGameObject(std::move(create.name)).GetHandle());
+            }
+        }
+
+        for (const auto& buffer : buffers)
+        {
+            for (const auto& command : buffer._parents)
+            {
+                entt::entity child = buffer._Resolve(command.child);
+                entt::entity parent = buffer._Resolve(command.parent);
+
+                if (!registry.valid(child) || (parent != entt::null && !registry.valid(parent)))
+                {
+                    continue;
+                }
+
+                GameObject(child, &scene).SetParent(parent != entt::null ? GameObject(parent, &scene) : GameObject());
+            }
+        }
+
+        struct ResolvedComponentCommand
+        {
+            entt::id_type type;
+            entt::entity target;
+            ComponentPayload* payload;
+        };
+
+        std::vector<ResolvedComponentCommand> components;
+        for (auto& buffer : buffers)
+        {
+            for (auto& command : buffer._components)
+            {
+                components.push_back({ command.type, buffer._Resolve(command.target), command.payload.get() });
+            }
+        }
+
+        // Grouping by type keeps each storage hot, the stable sort preserves add/remove order on the same entity
+        std::stable_sort(components.begin(),
+                         components.end(),
+                         [](const ResolvedComponentCommand& a, const ResolvedComponentCommand& b)
+                         {
+                             if (a.type != b.type)
+                             {
+                                 return a.type < b.type;
+                             }
+                             return a.target < b.target;
+                         });
+
+        for (const auto& command : components)
+        {
+            if (registry.valid(command.target))
+            {
+                command.payload->Apply(GameObject(command.target, &scene));
+            }
+        }
+
+        std::vector<GameObject> destroys;
+        for (const auto& buffer : buffers)
+        {
+            for (const auto& ref : buffer._destroys)
+            {
+                destroys.emplace_back(buffer._Resolve(ref), &scene);
+            }
+        }
+
+        scene.DestroyGameObjects(destroys);
+
+        for (auto& buffer : buffers)
+        {
+            buffer.Clear();
+        }
+    }
+} // namespace Frost
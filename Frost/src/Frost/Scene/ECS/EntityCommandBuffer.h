@@ -0,0 +1,132 @@
+#pragma once
+
+#include "Frost/Core/Core.h"
+#include "Frost/Scene/ECS/GameObject.h"
+
+#include <entt/entt.hpp>
+#include <limits>
+#include <memory>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+
+namespace Frost
+{
+    class Scene;
+
+    // Records structural changes and applies them at the scene sync points, so they are safe while systems iterate
+    class FROST_API EntityCommandBuffer
+    {
+    public:
+        EntityCommandBuffer() = default;
+        EntityCommandBuffer(EntityCommandBuffer&&) noexcept = default;
+        EntityCommandBuffer& operator=(EntityCommandBuffer&&) noexcept = default;
+        EntityCommandBuffer(const EntityCommandBuffer&) = delete;
+        EntityCommandBuffer& operator=(const EntityCommandBuffer&) = delete;
+
+        // Either an existing game object or one created earlier in the same buffer
+        class EntityRef
+        {
+        public:
+            EntityRef(GameObject gameObject) : _handle(gameObject.GetHandle()) {}
+            EntityRef(entt::entity handle) : _handle(handle) {}
+
+        private:
+            EntityRef(uint32_t pendingIndex) : _pendingIndex(pendingIndex) {}
+
+            entt::entity _handle{ entt::null };
+            uint32_t _pendingIndex = NOT_PENDING;
+
+            static constexpr uint32_t NOT_PENDING = std::numeric_limits<uint32_t>::max();
+
+            friend class EntityCommandBuffer;
+        };
+
+        EntityRef CreateGameObject(std::string name = "Entity");
+        EntityRef CreateGameObject(std::string name, EntityRef parent);
+        void DestroyGameObject(EntityRef gameObject);
+        void SetParent(EntityRef child, EntityRef parent);
+
+        // The arguments are moved into the buffer, so move-only ones are accepted
+        template<typename T, typename... Args>
+        void AddComponent(EntityRef gameObject, Args&&... args)
+        {
+            _components.push_back(
+                { entt::type_hash<T>::value(),
+                  gameObject,
+                  std::make_unique<AddPayload<T, std::decay_t<Args>...>>(std::forward<Args>(args)...) });
+        }
+
+        template<typename T>
+        void RemoveComponent(EntityRef gameObject)
+        {
+            _components.push_back({ entt::type_hash<T>::value(), gameObject, std::make_unique<RemovePayload<T>>() });
+        }
+
+        bool IsEmpty() const;
+        void Clear();
+
+        // Applies every buffer in order: creations, reparenting, component changes sorted by type, then destructions
+        static void Playback(Scene& scene, std::vector<EntityCommandBuffer>& buffers);
+
+    private:
+        struct CreateCommand
+        {
+            std::string name;
+        };
+
+        struct ParentCommand
+        {
+            EntityRef child;
+            EntityRef parent;
+        };
+
+        // Type-erased component change, applied once during playback
+        struct ComponentPayload
+        {
+            virtual ~ComponentPayload() = default;
+            virtual void Apply(GameObject target) = 0;
+        };
+
+        template<typename T, typename... Args>
+        struct AddPayload final : ComponentPayload
+        {
+            template<typename... Forwarded>
+            explicit AddPayload(Forwarded&&... forwarded) : args(std::forward<Forwarded>(forwarded)...)
+            {
+            }
+
+            void Apply(GameObject target) override
+            {
+                std::apply([&target](Args&... values) { target.AddComponent<T>(std::move(values)...); }, args);
+            }
+
+            std::tuple<Args...> args;
+        };
+
+        template<typename T>
+        struct RemovePayload final : ComponentPayload
+        {
+            void Apply(GameObject target) override { target.RemoveComponent<T>(); }
+        };
+
+        struct ComponentCommand
+        {
+            entt::id_type type;
+            EntityRef target;
+            std::unique_ptr<ComponentPayload> payload;
+        };
+
+        entt::entity _Resolve(const EntityRef& ref) const;
+
+    private:
+        std::vector<CreateCommand> _creates;
+        std::vector<ParentCommand> _parents;
+        std::vector<ComponentCommand> _components;
+        std::vector<EntityRef> _destroys;
+
+        // Filled during playback, maps pending indices to the entities that were created
+        std::vector<entt::entity> _created;
+    };
+} // namespace Frost
@@ -18,6 +18,11 @@ namespace Frost
         }
     }
 
+    GameObject::GameObject(entt::entity handle, entt::registry& registry) :
+        _entityHandle(handle), _scene(nullptr), _registry(&registry)
+    {
+    }
+
     static void DetachFromParent(entt::registry& registry, entt::entity entity)
     {
         auto& childRel = registry.get<Component::Relationship>(entity);
@@ -132,6 +137,11 @@ namespace Frost
         {
             AttachToParent(*_registry, _entityHandle, parentHandle);
         }
+
+        if (_registry->all_of<Component::Relationship>(_entityHandle))
+        {
+            _registry->patch<Component::Relationship>(_entityHandle);
+        }
     }
 
     GameObject GameObject::GetParent()
@@ -179,11 +189,7 @@ namespace Frost
             return;
         }
 
-        auto childrenCopy = GetChildren();
-        for (auto& child : childrenCopy)
-        {
-            _scene->DestroyGameObject(child);
-        }
+        _scene->DestroyGameObjects(GetChildren());
 
         if (HasComponent<Component::Relationship>())
         {
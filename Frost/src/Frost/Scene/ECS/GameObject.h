@@ -21,6 +21,9 @@ namespace Frost
         GameObject() = default;
         GameObject(entt::entity handle);
         GameObject(entt::entity handle, Scene* scene);
+        // Entity of a registry owned by no scene, such as a streaming staging registry. Only the component accessors
+        // can be used, the hierarchy and scene helpers need a scene
+        GameObject(entt::entity handle, entt::registry& registry);
 
         template<typename T, typename... Args>
         decltype(auto) AddComponent(Args&&... args)
@@ -64,6 +67,13 @@ namespace Frost
             _registry->remove<T>(_entityHandle);
         }
 
+        // Runs the update observers of a component edited in place
+        template<typename T>
+        void PatchComponent()
+        {
+            _registry->patch<T>(_entityHandle);
+        }
+
         // Activation
         void SetActive(bool active);
         bool IsActive() const;
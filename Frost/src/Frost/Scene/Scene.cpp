@@ -1,7 +1,9 @@
 #include "Frost/Scene/Scene.h"
 
+#include "Frost/Scene/Components/EntityID.h"
 #include "Frost/Scene/Components/Meta.h"
 #include "Frost/Scene/Components/Relationship.h"
+#include "Frost/Scene/Components/WorldMatrix.h"
 #include "Frost/Scene/Systems/PhysicSystem.h"
 #include "Frost/Scene/Systems/RendererSystem.h"
 #include "Frost/Scene/Systems/ScriptableSystem.h"
@@ -10,18 +12,24 @@
 #include "Frost/Scene/Systems/BillboardSystem.h"
 #include "Frost/Scene/Serializers/SerializationSystem.h"
 
+#include <unordered_set>
+
 using namespace Frost::Component;
 
 namespace Frost
 {
-    Scene::Scene(std::string name) : _name{ name }
+    Scene::Scene(std::string name) : _name{ name }, _history{ this }, _streamer{ this }
     {
         _registry.on_destroy<Component::Relationship>().connect<&Scene::_OnRelationshipDestroyed>(this);
+        _changeTracker.Watch(_registry);
+        _hierarchyCache.Watch(_registry);
         _InitializeSystems();
     }
 
     Scene::~Scene()
     {
+        _streamer.Close();
+
         for (auto& system : _systems)
         {
             if (system)
@@ -39,12 +47,14 @@ namespace Frost
     {
         auto entity = _registry.create();
 
-        // Meta, Relationship, Transform and WorldTransform is used
+        // EntityID, Meta, Relationship, Transform, WorldTransform and WorldMatrix is used
         // by 99% of all gameobjects
+        _registry.emplace<Component::EntityID>(entity);
         _registry.emplace<Component::Meta>(entity, name);
         _registry.emplace<Component::Relationship>(entity);
         _registry.emplace<Component::Transform>(entity);
         _registry.emplace<Component::WorldTransform>(entity);
+        _registry.emplace<Component::WorldMatrix>(entity);
 
         return GameObject(entity, this);
     }
@@ -61,14 +71,73 @@ namespace Frost
         if (!gameObject.IsValid())
             return;
 
-        gameObject.DestroyAllChildren();
+        _DestroyHierarchies({ gameObject.GetHandle() });
+    }
+
+    void Scene::DestroyGameObjects(const std::vector<GameObject>& gameObjects)
+    {
+        std::vector<entt::entity> entities;
+        entities.reserve(gameObjects.size());
+
+        for (const auto& gameObject : gameObjects)
+        {
+            if (_registry.valid(gameObject.GetHandle()))
+            {
+                entities.push_back(gameObject.GetHandle());
+            }
+        }
+
+        if (!entities.empty())
+        {
+            _DestroyHierarchies(std::move(entities));
+        }
+    }
+
+    void Scene::_DestroyHierarchies(std::vector<entt::entity> entities)
+    {
+        std::unordered_set<entt::entity> dying;
+        std::vector<entt::entity> roots;
+
+        for (auto entity : entities)
+        {
+            if (dying.insert(entity).second)
+            {
+                roots.push_back(entity);
+            }
+        }
+
+        // Gather the whole subtrees, children are appended while iterating
+        entities = roots;
+        for (size_t i = 0; i < entities.size(); ++i)
+        {
+            auto* relationship = _registry.try_get<Relationship>(entities[i]);
+            if (!relationship)
+                continue;
+
+            for (auto child = relationship->firstChild; child != entt::null;)
+            {
+                if (dying.insert(child).second)
+                {
+                    entities.push_back(child);
+                }
+                child = _registry.get<Relationship>(child).nextSibling;
+            }
+        }
 
-        if (gameObject.GetParent())
+        // Only the roots whose parent survives have links to fix
+        for (auto root : roots)
         {
-            gameObject.SetParent({});
+            auto* relationship = _registry.try_get<Relationship>(root);
+            if (relationship && relationship->parent != entt::null && !dying.contains(relationship->parent))
+            {
+                GameObject(root, this).SetParent({});
+            }
         }
 
-        _registry.destroy(gameObject.GetHandle());
+        // The whole batch goes away at once, unlinking each entity one by one would be wasted work
+        _registry.on_destroy<Component::Relationship>().disconnect<&Scene::_OnRelationshipDestroyed>(this);
+        _registry.destroy(entities.begin(), entities.end());
+        _registry.on_destroy<Component::Relationship>().connect<&Scene::_OnRelationshipDestroyed>(this);
     }
 
     GameObject Scene::DuplicateGameObject(GameObject source)
@@ -207,10 +276,14 @@ namespace Frost
 
     void Scene::Update(float deltaTime)
     {
+        _streamer.Update();
+
         for (const auto& system : _systems)
         {
             system->Update(*this, deltaTime);
         }
+
+        FlushCommandBuffers();
     }
 
     void Scene::PreFixedUpdate(float deltaTime)
@@ -219,6 +292,8 @@ namespace Frost
         {
             system->PreFixedUpdate(*this, deltaTime);
         }
+
+        FlushCommandBuffers();
     }
 
     void Scene::FixedUpdate(float deltaTime)
@@ -227,6 +302,8 @@ namespace Frost
         {
             system->FixedUpdate(*this, deltaTime);
         }
+
+        FlushCommandBuffers();
     }
 
     void Scene::LateUpdate(float deltaTime)
@@ -235,6 +312,46 @@ namespace Frost
         {
             system->LateUpdate(*this, deltaTime);
         }
+
+        FlushCommandBuffers();
+    }
+
+    EntityCommandBuffer& Scene::GetCommandBuffer()
+    {
+        std::lock_guard lock(_commandBuffersMutex);
+
+        auto threadId = std::this_thread::get_id();
+        for (auto& [id, buffer] : _commandBuffers)
+        {
+            if (id == threadId)
+            {
+                return *buffer;
+            }
+        }
+
+        return *_commandBuffers.emplace_back(threadId, std::make_unique<EntityCommandBuffer>()).second;
+    }
+
+    void Scene::FlushCommandBuffers()
+    {
+        std::vector<EntityCommandBuffer> batches;
+        {
+            std::lock_guard lock(_commandBuffersMutex);
+            for (auto& [id, buffer] : _commandBuffers)
+            {
+                if (!buffer->IsEmpty())
+                {
+                    batches.push_back(std::move(*buffer));
+                    buffer->Clear();
+                }
+            }
+        }
+
+        // Commands recorded during playback land in the emptied buffers and wait for the next sync point
+        if (!batches.empty())
+        {
+            EntityCommandBuffer::Playback(*this, batches);
+        }
     }
 
     void Scene::SetEditorRenderTarget(std::shared_ptr<Texture> target)
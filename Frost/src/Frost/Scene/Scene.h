@@ -4,13 +4,20 @@
 #include "Frost/Core/Timer.h"
 #include "Frost/Scene/Components/Disabled.h"
 #include "Frost/Scene/Components/Scriptable.h"
+#include "Frost/Scene/ECS/EntityCommandBuffer.h"
 #include "Frost/Scene/ECS/GameObject.h"
+#include "Frost/Scene/SceneChangeTracker.h"
+#include "Frost/Scene/SceneHierarchyCache.h"
+#include "Frost/Scene/SceneHistory.h"
+#include "Frost/Scene/SceneStreamer.h"
 #include "Frost/Utils/NoCopy.h"
 #include "Frost/Asset/Texture.h"
 
 #include <entt/entt.hpp>
 #include <memory>
+#include <mutex>
 #include <string>
+#include <thread>
 #include <vector>
 
 namespace Frost
@@ -27,6 +34,7 @@ namespace Frost
         GameObject CreateGameObject(std::string name = "Entity");
         GameObject CreateGameObject(std::string name, GameObject parent);
         void DestroyGameObject(GameObject gameObject);
+        void DestroyGameObjects(const std::vector<GameObject>& gameObjects);
         GameObject DuplicateGameObject(GameObject source);
 
         std::vector<GameObject> FindGameObjectsByName(const std::string& name);
@@ -38,11 +46,24 @@ namespace Frost
         void LateUpdate(float deltaTime);
         void SetEditorRenderTarget(std::shared_ptr<Texture> target);
 
+        // Buffer of the calling thread, applied after each update phase
+        EntityCommandBuffer& GetCommandBuffer();
+        void FlushCommandBuffers();
+
         entt::registry& GetRegistry() { return _registry; }
+        SceneChangeTracker& GetChangeTracker() { return _changeTracker; }
+        SceneHierarchyCache& GetHierarchyCache() { return _hierarchyCache; }
+        SceneHistory& GetHistory() { return _history; }
+        SceneStreamer& GetStreamer() { return _streamer; }
 
         const std::string& GetName() const { return _name; }
         void SetName(const std::string& name) { _name = name; }
-        void Clear() { _registry.clear(); }
+        void Clear()
+        {
+            _streamer.Close();
+            _registry.clear();
+            _history.Clear();
+        }
 
         template<typename... Components>
         auto View()
@@ -104,12 +125,21 @@ namespace Frost
         }
 
     private:
+        // Declared first so that they outlive the registry signals they listen to
+        SceneChangeTracker _changeTracker;
+        SceneHierarchyCache _hierarchyCache;
         entt::registry _registry;
         std::string _name;
         std::vector<std::unique_ptr<System>> _systems;
+        SceneHistory _history;
+        SceneStreamer _streamer;
+
+        std::mutex _commandBuffersMutex;
+        std::vector<std::pair<std::thread::id, std::unique_ptr<EntityCommandBuffer>>> _commandBuffers;
 
         void _InitializeSystems();
 
+        void _DestroyHierarchies(std::vector<entt::entity> entities);
         void _DuplicateRecursively(GameObject source, GameObject newParent);
         void _OnRelationshipDestroyed(entt::registry& registry, entt::entity entity);
     };
@@ -0,0 +1,103 @@
+#include "Frost/Scene/SceneChangeTracker.h"
+#include "Frost/Scene/Components/EntityID.h"
+#include "Frost/Scene/Components/Relationship.h"
+#include "Frost/Scene/Serializers/SerializationSystem.h"
+
+namespace Frost
+{
+    SceneChangeTracker::~SceneChangeTracker()
+    {
+        WaitForCompaction();
+    }
+
+    void SceneChangeTracker::Watch(entt::registry& registry)
+    {
+        registry.on_destroy<Component::EntityID>().connect<&SceneChangeTracker::_OnEntityIDDestroyed>(this);
+
+        // GameObject::SetParent patches the relationship
+        registry.on_construct<Component::Relationship>().connect<&SceneChangeTracker::_OnChanged>(this);
+        registry.on_update<Component::Relationship>().connect<&SceneChangeTracker::_OnChanged>(this);
+
+        for (const auto& serializer : SerializationSystem::GetAllSerializers())
+        {
+            serializer.WatchChanges(registry, *this);
+        }
+    }
+
+    void SceneChangeTracker::MarkDirty(entt::entity entity)
+    {
+        if (_IsJournaled())
+        {
+            _dirty.insert(entity);
+        }
+    }
+
+    bool SceneChangeTracker::IsSyncedWith(const std::filesystem::path& filepath) const
+    {
+        return !_syncedPath.empty() && _syncedPath == filepath && std::filesystem::exists(filepath);
+    }
+
+    void SceneChangeTracker::MarkSynced(const std::filesystem::path& filepath, uint32_t recordCount)
+    {
+        _syncedPath = filepath;
+        _recordCount = recordCount;
+        _ClearChanges();
+    }
+
+    void SceneChangeTracker::Reset()
+    {
+        WaitForCompaction();
+        _syncedPath.clear();
+        _recordCount = 0;
+        _ClearChanges();
+    }
+
+    void SceneChangeTracker::SetPendingCompaction(std::future<void>&& compaction)
+    {
+        WaitForCompaction();
+        _compaction = std::move(compaction);
+    }
+
+    void SceneChangeTracker::WaitForCompaction()
+    {
+        if (_compaction.valid())
+        {
+            _compaction.wait();
+            _compaction = {};
+        }
+    }
+
+    void SceneChangeTracker::_OnChanged(entt::registry& registry, entt::entity entity)
+    {
+        if (_IsJournaled())
+        {
+            _dirty.insert(entity);
+        }
+    }
+
+    void SceneChangeTracker::_OnEntityIDDestroyed(entt::registry& registry, entt::entity entity)
+    {
+        _dirty.erase(entity);
+        if (!_IsJournaled())
+        {
+            return;
+        }
+
+        if (_destroyed.size() >= MAX_DESTROYED_GUIDS)
+        {
+            // Dropping the journal makes the next save rewrite the file, which also compacts it
+            _syncedPath.clear();
+            _recordCount = 0;
+            _ClearChanges();
+            return;
+        }
+
+        _destroyed.push_back(registry.get<Component::EntityID>(entity).guid);
+    }
+
+    void SceneChangeTracker::_ClearChanges()
+    {
+        _dirty.clear();
+        _destroyed.clear();
+    }
+} // namespace Frost
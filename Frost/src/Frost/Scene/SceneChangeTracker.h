@@ -0,0 +1,61 @@
+#pragma once
+
+#include "Frost/Core/Core.h"
+
+#include <entt/entt.hpp>
+#include <cstdint>
+#include <filesystem>
+#include <future>
+#include <unordered_set>
+#include <vector>
+
+namespace Frost
+{
+    // Entities touched since the scene was last written to its chunked binary file, fed by registry signals
+    class FROST_API SceneChangeTracker
+    {
+    public:
+        ~SceneChangeTracker();
+
+        void Watch(entt::registry& registry);
+
+        // For in-place edits that do not go through registry.patch
+        void MarkDirty(entt::entity entity);
+
+        const std::unordered_set<entt::entity>& GetDirtyEntities() const { return _dirty; }
+        const std::vector<uint64_t>& GetDestroyedGuids() const { return _destroyed; }
+
+        // The file the scene was last loaded from or fully written to, incremental saves only append to it
+        bool IsSyncedWith(const std::filesystem::path& filepath) const;
+        const std::filesystem::path& GetSyncedPath() const { return _syncedPath; }
+        uint32_t GetRecordCount() const { return _recordCount; }
+
+        void MarkSynced(const std::filesystem::path& filepath, uint32_t recordCount);
+        void Reset();
+
+        void SetPendingCompaction(std::future<void>&& compaction);
+        void WaitForCompaction();
+
+    private:
+        void _OnChanged(entt::registry& registry, entt::entity entity);
+        void _OnEntityIDDestroyed(entt::registry& registry, entt::entity entity);
+
+        // Changes only matter once there is a file to append them to, the next save is a full one otherwise
+        bool _IsJournaled() const { return !_syncedPath.empty(); }
+        void _ClearChanges();
+
+    private:
+        std::unordered_set<entt::entity> _dirty;
+        std::vector<uint64_t> _destroyed;
+
+        std::filesystem::path _syncedPath;
+        uint32_t _recordCount = 0;
+
+        std::future<void> _compaction;
+
+        // Past this many tombstones a full rewrite is cheaper than appending them
+        static constexpr size_t MAX_DESTROYED_GUIDS = 16384;
+
+        friend class SerializationSystem;
+    };
+} // namespace Frost
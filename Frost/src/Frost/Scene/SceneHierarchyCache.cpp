@@ -0,0 +1,224 @@
+#include "Frost/Scene/SceneHierarchyCache.h"
+#include "Frost/Scene/Components/Meta.h"
+#include "Frost/Scene/Components/Relationship.h"
+
+#include <algorithm>
+#include <cctype>
+
+namespace Frost
+{
+    static std::string ToLower(std::string_view text)
+    {
+        std::string lower(text);
+        std::ranges::transform(lower, lower.begin(), [](unsigned char c) { return std::tolower(c); });
+        return lower;
+    }
+
+    static bool IsEditorEntity(const Component::Meta& meta)
+    {
+        return meta.name.starts_with("__EDITOR__");
+    }
+
+    void SceneHierarchyCache::Watch(entt::registry& registry)
+    {
+        _registry = &registry;
+
+        registry.on_construct<Component::Relationship>().connect<&SceneHierarchyCache::_OnTreeChanged>(this);
+        registry.on_update<Component::Relationship>().connect<&SceneHierarchyCache::_OnTreeChanged>(this);
+        registry.on_destroy<Component::Relationship>().connect<&SceneHierarchyCache::_OnTreeChanged>(this);
+        registry.on_construct<Component::Meta>().connect<&SceneHierarchyCache::_OnTreeChanged>(this);
+        registry.on_update<Component::Meta>().connect<&SceneHierarchyCache::_OnTreeChanged>(this);
+        registry.on_destroy<Component::Meta>().connect<&SceneHierarchyCache::_OnTreeChanged>(this);
+    }
+
+    void SceneHierarchyCache::Invalidate()
+    {
+        _isDirty = true;
+        _isNameIndexDirty = true;
+    }
+
+    void SceneHierarchyCache::SetExpanded(entt::entity entity, bool isExpanded)
+    {
+        bool changed = isExpanded ? _expanded.insert(entity).second : _expanded.erase(entity) > 0;
+        if (changed)
+        {
+            _isDirty = true;
+        }
+    }
+
+    void SceneHierarchyCache::SetFilter(std::string_view filter)
+    {
+        std::string lower = ToLower(filter);
+        if (lower != _filter)
+        {
+            _filter = std::move(lower);
+            _isDirty = true;
+        }
+    }
+
+    void SceneHierarchyCache::SetSortedByName(bool isSortedByName)
+    {
+        if (isSortedByName != _isSortedByName)
+        {
+            _isSortedByName = isSortedByName;
+            _isDirty = true;
+        }
+    }
+
+    const std::vector<SceneHierarchyCache::Row>& SceneHierarchyCache::GetRows()
+    {
+        if (_isDirty && _registry)
+        {
+            _rows.clear();
+            if (_filter.empty())
+            {
+                _BuildTree();
+            }
+            else
+            {
+                _BuildFilteredRows();
+            }
+            _isDirty = false;
+        }
+
+        return _rows;
+    }
+
+    void SceneHierarchyCache::_OnTreeChanged(entt::registry&, entt::entity)
+    {
+        Invalidate();
+    }
+
+    void SceneHierarchyCache::_BuildTree()
+    {
+        auto& registry = *_registry;
+
+        // Depth first, without recursion so that deep chains do not overflow the stack
+        std::vector<std::pair<entt::entity, uint32_t>> stack;
+        std::vector<entt::entity> children;
+
+        auto visit = [&](entt::entity root)
+        {
+            stack.push_back({ root, 0 });
+            while (!stack.empty())
+            {
+                auto [entity, depth] = stack.back();
+                stack.pop_back();
+
+                const auto* relationship = registry.try_get<Component::Relationship>(entity);
+                const auto* meta = registry.try_get<Component::Meta>(entity);
+                if (!relationship || !meta || IsEditorEntity(*meta))
+                    continue;
+
+                bool hasChildren = relationship->childrenCount > 0;
+                bool isExpanded = hasChildren && _expanded.contains(entity);
+                _rows.push_back({ entity, depth, hasChildren, isExpanded });
+
+                if (!isExpanded)
+                    continue;
+
+                children.clear();
+                for (entt::entity child = relationship->firstChild; registry.valid(child);)
+                {
+                    children.push_back(child);
+                    const auto* childRelationship = registry.try_get<Component::Relationship>(child);
+                    child = childRelationship ? childRelationship->nextSibling : entt::null;
+                }
+                _SortByName(children);
+
+                // Pushed backwards so that the first child is listed first
+                for (auto it = children.rbegin(); it != children.rend(); ++it)
+                {
+                    stack.push_back({ *it, depth + 1 });
+                }
+            }
+        };
+
+        std::vector<entt::entity> roots;
+        registry.view<Component::Relationship, Component::Meta>().each(
+            [&](entt::entity entity, const Component::Relationship& relationship, const Component::Meta&)
+            {
+                if (relationship.parent == entt::null)
+                {
+                    roots.push_back(entity);
+                }
+            });
+        _SortByName(roots);
+
+        for (entt::entity root : roots)
+        {
+            visit(root);
+        }
+    }
+
+    void SceneHierarchyCache::_BuildFilteredRows()
+    {
+        // Typing one more character only narrows the previous matches down
+        bool isNarrowing = !_isNameIndexDirty && !_matchedFilter.empty() && _filter.starts_with(_matchedFilter);
+
+        if (_isNameIndexDirty)
+        {
+            _BuildNameIndex();
+        }
+
+        if (isNarrowing)
+        {
+            std::erase_if(_matches,
+                          [&](uint32_t index) { return _nameIndex[index].second.find(_filter) == std::string::npos; });
+        }
+        else
+        {
+            _matches.clear();
+            for (uint32_t index = 0; index < _nameIndex.size(); ++index)
+            {
+                if (_nameIndex[index].second.find(_filter) != std::string::npos)
+                {
+                    _matches.push_back(index);
+                }
+            }
+        }
+        _matchedFilter = _filter;
+
+        _rows.reserve(_matches.size());
+        for (uint32_t index : _matches)
+        {
+            _rows.push_back({ _nameIndex[index].first, 0, false, false });
+        }
+    }
+
+    void SceneHierarchyCache::_BuildNameIndex()
+    {
+        _nameIndex.clear();
+        _registry->view<Component::Relationship, Component::Meta>().each(
+            [&](entt::entity entity, const Component::Relationship&, const Component::Meta& meta)
+            {
+                if (!IsEditorEntity(meta))
+                {
+                    _nameIndex.emplace_back(entity, ToLower(meta.name));
+                }
+            });
+
+        _isNameIndexDirty = false;
+    }
+
+    void SceneHierarchyCache::_SortByName(std::vector<entt::entity>& entities) const
+    {
+        if (!_isSortedByName)
+            return;
+
+        auto& registry = *_registry;
+        std::ranges::stable_sort(entities,
+                                 [&](entt::entity a, entt::entity b)
+                                 {
+                                     const auto* metaA = registry.try_get<Component::Meta>(a);
+                                     const auto* metaB = registry.try_get<Component::Meta>(b);
+                                     std::string_view nameA = metaA ? std::string_view(metaA->name) : "Entity";
+                                     std::string_view nameB = metaB ? std::string_view(metaB->name) : "Entity";
+                                     return std::ranges::lexicographical_compare(
+                                         nameA,
+                                         nameB,
+                                         [](unsigned char c1, unsigned char c2)
+                                         { return std::tolower(c1) < std::tolower(c2); });
+                                 });
+    }
+} // namespace Frost
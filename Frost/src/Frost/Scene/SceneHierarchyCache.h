@@ -0,0 +1,71 @@
+#pragma once
+
+#include "Frost/Core/Core.h"
+
+#include <entt/entt.hpp>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <unordered_set>
+#include <vector>
+
+namespace Frost
+{
+    // Flattened rows of the entity tree for hierarchy panels, only the children of expanded entities are listed. The
+    // rows are rebuilt when the tree, a name or the expansion state changes, so a panel drawing only the rows on
+    // screen costs the same whatever the scene size.
+    //
+    // Tree and name changes are picked up from the registry signals, in-place edits call Invalidate(). Editor
+    // helpers, whose name starts with __EDITOR__, are never listed.
+    class FROST_API SceneHierarchyCache
+    {
+    public:
+        struct Row
+        {
+            entt::entity entity;
+            uint32_t depth;
+            bool hasChildren;
+            bool isExpanded;
+        };
+
+        void Watch(entt::registry& registry);
+
+        void Invalidate();
+
+        bool IsExpanded(entt::entity entity) const { return _expanded.contains(entity); }
+        void SetExpanded(entt::entity entity, bool isExpanded);
+
+        // With a filter, the rows are the entities whose name contains it, case insensitive, as a flat list
+        void SetFilter(std::string_view filter);
+        const std::string& GetFilter() const { return _filter; }
+
+        // Siblings in name order, case insensitive, instead of the registry order
+        void SetSortedByName(bool isSortedByName);
+
+        const std::vector<Row>& GetRows();
+
+    private:
+        void _OnTreeChanged(entt::registry& registry, entt::entity entity);
+
+        void _BuildTree();
+        void _BuildFilteredRows();
+        void _BuildNameIndex();
+        void _SortByName(std::vector<entt::entity>& entities) const;
+
+    private:
+        entt::registry* _registry = nullptr;
+
+        std::vector<Row> _rows;
+        std::unordered_set<entt::entity> _expanded;
+        bool _isDirty = true;
+        bool _isSortedByName = false;
+
+        std::string _filter;
+        // Lowercase names of every entity, rebuilt with the rows when a filter is set
+        std::vector<std::pair<entt::entity, std::string>> _nameIndex;
+        // Index entries matching _matchedFilter. A filter extending it only searches these.
+        std::vector<uint32_t> _matches;
+        std::string _matchedFilter;
+        bool _isNameIndexDirty = true;
+    };
+} // namespace Frost
@@ -0,0 +1,551 @@
+#include "Frost/Scene/SceneHistory.h"
+
+#include "Frost/Scene/Components/EntityID.h"
+#include "Frost/Scene/Components/Relationship.h"
+#include "Frost/Scene/Components/RigidBody.h"
+#include "Frost/Scene/Scene.h"
+#include "Frost/Scene/Serializers/SerializationSystem.h"
+#include "Frost/Scene/Systems/PhysicSystem.h"
+
+#include <span>
+#include <spanstream>
+#include <string_view>
+
+using namespace Frost::Component;
+
+namespace Frost
+{
+    namespace
+    {
+        uint64_t AllFields(uint32_t count)
+        {
+            return count >= 64 ? ~uint64_t{ 0 } : (uint64_t{ 1 } << count) - 1;
+        }
+
+        uint32_t SegmentCount(const ComponentSerializer& serializer)
+        {
+            return serializer.SerializeBinaryFields ? serializer.FieldCount : 1;
+        }
+    } // namespace
+
+    SceneHistory::SceneHistory(Scene* scene) : _scene{ scene } {}
+
+    SceneHistory::~SceneHistory() = default;
+
+    void SceneHistory::BeginTransaction(std::string name, uint64_t mergeKey)
+    {
+        if (_depth++ > 0)
+        {
+            return;
+        }
+
+        if (_pending && _pending->isLingering)
+        {
+            if (mergeKey != 0 && _pending->mergeKey == mergeKey)
+            {
+                _pending->isLingering = false;
+                return;
+            }
+
+            _Finalize();
+        }
+
+        _pending = std::make_unique<PendingTransaction>();
+        _pending->name = std::move(name);
+        _pending->mergeKey = mergeKey;
+    }
+
+    void SceneHistory::EndTransaction(bool keepOpen)
+    {
+        FT_ENGINE_ASSERT(_depth > 0, "SceneHistory::EndTransaction called without a transaction");
+        if (_depth == 0 || --_depth > 0)
+        {
+            return;
+        }
+
+        if (keepOpen && _pending->mergeKey != 0)
+        {
+            _pending->isLingering = true;
+            return;
+        }
+
+        _Finalize();
+    }
+
+    void SceneHistory::Record(GameObject gameObject, bool withChildren)
+    {
+        _Record(gameObject, withChildren, false);
+    }
+
+    void SceneHistory::RecordCreated(GameObject gameObject, bool withChildren)
+    {
+        _Record(gameObject, withChildren, true);
+    }
+
+    bool SceneHistory::CanUndo() const
+    {
+        return !_undo.empty() || (_pending && _pending->isLingering);
+    }
+
+    bool SceneHistory::CanRedo() const
+    {
+        return !_redo.empty() && !_pending;
+    }
+
+    bool SceneHistory::Undo()
+    {
+        if (_depth > 0)
+        {
+            return false;
+        }
+
+        if (_pending)
+        {
+            _Finalize();
+        }
+
+        if (_undo.empty())
+        {
+            return false;
+        }
+
+        _Apply(_undo.back(), false);
+        _redo.push_back(std::move(_undo.back()));
+        _undo.pop_back();
+        return true;
+    }
+
+    bool SceneHistory::Redo()
+    {
+        if (_depth > 0)
+        {
+            return false;
+        }
+
+        if (_pending)
+        {
+            _Finalize();
+        }
+
+        if (_redo.empty())
+        {
+            return false;
+        }
+
+        _Apply(_redo.back(), true);
+        _undo.push_back(std::move(_redo.back()));
+        _redo.pop_back();
+        return true;
+    }
+
+    void SceneHistory::Clear()
+    {
+        _depth = 0;
+        _pending.reset();
+        _undo.clear();
+        _redo.clear();
+        _memoryUsage = 0;
+    }
+
+    const std::string& SceneHistory::GetUndoName() const
+    {
+        static const std::string none;
+        if (_pending && _pending->isLingering)
+        {
+            return _pending->name;
+        }
+        return _undo.empty() ? none : _undo.back().name;
+    }
+
+    const std::string& SceneHistory::GetRedoName() const
+    {
+        static const std::string none;
+        return _redo.empty() ? none : _redo.back().name;
+    }
+
+    void SceneHistory::SetMemoryBudget(size_t bytes)
+    {
+        _memoryBudget = bytes;
+        _Trim();
+    }
+
+    size_t SceneHistory::Transaction::GetMemoryUsage() const
+    {
+        return sizeof(Transaction) + name.capacity() + entities.capacity() * sizeof(EntityChange) +
+               components.capacity() * sizeof(ComponentChange) + parents.capacity() * sizeof(ParentChange) +
+               bytes.capacity();
+    }
+
+    void SceneHistory::_Record(GameObject gameObject, bool withChildren, bool isCreated)
+    {
+        if (!_pending || _pending->isLingering || !gameObject.IsValid())
+        {
+            FT_ENGINE_ASSERT(_pending && !_pending->isLingering, "SceneHistory::Record called outside a transaction");
+            return;
+        }
+
+        auto& registry = _scene->GetRegistry();
+
+        std::vector<entt::entity> entities = { gameObject.GetHandle() };
+        for (size_t i = 0; withChildren && i < entities.size(); ++i)
+        {
+            if (auto* relationship = registry.try_get<Relationship>(entities[i]))
+            {
+                for (auto child = relationship->firstChild; child != entt::null;)
+                {
+                    entities.push_back(child);
+                    child = registry.get<Relationship>(child).nextSibling;
+                }
+            }
+        }
+
+        for (entt::entity entity : entities)
+        {
+            auto* id = registry.try_get<EntityID>(entity);
+            if (!id)
+            {
+                continue;
+            }
+
+            uint32_t index = static_cast<uint32_t>(_pending->before.entities.size());
+            if (!_pending->recorded.try_emplace(id->guid, index).second)
+            {
+                continue;
+            }
+
+            // A created entity did not exist before, its handle is kept to find it when the transaction ends
+            _Capture(_pending->before, isCreated ? GameObject{} : GameObject(entity, _scene), id->guid);
+            _pending->before.entities.back().handle = entity;
+        }
+    }
+
+    void SceneHistory::_Capture(Capture& capture, GameObject gameObject, uint64_t guid)
+    {
+        CapturedEntity& entity = capture.entities.emplace_back();
+        entity.handle = gameObject.GetHandle();
+        entity.guid = guid;
+        entity.parentGuid = 0;
+        entity.exists = static_cast<bool>(gameObject);
+        entity.isActive = true;
+        entity.firstComponent = static_cast<uint32_t>(capture.components.size());
+        entity.componentCount = 0;
+
+        if (!entity.exists)
+        {
+            return;
+        }
+
+        auto& registry = _scene->GetRegistry();
+        entity.isActive = gameObject.IsActive();
+        auto* relationship = registry.try_get<Relationship>(gameObject.GetHandle());
+        if (relationship && relationship->parent != entt::null)
+        {
+            if (auto* parentId = registry.try_get<EntityID>(relationship->parent))
+            {
+                entity.parentGuid = parentId->guid;
+            }
+        }
+
+        for (const auto& serializer : SerializationSystem::GetAllSerializers())
+        {
+            // The hierarchy is restored from the parent GUID, the handles it holds do not survive
+            if (serializer.Name == "Relationship" || !serializer.HasComponent(gameObject))
+            {
+                continue;
+            }
+
+            capture.components.push_back({ &serializer, static_cast<uint32_t>(capture.segments.size()) });
+            ++entity.componentCount;
+
+            if (!serializer.SerializeBinaryFields)
+            {
+                capture.segments.push_back(static_cast<uint32_t>(capture.stream.tellp()));
+                serializer.SerializeBinary(capture.stream, gameObject);
+                continue;
+            }
+
+            for (uint32_t field = 0; field < serializer.FieldCount; ++field)
+            {
+                capture.segments.push_back(static_cast<uint32_t>(capture.stream.tellp()));
+                serializer.SerializeBinaryFields(capture.stream, gameObject, uint64_t{ 1 } << field);
+            }
+        }
+    }
+
+    void SceneHistory::_Finalize()
+    {
+        std::unique_ptr<PendingTransaction> pending = std::move(_pending);
+        const Capture& before = pending->before;
+
+        Capture after;
+        auto& registry = _scene->GetRegistry();
+        for (const CapturedEntity& entity : before.entities)
+        {
+            auto* id = registry.valid(entity.handle) ? registry.try_get<EntityID>(entity.handle) : nullptr;
+            bool isAlive = id && id->guid == entity.guid;
+            _Capture(after, isAlive ? GameObject(entity.handle, _scene) : GameObject{}, entity.guid);
+        }
+
+        std::string_view beforeBytes = before.stream.view();
+        std::string_view afterBytes = after.stream.view();
+        auto segmentOf = [](const Capture& capture, std::string_view bytes, uint32_t segment)
+        {
+            uint32_t begin = capture.segments[segment];
+            uint32_t end = segment + 1 < capture.segments.size() ? capture.segments[segment + 1]
+                                                                 : static_cast<uint32_t>(bytes.size());
+            return bytes.substr(begin, end - begin);
+        };
+        auto findComponent = [](const Capture& capture, const CapturedEntity& entity, const ComponentSerializer* s)
+        {
+            for (uint32_t i = entity.firstComponent; i < entity.firstComponent + entity.componentCount; ++i)
+            {
+                if (capture.components[i].serializer == s)
+                {
+                    return &capture.components[i];
+                }
+            }
+            return static_cast<const CapturedComponent*>(nullptr);
+        };
+
+        Transaction transaction;
+        transaction.name = std::move(pending->name);
+
+        std::vector<const ComponentSerializer*> serializers;
+        for (size_t i = 0; i < before.entities.size(); ++i)
+        {
+            const CapturedEntity& entityBefore = before.entities[i];
+            const CapturedEntity& entityAfter = after.entities[i];
+            if (!entityBefore.exists && !entityAfter.exists)
+            {
+                continue;
+            }
+
+            // Components present on either side
+            serializers.clear();
+            for (uint32_t c = 0; c < entityBefore.componentCount; ++c)
+            {
+                serializers.push_back(before.components[entityBefore.firstComponent + c].serializer);
+            }
+            for (uint32_t c = 0; c < entityAfter.componentCount; ++c)
+            {
+                const ComponentSerializer* serializer = after.components[entityAfter.firstComponent + c].serializer;
+                if (!findComponent(before, entityBefore, serializer))
+                {
+                    serializers.push_back(serializer);
+                }
+            }
+
+            uint32_t componentCount = 0;
+            for (const ComponentSerializer* serializer : serializers)
+            {
+                const CapturedComponent* componentBefore = findComponent(before, entityBefore, serializer);
+                const CapturedComponent* componentAfter = findComponent(after, entityAfter, serializer);
+                uint32_t segmentCount = SegmentCount(*serializer);
+
+                uint64_t mask = AllFields(segmentCount);
+                if (componentBefore && componentAfter)
+                {
+                    mask = 0;
+                    for (uint32_t s = 0; s < segmentCount; ++s)
+                    {
+                        if (segmentOf(before, beforeBytes, componentBefore->firstSegment + s) !=
+                            segmentOf(after, afterBytes, componentAfter->firstSegment + s))
+                        {
+                            mask |= uint64_t{ 1 } << s;
+                        }
+                    }
+
+                    if (mask == 0)
+                    {
+                        continue;
+                    }
+                }
+
+                ComponentChange change = {
+                    serializer, mask, 0, 0, componentBefore != nullptr, componentAfter != nullptr
+                };
+                auto appendSegments = [&](const Capture& capture, std::string_view bytes, const CapturedComponent* c)
+                {
+                    size_t start = transaction.bytes.size();
+                    for (uint32_t s = 0; c && s < segmentCount; ++s)
+                    {
+                        if (mask & (uint64_t{ 1 } << s))
+                        {
+                            transaction.bytes += segmentOf(capture, bytes, c->firstSegment + s);
+                        }
+                    }
+                    return static_cast<uint32_t>(transaction.bytes.size() - start);
+                };
+                change.beforeSize = appendSegments(before, beforeBytes, componentBefore);
+                change.afterSize = appendSegments(after, afterBytes, componentAfter);
+
+                transaction.components.push_back(change);
+                ++componentCount;
+            }
+
+            bool isActivationChanged =
+                entityBefore.exists && entityAfter.exists && entityBefore.isActive != entityAfter.isActive;
+            bool isParentChanged = entityBefore.parentGuid != entityAfter.parentGuid;
+            if (componentCount == 0 && entityBefore.exists == entityAfter.exists && !isActivationChanged &&
+                !isParentChanged)
+            {
+                continue;
+            }
+
+            transaction.entities.push_back({ .guid = entityBefore.guid,
+                                             .componentCount = componentCount,
+                                             .existedBefore = entityBefore.exists,
+                                             .existsAfter = entityAfter.exists,
+                                             .wasActive = entityBefore.isActive,
+                                             .isActive = entityAfter.isActive });
+
+            if (isParentChanged)
+            {
+                transaction.parents.push_back({ entityBefore.guid, entityBefore.parentGuid, entityAfter.parentGuid });
+            }
+        }
+
+        // Recorded entities left as they were
+        if (transaction.entities.empty())
+        {
+            return;
+        }
+
+        transaction.entities.shrink_to_fit();
+        transaction.components.shrink_to_fit();
+        transaction.parents.shrink_to_fit();
+        transaction.bytes.shrink_to_fit();
+
+        for (const Transaction& redone : _redo)
+        {
+            _memoryUsage -= redone.GetMemoryUsage();
+        }
+        _redo.clear();
+
+        _memoryUsage += transaction.GetMemoryUsage();
+        _undo.push_back(std::move(transaction));
+        _Trim();
+    }
+
+    void SceneHistory::_Apply(const Transaction& transaction, bool isRedo)
+    {
+        auto& registry = _scene->GetRegistry();
+
+        std::unordered_map<uint64_t, entt::entity> entities;
+        for (auto [entity, id] : registry.view<EntityID>().each())
+        {
+            entities.emplace(id.guid, entity);
+        }
+
+        auto find = [&](uint64_t guid)
+        {
+            auto it = entities.find(guid);
+            return it != entities.end() ? GameObject(it->second, _scene) : GameObject{};
+        };
+
+        std::vector<GameObject> touched;
+        std::vector<GameObject> destroyed;
+        size_t componentIndex = 0;
+        size_t byteOffset = 0;
+
+        for (const EntityChange& change : transaction.entities)
+        {
+            GameObject gameObject = find(change.guid);
+            if (!(isRedo ? change.existsAfter : change.existedBefore))
+            {
+                if (gameObject)
+                {
+                    destroyed.push_back(gameObject);
+                }
+
+                for (uint32_t i = 0; i < change.componentCount; ++i)
+                {
+                    const ComponentChange& component = transaction.components[componentIndex++];
+                    byteOffset += component.beforeSize + component.afterSize;
+                }
+                continue;
+            }
+
+            if (!gameObject)
+            {
+                gameObject = _scene->CreateGameObject();
+                gameObject.GetComponent<EntityID>().guid = change.guid;
+                entities[change.guid] = gameObject.GetHandle();
+            }
+
+            for (uint32_t i = 0; i < change.componentCount; ++i)
+            {
+                const ComponentChange& component = transaction.components[componentIndex++];
+                const ComponentSerializer& serializer = *component.serializer;
+
+                size_t offset = byteOffset + (isRedo ? component.beforeSize : 0);
+                uint32_t size = isRedo ? component.afterSize : component.beforeSize;
+                byteOffset += component.beforeSize + component.afterSize;
+
+                if (!(isRedo ? component.presentAfter : component.presentBefore))
+                {
+                    if (serializer.HasComponent(gameObject))
+                    {
+                        serializer.RemoveComponent(gameObject);
+                    }
+                    continue;
+                }
+
+                serializer.AddComponent(gameObject);
+
+                std::ispanstream in(std::span<const char>(transaction.bytes.data() + offset, size));
+                if (serializer.DeserializeBinaryFields)
+                {
+                    serializer.DeserializeBinaryFields(in, gameObject, component.mask);
+                }
+                else
+                {
+                    serializer.DeserializeBinary(in, gameObject);
+                }
+                serializer.PatchComponent(gameObject);
+            }
+
+            bool isActive = isRedo ? change.isActive : change.wasActive;
+            if (gameObject.IsActive() != isActive)
+            {
+                gameObject.SetActive(isActive);
+            }
+
+            touched.push_back(gameObject);
+        }
+
+        // Every entity exists at this point, so a parent created by this transaction can be found
+        for (const ParentChange& change : transaction.parents)
+        {
+            GameObject gameObject = find(change.guid);
+            uint64_t parentGuid = isRedo ? change.after : change.before;
+            if (gameObject)
+            {
+                gameObject.SetParent(parentGuid != 0 ? find(parentGuid) : GameObject{});
+            }
+        }
+
+        _scene->DestroyGameObjects(destroyed);
+
+        if (auto* physicSystem = _scene->GetSystem<PhysicSystem>())
+        {
+            for (GameObject gameObject : touched)
+            {
+                if (registry.valid(gameObject.GetHandle()) && gameObject.HasComponent<RigidBody>())
+                {
+                    physicSystem->NotifyRigidBodyUpdate(*_scene, gameObject);
+                }
+            }
+        }
+    }
+
+    void SceneHistory::_Trim()
+    {
+        // The latest entry is kept whatever its size, so the last operation can always be undone
+        while (_memoryUsage > _memoryBudget && _undo.size() > 1)
+        {
+            _memoryUsage -= _undo.front().GetMemoryUsage();
+            _undo.pop_front();
+        }
+    }
+} // namespace Frost
@@ -0,0 +1,155 @@
+#pragma once
+
+#include "Frost/Core/Core.h"
+#include "Frost/Scene/ECS/GameObject.h"
+
+#include <entt/entt.hpp>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace Frost
+{
+    class Scene;
+    struct ComponentSerializer;
+
+    // Undo and redo of editor operations. A transaction records the entities it is about to touch, and when it ends
+    // only what differs from that recorded state is kept: the binary bytes of the changed fields of reflected
+    // components, whole components otherwise, and the parent, presence and activation of the entity. Entities are
+    // referenced by their EntityID, so a record still applies after the entity was destroyed and recreated.
+    //
+    // A transaction ended with keepOpen and a merge key is resumed by the next one with the same key, so a drag over
+    // many frames becomes a single entry. The oldest entries are dropped once the history exceeds its memory budget.
+    class FROST_API SceneHistory
+    {
+    public:
+        static constexpr size_t DEFAULT_MEMORY_BUDGET = 64ull * 1024 * 1024;
+
+        explicit SceneHistory(Scene* scene);
+        ~SceneHistory();
+
+        SceneHistory(const SceneHistory&) = delete;
+        SceneHistory& operator=(const SceneHistory&) = delete;
+
+        // Nested transactions join the outer one
+        void BeginTransaction(std::string name, uint64_t mergeKey = 0);
+        void EndTransaction(bool keepOpen = false);
+        bool IsRecording() const { return _depth > 0; }
+
+        // Before changing or destroying an entity. An entity keeps the state it had when first recorded.
+        void Record(GameObject gameObject, bool withChildren = false);
+        // After creating an entity
+        void RecordCreated(GameObject gameObject, bool withChildren = false);
+
+        bool CanUndo() const;
+        bool CanRedo() const;
+        bool Undo();
+        bool Redo();
+        void Clear();
+
+        const std::string& GetUndoName() const;
+        const std::string& GetRedoName() const;
+
+        void SetMemoryBudget(size_t bytes);
+        size_t GetMemoryBudget() const { return _memoryBudget; }
+        size_t GetMemoryUsage() const { return _memoryUsage; }
+
+    private:
+        // Components of the recorded entities, each made of byte ranges of the stream: one per field of reflected
+        // components, one for the whole component otherwise
+        struct CapturedComponent
+        {
+            const ComponentSerializer* serializer;
+            uint32_t firstSegment;
+        };
+
+        struct CapturedEntity
+        {
+            entt::entity handle;
+            uint64_t guid;
+            uint64_t parentGuid;
+            bool exists;
+            bool isActive;
+            uint32_t firstComponent;
+            uint32_t componentCount;
+        };
+
+        struct Capture
+        {
+            std::ostringstream stream;
+            std::vector<uint32_t> segments;
+            std::vector<CapturedComponent> components;
+            std::vector<CapturedEntity> entities;
+        };
+
+        struct PendingTransaction
+        {
+            std::string name;
+            uint64_t mergeKey;
+            bool isLingering = false;
+            Capture before;
+            std::unordered_map<uint64_t, uint32_t> recorded;
+        };
+
+        struct EntityChange
+        {
+            uint64_t guid;
+            uint32_t componentCount;
+            bool existedBefore : 1;
+            bool existsAfter : 1;
+            bool wasActive : 1;
+            bool isActive : 1;
+        };
+
+        // The bytes of the masked fields before, then after, follow the bytes of the previous change
+        struct ComponentChange
+        {
+            const ComponentSerializer* serializer;
+            uint64_t mask;
+            uint32_t beforeSize;
+            uint32_t afterSize;
+            bool presentBefore;
+            bool presentAfter;
+        };
+
+        struct ParentChange
+        {
+            uint64_t guid;
+            uint64_t before;
+            uint64_t after;
+        };
+
+        struct Transaction
+        {
+            std::string name;
+            std::vector<EntityChange> entities;
+            std::vector<ComponentChange> components;
+            std::vector<ParentChange> parents;
+            std::string bytes;
+
+            size_t GetMemoryUsage() const;
+        };
+
+        void _Record(GameObject gameObject, bool withChildren, bool isCreated);
+        void _Capture(Capture& capture, GameObject gameObject, uint64_t guid);
+        void _Finalize();
+        void _Apply(const Transaction& transaction, bool isRedo);
+        void _Trim();
+
+    private:
+        Scene* _scene = nullptr;
+
+        uint32_t _depth = 0;
+        std::unique_ptr<PendingTransaction> _pending;
+
+        std::deque<Transaction> _undo;
+        std::deque<Transaction> _redo;
+
+        size_t _memoryBudget = DEFAULT_MEMORY_BUDGET;
+        size_t _memoryUsage = 0;
+    };
+} // namespace Frost
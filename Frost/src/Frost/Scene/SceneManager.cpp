@@ -1,6 +1,7 @@
 #include "Frost/Scene/SceneManager.h"
 #include "Frost/Debugging/Logger.h"
 #include "Frost/Scene/SceneSerializer.h"
+#include "Frost/Scene/SceneStreamer.h"
 
 namespace Frost
 {
@@ -25,8 +26,19 @@ namespace Frost
 
         SceneSerializer serializer(newScene.get());
 
-        if (serializer.Deserialize(filepath))
+        // A scene split by the asset compiler only loads what is never streamed, the cells follow around the camera
+        std::filesystem::path cellsDirectory = SceneStreamer::GetCellsDirectory(filepath);
+        bool streamed = SceneStreamer::HasCells(cellsDirectory, filepath);
+        std::filesystem::path loadPath = streamed ? SceneStreamer::GetResidentPath(cellsDirectory) : filepath;
+
+        if (serializer.Deserialize(loadPath))
         {
+            if (streamed && !newScene->GetStreamer().Open(cellsDirectory))
+            {
+                FT_ENGINE_ERROR("Failed to open the cells of scene file: {0}", filepath);
+                return nullptr;
+            }
+
             const std::string& sceneName = newScene->GetName();
             if (_loadedScenes.count(sceneName))
             {
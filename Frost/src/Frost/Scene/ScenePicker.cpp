@@ -0,0 +1,157 @@
+#include "Frost/Scene/ScenePicker.h"
+#include "Frost/Asset/Model.h"
+#include "Frost/Scene/Components/StaticMesh.h"
+#include "Frost/Scene/Components/WorldMatrix.h"
+#include "Frost/Scene/Scene.h"
+#include "Frost/Utils/Math/TriangleBVH.h"
+
+#include <algorithm>
+
+namespace Frost
+{
+    using namespace Frost::Math;
+
+    ScenePicker::ScenePicker(Scene* scene) : _scene{ scene } {}
+
+    std::optional<PickHit> ScenePicker::Pick(const Ray& ray,
+                                             float maxDistance,
+                                             std::span<const entt::entity> ignoredEntities)
+    {
+        _Sync();
+
+        std::optional<PickHit> closest;
+        _tree.Raycast(
+            ray,
+            maxDistance,
+            [&](uint64_t userData, float currentMax)
+            {
+                entt::entity entity = static_cast<entt::entity>(userData);
+                if (std::ranges::find(ignoredEntities, entity) != ignoredEntities.end())
+                {
+                    return currentMax;
+                }
+
+                const Entry& entry = _entries.at(entity);
+                std::shared_ptr<Model> model = entry.model.lock();
+                if (!model)
+                {
+                    return currentMax;
+                }
+
+                // The direction is not normalized in model space, so the ray parameter is the same in both spaces
+                Ray localRay = { TransformCoord(ray.origin, entry.inverseWorld),
+                                 TransformNormal(ray.direction, entry.inverseWorld) };
+                Vector3 inverseDirection = InverseDirection(localRay.direction);
+
+                const std::vector<Mesh>& meshes = model->GetMeshes();
+                for (size_t meshIndex = 0; meshIndex < meshes.size(); ++meshIndex)
+                {
+                    const Mesh& mesh = meshes[meshIndex];
+                    BoundingBox meshBounds = mesh.GetBoundingBox();
+                    float entryDistance;
+                    if (!mesh.enabled ||
+                        !IntersectRayAABB(
+                            localRay, inverseDirection, meshBounds.min, meshBounds.max, currentMax, entryDistance))
+                    {
+                        continue;
+                    }
+
+                    const TriangleBVH* bvh = model->GetTriangleBVH(meshIndex);
+                    TriangleBVH::Hit hit;
+                    if (!bvh || !bvh->Raycast(localRay, currentMax, hit))
+                    {
+                        continue;
+                    }
+
+                    // Both faces can be hit, the normal is turned towards the ray origin
+                    Matrix4x4 normalMatrix = Matrix4x4::CreateTranspose(entry.inverseWorld);
+                    Vector3 normal = Normalize(TransformNormal(hit.normal, normalMatrix));
+                    if (Dot(normal, ray.direction) > 0.0f)
+                    {
+                        normal = normal * -1.0f;
+                    }
+
+                    currentMax = hit.t;
+                    closest = PickHit{ .gameObject = GameObject(entity, _scene),
+                                       .meshIndex = static_cast<uint32_t>(meshIndex),
+                                       .triangle = hit.triangle,
+                                       .distance = hit.t,
+                                       .position = ray.origin + ray.direction * hit.t,
+                                       .normal = normal };
+                }
+
+                return currentMax;
+            });
+
+        return closest;
+    }
+
+    void ScenePicker::_Sync()
+    {
+        ++_syncIndex;
+
+        auto view = _scene->ViewActive<Component::StaticMesh, Component::WorldMatrix>();
+        for (auto [entity, staticMesh, worldMatrix] : view.each())
+        {
+            const std::shared_ptr<Model>& model = staticMesh.GetModel();
+            if (!model)
+            {
+                continue;
+            }
+
+            auto [it, isNew] = _entries.try_emplace(entity);
+            Entry& entry = it->second;
+            entry.syncIndex = _syncIndex;
+
+            bool isModelLoaded = model->HasMeshes();
+            if (!isNew && entry.matrixVersion == worldMatrix.version && entry.isModelLoaded == isModelLoaded &&
+                entry.model.lock() == model)
+            {
+                continue;
+            }
+
+            entry.model = model;
+            entry.matrixVersion = worldMatrix.version;
+            entry.isModelLoaded = isModelLoaded;
+            entry.inverseWorld = Matrix4x4::Invert(worldMatrix.matrix);
+
+            // Models still loading have no bounds yet, they enter the tree once loaded
+            if (!isModelLoaded)
+            {
+                if (entry.proxy != DynamicAABBTree::NULL_NODE)
+                {
+                    _tree.DestroyProxy(entry.proxy);
+                    entry.proxy = DynamicAABBTree::NULL_NODE;
+                }
+                continue;
+            }
+
+            BoundingBox bounds = BoundingBox::TransformAABB(model->GetBoundingBox(), LoadMatrix(worldMatrix.matrix));
+            if (entry.proxy == DynamicAABBTree::NULL_NODE)
+            {
+                entry.proxy = _tree.CreateProxy(bounds, entt::to_integral(entity));
+            }
+            else
+            {
+                _tree.MoveProxy(entry.proxy, bounds);
+            }
+        }
+
+        // Destroyed or disabled entities, and meshes that lost their model
+        std::erase_if(_entries,
+                      [&](const auto& pair)
+                      {
+                          const Entry& entry = pair.second;
+                          if (entry.syncIndex == _syncIndex)
+                          {
+                              return false;
+                          }
+
+                          if (entry.proxy != DynamicAABBTree::NULL_NODE)
+                          {
+                              _tree.DestroyProxy(entry.proxy);
+                          }
+                          return true;
+                      });
+    }
+} // namespace Frost
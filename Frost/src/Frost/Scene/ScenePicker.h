@@ -0,0 +1,70 @@
+#pragma once
+
+#include "Frost/Core/Core.h"
+#include "Frost/Scene/ECS/GameObject.h"
+#include "Frost/Utils/Math/DynamicAABBTree.h"
+#include "Frost/Utils/Math/Intersection.h"
+#include "Frost/Utils/Math/Matrix.h"
+
+#include <entt/entt.hpp>
+#include <cfloat>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <span>
+#include <unordered_map>
+
+namespace Frost
+{
+    class Model;
+    class Scene;
+
+    struct PickHit
+    {
+        GameObject gameObject;
+        // Mesh of the model and triangle of the mesh under the ray
+        uint32_t meshIndex = 0;
+        uint32_t triangle = 0;
+        float distance = 0.0f;
+        Math::Vector3 position;
+        Math::Vector3 normal;
+    };
+
+    // Ray picking against the triangles of the StaticMesh entities. A dynamic AABB tree over their world bounds finds
+    // the candidates, then the triangle BVH of each candidate mesh, built on first use and kept by its Model, gives
+    // the exact hit.
+    //
+    // The tree catches up with the scene at each pick, only the entities whose world matrix or model changed since
+    // the previous pick are moved in it.
+    class FROST_API ScenePicker
+    {
+    public:
+        explicit ScenePicker(Scene* scene);
+
+        // Closest hit before maxDistance, in units of the ray direction
+        std::optional<PickHit> Pick(const Math::Ray& ray,
+                                    float maxDistance = FLT_MAX,
+                                    std::span<const entt::entity> ignoredEntities = {});
+
+        uint32_t GetCandidateCount() const { return _tree.GetProxyCount(); }
+
+    private:
+        struct Entry
+        {
+            int32_t proxy = Math::DynamicAABBTree::NULL_NODE;
+            std::weak_ptr<Model> model;
+            Math::Matrix4x4 inverseWorld;
+            uint32_t matrixVersion = 0;
+            bool isModelLoaded = false;
+            uint32_t syncIndex = 0;
+        };
+
+        void _Sync();
+
+    private:
+        Scene* _scene = nullptr;
+        Math::DynamicAABBTree _tree;
+        std::unordered_map<entt::entity, Entry> _entries;
+        uint32_t _syncIndex = 0;
+    };
+} // namespace Frost
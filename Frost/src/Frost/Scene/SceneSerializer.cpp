@@ -3,13 +3,17 @@
 #include "Frost/Scene/PrefabSerializer.h"
 #include "Frost/Utils/SerializerUtils.h"
 #include "Frost/Debugging/Logger.h"
+#include "Frost/Scene/Components/EntityID.h"
 #include "Frost/Scene/Components/Meta.h"
 #include "Frost/Scene/Components/Relationship.h"
 #include "Frost/Scene/Components/Prefab.h"
 #include "Frost/Scene/Components/Transform.h"
 #include "Frost/Scene/Systems/ScriptableSystem.h"
 
+#include <algorithm>
 #include <fstream>
+#include <future>
+#include <sstream>
 #include <yaml-cpp/yaml.h>
 #include <unordered_map>
 
@@ -17,38 +21,52 @@ namespace Frost
 {
     SceneSerializer::SceneSerializer(Scene* scene) : m_Scene(scene) {}
 
-    bool SceneSerializer::_IsDescendantOfPrefab(GameObject go)
+    std::unordered_set<entt::entity> SceneSerializer::_CollectExcludedEntities()
     {
-        if (!go || !go.HasComponent<Component::Relationship>())
-        {
-            return false;
-        }
+        auto& registry = m_Scene->GetRegistry();
+        std::unordered_set<entt::entity> excluded;
+        std::vector<entt::entity> stack;
 
-        auto parentHandle = go.GetComponent<Component::Relationship>().parent;
-        while (parentHandle != entt::null)
-        {
-            GameObject parentGo(parentHandle, go.GetScene());
-            if (!parentGo)
+        registry.view<Component::Meta>().each(
+            [&](entt::entity entity, const Component::Meta& meta)
             {
-                break;
-            }
+                if (meta.name.rfind("__EDITOR__", 0) == 0)
+                    excluded.insert(entity);
+            });
 
-            if (parentGo.HasComponent<Component::Prefab>())
+        auto pushChildren = [&](entt::entity entity)
+        {
+            auto* relationship = registry.try_get<Component::Relationship>(entity);
+            entt::entity child = relationship ? relationship->firstChild : entt::null;
+            while (child != entt::null)
             {
-                return true;
+                stack.push_back(child);
+                child = registry.get<Component::Relationship>(child).nextSibling;
             }
+        };
 
-            if (parentGo.HasComponent<Component::Relationship>())
-            {
-                parentHandle = parentGo.GetComponent<Component::Relationship>().parent;
-            }
-            else
+        for (auto entity : registry.view<Component::Prefab>())
+        {
+            pushChildren(entity);
+        }
+
+        while (!stack.empty())
+        {
+            entt::entity entity = stack.back();
+            stack.pop_back();
+
+            if (excluded.insert(entity).second)
             {
-                break;
+                pushChildren(entity);
             }
         }
 
-        return false;
+        return excluded;
+    }
+
+    uint64_t SceneSerializer::_GetOrCreateGuid(entt::entity entity)
+    {
+        return m_Scene->GetRegistry().get_or_emplace<Component::EntityID>(entity).guid;
     }
 
     bool SceneSerializer::Serialize(const std::filesystem::path& filepath)
@@ -71,6 +89,8 @@ namespace Frost
 
     bool SceneSerializer::Deserialize(const std::filesystem::path& filepath)
     {
+        m_Scene->GetChangeTracker().WaitForCompaction();
+
         std::string extension = filepath.extension().string();
         if (extension == ".yaml" || extension == ".scene")
         {
@@ -85,33 +105,56 @@ namespace Frost
         return false;
     }
 
+    std::filesystem::path SceneSerializer::GetLatestScenePath(const std::filesystem::path& filepath)
+    {
+        std::string extension = filepath.extension().string();
+        if (extension != ".yaml" && extension != ".scene")
+            return filepath;
+
+        std::filesystem::path binaryPath = filepath;
+        binaryPath.replace_extension(".bin");
+
+        std::error_code error;
+        if (!std::filesystem::exists(binaryPath, error))
+            return filepath;
+        if (std::filesystem::exists(filepath, error) &&
+            std::filesystem::last_write_time(binaryPath, error) < std::filesystem::last_write_time(filepath, error))
+            return filepath;
+
+        return binaryPath;
+    }
+
     bool SceneSerializer::_SerializeToYaml(const std::filesystem::path& filepath)
     {
         YAML::Emitter out;
         out << YAML::BeginMap;
         out << YAML::Key << "Scene" << YAML::Value << m_Scene->GetName();
+        out << YAML::Key << "Version" << YAML::Value << YAML_VERSION;
 
         out << YAML::Key << "Entities" << YAML::Value << YAML::BeginSeq;
-        auto view = m_Scene->GetRegistry().view<entt::entity>();
-        for (auto entityID : view)
-        {
-            GameObject go(entityID, m_Scene);
-            if (!go)
-                continue;
 
-            if (auto* meta = go.TryGetComponent<Component::Meta>())
+        auto& registry = m_Scene->GetRegistry();
+        std::unordered_set<entt::entity> excluded = _CollectExcludedEntities();
+
+        // Sorted by GUID so that saving an unchanged scene produces the same file
+        std::vector<std::pair<uint64_t, entt::entity>> entities;
+        for (auto entityID : registry.view<entt::entity>())
+        {
+            if (!excluded.contains(entityID))
             {
-                if (meta->name.rfind("__EDITOR__", 0) == 0)
-                    continue;
+                entities.emplace_back(_GetOrCreateGuid(entityID), entityID);
             }
+        }
+        std::sort(entities.begin(), entities.end());
 
-            if (_IsDescendantOfPrefab(go))
-            {
+        for (const auto& [guid, entityID] : entities)
+        {
+            GameObject go(entityID, m_Scene);
+            if (!go)
                 continue;
-            }
 
             out << YAML::BeginMap;
-            out << YAML::Key << "Entity" << YAML::Value << static_cast<uint32_t>(entityID);
+            out << YAML::Key << "Entity" << YAML::Value << guid;
 
             for (const auto& serializer : SerializationSystem::GetAllSerializers())
             {
@@ -127,19 +170,16 @@ namespace Frost
                 }
             }
 
-            int32_t parentID = -1;
+            uint64_t parentGuid = 0;
             if (go.HasComponent<Component::Relationship>())
             {
                 entt::entity parentHandle = go.GetComponent<Component::Relationship>().parent;
-                if (parentHandle != entt::null)
+                if (parentHandle != entt::null && !excluded.contains(parentHandle))
                 {
-                    if (!_IsDescendantOfPrefab(GameObject(parentHandle, m_Scene)))
-                    {
-                        parentID = static_cast<int32_t>(parentHandle);
-                    }
+                    parentGuid = _GetOrCreateGuid(parentHandle);
                 }
             }
-            out << YAML::Key << "Parent" << YAML::Value << parentID;
+            out << YAML::Key << "Parent" << YAML::Value << parentGuid;
             out << YAML::EndMap;
         }
         out << YAML::EndSeq;
@@ -182,19 +222,24 @@ namespace Frost
         if (entities)
         {
             m_Scene->Clear();
-            std::unordered_map<uint32_t, entt::entity> entityMap;
+
+            // Files without a version stored the entt handle under "Entity" and -1 as "no parent". Handle 0 would
+            // read as the "no parent" GUID, so their entities keep a fresh GUID and parents go through the handles
+            const bool hasGuids = data["Version"].IsDefined();
+            std::unordered_map<uint64_t, entt::entity> entityMap; // file id -> new entity
 
             for (auto entityNode : entities)
             {
-                uint32_t oldID = entityNode["Entity"].as<uint32_t>();
+                uint64_t fileId = entityNode["Entity"].as<uint64_t>();
                 GameObject newGo = m_Scene->CreateGameObject("TempName");
-                entityMap[oldID] = newGo.GetHandle();
+                if (hasGuids)
+                    newGo.GetComponent<Component::EntityID>().guid = fileId;
+                entityMap[fileId] = newGo.GetHandle();
             }
 
             for (auto entityNode : entities)
             {
-                uint32_t oldID = entityNode["Entity"].as<uint32_t>();
-                GameObject go(entityMap.at(oldID), m_Scene);
+                GameObject go(entityMap.at(entityNode["Entity"].as<uint64_t>()), m_Scene);
 
                 for (const auto& serializer : SerializationSystem::GetAllSerializers())
                 {
@@ -212,15 +257,17 @@ namespace Frost
 
             for (auto entityNode : entities)
             {
-                uint32_t oldID = entityNode["Entity"].as<uint32_t>();
-                int32_t parentID = entityNode["Parent"].as<int32_t>(-1);
+                uint64_t fileId = entityNode["Entity"].as<uint64_t>();
+                int64_t parentId = entityNode["Parent"].as<int64_t>(-1);
 
-                if (parentID != -1)
+                const bool hasParent = hasGuids ? parentId > 0 : parentId >= 0;
+                if (hasParent)
                 {
-                    GameObject childGo(entityMap.at(oldID), m_Scene);
-                    if (entityMap.count(static_cast<uint32_t>(parentID)))
+                    GameObject childGo(entityMap.at(fileId), m_Scene);
+                    auto it = entityMap.find(static_cast<uint64_t>(parentId));
+                    if (it != entityMap.end())
                     {
-                        GameObject parentGo(entityMap.at(static_cast<uint32_t>(parentID)), m_Scene);
+                        GameObject parentGo(it->second, m_Scene);
                         childGo.SetParent(parentGo);
                     }
                 }
@@ -261,80 +308,273 @@ namespace Frost
             }
         }
 
+        // The YAML file is not the chunked binary file, the next binary save is a full one
+        m_Scene->GetChangeTracker().Reset();
+
         return true;
     }
 
     bool SceneSerializer::_SerializeToBinary(const std::filesystem::path& filepath)
     {
-        std::ofstream out(filepath, std::ios::binary);
-        if (!out.is_open())
+        SceneChangeTracker& tracker = m_Scene->GetChangeTracker();
+        tracker.WaitForCompaction();
+
+        if (tracker.IsSyncedWith(filepath))
         {
-            FT_ENGINE_CRITICAL("Failed to open file for writing: {}", filepath.string());
-            return false;
+            return _AppendToBinary(filepath);
         }
 
-        const char header[] = "FROST_SCENE_BIN";
-        out.write(header, sizeof(header) - 1);
-        WriteBinaryString(out, m_Scene->GetName());
+        std::filesystem::path tempFile = filepath;
+        tempFile += ".tmp";
+
+        std::unordered_set<entt::entity> excluded = _CollectExcludedEntities();
+        uint32_t chunkCount = 0;
 
-        std::vector<entt::entity> entitiesToSerialize;
-        auto allEntitiesView = m_Scene->GetRegistry().view<entt::entity>();
-        for (auto entity : allEntitiesView)
         {
-            GameObject go(entity, m_Scene);
-            if (auto* meta = go.TryGetComponent<Component::Meta>())
+            std::ofstream out(tempFile, std::ios::binary | std::ios::trunc);
+            if (!out.is_open())
             {
-                if (meta->name.rfind("__EDITOR__", 0) == 0)
-                    continue;
+                FT_ENGINE_CRITICAL("Failed to open file for writing: {}", tempFile.string());
+                return false;
             }
 
-            if (_IsDescendantOfPrefab(go))
+            WriteBinary(out, SCENE_MAGIC);
+            WriteBinary(out, SCENE_VERSION);
+            WriteBinaryString(out, m_Scene->GetName());
+
+            for (auto entity : m_Scene->GetRegistry().view<entt::entity>())
             {
-                continue;
+                if (excluded.contains(entity))
+                    continue;
+
+                _WriteEntityChunk(out, GameObject(entity, m_Scene), excluded);
+                ++chunkCount;
             }
+        }
+
+        std::error_code ec;
+        std::filesystem::rename(tempFile, filepath, ec);
+        if (ec)
+        {
+            FT_ENGINE_ERROR("Failed to replace scene file {}: {}", filepath.string(), ec.message());
+            return false;
+        }
+
+        tracker.MarkSynced(filepath, chunkCount);
+        return true;
+    }
 
-            entitiesToSerialize.push_back(entity);
+    bool SceneSerializer::_AppendToBinary(const std::filesystem::path& filepath)
+    {
+        SceneChangeTracker& tracker = m_Scene->GetChangeTracker();
+        auto& registry = m_Scene->GetRegistry();
+
+        std::ofstream out(filepath, std::ios::binary | std::ios::app);
+        if (!out.is_open())
+        {
+            FT_ENGINE_CRITICAL("Failed to open file for writing: {}", filepath.string());
+            return false;
         }
 
-        uint32_t count = static_cast<uint32_t>(entitiesToSerialize.size());
-        out.write(reinterpret_cast<const char*>(&count), sizeof(uint32_t));
+        std::unordered_set<entt::entity> excluded = _CollectExcludedEntities();
+        uint32_t chunkCount = tracker.GetRecordCount();
 
-        for (auto& entity : entitiesToSerialize)
+        for (uint64_t guid : tracker.GetDestroyedGuids())
         {
-            GameObject go(entity, m_Scene);
-            uint32_t entityId = static_cast<uint32_t>(entity);
-            out.write(reinterpret_cast<const char*>(&entityId), sizeof(uint32_t));
+            _WriteChunk(out, ChunkType::Tombstone, guid, {});
+            ++chunkCount;
+        }
 
-            int32_t parentId = -1;
-            if (go.HasComponent<Component::Relationship>())
+        for (auto entity : tracker.GetDirtyEntities())
+        {
+            if (!registry.valid(entity))
+                continue;
+
+            if (excluded.contains(entity))
             {
-                auto parentHandle = go.GetComponent<Component::Relationship>().parent;
-                if (parentHandle != entt::null)
+                // It may have been saved before it was parented under a prefab or renamed
+                if (auto* entityID = registry.try_get<Component::EntityID>(entity))
                 {
-                    parentId = static_cast<int32_t>(parentHandle);
+                    _WriteChunk(out, ChunkType::Tombstone, entityID->guid, {});
+                    ++chunkCount;
                 }
+                continue;
             }
-            out.write(reinterpret_cast<const char*>(&parentId), sizeof(int32_t));
 
-            for (const auto& serializer : SerializationSystem::GetAllSerializers())
+            _WriteEntityChunk(out, GameObject(entity, m_Scene), excluded);
+            ++chunkCount;
+        }
+
+        out.close();
+        if (out.fail())
+        {
+            FT_ENGINE_ERROR("Failed to append to scene file: {}", filepath.string());
+            return false;
+        }
+
+        uint32_t liveCount = static_cast<uint32_t>(registry.storage<Component::EntityID>().size());
+        if (chunkCount > liveCount * 2 + COMPACTION_SLACK)
+        {
+            tracker.MarkSynced(filepath, liveCount);
+            tracker.SetPendingCompaction(std::async(std::launch::async, [filepath]() { CompactBinary(filepath); }));
+        }
+        else
+        {
+            tracker.MarkSynced(filepath, chunkCount);
+        }
+
+        return true;
+    }
+
+    bool SceneSerializer::CompactBinary(const std::filesystem::path& filepath)
+    {
+        std::string sceneName;
+        std::vector<Chunk> chunks;
+
+        {
+            std::ifstream in(filepath, std::ios::binary);
+            uint32_t magic = 0;
+            uint32_t version = 0;
+            ReadBinary(in, magic);
+            ReadBinary(in, version);
+            if (!in || magic != SCENE_MAGIC || version != SCENE_VERSION)
             {
-                if (serializer.Name == "Relationship")
-                    continue;
+                FT_ENGINE_WARN("Cannot compact {}: not a chunked scene file", filepath.string());
+                return false;
+            }
 
-                if (serializer.HasComponent(go))
-                {
-                    out.write(reinterpret_cast<const char*>(&serializer.ID), sizeof(uint32_t));
-                    serializer.SerializeBinary(out, go);
-                }
+            sceneName = ReadBinaryString(in);
+            _ReadChunks(in, chunks);
+        }
+
+        std::filesystem::path tempFile = filepath;
+        tempFile += ".tmp";
+
+        {
+            std::ofstream out(tempFile, std::ios::binary | std::ios::trunc);
+            if (!out.is_open())
+            {
+                FT_ENGINE_WARN("Cannot compact {}: failed to open {}", filepath.string(), tempFile.string());
+                return false;
+            }
+
+            WriteBinary(out, SCENE_MAGIC);
+            WriteBinary(out, SCENE_VERSION);
+            WriteBinaryString(out, sceneName);
+
+            for (const auto& chunk : chunks)
+            {
+                _WriteChunk(out, ChunkType::Entity, chunk.guid, chunk.payload);
             }
-            uint32_t endMarker = 0;
-            out.write(reinterpret_cast<const char*>(&endMarker), sizeof(uint32_t));
         }
 
-        out.close();
+        std::error_code ec;
+        std::filesystem::rename(tempFile, filepath, ec);
+        if (ec)
+        {
+            FT_ENGINE_WARN("Cannot compact {}: {}", filepath.string(), ec.message());
+            return false;
+        }
+
         return true;
     }
 
+    void SceneSerializer::_WriteEntityChunk(std::ostream& out,
+                                            GameObject go,
+                                            const std::unordered_set<entt::entity>& excluded)
+    {
+        std::ostringstream payload(std::ios::binary);
+
+        uint64_t parentGuid = 0;
+        if (auto* relationship = go.TryGetComponent<Component::Relationship>())
+        {
+            if (relationship->parent != entt::null && !excluded.contains(relationship->parent))
+            {
+                parentGuid = _GetOrCreateGuid(relationship->parent);
+            }
+        }
+        WriteBinary(payload, parentGuid);
+
+        for (const auto& serializer : SerializationSystem::GetAllSerializers())
+        {
+            if (serializer.Name == "Relationship")
+                continue;
+
+            if (serializer.HasComponent(go))
+            {
+                WriteBinary(payload, serializer.ID);
+                serializer.SerializeBinary(payload, go);
+            }
+        }
+
+        uint32_t endMarker = 0;
+        WriteBinary(payload, endMarker);
+
+        _WriteChunk(out, ChunkType::Entity, _GetOrCreateGuid(go.GetHandle()), payload.str());
+    }
+
+    void SceneSerializer::_WriteChunk(std::ostream& out, ChunkType type, uint64_t guid, const std::string& payload)
+    {
+        WriteBinary(out, type);
+        WriteBinary(out, guid);
+        WriteBinary(out, static_cast<uint32_t>(payload.size()));
+        out.write(payload.data(), payload.size());
+    }
+
+    uint32_t SceneSerializer::_ReadChunks(std::istream& in, std::vector<Chunk>& outChunks)
+    {
+        std::vector<Chunk> chunks;
+        std::vector<bool> removed;
+        std::unordered_map<uint64_t, size_t> indices;
+        uint32_t rawCount = 0;
+
+        while (true)
+        {
+            ChunkType type;
+            uint64_t guid = 0;
+            uint32_t size = 0;
+
+            ReadBinary(in, type);
+            ReadBinary(in, guid);
+            ReadBinary(in, size);
+            if (!in)
+                break;
+
+            std::string payload(size, '\0');
+            in.read(payload.data(), size);
+            if (!in)
+            {
+                // An append that was interrupted, everything before it is still valid
+                FT_ENGINE_WARN("Scene file ends with a truncated chunk, it is ignored");
+                break;
+            }
+
+            ++rawCount;
+
+            auto [it, inserted] = indices.try_emplace(guid, chunks.size());
+            if (inserted)
+            {
+                chunks.push_back({ guid, {} });
+                removed.push_back(false);
+            }
+
+            chunks[it->second].payload = std::move(payload);
+            removed[it->second] = type == ChunkType::Tombstone;
+        }
+
+        outChunks.clear();
+        outChunks.reserve(chunks.size());
+        for (size_t i = 0; i < chunks.size(); ++i)
+        {
+            if (!removed[i])
+            {
+                outChunks.push_back(std::move(chunks[i]));
+            }
+        }
+
+        return rawCount;
+    }
+
     bool SceneSerializer::_DeserializeFromBinary(const std::filesystem::path& filepath)
     {
         // Print absolute path for debugging
@@ -348,6 +588,194 @@ namespace Frost
             return false;
         }
 
+        uint32_t magic = 0;
+        ReadBinary(in, magic);
+        if (magic != SCENE_MAGIC)
+        {
+            in.clear();
+            in.seekg(0);
+            bool loaded = _DeserializeFromLegacyBinary(in);
+
+            // The next save rewrites the file in the chunked format
+            m_Scene->GetChangeTracker().Reset();
+            return loaded;
+        }
+
+        uint32_t version = 0;
+        ReadBinary(in, version);
+        if (version != SCENE_VERSION)
+        {
+            FT_ENGINE_ERROR("Unsupported scene file version {0}: {1}", version, filepath.string());
+            return false;
+        }
+
+        m_Scene->SetName(ReadBinaryString(in));
+
+        std::vector<Chunk> chunks;
+        uint32_t rawCount = _ReadChunks(in, chunks);
+
+        m_Scene->Clear();
+
+        std::unordered_map<uint64_t, entt::entity> entityMap;
+        for (const auto& chunk : chunks)
+        {
+            GameObject newGo = m_Scene->CreateGameObject("TempName");
+            newGo.GetComponent<Component::EntityID>().guid = chunk.guid;
+            entityMap[chunk.guid] = newGo.GetHandle();
+        }
+
+        std::vector<std::pair<entt::entity, uint64_t>> parentChildMap; // {child, parent_guid}
+        for (const auto& chunk : chunks)
+        {
+            GameObject go(entityMap.at(chunk.guid), m_Scene);
+
+            uint64_t parentGuid = _ReadEntityChunk(chunk, go);
+            if (parentGuid != 0)
+                parentChildMap.push_back({ go.GetHandle(), parentGuid });
+        }
+
+        for (const auto& [child, parentGuid] : parentChildMap)
+        {
+            auto it = entityMap.find(parentGuid);
+            if (it != entityMap.end())
+            {
+                GameObject(child, m_Scene).SetParent(GameObject(it->second, m_Scene));
+            }
+            else
+            {
+                FT_ENGINE_WARN("Parent entity {0} not found for child {1}.",
+                               parentGuid,
+                               m_Scene->GetRegistry().get<Component::EntityID>(child).guid);
+            }
+        }
+
+        _InstantiateBinaryPrefabs();
+
+        if (auto* scriptSystem = m_Scene->GetSystem<ScriptableSystem>())
+        {
+            scriptSystem->OnScriptsReloaded();
+        }
+
+        m_Scene->GetChangeTracker().MarkSynced(filepath, rawCount);
+        return true;
+    }
+
+    uint64_t SceneSerializer::_ReadEntityChunk(const Chunk& chunk, GameObject go)
+    {
+        std::istringstream payload(chunk.payload, std::ios::binary);
+
+        uint64_t parentGuid = 0;
+        ReadBinary(payload, parentGuid);
+
+        while (true)
+        {
+            uint32_t componentID = 0;
+            ReadBinary(payload, componentID);
+            if (componentID == 0 || !payload)
+                break;
+
+            auto* serializer = SerializationSystem::GetSerializerByID(componentID);
+            if (!serializer)
+            {
+                // The chunk size lets the rest of the scene load, only this entity is incomplete
+                FT_ENGINE_ERROR("Unknown component ID {0} in scene file, skipping the rest of entity {1}.",
+                                componentID,
+                                chunk.guid);
+                break;
+            }
+
+            if (!serializer->HasComponent(go))
+                serializer->AddComponent(go);
+            serializer->DeserializeBinary(payload, go);
+        }
+
+        return parentGuid;
+    }
+
+    bool SceneSerializer::SerializeHierarchies(const std::filesystem::path& filepath,
+                                               std::span<const entt::entity> roots)
+    {
+        auto& registry = m_Scene->GetRegistry();
+        std::unordered_set<entt::entity> excluded = _CollectExcludedEntities();
+
+        std::ofstream out(filepath, std::ios::binary | std::ios::trunc);
+        if (!out.is_open())
+        {
+            FT_ENGINE_ERROR("Failed to open file for writing: {}", filepath.string());
+            return false;
+        }
+
+        WriteBinary(out, SCENE_MAGIC);
+        WriteBinary(out, SCENE_VERSION);
+        WriteBinaryString(out, m_Scene->GetName());
+
+        // Parents are written before their children
+        std::vector<entt::entity> stack(roots.rbegin(), roots.rend());
+        while (!stack.empty())
+        {
+            entt::entity entity = stack.back();
+            stack.pop_back();
+
+            if (!registry.valid(entity) || excluded.contains(entity))
+                continue;
+
+            _WriteEntityChunk(out, GameObject(entity, m_Scene), excluded);
+
+            auto* relationship = registry.try_get<Component::Relationship>(entity);
+            entt::entity child = relationship ? relationship->firstChild : entt::null;
+            while (child != entt::null)
+            {
+                stack.push_back(child);
+                child = registry.get<Component::Relationship>(child).nextSibling;
+            }
+        }
+
+        out.close();
+        if (out.fail())
+        {
+            FT_ENGINE_ERROR("Failed to write scene file: {}", filepath.string());
+            return false;
+        }
+
+        return true;
+    }
+
+    bool SceneSerializer::DeserializeDetached(const std::filesystem::path& filepath,
+                                              entt::registry& registry,
+                                              std::vector<DetachedEntity>& outEntities)
+    {
+        std::ifstream in(filepath, std::ios::binary);
+        uint32_t magic = 0;
+        uint32_t version = 0;
+        ReadBinary(in, magic);
+        ReadBinary(in, version);
+        if (!in || magic != SCENE_MAGIC || version != SCENE_VERSION)
+        {
+            FT_ENGINE_ERROR("Failed to read {}: not a chunked scene file", filepath.string());
+            return false;
+        }
+
+        ReadBinaryString(in);
+
+        std::vector<Chunk> chunks;
+        _ReadChunks(in, chunks);
+
+        outEntities.clear();
+        outEntities.reserve(chunks.size());
+        for (const auto& chunk : chunks)
+        {
+            entt::entity entity = registry.create();
+            registry.emplace<Component::EntityID>(entity, chunk.guid);
+
+            uint64_t parentGuid = _ReadEntityChunk(chunk, GameObject(entity, registry));
+            outEntities.push_back({ entity, chunk.guid, parentGuid });
+        }
+
+        return true;
+    }
+
+    bool SceneSerializer::_DeserializeFromLegacyBinary(std::istream& in)
+    {
         char header[16] = { 0 };
         in.read(header, 15);
         if (std::string(header) != "FROST_SCENE_BIN")
@@ -411,6 +839,18 @@ namespace Frost
             }
         }
 
+        _InstantiateBinaryPrefabs();
+
+        if (auto* scriptSystem = m_Scene->GetSystem<ScriptableSystem>())
+        {
+            scriptSystem->OnScriptsReloaded();
+        }
+
+        return true;
+    }
+
+    void SceneSerializer::_InstantiateBinaryPrefabs()
+    {
         std::vector<entt::entity> prefabInstances;
         auto prefabView = m_Scene->GetRegistry().view<Component::Prefab>();
         for (auto entity : prefabView)
@@ -420,38 +860,33 @@ namespace Frost
 
         for (auto entityID : prefabInstances)
         {
-            GameObject placeholder(entityID, m_Scene);
-            if (!placeholder)
-                continue;
+            InstantiatePrefab(GameObject(entityID, m_Scene));
+        }
+    }
 
-            const auto& prefabComponent = placeholder.GetComponent<Component::Prefab>();
-            const auto& assetPath = prefabComponent.assetPath;
+    void SceneSerializer::InstantiatePrefab(GameObject placeholder)
+    {
+        if (!placeholder)
+            return;
 
-            if (!assetPath.empty())
-            {
-                std::filesystem::path binPath = assetPath;
-                binPath.replace_extension(".bin");
+        // Copied, instantiating may add Prefab components and move the storage
+        std::filesystem::path assetPath = placeholder.GetComponent<Component::Prefab>().assetPath;
+        if (assetPath.empty())
+            return;
 
-                GameObject prefabRoot =
-                    PrefabSerializer::Instantiate(m_Scene, std::filesystem::exists(binPath) ? binPath : assetPath);
+        std::filesystem::path binPath = assetPath;
+        binPath.replace_extension(".bin");
 
-                if (prefabRoot)
-                {
-                    prefabRoot.SetParent(placeholder);
-                }
-                else
-                {
-                    FT_ENGINE_WARN("Impossible d'instancier le prefab '{0}' pour l'entité placeholder.",
-                                   assetPath.string());
-                }
-            }
-        }
+        GameObject prefabRoot = PrefabSerializer::Instantiate(placeholder.GetScene(),
+                                                              std::filesystem::exists(binPath) ? binPath : assetPath);
 
-        if (auto* scriptSystem = m_Scene->GetSystem<ScriptableSystem>())
+        if (prefabRoot)
         {
-            scriptSystem->OnScriptsReloaded();
+            prefabRoot.SetParent(placeholder);
+        }
+        else
+        {
+            FT_ENGINE_WARN("Impossible d'instancier le prefab '{0}' pour l'entité placeholder.", assetPath.string());
         }
-
-        return true;
     }
-} // namespace Frost
\ No newline at end of file
+} // namespace Frost
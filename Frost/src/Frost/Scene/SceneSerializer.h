@@ -3,27 +3,94 @@
 #include "Frost/Core/Core.h"
 #include "Frost/Scene/Scene.h"
 
+#include <cstdint>
 #include <filesystem>
+#include <istream>
+#include <ostream>
+#include <span>
+#include <string>
+#include <unordered_set>
+#include <vector>
 
 namespace Frost
 {
     class FROST_API SceneSerializer
     {
     public:
+        // Entity read into a registry that belongs to no scene, its parent is only known by GUID
+        struct DetachedEntity
+        {
+            entt::entity entity;
+            uint64_t guid;
+            uint64_t parentGuid;
+        };
+
         SceneSerializer(Scene* scene);
 
         bool Serialize(const std::filesystem::path& filepath);
         bool Deserialize(const std::filesystem::path& filepath);
 
+        // The binary file next to a YAML scene when it was saved after the YAML file, else filepath. Editor saves
+        // only append to the binary file, the YAML file is rewritten by an explicit export
+        static std::filesystem::path GetLatestScenePath(const std::filesystem::path& filepath);
+
+        // Writes the given root entities and their children to a binary scene file, see SceneStreamer::BuildCells
+        bool SerializeHierarchies(const std::filesystem::path& filepath, std::span<const entt::entity> roots);
+
+        // Reads a binary scene file into a standalone registry. No scene, system or hierarchy is involved, so this
+        // can run on a worker thread. Prefab placeholders are read but not instantiated
+        static bool DeserializeDetached(const std::filesystem::path& filepath,
+                                        entt::registry& registry,
+                                        std::vector<DetachedEntity>& outEntities);
+
+        // Rebuilds the children of a prefab placeholder from its asset, preferring the cooked .bin next to it
+        static void InstantiatePrefab(GameObject placeholder);
+
+        // Rewrites a binary scene file keeping only the latest chunk of each live entity
+        static bool CompactBinary(const std::filesystem::path& filepath);
+
     private:
+        enum class ChunkType : uint8_t
+        {
+            Entity = 1,
+            Tombstone = 2
+        };
+
+        struct Chunk
+        {
+            uint64_t guid;
+            std::string payload;
+        };
+
         bool _SerializeToYaml(const std::filesystem::path& filepath);
         bool _DeserializeFromYaml(const std::filesystem::path& filepath);
 
         bool _SerializeToBinary(const std::filesystem::path& filepath);
+        bool _AppendToBinary(const std::filesystem::path& filepath);
         bool _DeserializeFromBinary(const std::filesystem::path& filepath);
+        bool _DeserializeFromLegacyBinary(std::istream& in);
+        void _InstantiateBinaryPrefabs();
+
+        // Editor-only objects and everything below a prefab instance, which is rebuilt from the prefab asset
+        std::unordered_set<entt::entity> _CollectExcludedEntities();
+        uint64_t _GetOrCreateGuid(entt::entity entity);
+        void _WriteEntityChunk(std::ostream& out, GameObject go, const std::unordered_set<entt::entity>& excluded);
 
-        bool _IsDescendantOfPrefab(GameObject go);
+        static void _WriteChunk(std::ostream& out, ChunkType type, uint64_t guid, const std::string& payload);
+        // Adds the components stored in an entity chunk to go, returns the GUID of its parent
+        static uint64_t _ReadEntityChunk(const Chunk& chunk, GameObject go);
+        // Replays the journal: later chunks replace earlier ones, tombstones drop them. Returns the raw chunk count
+        static uint32_t _ReadChunks(std::istream& in, std::vector<Chunk>& outChunks);
 
         Scene* m_Scene;
+
+        static constexpr uint32_t SCENE_MAGIC = 0x43535446; // "FTSC"
+        // 2: components are encoded from their Reflection::Fields
+        static constexpr uint32_t SCENE_VERSION = 2;
+        // Written in YAML files whose entities are identified by GUID
+        static constexpr uint32_t YAML_VERSION = 1;
+
+        // Compaction starts once the journal holds twice as many chunks as there are entities, plus this slack
+        static constexpr uint32_t COMPACTION_SLACK = 64;
     };
-} // namespace Frost
\ No newline at end of file
+} // namespace Frost
@@ -0,0 +1,560 @@
+#include "Frost/Scene/SceneStreamer.h"
+
+#include "Frost/Debugging/Logger.h"
+#include "Frost/Scene/Components/Camera.h"
+#include "Frost/Scene/Components/EntityID.h"
+#include "Frost/Scene/Components/Meta.h"
+#include "Frost/Scene/Components/Prefab.h"
+#include "Frost/Scene/Components/Relationship.h"
+#include "Frost/Scene/Components/StaticMesh.h"
+#include "Frost/Scene/Components/WorldCell.h"
+#include "Frost/Scene/Components/WorldMatrix.h"
+#include "Frost/Scene/Components/WorldTransform.h"
+#include "Frost/Scene/Scene.h"
+#include "Frost/Scene/SceneSerializer.h"
+#include "Frost/Scene/Serializers/SerializationSystem.h"
+#include "Frost/Scene/Systems/PhysicSystem.h"
+#include "Frost/Scene/Systems/WorldTransformSystem.h"
+#include "Frost/Utils/SerializerUtils.h"
+
+#include <algorithm>
+#include <cfloat>
+#include <chrono>
+#include <cmath>
+#include <format>
+#include <fstream>
+#include <map>
+
+namespace Frost
+{
+    struct SceneStreamer::StagedCell
+    {
+        entt::registry registry;
+        std::vector<SceneSerializer::DetachedEntity> entities;
+
+        // Indices into entities, parents before children. Hierarchy i spans order[hierarchyStarts[i]] up to
+        // order[hierarchyStarts[i + 1]]
+        std::vector<uint32_t> order;
+        std::vector<uint32_t> hierarchyStarts;
+    };
+
+    namespace
+    {
+        void CollectHierarchy(entt::registry& registry, entt::entity root, std::vector<entt::entity>& outEntities)
+        {
+            size_t first = outEntities.size();
+            outEntities.push_back(root);
+
+            for (size_t i = first; i < outEntities.size(); ++i)
+            {
+                auto* relationship = registry.try_get<Component::Relationship>(outEntities[i]);
+                entt::entity child = relationship ? relationship->firstChild : entt::null;
+                while (child != entt::null)
+                {
+                    outEntities.push_back(child);
+                    child = registry.get<Component::Relationship>(child).nextSibling;
+                }
+            }
+        }
+
+        // Loaded meshes contribute their bounds, everything else its position
+        BoundingBox ComputeHierarchyBounds(entt::registry& registry, const std::vector<entt::entity>& entities)
+        {
+            BoundingBox bounds = { { FLT_MAX, FLT_MAX, FLT_MAX }, { -FLT_MAX, -FLT_MAX, -FLT_MAX } };
+
+            for (auto entity : entities)
+            {
+                auto* worldTransform = registry.try_get<Component::WorldTransform>(entity);
+                if (!worldTransform)
+                    continue;
+
+                auto* staticMesh = registry.try_get<Component::StaticMesh>(entity);
+                auto* worldMatrix = registry.try_get<Component::WorldMatrix>(entity);
+                if (staticMesh && worldMatrix && staticMesh->GetModel() && staticMesh->GetModel()->IsLoaded())
+                {
+                    bounds.Merge(BoundingBox::TransformAABB(staticMesh->GetModel()->GetBoundingBox(),
+                                                            Math::LoadMatrix(worldMatrix->matrix)));
+                    continue;
+                }
+
+                const Math::Vector3& position = worldTransform->position;
+                bounds.Merge({ { position.x, position.y, position.z }, { position.x, position.y, position.z } });
+            }
+
+            return bounds;
+        }
+    } // namespace
+
+    SceneStreamer::SceneStreamer(Scene* scene) : _scene{ scene } {}
+
+    SceneStreamer::~SceneStreamer()
+    {
+        // Workers only touch their own registry, the scene can already be gone
+        for (auto& cell : _cells)
+        {
+            if (cell.pending.valid())
+            {
+                cell.pending.wait();
+            }
+        }
+    }
+
+    bool SceneStreamer::BuildCells(Scene& scene, const std::filesystem::path& directory, float cellSize)
+    {
+        auto& registry = scene.GetRegistry();
+
+        // The scene may never have been updated, as when it was only loaded to be cooked
+        if (auto* worldTransformSystem = scene.GetSystem<WorldTransformSystem>())
+        {
+            worldTransformSystem->PreFixedUpdate(scene, 0.0f);
+        }
+
+        struct CellBuild
+        {
+            BoundingBox bounds = { { FLT_MAX, FLT_MAX, FLT_MAX }, { -FLT_MAX, -FLT_MAX, -FLT_MAX } };
+            std::vector<entt::entity> roots;
+        };
+        std::map<std::pair<int32_t, int32_t>, CellBuild> cells;
+        std::vector<entt::entity> residentRoots;
+
+        std::vector<entt::entity> hierarchy;
+        registry.view<Component::Relationship>().each(
+            [&](entt::entity entity, const Component::Relationship& relationship)
+            {
+                if (relationship.parent != entt::null)
+                    return;
+
+                auto* meta = registry.try_get<Component::Meta>(entity);
+                if (meta && meta->name.rfind("__EDITOR__", 0) == 0)
+                    return;
+
+                hierarchy.clear();
+                CollectHierarchy(registry, entity, hierarchy);
+
+                // The focus follows the main camera, it has to stay loaded
+                auto* worldCell = registry.try_get<Component::WorldCell>(entity);
+                if (!worldCell && std::ranges::any_of(hierarchy,
+                                                      [&](entt::entity member)
+                                                      { return registry.all_of<Component::Camera>(member); }))
+                {
+                    residentRoots.push_back(entity);
+                    return;
+                }
+
+                BoundingBox bounds = ComputeHierarchyBounds(registry, hierarchy);
+
+                std::pair<int32_t, int32_t> coords = { 0, 0 };
+                if (worldCell)
+                {
+                    coords = { worldCell->x, worldCell->z };
+                }
+                else if (bounds.min.x <= bounds.max.x)
+                {
+                    coords = { static_cast<int32_t>(std::floor((bounds.min.x + bounds.max.x) * 0.5f / cellSize)),
+                               static_cast<int32_t>(std::floor((bounds.min.z + bounds.max.z) * 0.5f / cellSize)) };
+                }
+
+                CellBuild& cell = cells[coords];
+                cell.roots.push_back(entity);
+                if (bounds.min.x <= bounds.max.x)
+                {
+                    cell.bounds.Merge(bounds);
+                }
+            });
+
+        std::error_code ec;
+        std::filesystem::create_directories(directory, ec);
+        if (ec)
+        {
+            FT_ENGINE_ERROR("Failed to create the cell directory {}: {}", directory.string(), ec.message());
+            return false;
+        }
+
+        std::ofstream manifest(directory / MANIFEST_NAME, std::ios::binary | std::ios::trunc);
+        if (!manifest.is_open())
+        {
+            FT_ENGINE_ERROR("Failed to open file for writing: {}", (directory / MANIFEST_NAME).string());
+            return false;
+        }
+
+        WriteBinary(manifest, MANIFEST_MAGIC);
+        WriteBinary(manifest, MANIFEST_VERSION);
+        WriteBinary(manifest, static_cast<uint32_t>(cells.size()));
+
+        SceneSerializer serializer(&scene);
+        for (auto& [coords, cell] : cells)
+        {
+            // A cell of entities without any transform still needs bounds, it covers its whole square
+            if (cell.bounds.min.x > cell.bounds.max.x)
+            {
+                cell.bounds = { { coords.first * cellSize, 0.0f, coords.second * cellSize },
+                                { (coords.first + 1) * cellSize, 0.0f, (coords.second + 1) * cellSize } };
+            }
+
+            std::string filename = std::format("cell_{}_{}.bin", coords.first, coords.second);
+            if (!serializer.SerializeHierarchies(directory / filename, cell.roots))
+            {
+                return false;
+            }
+
+            WriteBinary(manifest, coords.first);
+            WriteBinary(manifest, coords.second);
+            WriteBinary(manifest, cell.bounds);
+            WriteBinaryString(manifest, filename);
+        }
+
+        if (!serializer.SerializeHierarchies(GetResidentPath(directory), residentRoots))
+        {
+            return false;
+        }
+
+        FT_ENGINE_INFO("Scene '{}' split into {} cells of {} units in {}",
+                       scene.GetName(),
+                       cells.size(),
+                       cellSize,
+                       directory.string());
+        return true;
+    }
+
+    std::filesystem::path SceneStreamer::GetCellsDirectory(const std::filesystem::path& scenePath)
+    {
+        std::filesystem::path directory = scenePath;
+        directory.replace_filename(scenePath.stem().string() + "_cells");
+        return directory;
+    }
+
+    std::filesystem::path SceneStreamer::GetResidentPath(const std::filesystem::path& directory)
+    {
+        return directory / RESIDENT_NAME;
+    }
+
+    bool SceneStreamer::HasCells(const std::filesystem::path& directory, const std::filesystem::path& scenePath)
+    {
+        std::error_code ec;
+        std::filesystem::path manifestPath = directory / MANIFEST_NAME;
+        if (!std::filesystem::exists(manifestPath, ec) || !std::filesystem::exists(GetResidentPath(directory), ec))
+            return false;
+
+        std::filesystem::path latestPath = SceneSerializer::GetLatestScenePath(scenePath);
+        auto sceneTime = std::filesystem::last_write_time(latestPath, ec);
+        if (ec)
+            return true;
+
+        if (std::filesystem::last_write_time(manifestPath, ec) < sceneTime)
+        {
+            FT_ENGINE_WARN("Ignoring the cells in {}: the scene was saved after they were built", directory.string());
+            return false;
+        }
+
+        return true;
+    }
+
+    bool SceneStreamer::Open(const std::filesystem::path& directory)
+    {
+        Close();
+
+        std::ifstream manifest(directory / MANIFEST_NAME, std::ios::binary);
+        uint32_t magic = 0;
+        uint32_t version = 0;
+        uint32_t cellCount = 0;
+        ReadBinary(manifest, magic);
+        ReadBinary(manifest, version);
+        ReadBinary(manifest, cellCount);
+        if (!manifest || magic != MANIFEST_MAGIC || version != MANIFEST_VERSION)
+        {
+            FT_ENGINE_ERROR("Failed to open streamed world {}: missing or unsupported manifest", directory.string());
+            return false;
+        }
+
+        _cells.resize(cellCount);
+        for (auto& cell : _cells)
+        {
+            ReadBinary(manifest, cell.x);
+            ReadBinary(manifest, cell.z);
+            ReadBinary(manifest, cell.bounds);
+            cell.filepath = directory / ReadBinaryString(manifest);
+        }
+
+        if (!manifest)
+        {
+            FT_ENGINE_ERROR("Failed to open streamed world {}: truncated manifest", directory.string());
+            _cells.clear();
+            return false;
+        }
+
+        return true;
+    }
+
+    void SceneStreamer::Close()
+    {
+        for (auto& cell : _cells)
+        {
+            if (cell.pending.valid())
+            {
+                cell.pending.wait();
+            }
+            _UnloadCell(cell);
+        }
+
+        _cells.clear();
+    }
+
+    size_t SceneStreamer::GetLoadedCellCount() const
+    {
+        return std::count_if(
+            _cells.begin(), _cells.end(), [](const Cell& cell) { return cell.state == CellState::Loaded; });
+    }
+
+    void SceneStreamer::Update()
+    {
+        if (_cells.empty())
+            return;
+
+        std::optional<Math::Vector3> focus = _focus ? _focus : _FindFocus();
+        if (!focus)
+            return;
+
+        uint32_t loadingCount = 0;
+        std::vector<std::pair<float, Cell*>> toLoad;
+        std::vector<std::pair<float, Cell*>> toMerge;
+
+        for (auto& cell : _cells)
+        {
+            if (cell.state == CellState::Loading)
+            {
+                if (cell.pending.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+                {
+                    ++loadingCount;
+                    continue;
+                }
+
+                cell.staged = cell.pending.get();
+                cell.state = cell.staged ? CellState::Merging : CellState::Failed;
+                cell.nextHierarchy = 0;
+            }
+
+            float distance = _DistanceXZ(cell.bounds, *focus);
+            if (distance > _settings.unloadRadius)
+            {
+                _UnloadCell(cell);
+            }
+            else if (cell.state == CellState::Unloaded && distance <= _settings.loadRadius)
+            {
+                toLoad.emplace_back(distance, &cell);
+            }
+            else if (cell.state == CellState::Merging)
+            {
+                toMerge.emplace_back(distance, &cell);
+            }
+        }
+
+        // Nearest cells first
+        auto byDistance = [](const auto& a, const auto& b) { return a.first < b.first; };
+        std::sort(toLoad.begin(), toLoad.end(), byDistance);
+        std::sort(toMerge.begin(), toMerge.end(), byDistance);
+
+        for (auto& [distance, cell] : toLoad)
+        {
+            if (loadingCount >= _settings.maxConcurrentLoads)
+                break;
+
+            cell->state = CellState::Loading;
+            cell->pending = std::async(std::launch::async, &SceneStreamer::_LoadCell, cell->filepath);
+            ++loadingCount;
+        }
+
+        // At least one hierarchy per update, so a budget smaller than a hierarchy still makes progress
+        auto start = std::chrono::steady_clock::now();
+        for (auto& [distance, cell] : toMerge)
+        {
+            while (cell->nextHierarchy + 1 < cell->staged->hierarchyStarts.size())
+            {
+                _MergeHierarchy(*cell);
+
+                std::chrono::duration<float, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+                if (elapsed.count() > _settings.mergeBudgetMs)
+                    return;
+            }
+
+            cell->state = CellState::Loaded;
+            cell->staged.reset();
+            cell->mergedEntities.clear();
+        }
+    }
+
+    std::optional<Math::Vector3> SceneStreamer::_FindFocus() const
+    {
+        std::optional<Math::Vector3> focus;
+        int32_t bestPriority = 0;
+
+        // Same main camera as the renderer, the one drawn last
+        _scene->ViewActive<Component::Camera, Component::WorldTransform>().each(
+            [&](const Component::Camera& camera, const Component::WorldTransform& transform)
+            {
+                if (camera.renderTargetConfig.has_value())
+                    return;
+
+                if (!focus || camera.priority >= bestPriority)
+                {
+                    focus = transform.position;
+                    bestPriority = camera.priority;
+                }
+            });
+
+        return focus;
+    }
+
+    void SceneStreamer::_MergeHierarchy(Cell& cell)
+    {
+        StagedCell& staged = *cell.staged;
+        uint32_t begin = staged.hierarchyStarts[cell.nextHierarchy];
+        uint32_t end = staged.hierarchyStarts[cell.nextHierarchy + 1];
+        ++cell.nextHierarchy;
+
+        std::vector<entt::entity> prefabs;
+        for (uint32_t i = begin; i < end; ++i)
+        {
+            const SceneSerializer::DetachedEntity& detached = staged.entities[staged.order[i]];
+            GameObject source(detached.entity, staged.registry);
+            GameObject target = _scene->CreateGameObject();
+            target.GetComponent<Component::EntityID>().guid = detached.guid;
+
+            for (const auto& serializer : SerializationSystem::GetAllSerializers())
+            {
+                if (serializer.Name == "Relationship")
+                    continue;
+
+                if (serializer.HasComponent(source))
+                {
+                    serializer.MoveComponent(source, target);
+                }
+            }
+
+            auto parent = cell.mergedEntities.find(detached.parentGuid);
+            if (i != begin && parent != cell.mergedEntities.end())
+            {
+                target.SetParent(GameObject(parent->second, _scene));
+            }
+            else
+            {
+                cell.roots.push_back(target.GetHandle());
+            }
+
+            cell.mergedEntities[detached.guid] = target.GetHandle();
+            if (target.HasComponent<Component::Prefab>())
+            {
+                prefabs.push_back(target.GetHandle());
+            }
+        }
+
+        for (auto entity : prefabs)
+        {
+            SceneSerializer::InstantiatePrefab(GameObject(entity, _scene));
+        }
+    }
+
+    void SceneStreamer::_UnloadCell(Cell& cell)
+    {
+        if (cell.state == CellState::Unloaded || cell.state == CellState::Loading || cell.state == CellState::Failed)
+            return;
+
+        auto& registry = _scene->GetRegistry();
+        std::vector<entt::entity> entities;
+        std::vector<GameObject> roots;
+
+        for (auto root : cell.roots)
+        {
+            // Gameplay may have destroyed some of them already
+            if (registry.valid(root))
+            {
+                CollectHierarchy(registry, root, entities);
+                roots.emplace_back(root, _scene);
+            }
+        }
+
+        if (auto* physicSystem = _scene->GetSystem<PhysicSystem>())
+        {
+            physicSystem->DestroyBodies(*_scene, entities);
+        }
+        _scene->DestroyGameObjects(roots);
+
+        cell.state = CellState::Unloaded;
+        cell.staged.reset();
+        cell.nextHierarchy = 0;
+        cell.mergedEntities.clear();
+        cell.roots.clear();
+    }
+
+    std::unique_ptr<SceneStreamer::StagedCell> SceneStreamer::_LoadCell(const std::filesystem::path& filepath)
+    {
+        auto staged = std::make_unique<StagedCell>();
+        if (!SceneSerializer::DeserializeDetached(filepath, staged->registry, staged->entities))
+        {
+            return nullptr;
+        }
+
+        uint32_t count = static_cast<uint32_t>(staged->entities.size());
+        std::unordered_map<uint64_t, uint32_t> indexByGuid;
+        indexByGuid.reserve(count);
+        for (uint32_t i = 0; i < count; ++i)
+        {
+            indexByGuid.emplace(staged->entities[i].guid, i);
+        }
+
+        // Children lists in one array, as offsets by parent
+        std::vector<uint32_t> parents(count, UINT32_MAX);
+        std::vector<uint32_t> childOffsets(count + 1, 0);
+        for (uint32_t i = 0; i < count; ++i)
+        {
+            auto it = indexByGuid.find(staged->entities[i].parentGuid);
+            if (staged->entities[i].parentGuid != 0 && it != indexByGuid.end())
+            {
+                parents[i] = it->second;
+                ++childOffsets[it->second + 1];
+            }
+        }
+
+        for (uint32_t i = 0; i < count; ++i)
+        {
+            childOffsets[i + 1] += childOffsets[i];
+        }
+
+        std::vector<uint32_t> children(childOffsets[count]);
+        std::vector<uint32_t> cursor(childOffsets.begin(), childOffsets.end() - 1);
+        for (uint32_t i = 0; i < count; ++i)
+        {
+            if (parents[i] != UINT32_MAX)
+            {
+                children[cursor[parents[i]]++] = i;
+            }
+        }
+
+        staged->order.reserve(count);
+        for (uint32_t root = 0; root < count; ++root)
+        {
+            if (parents[root] != UINT32_MAX)
+                continue;
+
+            staged->hierarchyStarts.push_back(static_cast<uint32_t>(staged->order.size()));
+            staged->order.push_back(root);
+            for (size_t i = staged->order.size() - 1; i < staged->order.size(); ++i)
+            {
+                uint32_t entity = staged->order[i];
+                for (uint32_t c = childOffsets[entity]; c < childOffsets[entity + 1]; ++c)
+                {
+                    staged->order.push_back(children[c]);
+                }
+            }
+        }
+        staged->hierarchyStarts.push_back(static_cast<uint32_t>(staged->order.size()));
+
+        return staged;
+    }
+
+    float SceneStreamer::_DistanceXZ(const BoundingBox& bounds, const Math::Vector3& point)
+    {
+        float dx = std::max({ bounds.min.x - point.x, 0.0f, point.x - bounds.max.x });
+        float dz = std::max({ bounds.min.z - point.z, 0.0f, point.z - bounds.max.z });
+        return std::sqrt(dx * dx + dz * dz);
+    }
+} // namespace Frost
@@ -0,0 +1,124 @@
+#pragma once
+
+#include "Frost/Core/Core.h"
+#include "Frost/Renderer/BoundingBox.h"
+#include "Frost/Utils/Math/Vector.h"
+
+#include <entt/entt.hpp>
+#include <cstdint>
+#include <filesystem>
+#include <future>
+#include <memory>
+#include <optional>
+#include <unordered_map>
+#include <vector>
+
+namespace Frost
+{
+    class Scene;
+
+    struct StreamingSettings
+    {
+        // Cells closer than loadRadius on the XZ plane are loaded and cells further than unloadRadius are unloaded,
+        // the gap keeps a cell on the edge from going back and forth
+        float loadRadius = 128.0f;
+        float unloadRadius = 160.0f;
+        // Main thread time an update may spend merging loaded cells into the scene
+        float mergeBudgetMs = 2.0f;
+        uint32_t maxConcurrentLoads = 2;
+    };
+
+    // Streams a world split into cells around a focus point, additively: the entities of a cell join the scene next
+    // to whatever it already holds. A worker thread reads a cell into a registry of its own, then the main thread
+    // moves it into the scene one root hierarchy at a time, within a time budget. Rigid bodies of merged entities are
+    // added by the PhysicSystem in one batch at the next fixed update.
+    class FROST_API SceneStreamer
+    {
+    public:
+        static constexpr float DEFAULT_CELL_SIZE = 64.0f;
+
+        explicit SceneStreamer(Scene* scene);
+        ~SceneStreamer();
+
+        SceneStreamer(const SceneStreamer&) = delete;
+        SceneStreamer& operator=(const SceneStreamer&) = delete;
+
+        // Writes one binary scene file per cell in directory, plus the manifest Open reads. Every root hierarchy goes
+        // to its WorldCell if it has one, to the cell holding the centre of its bounds otherwise. Hierarchies holding
+        // a camera and no WorldCell are never streamed, they go to the resident scene file instead
+        static bool BuildCells(Scene& scene,
+                               const std::filesystem::path& directory,
+                               float cellSize = DEFAULT_CELL_SIZE);
+
+        // <stem>_cells next to the scene file
+        static std::filesystem::path GetCellsDirectory(const std::filesystem::path& scenePath);
+        // Binary scene file to load before opening directory, it holds the hierarchies that are not streamed
+        static std::filesystem::path GetResidentPath(const std::filesystem::path& directory);
+        // True when BuildCells wrote directory after the last save of the scene file
+        static bool HasCells(const std::filesystem::path& directory, const std::filesystem::path& scenePath);
+
+        // Unloads the previous world, cells are then loaded by Update
+        bool Open(const std::filesystem::path& directory);
+        void Close();
+        bool IsOpen() const { return !_cells.empty(); }
+
+        // Streams around this point instead of the main camera
+        void SetFocus(const Math::Vector3& position) { _focus = position; }
+        void ClearFocus() { _focus.reset(); }
+
+        // Called by the scene at the start of its update
+        void Update();
+
+        void SetSettings(const StreamingSettings& settings) { _settings = settings; }
+        const StreamingSettings& GetSettings() const { return _settings; }
+
+        size_t GetCellCount() const { return _cells.size(); }
+        size_t GetLoadedCellCount() const;
+
+    private:
+        enum class CellState : uint8_t
+        {
+            Unloaded,
+            Loading,
+            Merging,
+            Loaded,
+            Failed
+        };
+
+        struct StagedCell;
+
+        struct Cell
+        {
+            int32_t x = 0;
+            int32_t z = 0;
+            BoundingBox bounds;
+            std::filesystem::path filepath;
+
+            CellState state = CellState::Unloaded;
+            std::future<std::unique_ptr<StagedCell>> pending;
+            std::unique_ptr<StagedCell> staged;
+            size_t nextHierarchy = 0;
+
+            // Live entities by GUID while merging, to link children to their parent
+            std::unordered_map<uint64_t, entt::entity> mergedEntities;
+            std::vector<entt::entity> roots;
+        };
+
+        std::optional<Math::Vector3> _FindFocus() const;
+        void _MergeHierarchy(Cell& cell);
+        void _UnloadCell(Cell& cell);
+
+        static std::unique_ptr<StagedCell> _LoadCell(const std::filesystem::path& filepath);
+        static float _DistanceXZ(const BoundingBox& bounds, const Math::Vector3& point);
+
+        Scene* _scene;
+        StreamingSettings _settings;
+        std::optional<Math::Vector3> _focus;
+        std::vector<Cell> _cells;
+
+        static constexpr const char* MANIFEST_NAME = "world.cells";
+        static constexpr const char* RESIDENT_NAME = "resident.bin";
+        static constexpr uint32_t MANIFEST_MAGIC = 0x43575446; // "FTWC"
+        static constexpr uint32_t MANIFEST_VERSION = 1;
+    };
+} // namespace Frost
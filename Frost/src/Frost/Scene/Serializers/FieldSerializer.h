@@ -0,0 +1,455 @@
+#pragma once
+
+#include "Frost/Scene/ECS/ComponentFields.h"
+#include "Frost/Utils/Math/Angle.h"
+#include "Frost/Utils/SerializerUtils.h"
+
+#include <yaml-cpp/yaml.h>
+#include <algorithm>
+#include <array>
+#include <filesystem>
+#include <iostream>
+#include <optional>
+#include <string>
+#include <utility>
+#include <variant>
+#include <vector>
+
+namespace Frost::Reflection
+{
+    // Field encodings call each other, nested reflected types and variant alternatives go back through
+    // WriteBinary and WriteYaml, so every overload is declared up front
+    template<typename T>
+    void WriteBinaryField(std::ostream& out, const T& value);
+    template<Reflected T>
+    void WriteBinaryField(std::ostream& out, const T& value);
+    template<typename... Ts>
+    void WriteBinaryField(std::ostream& out, const std::variant<Ts...>& value);
+    template<typename T>
+    void WriteBinaryField(std::ostream& out, const std::optional<T>& value);
+    template<typename T>
+    void WriteBinaryField(std::ostream& out, const std::vector<T>& value);
+    template<typename T, std::size_t N>
+    void WriteBinaryField(std::ostream& out, const std::array<T, N>& value);
+
+    template<typename T>
+    void ReadBinaryField(std::istream& in, T& value);
+    template<Reflected T>
+    void ReadBinaryField(std::istream& in, T& value);
+    template<typename... Ts>
+    void ReadBinaryField(std::istream& in, std::variant<Ts...>& value);
+    template<typename T>
+    void ReadBinaryField(std::istream& in, std::optional<T>& value);
+    template<typename T>
+    void ReadBinaryField(std::istream& in, std::vector<T>& value);
+    template<typename T, std::size_t N>
+    void ReadBinaryField(std::istream& in, std::array<T, N>& value);
+
+    template<typename T>
+    void WriteYamlField(YAML::Emitter& out, const T& value);
+    template<typename T>
+        requires std::is_enum_v<T>
+    void WriteYamlField(YAML::Emitter& out, const T& value);
+    template<Reflected T>
+    void WriteYamlField(YAML::Emitter& out, const T& value);
+    template<typename T>
+    void WriteYamlField(YAML::Emitter& out, const std::vector<T>& value);
+    template<typename T, std::size_t N>
+    void WriteYamlField(YAML::Emitter& out, const std::array<T, N>& value);
+
+    template<typename T>
+    void ReadYamlField(const YAML::Node& node, T& value);
+    template<typename T>
+        requires std::is_enum_v<T>
+    void ReadYamlField(const YAML::Node& node, T& value);
+    template<Reflected T>
+    void ReadYamlField(const YAML::Node& node, T& value);
+    template<typename T>
+    void ReadYamlField(const YAML::Node& node, std::vector<T>& value);
+    template<typename T, std::size_t N>
+    void ReadYamlField(const YAML::Node& node, std::array<T, N>& value);
+
+    template<Reflected T>
+    void WriteBinary(std::ostream& out, const T& component);
+    template<Reflected T>
+    void ReadBinary(std::istream& in, T& component);
+    template<Reflected T>
+    void WriteYaml(YAML::Emitter& out, const T& component);
+    template<Reflected T>
+    void ReadYaml(const YAML::Node& node, T& component);
+
+    template<typename T>
+    void WriteBinaryField(std::ostream& out, const T& value)
+    {
+        static_assert(std::is_trivially_copyable_v<T>, "No binary encoding for this field type");
+        Frost::WriteBinary(out, value);
+    }
+
+    inline void WriteBinaryField(std::ostream& out, const std::string& value)
+    {
+        WriteBinaryString(out, value);
+    }
+
+    inline void WriteBinaryField(std::ostream& out, const std::filesystem::path& value)
+    {
+        WriteBinaryString(out, value.generic_string());
+    }
+
+    template<Reflected T>
+    void WriteBinaryField(std::ostream& out, const T& value)
+    {
+        WriteBinary(out, value);
+    }
+
+    // Index of the alternative, then its fields
+    template<typename... Ts>
+    void WriteBinaryField(std::ostream& out, const std::variant<Ts...>& value)
+    {
+        Frost::WriteBinary(out, static_cast<uint32_t>(value.index()));
+        std::visit([&](const auto& alternative) { WriteBinaryField(out, alternative); }, value);
+    }
+
+    template<typename T>
+    void WriteBinaryField(std::ostream& out, const std::optional<T>& value)
+    {
+        Frost::WriteBinary(out, static_cast<uint8_t>(value.has_value()));
+        if (value)
+        {
+            WriteBinaryField(out, *value);
+        }
+    }
+
+    template<typename T>
+    void WriteBinaryField(std::ostream& out, const std::vector<T>& value)
+    {
+        Frost::WriteBinary(out, static_cast<uint32_t>(value.size()));
+        for (const T& element : value)
+        {
+            WriteBinaryField(out, element);
+        }
+    }
+
+    template<typename T, std::size_t N>
+    void WriteBinaryField(std::ostream& out, const std::array<T, N>& value)
+    {
+        for (const T& element : value)
+        {
+            WriteBinaryField(out, element);
+        }
+    }
+
+    template<typename T>
+    void ReadBinaryField(std::istream& in, T& value)
+    {
+        static_assert(std::is_trivially_copyable_v<T>, "No binary encoding for this field type");
+        Frost::ReadBinary(in, value);
+    }
+
+    inline void ReadBinaryField(std::istream& in, std::string& value)
+    {
+        value = ReadBinaryString(in);
+    }
+
+    inline void ReadBinaryField(std::istream& in, std::filesystem::path& value)
+    {
+        value = ReadBinaryString(in);
+    }
+
+    template<Reflected T>
+    void ReadBinaryField(std::istream& in, T& value)
+    {
+        ReadBinary(in, value);
+    }
+
+    template<typename... Ts>
+    void ReadBinaryField(std::istream& in, std::variant<Ts...>& value)
+    {
+        uint32_t index = 0;
+        Frost::ReadBinary(in, index);
+        EmplaceAlternative(value, index);
+        std::visit([&](auto& alternative) { ReadBinaryField(in, alternative); }, value);
+    }
+
+    template<typename T>
+    void ReadBinaryField(std::istream& in, std::optional<T>& value)
+    {
+        uint8_t hasValue = 0;
+        Frost::ReadBinary(in, hasValue);
+        if (!hasValue)
+        {
+            value.reset();
+            return;
+        }
+
+        if (!value)
+        {
+            value.emplace();
+        }
+        ReadBinaryField(in, *value);
+    }
+
+    template<typename T>
+    void ReadBinaryField(std::istream& in, std::vector<T>& value)
+    {
+        uint32_t count = 0;
+        Frost::ReadBinary(in, count);
+        value.resize(count);
+        for (T& element : value)
+        {
+            ReadBinaryField(in, element);
+        }
+    }
+
+    template<typename T, std::size_t N>
+    void ReadBinaryField(std::istream& in, std::array<T, N>& value)
+    {
+        for (T& element : value)
+        {
+            ReadBinaryField(in, element);
+        }
+    }
+
+    template<Reflected T>
+    void WriteBinary(std::ostream& out, const T& component)
+    {
+        if constexpr (IsBlockCopyable<T>())
+        {
+            out.write(reinterpret_cast<const char*>(&component), sizeof(T));
+        }
+        else
+        {
+            ForEachField<T>([&](const auto& field) { WriteBinaryField(out, component.*field.member); });
+        }
+    }
+
+    template<Reflected T>
+    void ReadBinary(std::istream& in, T& component)
+    {
+        if constexpr (IsBlockCopyable<T>())
+        {
+            in.read(reinterpret_cast<char*>(&component), sizeof(T));
+        }
+        else
+        {
+            ForEachField<T>([&](const auto& field) { ReadBinaryField(in, component.*field.member); });
+        }
+        NotifyAssigned(component);
+    }
+
+    // Only the fields whose bit is set, in declaration order, as masks from Diff select them
+    template<Reflected T>
+    void WriteBinaryFields(std::ostream& out, const T& component, uint64_t mask)
+    {
+        uint32_t index = 0;
+        ForEachField<T>(
+            [&](const auto& field)
+            {
+                if (mask & (uint64_t{ 1 } << index))
+                {
+                    WriteBinaryField(out, component.*field.member);
+                }
+                ++index;
+            });
+    }
+
+    template<Reflected T>
+    void ReadBinaryFields(std::istream& in, T& component, uint64_t mask)
+    {
+        uint32_t index = 0;
+        ForEachField<T>(
+            [&](const auto& field)
+            {
+                if (mask & (uint64_t{ 1 } << index))
+                {
+                    ReadBinaryField(in, component.*field.member);
+                }
+                ++index;
+            });
+        NotifyAssigned(component);
+    }
+
+    template<typename T>
+    void WriteYamlField(YAML::Emitter& out, const T& value)
+    {
+        out << value;
+    }
+
+    template<typename T>
+        requires std::is_enum_v<T>
+    void WriteYamlField(YAML::Emitter& out, const T& value)
+    {
+        out << static_cast<int>(value);
+    }
+
+    inline void WriteYamlField(YAML::Emitter& out, const std::filesystem::path& value)
+    {
+        out << value.generic_string();
+    }
+
+    // Degrees are easier to edit by hand, the component keeps radians
+    inline void WriteYamlField(YAML::Emitter& out, const Math::Angle<Math::Radian>& value)
+    {
+        out << Math::Angle<Math::Degree>(value).value();
+    }
+
+    template<Reflected T>
+    void WriteYamlField(YAML::Emitter& out, const T& value)
+    {
+        out << YAML::BeginMap;
+        WriteYaml(out, value);
+        out << YAML::EndMap;
+    }
+
+    template<typename T>
+    void WriteYamlField(YAML::Emitter& out, const std::vector<T>& value)
+    {
+        out << YAML::BeginSeq;
+        for (const T& element : value)
+        {
+            WriteYamlField(out, element);
+        }
+        out << YAML::EndSeq;
+    }
+
+    template<typename T, std::size_t N>
+    void WriteYamlField(YAML::Emitter& out, const std::array<T, N>& value)
+    {
+        out << YAML::BeginSeq;
+        for (const T& element : value)
+        {
+            WriteYamlField(out, element);
+        }
+        out << YAML::EndSeq;
+    }
+
+    template<typename T>
+    void ReadYamlField(const YAML::Node& node, T& value)
+    {
+        value = node.as<T>();
+    }
+
+    template<typename T>
+        requires std::is_enum_v<T>
+    void ReadYamlField(const YAML::Node& node, T& value)
+    {
+        value = static_cast<T>(node.as<int>());
+    }
+
+    inline void ReadYamlField(const YAML::Node& node, std::filesystem::path& value)
+    {
+        value = node.as<std::string>();
+    }
+
+    inline void ReadYamlField(const YAML::Node& node, Math::Angle<Math::Radian>& value)
+    {
+        value = Math::Angle<Math::Radian>(Math::Angle<Math::Degree>(node.as<float>()));
+    }
+
+    template<Reflected T>
+    void ReadYamlField(const YAML::Node& node, T& value)
+    {
+        ReadYaml(node, value);
+    }
+
+    template<typename T>
+    void ReadYamlField(const YAML::Node& node, std::vector<T>& value)
+    {
+        if (!node.IsSequence())
+            return;
+
+        value.resize(node.size());
+        for (std::size_t i = 0; i < value.size(); ++i)
+        {
+            ReadYamlField(node[i], value[i]);
+        }
+    }
+
+    // Extra elements are ignored and missing ones keep their value
+    template<typename T, std::size_t N>
+    void ReadYamlField(const YAML::Node& node, std::array<T, N>& value)
+    {
+        if (!node.IsSequence())
+            return;
+
+        for (std::size_t i = 0; i < std::min(N, node.size()); ++i)
+        {
+            ReadYamlField(node[i], value[i]);
+        }
+    }
+
+    template<typename T>
+    void WriteYamlEntry(YAML::Emitter& out, const char* name, const T& value)
+    {
+        out << YAML::Key << name << YAML::Value;
+        WriteYamlField(out, value);
+    }
+
+    // Two keys, <name>Type holds the index of the alternative and <name>Params its fields
+    template<typename... Ts>
+    void WriteYamlEntry(YAML::Emitter& out, const char* name, const std::variant<Ts...>& value)
+    {
+        out << YAML::Key << std::string(name) + "Type" << YAML::Value << static_cast<int>(value.index());
+        out << YAML::Key << std::string(name) + "Params" << YAML::Value;
+        std::visit([&](const auto& alternative) { WriteYamlField(out, alternative); }, value);
+    }
+
+    // Nothing is written while empty
+    template<typename T>
+    void WriteYamlEntry(YAML::Emitter& out, const char* name, const std::optional<T>& value)
+    {
+        if (value)
+        {
+            WriteYamlEntry(out, name, *value);
+        }
+    }
+
+    template<typename T>
+    void ReadYamlEntry(const YAML::Node& node, const char* name, T& value)
+    {
+        if (const YAML::Node fieldNode = node[name])
+        {
+            ReadYamlField(fieldNode, value);
+        }
+    }
+
+    template<typename... Ts>
+    void ReadYamlEntry(const YAML::Node& node, const char* name, std::variant<Ts...>& value)
+    {
+        if (const YAML::Node typeNode = node[std::string(name) + "Type"])
+        {
+            EmplaceAlternative(value, typeNode.as<std::size_t>());
+        }
+
+        if (const YAML::Node paramsNode = node[std::string(name) + "Params"])
+        {
+            std::visit([&](auto& alternative) { ReadYamlField(paramsNode, alternative); }, value);
+        }
+    }
+
+    template<typename T>
+    void ReadYamlEntry(const YAML::Node& node, const char* name, std::optional<T>& value)
+    {
+        if (const YAML::Node fieldNode = node[name])
+        {
+            if (!value)
+            {
+                value.emplace();
+            }
+            ReadYamlField(fieldNode, *value);
+        }
+    }
+
+    template<Reflected T>
+    void WriteYaml(YAML::Emitter& out, const T& component)
+    {
+        ForEachField<T>([&](const auto& field) { WriteYamlEntry(out, field.name, component.*field.member); });
+    }
+
+    // Missing keys keep their current value, so older files still load
+    template<Reflected T>
+    void ReadYaml(const YAML::Node& node, T& component)
+    {
+        ForEachField<T>([&](const auto& field) { ReadYamlEntry(node, field.name, component.*field.member); });
+        NotifyAssigned(component);
+    }
+} // namespace Frost::Reflection
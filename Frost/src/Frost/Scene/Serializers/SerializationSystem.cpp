@@ -2,6 +2,39 @@
 
 namespace Frost
 {
+    void SerializationSystem::_Register(ComponentSerializer&& serializer, entt::id_type typeHash)
+    {
+        GetSerializers().push_back(std::move(serializer));
+        ComponentSerializer* ptr = &GetSerializers().back();
+
+        GetIdMap()[ptr->ID] = ptr;
+        GetNameMap()[ptr->Name] = ptr;
+
+        auto [it, inserted] = GetSlotMap().try_emplace(typeHash, static_cast<uint32_t>(GetSlotTable().size()));
+        if (inserted)
+        {
+            GetSlotTable().push_back(ptr);
+        }
+        else
+        {
+            GetSlotTable()[it->second] = ptr;
+        }
+    }
+
+    uint32_t SerializationSystem::_FindSlot(entt::id_type typeHash)
+    {
+        auto& map = GetSlotMap();
+        auto it = map.find(typeHash);
+        if (it != map.end())
+            return it->second;
+        return INVALID_SLOT;
+    }
+
+    ComponentSerializer* SerializationSystem::_GetBySlot(uint32_t slot)
+    {
+        return GetSlotTable()[slot];
+    }
+
     const std::list<ComponentSerializer>& SerializationSystem::GetAllSerializers()
     {
         return GetSerializers();
@@ -43,9 +76,15 @@ namespace Frost
         return map;
     }
 
-    std::unordered_map<std::type_index, uint32_t>& SerializationSystem::GetTypeIdMap()
+    std::vector<ComponentSerializer*>& SerializationSystem::GetSlotTable()
+    {
+        static std::vector<ComponentSerializer*> table;
+        return table;
+    }
+
+    std::unordered_map<entt::id_type, uint32_t>& SerializationSystem::GetSlotMap()
     {
-        static std::unordered_map<std::type_index, uint32_t> map;
+        static std::unordered_map<entt::id_type, uint32_t> map;
         return map;
     }
 } // namespace Frost
\ No newline at end of file
@@ -2,38 +2,59 @@
 
 #include "Frost/Core/Core.h"
 #include "Frost/Scene/ECS/GameObject.h"
+#include "Frost/Scene/SceneChangeTracker.h"
+#include "Frost/Scene/Serializers/FieldSerializer.h"
 
 #include <yaml-cpp/yaml.h>
+#include <entt/entt.hpp>
+#include <atomic>
 #include <functional>
 #include <string>
+#include <limits>
 #include <list>
 #include <map>
 #include <iostream>
 #include <unordered_map>
-#include <typeindex>
+#include <vector>
 
 namespace Frost
 {
-    using SerializeYamlFn = std::function<void(YAML::Emitter&, GameObject)>;
-    using DeserializeYamlFn = std::function<void(const YAML::Node&, GameObject&)>;
+    using SerializeYamlFn = void (*)(YAML::Emitter&, GameObject);
+    using DeserializeYamlFn = void (*)(const YAML::Node&, GameObject&);
 
-    using SerializeBinaryFn = std::function<void(std::ostream&, GameObject)>;
-    using DeserializeBinaryFn = std::function<void(std::istream&, GameObject&)>;
+    using SerializeBinaryFn = void (*)(std::ostream&, GameObject);
+    using DeserializeBinaryFn = void (*)(std::istream&, GameObject&);
 
     struct ComponentSerializer
     {
         std::string Name;
         uint32_t ID;
 
-        std::function<bool(GameObject)> HasComponent;
-        std::function<void(GameObject)> AddComponent;
-        std::function<void(GameObject, GameObject)> CopyComponent;
+        bool (*HasComponent)(GameObject) = nullptr;
+        void (*AddComponent)(GameObject) = nullptr;
+        void (*RemoveComponent)(GameObject) = nullptr;
+        void (*CopyComponent)(GameObject, GameObject) = nullptr;
+        // Moves the component to another entity, which may live in another registry
+        void (*MoveComponent)(GameObject, GameObject) = nullptr;
+        // Signals an in-place edit to the registry observers
+        void (*PatchComponent)(GameObject) = nullptr;
 
-        SerializeYamlFn SerializeYaml;
-        DeserializeYamlFn DeserializeYaml;
+        // Bit mask of the fields that differ between the two components, only set for reflected components
+        uint64_t (*DiffComponent)(GameObject, GameObject) = nullptr;
 
-        SerializeBinaryFn SerializeBinary;
-        DeserializeBinaryFn DeserializeBinary;
+        // Binary access to the fields selected by a mask, only set for reflected components
+        uint32_t FieldCount = 0;
+        void (*SerializeBinaryFields)(std::ostream&, GameObject, uint64_t) = nullptr;
+        void (*DeserializeBinaryFields)(std::istream&, GameObject&, uint64_t) = nullptr;
+
+        // Marks entities dirty in the tracker whenever this component is added, patched or removed
+        void (*WatchChanges)(entt::registry&, SceneChangeTracker&) = nullptr;
+
+        SerializeYamlFn SerializeYaml = nullptr;
+        DeserializeYamlFn DeserializeYaml = nullptr;
+
+        SerializeBinaryFn SerializeBinary = nullptr;
+        DeserializeBinaryFn DeserializeBinary = nullptr;
     };
 
     class FROST_API SerializationSystem
@@ -45,9 +66,81 @@ namespace Frost
                                       DeserializeYamlFn yamlDeser,
                                       SerializeBinaryFn binSer,
                                       DeserializeBinaryFn binDeser)
+        {
+            ComponentSerializer serializer = _MakeSerializer<T>(name);
+            serializer.CopyComponent = &_CopyThroughYaml<T>;
+            serializer.SerializeYaml = yamlSer;
+            serializer.DeserializeYaml = yamlDeser;
+            serializer.SerializeBinary = binSer;
+            serializer.DeserializeBinary = binDeser;
+
+            _Register(std::move(serializer), entt::type_hash<T>::value());
+        }
+
+        // Everything is generated from the component's Reflection::Fields
+        template<Reflection::Reflected T>
+        static void RegisterComponent(const std::string& name)
+        {
+            ComponentSerializer serializer = _MakeSerializer<T>(name);
+
+            serializer.CopyComponent = [](GameObject source, GameObject destination)
+            {
+                if (!source || !destination)
+                    return;
+
+                Reflection::Copy(source.GetComponent<T>(), _GetOrAdd<T>(destination));
+            };
+            serializer.DiffComponent = [](GameObject a, GameObject b)
+            { return Reflection::Diff(a.GetComponent<T>(), b.GetComponent<T>()); };
+
+            serializer.FieldCount = static_cast<uint32_t>(Reflection::FieldCount<T>);
+            serializer.SerializeBinaryFields = [](std::ostream& out, GameObject go, uint64_t mask)
+            { Reflection::WriteBinaryFields(out, go.GetComponent<T>(), mask); };
+            serializer.DeserializeBinaryFields = [](std::istream& in, GameObject& go, uint64_t mask)
+            { Reflection::ReadBinaryFields(in, _GetOrAdd<T>(go), mask); };
+
+            serializer.SerializeYaml = [](YAML::Emitter& out, GameObject go)
+            { Reflection::WriteYaml(out, go.GetComponent<T>()); };
+            serializer.DeserializeYaml = [](const YAML::Node& node, GameObject& go)
+            { Reflection::ReadYaml(node, _GetOrAdd<T>(go)); };
+            serializer.SerializeBinary = [](std::ostream& out, GameObject go)
+            { Reflection::WriteBinary(out, go.GetComponent<T>()); };
+            serializer.DeserializeBinary = [](std::istream& in, GameObject& go)
+            { Reflection::ReadBinary(in, _GetOrAdd<T>(go)); };
+
+            _Register(std::move(serializer), entt::type_hash<T>::value());
+        }
+
+        static const std::list<ComponentSerializer>& GetAllSerializers();
+        static ComponentSerializer* GetSerializerByID(uint32_t id);
+        static ComponentSerializer* GetSerializerByName(const std::string& name);
+
+        // The dense slot of each type is looked up once, later calls index the table directly
+        template<typename T>
+        static ComponentSerializer* GetSerializer()
+        {
+            static std::atomic<uint32_t> slot{ INVALID_SLOT };
+
+            uint32_t index = slot.load(std::memory_order_relaxed);
+            if (index == INVALID_SLOT)
+            {
+                index = _FindSlot(entt::type_hash<T>::value());
+                if (index == INVALID_SLOT)
+                    return nullptr;
+
+                slot.store(index, std::memory_order_relaxed);
+            }
+
+            return _GetBySlot(index);
+        }
+
+    private:
+        template<typename T>
+        static ComponentSerializer _MakeSerializer(const std::string& name)
         {
             ComponentSerializer serializer;
             serializer.Name = name;
+            // Stored in scene and prefab files, must stay stable across builds
             serializer.ID = static_cast<uint32_t>(std::hash<std::string>{}(name));
 
             serializer.HasComponent = [](GameObject go) { return go.HasComponent<T>(); };
@@ -58,61 +151,67 @@ namespace Frost
                     go.AddComponent<T>();
                 }
             };
-
-            serializer.CopyComponent = [yamlSer, yamlDeser](GameObject source, GameObject destination)
+            serializer.RemoveComponent = [](GameObject go) { go.RemoveComponent<T>(); };
+            serializer.MoveComponent = [](GameObject source, GameObject destination)
+            { destination.AddComponent<T>(std::move(source.GetComponent<T>())); };
+            serializer.PatchComponent = [](GameObject go) { go.PatchComponent<T>(); };
+            serializer.WatchChanges = [](entt::registry& registry, SceneChangeTracker& tracker)
             {
-                if (!source || !destination)
-                    return;
-
-                YAML::Emitter out;
-                out << YAML::BeginMap;
-                yamlSer(out, source);
-                out << YAML::EndMap;
-
-                if (!destination.HasComponent<T>())
-                {
-                    destination.AddComponent<T>();
-                }
-
-                YAML::Node data = YAML::Load(out.c_str());
-                if (data)
-                {
-                    yamlDeser(data, destination);
-                }
+                registry.on_construct<T>().template connect<&SceneChangeTracker::_OnChanged>(tracker);
+                registry.on_update<T>().template connect<&SceneChangeTracker::_OnChanged>(tracker);
+                registry.on_destroy<T>().template connect<&SceneChangeTracker::_OnChanged>(tracker);
             };
 
-            serializer.SerializeYaml = yamlSer;
-            serializer.DeserializeYaml = yamlDeser;
-            serializer.SerializeBinary = binSer;
-            serializer.DeserializeBinary = binDeser;
-
-            GetSerializers().push_back(serializer);
-            ComponentSerializer* ptr = &GetSerializers().back();
-
-            GetIdMap()[serializer.ID] = ptr;
-            GetNameMap()[name] = ptr;
-            GetTypeIdMap()[std::type_index(typeid(T))] = serializer.ID;
+            return serializer;
         }
 
-        static const std::list<ComponentSerializer>& GetAllSerializers();
-        static ComponentSerializer* GetSerializerByID(uint32_t id);
-        static ComponentSerializer* GetSerializerByName(const std::string& name);
+        template<typename T>
+        static T& _GetOrAdd(GameObject go)
+        {
+            if (T* component = go.TryGetComponent<T>())
+            {
+                return *component;
+            }
+            return go.AddComponent<T>();
+        }
 
         template<typename T>
-        static ComponentSerializer* GetSerializer()
+        static void _CopyThroughYaml(GameObject source, GameObject destination)
         {
-            auto it = GetTypeIdMap().find(std::type_index(typeid(T)));
-            if (it != GetTypeIdMap().end())
+            if (!source || !destination)
+                return;
+
+            ComponentSerializer* serializer = GetSerializer<T>();
+            if (!serializer)
+                return;
+
+            YAML::Emitter out;
+            out << YAML::BeginMap;
+            serializer->SerializeYaml(out, source);
+            out << YAML::EndMap;
+
+            if (!destination.HasComponent<T>())
+            {
+                destination.AddComponent<T>();
+            }
+
+            YAML::Node data = YAML::Load(out.c_str());
+            if (data)
             {
-                return GetSerializerByID(it->second);
+                serializer->DeserializeYaml(data, destination);
             }
-            return nullptr;
         }
 
-    private:
+        static void _Register(ComponentSerializer&& serializer, entt::id_type typeHash);
+        static uint32_t _FindSlot(entt::id_type typeHash);
+        static ComponentSerializer* _GetBySlot(uint32_t slot);
+
         static std::list<ComponentSerializer>& GetSerializers();
         static std::unordered_map<uint32_t, ComponentSerializer*>& GetIdMap();
         static std::unordered_map<std::string, ComponentSerializer*>& GetNameMap();
-        static std::unordered_map<std::type_index, uint32_t>& GetTypeIdMap();
+        static std::vector<ComponentSerializer*>& GetSlotTable();
+        static std::unordered_map<entt::id_type, uint32_t>& GetSlotMap();
+
+        static constexpr uint32_t INVALID_SLOT = std::numeric_limits<uint32_t>::max();
     };
 } // namespace Frost
\ No newline at end of file
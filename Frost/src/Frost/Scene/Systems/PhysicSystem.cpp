@@ -1,6 +1,7 @@
 #include "Frost/Scene/Systems/PhysicSystem.h"
 #include "Frost/Scene/Components/RigidBody.h"
 #include "Frost/Scene/Components/Relationship.h"
+#include "Frost/Scene/Components/WorldMatrix.h"
 #include "Frost/Physics/Physics.h"
 #include "Frost/Scripting/Script.h"
 #include "Frost/Utils/Math/Angle.h"
@@ -190,15 +191,22 @@ namespace Frost
     void PhysicSystem::FixedUpdate(Scene& scene, float fixedDeltaTime)
     {
         {
+            // A streamed cell brings its bodies all at once, one batch inserts them into the broad phase together
+            std::vector<JPH::BodyID> newBodies;
             auto view = scene.GetRegistry().view<RigidBody, WorldTransform>();
             view.each(
                 [&](entt::entity entity, RigidBody& rb, WorldTransform& worldTransform)
                 {
                     if (rb.runtimeBodyID.IsInvalid())
                     {
-                        _CreateBodyForEntity(scene, entity);
+                        JPH::BodyID bodyID = _CreateBody(scene, entity);
+                        if (!bodyID.IsInvalid())
+                        {
+                            newBodies.push_back(bodyID);
+                        }
                     }
                 });
+            _AddBodies(newBodies);
         }
 
         Physics::Get().UpdatePhysics(fixedDeltaTime);
@@ -267,24 +275,68 @@ namespace Frost
     }
 
     void PhysicSystem::_CreateBodyForEntity(Scene& scene, entt::entity entity)
+    {
+        JPH::BodyID bodyID = _CreateBody(scene, entity);
+        if (!bodyID.IsInvalid())
+        {
+            Physics::GetBodyInterface().AddBody(bodyID, JPH::EActivation::Activate);
+        }
+    }
+
+    void PhysicSystem::_AddBodies(std::vector<JPH::BodyID>& bodies)
+    {
+        if (bodies.empty())
+            return;
+
+        auto& body_interface = Physics::GetBodyInterface();
+        int count = static_cast<int>(bodies.size());
+
+        JPH::BodyInterface::AddState addState = body_interface.AddBodiesPrepare(bodies.data(), count);
+        body_interface.AddBodiesFinalize(bodies.data(), count, addState, JPH::EActivation::Activate);
+    }
+
+    void PhysicSystem::DestroyBodies(Scene& scene, std::span<const entt::entity> entities)
     {
         auto& registry = scene.GetRegistry();
-        if (!registry.all_of<Component::RigidBody, Component::WorldTransform>(entity))
+        std::vector<JPH::BodyID> bodies;
+
+        for (auto entity : entities)
+        {
+            auto* rb = registry.valid(entity) ? registry.try_get<Component::RigidBody>(entity) : nullptr;
+            if (rb && !rb->runtimeBodyID.IsInvalid())
+            {
+                bodies.push_back(rb->runtimeBodyID);
+                rb->runtimeBodyID = JPH::BodyID();
+            }
+        }
+
+        if (bodies.empty())
             return;
 
+        auto& body_interface = Physics::GetBodyInterface();
+        body_interface.RemoveBodies(bodies.data(), static_cast<int>(bodies.size()));
+        body_interface.DestroyBodies(bodies.data(), static_cast<int>(bodies.size()));
+    }
+
+    JPH::BodyID PhysicSystem::_CreateBody(Scene& scene, entt::entity entity)
+    {
+        auto& registry = scene.GetRegistry();
+        if (!registry.all_of<Component::RigidBody, Component::WorldTransform>(entity))
+            return {};
+
         auto& rb = registry.get<Component::RigidBody>(entity);
         auto& worldTransform = registry.get<Component::WorldTransform>(entity);
         auto& body_interface = Physics::GetBodyInterface();
 
         if (!rb.runtimeBodyID.IsInvalid())
-            return;
+            return {};
 
         JPH::Ref<JPH::Shape> finalShape = CreateJoltShape(rb.shape, worldTransform.scale);
 
         if (!finalShape)
         {
             FT_ENGINE_ERROR("PhysicSystem: Failed to create shape for entity {0}", (uint32_t)entity);
-            return;
+            return {};
         }
 
         JPH::BodyCreationSettings bodySettings(finalShape,
@@ -326,15 +378,14 @@ namespace Frost
         bodySettings.mUserData = static_cast<uint64_t>(entity);
 
         JPH::Body* body = body_interface.CreateBody(bodySettings);
-        if (body)
-        {
-            rb.runtimeBodyID = body->GetID();
-            body_interface.AddBody(rb.runtimeBodyID, JPH::EActivation::Activate);
-        }
-        else
+        if (!body)
         {
             FT_ENGINE_ERROR("PhysicSystem: Failed to create body for entity {0}", (uint32_t)entity);
+            return {};
         }
+
+        rb.runtimeBodyID = body->GetID();
+        return rb.runtimeBodyID;
     }
 
     void PhysicSystem::_DestroyBodyForEntity(Scene& scene, entt::entity entity)
@@ -378,15 +429,13 @@ namespace Frost
                 auto* relationship = registry.try_get<Component::Relationship>(entity);
                 if (relationship && relationship->parent != entt::null)
                 {
-                    auto* parentWorldTransform = registry.try_get<Component::WorldTransform>(relationship->parent);
-                    if (parentWorldTransform)
+                    auto* parentWorldMatrix = registry.try_get<Component::WorldMatrix>(relationship->parent);
+                    if (parentWorldMatrix)
                     {
                         Math::Matrix4x4 newWorldMat = Math::Matrix4x4::CreateFromQuaternion(newWorldRotation) *
                                                       Math::Matrix4x4::CreateTranslation(newWorldPosition);
 
-                        Math::Matrix4x4 parentWorldMat = Math::GetTransformMatrix(*parentWorldTransform);
-
-                        DirectX::XMMATRIX parentMatDX = Math::LoadMatrix(parentWorldMat);
+                        DirectX::XMMATRIX parentMatDX = Math::LoadMatrix(parentWorldMatrix->matrix);
                         DirectX::XMVECTOR det;
                         DirectX::XMMATRIX parentInverseMatDX = DirectX::XMMatrixInverse(&det, parentMatDX);
 
@@ -6,6 +6,10 @@
 #include "Frost/Scene/Scene.h"
 
 #include <entt/entt.hpp>
+#include <Jolt/Jolt.h>
+#include <Jolt/Physics/Body/BodyID.h>
+#include <span>
+#include <vector>
 
 namespace Frost
 {
@@ -22,10 +26,16 @@ namespace Frost
 
         void NotifyRigidBodyUpdate(Scene& scene, GameObject entity);
 
+        // Takes the bodies of the entities out of the physics world as one batch, before the entities are destroyed
+        void DestroyBodies(Scene& scene, std::span<const entt::entity> entities);
+
     private:
         void _OnDestroyBody(entt::registry& registry, entt::entity entity);
         void _CreateBodyForEntity(Scene& scene, entt::entity entity);
         void _DestroyBodyForEntity(Scene& scene, entt::entity entity);
+        // Creates the body without adding it to the physics world
+        JPH::BodyID _CreateBody(Scene& scene, entt::entity entity);
+        void _AddBodies(std::vector<JPH::BodyID>& bodies);
 
         void _SynchronizeTransforms(Scene& scene);
 
@@ -5,16 +5,31 @@
 #include "Frost/Physics/Physics.h"
 #include "Frost/Renderer/Renderer.h"
 #include "Frost/Renderer/RendererAPI.h"
+#include "Frost/Renderer/TextureStreamer.h"
+#include "Frost/Scene/Components/Occluder.h"
 #include "Frost/Scene/Components/RelativeView.h"
 #include "Frost/Utils/Math/Transform.h"
 #include "Frost/Renderer/Pipeline/JoltDebugRenderingPipeline.h"
 #include "Frost/Renderer/Frustum.h"
 
+#include <algorithm>
+#include <cmath>
+#include <tuple>
+
 using namespace Frost::Component;
 
 namespace Frost
 {
-    RendererSystem::RendererSystem() : _frustum{} {}
+    RendererSystem::RendererSystem() : _frustum{}
+    {
+        _shadowPipeline.SetLodBias(_lodSettings.shadowLodBias);
+    }
+
+    void RendererSystem::SetLodSettings(const LodSettings& settings)
+    {
+        _lodSettings = settings;
+        _shadowPipeline.SetLodBias(settings.shadowLodBias);
+    }
 
     void RendererSystem::LateUpdate(Scene& scene, float deltaTime)
     {
@@ -28,9 +43,13 @@ namespace Frost
             return;
         }
 
+        ++_frameIndex;
+        Debug::RendererConfig::occluderCount = 0;
+        Debug::RendererConfig::occludedCount = 0;
+
         auto cameraView = scene.ViewActive<Camera, WorldTransform>();
         auto lightView = scene.ViewActive<Light, WorldTransform>();
-        auto meshView = scene.ViewActive<StaticMesh, WorldTransform>();
+        auto meshView = scene.ViewActive<StaticMesh, WorldMatrix>();
 
         std::vector<std::pair<Component::Light, Component::WorldTransform>> allLights;
         allLights.reserve(lightView.size_hint());
@@ -60,52 +79,7 @@ namespace Frost
 
         const float mainAspectRatio = (currentHeight > 0) ? (currentWidth / currentHeight) : 1.0f;
 
-        for (const auto& camData : renderTargetCameras)
-        {
-            const auto& config = camData.camera->renderTargetConfig.value();
-
-            std::shared_ptr<Texture> renderTarget;
-            auto it = _renderTargetCache.find(camData.entity);
-            if (it != _renderTargetCache.end() && it->second->GetWidth() == config.width &&
-                it->second->GetHeight() == config.height)
-            {
-                renderTarget = it->second;
-            }
-            else
-            {
-                TextureConfig texConfig = { .debugName = "CameraTarget",
-                                            .format = Format::RGBA8_UNORM,
-                                            .width = config.width,
-                                            .height = config.height,
-                                            .isRenderTarget = true,
-                                            .isShaderResource = true };
-                renderTarget = Texture::Create(texConfig);
-                _renderTargetCache[camData.entity] = renderTarget;
-            }
-
-            float aspectRatioToUse = config.useScreenSpaceAspectRatio ? mainAspectRatio : 0.0f;
-            _RenderSceneToTexture(scene, camData, deltaTime, allLights, renderTarget, aspectRatioToUse);
-        }
-
-        meshView.each(
-            [&](StaticMesh& staticMesh, const WorldTransform&)
-            {
-                if (staticMesh.GetModel())
-                {
-                    for (auto& material : staticMesh.GetModel()->GetMaterials())
-                    {
-                        if (material.cameraRef != entt::null)
-                        {
-                            auto it = _renderTargetCache.find(static_cast<entt::entity>(material.cameraRef));
-                            if (it != _renderTargetCache.end())
-                            {
-                                material.albedoTextures.clear();
-                                material.albedoTextures.push_back(it->second);
-                            }
-                        }
-                    }
-                }
-            });
+        _RenderTargetCameras(scene, renderTargetCameras, deltaTime, allLights, mainAspectRatio);
 
         JoltRenderingPipeline* joltDebugRenderer = static_cast<JoltRenderingPipeline*>(Physics::GetDebugRenderer());
 
@@ -130,10 +104,6 @@ namespace Frost
 
             const float mainCameraAspectRatio =
                 (mainRenderViewport.height > 0) ? (mainRenderViewport.width / mainRenderViewport.height) : 1.0f;
-            _deferredRendering.OnResize(static_cast<uint32_t>(mainRenderViewport.width),
-                                        static_cast<uint32_t>(mainRenderViewport.height));
-            _shadowPipeline.OnResize(static_cast<uint32_t>(mainRenderViewport.width),
-                                     static_cast<uint32_t>(mainRenderViewport.height));
 
             Math::Matrix4x4 viewMatrix = Math::GetViewMatrix(cameraTransform);
             Math::Matrix4x4 projectionMatrix = Math::GetProjectionMatrix(camera, mainCameraAspectRatio);
@@ -147,10 +117,12 @@ namespace Frost
 
             // Light Culling
             std::vector<std::pair<Component::Light, Component::WorldTransform>> visibleLights;
+            std::vector<entt::entity> visibleLightEntities;
             visibleLights.reserve(lightView.size_hint());
+            visibleLightEntities.reserve(lightView.size_hint());
 
             lightView.each(
-                [&](const Component::Light& light, const Component::WorldTransform& transform)
+                [&](entt::entity lightEntity, const Component::Light& light, const Component::WorldTransform& transform)
                 {
                     bool isVisible = false;
                     switch (light.GetType())
@@ -196,6 +168,7 @@ namespace Frost
                     if (isVisible)
                     {
                         visibleLights.emplace_back(light, transform);
+                        visibleLightEntities.push_back(lightEntity);
                     }
                 });
 
@@ -209,87 +182,179 @@ namespace Frost
                 skyboxTexture = _GetOrCreateSkyboxTexture(skyboxComponent);
             }
 
-            if (Debug::RendererConfig::display)
-            {
-                // Apply post-processing effects pre-render
-                for (auto& effect : camera.postEffects)
-                {
-                    if (!effect->IsEnabled())
-                        continue;
-                    FT_ENGINE_ASSERT(effect != nullptr, "PostEffect is null");
-                    effect->OnPreRender(deltaTime, viewMatrix, projectionMatrix);
-                }
+            _renderGraph.Reset();
+            RenderGraph::TextureHandle output = _renderGraph.Import("Output", finalRenderTarget);
 
-                _deferredRendering.BeginFrame(
-                    camera, cameraTransform, viewMatrix, projectionMatrix, mainRenderViewport);
+            const uint32_t viewWidth = static_cast<uint32_t>(mainRenderViewport.width);
+            const uint32_t viewHeight = static_cast<uint32_t>(mainRenderViewport.height);
+            GBufferHandles gbuffer;
 
-                meshView.each(
-                    [&](const StaticMesh& staticMesh, const WorldTransform& meshTransform)
+            _renderGraph.AddPass(
+                "GBuffer",
+                [&](RenderGraph::Builder& builder)
+                {
+                    gbuffer = _CreateGBuffer(builder, viewWidth, viewHeight);
+                    return [&, gbuffer](RenderGraph::Context& context)
                     {
-                        if (staticMesh.GetModel())
+                        _deferredRendering.SetGBuffer({ .albedo = context.GetTexture(gbuffer.albedo),
+                                                        .normal = context.GetTexture(gbuffer.normal),
+                                                        .worldPosition = context.GetTexture(gbuffer.worldPosition),
+                                                        .material = context.GetTexture(gbuffer.material),
+                                                        .emission = context.GetTexture(gbuffer.emission),
+                                                        .depth = context.GetTexture(gbuffer.depth) });
+
+                        if (Debug::RendererConfig::display)
                         {
-                            Math::Matrix4x4 worldMatrix = Math::GetTransformMatrix(meshTransform);
-                            if (!camera.frustumCulling || _IsVisible(staticMesh, worldMatrix))
+                            // Apply post-processing effects pre-render
+                            for (auto& effect : camera.postEffects)
                             {
-                                _deferredRendering.SubmitModel(*staticMesh.GetModel(), worldMatrix);
+                                if (!effect->IsEnabled())
+                                    continue;
+                                FT_ENGINE_ASSERT(effect != nullptr, "PostEffect is null");
+                                effect->OnPreRender(deltaTime, viewMatrix, projectionMatrix);
                             }
-                        }
-                    });
 
-                _shadowPipeline.SetGBufferData(&_deferredRendering, &scene);
+                            _deferredRendering.BeginFrame(
+                                camera, cameraTransform, viewMatrix, projectionMatrix, mainRenderViewport);
+
+                            _visibleInstances.clear();
+                            meshView.each(
+                                [&](entt::entity entity, StaticMesh& staticMesh, const WorldMatrix& meshMatrix)
+                                {
+                                    if (staticMesh.GetModel() &&
+                                        (!camera.frustumCulling || _IsVisible(staticMesh, meshMatrix.matrix)))
+                                    {
+                                        _visibleInstances.push_back({ entity, &staticMesh, &meshMatrix.matrix });
+                                    }
+                                });
+
+                            if (GetOcclusionSettings().enabled && Debug::RendererConfig::occlusionCulling)
+                            {
+                                _CullOccluded(scene, camera, cameraTransform, viewProjectionMatrix);
+                            }
+
+                            _drawItems.clear();
+                            for (const VisibleInstance& instance : _visibleInstances)
+                            {
+                                StaticMesh& staticMesh = *instance.staticMesh;
+                                const Math::Matrix4x4& worldMatrix = *instance.worldMatrix;
+                                staticMesh.SetLod(_SelectLod(
+                                    staticMesh, worldMatrix, camera, cameraTransform, mainRenderViewport.height));
+                                _drawItems.push_back({ staticMesh.GetModel().get(),
+                                                       &worldMatrix,
+                                                       &staticMesh.GetPropertyBlock(),
+                                                       staticMesh.GetLod() });
+                                _MarkRenderTargetSurfaces(staticMesh.GetModel());
+                                _RequestTextureMips(
+                                    staticMesh, worldMatrix, camera, cameraTransform, mainRenderViewport.height);
+                            }
+                            _deferredRendering.SubmitModels(_drawItems);
+                        }
+                        else
+                        {
+                            _deferredRendering.BeginFrame(
+                                camera, cameraTransform, viewMatrix, projectionMatrix, mainRenderViewport);
+                        }
+                    };
+                });
 
-                _shadowPipeline.ShadowPass(visibleLights, camera, cameraTransform, camera.viewport);
-                auto envView = scene.ViewActive<EnvironmentMap>();
-                if (envView.begin() != envView.end())
+            // The shadow atlas stays inside the shadow pipeline, it is written and read by this pass only
+            RenderGraph::TextureHandle sceneColor;
+            _renderGraph.AddPass(
+                "Lighting",
+                [&](RenderGraph::Builder& builder)
                 {
-                    const auto& envComponent = envView.get<EnvironmentMap>(*envView.begin());
-                    std::shared_ptr<Texture> envTexture = _GetOrCreateEnvironmentTexture(envComponent);
-                    if (envTexture)
+                    builder.Read(gbuffer.albedo);
+                    builder.Read(gbuffer.normal);
+                    builder.Read(gbuffer.worldPosition);
+                    builder.Read(gbuffer.material);
+                    builder.Read(gbuffer.emission);
+                    builder.Read(gbuffer.depth);
+                    const RenderGraph::TextureDesc luminanceDesc = {
+                        .format = ShadowPipeline::LUMINANCE_FORMAT, .width = viewWidth, .height = viewHeight
+                    };
+                    RenderGraph::TextureHandle luminance1 = builder.Create("Luminance1", luminanceDesc);
+                    RenderGraph::TextureHandle luminance2 = builder.Create("Luminance2", luminanceDesc);
+                    sceneColor = builder.Create(
+                        "SceneColor",
+                        { .format = ShadowPipeline::OUTPUT_FORMAT, .width = viewWidth, .height = viewHeight });
+                    return [&, luminance1, luminance2, sceneColor](RenderGraph::Context& context)
                     {
-                        _shadowPipeline.SetEnvironmentMap(envTexture, envComponent.intensity);
-                    }
-                }
-                else
-                {
-                    _shadowPipeline.SetEnvironmentMap(nullptr, 0.0f);
-                }
+                        _shadowPipeline.SetLightTargets({ .luminance1 = context.GetTexture(luminance1),
+                                                          .luminance2 = context.GetTexture(luminance2),
+                                                          .output = context.GetTexture(sceneColor) });
+                        _shadowPipeline.SetGBufferData(&_deferredRendering, &scene);
+                        _shadowPipeline.ShadowPass(
+                            visibleLights, visibleLightEntities, camera, cameraTransform, camera.viewport);
+
+                        if (Debug::RendererConfig::display)
+                        {
+                            auto envView = scene.ViewActive<EnvironmentMap>();
+                            if (envView.begin() != envView.end())
+                            {
+                                const auto& envComponent = envView.get<EnvironmentMap>(*envView.begin());
+                                std::shared_ptr<Texture> envTexture = _GetOrCreateEnvironmentTexture(envComponent);
+                                if (envTexture)
+                                {
+                                    _shadowPipeline.SetEnvironmentMap(envTexture, envComponent.intensity);
+                                }
+                            }
+                            else
+                            {
+                                _shadowPipeline.SetEnvironmentMap(nullptr, 0.0f);
+                            }
+                        }
 
-                _shadowPipeline.LightPass(camera, cameraTransform, camera.viewport);
+                        _shadowPipeline.LightPass(camera, cameraTransform, camera.viewport);
+                    };
+                });
 
-                if (skyboxTexture)
-                {
-                    _skyboxPipeline.Render(commandList,
-                                           _shadowPipeline.GetFinalLitTexture(),
-                                           _deferredRendering.GetDepthStencilTexture().get(),
-                                           skyboxTexture.get(),
-                                           camera,
-                                           cameraTransform);
-                }
-            }
-            else
+            if (skyboxTexture && Debug::RendererConfig::display)
             {
-                _deferredRendering.BeginFrame(
-                    camera, cameraTransform, viewMatrix, projectionMatrix, mainRenderViewport);
-                _shadowPipeline.SetGBufferData(&_deferredRendering, &scene);
-                _shadowPipeline.ShadowPass(visibleLights, camera, cameraTransform, camera.viewport);
-                _shadowPipeline.LightPass(camera, cameraTransform, camera.viewport);
+                // Depth tested against the G-buffer depth, not written
+                _renderGraph.AddPass("Skybox",
+                                     [&](RenderGraph::Builder& builder)
+                                     {
+                                         builder.Read(gbuffer.depth, RenderGraph::ResourceState::DepthWrite);
+                                         sceneColor = builder.Write(sceneColor);
+                                         return [&, sceneColor, depth = gbuffer.depth](RenderGraph::Context& context)
+                                         {
+                                             _skyboxPipeline.Render(context.GetCommandList(),
+                                                                    context.GetTexture(sceneColor),
+                                                                    context.GetTexture(depth),
+                                                                    skyboxTexture.get(),
+                                                                    camera,
+                                                                    cameraTransform);
+                                         };
+                                     });
             }
 
-            Texture* sceneTexture = _shadowPipeline.GetFinalLitTexture();
-            _ApplyPostProcessing(commandList, sceneTexture, finalRenderTarget, camera, deltaTime);
+            output = _AddPostProcessingPasses(sceneColor, output, gbuffer, camera, deltaTime);
 
 #ifdef FT_DEBUG
             if (Debug::PhysicsConfig::IsDisplayEnabled() && joltDebugRenderer)
             {
-                joltDebugRenderer->Render(commandList,
-                                          mainRenderViewport,
-                                          viewProjectionMatrix,
-                                          camera,
-                                          finalRenderTarget,
-                                          _deferredRendering.GetDepthStencilTexture().get());
+                _renderGraph.AddPass("PhysicsDebug",
+                                     [&](RenderGraph::Builder& builder)
+                                     {
+                                         builder.Read(gbuffer.depth, RenderGraph::ResourceState::DepthWrite);
+                                         output = builder.Write(output);
+                                         return [&, depth = gbuffer.depth](RenderGraph::Context& context)
+                                         {
+                                             joltDebugRenderer->Render(context.GetCommandList(),
+                                                                       mainRenderViewport,
+                                                                       viewProjectionMatrix,
+                                                                       camera,
+                                                                       finalRenderTarget,
+                                                                       context.GetTexture(depth));
+                                         };
+                                     });
             }
 #endif
 
+            _renderGraph.Compile();
+            _renderGraph.Execute(commandList, _transientTextures);
+
             commandList->EndRecording();
             commandList->Execute();
         }
@@ -299,9 +364,141 @@ namespace Frost
             joltDebugRenderer->Clear();
         }
 
+        _transientTextures.EndFrame();
         RendererAPI::GetRenderer()->RestoreBackBufferRenderTarget();
     }
 
+    void RendererSystem::_RenderTargetCameras(
+        Scene& scene,
+        std::vector<RenderCameraData>& cameras,
+        float deltaTime,
+        const std::vector<std::pair<Component::Light, Component::WorldTransform>>& allLights,
+        float mainAspectRatio)
+    {
+        std::erase_if(_renderTargets,
+                      [&](const auto& entry)
+                      {
+                          return std::ranges::none_of(cameras,
+                                                      [&](const RenderCameraData& camData)
+                                                      { return camData.entity == entry.first; });
+                      });
+        std::erase_if(_renderTargetBindings, [](const auto& entry) { return entry.second.model.expired(); });
+
+        // A target is only due when a main camera drew a surface showing it last frame
+        std::erase_if(cameras,
+                      [&](const RenderCameraData& camData)
+                      {
+                          const auto& config = camData.camera->renderTargetConfig.value();
+                          const RenderTargetState& state = _renderTargets[camData.entity];
+
+                          bool isVisible = state.lastVisibleFrame != 0 && _frameIndex - state.lastVisibleFrame <= 1;
+                          bool isDue = state.lastRenderedFrame == 0 ||
+                                       _frameIndex - state.lastRenderedFrame >= std::max(config.updateInterval, 1u);
+                          return !isVisible || !isDue;
+                      });
+
+        // Round robin over the budget, then back to priority order for rendering
+        auto lastRendered = [&](const RenderCameraData& camData)
+        { return _renderTargets[camData.entity].lastRenderedFrame; };
+        std::stable_sort(cameras.begin(),
+                         cameras.end(),
+                         [&](const RenderCameraData& a, const RenderCameraData& b)
+                         { return lastRendered(a) < lastRendered(b); });
+        if (cameras.size() > _renderTargetCameraBudget)
+        {
+            cameras.resize(_renderTargetCameraBudget);
+        }
+        std::stable_sort(cameras.begin(),
+                         cameras.end(),
+                         [](const RenderCameraData& a, const RenderCameraData& b)
+                         { return a.camera->priority < b.camera->priority; });
+
+        for (const auto& camData : cameras)
+        {
+            const auto& config = camData.camera->renderTargetConfig.value();
+            RenderTargetState& state = _renderTargets[camData.entity];
+
+            uint32_t width = std::max(1u, static_cast<uint32_t>(config.width * config.resolutionScale));
+            uint32_t height = std::max(1u, static_cast<uint32_t>(config.height * config.resolutionScale));
+            if (!state.texture || state.texture->GetWidth() != width || state.texture->GetHeight() != height)
+            {
+                TextureConfig texConfig = { .debugName = "CameraTarget",
+                                            .format = Format::RGBA8_UNORM,
+                                            .width = width,
+                                            .height = height,
+                                            .isRenderTarget = true,
+                                            .isShaderResource = true };
+                state.texture = Texture::Create(texConfig);
+                _BindRenderTarget(camData.entity, state.texture);
+            }
+
+            float aspectRatioToUse = config.useScreenSpaceAspectRatio ? mainAspectRatio : 0.0f;
+            _RenderSceneToTexture(scene, camData, deltaTime, allLights, state.texture, aspectRatioToUse);
+            state.lastRenderedFrame = _frameIndex;
+        }
+    }
+
+    void RendererSystem::_MarkRenderTargetSurfaces(const std::shared_ptr<Model>& model)
+    {
+        auto it = _renderTargetBindings.find(model.get());
+        if (it == _renderTargetBindings.end() || it->second.model.expired())
+        {
+            if (!model->HasMaterials())
+            {
+                return;
+            }
+
+            ModelRenderTargetBindings entry = { .model = model };
+            auto& materials = model->GetMaterials();
+            for (size_t i = 0; i < materials.size(); ++i)
+            {
+                if (materials[i].cameraRef == entt::null)
+                {
+                    continue;
+                }
+
+                entt::entity camera = static_cast<entt::entity>(materials[i].cameraRef);
+                entry.bindings.push_back({ i, camera });
+
+                auto state = _renderTargets.find(camera);
+                if (state != _renderTargets.end() && state->second.texture)
+                {
+                    materials[i].albedoTextures = { state->second.texture };
+                }
+            }
+            it = _renderTargetBindings.insert_or_assign(model.get(), std::move(entry)).first;
+        }
+
+        for (const RenderTargetBinding& binding : it->second.bindings)
+        {
+            auto state = _renderTargets.find(binding.camera);
+            if (state != _renderTargets.end())
+            {
+                state->second.lastVisibleFrame = _frameIndex;
+            }
+        }
+    }
+
+    void RendererSystem::_BindRenderTarget(entt::entity camera, const std::shared_ptr<Texture>& texture)
+    {
+        for (auto& [key, entry] : _renderTargetBindings)
+        {
+            std::shared_ptr<Model> model = entry.model.lock();
+            if (!model)
+            {
+                continue;
+            }
+
+            for (const RenderTargetBinding& binding : entry.bindings)
+            {
+                if (binding.camera == camera)
+                {
+                    model->GetMaterials()[binding.materialIndex].albedoTextures = { texture };
+                }
+            }
+        }
+    }
+
     std::shared_ptr<Texture> RendererSystem::_GetOrCreateEnvironmentTexture(const Component::EnvironmentMap& envMap)
     {
         std::string cacheKey;
@@ -383,59 +580,274 @@ namespace Frost
         return renderModel;
     }
 
-    void RendererSystem::_ApplyPostProcessing(CommandList* commandList,
-                                              Texture* sourceTexture,
-                                              Texture* destinationTarget,
-                                              const Camera& camera,
-                                              float deltaTime)
+    void RendererSystem::_CullOccluded(Scene& scene,
+                                       const Component::Camera& camera,
+                                       const Component::WorldTransform& cameraTransform,
+                                       const Math::Matrix4x4& viewProjectionMatrix)
     {
-        std::vector<std::shared_ptr<PostEffect>> postProcessingPasses;
+        const OcclusionSettings& settings = GetOcclusionSettings();
+        auto& registry = scene.GetRegistry();
+
+        _occluderCandidates.clear();
+        for (size_t i = 0; i < _visibleInstances.size(); ++i)
+        {
+            VisibleInstance& instance = _visibleInstances[i];
+            instance.worldBounds = BoundingBox::TransformAABB(instance.staticMesh->GetModel()->GetBoundingBox(),
+                                                              Math::LoadMatrix(*instance.worldMatrix));
+
+            const Occluder* occluder = registry.try_get<Occluder>(instance.entity);
+            if (occluder && !occluder->enabled)
+            {
+                continue;
+            }
+
+            float screenSize = LodSelector::GetScreenSize(instance.worldBounds, camera, cameraTransform.position);
+            if (occluder || screenSize >= settings.minOccluderScreenSize)
+            {
+                _occluderCandidates.push_back({ occluder != nullptr, screenSize, i });
+            }
+        }
+
+        // The designated occluders first, then the largest on screen
+        size_t occluderCount = std::min<size_t>(_occluderCandidates.size(), settings.maxOccluders);
+        std::partial_sort(_occluderCandidates.begin(),
+                          _occluderCandidates.begin() + occluderCount,
+                          _occluderCandidates.end(),
+                          [](const OccluderCandidate& a, const OccluderCandidate& b)
+                          { return std::tie(a.designated, a.screenSize) > std::tie(b.designated, b.screenSize); });
+
+        _occlusionCuller.BeginFrame(viewProjectionMatrix);
+        for (size_t i = 0; i < occluderCount; ++i)
+        {
+            const VisibleInstance& instance = _visibleInstances[_occluderCandidates[i].instance];
+            for (const Mesh& mesh : instance.staticMesh->GetModel()->GetMeshes())
+            {
+                _occlusionCuller.AddOccluder(
+                    mesh.GetOccluderPositions(), mesh.GetOccluderIndices(), *instance.worldMatrix);
+            }
+        }
+        _occlusionCuller.Rasterize();
+
+        // An occluder is never hidden by itself, its bounds are in front of its surface
+        size_t visibleCount = _visibleInstances.size();
+        std::erase_if(_visibleInstances,
+                      [this](const VisibleInstance& instance)
+                      { return !_occlusionCuller.IsVisible(instance.worldBounds); });
+
+        Debug::RendererConfig::occluderCount += static_cast<uint32_t>(_occlusionCuller.GetOccluderCount());
+        Debug::RendererConfig::occludedCount += static_cast<uint32_t>(visibleCount - _visibleInstances.size());
+    }
+
+    uint32_t RendererSystem::_SelectLod(const Component::StaticMesh& staticMesh,
+                                        const Math::Matrix4x4& worldMatrix,
+                                        const Component::Camera& camera,
+                                        const Component::WorldTransform& cameraTransform,
+                                        float viewportHeight) const
+    {
+        const Model& model = *staticMesh.GetModel();
+        if (!model.IsLoaded() || model.GetLodCount() <= 1)
+        {
+            return 0;
+        }
+
+        BoundingBox worldBounds = BoundingBox::TransformAABB(model.GetBoundingBox(), Math::LoadMatrix(worldMatrix));
+        float screenSize = LodSelector::GetScreenSize(worldBounds, camera, cameraTransform.position);
+        return LodSelector::Select(model, screenSize, viewportHeight, staticMesh.GetLod(), _lodSettings);
+    }
+
+    void RendererSystem::_RequestTextureMips(const Component::StaticMesh& staticMesh,
+                                             const Math::Matrix4x4& worldMatrix,
+                                             const Component::Camera& camera,
+                                             const Component::WorldTransform& cameraTransform,
+                                             float viewportHeight) const
+    {
+        const Model& model = *staticMesh.GetModel();
+        if (!model.IsLoaded())
+        {
+            return;
+        }
+
+        BoundingBox modelBounds = model.GetBoundingBox();
+        BoundingBox worldBounds = BoundingBox::TransformAABB(modelBounds, Math::LoadMatrix(worldMatrix));
+        Math::Vector3 boundsMin = { worldBounds.min.x, worldBounds.min.y, worldBounds.min.z };
+        Math::Vector3 boundsMax = { worldBounds.max.x, worldBounds.max.y, worldBounds.max.z };
+
+        // Pixels per world unit at the closest point of the bounds
+        float pixelsPerUnit = viewportHeight / camera.orthographicSize;
+        if (camera.projectionType == Component::Camera::ProjectionType::Perspective)
+        {
+            const Math::Vector3& eye = cameraTransform.position;
+            Math::Vector3 closest = { std::clamp(eye.x, boundsMin.x, boundsMax.x),
+                                      std::clamp(eye.y, boundsMin.y, boundsMax.y),
+                                      std::clamp(eye.z, boundsMin.z, boundsMax.z) };
+            float distance = std::max(Math::Length(closest - eye), camera.nearClip);
+            pixelsPerUnit = viewportHeight / (2.0f * distance * std::tan(camera.perspectiveFOV.value() * 0.5f));
+        }
+
+        // The UV densities are in model space
+        float modelDiagonal = Math::Length(Math::Vector3{ modelBounds.max.x - modelBounds.min.x,
+                                                          modelBounds.max.y - modelBounds.min.y,
+                                                          modelBounds.max.z - modelBounds.min.z });
+        if (modelDiagonal > 0.0f)
+        {
+            pixelsPerUnit *= Math::Length(boundsMax - boundsMin) / modelDiagonal;
+        }
+
+        const std::vector<Material>& materials = model.GetMaterials();
+        float mipBias = TextureStreamer::GetSettings().mipBias;
+        for (const Mesh& mesh : model.GetMeshes())
+        {
+            if (!mesh.enabled || mesh.GetMaterialIndex() >= materials.size())
+            {
+                continue;
+            }
+
+            const Material& material = materials[mesh.GetMaterialIndex()];
+            for (const auto* textures : { &material.albedoTextures,
+                                          &material.normalTextures,
+                                          &material.metallicTextures,
+                                          &material.roughnessTextures,
+                                          &material.aoTextures,
+                                          &material.emissiveTextures })
+            {
+                for (const std::shared_ptr<Texture>& texture : *textures)
+                {
+                    if (texture && texture->IsLoaded() && texture->IsStreamable())
+                    {
+                        uint32_t mip = TextureStreaming::ComputeRequiredMip(texture->GetWidth(),
+                                                                            texture->GetHeight(),
+                                                                            mesh.GetUVDensity(),
+                                                                            pixelsPerUnit,
+                                                                            mipBias);
+                        TextureStreamer::RequestMip(texture, mip);
+                    }
+                }
+            }
+        }
+    }
+
+    RendererSystem::GBufferHandles RendererSystem::_CreateGBuffer(RenderGraph::Builder& builder,
+                                                                  uint32_t width,
+                                                                  uint32_t height)
+    {
+        auto create = [&](const char* name,
+                          Format format,
+                          RenderGraph::ResourceState state = RenderGraph::ResourceState::RenderTarget)
+        { return builder.Create(name, { .format = format, .width = width, .height = height }, state); };
+
+        return {
+            .albedo = create("GBufferAlbedo", DeferredRenderingPipeline::ALBEDO_FORMAT),
+            .normal = create("GBufferNormal", DeferredRenderingPipeline::NORMAL_FORMAT),
+            .worldPosition = create("GBufferWorldPosition", DeferredRenderingPipeline::WORLD_POSITION_FORMAT),
+            .material = create("GBufferMaterial", DeferredRenderingPipeline::MATERIAL_FORMAT),
+            .emission = create("GBufferEmission", DeferredRenderingPipeline::EMISSION_FORMAT),
+            .depth = create("Depth", DeferredRenderingPipeline::DEPTH_FORMAT, RenderGraph::ResourceState::DepthWrite)
+        };
+    }
+
+    RenderGraph::TextureHandle RendererSystem::_AddPostProcessingPasses(RenderGraph::TextureHandle source,
+                                                                        RenderGraph::TextureHandle destination,
+                                                                        const GBufferHandles& gbuffer,
+                                                                        const Camera& camera,
+                                                                        float deltaTime)
+    {
+        std::vector<PostEffect*> postEffects;
         for (const auto& effect : camera.postEffects)
         {
             if (effect && effect->IsEnabled() && effect->IsPostProcessingPass())
             {
-                postProcessingPasses.push_back(effect);
+                postEffects.push_back(effect.get());
             }
         }
 
-        if (!postProcessingPasses.empty())
+        // Consecutive per-pixel effects share one fullscreen pass
+        std::vector<PostEffectChain::Pass> postProcessingPasses;
+        for (PostEffectChain::Pass& pass : PostEffectChain::Build(postEffects))
         {
-            uint32_t width = sourceTexture->GetWidth();
-            uint32_t height = sourceTexture->GetHeight();
-            if (!_source || _source->GetWidth() != width || _source->GetHeight() != height)
+            if (!pass.IsFused() || _fusedPostEffects.IsAvailable(pass))
             {
-                TextureConfig ppConfig = { .format = sourceTexture->GetFormat(),
-                                           .width = width,
-                                           .height = height,
-                                           .isRenderTarget = true,
-                                           .isShaderResource = true };
-                _source = Texture::Create(ppConfig);
-                _destination = Texture::Create(ppConfig);
+                postProcessingPasses.push_back(std::move(pass));
+                continue;
             }
 
-            Texture* source = sourceTexture;
-            Texture* destination = nullptr;
-
-            for (size_t i = 0; i < postProcessingPasses.size(); ++i)
+            // The generated shader did not compile, each effect falls back to its own pass
+            for (PostEffect* effect : pass.effects)
             {
-                destination = (i == postProcessingPasses.size() - 1)
-                                  ? destinationTarget
-                                  : ((i % 2 == 0) ? _destination.get() : _source.get());
-                postProcessingPasses[i]->SetNormalTexture(_deferredRendering.GetNormalTexture().get());
-                postProcessingPasses[i]->SetMaterialTexture(_deferredRendering.GetMaterialTexture().get());
-                postProcessingPasses[i]->SetDepthTexture(_deferredRendering.GetDepthStencilTexture().get());
-                postProcessingPasses[i]->OnPostRender(deltaTime, commandList, source, destination);
-                source = destination;
+                postProcessingPasses.push_back(PostEffectChain::Pass{ .effects = { effect } });
             }
         }
-        else
+
+        const RenderGraph::TextureDesc sourceDesc = _renderGraph.GetDesc(source);
+        if (postProcessingPasses.empty())
         {
-            if (destinationTarget->GetWidth() == sourceTexture->GetWidth() &&
-                destinationTarget->GetHeight() == sourceTexture->GetHeight())
+            const RenderGraph::TextureDesc& destinationDesc = _renderGraph.GetDesc(destination);
+            if (destinationDesc.width == sourceDesc.width && destinationDesc.height == sourceDesc.height)
             {
-                commandList->CopyResource(destinationTarget, sourceTexture);
+                _renderGraph.AddPass("CopyToTarget",
+                                     [&](RenderGraph::Builder& builder)
+                                     {
+                                         builder.Read(source, RenderGraph::ResourceState::CopySource);
+                                         destination = builder.Write(destination, RenderGraph::ResourceState::CopyDest);
+                                         return [source, destination](RenderGraph::Context& context)
+                                         {
+                                             context.GetCommandList()->CopyResource(context.GetTexture(destination),
+                                                                                    context.GetTexture(source));
+                                         };
+                                     });
             }
+            return destination;
         }
+
+        // Intermediate results are transient, the graph lets them share textures instead of a fixed ping-pong pair
+        for (size_t i = 0; i < postProcessingPasses.size(); ++i)
+        {
+            const PostEffectChain::Pass& pass = postProcessingPasses[i];
+            const bool isLast = i == postProcessingPasses.size() - 1;
+
+            _renderGraph.AddPass(
+                pass.IsFused() ? "FusedPostEffects" : pass.effects.front()->GetName(),
+                [&](RenderGraph::Builder& builder)
+                {
+                    // Effects may sample the G-buffer, it is handed to them once the graph has textures for it
+                    RenderGraph::TextureHandle normal = builder.Read(gbuffer.normal);
+                    RenderGraph::TextureHandle material = builder.Read(gbuffer.material);
+                    RenderGraph::TextureHandle depth = builder.Read(gbuffer.depth);
+                    RenderGraph::TextureHandle input = builder.Read(source);
+                    RenderGraph::TextureHandle output =
+                        isLast ? builder.Write(destination) : builder.Create("PostEffect", sourceDesc);
+
+                    if (isLast)
+                    {
+                        destination = output;
+                    }
+                    source = output;
+
+                    return [this, pass, normal, material, depth, input, output, deltaTime](
+                               RenderGraph::Context& context)
+                    {
+                        for (PostEffect* effect : pass.effects)
+                        {
+                            effect->SetNormalTexture(context.GetTexture(normal));
+                            effect->SetMaterialTexture(context.GetTexture(material));
+                            effect->SetDepthTexture(context.GetTexture(depth));
+                        }
+
+                        Texture* sourceTexture = context.GetTexture(input);
+                        Texture* destinationTexture = context.GetTexture(output);
+                        if (pass.IsFused())
+                        {
+                            _fusedPostEffects.Render(context.GetCommandList(), pass, sourceTexture, destinationTexture);
+                        }
+                        else
+                        {
+                            pass.effects.front()->OnPostRender(
+                                deltaTime, context.GetCommandList(), sourceTexture, destinationTexture);
+                        }
+                    };
+                });
+        }
+
+        return destination;
     }
 
     void RendererSystem::_RenderSceneToTexture(
@@ -452,7 +864,7 @@ namespace Frost
         if (!renderTarget)
             return;
 
-        auto meshView = scene.ViewActive<StaticMesh, WorldTransform>();
+        auto meshView = scene.ViewActive<StaticMesh, WorldMatrix>();
 
         float targetWidth = static_cast<float>(renderTarget->GetWidth());
         float targetHeight = static_cast<float>(renderTarget->GetHeight());
@@ -461,9 +873,6 @@ namespace Frost
 
         Viewport renderViewport = { 0.0f, 0.0f, targetWidth, targetHeight };
 
-        _deferredRendering.OnResize(static_cast<uint32_t>(targetWidth), static_cast<uint32_t>(targetHeight));
-        _shadowPipeline.OnResize(static_cast<uint32_t>(targetWidth), static_cast<uint32_t>(targetHeight));
-
         float aspectRatio = (renderViewport.height > 0) ? (renderViewport.width / renderViewport.height) : 1.0f;
         if (overrideAspectRatio > 0.0f)
         {
@@ -485,9 +894,11 @@ namespace Frost
         std::vector<std::pair<Component::Light, Component::WorldTransform>> visibleLights;
         auto lightView = scene.ViewActive<Light, WorldTransform>();
 
+        std::vector<entt::entity> visibleLightEntities;
         visibleLights.reserve(lightView.size_hint());
+        visibleLightEntities.reserve(lightView.size_hint());
         lightView.each(
-            [&](const Component::Light& light, const Component::WorldTransform& transform)
+            [&](entt::entity lightEntity, const Component::Light& light, const Component::WorldTransform& transform)
             {
                 bool isVisible = false;
                 switch (light.GetType())
@@ -522,27 +933,56 @@ namespace Frost
                     }
                 }
                 if (isVisible)
+                {
                     visibleLights.emplace_back(light, transform);
+                    visibleLightEntities.push_back(lightEntity);
+                }
             });
 
+        // Render target cameras draw outside the render graph, they borrow their targets from its pool
+        const uint32_t width = renderTarget->GetWidth();
+        const uint32_t height = renderTarget->GetHeight();
+        auto acquire = [&](Format format)
+        { return _transientTextures.Acquire({ .format = format, .width = width, .height = height }); };
+        const DeferredRenderingPipeline::GBuffer gbuffer = {
+            .albedo = acquire(DeferredRenderingPipeline::ALBEDO_FORMAT),
+            .normal = acquire(DeferredRenderingPipeline::NORMAL_FORMAT),
+            .worldPosition = acquire(DeferredRenderingPipeline::WORLD_POSITION_FORMAT),
+            .material = acquire(DeferredRenderingPipeline::MATERIAL_FORMAT),
+            .emission = acquire(DeferredRenderingPipeline::EMISSION_FORMAT),
+            .depth = acquire(DeferredRenderingPipeline::DEPTH_FORMAT)
+        };
+        const ShadowPipeline::LightTargets lightTargets = { .luminance1 = acquire(ShadowPipeline::LUMINANCE_FORMAT),
+                                                            .luminance2 = acquire(ShadowPipeline::LUMINANCE_FORMAT),
+                                                            .output = acquire(ShadowPipeline::OUTPUT_FORMAT) };
+        _deferredRendering.SetGBuffer(gbuffer);
+        _shadowPipeline.SetLightTargets(lightTargets);
+
         CommandList* commandList = _deferredRendering.GetCommandList();
         commandList->BeginRecording();
 
         _deferredRendering.BeginFrame(camera, cameraTransform, viewMatrix, projectionMatrix, renderViewport);
 
+        _drawItems.clear();
         meshView.each(
-            [&](const StaticMesh& staticMesh, const WorldTransform& meshTransform)
+            [&](const StaticMesh& staticMesh, const WorldMatrix& meshMatrix)
             {
                 if (staticMesh.GetModel())
                 {
-                    Math::Matrix4x4 worldMatrix = Math::GetTransformMatrix(meshTransform);
-                    _deferredRendering.SubmitModel(*staticMesh.GetModel(), worldMatrix);
+                    // The instance keeps the level of the main camera for the hysteresis
+                    uint32_t lod =
+                        _SelectLod(staticMesh, meshMatrix.matrix, camera, cameraTransform, renderViewport.height);
+                    _drawItems.push_back(
+                        { staticMesh.GetModel().get(), &meshMatrix.matrix, &staticMesh.GetPropertyBlock(), lod });
+                    _RequestTextureMips(
+                        staticMesh, meshMatrix.matrix, camera, cameraTransform, renderViewport.height);
                 }
             });
+        _deferredRendering.SubmitModels(_drawItems);
 
         _shadowPipeline.SetGBufferData(&_deferredRendering, &scene);
 
-        _shadowPipeline.ShadowPass(visibleLights, camera, cameraTransform, camera.viewport);
+        _shadowPipeline.ShadowPass(visibleLights, visibleLightEntities, camera, cameraTransform, camera.viewport);
         _shadowPipeline.LightPass(camera, cameraTransform, camera.viewport);
 
         std::shared_ptr<Texture> skyboxTexture = nullptr;
@@ -554,16 +994,25 @@ namespace Frost
 
         if (skyboxTexture)
         {
-            _skyboxPipeline.Render(commandList,
-                                   renderTarget.get(),
-                                   _deferredRendering.GetDepthStencilTexture().get(),
-                                   skyboxTexture.get(),
-                                   camera,
-                                   cameraTransform);
+            _skyboxPipeline.Render(
+                commandList, renderTarget.get(), gbuffer.depth, skyboxTexture.get(), camera, cameraTransform);
         }
 
         commandList->EndRecording();
         commandList->Execute();
+
+        for (Texture* texture : { gbuffer.albedo,
+                                  gbuffer.normal,
+                                  gbuffer.worldPosition,
+                                  gbuffer.material,
+                                  gbuffer.emission,
+                                  gbuffer.depth,
+                                  lightTargets.luminance1,
+                                  lightTargets.luminance2,
+                                  lightTargets.output })
+        {
+            _transientTextures.Release(texture);
+        }
     }
 
     std::shared_ptr<Texture> RendererSystem::_GetOrCreateSkyboxTexture(const Component::Skybox& skybox)
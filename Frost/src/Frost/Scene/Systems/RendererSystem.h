@@ -3,13 +3,19 @@
 #include "Frost/Asset/Texture.h"
 #include "Frost/Renderer/CommandList.h"
 #include "Frost/Renderer/Pipeline/DeferredRenderingPipeline.h"
+#include "Frost/Renderer/Pipeline/FusedPostEffectPipeline.h"
 #include "Frost/Renderer/Pipeline/SkyboxPipeline.h"
+#include "Frost/Renderer/RenderGraph.h"
+#include "Frost/Renderer/TransientTexturePool.h"
 #include "Frost/Scene/Components/Camera.h"
 #include "Frost/Scene/Components/Light.h"
 #include "Frost/Scene/Components/StaticMesh.h"
+#include "Frost/Scene/Components/WorldMatrix.h"
 #include "Frost/Scene/Components/WorldTransform.h"
 #include "Frost/Scene/Components/Skybox.h"
 #include "Frost/Renderer/Frustum.h"
+#include "Frost/Renderer/LodSelector.h"
+#include "Frost/Renderer/OcclusionCuller.h"
 #include "Frost/Scene/ECS/System.h"
 #include "Frost/Scene/Components/EnvironmentMap.h"
 
@@ -35,7 +41,76 @@ namespace Frost
         void SetRenderTargetOverride(std::shared_ptr<Texture> target) { _externalRenderTarget = target; }
         DeferredRenderingPipeline& GetPipeline() { return _deferredRendering; }
 
+        // Render target cameras rendered per frame at most, the ones waiting the longest go first
+        void SetRenderTargetCameraBudget(uint32_t budget) { _renderTargetCameraBudget = budget; }
+        uint32_t GetRenderTargetCameraBudget() const { return _renderTargetCameraBudget; }
+
+        void SetLodSettings(const LodSettings& settings);
+        const LodSettings& GetLodSettings() const { return _lodSettings; }
+
+        // Main cameras only, the shadow maps keep the casters the camera cannot see
+        void SetOcclusionSettings(const OcclusionSettings& settings) { _occlusionCuller.SetSettings(settings); }
+        const OcclusionSettings& GetOcclusionSettings() const { return _occlusionCuller.GetSettings(); }
+
     private:
+        struct RenderTargetState
+        {
+            std::shared_ptr<Texture> texture;
+            // Frame indices, 0 is never
+            uint64_t lastVisibleFrame = 0;
+            uint64_t lastRenderedFrame = 0;
+        };
+
+        struct RenderTargetBinding
+        {
+            size_t materialIndex;
+            entt::entity camera;
+        };
+
+        // Materials of a model showing a camera target, resolved once per model
+        struct ModelRenderTargetBindings
+        {
+            std::weak_ptr<Model> model;
+            std::vector<RenderTargetBinding> bindings;
+        };
+
+        // Instance left by the frustum culling, the bounds are only filled for the occlusion culling
+        struct VisibleInstance
+        {
+            entt::entity entity;
+            Component::StaticMesh* staticMesh;
+            const Math::Matrix4x4* worldMatrix;
+            BoundingBox worldBounds;
+        };
+
+        struct OccluderCandidate
+        {
+            bool designated;
+            float screenSize;
+            size_t instance;
+        };
+
+        // Transient G-buffer of the render graph, the latest version of each target
+        struct GBufferHandles
+        {
+            RenderGraph::TextureHandle albedo;
+            RenderGraph::TextureHandle normal;
+            RenderGraph::TextureHandle worldPosition;
+            RenderGraph::TextureHandle material;
+            RenderGraph::TextureHandle emission;
+            RenderGraph::TextureHandle depth;
+        };
+
+    private:
+        void _RenderTargetCameras(Scene& scene,
+                                  std::vector<RenderCameraData>& cameras,
+                                  float deltaTime,
+                                  const std::vector<std::pair<Component::Light, Component::WorldTransform>>& allLights,
+                                  float mainAspectRatio);
+        // Called for the meshes drawn by a main camera, their targets are worth rendering next frame
+        void _MarkRenderTargetSurfaces(const std::shared_ptr<Model>& model);
+        void _BindRenderTarget(entt::entity camera, const std::shared_ptr<Texture>& texture);
+
         void _RenderSceneToTexture(Scene& scene,
                                    const RenderCameraData& camData,
                                    float deltaTime,
@@ -43,28 +118,57 @@ namespace Frost
                                    const std::shared_ptr<Texture>& renderTarget,
                                    float overrideAspectRatio);
 
-        void _ApplyPostProcessing(CommandList* commandList,
-                                  Texture* sourceTexture,
-                                  Texture* destinationTarget,
-                                  const Component::Camera& camera,
-                                  float deltaTime);
+        // Declares the G-buffer targets as written by the pass being set up
+        static GBufferHandles _CreateGBuffer(RenderGraph::Builder& builder, uint32_t width, uint32_t height);
+        // Returns the last version of destination
+        RenderGraph::TextureHandle _AddPostProcessingPasses(RenderGraph::TextureHandle source,
+                                                            RenderGraph::TextureHandle destination,
+                                                            const GBufferHandles& gbuffer,
+                                                            const Component::Camera& camera,
+                                                            float deltaTime);
 
         bool _IsVisible(const Component::StaticMesh& staticMesh, const Math::Matrix4x4& worldMatrix);
+        // Rasterizes the occluders among the visible instances and removes the instances they hide
+        void _CullOccluded(Scene& scene,
+                           const Component::Camera& camera,
+                           const Component::WorldTransform& cameraTransform,
+                           const Math::Matrix4x4& viewProjectionMatrix);
+        uint32_t _SelectLod(const Component::StaticMesh& staticMesh,
+                            const Math::Matrix4x4& worldMatrix,
+                            const Component::Camera& camera,
+                            const Component::WorldTransform& cameraTransform,
+                            float viewportHeight) const;
+        // Asks the TextureStreamer for the mips the textures of the instance need at its distance
+        void _RequestTextureMips(const Component::StaticMesh& staticMesh,
+                                 const Math::Matrix4x4& worldMatrix,
+                                 const Component::Camera& camera,
+                                 const Component::WorldTransform& cameraTransform,
+                                 float viewportHeight) const;
         std::shared_ptr<Texture> _GetOrCreateEnvironmentTexture(const Component::EnvironmentMap& envMap);
 
     private:
         DeferredRenderingPipeline _deferredRendering;
         ShadowPipeline _shadowPipeline;
         SkyboxPipeline _skyboxPipeline;
+        FusedPostEffectPipeline _fusedPostEffects;
 
-        std::shared_ptr<Texture> _source;
-        std::shared_ptr<Texture> _destination;
+        RenderGraph _renderGraph;
+        TransientTexturePool _transientTextures;
+        // Meshes of the camera being drawn, reused every frame
+        std::vector<VisibleInstance> _visibleInstances;
+        std::vector<OccluderCandidate> _occluderCandidates;
+        std::vector<DeferredRenderingPipeline::DrawItem> _drawItems;
+        OcclusionCuller _occlusionCuller;
 
         std::shared_ptr<Texture> _externalRenderTarget = nullptr;
         std::shared_ptr<Texture> _GetOrCreateSkyboxTexture(const Component::Skybox& skybox);
 
         std::unordered_map<std::string, std::shared_ptr<Texture>> _skyboxTextureCache;
-        std::unordered_map<entt::entity, std::shared_ptr<Texture>> _renderTargetCache;
+        std::unordered_map<entt::entity, RenderTargetState> _renderTargets;
+        std::unordered_map<const Model*, ModelRenderTargetBindings> _renderTargetBindings;
+        uint32_t _renderTargetCameraBudget = 2;
+        LodSettings _lodSettings;
+        uint64_t _frameIndex = 0;
 
         uint32_t _viewportWidth = 0;
         uint32_t _viewportHeight = 0;
@@ -4,6 +4,8 @@
 #include "Frost/Scene/Components/Transform.h"
 #include "Frost/Scene/Components/WorldTransform.h"
 
+#include <algorithm>
+
 using namespace DirectX;
 using namespace Frost::Component;
 
@@ -37,6 +39,15 @@ namespace Frost
                 world.rotation = local.rotation;
                 world.scale = local.scale;
             });
+
+        // Physics reads parent matrices during the fixed update
+        _UpdateWorldMatrices(registry);
+    }
+
+    void WorldTransformSystem::LateUpdate(Scene& scene, float deltaTime)
+    {
+        // Scripts and physics may have written world transforms since the fixed update
+        _UpdateWorldMatrices(scene.GetRegistry());
     }
 
     void WorldTransformSystem::_UpdateHierarchy(entt::registry& registry,
@@ -83,4 +94,145 @@ namespace Frost
             }
         }
     }
-} // namespace Frost
\ No newline at end of file
+
+    void WorldTransformSystem::_UpdateWorldMatrices(entt::registry& registry)
+    {
+        // Entities that were not created through Scene::CreateGameObject
+        auto missingView = registry.view<WorldTransform>(entt::exclude<WorldMatrix>);
+        if (missingView.begin() != missingView.end())
+        {
+            std::vector<entt::entity> missing(missingView.begin(), missingView.end());
+            registry.insert<WorldMatrix>(missing.begin(), missing.end());
+        }
+
+        _GatherChangedTransforms(registry);
+        _BuildMatrices();
+    }
+
+    void WorldTransformSystem::_GatherChangedTransforms(entt::registry& registry)
+    {
+        _batch.Clear();
+
+        auto view = registry.view<WorldTransform, WorldMatrix>();
+        view.each(
+            [&](const WorldTransform& world, WorldMatrix& cached)
+            {
+                bool hasChanged = cached.isDirty || world.position.x != cached.position.x ||
+                                  world.position.y != cached.position.y || world.position.z != cached.position.z ||
+                                  world.rotation.x != cached.rotation.x || world.rotation.y != cached.rotation.y ||
+                                  world.rotation.z != cached.rotation.z || world.rotation.w != cached.rotation.w ||
+                                  world.scale.x != cached.scale.x || world.scale.y != cached.scale.y ||
+                                  world.scale.z != cached.scale.z;
+
+                if (hasChanged)
+                {
+                    cached.position = world.position;
+                    cached.rotation = world.rotation;
+                    cached.scale = world.scale;
+                    cached.isDirty = false;
+                    ++cached.version;
+                    _batch.Push(world, &cached);
+                }
+            });
+    }
+
+    void WorldTransformSystem::_BuildMatrices()
+    {
+        const size_t count = _batch.targets.size();
+        if (count == 0)
+            return;
+
+        // Identity padding so the last batch can be loaded whole
+        while (_batch.targets.size() % SIMD_WIDTH != 0)
+        {
+            _batch.Push(WorldTransform(), nullptr);
+        }
+
+        const XMVECTOR one = XMVectorSplatOne();
+        const XMVECTOR zero = XMVectorZero();
+
+        auto load = [](const std::vector<float>& values, size_t index)
+        { return XMLoadFloat4(reinterpret_cast<const XMFLOAT4*>(values.data() + index)); };
+
+        // Each lane is a different entity: S * R(q) * T written out component-wise, then transposed back
+        for (size_t i = 0; i < count; i += SIMD_WIDTH)
+        {
+            XMVECTOR qx = load(_batch.rotationX, i);
+            XMVECTOR qy = load(_batch.rotationY, i);
+            XMVECTOR qz = load(_batch.rotationZ, i);
+            XMVECTOR qw = load(_batch.rotationW, i);
+            XMVECTOR sx = load(_batch.scaleX, i);
+            XMVECTOR sy = load(_batch.scaleY, i);
+            XMVECTOR sz = load(_batch.scaleZ, i);
+
+            XMVECTOR x2 = XMVectorAdd(qx, qx);
+            XMVECTOR y2 = XMVectorAdd(qy, qy);
+            XMVECTOR z2 = XMVectorAdd(qz, qz);
+
+            XMVECTOR xx = XMVectorMultiply(qx, x2);
+            XMVECTOR yy = XMVectorMultiply(qy, y2);
+            XMVECTOR zz = XMVectorMultiply(qz, z2);
+            XMVECTOR xy = XMVectorMultiply(qx, y2);
+            XMVECTOR xz = XMVectorMultiply(qx, z2);
+            XMVECTOR yz = XMVectorMultiply(qy, z2);
+            XMVECTOR wx = XMVectorMultiply(qw, x2);
+            XMVECTOR wy = XMVectorMultiply(qw, y2);
+            XMVECTOR wz = XMVectorMultiply(qw, z2);
+
+            XMMATRIX row0 = XMMatrixTranspose(XMMATRIX(XMVectorMultiply(XMVectorSubtract(one, XMVectorAdd(yy, zz)), sx),
+                                                       XMVectorMultiply(XMVectorAdd(xy, wz), sx),
+                                                       XMVectorMultiply(XMVectorSubtract(xz, wy), sx),
+                                                       zero));
+            XMMATRIX row1 = XMMatrixTranspose(XMMATRIX(XMVectorMultiply(XMVectorSubtract(xy, wz), sy),
+                                                       XMVectorMultiply(XMVectorSubtract(one, XMVectorAdd(xx, zz)), sy),
+                                                       XMVectorMultiply(XMVectorAdd(yz, wx), sy),
+                                                       zero));
+            XMMATRIX row2 = XMMatrixTranspose(XMMATRIX(XMVectorMultiply(XMVectorAdd(xz, wy), sz),
+                                                       XMVectorMultiply(XMVectorSubtract(yz, wx), sz),
+                                                       XMVectorMultiply(XMVectorSubtract(one, XMVectorAdd(xx, yy)), sz),
+                                                       zero));
+            XMMATRIX row3 = XMMatrixTranspose(
+                XMMATRIX(load(_batch.positionX, i), load(_batch.positionY, i), load(_batch.positionZ, i), one));
+
+            const size_t lanes = std::min(SIMD_WIDTH, count - i);
+            for (size_t lane = 0; lane < lanes; ++lane)
+            {
+                XMFLOAT4* out = reinterpret_cast<XMFLOAT4*>(_batch.targets[i + lane]->matrix.elements.data());
+                XMStoreFloat4(out + 0, row0.r[lane]);
+                XMStoreFloat4(out + 1, row1.r[lane]);
+                XMStoreFloat4(out + 2, row2.r[lane]);
+                XMStoreFloat4(out + 3, row3.r[lane]);
+            }
+        }
+    }
+
+    void WorldTransformSystem::TransformBatch::Clear()
+    {
+        positionX.clear();
+        positionY.clear();
+        positionZ.clear();
+        rotationX.clear();
+        rotationY.clear();
+        rotationZ.clear();
+        rotationW.clear();
+        scaleX.clear();
+        scaleY.clear();
+        scaleZ.clear();
+        targets.clear();
+    }
+
+    void WorldTransformSystem::TransformBatch::Push(const WorldTransform& transform, WorldMatrix* target)
+    {
+        positionX.push_back(transform.position.x);
+        positionY.push_back(transform.position.y);
+        positionZ.push_back(transform.position.z);
+        rotationX.push_back(transform.rotation.x);
+        rotationY.push_back(transform.rotation.y);
+        rotationZ.push_back(transform.rotation.z);
+        rotationW.push_back(transform.rotation.w);
+        scaleX.push_back(transform.scale.x);
+        scaleY.push_back(transform.scale.y);
+        scaleZ.push_back(transform.scale.z);
+        targets.push_back(target);
+    }
+} // namespace Frost
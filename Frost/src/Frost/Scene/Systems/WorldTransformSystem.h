@@ -1,8 +1,11 @@
 #pragma once
 
+#include "Frost/Scene/Components/WorldMatrix.h"
+#include "Frost/Scene/Components/WorldTransform.h"
 #include "Frost/Scene/ECS/System.h"
 
 #include <DirectXMath.h>
+#include <vector>
 
 namespace Frost
 {
@@ -11,6 +14,7 @@ namespace Frost
     public:
         WorldTransformSystem();
         void PreFixedUpdate(Scene& scene, float deltaTime) override;
+        void LateUpdate(Scene& scene, float deltaTime) override;
 
     private:
         void _UpdateHierarchy(entt::registry& registry,
@@ -18,5 +22,26 @@ namespace Frost
                               DirectX::XMVECTOR parentPosition,
                               DirectX::XMVECTOR parentRotation,
                               DirectX::XMVECTOR parentScale);
+
+        void _UpdateWorldMatrices(entt::registry& registry);
+        void _GatherChangedTransforms(entt::registry& registry);
+        void _BuildMatrices();
+
+    private:
+        // Changed world transforms laid out as structure of arrays, padded to a multiple of the SIMD width
+        struct TransformBatch
+        {
+            std::vector<float> positionX, positionY, positionZ;
+            std::vector<float> rotationX, rotationY, rotationZ, rotationW;
+            std::vector<float> scaleX, scaleY, scaleZ;
+            std::vector<Component::WorldMatrix*> targets;
+
+            void Clear();
+            void Push(const Component::WorldTransform& transform, Component::WorldMatrix* target);
+        };
+
+        TransformBatch _batch;
+
+        static constexpr size_t SIMD_WIDTH = 4;
     };
 } // namespace Frost
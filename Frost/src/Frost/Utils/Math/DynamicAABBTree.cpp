@@ -0,0 +1,328 @@
+#include "Frost/Utils/Math/DynamicAABBTree.h"
+
+#include <algorithm>
+
+namespace Frost::Math
+{
+    namespace
+    {
+        BoundingBox Union(const BoundingBox& a, const BoundingBox& b)
+        {
+            BoundingBox result = a;
+            result.Merge(b);
+            return result;
+        }
+
+        float HalfSurfaceArea(const BoundingBox& box)
+        {
+            float x = box.max.x - box.min.x;
+            float y = box.max.y - box.min.y;
+            float z = box.max.z - box.min.z;
+            return x * y + y * z + z * x;
+        }
+
+        bool Contains(const BoundingBox& outer, const BoundingBox& inner)
+        {
+            return outer.min.x <= inner.min.x && outer.min.y <= inner.min.y && outer.min.z <= inner.min.z &&
+                   outer.max.x >= inner.max.x && outer.max.y >= inner.max.y && outer.max.z >= inner.max.z;
+        }
+
+        BoundingBox Fatten(const BoundingBox& box)
+        {
+            constexpr float margin = DynamicAABBTree::FAT_MARGIN;
+            return { { box.min.x - margin, box.min.y - margin, box.min.z - margin },
+                     { box.max.x + margin, box.max.y + margin, box.max.z + margin } };
+        }
+    } // namespace
+
+    int32_t DynamicAABBTree::CreateProxy(const BoundingBox& bounds, uint64_t userData)
+    {
+        int32_t proxy = _AllocateNode();
+        _nodes[proxy].bounds = Fatten(bounds);
+        _nodes[proxy].userData = userData;
+        _nodes[proxy].height = 0;
+
+        _InsertLeaf(proxy);
+        ++_proxyCount;
+        return proxy;
+    }
+
+    void DynamicAABBTree::DestroyProxy(int32_t proxy)
+    {
+        _RemoveLeaf(proxy);
+        _FreeNode(proxy);
+        --_proxyCount;
+    }
+
+    bool DynamicAABBTree::MoveProxy(int32_t proxy, const BoundingBox& bounds)
+    {
+        BoundingBox fatBounds = Fatten(bounds);
+
+        // A proxy that shrank a lot is reinserted as well, so that its old box does not keep catching rays
+        const BoundingBox& current = _nodes[proxy].bounds;
+        if (Contains(current, bounds) && HalfSurfaceArea(current) <= 4.0f * HalfSurfaceArea(fatBounds))
+        {
+            return false;
+        }
+
+        _RemoveLeaf(proxy);
+        _nodes[proxy].bounds = fatBounds;
+        _InsertLeaf(proxy);
+        return true;
+    }
+
+    void DynamicAABBTree::Clear()
+    {
+        _nodes.clear();
+        _root = NULL_NODE;
+        _freeList = NULL_NODE;
+        _proxyCount = 0;
+    }
+
+    int32_t DynamicAABBTree::_AllocateNode()
+    {
+        if (_freeList == NULL_NODE)
+        {
+            _nodes.emplace_back();
+            return static_cast<int32_t>(_nodes.size() - 1);
+        }
+
+        int32_t node = _freeList;
+        _freeList = _nodes[node].parent;
+        _nodes[node] = Node{};
+        return node;
+    }
+
+    void DynamicAABBTree::_FreeNode(int32_t node)
+    {
+        _nodes[node].parent = _freeList;
+        _nodes[node].height = -1;
+        _freeList = node;
+    }
+
+    void DynamicAABBTree::_InsertLeaf(int32_t leaf)
+    {
+        if (_root == NULL_NODE)
+        {
+            _root = leaf;
+            _nodes[leaf].parent = NULL_NODE;
+            return;
+        }
+
+        // Walk down towards the sibling that grows the tree surface the least
+        const BoundingBox leafBounds = _nodes[leaf].bounds;
+        int32_t index = _root;
+        while (!_nodes[index].IsLeaf())
+        {
+            const Node& node = _nodes[index];
+            float area = HalfSurfaceArea(node.bounds);
+            float combinedArea = HalfSurfaceArea(Union(node.bounds, leafBounds));
+
+            // Pairing with this node creates a parent, descending makes every node on the way grow
+            float cost = 2.0f * combinedArea;
+            float inheritanceCost = 2.0f * (combinedArea - area);
+
+            auto descendCost = [&](int32_t child)
+            {
+                const BoundingBox& childBounds = _nodes[child].bounds;
+                float grownArea = HalfSurfaceArea(Union(childBounds, leafBounds));
+                float childCost = _nodes[child].IsLeaf() ? grownArea : grownArea - HalfSurfaceArea(childBounds);
+                return childCost + inheritanceCost;
+            };
+
+            float cost1 = descendCost(node.child1);
+            float cost2 = descendCost(node.child2);
+
+            if (cost < cost1 && cost < cost2)
+            {
+                break;
+            }
+
+            index = cost1 < cost2 ? node.child1 : node.child2;
+        }
+
+        int32_t sibling = index;
+        int32_t oldParent = _nodes[sibling].parent;
+
+        int32_t newParent = _AllocateNode();
+        _nodes[newParent].parent = oldParent;
+        _nodes[newParent].bounds = Union(leafBounds, _nodes[sibling].bounds);
+        _nodes[newParent].height = _nodes[sibling].height + 1;
+        _nodes[newParent].child1 = sibling;
+        _nodes[newParent].child2 = leaf;
+        _nodes[sibling].parent = newParent;
+        _nodes[leaf].parent = newParent;
+
+        if (oldParent == NULL_NODE)
+        {
+            _root = newParent;
+        }
+        else if (_nodes[oldParent].child1 == sibling)
+        {
+            _nodes[oldParent].child1 = newParent;
+        }
+        else
+        {
+            _nodes[oldParent].child2 = newParent;
+        }
+
+        _RefitAncestors(oldParent);
+    }
+
+    void DynamicAABBTree::_RemoveLeaf(int32_t leaf)
+    {
+        if (leaf == _root)
+        {
+            _root = NULL_NODE;
+            return;
+        }
+
+        int32_t parent = _nodes[leaf].parent;
+        int32_t grandParent = _nodes[parent].parent;
+        int32_t sibling = _nodes[parent].child1 == leaf ? _nodes[parent].child2 : _nodes[parent].child1;
+
+        _FreeNode(parent);
+        _nodes[sibling].parent = grandParent;
+
+        if (grandParent == NULL_NODE)
+        {
+            _root = sibling;
+            return;
+        }
+
+        if (_nodes[grandParent].child1 == parent)
+        {
+            _nodes[grandParent].child1 = sibling;
+        }
+        else
+        {
+            _nodes[grandParent].child2 = sibling;
+        }
+
+        _RefitAncestors(grandParent);
+    }
+
+    void DynamicAABBTree::_RefitAncestors(int32_t node)
+    {
+        while (node != NULL_NODE)
+        {
+            node = _Balance(node);
+
+            Node& current = _nodes[node];
+            const Node& child1 = _nodes[current.child1];
+            const Node& child2 = _nodes[current.child2];
+            current.height = 1 + std::max(child1.height, child2.height);
+            current.bounds = Union(child1.bounds, child2.bounds);
+
+            node = current.parent;
+        }
+    }
+
+    int32_t DynamicAABBTree::_Balance(int32_t iA)
+    {
+        Node& A = _nodes[iA];
+        if (A.IsLeaf() || A.height < 2)
+        {
+            return iA;
+        }
+
+        int32_t iB = A.child1;
+        int32_t iC = A.child2;
+        Node& B = _nodes[iB];
+        Node& C = _nodes[iC];
+
+        // Promotes the taller child of A to the place of A, A takes its shorter grandchild
+        auto replaceInParent = [&](int32_t oldChild, int32_t newChild)
+        {
+            int32_t parent = _nodes[newChild].parent;
+            if (parent == NULL_NODE)
+            {
+                _root = newChild;
+            }
+            else if (_nodes[parent].child1 == oldChild)
+            {
+                _nodes[parent].child1 = newChild;
+            }
+            else
+            {
+                _nodes[parent].child2 = newChild;
+            }
+        };
+
+        int32_t balance = C.height - B.height;
+
+        if (balance > 1)
+        {
+            int32_t iF = C.child1;
+            int32_t iG = C.child2;
+            Node& F = _nodes[iF];
+            Node& G = _nodes[iG];
+
+            C.child1 = iA;
+            C.parent = A.parent;
+            A.parent = iC;
+            replaceInParent(iA, iC);
+
+            if (F.height > G.height)
+            {
+                C.child2 = iF;
+                A.child2 = iG;
+                G.parent = iA;
+                A.bounds = Union(B.bounds, G.bounds);
+                C.bounds = Union(A.bounds, F.bounds);
+                A.height = 1 + std::max(B.height, G.height);
+                C.height = 1 + std::max(A.height, F.height);
+            }
+            else
+            {
+                C.child2 = iG;
+                A.child2 = iF;
+                F.parent = iA;
+                A.bounds = Union(B.bounds, F.bounds);
+                C.bounds = Union(A.bounds, G.bounds);
+                A.height = 1 + std::max(B.height, F.height);
+                C.height = 1 + std::max(A.height, G.height);
+            }
+
+            return iC;
+        }
+
+        if (balance < -1)
+        {
+            int32_t iD = B.child1;
+            int32_t iE = B.child2;
+            Node& D = _nodes[iD];
+            Node& E = _nodes[iE];
+
+            B.child1 = iA;
+            B.parent = A.parent;
+            A.parent = iB;
+            replaceInParent(iA, iB);
+
+            if (D.height > E.height)
+            {
+                B.child2 = iD;
+                A.child1 = iE;
+                E.parent = iA;
+                A.bounds = Union(C.bounds, E.bounds);
+                B.bounds = Union(A.bounds, D.bounds);
+                A.height = 1 + std::max(C.height, E.height);
+                B.height = 1 + std::max(A.height, D.height);
+            }
+            else
+            {
+                B.child2 = iE;
+                A.child1 = iD;
+                D.parent = iA;
+                A.bounds = Union(C.bounds, D.bounds);
+                B.bounds = Union(A.bounds, E.bounds);
+                A.height = 1 + std::max(C.height, D.height);
+                B.height = 1 + std::max(A.height, E.height);
+            }
+
+            return iB;
+        }
+
+        return iA;
+    }
+} // namespace Frost::Math
@@ -0,0 +1,110 @@
+#pragma once
+
+#include "Frost/Core/Core.h"
+#include "Frost/Renderer/BoundingBox.h"
+#include "Frost/Utils/Math/Intersection.h"
+#include "Frost/Utils/Math/Vector.h"
+
+#include <cstdint>
+#include <vector>
+
+namespace Frost::Math
+{
+    // Bounding volume hierarchy over boxes that move, kept balanced by rotations as proxies are inserted and removed.
+    // Each proxy is stored with a slightly larger box, so a proxy moving by less than the margin is left in place.
+    class FROST_API DynamicAABBTree
+    {
+    public:
+        static constexpr int32_t NULL_NODE = -1;
+        static constexpr float FAT_MARGIN = 0.1f;
+
+        int32_t CreateProxy(const BoundingBox& bounds, uint64_t userData);
+        void DestroyProxy(int32_t proxy);
+        // Returns true when the proxy left its fattened box and was reinserted
+        bool MoveProxy(int32_t proxy, const BoundingBox& bounds);
+        void Clear();
+
+        uint64_t GetUserData(int32_t proxy) const { return _nodes[proxy].userData; }
+        const BoundingBox& GetFatBounds(int32_t proxy) const { return _nodes[proxy].bounds; }
+        uint32_t GetProxyCount() const { return _proxyCount; }
+        int32_t GetHeight() const { return _root == NULL_NODE ? 0 : _nodes[_root].height; }
+
+        // Calls callback(userData, maxDistance) for each proxy whose box the ray enters before maxDistance. The
+        // callback returns the new max distance: its hit distance to clip the ray, the value it got to go on unchanged,
+        // or 0 to stop.
+        template<typename Callback>
+        void Raycast(const Ray& ray, float maxDistance, Callback&& callback) const;
+
+    private:
+        struct Node
+        {
+            BoundingBox bounds;
+            uint64_t userData = 0;
+            // Next free node while the node is in the free list
+            int32_t parent = NULL_NODE;
+            int32_t child1 = NULL_NODE;
+            int32_t child2 = NULL_NODE;
+            // 0 for leaves, -1 for free nodes
+            int32_t height = -1;
+
+            bool IsLeaf() const { return child1 == NULL_NODE; }
+        };
+
+        int32_t _AllocateNode();
+        void _FreeNode(int32_t node);
+
+        void _InsertLeaf(int32_t leaf);
+        void _RemoveLeaf(int32_t leaf);
+        // Rotates the subtree under node if its children heights differ by more than one, returns its new root
+        int32_t _Balance(int32_t node);
+        void _RefitAncestors(int32_t node);
+
+    private:
+        std::vector<Node> _nodes;
+        int32_t _root = NULL_NODE;
+        int32_t _freeList = NULL_NODE;
+        uint32_t _proxyCount = 0;
+    };
+
+    template<typename Callback>
+    void DynamicAABBTree::Raycast(const Ray& ray, float maxDistance, Callback&& callback) const
+    {
+        if (_root == NULL_NODE)
+        {
+            return;
+        }
+
+        Vector3 inverseDirection = InverseDirection(ray.direction);
+
+        // The tree is balanced, so the stack stays around twice the log of the proxy count
+        std::vector<int32_t> stack;
+        stack.reserve(64);
+        stack.push_back(_root);
+
+        while (!stack.empty())
+        {
+            int32_t nodeIndex = stack.back();
+            stack.pop_back();
+
+            const Node& node = _nodes[nodeIndex];
+            float entry;
+            if (!IntersectRayAABB(ray, inverseDirection, node.bounds.min, node.bounds.max, maxDistance, entry))
+            {
+                continue;
+            }
+
+            if (node.IsLeaf())
+            {
+                maxDistance = callback(node.userData, maxDistance);
+                if (maxDistance <= 0.0f)
+                {
+                    return;
+                }
+                continue;
+            }
+
+            stack.push_back(node.child1);
+            stack.push_back(node.child2);
+        }
+    }
+} // namespace Frost::Math
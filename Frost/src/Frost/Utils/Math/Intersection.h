@@ -2,6 +2,8 @@
 
 #include "Frost/Utils/Math/Vector.h"
 
+#include <algorithm>
+#include <cmath>
 #include <limits>
 
 namespace Frost::Math
@@ -151,4 +153,70 @@ namespace Frost::Math
 
         return t > 0.0f;
     }
+
+    // Both faces are hit, the direction does not need to be normalized. u and v weight v1 and v2 at the hit point.
+    inline bool IntersectRayTriangle(const Ray& ray,
+                                     const Vector3& v0,
+                                     const Vector3& v1,
+                                     const Vector3& v2,
+                                     float& t,
+                                     float& u,
+                                     float& v)
+    {
+        Vector3 edge1 = v1 - v0;
+        Vector3 edge2 = v2 - v0;
+        Vector3 h = Cross(ray.direction, edge2);
+        float a = Dot(edge1, h);
+
+        if (a > -1e-8f && a < 1e-8f)
+            return false;
+
+        float f = 1.0f / a;
+        Vector3 s = ray.origin - v0;
+        u = f * Dot(s, h);
+
+        if (u < 0.0f || u > 1.0f)
+            return false;
+
+        Vector3 q = Cross(s, edge1);
+        v = f * Dot(ray.direction, q);
+
+        if (v < 0.0f || u + v > 1.0f)
+            return false;
+
+        t = f * Dot(edge2, q);
+        return t > 1e-6f;
+    }
+
+    // Slab test, t is where the ray enters the box, or 0 when it starts inside
+    inline bool IntersectRayAABB(const Ray& ray,
+                                 const Vector3& inverseDirection,
+                                 const Vector3& boxMin,
+                                 const Vector3& boxMax,
+                                 float maxDistance,
+                                 float& t)
+    {
+        float tMin = 0.0f;
+        float tMax = maxDistance;
+
+        for (int axis = 0; axis < 3; ++axis)
+        {
+            float t1 = (boxMin.values[axis] - ray.origin.values[axis]) * inverseDirection.values[axis];
+            float t2 = (boxMax.values[axis] - ray.origin.values[axis]) * inverseDirection.values[axis];
+
+            tMin = std::max(tMin, std::min(t1, t2));
+            tMax = std::min(tMax, std::max(t1, t2));
+        }
+
+        t = tMin;
+        return tMin <= tMax;
+    }
+
+    // Components of a zero direction give a huge value instead of an infinity, so that the slab test never sees 0 * inf
+    inline Vector3 InverseDirection(const Vector3& direction)
+    {
+        auto inverse = [](float value)
+        { return std::abs(value) > 1e-12f ? 1.0f / value : std::copysign(1e30f, value); };
+        return { inverse(direction.x), inverse(direction.y), inverse(direction.z) };
+    }
 } // namespace Frost::Math
\ No newline at end of file
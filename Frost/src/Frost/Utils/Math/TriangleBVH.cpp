@@ -0,0 +1,304 @@
+#include "Frost/Utils/Math/TriangleBVH.h"
+
+#include <array>
+#include <cfloat>
+#include <utility>
+
+namespace Frost::Math
+{
+    namespace
+    {
+        Vector3 Min(const Vector3& a, const Vector3& b)
+        {
+            return { std::min(a.x, b.x), std::min(a.y, b.y), std::min(a.z, b.z) };
+        }
+
+        Vector3 Max(const Vector3& a, const Vector3& b)
+        {
+            return { std::max(a.x, b.x), std::max(a.y, b.y), std::max(a.z, b.z) };
+        }
+
+        float HalfSurfaceArea(const Vector3& boundsMin, const Vector3& boundsMax)
+        {
+            Vector3 extent = boundsMax - boundsMin;
+            return extent.x * extent.y + extent.y * extent.z + extent.z * extent.x;
+        }
+    } // namespace
+
+    TriangleBVH::TriangleBVH(std::span<const Vector3> positions, std::span<const uint32_t> indices)
+    {
+        size_t triangleCount = indices.size() / 3;
+        _triangles.reserve(triangleCount);
+        _triangleIds.reserve(triangleCount);
+
+        std::vector<Vector3> centroids;
+        centroids.reserve(triangleCount);
+
+        for (size_t i = 0; i < triangleCount; ++i)
+        {
+            uint32_t i0 = indices[i * 3 + 0];
+            uint32_t i1 = indices[i * 3 + 1];
+            uint32_t i2 = indices[i * 3 + 2];
+
+            // Triangles referencing missing vertices cannot be hit
+            if (i0 >= positions.size() || i1 >= positions.size() || i2 >= positions.size())
+            {
+                continue;
+            }
+
+            _triangles.push_back({ positions[i0], positions[i1], positions[i2] });
+            _triangleIds.push_back(static_cast<uint32_t>(i));
+            centroids.push_back((positions[i0] + positions[i1] + positions[i2]) / 3.0f);
+        }
+
+        if (!_triangles.empty())
+        {
+            _Build(centroids);
+        }
+    }
+
+    bool TriangleBVH::Raycast(const Ray& ray, float maxDistance, Hit& hit) const
+    {
+        if (_nodes.empty())
+        {
+            return false;
+        }
+
+        Vector3 inverseDirection = InverseDirection(ray.direction);
+        float closest = maxDistance;
+        bool hasHit = false;
+
+        float entry;
+        if (!IntersectRayAABB(ray, inverseDirection, _nodes[0].boundsMin, _nodes[0].boundsMax, closest, entry))
+        {
+            return false;
+        }
+
+        // The farther child is pushed first, so the nearer one is visited first and shortens the ray sooner
+        std::array<uint32_t, MAX_DEPTH + 2> stack;
+        uint32_t stackSize = 0;
+        stack[stackSize++] = 0;
+
+        while (stackSize > 0)
+        {
+            const Node& node = _nodes[stack[--stackSize]];
+
+            if (node.triangleCount > 0)
+            {
+                for (uint32_t i = node.firstOrChild; i < node.firstOrChild + node.triangleCount; ++i)
+                {
+                    const Triangle& triangle = _triangles[i];
+                    float t, u, v;
+                    if (IntersectRayTriangle(ray, triangle.v0, triangle.v1, triangle.v2, t, u, v) && t < closest)
+                    {
+                        closest = t;
+                        hasHit = true;
+                        hit.triangle = _triangleIds[i];
+                        hit.t = t;
+                        hit.u = u;
+                        hit.v = v;
+                        hit.normal = Cross(triangle.v1 - triangle.v0, triangle.v2 - triangle.v0);
+                    }
+                }
+                continue;
+            }
+
+            uint32_t children[2] = { node.firstOrChild, node.firstOrChild + 1 };
+            float distances[2];
+            bool hits[2];
+            for (int c = 0; c < 2; ++c)
+            {
+                const Node& child = _nodes[children[c]];
+                hits[c] =
+                    IntersectRayAABB(ray, inverseDirection, child.boundsMin, child.boundsMax, closest, distances[c]);
+            }
+
+            if (hits[0] && hits[1])
+            {
+                int nearest = distances[0] <= distances[1] ? 0 : 1;
+                stack[stackSize++] = children[1 - nearest];
+                stack[stackSize++] = children[nearest];
+            }
+            else if (hits[0] || hits[1])
+            {
+                stack[stackSize++] = children[hits[0] ? 0 : 1];
+            }
+        }
+
+        return hasHit;
+    }
+
+    void TriangleBVH::_Build(std::vector<Vector3>& centroids)
+    {
+        _nodes.reserve(_triangles.size() * 2 - 1);
+
+        Node root;
+        root.triangleCount = static_cast<uint32_t>(_triangles.size());
+        _ComputeBounds(root);
+        _nodes.push_back(root);
+
+        std::vector<std::pair<uint32_t, uint32_t>> pending = { { 0, 0 } };
+        while (!pending.empty())
+        {
+            auto [nodeIndex, depth] = pending.back();
+            pending.pop_back();
+
+            // Copied, the pushes below may move the nodes
+            Node node = _nodes[nodeIndex];
+            if (node.triangleCount <= MAX_LEAF_TRIANGLES || depth >= MAX_DEPTH)
+            {
+                continue;
+            }
+
+            uint32_t leftCount = _Split(node, centroids);
+            if (leftCount == 0)
+            {
+                continue;
+            }
+
+            Node left;
+            left.firstOrChild = node.firstOrChild;
+            left.triangleCount = leftCount;
+            _ComputeBounds(left);
+
+            Node right;
+            right.firstOrChild = node.firstOrChild + leftCount;
+            right.triangleCount = node.triangleCount - leftCount;
+            _ComputeBounds(right);
+
+            uint32_t leftIndex = static_cast<uint32_t>(_nodes.size());
+            _nodes.push_back(left);
+            _nodes.push_back(right);
+
+            _nodes[nodeIndex].firstOrChild = leftIndex;
+            _nodes[nodeIndex].triangleCount = 0;
+
+            pending.emplace_back(leftIndex, depth + 1);
+            pending.emplace_back(leftIndex + 1, depth + 1);
+        }
+    }
+
+    void TriangleBVH::_ComputeBounds(Node& node) const
+    {
+        node.boundsMin = { FLT_MAX, FLT_MAX, FLT_MAX };
+        node.boundsMax = { -FLT_MAX, -FLT_MAX, -FLT_MAX };
+
+        for (uint32_t i = node.firstOrChild; i < node.firstOrChild + node.triangleCount; ++i)
+        {
+            const Triangle& triangle = _triangles[i];
+            node.boundsMin = Min(node.boundsMin, Min(triangle.v0, Min(triangle.v1, triangle.v2)));
+            node.boundsMax = Max(node.boundsMax, Max(triangle.v0, Max(triangle.v1, triangle.v2)));
+        }
+    }
+
+    uint32_t TriangleBVH::_Split(const Node& node, std::vector<Vector3>& centroids)
+    {
+        const uint32_t first = node.firstOrChild;
+        const uint32_t count = node.triangleCount;
+
+        Vector3 centroidMin = { FLT_MAX, FLT_MAX, FLT_MAX };
+        Vector3 centroidMax = { -FLT_MAX, -FLT_MAX, -FLT_MAX };
+        for (uint32_t i = first; i < first + count; ++i)
+        {
+            centroidMin = Min(centroidMin, centroids[i]);
+            centroidMax = Max(centroidMax, centroids[i]);
+        }
+
+        Vector3 extent = centroidMax - centroidMin;
+        int axis = 0;
+        if (extent.y > extent.values[axis])
+            axis = 1;
+        if (extent.z > extent.values[axis])
+            axis = 2;
+
+        // Every centroid at the same place, no plane separates them
+        if (extent.values[axis] <= 1e-12f)
+        {
+            return count > MAX_FORCED_LEAF_TRIANGLES ? count / 2 : 0;
+        }
+
+        // Surface area heuristic evaluated on the planes between bins of centroids
+        struct Bin
+        {
+            Vector3 boundsMin = { FLT_MAX, FLT_MAX, FLT_MAX };
+            Vector3 boundsMax = { -FLT_MAX, -FLT_MAX, -FLT_MAX };
+            uint32_t count = 0;
+        };
+
+        float binScale = SPLIT_BIN_COUNT / extent.values[axis];
+        auto binOf = [&](const Vector3& centroid)
+        {
+            uint32_t bin = static_cast<uint32_t>((centroid.values[axis] - centroidMin.values[axis]) * binScale);
+            return std::min(bin, SPLIT_BIN_COUNT - 1);
+        };
+
+        std::array<Bin, SPLIT_BIN_COUNT> bins;
+        for (uint32_t i = first; i < first + count; ++i)
+        {
+            Bin& bin = bins[binOf(centroids[i])];
+            const Triangle& triangle = _triangles[i];
+            bin.boundsMin = Min(bin.boundsMin, Min(triangle.v0, Min(triangle.v1, triangle.v2)));
+            bin.boundsMax = Max(bin.boundsMax, Max(triangle.v0, Max(triangle.v1, triangle.v2)));
+            ++bin.count;
+        }
+
+        // Plane p puts the bins before p on the left
+        std::array<float, SPLIT_BIN_COUNT> leftCosts{};
+        Bin left;
+        for (uint32_t p = 1; p < SPLIT_BIN_COUNT; ++p)
+        {
+            const Bin& bin = bins[p - 1];
+            left.boundsMin = Min(left.boundsMin, bin.boundsMin);
+            left.boundsMax = Max(left.boundsMax, bin.boundsMax);
+            left.count += bin.count;
+            leftCosts[p] = left.count > 0 ? left.count * HalfSurfaceArea(left.boundsMin, left.boundsMax) : 0.0f;
+        }
+
+        float bestCost = FLT_MAX;
+        uint32_t bestPlane = 0;
+        Bin right;
+        for (uint32_t p = SPLIT_BIN_COUNT - 1; p > 0; --p)
+        {
+            const Bin& bin = bins[p];
+            right.boundsMin = Min(right.boundsMin, bin.boundsMin);
+            right.boundsMax = Max(right.boundsMax, bin.boundsMax);
+            right.count += bin.count;
+
+            if (right.count == 0 || right.count == count)
+            {
+                continue;
+            }
+
+            float cost = leftCosts[p] + right.count * HalfSurfaceArea(right.boundsMin, right.boundsMax);
+            if (cost < bestCost)
+            {
+                bestCost = cost;
+                bestPlane = p;
+            }
+        }
+
+        float leafCost = count * HalfSurfaceArea(node.boundsMin, node.boundsMax);
+        if (bestPlane == 0 || (bestCost >= leafCost && count <= MAX_FORCED_LEAF_TRIANGLES))
+        {
+            return 0;
+        }
+
+        uint32_t i = first;
+        uint32_t j = first + count;
+        while (i < j)
+        {
+            if (binOf(centroids[i]) < bestPlane)
+            {
+                ++i;
+                continue;
+            }
+
+            --j;
+            std::swap(_triangles[i], _triangles[j]);
+            std::swap(_triangleIds[i], _triangleIds[j]);
+            std::swap(centroids[i], centroids[j]);
+        }
+
+        return i - first;
+    }
+} // namespace Frost::Math
@@ -0,0 +1,80 @@
+#pragma once
+
+#include "Frost/Core/Core.h"
+#include "Frost/Utils/Math/Intersection.h"
+#include "Frost/Utils/Math/Vector.h"
+
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace Frost::Math
+{
+    // Bounding volume hierarchy over the triangles of a mesh, for ray queries on the CPU. It keeps its own copy of the
+    // triangles, sorted in leaf order, so the source buffers can go away once it is built.
+    class FROST_API TriangleBVH
+    {
+    public:
+        struct Hit
+        {
+            // Position of the triangle in the source index buffer, divided by three
+            uint32_t triangle = 0;
+            // Ray parameter and barycentric coordinates of the hit point
+            float t = 0.0f;
+            float u = 0.0f;
+            float v = 0.0f;
+            // Not normalized, follows the winding of the triangle
+            Vector3 normal;
+        };
+
+        TriangleBVH() = default;
+        TriangleBVH(std::span<const Vector3> positions, std::span<const uint32_t> indices);
+
+        // Closest hit before maxDistance, in units of the ray direction which does not need to be normalized
+        bool Raycast(const Ray& ray, float maxDistance, Hit& hit) const;
+
+        bool IsEmpty() const { return _nodes.empty(); }
+        uint32_t GetTriangleCount() const { return static_cast<uint32_t>(_triangles.size()); }
+        uint32_t GetNodeCount() const { return static_cast<uint32_t>(_nodes.size()); }
+        size_t GetMemorySize() const
+        {
+            return _nodes.capacity() * sizeof(Node) + _triangles.capacity() * sizeof(Triangle) +
+                   _triangleIds.capacity() * sizeof(uint32_t);
+        }
+
+    private:
+        struct Node
+        {
+            Vector3 boundsMin;
+            // First triangle of a leaf, left child of an inner node, the right child follows the left one
+            uint32_t firstOrChild = 0;
+            Vector3 boundsMax;
+            // 0 for inner nodes
+            uint32_t triangleCount = 0;
+        };
+
+        struct Triangle
+        {
+            Vector3 v0;
+            Vector3 v1;
+            Vector3 v2;
+        };
+
+        void _Build(std::vector<Vector3>& centroids);
+        void _ComputeBounds(Node& node) const;
+        // Returns the number of triangles sent to the left child, 0 when the node should stay a leaf
+        uint32_t _Split(const Node& node, std::vector<Vector3>& centroids);
+
+    private:
+        std::vector<Node> _nodes;
+        std::vector<Triangle> _triangles;
+        std::vector<uint32_t> _triangleIds;
+
+        static constexpr uint32_t MAX_LEAF_TRIANGLES = 4;
+        // Above this many triangles a node is split even when the split costs more than the leaf
+        static constexpr uint32_t MAX_FORCED_LEAF_TRIANGLES = 16;
+        static constexpr uint32_t SPLIT_BIN_COUNT = 12;
+        // Bounds the traversal stack, deeper nodes are turned into leaves
+        static constexpr uint32_t MAX_DEPTH = 48;
+    };
+} // namespace Frost::Math
@@ -1 +1,11 @@
 #include "Random.h"
+
+namespace Frost
+{
+    // Defined here so that the engine and the game scripts share one generator across the DLL boundary
+    Random& Random::Get()
+    {
+        static Random instance;
+        return instance;
+    }
+} // namespace Frost
@@ -6,21 +6,26 @@
 
 namespace Frost
 {
-    class Random : NoCopy
+    class FROST_API Random : NoCopy
     {
     public:
-        Random() : prng{ rd() } {}
+        Random() : seed{ std::random_device{}() }, prng{ seed } {}
 
-        static Random& Get()
+        static Random& Get();
+
+        static std::mt19937& PRNG() { return Get().prng; }
+
+        // A fixed seed makes a run reproducible, e.g. when replaying recorded input
+        static void SetSeed(uint32_t newSeed)
         {
-            static Random instance;
-            return instance;
+            Get().seed = newSeed;
+            Get().prng.seed(newSeed);
         }
 
-        static std::mt19937& PRNG() { return Get().prng; }
+        static uint32_t GetSeed() { return Get().seed; }
 
     private:
-        std::random_device rd;
+        uint32_t seed;
         std::mt19937 prng;
     };
 } // namespace Frost
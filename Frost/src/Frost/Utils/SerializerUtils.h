@@ -1,5 +1,6 @@
 #pragma once
 
+#include "Frost/Renderer/Viewport.h"
 #include "Frost/Utils/Math/Vector.h"
 
 #include <yaml-cpp/yaml.h>
@@ -21,6 +22,14 @@ operator<<(YAML::Emitter& out, const Frost::Math::Vector4& v)
     return out;
 }
 
+inline YAML::Emitter&
+operator<<(YAML::Emitter& out, const Frost::Viewport& v)
+{
+    out << YAML::Flow;
+    out << YAML::BeginSeq << v.x << v.y << v.width << v.height << YAML::EndSeq;
+    return out;
+}
+
 namespace YAML
 {
     template<>
@@ -70,6 +79,34 @@ namespace YAML
             return true;
         }
     };
+
+    template<>
+    struct convert<Frost::Viewport>
+    {
+        static Node encode(const Frost::Viewport& rhs)
+        {
+            Node node;
+            node.push_back(rhs.x);
+            node.push_back(rhs.y);
+            node.push_back(rhs.width);
+            node.push_back(rhs.height);
+            node.SetStyle(EmitterStyle::Flow);
+            return node;
+        }
+
+        static bool decode(const Node& node, Frost::Viewport& rhs)
+        {
+            if (!node.IsSequence() || node.size() != 4)
+            {
+                return false;
+            }
+            rhs.x = node[0].as<float>();
+            rhs.y = node[1].as<float>();
+            rhs.width = node[2].as<float>();
+            rhs.height = node[3].as<float>();
+            return true;
+        }
+    };
 } // namespace YAML
 
 namespace Frost
@@ -105,11 +105,11 @@ namespace GameLogic
 
     void PauseScreen::OnDestroy()
     {
-        auto scene = GetGameObject().GetScene();
-        scene->DestroyGameObject(pauseLogoId);
-        scene->DestroyGameObject(resumeButtonId);
-        scene->DestroyGameObject(resetButtonId);
-        scene->DestroyGameObject(menuButtonId);
+        EntityCommandBuffer& commands = GetGameObject().GetScene()->GetCommandBuffer();
+        commands.DestroyGameObject(pauseLogoId);
+        commands.DestroyGameObject(resumeButtonId);
+        commands.DestroyGameObject(resetButtonId);
+        commands.DestroyGameObject(menuButtonId);
     }
 
     void PauseScreen::OnUpdate(float deltaTime)
@@ -85,9 +85,10 @@ namespace GameLogic
         auto scene = GetGameObject().GetScene();
         if (scene)
         {
-            scene->DestroyGameObject(_speedometerFrame);
-            scene->DestroyGameObject(_speedometerNeedle);
-            scene->DestroyGameObject(_speedometerText);
+            EntityCommandBuffer& commands = scene->GetCommandBuffer();
+            commands.DestroyGameObject(_speedometerFrame);
+            commands.DestroyGameObject(_speedometerNeedle);
+            commands.DestroyGameObject(_speedometerText);
         }
     }
 
@@ -190,17 +190,17 @@ namespace GameLogic
 
     void SplashScreen::OnDestroy()
     {
-        auto scene = GetGameObject().GetScene();
-        scene->DestroyGameObject(titleImageId);
-        scene->DestroyGameObject(creditsImageId);
+        EntityCommandBuffer& commands = GetGameObject().GetScene()->GetCommandBuffer();
+        commands.DestroyGameObject(titleImageId);
+        commands.DestroyGameObject(creditsImageId);
 
-        scene->DestroyGameObject(startButtonId);
-        scene->DestroyGameObject(creditsButtonId);
-        scene->DestroyGameObject(backButtonId);
-        scene->DestroyGameObject(exitButtonId);
+        commands.DestroyGameObject(startButtonId);
+        commands.DestroyGameObject(creditsButtonId);
+        commands.DestroyGameObject(backButtonId);
+        commands.DestroyGameObject(exitButtonId);
 
-        scene->DestroyGameObject(creditsText1);
-        scene->DestroyGameObject(creditsText2);
+        commands.DestroyGameObject(creditsText1);
+        commands.DestroyGameObject(creditsText2);
     }
 
     void SplashScreen::OnStartButtonPress()
@@ -51,7 +51,7 @@ namespace GameLogic
         auto scene = GetGameObject().GetScene();
         if (scene)
         {
-            scene->DestroyGameObject(_timerTextObj);
+            scene->GetCommandBuffer().DestroyGameObject(_timerTextObj);
         }
     }
 
@@ -62,17 +62,18 @@ namespace GameLogic
 
     void VictoryScreen::OnDestroy()
     {
-        auto scene = GetGameObject().GetScene();
-        scene->DestroyGameObject(victoryImageId);
-        scene->DestroyGameObject(restartButtonId);
+        EntityCommandBuffer& commands = GetGameObject().GetScene()->GetCommandBuffer();
+        commands.DestroyGameObject(victoryImageId);
+        commands.DestroyGameObject(restartButtonId);
     }
 
     void VictoryScreen::OnUpdate(float deltaTime)
     {
         if (GameState::Get().IsInitialized() && GameState::Get().Finished())
         {
-            victoryImageId.RemoveComponent<Disabled>();
-            restartButtonId.RemoveComponent<Disabled>();
+            EntityCommandBuffer& commands = GetGameObject().GetScene()->GetCommandBuffer();
+            commands.RemoveComponent<Disabled>(victoryImageId);
+            commands.RemoveComponent<Disabled>(restartButtonId);
         }
     }
 
@@ -50,13 +50,7 @@ namespace GameLogic
         if (GetGameObject().HasComponent<StaticMesh>())
         {
             auto& mesh = GetGameObject().GetComponent<StaticMesh>();
-            if (mesh.GetModel() && !mesh.GetModel()->GetMaterials().empty())
-            {
-                std::vector<uint8_t> paramData(sizeof(BoostMaterialParameters));
-                memcpy(paramData.data(), &_shaderParams, sizeof(BoostMaterialParameters));
-
-                mesh.GetModel()->GetMaterials()[0].parameters = paramData;
-            }
+            mesh.GetPropertyBlock().Set(_shaderParams);
         }
     }
 
@@ -85,12 +85,7 @@ namespace GameLogic
         if (GetGameObject().HasComponent<StaticMesh>())
         {
             auto& mesh = GetGameObject().GetComponent<StaticMesh>();
-            if (mesh.GetModel() && !mesh.GetModel()->GetMaterials().empty())
-            {
-                std::vector<uint8_t> paramData(sizeof(GrassMaterialParameters));
-                memcpy(paramData.data(), &_params, sizeof(GrassMaterialParameters));
-                mesh.GetModel()->GetMaterials()[0].parameters = paramData;
-            }
+            mesh.GetPropertyBlock().Set(_params);
         }
     }
 } // namespace GameLogic
\ No newline at end of file
@@ -54,6 +54,7 @@ namespace GameLogic
 
         textureConfig.textureType = TextureType::HEIGHTMAP;
         textureConfig.path = "./assets/Prefabs/Heightmap/heightmap_lake.png";
+        textureConfig.keepReadback = true;
 
         std::shared_ptr<Texture> heightmapTexture = Texture::Create(textureConfig);
 
@@ -72,7 +73,7 @@ namespace GameLogic
             auto bodyId =
                 Physics::CreateAndAddBody(bodySettings, GetGameObject().GetHandle(), JPH::EActivation::DontActivate);
 
-            GetGameObject().AddComponent<RigidBody>(bodyId);
+            GetGameObject().GetScene()->GetCommandBuffer().AddComponent<RigidBody>(GetGameObject(), bodyId);
         }
         else
         {
@@ -61,13 +61,7 @@ namespace GameLogic
         if (GetGameObject().HasComponent<StaticMesh>())
         {
             auto& mesh = GetGameObject().GetComponent<StaticMesh>();
-            if (mesh.GetModel() && !mesh.GetModel()->GetMaterials().empty())
-            {
-                std::vector<uint8_t> paramData(sizeof(WaterMaterialParameters));
-                memcpy(paramData.data(), &_shaderParams, sizeof(WaterMaterialParameters));
-
-                mesh.GetModel()->GetMaterials()[0].parameters = paramData;
-            }
+            mesh.GetPropertyBlock().Set(_shaderParams);
         }
     }
 
@@ -2,9 +2,6 @@
 #include "Physics/PhysicLayer.h"
 #include "GameState/GameState.h"
 
-#include <Jolt/Physics/Collision/RayCast.h>
-#include <Jolt/Physics/Collision/CastResult.h>
-
 #undef min
 #undef max
 
@@ -15,21 +12,6 @@ using namespace Frost::Component;
 
 namespace GameLogic
 {
-    class IgnoreCameraLayerFilter : public JPH::ObjectLayerFilter
-    {
-    public:
-        bool ShouldCollide(JPH::ObjectLayer inLayer) const override { return inLayer == ObjectLayers::NON_MOVING; }
-    };
-
-    class RayCastBroadPhaseFilter : public JPH::BroadPhaseLayerFilter
-    {
-    public:
-        bool ShouldCollide(JPH::BroadPhaseLayer inLayer) const override
-        {
-            return inLayer == Frost::BroadPhaseLayers::NON_MOVING;
-        }
-    };
-
     void PlayerSpringCamera::OnCreate()
     {
         // Get camera game objects
@@ -239,22 +221,26 @@ namespace GameLogic
 
         if (isThirdPerson)
         {
-            JPH::RRayCast ray;
+            RaycastQuery ray;
             auto pivotPos = Math::vector_cast<JPH::Vec3>(pivotWTransform.position);
-            ray.mOrigin = pivotPos;
-            ray.mDirection = (newPos - pivotPos) * 1.1f;
-            float desiredDistance = ray.mDirection.Length();
-
-            RayCastBroadPhaseFilter bpFilter;
-            IgnoreCameraLayerFilter objectFilter;
+            ray.origin = pivotPos;
+            ray.direction = (newPos - pivotPos) * 1.1f;
+            ray.layerMask = PhysicsLayerBit(ObjectLayers::NON_MOVING);
+            float desiredDistance = ray.direction.Length();
 
-            JPH::RayCastResult result;
-            if (desiredDistance > 0.01 &&
-                Physics::Get().physics_system.GetNarrowPhaseQuery().CastRay(ray, result, bpFilter, objectFilter))
+            if (desiredDistance > 0.01)
             {
-                cameraPos = ray.GetPointOnRay(result.mFraction * 0.95f);
-                Physics::Get().body_interface->SetPosition(
-                    springCamRigidBody.runtimeBodyID, cameraPos, JPH::EActivation::Activate);
+                _cameraQueries.Clear();
+                uint32_t rayIndex = _cameraQueries.AddRaycast(ray);
+                Physics::ExecuteQueries(_cameraQueries, *GetScene());
+
+                const QueryHit& hit = _cameraQueries.GetRaycastHit(rayIndex);
+                if (hit.hasHit)
+                {
+                    cameraPos = ray.origin + ray.direction * (hit.fraction * 0.95f);
+                    Physics::Get().body_interface->SetPosition(
+                        springCamRigidBody.runtimeBodyID, cameraPos, JPH::EActivation::Activate);
+                }
             }
         }
 
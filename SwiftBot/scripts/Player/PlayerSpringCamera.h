@@ -32,6 +32,8 @@ namespace GameLogic
         Frost::ScreenShakeEffect* _screenShake{ nullptr };
         Frost::RadialBlurEffect* _radialBlur{ nullptr };
 
+        Frost::SceneQueryBatch _cameraQueries;
+
         bool _freeCam = false;
         bool isThirdPerson = true;
 
@@ -58,9 +58,7 @@ namespace GameLogic
         BodyID bodyId = body->GetID();
         Physics::AddBody(bodyId, EActivation::Activate);
 
-        auto& rigidBody = _playerController.AddComponent<RigidBody>(bodyId);
-        rigidBody.objectLayer = ObjectLayers::PLAYER;
-        rigidBody.motionType = RigidBody::MotionType::Dynamic;
+        _AttachBody(bodyId);
 
         _isBodyValid = true;
     }
@@ -69,11 +67,7 @@ namespace GameLogic
     {
         _vehicle.SetActive(false);
 
-        if (_playerController.HasComponent<RigidBody>())
-        {
-            Physics::RemoveAndDestroyBody(_playerController.GetComponent<RigidBody>().runtimeBodyID);
-            _playerController.RemoveComponent<RigidBody>();
-        }
+        _DetachBody();
         _isBodyValid = false;
     }
 
@@ -6,35 +6,12 @@
 #include <Jolt/Physics/Body/BodyCreationSettings.h>
 #include <Jolt/Physics/Vehicle/WheeledVehicleController.h>
 #include <Jolt/Physics/Vehicle/MotorcycleController.h>
-#include <Jolt/Physics/Collision/Shape/SphereShape.h>
-#include <Jolt/Physics/Collision/CollisionCollectorImpl.h>
-#include <Jolt/Physics/Collision/ShapeCast.h>
-#include <Jolt/Physics/Collision/ObjectLayer.h>
-#include <Jolt/Physics/Collision/BroadPhase/BroadPhaseLayer.h>
 
 #include "GameState/GameState.h"
 
 #undef min
 #undef max
 
-class MotoObjectLayerFilter : public JPH::ObjectLayerFilter
-{
-public:
-    bool ShouldCollide(JPH::ObjectLayer inLayer) const override
-    {
-        return inLayer == GameLogic::ObjectLayers::NON_MOVING;
-    }
-};
-
-class MotoBroadPhaseLayerFilter : public JPH::BroadPhaseLayerFilter
-{
-public:
-    bool ShouldCollide(JPH::BroadPhaseLayer inLayer) const override
-    {
-        return inLayer == GameLogic::BroadPhaseLayers::NON_MOVING;
-    }
-};
-
 using namespace JPH;
 using namespace Frost;
 using namespace Frost::Math;
@@ -215,9 +192,7 @@ namespace GameLogic
         _previousLinearSpeed = body->GetLinearVelocity();
         _previousAngularSpeed = body->GetAngularVelocity();
 
-        auto& rigidBody = _playerController.AddComponent<RigidBody>(bodyId);
-        rigidBody.objectLayer = ObjectLayers::PLAYER;
-        rigidBody.motionType = RigidBody::MotionType::Dynamic;
+        _AttachBody(bodyId);
 
         if (_camera.IsValid())
         {
@@ -243,11 +218,7 @@ namespace GameLogic
             Physics::Get().physics_system.RemoveStepListener(_constraint);
         }
 
-        if (_playerController.HasComponent<RigidBody>())
-        {
-            Physics::RemoveAndDestroyBody(_playerController.GetComponent<RigidBody>().runtimeBodyID);
-            _playerController.RemoveComponent<RigidBody>();
-        }
+        _DetachBody();
 
         _constraint = nullptr;
         _controller = nullptr;
@@ -310,22 +281,20 @@ namespace GameLogic
 
         if (sOverrideGravity)
         {
-            SphereShape sphere(0.5f);
-            sphere.SetEmbedded();
-
-            Vec3 castDir = -3.0f * bodyUp;
-
-            RShapeCast shape_cast(&sphere, Vec3::sOne(), RMat44::sTranslation(bodyPosition), castDir);
-
-            ShapeCastSettings settings;
-            ClosestHitCollisionCollector<CastShapeCollector> collector;
+            ShapeCastQuery sphereCast = { .shape = QueryShape::Sphere(0.5f),
+                                          .position = bodyPosition,
+                                          .direction = -3.0f * bodyUp,
+                                          .layerMask = PhysicsLayerBit(ObjectLayers::NON_MOVING) };
 
-            Physics::Get().physics_system.GetNarrowPhaseQuery().CastShape(
-                shape_cast, settings, bodyPosition, collector, MotoBroadPhaseLayerFilter(), MotoObjectLayerFilter());
+            _gravityQueries.Clear();
+            uint32_t castIndex = _gravityQueries.AddShapeCast(sphereCast);
+            Physics::ExecuteQueries(_gravityQueries, *_player.GetScene());
 
-            if (collector.HadHit())
+            const QueryHit& hit = _gravityQueries.GetShapeCastHit(castIndex);
+            if (hit.hasHit)
             {
-                newGravityDir = collector.mHit.mPenetrationAxis.Normalized();
+                // Towards the surface
+                newGravityDir = -hit.normal;
                 gravityOverridden = true;
             }
         }
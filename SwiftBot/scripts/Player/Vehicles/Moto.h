@@ -74,5 +74,8 @@ namespace GameLogic
         // Wheels
         Frost::GameObject _frontWheel;
         Frost::GameObject _backWheel;
+
+        // Anti-gravity ground probe
+        Frost::SceneQueryBatch _gravityQueries;
     };
 } // namespace GameLogic
\ No newline at end of file
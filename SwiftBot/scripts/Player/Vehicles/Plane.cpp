@@ -75,9 +75,7 @@ namespace GameLogic
         BodyID bodyId = body->GetID();
         Physics::AddBody(bodyId, EActivation::Activate);
 
-        auto& rigidBody = _playerController.AddComponent<RigidBody>(bodyId);
-        rigidBody.objectLayer = ObjectLayers::PLAYER;
-        rigidBody.motionType = RigidBody::MotionType::Dynamic;
+        _AttachBody(bodyId);
 
         _justAppeared = true;
         _inContinuousCollision = false;
@@ -95,17 +93,15 @@ namespace GameLogic
 
         if (_playerController.HasComponent<RigidBody>())
         {
-            BodyID bodyId = _playerController.GetComponent<RigidBody>().runtimeBodyID;
-
-            BodyLockRead lock(Physics::GetBodyLockInterface(), bodyId);
+            BodyLockRead lock(Physics::GetBodyLockInterface(),
+                              _playerController.GetComponent<RigidBody>().runtimeBodyID);
             if (lock.Succeeded())
             {
                 _transferredSpeed = lock.GetBody().GetLinearVelocity().Length();
             }
-
-            _playerController.RemoveComponent<RigidBody>();
-            Physics::RemoveAndDestroyBody(bodyId);
         }
+
+        _DetachBody();
     }
 
     void Plane::OnMove(float right, float forward)
@@ -1,4 +1,5 @@
 #include "Player/Vehicles/Vehicle.h"
+#include "Physics/PhysicLayer.h"
 
 namespace GameLogic
 {
@@ -8,4 +9,32 @@ namespace GameLogic
         _camera{ player.GetChildByName("Camera", true) }
     {
     }
+
+    void Vehicle::_AttachBody(JPH::BodyID bodyId)
+    {
+        using Frost::Component::RigidBody;
+
+        RigidBody rigidBody(bodyId);
+        rigidBody.objectLayer = ObjectLayers::PLAYER;
+        rigidBody.motionType = RigidBody::MotionType::Dynamic;
+
+        _playerController.GetScene()->GetCommandBuffer().AddComponent<RigidBody>(_playerController,
+                                                                                 std::move(rigidBody));
+    }
+
+    bool Vehicle::_DetachBody()
+    {
+        using Frost::Component::RigidBody;
+
+        if (!_playerController.HasComponent<RigidBody>())
+            return false;
+
+        JPH::BodyID bodyId = _playerController.GetComponent<RigidBody>().runtimeBodyID;
+        if (bodyId.IsInvalid() || !Frost::Physics::GetBodyInterface().IsAdded(bodyId))
+            return false;
+
+        Frost::Physics::RemoveAndDestroyBody(bodyId);
+        _playerController.GetScene()->GetCommandBuffer().RemoveComponent<RigidBody>(_playerController);
+        return true;
+    }
 } // namespace GameLogic
\ No newline at end of file
@@ -29,6 +29,12 @@ namespace GameLogic
         virtual void OnMove(float right, float forward) {}
 
     protected:
+        // The RigidBody of the player controller changes through the scene command buffer, at the next sync point
+        void _AttachBody(JPH::BodyID bodyId);
+        // Destroys the body of the player controller, false when there is none. Every vehicle is hidden in a row and
+        // the component outlives its body until the sync point, so the vehicles after the first find no body.
+        bool _DetachBody();
+
         Frost::GameObject _player;
         Frost::GameObject _playerController;
         Frost::GameObject _camera;
@@ -48,7 +48,12 @@ namespace Game
 
         Frost::FT_INFO("Loading level from path: {}", levelPath);
 
+        // Levels compiled with world cells are streamed around the player camera
         std::shared_ptr<Frost::Scene> levelScene = Frost::SceneManager::LoadSceneFromFile(levelPath);
+        if (levelScene && levelScene->GetStreamer().IsOpen())
+        {
+            Frost::FT_INFO("Level streams {} cells", levelScene->GetStreamer().GetCellCount());
+        }
         Frost::Application::PushLayer<Frost::SceneLayer>(levelScene, "LevelLayer");
 
         _currentLevelPath = levelPath;